@@ -0,0 +1,771 @@
+/**
+ * @file bench_main.cpp
+ * @brief Benchmark driver for Gaussian Extractor
+ * @author Le Nhan Pham
+ * @date 2025
+ *
+ * Generates a synthetic corpus of Gaussian logs, runs the extractor commands
+ * on it at several thread counts and writes the timings as JSON. Every run
+ * starts from a fresh copy of the corpus (hard links where possible) because
+ * check and xyz move or create files.
+ *
+ * Usage: gaussian_bench.x --binary ./gaussian_extractor.x [options]
+ *
+ * The driver measures each command as a child process, so wall time, CPU
+ * time and peak RSS are those of the extractor alone. Each child also runs
+ * with --profile-trace, and the phase totals of its trace (discovery, read,
+ * parse, sort, write, move and the waits) are added to the run's record.
+ * POSIX only.
+ */
+
+#include "synthetic_log.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifndef _WIN32
+    #include <fcntl.h>
+    #include <sys/resource.h>
+    #include <sys/wait.h>
+    #include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    using KindWeight = std::pair<SyntheticLogGenerator::Kind, unsigned int>;
+
+    /**
+     * @brief Command-line options of the benchmark
+     */
+    struct BenchOptions
+    {
+        std::string               binary;                   ///< Extractor to benchmark
+        size_t                    files    = 200;           ///< Logs per corpus
+        uintmax_t                 size_kb  = 512;           ///< Approximate size of each log
+        unsigned int              atoms    = 40;            ///< Atoms per molecule
+        std::vector<unsigned int> threads;                  ///< Thread counts to run
+        std::vector<std::string>  commands;                 ///< Commands to run
+        std::vector<KindWeight>   mix;                      ///< Kind weights of the extract corpus
+        unsigned int              repeat   = 3;             ///< Runs per command and thread count
+        uint32_t                  seed     = 42;            ///< Corpus seed
+        std::string               work_dir = "bench_work";  ///< Scratch directory
+        std::string               output   = "bench.json";  ///< JSON report
+        bool                      keep     = false;         ///< Keep the corpus after the run
+    };
+
+    /**
+     * @brief One corpus directory and what is in it
+     */
+    struct Corpus
+    {
+        fs::path  directory;  ///< Files to stage for a run
+        size_t    files = 0;  ///< Files the command processes
+        uintmax_t bytes = 0;  ///< Bytes the command reads
+    };
+
+    /**
+     * @brief Measurements of one command run
+     */
+    struct RunResult
+    {
+        std::string  command;
+        unsigned int threads     = 1;
+        unsigned int repeat      = 0;
+        double       stage_s     = 0.0;  ///< Copying the corpus into the run directory
+        double       wall_s      = 0.0;  ///< Child process wall time
+        double       user_s      = 0.0;  ///< Child CPU time in user mode
+        double       sys_s       = 0.0;  ///< Child CPU time in kernel mode
+        double       cleanup_s   = 0.0;  ///< Removing the run directory
+        long         peak_rss_kb = 0;    ///< Child peak resident set size
+        int          exit_code   = 0;
+        size_t       files       = 0;
+        uintmax_t    bytes       = 0;
+
+        std::vector<std::pair<std::string, double>> profile;  ///< Phase totals of the child's trace, in order
+    };
+
+    void print_usage()
+    {
+        std::cout << "Usage: gaussian_bench.x --binary <path> [options]\n\n"
+                  << "Options:\n"
+                  << "  --binary <path>       Extractor executable to benchmark (required)\n"
+                  << "  --files <N>           Logs per corpus (default: 200)\n"
+                  << "  --size-kb <N>         Approximate size of each log in KB (default: 512)\n"
+                  << "  --atoms <N>           Atoms per molecule (default: 40)\n"
+                  << "  --threads <list>      Comma-separated thread counts (default: 1,2,4,... up to all cores)\n"
+                  << "  --commands <list>     Subset of extract,check,high-kj,xyz,ci (default: all)\n"
+                  << "  --mix <kind=w,...>    Log shapes of the extract corpus (default: opt-freq=6,tddft=1,\n"
+                  << "                        pcm-failure=1,error=1,multi-link=1)\n"
+                  << "  --repeat <N>          Runs per command and thread count (default: 3)\n"
+                  << "  --seed <N>            Corpus seed (default: 42)\n"
+                  << "  --work-dir <dir>      Scratch directory (default: bench_work)\n"
+                  << "  --output <file>       JSON report (default: bench.json)\n"
+                  << "  --keep                Keep the generated corpus\n";
+    }
+
+    std::vector<std::string> split_list(const std::string& text)
+    {
+        std::vector<std::string> items;
+        std::stringstream        stream(text);
+        std::string              item;
+        while (std::getline(stream, item, ','))
+        {
+            if (!item.empty())
+            {
+                items.push_back(item);
+            }
+        }
+        return items;
+    }
+
+    unsigned long parse_number(const std::string& option, const std::string& value)
+    {
+        try
+        {
+            size_t        used   = 0;
+            unsigned long number = std::stoul(value, &used);
+            if (used == value.size() && number > 0)
+            {
+                return number;
+            }
+        }
+        catch (const std::exception&)
+        {
+        }
+        throw std::invalid_argument(option + " expects a positive number, got '" + value + "'");
+    }
+
+    BenchOptions parse_options(int argc, char* argv[])
+    {
+        BenchOptions options;
+        for (int i = 1; i < argc; ++i)
+        {
+            std::string arg = argv[i];
+            if (arg == "-h" || arg == "--help")
+            {
+                print_usage();
+                std::exit(0);
+            }
+            if (arg == "--keep")
+            {
+                options.keep = true;
+                continue;
+            }
+            if (i + 1 >= argc)
+            {
+                throw std::invalid_argument("Missing value for " + arg);
+            }
+            std::string value = argv[++i];
+
+            if (arg == "--binary")
+            {
+                options.binary = value;
+            }
+            else if (arg == "--files")
+            {
+                options.files = parse_number(arg, value);
+            }
+            else if (arg == "--size-kb")
+            {
+                options.size_kb = parse_number(arg, value);
+            }
+            else if (arg == "--atoms")
+            {
+                options.atoms = static_cast<unsigned int>(parse_number(arg, value));
+            }
+            else if (arg == "--repeat")
+            {
+                options.repeat = static_cast<unsigned int>(parse_number(arg, value));
+            }
+            else if (arg == "--seed")
+            {
+                options.seed = static_cast<uint32_t>(std::stoul(value));
+            }
+            else if (arg == "--work-dir")
+            {
+                options.work_dir = value;
+            }
+            else if (arg == "--output")
+            {
+                options.output = value;
+            }
+            else if (arg == "--threads")
+            {
+                for (const auto& item : split_list(value))
+                {
+                    options.threads.push_back(static_cast<unsigned int>(parse_number(arg, item)));
+                }
+            }
+            else if (arg == "--commands")
+            {
+                options.commands = split_list(value);
+                for (const auto& command : options.commands)
+                {
+                    if (command != "extract" && command != "check" && command != "high-kj" && command != "xyz" &&
+                        command != "ci")
+                    {
+                        throw std::invalid_argument("Unknown command to benchmark: " + command);
+                    }
+                }
+            }
+            else if (arg == "--mix")
+            {
+                for (const auto& item : split_list(value))
+                {
+                    size_t                      equals = item.find('=');
+                    SyntheticLogGenerator::Kind kind;
+                    if (!SyntheticLogGenerator::parse_kind(item.substr(0, equals), kind))
+                    {
+                        throw std::invalid_argument("Unknown log kind in --mix: " + item.substr(0, equals));
+                    }
+                    unsigned int weight =
+                        equals == std::string::npos
+                            ? 1
+                            : static_cast<unsigned int>(parse_number("--mix", item.substr(equals + 1)));
+                    options.mix.emplace_back(kind, weight);
+                }
+            }
+            else
+            {
+                throw std::invalid_argument("Unknown option: " + arg);
+            }
+        }
+
+        if (options.binary.empty())
+        {
+            throw std::invalid_argument("--binary is required");
+        }
+        if (options.commands.empty())
+        {
+            options.commands = {"extract", "check", "high-kj", "xyz", "ci"};
+        }
+        if (options.threads.empty())
+        {
+            unsigned int cores = std::max(1u, std::thread::hardware_concurrency());
+            for (unsigned int n = 1; n < cores; n *= 2)
+            {
+                options.threads.push_back(n);
+            }
+            options.threads.push_back(cores);
+        }
+        if (options.mix.empty())
+        {
+            using Kind  = SyntheticLogGenerator::Kind;
+            options.mix = {{Kind::OPT_FREQ, 6},
+                           {Kind::TDDFT, 1},
+                           {Kind::PCM_FAILURE, 1},
+                           {Kind::ERROR_TERMINATION, 1},
+                           {Kind::MULTI_LINK, 1}};
+        }
+        return options;
+    }
+
+    double seconds_since(Clock::time_point start)
+    {
+        return std::chrono::duration<double>(Clock::now() - start).count();
+    }
+
+    std::string file_name(const char* prefix, size_t index, const char* extension)
+    {
+        char buffer[64];
+        std::snprintf(buffer, sizeof(buffer), "%s-%05zu%s", prefix, index, extension);
+        return buffer;
+    }
+
+    /**
+     * @brief Kind of the index-th log, interleaving the kinds by weight
+     */
+    SyntheticLogGenerator::Kind kind_for(const BenchOptions& options, size_t index)
+    {
+        unsigned int total = 0;
+        for (const auto& entry : options.mix)
+        {
+            total += entry.second;
+        }
+        unsigned int slot = static_cast<unsigned int>(index % total);
+        for (const auto& entry : options.mix)
+        {
+            if (slot < entry.second)
+            {
+                return entry.first;
+            }
+            slot -= entry.second;
+        }
+        return options.mix.front().first;
+    }
+
+    /**
+     * @brief Generate the corpora needed by the selected commands
+     */
+    std::map<std::string, Corpus> generate_corpora(const BenchOptions& options, const fs::path& root)
+    {
+        SyntheticLogGenerator::Options generator_options;
+        generator_options.atoms        = options.atoms;
+        generator_options.target_bytes = options.size_kb * 1024;
+        generator_options.seed         = options.seed;
+        SyntheticLogGenerator generator(generator_options);
+
+        auto wanted = [&options](const std::string& command) {
+            return std::find(options.commands.begin(), options.commands.end(), command) != options.commands.end();
+        };
+
+        std::map<std::string, Corpus> corpora;
+        if (wanted("extract") || wanted("check") || wanted("xyz"))
+        {
+            Corpus logs;
+            logs.directory = root / "logs";
+            fs::create_directories(logs.directory);
+            for (size_t i = 0; i < options.files; ++i)
+            {
+                std::string path = (logs.directory / file_name("mol", i, ".log")).string();
+                logs.bytes += generator.write_log(kind_for(options, i), i, path);
+            }
+            logs.files         = options.files;
+            corpora["extract"] = logs;
+            corpora["check"]   = logs;
+            corpora["xyz"]     = logs;
+        }
+
+        if (wanted("high-kj"))
+        {
+            // Low-level opt+freq logs in the parent, single points of the same names in high/
+            Corpus combined;
+            combined.directory = root / "high_level";
+            fs::create_directories(combined.directory / "high");
+            for (size_t i = 0; i < options.files; ++i)
+            {
+                std::string name = file_name("mol", i, ".log");
+                combined.bytes += generator.write_log(
+                    SyntheticLogGenerator::Kind::OPT_FREQ, i, (combined.directory / name).string());
+                combined.bytes += generator.write_log(
+                    SyntheticLogGenerator::Kind::SINGLE_POINT, i, (combined.directory / "high" / name).string());
+            }
+            combined.files     = options.files;
+            corpora["high-kj"] = combined;
+        }
+
+        if (wanted("ci"))
+        {
+            Corpus xyz;
+            xyz.directory = root / "xyz";
+            fs::create_directories(xyz.directory);
+            for (size_t i = 0; i < options.files; ++i)
+            {
+                xyz.bytes += generator.write_xyz(i, (xyz.directory / file_name("mol", i, ".xyz")).string());
+            }
+            xyz.files     = options.files;
+            corpora["ci"] = xyz;
+        }
+        return corpora;
+    }
+
+    /**
+     * @brief Recreate a corpus under target, hard-linking files where the file system allows it
+     */
+    void stage_corpus(const fs::path& source, const fs::path& target)
+    {
+        fs::create_directories(target);
+        for (const auto& entry : fs::directory_iterator(source))
+        {
+            fs::path destination = target / entry.path().filename();
+            if (entry.is_directory())
+            {
+                stage_corpus(entry.path(), destination);
+                continue;
+            }
+            std::error_code ec;
+            fs::create_hard_link(entry.path(), destination, ec);
+            if (ec)
+            {
+                fs::copy_file(entry.path(), destination);
+            }
+        }
+    }
+
+#ifndef _WIN32
+
+    /**
+     * @brief Run the extractor in a directory and measure it
+     * @param arguments Command line, arguments[0] being the absolute binary path
+     * @param directory Working directory of the child
+     * @param log_path File receiving the child's stdout and stderr
+     * @param result Filled with wall time, CPU times, peak RSS and exit code
+     */
+    void run_child(const std::vector<std::string>& arguments,
+                   const fs::path&                 directory,
+                   const fs::path&                 log_path,
+                   RunResult&                      result)
+    {
+        std::vector<char*> argv;
+        for (const auto& argument : arguments)
+        {
+            argv.push_back(const_cast<char*>(argument.c_str()));
+        }
+        argv.push_back(nullptr);
+
+        Clock::time_point start = Clock::now();
+        pid_t             pid   = ::fork();
+        if (pid < 0)
+        {
+            throw std::runtime_error("fork failed");
+        }
+        if (pid == 0)
+        {
+            int output = ::open(log_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+            int input  = ::open("/dev/null", O_RDONLY);
+            if (output < 0 || input < 0 || ::chdir(directory.c_str()) != 0)
+            {
+                ::_exit(127);
+            }
+            ::dup2(input, STDIN_FILENO);
+            ::dup2(output, STDOUT_FILENO);
+            ::dup2(output, STDERR_FILENO);
+            ::execv(argv[0], argv.data());
+            ::_exit(127);
+        }
+
+        int           status = 0;
+        struct rusage usage;
+        if (::wait4(pid, &status, 0, &usage) < 0)
+        {
+            throw std::runtime_error("wait4 failed");
+        }
+        result.wall_s    = seconds_since(start);
+        result.user_s    = usage.ru_utime.tv_sec + usage.ru_utime.tv_usec / 1e6;
+        result.sys_s     = usage.ru_stime.tv_sec + usage.ru_stime.tv_usec / 1e6;
+        result.exit_code = WIFEXITED(status) ? WEXITSTATUS(status) : 128 + WTERMSIG(status);
+    #ifdef __APPLE__
+        result.peak_rss_kb = usage.ru_maxrss / 1024;  // Bytes on macOS
+    #else
+        result.peak_rss_kb = usage.ru_maxrss;  // Kilobytes on Linux
+    #endif
+    }
+
+    /**
+     * @brief Read the phase totals a child wrote with --profile-trace
+     * @param trace_path Chrome trace of the run
+     * @return The "<phase>_s" entries of its "otherData" object, in file order; empty if the trace is missing
+     */
+    std::vector<std::pair<std::string, double>> read_profile(const fs::path& trace_path)
+    {
+        std::vector<std::pair<std::string, double>> phases;
+        std::ifstream                               file(trace_path);
+        std::stringstream                           buffer;
+        buffer << file.rdbuf();
+        std::string text = buffer.str();
+
+        // otherData is a flat object of "name":number pairs written by Profiler::write_trace
+        size_t pos = text.find("\"otherData\":{");
+        if (pos == std::string::npos)
+        {
+            return phases;
+        }
+        size_t end = text.find('}', pos);
+        pos        = text.find('{', pos) + 1;
+        while (pos < end)
+        {
+            size_t name_begin = text.find('"', pos);
+            size_t name_end   = text.find('"', name_begin + 1);
+            size_t colon      = text.find(':', name_end);
+            if (name_begin >= end || name_end >= end || colon >= end)
+            {
+                break;
+            }
+            std::string name = text.substr(name_begin + 1, name_end - name_begin - 1);
+            if (name.size() > 2 && name.compare(name.size() - 2, 2, "_s") == 0)
+            {
+                phases.emplace_back(name, std::strtod(text.c_str() + colon + 1, nullptr));
+            }
+            pos = text.find(',', colon);
+            if (pos == std::string::npos)
+            {
+                break;
+            }
+            ++pos;
+        }
+        return phases;
+    }
+
+    std::string binary_version(const std::string& binary)
+    {
+        std::string command = "\"" + binary + "\" --version 2>/dev/null";
+        FILE*       pipe    = ::popen(command.c_str(), "r");
+        if (!pipe)
+        {
+            return "unknown";
+        }
+        char        line[256] = {};
+        std::string version   = std::fgets(line, sizeof(line), pipe) ? line : "unknown";
+        ::pclose(pipe);
+        while (!version.empty() && (version.back() == '\n' || version.back() == '\r'))
+        {
+            version.pop_back();
+        }
+        return version;
+    }
+
+#endif
+
+    std::string json_string(const std::string& text)
+    {
+        std::string quoted = "\"";
+        for (char c : text)
+        {
+            if (c == '"' || c == '\\')
+            {
+                quoted += '\\';
+                quoted += c;
+            }
+            else if (static_cast<unsigned char>(c) < 0x20)
+            {
+                char buffer[8];
+                std::snprintf(buffer, sizeof(buffer), "\\u%04x", c);
+                quoted += buffer;
+            }
+            else
+            {
+                quoted += c;
+            }
+        }
+        return quoted + "\"";
+    }
+
+    std::string json_number(double value)
+    {
+        char buffer[32];
+        std::snprintf(buffer, sizeof(buffer), "%.6f", value);
+        return buffer;
+    }
+
+    double median(std::vector<double> values)
+    {
+        std::sort(values.begin(), values.end());
+        size_t middle = values.size() / 2;
+        return values.size() % 2 ? values[middle] : (values[middle - 1] + values[middle]) / 2.0;
+    }
+
+    void write_report(const BenchOptions&                  options,
+                      const std::string&                   version,
+                      const std::map<std::string, Corpus>& corpora,
+                      double                               generate_s,
+                      const std::vector<RunResult>&        runs)
+    {
+        std::ofstream out(options.output);
+        if (!out)
+        {
+            throw std::runtime_error("Cannot write report: " + options.output);
+        }
+
+        double stage_s = 0.0, run_s = 0.0, cleanup_s = 0.0;
+        for (const auto& run : runs)
+        {
+            stage_s += run.stage_s;
+            run_s += run.wall_s;
+            cleanup_s += run.cleanup_s;
+        }
+
+        out << "{\n"
+            << "  \"version\": " << json_string(version) << ",\n"
+            << "  \"corpus\": {\n"
+            << "    \"files\": " << options.files << ",\n"
+            << "    \"size_kb\": " << options.size_kb << ",\n"
+            << "    \"atoms\": " << options.atoms << ",\n"
+            << "    \"seed\": " << options.seed << ",\n"
+            << "    \"mix\": {";
+        for (size_t i = 0; i < options.mix.size(); ++i)
+        {
+            out << (i ? ", " : "") << json_string(SyntheticLogGenerator::kind_name(options.mix[i].first)) << ": "
+                << options.mix[i].second;
+        }
+        out << "},\n"
+            << "    \"bytes\": {";
+        bool first = true;
+        for (const auto& entry : corpora)
+        {
+            out << (first ? "" : ", ") << json_string(entry.first) << ": " << entry.second.bytes;
+            first = false;
+        }
+        out << "}\n"
+            << "  },\n"
+            << "  \"phases\": {\n"
+            << "    \"generate_s\": " << json_number(generate_s) << ",\n"
+            << "    \"stage_s\": " << json_number(stage_s) << ",\n"
+            << "    \"run_s\": " << json_number(run_s) << ",\n"
+            << "    \"cleanup_s\": " << json_number(cleanup_s) << "\n"
+            << "  },\n"
+            << "  \"runs\": [\n";
+        for (size_t i = 0; i < runs.size(); ++i)
+        {
+            const RunResult& run = runs[i];
+            out << "    {\"command\": " << json_string(run.command) << ", \"threads\": " << run.threads
+                << ", \"repeat\": " << run.repeat << ", \"exit_code\": " << run.exit_code
+                << ", \"stage_s\": " << json_number(run.stage_s) << ", \"wall_s\": " << json_number(run.wall_s)
+                << ", \"user_s\": " << json_number(run.user_s) << ", \"sys_s\": " << json_number(run.sys_s)
+                << ", \"cleanup_s\": " << json_number(run.cleanup_s) << ", \"peak_rss_kb\": " << run.peak_rss_kb
+                << ", \"files\": " << run.files << ", \"bytes\": " << run.bytes
+                << ", \"files_per_s\": " << json_number(run.files / std::max(run.wall_s, 1e-9))
+                << ", \"mb_per_s\": " << json_number(run.bytes / 1048576.0 / std::max(run.wall_s, 1e-9))
+                << ", \"profile\": {";
+            for (size_t p = 0; p < run.profile.size(); ++p)
+            {
+                out << (p ? ", " : "") << json_string(run.profile[p].first) << ": "
+                    << json_number(run.profile[p].second);
+            }
+            out << "}}" << (i + 1 < runs.size() ? "," : "") << "\n";
+        }
+        out << "  ],\n"
+            << "  \"summary\": [\n";
+
+        // Median over the repeats of each command and thread count, with the speedup over one thread
+        std::vector<std::string> lines;
+        for (const auto& command : options.commands)
+        {
+            double single_thread = 0.0;
+            for (unsigned int threads : options.threads)
+            {
+                std::vector<double> walls;
+                long                peak_rss = 0;
+                const RunResult*    sample   = nullptr;
+                for (const auto& run : runs)
+                {
+                    if (run.command == command && run.threads == threads)
+                    {
+                        walls.push_back(run.wall_s);
+                        peak_rss = std::max(peak_rss, run.peak_rss_kb);
+                        sample   = &run;
+                    }
+                }
+                if (!sample)
+                {
+                    continue;
+                }
+                double wall = median(walls);
+                if (threads == 1)
+                {
+                    single_thread = wall;
+                }
+                std::ostringstream line;
+                line << "    {\"command\": " << json_string(command) << ", \"threads\": " << threads
+                     << ", \"median_wall_s\": " << json_number(wall)
+                     << ", \"min_wall_s\": " << json_number(*std::min_element(walls.begin(), walls.end()))
+                     << ", \"files_per_s\": " << json_number(sample->files / std::max(wall, 1e-9))
+                     << ", \"mb_per_s\": " << json_number(sample->bytes / 1048576.0 / std::max(wall, 1e-9))
+                     << ", \"peak_rss_kb\": " << peak_rss << ", \"speedup\": "
+                     << (single_thread > 0.0 ? json_number(single_thread / std::max(wall, 1e-9)) : "null") << "}";
+                lines.push_back(line.str());
+            }
+        }
+        for (size_t i = 0; i < lines.size(); ++i)
+        {
+            out << lines[i] << (i + 1 < lines.size() ? "," : "") << "\n";
+        }
+        out << "  ]\n"
+            << "}\n";
+    }
+}  // namespace
+
+int main(int argc, char* argv[])
+{
+#ifdef _WIN32
+    (void)argc;
+    (void)argv;
+    std::cerr << "gaussian_bench is only available on POSIX systems" << std::endl;
+    return 1;
+#else
+    try
+    {
+        BenchOptions options = parse_options(argc, argv);
+        fs::path     binary  = fs::absolute(options.binary);
+        if (!fs::exists(binary))
+        {
+            throw std::runtime_error("Extractor not found: " + binary.string());
+        }
+        std::string version = binary_version(binary.string());
+
+        fs::path work_dir    = fs::absolute(options.work_dir);
+        fs::path corpus_root = work_dir / "corpus";
+        fs::path run_root    = work_dir / "run";
+        fs::remove_all(work_dir);
+        fs::create_directories(work_dir);
+
+        std::cout << "Generating " << options.files << " synthetic logs of ~" << options.size_kb << " KB per corpus..."
+                  << std::endl;
+        Clock::time_point             start      = Clock::now();
+        std::map<std::string, Corpus> corpora    = generate_corpora(options, corpus_root);
+        double                        generate_s = seconds_since(start);
+        std::cout << "Corpus ready in " << json_number(generate_s) << " s" << std::endl;
+
+        std::vector<RunResult> runs;
+        for (const auto& command : options.commands)
+        {
+            const Corpus& corpus = corpora.at(command);
+            for (unsigned int threads : options.threads)
+            {
+                for (unsigned int repeat = 0; repeat < options.repeat; ++repeat)
+                {
+                    RunResult run;
+                    run.command = command;
+                    run.threads = threads;
+                    run.repeat  = repeat;
+                    run.files   = corpus.files;
+                    run.bytes   = corpus.bytes;
+
+                    start = Clock::now();
+                    stage_corpus(corpus.directory, run_root);
+                    run.stage_s = seconds_since(start);
+
+                    std::vector<std::string> arguments = {binary.string()};
+                    if (command != "extract")
+                    {
+                        arguments.push_back(command);
+                    }
+                    fs::path trace = work_dir / (command + ".trace.json");
+                    arguments.insert(arguments.end(),
+                                     {"-q", "-nt", std::to_string(threads), "--profile-trace", trace.string()});
+                    fs::path directory = command == "high-kj" ? run_root / "high" : run_root;
+
+                    fs::remove(trace);
+                    run_child(arguments, directory, work_dir / (command + ".out"), run);
+                    run.profile = read_profile(trace);
+
+                    start = Clock::now();
+                    fs::remove_all(run_root);
+                    run.cleanup_s = seconds_since(start);
+
+                    std::cout << "  " << command << " -nt " << threads << " #" << repeat + 1 << ": "
+                              << json_number(run.wall_s) << " s, " << run.peak_rss_kb << " KB peak"
+                              << (run.exit_code ? ", exit code " + std::to_string(run.exit_code) : "") << std::endl;
+                    runs.push_back(run);
+                }
+            }
+        }
+
+        write_report(options, version, corpora, generate_s, runs);
+        if (!options.keep)
+        {
+            fs::remove_all(work_dir);
+        }
+        std::cout << "Report written to " << options.output << std::endl;
+        return 0;
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+#endif
+}
@@ -0,0 +1,469 @@
+/**
+ * @file synthetic_log.cpp
+ * @brief Implementation of the synthetic Gaussian log generator
+ * @author Le Nhan Pham
+ * @date 2025
+ */
+
+#include "synthetic_log.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+namespace
+{
+    /**
+     * @brief Element symbols for the atomic numbers used in generated molecules
+     */
+    const char* element_symbol(int number)
+    {
+        switch (number)
+        {
+            case 1:
+                return "H";
+            case 6:
+                return "C";
+            case 7:
+                return "N";
+            case 8:
+                return "O";
+            case 15:
+                return "P";
+            case 16:
+                return "S";
+            case 17:
+                return "Cl";
+            case 77:
+                return "Ir";
+            default:
+                return "X";
+        }
+    }
+
+    /**
+     * @brief Append printf-style text to a stream
+     */
+    template <typename... Args>
+    void emit(std::ostream& out, const char* format, Args... args)
+    {
+        char buffer[256];
+        int  length = std::snprintf(buffer, sizeof(buffer), format, args...);
+        if (length > 0)
+        {
+            out.write(buffer, std::min<int>(length, static_cast<int>(sizeof(buffer)) - 1));
+        }
+    }
+
+    const char* const DASHES      = " ---------------------------------------------------------------------\n";
+    const char* const TIME_STAMP  = "Mon Jan 13 10:21:44 2025";
+    const char* const G16_LICENSE = " This is part of the Gaussian(R) 16 program.  It is based on\n"
+                                    " the Gaussian(R) 09 system (copyright 2009, Gaussian, Inc.),\n"
+                                    " the Gaussian(R) 03 system (copyright 2003, Gaussian, Inc.),\n"
+                                    " the Gaussian(R) 98 system (copyright 1998, Gaussian, Inc.).\n"
+                                    "  \n";
+}  // namespace
+
+// =============================================================================
+// SyntheticLogGenerator Implementation
+// =============================================================================
+
+SyntheticLogGenerator::SyntheticLogGenerator(const Options& options) : options_(options)
+{
+    options_.atoms = std::max(3u, options_.atoms);
+}
+
+const char* SyntheticLogGenerator::kind_name(Kind kind)
+{
+    switch (kind)
+    {
+        case Kind::OPT_FREQ:
+            return "opt-freq";
+        case Kind::TDDFT:
+            return "tddft";
+        case Kind::PCM_FAILURE:
+            return "pcm-failure";
+        case Kind::ERROR_TERMINATION:
+            return "error";
+        case Kind::MULTI_LINK:
+            return "multi-link";
+        case Kind::SINGLE_POINT:
+            return "single-point";
+    }
+    return "unknown";
+}
+
+bool SyntheticLogGenerator::parse_kind(const std::string& name, Kind& kind)
+{
+    for (Kind candidate : {Kind::OPT_FREQ,
+                           Kind::TDDFT,
+                           Kind::PCM_FAILURE,
+                           Kind::ERROR_TERMINATION,
+                           Kind::MULTI_LINK,
+                           Kind::SINGLE_POINT})
+    {
+        if (name == kind_name(candidate))
+        {
+            kind = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+std::vector<SyntheticLogGenerator::Atom> SyntheticLogGenerator::make_molecule(std::mt19937& rng) const
+{
+    // Organic skeleton with a heavy metal centre and a few heteroatoms, like the test complexes
+    static const int heavy[] = {6, 6, 6, 6, 7, 8, 15, 16, 17};
+
+    std::uniform_real_distribution<double> coordinate(-6.0, 6.0);
+    std::uniform_int_distribution<size_t>  element(0, sizeof(heavy) / sizeof(heavy[0]) - 1);
+
+    std::vector<Atom> atoms;
+    atoms.reserve(options_.atoms);
+    atoms.push_back({77, 0.0, 0.0, 0.0});
+    for (unsigned int i = 1; i < options_.atoms; ++i)
+    {
+        int number = (i % 2 == 0) ? 1 : heavy[element(rng)];
+        atoms.push_back({number, coordinate(rng), coordinate(rng), coordinate(rng)});
+    }
+    return atoms;
+}
+
+void SyntheticLogGenerator::write_header(std::ostream& out, const std::string& route, bool first_link) const
+{
+    if (first_link)
+    {
+        out << " Entering Gaussian System, Link 0=g16\n"
+            << " Input=bench.gau\n"
+            << " Output=bench.log\n"
+            << " Initial command:\n"
+            << " /apps/gaussian/g16c01/g16/l1.exe \"/scratch/Gau-1942014.inp\" -scrdir=\"/scratch/\"\n";
+    }
+    out << " Entering Link 1 = /apps/gaussian/g16c01/g16/l1.exe PID=   1942015.\n"
+        << "  \n"
+        << " Copyright (c) 1988-2019, Gaussian, Inc.  All Rights Reserved.\n"
+        << "  \n"
+        << G16_LICENSE << " ******************************************\n"
+        << " Gaussian 16:  ES64L-G16RevC.01  3-Jul-2019\n"
+        << " ******************************************\n"
+        << " %nprocshared=20\n"
+        << " %mem=60GB\n"
+        << DASHES << " " << route << "\n"
+        << DASHES;
+}
+
+void SyntheticLogGenerator::write_orientation(std::ostream& out, std::vector<Atom>& atoms, std::mt19937& rng) const
+{
+    std::normal_distribution<double> displacement(0.0, 0.002);
+
+    out << "                         Standard orientation:                         \n"
+        << DASHES << " Center     Atomic      Atomic             Coordinates (Angstroms)\n"
+        << " Number     Number       Type             X           Y           Z\n"
+        << DASHES;
+    double repulsion = 0.0;
+    for (size_t i = 0; i < atoms.size(); ++i)
+    {
+        Atom& atom = atoms[i];
+        atom.x += displacement(rng);
+        atom.y += displacement(rng);
+        atom.z += displacement(rng);
+        emit(out, " %6zu %10d %11d %15.6f %11.6f %11.6f\n", i + 1, atom.number, 0, atom.x, atom.y, atom.z);
+        repulsion += atom.number * 9.5;
+    }
+    out << DASHES;
+    emit(out, " Rotational constants (GHZ):      0.0620684      0.0581022      0.0550819\n");
+    emit(out, " %6zu basis functions,  %6zu primitive gaussians\n", atoms.size() * 12, atoms.size() * 21);
+    emit(out, "       nuclear repulsion energy %21.10f Hartrees.\n", repulsion);
+}
+
+void SyntheticLogGenerator::write_scf(std::ostream&            out,
+                                      const std::vector<Atom>& atoms,
+                                      double                   energy,
+                                      bool                     tddft,
+                                      std::mt19937&            rng) const
+{
+    std::uniform_int_distribution<int>     cycles(1, 24);
+    std::uniform_real_distribution<double> excitation(2.5, 4.5);
+
+    out << " SCF Done:  E(UwB97XD) =  ";
+    emit(out, "%.8f     A.U. after %4d cycles\n", energy, cycles(rng));
+    out << "            NFock= 21  Conv=0.25D-08     -V/T= 2.0049\n";
+
+    if (tddft)
+    {
+        double ev = 0.0;
+        for (int state = 1; state <= 3; ++state)
+        {
+            ev = excitation(rng);
+            emit(out,
+                 " Excited State %3d:      Singlet-A      %7.4f eV  %7.2f nm  f=%6.4f  <S**2>=0.000\n",
+                 state,
+                 ev,
+                 1239.84 / ev,
+                 ev / 100.0);
+            emit(out, "     %3d -> %3d         0.70%03d\n", 120 + state, 121 + state, state);
+        }
+        emit(out, " Total Energy, E(CIS/TDA) =  %.9f\n", energy + ev / 27.211386);
+    }
+
+    // Population analysis adds the bulk that the parsers skip in real logs
+    out << " Mulliken charges:\n"
+        << "               1\n";
+    std::uniform_real_distribution<double> charge(-0.6, 0.6);
+    for (size_t i = 0; i < atoms.size(); ++i)
+    {
+        emit(out, " %5zu  %-2s %12.6f\n", i + 1, element_symbol(atoms[i].number), charge(rng));
+    }
+    out << " Sum of Mulliken charges =   0.00000\n";
+}
+
+void SyntheticLogGenerator::write_convergence(std::ostream& out, bool converged, std::mt19937& rng) const
+{
+    std::uniform_real_distribution<double> scale(0.5, 5.0);
+    const char*                            flag = converged ? "YES" : "NO ";
+
+    emit(out, "         Item               Value     Threshold  Converged?\n");
+    emit(out, " Maximum Force            %.6f     0.000450     %s\n", converged ? 0.00001 : 0.001 * scale(rng), flag);
+    emit(out, " RMS     Force            %.6f     0.000300     %s\n", converged ? 0.000002 : 0.0005 * scale(rng), flag);
+    emit(out, " Maximum Displacement     %.6f     0.001800     %s\n", converged ? 0.0001 : 0.01 * scale(rng), flag);
+    emit(out, " RMS     Displacement     %.6f     0.001200     %s\n", converged ? 0.00005 : 0.004 * scale(rng), flag);
+    emit(out, " Predicted change in Energy=-%.6fD-07\n", scale(rng));
+    if (converged)
+    {
+        out << " Optimization completed.\n"
+            << "    -- Stationary point found.\n";
+    }
+}
+
+void SyntheticLogGenerator::write_frequencies(std::ostream&            out,
+                                              const std::vector<Atom>& atoms,
+                                              bool                     imaginary,
+                                              std::mt19937&            rng) const
+{
+    std::uniform_real_distribution<double> mode(-0.3, 0.3);
+    std::uniform_real_distribution<double> step(5.0, 60.0);
+
+    out << " Harmonic frequencies (cm**-1), IR intensities (KM/Mole), Raman scattering\n"
+        << " activities (A**4/AMU), depolarization ratios for plane and unpolarized\n"
+        << " incident light, reduced masses (AMU), force constants (mDyne/A),\n"
+        << " and normal coordinates:\n";
+
+    size_t modes     = 3 * atoms.size() - 6;
+    double frequency = imaginary ? -13.6 : 12.0;
+    for (size_t first = 0; first < modes; first += 3)
+    {
+        size_t block = std::min<size_t>(3, modes - first);
+        double values[3];
+        for (size_t k = 0; k < block; ++k)
+        {
+            values[k] = frequency;
+            frequency = std::fabs(frequency) + step(rng);
+        }
+
+        out << "                 ";
+        for (size_t k = 0; k < block; ++k)
+        {
+            emit(out, "%6zu                 ", first + k + 1);
+        }
+        out << "\n                 ";
+        for (size_t k = 0; k < block; ++k)
+        {
+            out << "     A                 ";
+        }
+        out << "\n Frequencies --";
+        for (size_t k = 0; k < block; ++k)
+        {
+            emit(out, " %11.4f           ", values[k]);
+        }
+        out << "\n Red. masses --";
+        for (size_t k = 0; k < block; ++k)
+        {
+            emit(out, " %11.4f           ", 4.9082);
+        }
+        out << "\n Frc consts  --";
+        for (size_t k = 0; k < block; ++k)
+        {
+            emit(out, " %11.4f           ", 0.0005 * (first + k + 1));
+        }
+        out << "\n IR Inten    --";
+        for (size_t k = 0; k < block; ++k)
+        {
+            emit(out, " %11.4f           ", 0.0365);
+        }
+        out << "\n  Atom  AN      X      Y      Z        X      Y      Z        X      Y      Z\n";
+        for (size_t i = 0; i < atoms.size(); ++i)
+        {
+            emit(out, " %5zu %3d ", i + 1, atoms[i].number);
+            for (size_t k = 0; k < block; ++k)
+            {
+                emit(out, "  %5.2f  %5.2f  %5.2f", mode(rng), mode(rng), mode(rng));
+            }
+            out << "\n";
+        }
+    }
+}
+
+void SyntheticLogGenerator::write_thermochemistry(std::ostream& out, double energy, std::mt19937& rng) const
+{
+    std::uniform_real_distribution<double> spread(0.98, 1.02);
+    double                                 zpe   = 0.0115 * options_.atoms * spread(rng);
+    double                                 gibbs = zpe * 0.89;
+
+    out << " -------------------\n"
+        << " - Thermochemistry -\n"
+        << " -------------------\n"
+        << " Temperature   298.150 Kelvin.  Pressure   1.00000 Atm.\n"
+        << " Thermochemistry will use frequencies scaled by 1.0000.\n";
+    emit(out, " Zero-point correction=                    %15.6f (Hartree/Particle)\n", zpe);
+    emit(out, " Thermal correction to Energy=             %15.6f\n", zpe * 1.065);
+    emit(out, " Thermal correction to Enthalpy=           %15.6f\n", zpe * 1.067);
+    emit(out, " Thermal correction to Gibbs Free Energy=  %15.6f\n", gibbs);
+    emit(out, " Sum of electronic and zero-point Energies=         %15.6f\n", energy + zpe);
+    emit(out, " Sum of electronic and thermal Energies=            %15.6f\n", energy + zpe * 1.065);
+    emit(out, " Sum of electronic and thermal Enthalpies=          %15.6f\n", energy + zpe * 1.067);
+    emit(out, " Sum of electronic and thermal Free Energies=       %15.6f\n", energy + gibbs);
+    out << "                     E (Thermal)             CV                S\n"
+        << "                      KCal/Mol        Cal/Mol-Kelvin    Cal/Mol-Kelvin\n";
+    emit(out, " Total              %9.3f          %9.3f          %9.3f\n", zpe * 668.0, 183.981, 280.776);
+}
+
+void SyntheticLogGenerator::write_normal_termination(std::ostream& out) const
+{
+    out << " Job cpu time:       0 days  6 hours 41 minutes 36.0 seconds.\n"
+        << " Elapsed time:       0 days  0 hours 27 minutes 29.0 seconds.\n"
+        << " File lengths (MBytes):  RWF=    512 Int=      0 D2E=      0 Chk=     42 Scr=      1\n"
+        << " Normal termination of Gaussian 16 at " << TIME_STAMP << ".\n";
+}
+
+uintmax_t SyntheticLogGenerator::write_log(Kind kind, size_t index, const std::string& path) const
+{
+    std::ofstream out(path, std::ios::binary);
+    if (!out)
+    {
+        throw std::runtime_error("Cannot write synthetic log: " + path);
+    }
+
+    std::seed_seq     seed{options_.seed, static_cast<uint32_t>(index), static_cast<uint32_t>(kind)};
+    std::mt19937      rng(seed);
+    std::vector<Atom> atoms  = make_molecule(rng);
+    double            energy = -38.5 * options_.atoms - std::uniform_real_distribution<double>(0.0, 5.0)(rng);
+
+    bool tddft     = kind == Kind::TDDFT;
+    bool imaginary = index % 8 == 7;  // Every eighth structure is a saddle point for the imode checker
+    std::string route;
+    switch (kind)
+    {
+        case Kind::TDDFT:
+            route = "# opt freq td=(nstates=3,root=1) uwb97xd/def2svpp scrf=(smd,solvent=acetonitrile)";
+            break;
+        case Kind::MULTI_LINK:
+            route = "# opt uwb97xd/def2svpp scrf=(smd,solvent=acetonitrile)";
+            break;
+        case Kind::SINGLE_POINT:
+            route = "# uwb97xd/def2tzvp scrf=(smd,solvent=acetonitrile)";
+            break;
+        default:
+            route = "# opt freq uwb97xd/def2svpp scrf=(smd,solvent=acetonitrile)";
+            break;
+    }
+    write_header(out, route, true);
+
+    if (kind == Kind::SINGLE_POINT)
+    {
+        write_orientation(out, atoms, rng);
+        write_scf(out, atoms, energy, false, rng);
+        write_normal_termination(out);
+        return static_cast<uintmax_t>(out.tellp());
+    }
+
+    // The frequency analysis is rendered first so the optimisation steps can fill the rest of the target
+    bool               has_frequencies = kind == Kind::OPT_FREQ || kind == Kind::TDDFT || kind == Kind::MULTI_LINK;
+    std::ostringstream frequencies;
+    if (has_frequencies)
+    {
+        write_frequencies(frequencies, atoms, imaginary, rng);
+    }
+
+    // Sizes vary by +-25% around the target, like a directory of optimisations that took different step counts
+    double         jitter       = std::uniform_real_distribution<double>(0.75, 1.25)(rng);
+    std::streamoff target       = static_cast<std::streamoff>(options_.target_bytes * jitter);
+    target                     -= static_cast<std::streamoff>(frequencies.tellp());
+    std::streamoff pcm_position = target / 2;
+    bool           pcm_written  = false;
+    do
+    {
+        write_orientation(out, atoms, rng);
+        energy -= 0.0005;
+        write_scf(out, atoms, energy, tddft, rng);
+        write_convergence(out, false, rng);
+
+        // Gaussian runs out of PCM memory mid-optimisation and the job is killed
+        if (kind == Kind::PCM_FAILURE && !pcm_written && out.tellp() >= pcm_position)
+        {
+            out << " Inv3 failed in PCMMkU.\n";
+            pcm_written = true;
+        }
+    } while (out.tellp() < target);
+
+    switch (kind)
+    {
+        case Kind::PCM_FAILURE:
+            if (!pcm_written)
+            {
+                out << " Inv3 failed in PCMMkU.\n";
+            }
+            break;
+        case Kind::ERROR_TERMINATION:
+            out << " Error in internal coordinate system.\n"
+                << " Error termination via Lnk1e in /apps/gaussian/g16c01/g16/l103.exe at " << TIME_STAMP << ".\n"
+                << " Job cpu time:       0 days  1 hours 12 minutes  3.4 seconds.\n";
+            break;
+        case Kind::MULTI_LINK:
+            write_convergence(out, true, rng);
+            write_normal_termination(out);
+            out << " Link1:  Proceeding to internal job step number  2.\n";
+            write_header(out, "# freq uwb97xd/def2svpp geom=check guess=read scrf=(smd,solvent=acetonitrile)", false);
+            write_orientation(out, atoms, rng);
+            write_scf(out, atoms, energy, false, rng);
+            out << frequencies.str();
+            write_thermochemistry(out, energy, rng);
+            write_normal_termination(out);
+            break;
+        default:
+            write_convergence(out, true, rng);
+            out << frequencies.str();
+            write_thermochemistry(out, energy, rng);
+            write_normal_termination(out);
+            break;
+    }
+
+    if (!out)
+    {
+        throw std::runtime_error("Error writing synthetic log: " + path);
+    }
+    return static_cast<uintmax_t>(out.tellp());
+}
+
+uintmax_t SyntheticLogGenerator::write_xyz(size_t index, const std::string& path) const
+{
+    std::ofstream out(path, std::ios::binary);
+    if (!out)
+    {
+        throw std::runtime_error("Cannot write synthetic XYZ file: " + path);
+    }
+
+    std::seed_seq     seed{options_.seed, static_cast<uint32_t>(index), 0xC1u};
+    std::mt19937      rng(seed);
+    std::vector<Atom> atoms = make_molecule(rng);
+
+    out << atoms.size() << "\n"
+        << "Synthetic structure " << index << "\n";
+    for (const auto& atom : atoms)
+    {
+        emit(out, "%-2s %14.8f %14.8f %14.8f\n", element_symbol(atom.number), atom.x, atom.y, atom.z);
+    }
+    return static_cast<uintmax_t>(out.tellp());
+}
@@ -0,0 +1,134 @@
+/**
+ * @file synthetic_log.h
+ * @brief Generator of synthetic Gaussian output files for benchmarking
+ * @author Le Nhan Pham
+ * @date 2025
+ *
+ * This header provides the generator behind the bench target. It writes
+ * Gaussian 16 style log files whose sections follow the real outputs in
+ * tests/extract-xyz (Standard orientation blocks, SCF energies, convergence
+ * tables, harmonic frequencies and the thermochemistry summary), so every
+ * command of the extractor finds the lines it parses in the same shape and at
+ * the same places as in production logs.
+ *
+ * @section Size Control
+ * The length of a log is controlled by the number of atoms and by a target
+ * size: optimisation steps are appended until the file reaches the target,
+ * which makes the per-file cost scale the way long optimisations do. Each
+ * file's target varies by up to 25% either way so that a corpus has the
+ * uneven sizes of a real project directory. The frequency analysis alone
+ * grows with the square of the atom count and may exceed small targets.
+ *
+ * @section Reproducibility
+ * All numbers are drawn from a std::mt19937 seeded with the corpus seed and
+ * the file index, so the same options always produce byte-identical corpora.
+ */
+
+#ifndef SYNTHETIC_LOG_H
+#define SYNTHETIC_LOG_H
+
+#include <cstdint>
+#include <ostream>
+#include <random>
+#include <string>
+#include <vector>
+
+/**
+ * @class SyntheticLogGenerator
+ * @brief Writes synthetic Gaussian logs and XYZ files of a chosen shape
+ */
+class SyntheticLogGenerator
+{
+public:
+    /**
+     * @enum Kind
+     * @brief Shape of a generated log
+     */
+    enum class Kind
+    {
+        OPT_FREQ,           ///< Optimisation + frequencies ending in normal termination
+        TDDFT,              ///< TD-DFT optimisation + frequencies with "Total Energy, E(CIS/TDA)" lines
+        PCM_FAILURE,        ///< Optimisation that stops after "failed in PCMMkU" without termination
+        ERROR_TERMINATION,  ///< Optimisation ending in "Error termination via Lnk1e"
+        MULTI_LINK,         ///< Optimisation step and a frequency job joined by Link1
+        SINGLE_POINT        ///< Single point energy, used as the high-level corpus
+    };
+
+    /**
+     * @struct Options
+     * @brief Size of each generated log
+     */
+    struct Options
+    {
+        unsigned int atoms;         ///< Atoms per molecule
+        uintmax_t    target_bytes;  ///< Approximate size of each log; at least one step is written
+        uint32_t     seed;          ///< Corpus seed
+
+        Options() : atoms(40), target_bytes(512 * 1024), seed(42) {}
+    };
+
+    /**
+     * @brief Create a generator
+     * @param options Atom count, target size and seed shared by all files
+     */
+    explicit SyntheticLogGenerator(const Options& options);
+
+    /**
+     * @brief Write one log
+     * @param kind Shape of the log
+     * @param index Index of the file in the corpus; selects the random stream
+     * @param path Output path
+     * @return Number of bytes written
+     * @throws std::runtime_error if the file cannot be written
+     */
+    uintmax_t write_log(Kind kind, size_t index, const std::string& path) const;
+
+    /**
+     * @brief Write one XYZ file of the same molecule family
+     * @param index Index of the file in the corpus
+     * @param path Output path
+     * @return Number of bytes written
+     * @throws std::runtime_error if the file cannot be written
+     */
+    uintmax_t write_xyz(size_t index, const std::string& path) const;
+
+    /**
+     * @brief Name of a kind as used on the command line ("opt-freq", "tddft", ...)
+     */
+    static const char* kind_name(Kind kind);
+
+    /**
+     * @brief Parse a kind name
+     * @param name Name as returned by kind_name()
+     * @param kind Set to the parsed kind
+     * @return False if the name is unknown
+     */
+    static bool parse_kind(const std::string& name, Kind& kind);
+
+private:
+    struct Atom
+    {
+        int    number;  ///< Atomic number
+        double x;       ///< Cartesian coordinates in Angstrom
+        double y;
+        double z;
+    };
+
+    std::vector<Atom> make_molecule(std::mt19937& rng) const;
+
+    void write_header(std::ostream& out, const std::string& route, bool first_link) const;
+    void write_orientation(std::ostream& out, std::vector<Atom>& atoms, std::mt19937& rng) const;
+    void write_scf(std::ostream&            out,
+                   const std::vector<Atom>& atoms,
+                   double                   energy,
+                   bool                     tddft,
+                   std::mt19937&            rng) const;
+    void write_convergence(std::ostream& out, bool converged, std::mt19937& rng) const;
+    void write_frequencies(std::ostream& out, const std::vector<Atom>& atoms, bool imaginary, std::mt19937& rng) const;
+    void write_thermochemistry(std::ostream& out, double energy, std::mt19937& rng) const;
+    void write_normal_termination(std::ostream& out) const;
+
+    Options options_;  ///< Options shared by every file of the corpus
+};
+
+#endif  // SYNTHETIC_LOG_H
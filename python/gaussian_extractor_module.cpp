@@ -0,0 +1,724 @@
+/**
+ * @file gaussian_extractor_module.cpp
+ * @brief Python bindings of the in-process extraction API (CPython C API)
+ * @author Le Nhan Pham
+ * @date 2025
+ *
+ * Builds the "gaussian_extractor" Python module on top of ExtractSession. It
+ * uses only the Python C API, so it builds wherever the Python headers are
+ * installed; NumPy and pyarrow are used when present but not required.
+ *
+ * Numeric and flag columns are handed to Python as read-only memoryviews
+ * that point into the batch's own buffers and keep the batch alive, so
+ * nothing is copied: numpy.asarray() and pyarrow.py_buffer() wrap them as
+ * they are. to_arrow() builds a pyarrow.RecordBatch over the same buffers;
+ * only BOOL columns are converted, since Arrow packs them into bits.
+ *
+ * Example:
+ * @code
+ * import gaussian_extractor as gx
+ * session = gx.Session(threads=8, use_result_index=True)
+ * batch = session.extract_many(["ts1.log", "ts2.log"])
+ * gibbs = numpy.asarray(batch.column("etg_hartree"))  # float64, no copy
+ * table = batch.to_arrow()                            # pyarrow.RecordBatch
+ * @endcode
+ *
+ * The GIL is released while logs are scanned. Sessions share the process-wide
+ * executor, so extract_many() calls from several Python threads run one at a
+ * time.
+ */
+
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+
+#include "extraction/custom_fields.h"
+#include "extraction/extract_session.h"
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    /**
+     * @brief Serializes extract_many() calls, which share TaskExecutor::shared()
+     */
+    std::mutex g_extract_mutex;
+
+    // =========================================================================
+    // Buffer: read-only view of one array of a batch
+    // =========================================================================
+
+    /**
+     * @brief Exporter of a batch array through the buffer protocol
+     *
+     * Only ever wrapped in a memoryview; holds a reference to the Batch that
+     * owns the memory.
+     */
+    struct BufferObject
+    {
+        PyObject_HEAD
+        PyObject*   owner;     ///< Batch owning the memory
+        const void* data;      ///< First element
+        Py_ssize_t  length;    ///< Number of elements
+        Py_ssize_t  itemsize;  ///< Bytes per element
+        const char* format;    ///< struct module format of an element
+    };
+
+    int buffer_getbuffer(PyObject* self, Py_buffer* view, int flags)
+    {
+        auto* buffer = reinterpret_cast<BufferObject*>(self);
+        if (flags & PyBUF_WRITABLE)
+        {
+            PyErr_SetString(PyExc_BufferError, "Batch columns are read-only");
+            view->obj = nullptr;
+            return -1;
+        }
+        Py_INCREF(self);
+        view->obj        = self;
+        view->buf        = const_cast<void*>(buffer->data);
+        view->len        = buffer->length * buffer->itemsize;
+        view->readonly   = 1;
+        view->itemsize   = buffer->itemsize;
+        view->format     = (flags & PyBUF_FORMAT) ? const_cast<char*>(buffer->format) : nullptr;
+        view->ndim       = 1;
+        view->shape      = (flags & PyBUF_ND) ? &buffer->length : nullptr;
+        view->strides    = (flags & PyBUF_STRIDES) ? &buffer->itemsize : nullptr;
+        view->suboffsets = nullptr;
+        view->internal   = nullptr;
+        return 0;
+    }
+
+    void buffer_dealloc(PyObject* self)
+    {
+        Py_XDECREF(reinterpret_cast<BufferObject*>(self)->owner);
+        Py_TYPE(self)->tp_free(self);
+    }
+
+    PyBufferProcs buffer_procs = {buffer_getbuffer, nullptr};
+
+    /**
+     * @brief Empty static type object; its slots are filled in by ready_types()
+     */
+    PyTypeObject static_type()
+    {
+        PyTypeObject type{};
+        Py_SET_REFCNT(reinterpret_cast<PyObject*>(&type), 1);
+        return type;
+    }
+
+    PyTypeObject BufferType = static_type();
+
+    /**
+     * @brief Read-only memoryview of an array owned by a batch
+     */
+    template <typename T>
+    PyObject* view(PyObject* owner, const T* data, size_t length, const char* format)
+    {
+        static const T empty{};
+        auto*          buffer = PyObject_New(BufferObject, &BufferType);
+        if (!buffer)
+        {
+            return nullptr;
+        }
+        Py_INCREF(owner);
+        buffer->owner    = owner;
+        buffer->data     = data ? data : &empty;
+        buffer->length   = static_cast<Py_ssize_t>(length);
+        buffer->itemsize = static_cast<Py_ssize_t>(sizeof(T));
+        buffer->format   = format;
+        PyObject* memory = PyMemoryView_FromObject(reinterpret_cast<PyObject*>(buffer));
+        Py_DECREF(buffer);
+        return memory;
+    }
+
+    // =========================================================================
+    // Batch: results table of one extract_many() call
+    // =========================================================================
+
+    struct BatchObject
+    {
+        PyObject_HEAD
+        ColumnarBatch* batch;  ///< Owned results table
+    };
+
+    PyTypeObject BatchType = static_type();
+
+    void batch_dealloc(PyObject* self)
+    {
+        delete reinterpret_cast<BatchObject*>(self)->batch;
+        Py_TYPE(self)->tp_free(self);
+    }
+
+    const ColumnarBatch& batch_of(PyObject* self)
+    {
+        return *reinterpret_cast<BatchObject*>(self)->batch;
+    }
+
+    Py_ssize_t batch_length(PyObject* self)
+    {
+        return static_cast<Py_ssize_t>(batch_of(self).row_count());
+    }
+
+    /**
+     * @brief Index of a column by name, or -1 with KeyError set
+     */
+    Py_ssize_t column_index(PyObject* self, PyObject* name)
+    {
+        const char* text = PyUnicode_AsUTF8(name);
+        if (!text)
+        {
+            return -1;
+        }
+        size_t column = batch_of(self).find(text);
+        if (column == batch_of(self).columns().size())
+        {
+            PyErr_Format(PyExc_KeyError, "No column '%s' in the batch", text);
+            return -1;
+        }
+        return static_cast<Py_ssize_t>(column);
+    }
+
+    /**
+     * @brief Values of one column: a memoryview for numbers and flags, a list of str for text
+     */
+    PyObject* column_values(PyObject* self, size_t column)
+    {
+        const ColumnarBatch& batch = batch_of(self);
+        size_t               rows  = batch.row_count();
+        switch (batch.columns()[column].type)
+        {
+            case ColumnarWriter::Type::FLOAT64:
+                return view(self, batch.doubles(column).data(), rows, "d");
+            case ColumnarWriter::Type::INT32:
+                return view(self, batch.ints(column).data(), rows, "i");
+            case ColumnarWriter::Type::BOOL:
+                return view(self, batch.bools(column).data(), rows, "?");
+            case ColumnarWriter::Type::STRING:
+            default:
+            {
+                PyObject* values = PyList_New(static_cast<Py_ssize_t>(rows));
+                for (size_t row = 0; values && row < rows; ++row)
+                {
+                    std::string_view text = batch.get_string(column, row);
+                    PyObject* item = PyUnicode_DecodeUTF8(text.data(), static_cast<Py_ssize_t>(text.size()), "replace");
+                    if (!item)
+                    {
+                        Py_CLEAR(values);
+                        break;
+                    }
+                    PyList_SET_ITEM(values, static_cast<Py_ssize_t>(row), item);
+                }
+                return values;
+            }
+        }
+    }
+
+    /**
+     * @brief (offsets, bytes) memoryviews of a STRING column in the Arrow layout
+     */
+    PyObject* string_buffers(PyObject* self, size_t column)
+    {
+        const ColumnarBatch& batch = batch_of(self);
+        if (batch.columns()[column].type != ColumnarWriter::Type::STRING)
+        {
+            PyErr_Format(PyExc_TypeError, "Column '%s' is not a text column", batch.columns()[column].name.c_str());
+            return nullptr;
+        }
+        const std::vector<int32_t>& offsets = batch.string_offsets(column);
+        const std::string&          bytes   = batch.string_data(column);
+        PyObject* offset_view = view(self, offsets.data(), offsets.size(), "i");
+        PyObject* byte_view   = offset_view ? view(self, reinterpret_cast<const uint8_t*>(bytes.data()), bytes.size(), "B")
+                                            : nullptr;
+        if (!byte_view)
+        {
+            Py_XDECREF(offset_view);
+            return nullptr;
+        }
+        return Py_BuildValue("(NN)", offset_view, byte_view);
+    }
+
+    PyObject* batch_column(PyObject* self, PyObject* name)
+    {
+        Py_ssize_t column = column_index(self, name);
+        return column < 0 ? nullptr : column_values(self, static_cast<size_t>(column));
+    }
+
+    PyObject* batch_string_buffers(PyObject* self, PyObject* name)
+    {
+        Py_ssize_t column = column_index(self, name);
+        return column < 0 ? nullptr : string_buffers(self, static_cast<size_t>(column));
+    }
+
+    PyObject* batch_to_dict(PyObject* self, PyObject*)
+    {
+        PyObject* values = PyDict_New();
+        for (size_t column = 0; values && column < batch_of(self).columns().size(); ++column)
+        {
+            PyObject* column_object = column_values(self, column);
+            if (!column_object ||
+                PyDict_SetItemString(values, batch_of(self).columns()[column].name.c_str(), column_object) < 0)
+            {
+                Py_XDECREF(column_object);
+                Py_CLEAR(values);
+                break;
+            }
+            Py_DECREF(column_object);
+        }
+        return values;
+    }
+
+    /**
+     * @brief pyarrow.Array of one column over the batch's buffers
+     */
+    PyObject* arrow_array(PyObject* self, PyObject* pa, size_t column)
+    {
+        const ColumnarBatch& batch = batch_of(self);
+        Py_ssize_t           rows  = static_cast<Py_ssize_t>(batch.row_count());
+        const char*          type  = nullptr;
+        PyObject*            data  = nullptr;
+        PyObject*            buffers;
+        switch (batch.columns()[column].type)
+        {
+            case ColumnarWriter::Type::BOOL:
+            {
+                // Arrow stores booleans as bits: convert through a list
+                PyObject* flags  = column_values(self, column);
+                PyObject* values = flags ? PyObject_CallMethod(flags, "tolist", nullptr) : nullptr;
+                Py_XDECREF(flags);
+                if (!values)
+                {
+                    return nullptr;
+                }
+                PyObject* array = PyObject_CallMethod(pa, "array", "(Os)", values, "bool");
+                Py_DECREF(values);
+                return array;
+            }
+            case ColumnarWriter::Type::FLOAT64:
+                type = "float64";
+                data = column_values(self, column);
+                break;
+            case ColumnarWriter::Type::INT32:
+                type = "int32";
+                data = column_values(self, column);
+                break;
+            case ColumnarWriter::Type::STRING:
+            default:
+                type = "string";
+                data = string_buffers(self, column);
+                break;
+        }
+        if (!data)
+        {
+            return nullptr;
+        }
+
+        if (PyTuple_Check(data))
+        {
+            PyObject* offsets = PyObject_CallMethod(pa, "py_buffer", "(O)", PyTuple_GET_ITEM(data, 0));
+            PyObject* bytes   = offsets ? PyObject_CallMethod(pa, "py_buffer", "(O)", PyTuple_GET_ITEM(data, 1)) : nullptr;
+            buffers           = bytes ? Py_BuildValue("[ONN]", Py_None, offsets, bytes) : nullptr;
+            if (!bytes)
+            {
+                Py_XDECREF(offsets);
+            }
+        }
+        else
+        {
+            PyObject* values = PyObject_CallMethod(pa, "py_buffer", "(O)", data);
+            buffers          = values ? Py_BuildValue("[ON]", Py_None, values) : nullptr;
+        }
+        Py_DECREF(data);
+        if (!buffers)
+        {
+            return nullptr;
+        }
+
+        PyObject* arrow_type = PyObject_CallMethod(pa, type, nullptr);
+        PyObject* array_type = arrow_type ? PyObject_GetAttrString(pa, "Array") : nullptr;
+        PyObject* array      = array_type ? PyObject_CallMethod(array_type, "from_buffers", "(OnO)", arrow_type, rows,
+                                                                buffers)
+                                          : nullptr;
+        Py_XDECREF(array_type);
+        Py_XDECREF(arrow_type);
+        Py_DECREF(buffers);
+        return array;
+    }
+
+    PyObject* batch_to_arrow(PyObject* self, PyObject*)
+    {
+        PyObject* pa = PyImport_ImportModule("pyarrow");
+        if (!pa)
+        {
+            return nullptr;
+        }
+        const ColumnarBatch& batch  = batch_of(self);
+        PyObject*            arrays = PyList_New(0);
+        PyObject*            names  = PyList_New(0);
+        PyObject*            result = nullptr;
+        bool                 ok     = arrays && names;
+        for (size_t column = 0; ok && column < batch.columns().size(); ++column)
+        {
+            PyObject* array = arrow_array(self, pa, column);
+            PyObject* name  = PyUnicode_FromString(batch.columns()[column].name.c_str());
+            ok              = array && name && PyList_Append(arrays, array) == 0 && PyList_Append(names, name) == 0;
+            Py_XDECREF(array);
+            Py_XDECREF(name);
+        }
+        if (ok)
+        {
+            PyObject* record_batch = PyObject_GetAttrString(pa, "RecordBatch");
+            PyObject* from_arrays  = record_batch ? PyObject_GetAttrString(record_batch, "from_arrays") : nullptr;
+            PyObject* args         = from_arrays ? Py_BuildValue("(O)", arrays) : nullptr;
+            PyObject* kwargs       = args ? Py_BuildValue("{sO}", "names", names) : nullptr;
+            result                 = kwargs ? PyObject_Call(from_arrays, args, kwargs) : nullptr;
+            Py_XDECREF(kwargs);
+            Py_XDECREF(args);
+            Py_XDECREF(from_arrays);
+            Py_XDECREF(record_batch);
+        }
+        Py_XDECREF(names);
+        Py_XDECREF(arrays);
+        Py_DECREF(pa);
+        return result;
+    }
+
+    PyObject* batch_columns(PyObject* self, void*)
+    {
+        const auto& columns = batch_of(self).columns();
+        PyObject*   names   = PyList_New(static_cast<Py_ssize_t>(columns.size()));
+        for (size_t column = 0; names && column < columns.size(); ++column)
+        {
+            PyObject* name = PyUnicode_FromString(columns[column].name.c_str());
+            if (!name)
+            {
+                Py_CLEAR(names);
+                break;
+            }
+            PyList_SET_ITEM(names, static_cast<Py_ssize_t>(column), name);
+        }
+        return names;
+    }
+
+    PyMethodDef batch_methods[] = {
+        {"column", batch_column, METH_O,
+         "column(name): values of a column; numbers and flags as a read-only memoryview of the batch, text as a "
+         "list of str"},
+        {"string_buffers", batch_string_buffers, METH_O,
+         "string_buffers(name): (offsets, bytes) of a text column in the Arrow string layout, without copying"},
+        {"to_dict", batch_to_dict, METH_NOARGS, "Every column by name, as column() returns it"},
+        {"to_arrow", batch_to_arrow, METH_NOARGS, "The batch as a pyarrow.RecordBatch sharing its buffers"},
+        {nullptr, nullptr, 0, nullptr}};
+
+    PyGetSetDef batch_getset[] = {{"columns", batch_columns, nullptr, "Column names, in order", nullptr},
+                                  {nullptr, nullptr, nullptr, nullptr, nullptr}};
+
+    PySequenceMethods batch_sequence{};
+
+    // =========================================================================
+    // Session: threads, limits and result index kept alive between calls
+    // =========================================================================
+
+    struct SessionObject
+    {
+        PyObject_HEAD
+        ExtractSession* session;  ///< Owned session (nullptr until __init__ succeeded)
+    };
+
+    PyTypeObject SessionType = static_type();
+
+    void session_dealloc(PyObject* self)
+    {
+        delete reinterpret_cast<SessionObject*>(self)->session;
+        Py_TYPE(self)->tp_free(self);
+    }
+
+    ExtractSession* session_of(PyObject* self)
+    {
+        ExtractSession* session = reinterpret_cast<SessionObject*>(self)->session;
+        if (!session)
+        {
+            PyErr_SetString(PyExc_RuntimeError, "Session was not initialized");
+        }
+        return session;
+    }
+
+    bool parse_scan_mode(const char* text, ScanMode& mode)
+    {
+        std::string name = text;
+        if (name == "fast")
+            mode = ScanMode::FAST;
+        else if (name == "tail")
+            mode = ScanMode::TAIL;
+        else if (name == "legacy")
+            mode = ScanMode::LEGACY;
+        else if (name == "verify")
+            mode = ScanMode::VERIFY;
+        else
+            return false;
+        return true;
+    }
+
+    /**
+     * @brief (name, spec) pairs of the fields argument
+     */
+    bool parse_fields(PyObject* fields, std::vector<std::pair<std::string, std::string>>& pairs)
+    {
+        PyObject* sequence = PySequence_Fast(fields, "fields must be a sequence of (name, spec) pairs");
+        if (!sequence)
+        {
+            return false;
+        }
+        bool ok = true;
+        for (Py_ssize_t i = 0; ok && i < PySequence_Fast_GET_SIZE(sequence); ++i)
+        {
+            const char* name = nullptr;
+            const char* spec = nullptr;
+            ok = PyArg_ParseTuple(PySequence_Fast_GET_ITEM(sequence, i), "ss;fields must hold (name, spec) pairs",
+                                  &name, &spec);
+            if (ok)
+            {
+                pairs.emplace_back(name, spec);
+            }
+        }
+        Py_DECREF(sequence);
+        return ok;
+    }
+
+    int session_init(PyObject* self, PyObject* args, PyObject* kwargs)
+    {
+        static const char* keywords[] = {"temp",    "concentration",   "use_input_temp",   "threads",
+                                         "scan_mode", "memory_limit_mb", "use_result_index", "index_path",
+                                         "fields",  nullptr};
+        ExtractOptions options;
+        int            use_input_temp   = 0;
+        int            use_result_index = 0;
+        unsigned int   threads          = 0;
+        Py_ssize_t     memory_limit_mb  = 0;
+        const char*    scan_mode        = "fast";
+        const char*    index_path       = RESULT_INDEX_FILENAME.c_str();
+        PyObject*      fields           = nullptr;
+        if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|dipIsnpsO:Session", const_cast<char**>(keywords),
+                                         &options.temp, &options.concentration, &use_input_temp, &threads,
+                                         &scan_mode, &memory_limit_mb, &use_result_index, &index_path, &fields))
+        {
+            return -1;
+        }
+        if (!parse_scan_mode(scan_mode, options.scan_mode))
+        {
+            PyErr_Format(PyExc_ValueError, "Unknown scan_mode '%s' (fast, tail, legacy or verify)", scan_mode);
+            return -1;
+        }
+        if (memory_limit_mb < 0)
+        {
+            PyErr_SetString(PyExc_ValueError, "memory_limit_mb must not be negative");
+            return -1;
+        }
+        options.use_input_temp   = use_input_temp != 0;
+        options.use_result_index = use_result_index != 0;
+        options.threads          = threads;
+        options.memory_limit_mb  = static_cast<size_t>(memory_limit_mb);
+        options.index_path       = index_path;
+
+        std::vector<std::pair<std::string, std::string>> pairs;
+        if (fields && fields != Py_None && !parse_fields(fields, pairs))
+        {
+            return -1;
+        }
+        try
+        {
+            if (!pairs.empty())
+            {
+                std::vector<std::string> errors;
+                options.custom_fields = CustomFieldSet::from_config(pairs, errors);
+                if (!errors.empty())
+                {
+                    PyErr_SetString(PyExc_ValueError, errors.front().c_str());
+                    return -1;
+                }
+            }
+            auto* session = reinterpret_cast<SessionObject*>(self);
+            delete session->session;
+            session->session = new ExtractSession(options);
+        }
+        catch (const std::exception& e)
+        {
+            PyErr_SetString(PyExc_RuntimeError, e.what());
+            return -1;
+        }
+        return 0;
+    }
+
+    PyObject* session_extract_many(PyObject* self, PyObject* paths)
+    {
+        ExtractSession* session = session_of(self);
+        if (!session)
+        {
+            return nullptr;
+        }
+        PyObject* sequence = PySequence_Fast(paths, "paths must be a sequence of file paths");
+        if (!sequence)
+        {
+            return nullptr;
+        }
+        std::vector<std::string> files;
+        for (Py_ssize_t i = 0; i < PySequence_Fast_GET_SIZE(sequence); ++i)
+        {
+            PyObject* encoded = nullptr;
+            if (!PyUnicode_FSConverter(PySequence_Fast_GET_ITEM(sequence, i), &encoded))
+            {
+                Py_DECREF(sequence);
+                return nullptr;
+            }
+            files.emplace_back(PyBytes_AS_STRING(encoded), static_cast<size_t>(PyBytes_GET_SIZE(encoded)));
+            Py_DECREF(encoded);
+        }
+        Py_DECREF(sequence);
+
+        std::unique_ptr<ColumnarBatch> batch;
+        std::string                    error;
+        Py_BEGIN_ALLOW_THREADS
+        try
+        {
+            std::lock_guard<std::mutex> lock(g_extract_mutex);
+            batch = std::make_unique<ColumnarBatch>(session->extract_many(files));
+        }
+        catch (const std::exception& e)
+        {
+            error = e.what();
+        }
+        Py_END_ALLOW_THREADS
+
+        if (!batch)
+        {
+            PyErr_SetString(PyExc_RuntimeError, error.c_str());
+            return nullptr;
+        }
+        auto* result = PyObject_New(BatchObject, &BatchType);
+        if (result)
+        {
+            result->batch = batch.release();
+        }
+        return reinterpret_cast<PyObject*>(result);
+    }
+
+    PyObject* session_take_errors(PyObject* self, PyObject*)
+    {
+        ExtractSession* session = session_of(self);
+        if (!session)
+        {
+            return nullptr;
+        }
+        std::vector<std::string> errors = session->take_errors();
+        PyObject*                list   = PyList_New(static_cast<Py_ssize_t>(errors.size()));
+        for (size_t i = 0; list && i < errors.size(); ++i)
+        {
+            PyObject* item = PyUnicode_DecodeUTF8(errors[i].data(), static_cast<Py_ssize_t>(errors[i].size()), "replace");
+            if (!item)
+            {
+                Py_CLEAR(list);
+                break;
+            }
+            PyList_SET_ITEM(list, static_cast<Py_ssize_t>(i), item);
+        }
+        return list;
+    }
+
+    PyObject* session_save_index(PyObject* self, PyObject*)
+    {
+        ExtractSession* session = session_of(self);
+        if (!session)
+        {
+            return nullptr;
+        }
+        bool saved;
+        Py_BEGIN_ALLOW_THREADS
+        saved = session->save_index();
+        Py_END_ALLOW_THREADS
+        return PyBool_FromLong(saved);
+    }
+
+    PyObject* session_thread_count(PyObject* self, void*)
+    {
+        ExtractSession* session = session_of(self);
+        return session ? PyLong_FromUnsignedLong(session->thread_count()) : nullptr;
+    }
+
+    PyMethodDef session_methods[] = {
+        {"extract_many", session_extract_many, METH_O,
+         "extract_many(paths): scan logs and return their results table as a Batch, one row per path"},
+        {"take_errors", session_take_errors, METH_NOARGS, "Errors and warnings since the last call"},
+        {"save_index", session_save_index, METH_NOARGS, "Write the result index now"},
+        {nullptr, nullptr, 0, nullptr}};
+
+    PyGetSetDef session_getset[] = {
+        {"thread_count", session_thread_count, nullptr, "Worker threads used by extract_many()", nullptr},
+        {nullptr, nullptr, nullptr, nullptr, nullptr}};
+
+    PyModuleDef module_definition = {PyModuleDef_HEAD_INIT, "gaussian_extractor",
+                                     "In-process Gaussian log extraction with zero-copy column buffers", -1, nullptr,
+                                     nullptr, nullptr, nullptr, nullptr};
+
+    /**
+     * @brief Fill in the type objects (designated initializers are C++20)
+     */
+    bool ready_types()
+    {
+        BufferType.tp_name      = "gaussian_extractor._Buffer";
+        BufferType.tp_basicsize = sizeof(BufferObject);
+        BufferType.tp_dealloc   = buffer_dealloc;
+        BufferType.tp_as_buffer = &buffer_procs;
+        BufferType.tp_flags     = Py_TPFLAGS_DEFAULT;
+        BufferType.tp_doc       = "Read-only array of a Batch (wrapped in a memoryview)";
+
+        BatchType.tp_name        = "gaussian_extractor.Batch";
+        BatchType.tp_basicsize   = sizeof(BatchObject);
+        BatchType.tp_dealloc     = batch_dealloc;
+        batch_sequence.sq_length = batch_length;
+        BatchType.tp_as_sequence = &batch_sequence;
+        BatchType.tp_flags       = Py_TPFLAGS_DEFAULT;
+        BatchType.tp_doc         = "Results table of one extract_many() call";
+        BatchType.tp_methods     = batch_methods;
+        BatchType.tp_getset      = batch_getset;
+
+        SessionType.tp_name      = "gaussian_extractor.Session";
+        SessionType.tp_basicsize = sizeof(SessionObject);
+        SessionType.tp_dealloc   = session_dealloc;
+        SessionType.tp_flags     = Py_TPFLAGS_DEFAULT;
+        SessionType.tp_doc =
+            "Session(temp=298.15, concentration=1000, use_input_temp=False, threads=0, scan_mode='fast', "
+            "memory_limit_mb=0, use_result_index=False, index_path='.gaussian_extractor.idx', fields=())\n\n"
+            "Threads, limits and result index kept alive between extract_many() calls. fields: (name, spec) "
+            "pairs in column order, as the field.<name> configuration entries.";
+        SessionType.tp_methods = session_methods;
+        SessionType.tp_getset  = session_getset;
+        SessionType.tp_init    = session_init;
+        SessionType.tp_new     = PyType_GenericNew;
+
+        return PyType_Ready(&BufferType) == 0 && PyType_Ready(&BatchType) == 0 && PyType_Ready(&SessionType) == 0;
+    }
+}  // namespace
+
+PyMODINIT_FUNC PyInit_gaussian_extractor()
+{
+    if (!ready_types())
+    {
+        return nullptr;
+    }
+    PyObject* module = PyModule_Create(&module_definition);
+    if (!module)
+    {
+        return nullptr;
+    }
+    Py_INCREF(&BatchType);
+    Py_INCREF(&SessionType);
+    if (PyModule_AddObject(module, "Batch", reinterpret_cast<PyObject*>(&BatchType)) < 0 ||
+        PyModule_AddObject(module, "Session", reinterpret_cast<PyObject*>(&SessionType)) < 0)
+    {
+        Py_DECREF(module);
+        return nullptr;
+    }
+    return module;
+}
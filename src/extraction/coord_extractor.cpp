@@ -1,11 +1,20 @@
 #include "coord_extractor.h"
+#include "extraction/log_scanner.h"
 #include "job_management/job_checker.h"
+#include "utilities/compressed_input.h"
+#include "utilities/move_planner.h"
+#include "utilities/profiler.h"
+#include "utilities/task_executor.h"
 #include "utilities/utils.h"
+#include <algorithm>
 #include <atomic>
+#include <charconv>
 #include <chrono>
+#include <cstdio>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <memory>
 #include <mutex>
 #include <sstream>
 #include <string>
@@ -17,7 +26,56 @@
 // External global for shutdown
 extern std::atomic<bool> g_shutdown_requested;
 
-CoordExtractor::CoordExtractor(std::shared_ptr<ProcessingContext> ctx, bool quiet) : context(ctx), quiet_mode(quiet) {}
+namespace
+{
+    inline bool is_row_space(char c)
+    {
+        return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+    }
+
+    /**
+     * @brief Parse the next whitespace-separated number of an atom row in place
+     */
+    template <typename T>
+    bool next_field(std::string_view& row, T& value)
+    {
+        while (!row.empty() && is_row_space(row.front()))
+        {
+            row.remove_prefix(1);
+        }
+        auto result = std::from_chars(row.data(), row.data() + row.size(), value);
+        if (result.ec != std::errc())
+        {
+            return false;
+        }
+        row.remove_prefix(static_cast<size_t>(result.ptr - row.data()));
+        return true;
+    }
+
+    /**
+     * @brief Append a coordinate right-aligned in 20 columns with 10 decimals (iostream std::fixed layout)
+     */
+    void append_coordinate(std::string& out, double value)
+    {
+        char buffer[64];
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+        auto   result = std::to_chars(buffer, buffer + sizeof(buffer), value, std::chars_format::fixed, 10);
+        size_t length = result.ec == std::errc() ? static_cast<size_t>(result.ptr - buffer) : 0;
+#else
+        int    written = std::snprintf(buffer, sizeof(buffer), "%.10f", value);
+        size_t length  = written > 0 ? std::min(static_cast<size_t>(written), sizeof(buffer) - 1) : 0;
+#endif
+        if (length < 20)
+        {
+            out.append(20 - length, ' ');
+        }
+        out.append(buffer, length);
+    }
+}  // namespace
+
+CoordExtractor::CoordExtractor(std::shared_ptr<ProcessingContext> ctx, bool quiet, bool frames)
+    : context(ctx), quiet_mode(quiet), all_frames(frames)
+{}
 
 ExtractSummary CoordExtractor::extract_coordinates(const std::vector<std::string>& log_files)
 {
@@ -36,7 +94,7 @@ ExtractSummary CoordExtractor::extract_coordinates(const std::vector<std::string
     std::unordered_map<std::string, std::vector<std::string>> base_name_map;
     for (const auto& log_file : log_files)
     {
-        std::filesystem::path path(log_file);
+        std::filesystem::path path(CompressedInput::strip_suffix(log_file));
         std::string           base_name = path.stem().string();
         std::string           extension = path.extension().string();
         base_name_map[base_name].push_back(extension);
@@ -55,7 +113,6 @@ ExtractSummary CoordExtractor::extract_coordinates(const std::vector<std::string
     // Thread-safe containers
     std::vector<std::pair<std::string, JobStatus>> successful_extractions;  // xyz_file, status
     std::mutex                                     results_mutex;
-    std::atomic<size_t>                            file_index{0};
 
     // Calculate safe thread count
     unsigned int num_threads = calculateSafeThreadCount(
@@ -66,65 +123,64 @@ ExtractSummary CoordExtractor::extract_coordinates(const std::vector<std::string
         std::cout << "Using " << num_threads << " threads" << std::endl;
     }
 
-    // Process files in parallel
-    std::vector<std::thread> threads;
-    for (unsigned int i = 0; i < num_threads; ++i)
-    {
-        threads.emplace_back([&]() {
-            size_t index;
-            while ((index = file_index.fetch_add(1)) < log_files.size())
+    // Process files in parallel, largest logs first
+    std::vector<uintmax_t> file_sizes   = TaskExecutor::file_sizes(log_files);
+    auto                   process_file = [&](size_t index) {
+        try
+        {
+            // The log text and its split lines are held together while the last geometry is located; a
+            // trajectory holds one chunk and the line carried over from the previous one
+            MemoryMonitor::Reservation memory;
+            if (context->memory_monitor)
             {
-                if (g_shutdown_requested.load())
-                    break;
-
-                try
-                {
-                    auto file_guard = context->file_manager->acquire();
-                    if (!file_guard.is_acquired())
-                        continue;
+                memory = context->memory_monitor->reserve(
+                    all_frames ? 2 * TRAJECTORY_CHUNK_BYTES : static_cast<size_t>(2 * file_sizes[index]));
+                if (!memory.is_acquired())
+                    return;
+            }
 
-                    std::string error_msg;
-                    auto [success, status] = extract_from_file(log_files[index], conflicting_base_names, error_msg);
+            auto file_guard = context->file_manager->acquire();
+            if (!file_guard.is_acquired())
+                return;
 
-                    {
-                        std::lock_guard<std::mutex> lock(results_mutex);
-                        summary.processed_files++;
-                        if (success)
-                        {
-                            std::string xyz_file = generate_xyz_filename(log_files[index], conflicting_base_names);
-                            successful_extractions.emplace_back(xyz_file, status);
-                            summary.extracted_files++;
-                        }
-                        else
-                        {
-                            summary.failed_files++;
-                            if (!error_msg.empty())
-                            {
-                                summary.errors.push_back("Error extracting " + log_files[index] + ": " + error_msg);
-                            }
-                        }
-                    }
+            std::string error_msg;
+            auto [success, status] = all_frames
+                                         ? extract_trajectory(log_files[index], conflicting_base_names, error_msg)
+                                         : extract_from_file(log_files[index], conflicting_base_names, error_msg);
 
-                    // Report progress
-                    if (!quiet_mode && summary.processed_files % 50 == 0)
-                    {
-                        report_progress(summary.processed_files, summary.total_files);
-                    }
+            {
+                auto lock = Profiler::lock(results_mutex);
+                summary.processed_files++;
+                if (success)
+                {
+                    std::string xyz_file = generate_xyz_filename(log_files[index], conflicting_base_names);
+                    successful_extractions.emplace_back(xyz_file, status);
+                    summary.extracted_files++;
                 }
-                catch (const std::exception& e)
+                else
                 {
-                    std::lock_guard<std::mutex> lock(results_mutex);
-                    summary.errors.push_back("Exception extracting " + log_files[index] + ": " + e.what());
+                    summary.failed_files++;
+                    if (!error_msg.empty())
+                    {
+                        summary.errors.push_back("Error extracting " + log_files[index] + ": " + error_msg);
+                    }
                 }
             }
-        });
-    }
 
-    // Wait for completion
-    for (auto& thread : threads)
-    {
-        thread.join();
-    }
+            // Report progress
+            if (!quiet_mode && summary.processed_files % 50 == 0)
+            {
+                report_progress(summary.processed_files, summary.total_files);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            auto lock = Profiler::lock(results_mutex);
+            summary.errors.push_back("Exception extracting " + log_files[index] + ": " + e.what());
+        }
+    };
+
+    TaskExecutor::shared(num_threads).run(log_files.size(), process_file, file_sizes);
 
     if (!quiet_mode && summary.processed_files > 0)
     {
@@ -132,21 +188,29 @@ ExtractSummary CoordExtractor::extract_coordinates(const std::vector<std::string
         std::cout << std::endl;
     }
 
-    // Move extracted XYZ files (avoid duplicates)
-    std::unordered_set<std::string> moved_files;
+    // Move extracted XYZ files (avoid duplicates) in one planned batch; a fresh geometry replaces an old one
+    MovePlanner                     planner(MoveOptions(), MovePlanner::Collision::REPLACE);
+    std::vector<JobStatus>          planned_status;
+    std::unordered_set<std::string> planned_files;
     for (const auto& [xyz_file, status] : successful_extractions)
     {
-        // Skip if this XYZ file has already been moved
-        if (moved_files.find(xyz_file) != moved_files.end())
+        if (planned_files.insert(xyz_file).second)
         {
-            continue;
+            planner.add(target_directory(status), xyz_file, {});
+            planned_status.push_back(status);
         }
+    }
+    planner.execute(num_threads);
 
-        std::string move_error;
-        if (move_xyz_file(xyz_file, status, move_error))
+    for (const auto& error : planner.general_errors())
+    {
+        summary.errors.push_back(error);
+    }
+    for (size_t group = 0; group < planner.group_count(); ++group)
+    {
+        if (planner.moved(group))
         {
-            moved_files.insert(xyz_file);
-            if (status == JobStatus::COMPLETED)
+            if (planned_status[group] == JobStatus::COMPLETED)
             {
                 summary.moved_to_final++;
             }
@@ -158,9 +222,9 @@ ExtractSummary CoordExtractor::extract_coordinates(const std::vector<std::string
         else
         {
             summary.failed_files++;
-            if (!move_error.empty())
+            if (!planner.error(group).empty())
             {
-                summary.errors.push_back(move_error);
+                summary.errors.push_back(planner.error(group));
             }
         }
     }
@@ -181,126 +245,178 @@ CoordExtractor::extract_from_file(const std::string&                     log_fil
         // Use SMART mode to read file, looking for orientation section
         std::string content = Utils::read_file_unified(log_file, FileReadMode::SMART, 1000, "Standard orientation:");
 
-        // Parse into lines
-        std::vector<std::string> lines;
-        std::istringstream       iss(content);
-        std::string              line;
-        while (std::getline(iss, line))
-        {
-            lines.push_back(line);
-        }
-
-        // Search backward for the last orientation header
-        int start = -1;
-        for (int i = static_cast<int>(lines.size()) - 1; i >= 0; --i)
-        {
-            if (lines[i].find("Standard orientation:") != std::string::npos ||
-                lines[i].find("Input orientation:") != std::string::npos)
-            {
-                start = i;
-                break;
-            }
-        }
-
-        if (start == -1)
+        size_t start = find_last_orientation(content);
+        if (start == std::string_view::npos)
         {
             error_msg = "No orientation section found";
             return {false, JobStatus::UNKNOWN};
         }
 
-        // Find end of section
-        int end = -1;
-        for (int m = start + 5; m < static_cast<int>(lines.size()); ++m)
-        {
-            if (lines[m].find("----") != std::string::npos)
-            {
-                end = m;
-                break;
-            }
-        }
-
-        if (end == -1)
+        std::string_view rows;
+        size_t           num_atoms = 0;
+        if (!locate_atom_rows(std::string_view(content).substr(start), rows, num_atoms))
         {
             error_msg = "No end delimiter found for orientation section";
             return {false, JobStatus::UNKNOWN};
         }
 
-        int num_atoms = end - start - 5;
-        if (num_atoms <= 0)
+        std::string xyz;
+        std::string title = std::filesystem::path(CompressedInput::strip_suffix(log_file)).stem().string();
+        if (!format_xyz(rows, num_atoms, title, xyz, error_msg))
         {
-            error_msg = "Invalid number of atoms";
             return {false, JobStatus::UNKNOWN};
         }
 
-        // Generate output filename
-        std::string xyz_file = generate_xyz_filename(log_file, conflicting_base_names);
-
         // Write XYZ file
+        std::string   xyz_file = generate_xyz_filename(log_file, conflicting_base_names);
         std::ofstream out(xyz_file);
         if (!out.is_open())
         {
             error_msg = "Failed to open output file: " + xyz_file;
             return {false, JobStatus::UNKNOWN};
         }
+        out.write(xyz.data(), static_cast<std::streamsize>(xyz.size()));
+        out.close();
 
-        out << num_atoms << std::endl;
-        out << std::filesystem::path(log_file).stem().string() << std::endl;
+        return {true, tail_status(log_file)};
+    }
+    catch (const std::exception& e)
+    {
+        error_msg = e.what();
+        return {false, JobStatus::UNKNOWN};
+    }
+}
 
-        // Parse and write each atom line
-        for (int l = start + 5; l < end; ++l)
+std::pair<bool, JobStatus>
+CoordExtractor::extract_trajectory(const std::string&                     log_file,
+                                   const std::unordered_set<std::string>& conflicting_base_names,
+                                   std::string&                           error_msg)
+{
+    try
+    {
+        std::unique_ptr<std::istream> stream = CompressedInput::open(log_file);
+        if (!*stream)
         {
-            std::istringstream ss(lines[l]);
-            int                center, atomic_num, type;
-            double             x, y, z;
-            if (!(ss >> center >> atomic_num >> type >> x >> y >> z))
-            {
-                error_msg = "Failed to parse coordinate line: " + lines[l];
-                out.close();
-                std::filesystem::remove(xyz_file);  // Cleanup partial file
-                return {false, JobStatus::UNKNOWN};
-            }
-
-            std::string symbol = get_atomic_symbol(atomic_num);
-
-            out << std::left << std::setw(10) << symbol << std::right << std::setw(20) << std::fixed
-                << std::setprecision(10) << x << std::setw(20) << std::fixed << std::setprecision(10) << y
-                << std::setw(20) << std::fixed << std::setprecision(10) << z << std::endl;
+            error_msg = "Could not open file";
+            return {false, JobStatus::UNKNOWN};
         }
 
-        out.close();
-
-        // Determine job status (read last 10 lines)
-        std::string              tail_content = Utils::read_file_unified(log_file, FileReadMode::TAIL, 10);
-        std::vector<std::string> last_lines;
-        std::istringstream       last_iss(tail_content);
-        std::string              last_line;
-        while (std::getline(last_iss, last_line))
+        std::string   xyz_file = generate_xyz_filename(log_file, conflicting_base_names);
+        std::ofstream out(xyz_file, std::ios::binary);
+        if (!out.is_open())
         {
-            last_lines.push_back(last_line);
+            error_msg = "Failed to open output file: " + xyz_file;
+            return {false, JobStatus::UNKNOWN};
         }
 
-        JobStatus status = JobStatus::RUNNING;  // Default UNDONE
+        std::string stem = std::filesystem::path(CompressedInput::strip_suffix(log_file)).stem().string();
+        std::string block;            // Orientation block being read, from its header line
+        int         block_lines = 0;  // Lines of block; the atom rows end at dashes after the fifth
+        std::string pending_rows;     // Atom rows of the last complete block not written yet
+        size_t      pending_atoms = 0;
+        size_t      frames        = 0;
+        std::string xyz;
+
+        auto write_frame = [&](const std::string& energy) {
+            std::string title = stem + "  frame " + std::to_string(frames + 1);
+            if (!energy.empty())
+            {
+                title += "  E = " + energy + " Hartree";
+            }
+            if (!format_xyz(pending_rows, pending_atoms, title, xyz, error_msg))
+            {
+                throw std::runtime_error(error_msg);
+            }
+            out.write(xyz.data(), static_cast<std::streamsize>(xyz.size()));
+            pending_rows.clear();
+            pending_atoms = 0;
+            ++frames;
+        };
+
+        auto visit_line = [&](std::string_view line) {
+            if (line.find("Standard orientation:") != std::string_view::npos ||
+                line.find("Input orientation:") != std::string_view::npos)
+            {
+                block.assign(line.data(), line.size()).append(1, '\n');
+                block_lines = 1;
+                return;
+            }
+            if (block_lines > 0)
+            {
+                block.append(line.data(), line.size()).append(1, '\n');
+                if (++block_lines > 5 && line.find("----") != std::string_view::npos)
+                {
+                    std::string_view rows;
+                    if (locate_atom_rows(block, rows, pending_atoms))
+                    {
+                        pending_rows.assign(rows.data(), rows.size());
+                    }
+                    block_lines = 0;
+                }
+                return;
+            }
+            if (!pending_rows.empty() && line.find("SCF Done:") != std::string_view::npos)
+            {
+                size_t eq_pos = line.find('=');
+                double energy = 0.0;
+                size_t length = 0;
+                if (eq_pos != std::string_view::npos &&
+                    LogScanner::parse_leading_double(line.substr(eq_pos + 1), energy, &length))
+                {
+                    std::string_view text = line.substr(eq_pos + 1, length);
+                    while (!text.empty() && text.front() == ' ')
+                    {
+                        text.remove_prefix(1);
+                    }
+                    write_frame(std::string(text));
+                }
+            }
+        };
 
-        bool is_completed = false;
-        for (const auto& l : last_lines)
+        // Complete lines of each chunk are visited; the partial last line is carried into the next chunk
+        std::string buffer;
+        std::string chunk(TRAJECTORY_CHUNK_BYTES, '\0');
+        while (*stream)
         {
-            if (l.find("Normal termination of Gaussian") != std::string::npos)
+            if (g_shutdown_requested.load())
             {
-                is_completed = true;
-                break;
+                throw std::runtime_error("Processing interrupted by shutdown signal");
             }
-        }
+            stream->read(&chunk[0], static_cast<std::streamsize>(chunk.size()));
+            size_t got = static_cast<size_t>(stream->gcount());
+            Profiler::add(Profiler::Counter::BYTES_READ, got);
+            if (stream->bad())
+            {
+                throw std::runtime_error("I/O error reading file");
+            }
+            buffer.append(chunk.data(), got);
 
-        if (is_completed)
+            size_t pos = 0;
+            size_t newline;
+            while ((newline = buffer.find('\n', pos)) != std::string::npos)
+            {
+                visit_line(std::string_view(buffer).substr(pos, newline - pos));
+                pos = newline + 1;
+            }
+            buffer.erase(0, pos);
+        }
+        if (!buffer.empty())
         {
-            status = JobStatus::COMPLETED;
+            visit_line(buffer);
         }
-        else
+        if (!pending_rows.empty())
         {
-            status = JobStatus::RUNNING;  // or ERROR, but grouped as UNDONE
+            write_frame(std::string());
         }
+        out.close();
 
-        return {true, status};
+        if (frames == 0)
+        {
+            std::filesystem::remove(xyz_file);
+            error_msg = "No orientation section found";
+            return {false, JobStatus::UNKNOWN};
+        }
+        return {true, tail_status(log_file)};
     }
     catch (const std::exception& e)
     {
@@ -309,7 +425,43 @@ CoordExtractor::extract_from_file(const std::string&                     log_fil
     }
 }
 
-std::string CoordExtractor::get_atomic_symbol(int atomic_num)
+JobStatus CoordExtractor::tail_status(const std::string& log_file)
+{
+    // Determine job status (read last 10 lines)
+    std::string              tail_content = Utils::read_file_unified(log_file, FileReadMode::TAIL, 10);
+    std::vector<std::string> last_lines;
+    std::istringstream       last_iss(tail_content);
+    std::string              last_line;
+    while (std::getline(last_iss, last_line))
+    {
+        last_lines.push_back(last_line);
+    }
+
+    JobStatus status = JobStatus::RUNNING;  // Default UNDONE
+
+    bool is_completed = false;
+    for (const auto& l : last_lines)
+    {
+        if (l.find("Normal termination of Gaussian") != std::string::npos)
+        {
+            is_completed = true;
+            break;
+        }
+    }
+
+    if (is_completed)
+    {
+        status = JobStatus::COMPLETED;
+    }
+    else
+    {
+        status = JobStatus::RUNNING;  // or ERROR, but grouped as UNDONE
+    }
+
+    return status;
+}
+
+const std::string& CoordExtractor::get_atomic_symbol(int atomic_num)
 {
     static const std::vector<std::string> symbols = {
         "",   "H",  "He", "Li", "Be", "B",  "C",  "N",  "O",  "F",  "Ne", "Na", "Mg", "Al", "Si", "P",  "S",
@@ -320,17 +472,19 @@ std::string CoordExtractor::get_atomic_symbol(int atomic_num)
         "At", "Rn", "Fr", "Ra", "Ac", "Th", "Pa", "U",  "Np", "Pu", "Am", "Cm", "Bk", "Cf", "Es", "Fm", "Md",
         "No", "Lr", "Rf", "Db", "Sg", "Bh", "Hs", "Mt", "Ds", "Rg", "Cn", "Nh", "Fl", "Mc", "Lv", "Ts", "Og"};
 
+    static const std::string unknown = "X";
+
     if (atomic_num >= 1 && atomic_num < static_cast<int>(symbols.size()))
     {
         return symbols[atomic_num];
     }
-    return "X";  // Unknown
+    return unknown;
 }
 
 std::string CoordExtractor::generate_xyz_filename(const std::string&                     log_file,
                                                   const std::unordered_set<std::string>& conflicting_base_names)
 {
-    std::filesystem::path path(log_file);
+    std::filesystem::path path(CompressedInput::strip_suffix(log_file));
     std::string           stem      = path.stem().string();
     std::string           extension = path.extension().string();
 
@@ -347,52 +501,10 @@ std::string CoordExtractor::generate_xyz_filename(const std::string&
     }
 }
 
-bool CoordExtractor::move_xyz_file(const std::string& xyz_file, JobStatus status, std::string& error_msg)
+std::string CoordExtractor::target_directory(JobStatus status)
 {
-    try
-    {
-        std::string dir_suffix = (status == JobStatus::COMPLETED) ? "_final_coord" : "_running_coord";
-        std::string target_dir = get_current_directory_name() + dir_suffix;
-
-        if (!create_target_directory(target_dir))
-        {
-            error_msg = "Failed to create target directory: " + target_dir;
-            return false;
-        }
-
-        std::filesystem::path src  = xyz_file;
-        std::filesystem::path dest = std::filesystem::path(target_dir) / src.filename();
-
-        std::filesystem::rename(src, dest);
-        return true;
-    }
-    catch (const std::exception& e)
-    {
-        error_msg = "Failed to move " + xyz_file + ": " + e.what();
-        return false;
-    }
-}
-
-bool CoordExtractor::create_target_directory(const std::string& target_dir)
-{
-    try
-    {
-        if (!std::filesystem::exists(target_dir))
-        {
-            std::filesystem::create_directory(target_dir);
-        }
-        return true;
-    }
-    catch (const std::exception& e)
-    {
-        log_error("Failed to create directory " + target_dir + ": " + e.what());
-        return false;
-    }
-}
-
-std::string CoordExtractor::get_current_directory_name()
-{
-    return std::filesystem::current_path().filename().string();
+    std::string dir_suffix = (status == JobStatus::COMPLETED) ? "_final_coord" : "_running_coord";
+    return std::filesystem::current_path().filename().string() + dir_suffix;
 }
 
 void CoordExtractor::report_progress(size_t current, size_t total)
@@ -429,6 +541,106 @@ void CoordExtractor::print_summary(const ExtractSummary& summary, const std::str
     }
 }
 
+size_t CoordExtractor::find_last_orientation(std::string_view content)
+{
+    size_t standard = content.rfind("Standard orientation:");
+    size_t input    = content.rfind("Input orientation:");
+
+    size_t header = standard;
+    if (header == std::string_view::npos || (input != std::string_view::npos && input > header))
+    {
+        header = input;
+    }
+    if (header == std::string_view::npos)
+    {
+        return std::string_view::npos;
+    }
+
+    size_t newline = content.rfind('\n', header);
+    return newline == std::string_view::npos ? 0 : newline + 1;
+}
+
+bool CoordExtractor::locate_atom_rows(std::string_view block, std::string_view& rows, size_t& atom_count)
+{
+    // Header line, dashes, two column title lines and dashes precede the first atom
+    size_t pos = 0;
+    for (int skipped = 0; skipped < 5; ++skipped)
+    {
+        size_t newline = block.find('\n', pos);
+        if (newline == std::string_view::npos)
+        {
+            return false;
+        }
+        pos = newline + 1;
+    }
+
+    size_t first = pos;
+    size_t count = 0;
+    while (pos < block.size())
+    {
+        size_t           newline = block.find('\n', pos);
+        size_t           end     = newline == std::string_view::npos ? block.size() : newline;
+        std::string_view line    = block.substr(pos, end - pos);
+        if (line.find("----") != std::string_view::npos)
+        {
+            rows       = block.substr(first, pos - first);
+            atom_count = count;
+            return true;
+        }
+        ++count;
+        pos = end + 1;
+    }
+    return false;
+}
+
+bool CoordExtractor::format_xyz(std::string_view   rows,
+                                size_t             atom_count,
+                                const std::string& title,
+                                std::string&       xyz,
+                                std::string&       error_msg)
+{
+    if (atom_count == 0)
+    {
+        error_msg = "Invalid number of atoms";
+        return false;
+    }
+
+    // Symbol column and three 20-character coordinates per atom
+    xyz.clear();
+    xyz.reserve(32 + title.size() + atom_count * 72);
+    xyz.append(std::to_string(atom_count)).append(1, '\n');
+    xyz.append(title).append(1, '\n');
+
+    while (!rows.empty())
+    {
+        size_t           newline = rows.find('\n');
+        std::string_view line    = rows.substr(0, newline);
+        rows.remove_prefix(newline == std::string_view::npos ? rows.size() : newline + 1);
+
+        std::string_view fields = line;
+        int              center, atomic_num, type;
+        double           x, y, z;
+        if (!(next_field(fields, center) && next_field(fields, atomic_num) && next_field(fields, type) &&
+              next_field(fields, x) && next_field(fields, y) && next_field(fields, z)))
+        {
+            error_msg = "Failed to parse coordinate line: " + std::string(line);
+            return false;
+        }
+
+        const std::string& symbol = get_atomic_symbol(atomic_num);
+        xyz.append(symbol);
+        if (symbol.size() < 10)
+        {
+            xyz.append(10 - symbol.size(), ' ');
+        }
+        append_coordinate(xyz, x);
+        append_coordinate(xyz, y);
+        append_coordinate(xyz, z);
+        xyz.append(1, '\n');
+    }
+    return true;
+}
+
 void CoordExtractor::log_message(const std::string& message)
 {
     if (!quiet_mode)
@@ -441,3 +653,167 @@ void CoordExtractor::log_error(const std::string& error)
 {
     context->error_collector->add_error(error);
 }
+
+// =============================================================================
+// GeometryWriter Implementation
+// =============================================================================
+
+GeometryWriter::GeometryWriter()
+    : final_ready_(false), running_ready_(false), final_dir_(CoordExtractor::target_directory(JobStatus::COMPLETED)),
+      running_dir_(CoordExtractor::target_directory(JobStatus::RUNNING)), final_count_(0), running_count_(0)
+{}
+
+void GeometryWriter::add_log(const std::string& log_file)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    stem_counts_[std::filesystem::path(CompressedInput::strip_suffix(log_file)).stem().string()]++;
+}
+
+std::string GeometryWriter::output_path(const std::string& log_file, bool completed)
+{
+    std::filesystem::path path(CompressedInput::strip_suffix(log_file));
+    std::string           stem      = path.stem().string();
+    const std::string&    directory = completed ? final_dir_ : running_dir_;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    bool& ready = completed ? final_ready_ : running_ready_;
+    if (!ready)
+    {
+        std::error_code ec;
+        std::filesystem::create_directory(directory, ec);
+        ready = std::filesystem::is_directory(directory, ec);
+    }
+
+    auto it = stem_counts_.find(stem);
+    if (it != stem_counts_.end() && it->second > 1)
+    {
+        return (std::filesystem::path(directory) / (stem + path.extension().string() + ".xyz")).string();
+    }
+
+    // A log with the same stem may still be found; finish() renames this file then
+    std::string target = (std::filesystem::path(directory) / (stem + ".xyz")).string();
+    short_names_.emplace_back(log_file, target);
+    return target;
+}
+
+bool GeometryWriter::write(const std::string& log_file,
+                           uint64_t           orientation_offset,
+                           bool               completed,
+                           std::string&       error_msg)
+{
+    std::unique_ptr<std::istream> stream = CompressedInput::open(log_file);
+    std::istream&                 file   = *stream;
+    if (!file)
+    {
+        error_msg = "Could not open file: " + log_file;
+        return false;
+    }
+
+    // Read from the header until the block is complete; a few KB for typical molecules
+    std::string      block;
+    std::string_view rows;
+    size_t           atom_count = 0;
+    size_t           chunk      = 16384;
+    if (CompressedInput::is_compressed(log_file))
+    {
+        file.ignore(static_cast<std::streamsize>(orientation_offset));
+    }
+    else
+    {
+        file.seekg(static_cast<std::streamoff>(orientation_offset));
+    }
+    while (true)
+    {
+        size_t have = block.size();
+        block.resize(have + chunk);
+        file.read(&block[have], static_cast<std::streamsize>(chunk));
+        block.resize(have + static_cast<size_t>(file.gcount()));
+
+        if (CoordExtractor::locate_atom_rows(block, rows, atom_count))
+        {
+            break;
+        }
+        if (!file)
+        {
+            error_msg = "No end delimiter found for orientation section";
+            return false;
+        }
+        chunk *= 2;
+    }
+
+    return save(log_file, rows, atom_count, completed, error_msg);
+}
+
+bool GeometryWriter::write(const std::string& log_file,
+                           std::string_view   content,
+                           uint64_t           orientation_offset,
+                           bool               completed,
+                           std::string&       error_msg)
+{
+    std::string_view rows;
+    size_t           atom_count = 0;
+    if (orientation_offset >= content.size() ||
+        !CoordExtractor::locate_atom_rows(content.substr(orientation_offset), rows, atom_count))
+    {
+        error_msg = "No end delimiter found for orientation section";
+        return false;
+    }
+    return save(log_file, rows, atom_count, completed, error_msg);
+}
+
+bool GeometryWriter::save(const std::string& log_file,
+                          std::string_view   rows,
+                          size_t             atom_count,
+                          bool               completed,
+                          std::string&       error_msg)
+{
+    std::string xyz;
+    std::string title = std::filesystem::path(CompressedInput::strip_suffix(log_file)).stem().string();
+    if (!CoordExtractor::format_xyz(rows, atom_count, title, xyz, error_msg))
+    {
+        return false;
+    }
+
+    Profiler::Scope write(Profiler::Phase::FORMAT);
+    std::string     xyz_file = output_path(log_file, completed);
+    std::ofstream   out(xyz_file);
+    if (!out.is_open())
+    {
+        error_msg = "Failed to open output file: " + xyz_file;
+        return false;
+    }
+    out.write(xyz.data(), static_cast<std::streamsize>(xyz.size()));
+    out.close();
+    if (!out)
+    {
+        error_msg = "Failed to write output file: " + xyz_file;
+        return false;
+    }
+
+    (completed ? final_count_ : running_count_).fetch_add(1);
+    return true;
+}
+
+void GeometryWriter::finish(std::vector<std::string>& errors)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& [log_file, xyz_file] : short_names_)
+    {
+        std::filesystem::path path(CompressedInput::strip_suffix(log_file));
+        std::string           stem = path.stem().string();
+        if (stem_counts_[stem] < 2)
+        {
+            continue;
+        }
+
+        std::filesystem::path target = std::filesystem::path(xyz_file).parent_path() /
+                                       (stem + path.extension().string() + ".xyz");
+        std::error_code ec;
+        std::filesystem::rename(xyz_file, target, ec);
+        if (ec)
+        {
+            errors.push_back("Failed to move " + xyz_file + ": " + ec.message());
+        }
+    }
+    short_names_.clear();
+}
@@ -3,9 +3,15 @@
 
 #include "gaussian_extractor.h"
 #include "job_management/job_checker.h"
+#include <atomic>
+#include <cstdint>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 
 
@@ -13,6 +19,11 @@
  * @file coord_extractor.h
  * @brief Header file for coordinate extraction command xyz to extract coordinates from Gaussian outputs
  */
+/**
+ * @brief Read size of the streamed log in xyz --all-frames mode
+ */
+const size_t TRAJECTORY_CHUNK_BYTES = 1024 * 1024;
+
 /**
  * @struct ExtractSummary
  * @brief Statistical summary of coordinate extraction operations
@@ -51,13 +62,21 @@ struct ExtractSummary
  * - Multi-threaded processing
  * - Resource-aware operation
  * - Detailed reporting and error handling
- * - Moves XYZ files to status-based directories
+ * - Moves XYZ files to status-based directories in one parallel batch (see MovePlanner)
+ * - Optional multi-frame trajectories of every geometry in the log (see extract_trajectory())
+ *
+ * @section Geometry Formatting
+ * The orientation block is parsed in place (no per-line strings) and the XYZ
+ * text is formatted with std::to_chars into one buffer, which is written to
+ * disk in a single call. The static helpers are shared with GeometryWriter,
+ * so "xyz" and "extract --with-xyz" produce byte-identical files.
  */
 class CoordExtractor
 {
 private:
     std::shared_ptr<ProcessingContext> context;     ///< Shared processing context
     bool                               quiet_mode;  ///< Suppress non-essential output
+    bool                               all_frames;  ///< Write every geometry instead of the last one
 
     /**
      * @brief Extract coordinates from a single log file
@@ -73,6 +92,28 @@ private:
                                                  const std::unordered_set<std::string>& conflicting_base_names,
                                                  std::string&                           error_msg);
 
+    /**
+     * @brief Write every geometry of a log as one multi-frame XYZ file
+     * @param log_file Path to the log file
+     * @param conflicting_base_names Stems shared by logs with different extensions
+     * @param error_msg Reference to store any error message
+     * @return Pair of success flag and job status
+     *
+     * The log is streamed in TRAJECTORY_CHUNK_BYTES chunks, so memory does not
+     * grow with its size. Each orientation block replaces the pending geometry;
+     * the next "SCF Done" line writes it as a frame with that energy in the
+     * comment line, and a geometry left pending at the end of the log is
+     * written without one.
+     */
+    std::pair<bool, JobStatus> extract_trajectory(const std::string&                     log_file,
+                                                  const std::unordered_set<std::string>& conflicting_base_names,
+                                                  std::string&                           error_msg);
+
+    /**
+     * @brief Job status from the last lines of a log (COMPLETED or RUNNING)
+     */
+    static JobStatus tail_status(const std::string& log_file);
+
     /**
      * @brief Get element symbol from atomic number
      * @param atomic_num Atomic number (1-118)
@@ -81,7 +122,7 @@ private:
      * Returns the standard two-letter (or one-letter) element symbol.
      * Uses modern names where applicable.
      */
-    std::string get_atomic_symbol(int atomic_num);
+    static const std::string& get_atomic_symbol(int atomic_num);
 
     /**
      * @brief Generate output XYZ filename from log file
@@ -91,28 +132,6 @@ private:
     std::string generate_xyz_filename(const std::string&                     log_file,
                                       const std::unordered_set<std::string>& conflicting_base_names);
 
-    /**
-     * @brief Move XYZ file to appropriate directory based on job status
-     * @param xyz_file Path to XYZ file
-     * @param status Job status determining target directory
-     * @param error_msg Reference to store any error
-     * @return true if move successful
-     */
-    bool move_xyz_file(const std::string& xyz_file, JobStatus status, std::string& error_msg);
-
-    /**
-     * @brief Create target directory if it doesn't exist
-     * @param target_dir Directory path
-     * @return true if directory exists or was created
-     */
-    bool create_target_directory(const std::string& target_dir);
-
-    /**
-     * @brief Get current directory name
-     * @return Current directory name
-     */
-    std::string get_current_directory_name();
-
     /**
      * @brief Report progress of extraction
      * @param current Processed files count
@@ -137,8 +156,9 @@ public:
      * @brief Constructor with processing context
      * @param ctx Shared processing context
      * @param quiet Quiet mode flag
+     * @param frames Write every geometry of each log as a multi-frame XYZ file (xyz --all-frames)
      */
-    explicit CoordExtractor(std::shared_ptr<ProcessingContext> ctx, bool quiet = false);
+    explicit CoordExtractor(std::shared_ptr<ProcessingContext> ctx, bool quiet = false, bool frames = false);
 
     /**
      * @brief Extract coordinates from multiple log files
@@ -156,6 +176,161 @@ public:
      * @param operation Operation description
      */
     void print_summary(const ExtractSummary& summary, const std::string& operation);
+
+    /**
+     * @brief Find the last orientation block of a log
+     * @param content Log text (or the part of it that was read)
+     * @return Offset of the start of the last line holding "Standard orientation:" or
+     *         "Input orientation:", std::string_view::npos if there is none
+     */
+    static size_t find_last_orientation(std::string_view content);
+
+    /**
+     * @brief Locate the atom rows of an orientation block
+     * @param block Text starting at the orientation header line
+     * @param rows Receives the atom rows (five lines below the header up to the closing dashes)
+     * @param atom_count Receives the number of atom rows
+     * @return false if @p block ends before the closing "----" line
+     */
+    static bool locate_atom_rows(std::string_view block, std::string_view& rows, size_t& atom_count);
+
+    /**
+     * @brief Format atom rows as an XYZ file
+     * @param rows Atom rows from locate_atom_rows()
+     * @param atom_count Number of atom rows
+     * @param title Comment line of the XYZ file (the log file stem)
+     * @param xyz Receives the complete file content
+     * @param error_msg Receives the reason on failure
+     * @return false if there are no atoms or a row cannot be parsed
+     */
+    static bool format_xyz(std::string_view   rows,
+                           size_t             atom_count,
+                           const std::string& title,
+                           std::string&       xyz,
+                           std::string&       error_msg);
+
+    /**
+     * @brief Directory that collects the XYZ files of jobs with the given status
+     * @param status COMPLETED selects "<dir>_final_coord", anything else "<dir>_running_coord"
+     * @return Directory name relative to the current directory
+     */
+    static std::string target_directory(JobStatus status);
+};
+
+/**
+ * @class GeometryWriter
+ * @brief Writes the final geometry of every log scanned by "extract --with-xyz"
+ *
+ * The extract scan records the file offset of the last orientation block;
+ * write() reads only that block, formats it with the CoordExtractor helpers
+ * and stores the XYZ file directly in the directory the xyz command would
+ * move it to, so the log is never read a second time from the start.
+ *
+ * @section Naming
+ * Files are named like the xyz command names them: "stem.xyz", or
+ * "stem.ext.xyz" when logs with the same stem and different extensions are
+ * processed together. Logs are discovered while earlier ones are already
+ * being written, so a file written before its stem turned out to be shared
+ * is renamed by finish().
+ *
+ * @note add_log(), write() and the counters are thread-safe; finish() must be
+ *       called once after the last write().
+ */
+class GeometryWriter
+{
+public:
+    /**
+     * @brief Create a writer for logs of the current directory
+     */
+    GeometryWriter();
+
+    /**
+     * @brief Register a log before it is handed to a worker thread
+     * @param log_file Path to the log file
+     */
+    void add_log(const std::string& log_file);
+
+    /**
+     * @brief Write the geometry of one log
+     * @param log_file Path to the log file
+     * @param orientation_offset File offset of the last orientation header line
+     * @param completed Whether the job terminated normally (selects the target directory)
+     * @param error_msg Receives the reason on failure
+     * @return true if the XYZ file was written
+     */
+    bool write(const std::string& log_file, uint64_t orientation_offset, bool completed, std::string& error_msg);
+
+    /**
+     * @brief Write the geometry of one log whose content is already in memory
+     * @param log_file Path to the log file (names the XYZ file)
+     * @param content Whole log content
+     * @param orientation_offset Offset of the last orientation header line in @p content
+     * @param completed Whether the job terminated normally (selects the target directory)
+     * @param error_msg Receives the reason on failure
+     * @return true if the XYZ file was written
+     */
+    bool write(const std::string& log_file,
+               std::string_view   content,
+               uint64_t           orientation_offset,
+               bool               completed,
+               std::string&       error_msg);
+
+    /**
+     * @brief Give early-written files of a shared stem their "stem.ext.xyz" name
+     * @param errors Receives one message per file that could not be renamed
+     */
+    void finish(std::vector<std::string>& errors);
+
+    /**
+     * @brief Number of XYZ files written to the final_coord directory
+     */
+    size_t final_count() const
+    {
+        return final_count_.load();
+    }
+
+    /**
+     * @brief Number of XYZ files written to the running_coord directory
+     */
+    size_t running_count() const
+    {
+        return running_count_.load();
+    }
+
+    /**
+     * @brief Directory receiving geometries of completed jobs
+     */
+    const std::string& final_directory() const
+    {
+        return final_dir_;
+    }
+
+    /**
+     * @brief Directory receiving geometries of unfinished jobs
+     */
+    const std::string& running_directory() const
+    {
+        return running_dir_;
+    }
+
+private:
+    bool save(const std::string& log_file,
+              std::string_view   rows,
+              size_t             atom_count,
+              bool               completed,
+              std::string&       error_msg);
+    std::string output_path(const std::string& log_file, bool completed);
+
+    std::mutex                                       mutex_;          ///< Guards the members below
+    std::unordered_map<std::string, size_t>          stem_counts_;    ///< Logs registered per file stem
+    std::vector<std::pair<std::string, std::string>> short_names_;    ///< (log, path) written as "stem.xyz"
+    bool                                             final_ready_;    ///< final_dir_ has been created
+    bool                                             running_ready_;  ///< running_dir_ has been created
+
+    std::string         final_dir_;      ///< Target directory of completed jobs
+    std::string         running_dir_;    ///< Target directory of unfinished jobs
+    std::atomic<size_t> final_count_;    ///< Files written to final_dir_
+    std::atomic<size_t> running_count_;  ///< Files written to running_dir_
 };
 
 #endif  // COORD_EXTRACTOR_H
\ No newline at end of file
@@ -0,0 +1,593 @@
+/**
+ * @file custom_fields.cpp
+ * @brief Implementation of the user-defined extraction fields
+ * @author Le Nhan Pham
+ * @date 2025
+ */
+
+#include "custom_fields.h"
+#include <algorithm>
+#include <charconv>
+#include <climits>
+#include <cstdio>
+#include <mutex>
+#include <stdexcept>
+
+namespace
+{
+    /**
+     * @brief Most phrases an AnchorSet holds (bits of its 32-bit masks)
+     */
+    const size_t MAX_ANCHOR_PHRASES = 32;
+
+    std::mutex                            installed_mutex;
+    std::shared_ptr<const CustomFieldSet> installed_fields;
+
+    std::string_view trim(std::string_view text)
+    {
+        while (!text.empty() && (text.front() == ' ' || text.front() == '\t'))
+        {
+            text.remove_prefix(1);
+        }
+        while (!text.empty() && (text.back() == ' ' || text.back() == '\t' || text.back() == '\r'))
+        {
+            text.remove_suffix(1);
+        }
+        return text;
+    }
+
+    bool parse_int(std::string_view text, long long& value)
+    {
+        if (!text.empty() && text.front() == '+')
+        {
+            text.remove_prefix(1);
+        }
+        auto result = std::from_chars(text.data(), text.data() + text.size(), value);
+        return result.ec == std::errc() && result.ptr != text.data();
+    }
+
+    inline bool is_blank(char c)
+    {
+        return c == ' ' || c == '\t' || c == '\r';
+    }
+
+    /**
+     * @brief Whitespace-separated token @p index of a line (1-based, negative from the end)
+     */
+    std::string_view token_at(std::string_view line, int index)
+    {
+        std::vector<std::string_view> tokens;
+        size_t                        pos = 0;
+        while (pos < line.size())
+        {
+            while (pos < line.size() && is_blank(line[pos]))
+            {
+                ++pos;
+            }
+            size_t start = pos;
+            while (pos < line.size() && !is_blank(line[pos]))
+            {
+                ++pos;
+            }
+            if (pos > start)
+            {
+                tokens.push_back(line.substr(start, pos - start));
+            }
+        }
+
+        long long slot = index > 0 ? index - 1 : static_cast<long long>(tokens.size()) + index;
+        if (slot < 0 || slot >= static_cast<long long>(tokens.size()))
+        {
+            return {};
+        }
+        return tokens[static_cast<size_t>(slot)];
+    }
+
+    /**
+     * @brief Name of an occurrence for the spec signature
+     */
+    const char* occurrence_name(CustomFieldSpec::Occurrence occurrence)
+    {
+        switch (occurrence)
+        {
+            case CustomFieldSpec::Occurrence::FIRST:
+                return "first";
+            case CustomFieldSpec::Occurrence::ALL:
+                return "all";
+            case CustomFieldSpec::Occurrence::COUNT:
+                return "count";
+            case CustomFieldSpec::Occurrence::LAST:
+            default:
+                return "last";
+        }
+    }
+}  // namespace
+
+bool CustomFieldSet::parse_spec(const std::string& name,
+                                const std::string& text,
+                                CustomFieldSpec&   spec,
+                                std::string&       error)
+{
+    spec      = CustomFieldSpec{};
+    spec.name = name;
+    if (name.empty() || name.find_first_not_of("abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789_-.") !=
+                            std::string::npos)
+    {
+        error = "field names may contain letters, digits, '_', '-' and '.' only";
+        return false;
+    }
+
+    bool             has_offset = false;
+    bool             has_reset  = false;
+    std::string_view rest(text);
+    while (!rest.empty())
+    {
+        size_t           separator = rest.find(';');
+        std::string_view item      = trim(rest.substr(0, separator));
+        rest.remove_prefix(separator == std::string_view::npos ? rest.size() : separator + 1);
+        if (item.empty())
+        {
+            continue;
+        }
+
+        // The value may itself contain '=' (anchor=Tot=), so only the first one separates
+        size_t equals = item.find('=');
+        if (equals == std::string_view::npos)
+        {
+            error = "expected key=value, got '" + std::string(item) + "'";
+            return false;
+        }
+        std::string_view key    = trim(item.substr(0, equals));
+        std::string_view value  = trim(item.substr(equals + 1));
+        long long        number = 0;
+
+        // Quotes keep leading or trailing blanks of a phrase (anchor=' Tot=')
+        if (value.size() >= 2 && (value.front() == '\'' || value.front() == '"') && value.back() == value.front())
+        {
+            value = value.substr(1, value.size() - 2);
+        }
+
+        if (key == "anchor")
+        {
+            spec.anchor = std::string(value);
+        }
+        else if (key == "reset")
+        {
+            spec.reset = std::string(value);
+            has_reset  = true;
+        }
+        else if (key == "field")
+        {
+            if (!parse_int(value, number) || number == 0 || number < INT_MIN || number > INT_MAX)
+            {
+                error = "field must be a non-zero token number";
+                return false;
+            }
+            spec.token = static_cast<int>(number);
+        }
+        else if (key == "offset")
+        {
+            if (!parse_int(value, number) || number < 0)
+            {
+                error = "offset must be a non-negative number of bytes";
+                return false;
+            }
+            spec.offset = static_cast<size_t>(number);
+            has_offset  = true;
+        }
+        else if (key == "type")
+        {
+            if (value == "double")
+            {
+                spec.type = CustomFieldSpec::Type::DOUBLE;
+            }
+            else if (value == "int")
+            {
+                spec.type = CustomFieldSpec::Type::INT;
+            }
+            else if (value == "string")
+            {
+                spec.type = CustomFieldSpec::Type::STRING;
+            }
+            else
+            {
+                error = "type must be double, int or string";
+                return false;
+            }
+        }
+        else if (key == "occurrence")
+        {
+            if (value == "first")
+            {
+                spec.occurrence = CustomFieldSpec::Occurrence::FIRST;
+            }
+            else if (value == "last")
+            {
+                spec.occurrence = CustomFieldSpec::Occurrence::LAST;
+            }
+            else if (value == "all")
+            {
+                spec.occurrence = CustomFieldSpec::Occurrence::ALL;
+            }
+            else if (value == "count")
+            {
+                spec.occurrence = CustomFieldSpec::Occurrence::COUNT;
+            }
+            else
+            {
+                error = "occurrence must be first, last, all or count";
+                return false;
+            }
+        }
+        else
+        {
+            error = "unknown key '" + std::string(key) + "'";
+            return false;
+        }
+    }
+
+    if (spec.anchor.size() < 2)
+    {
+        error = "anchor must be given and hold at least two characters";
+        return false;
+    }
+    if (has_reset && spec.reset.size() < 2)
+    {
+        error = "reset must hold at least two characters";
+        return false;
+    }
+    if (spec.token != 0 && has_offset)
+    {
+        error = "field and offset cannot both be given";
+        return false;
+    }
+    return true;
+}
+
+std::shared_ptr<const CustomFieldSet> CustomFieldSet::compile(const std::vector<CustomFieldSpec>& fields,
+                                                              std::string&                        error)
+{
+    if (fields.empty())
+    {
+        return nullptr;
+    }
+
+    // Field phrases equal to a built-in anchor share its bit; the others follow the built-in ones
+    std::vector<std::string_view> phrases  = LogScanner::extract_anchor_phrases();
+    size_t                        builtin  = phrases.size();
+    auto                          index_of = [&phrases](const std::string& phrase) {
+        auto it = std::find(phrases.begin(), phrases.end(), std::string_view(phrase));
+        if (it == phrases.end())
+        {
+            phrases.push_back(phrase);
+            return phrases.size() - 1;
+        }
+        return static_cast<size_t>(it - phrases.begin());
+    };
+
+    std::vector<Compiled>                  compiled;
+    std::vector<std::pair<size_t, size_t>> indices;  // (anchor, reset) phrase index of each field
+    for (const auto& spec : fields)
+    {
+        for (const auto& other : compiled)
+        {
+            if (other.spec.name == spec.name)
+            {
+                error = "field '" + spec.name + "' is defined twice";
+                return nullptr;
+            }
+        }
+        Compiled field;
+        field.spec = spec;
+        compiled.push_back(std::move(field));
+        indices.emplace_back(index_of(spec.anchor), spec.reset.empty() ? 0 : index_of(spec.reset));
+    }
+    if (phrases.size() > MAX_ANCHOR_PHRASES)
+    {
+        error = "custom fields use " + std::to_string(phrases.size() - builtin) +
+                " distinct anchor and reset phrases; at most " + std::to_string(MAX_ANCHOR_PHRASES - builtin) +
+                " are supported";
+        return nullptr;
+    }
+    for (size_t i = 0; i < compiled.size(); ++i)
+    {
+        compiled[i].anchor_bits = 1u << indices[i].first;
+        compiled[i].reset_bits  = compiled[i].spec.reset.empty() ? 0u : 1u << indices[i].second;
+    }
+
+    // phrases views the strings of fields, which the constructor copies into the anchor set
+    return std::shared_ptr<const CustomFieldSet>(new CustomFieldSet(std::move(compiled), phrases));
+}
+
+std::shared_ptr<const CustomFieldSet>
+CustomFieldSet::from_config(const std::vector<std::pair<std::string, std::string>>& entries,
+                            std::vector<std::string>&                               errors)
+{
+    std::vector<CustomFieldSpec> fields;
+    for (const auto& entry : entries)
+    {
+        CustomFieldSpec spec;
+        std::string     error;
+        bool            duplicate = std::any_of(fields.begin(), fields.end(), [&entry](const CustomFieldSpec& other) {
+            return other.name == entry.first;
+        });
+        if (duplicate)
+        {
+            errors.push_back("Custom field '" + entry.first + "' skipped: defined twice");
+        }
+        else if (!parse_spec(entry.first, entry.second, spec, error))
+        {
+            errors.push_back("Custom field '" + entry.first + "' skipped: " + error);
+        }
+        else
+        {
+            fields.push_back(std::move(spec));
+        }
+    }
+
+    std::string error;
+    auto        compiled = compile(fields, error);
+    if (!compiled && !fields.empty())
+    {
+        errors.push_back("Custom fields disabled: " + error);
+    }
+    return compiled;
+}
+
+void CustomFieldSet::install(std::shared_ptr<const CustomFieldSet> fields)
+{
+    std::lock_guard<std::mutex> lock(installed_mutex);
+    installed_fields = std::move(fields);
+}
+
+std::shared_ptr<const CustomFieldSet> CustomFieldSet::installed()
+{
+    std::lock_guard<std::mutex> lock(installed_mutex);
+    return installed_fields;
+}
+
+CustomFieldSet::CustomFieldSet(std::vector<Compiled> fields, const std::vector<std::string_view>& phrases)
+    : fields_(std::move(fields)), anchors_(phrases)
+{
+    // FNV-1a over every spec, so a changed field invalidates cached values
+    uint64_t hash = 14695981039346656037ULL;
+    auto     mix  = [&hash](const std::string& text) {
+        for (unsigned char c : text)
+        {
+            hash ^= c;
+            hash *= 1099511628211ULL;
+        }
+        hash ^= 0xff;
+        hash *= 1099511628211ULL;
+    };
+    for (const auto& field : fields_)
+    {
+        const CustomFieldSpec& spec = field.spec;
+        mask_ |= field.anchor_bits | field.reset_bits;
+        mergeable_ = mergeable_ && field.reset_bits == 0;
+        mix(spec.name);
+        mix(spec.anchor);
+        mix(spec.reset);
+        mix(std::to_string(spec.token));
+        mix(std::to_string(spec.offset));
+        mix(std::to_string(static_cast<int>(spec.type)));
+        mix(occurrence_name(spec.occurrence));
+    }
+
+    char text[17];
+    std::snprintf(text, sizeof(text), "%016llx", static_cast<unsigned long long>(hash));
+    signature_ = text;
+}
+
+std::vector<ColumnarWriter::Column> CustomFieldSet::columns() const
+{
+    using Type = ColumnarWriter::Type;
+    std::vector<ColumnarWriter::Column> columns;
+    for (const auto& field : fields_)
+    {
+        const CustomFieldSpec& spec = field.spec;
+        Type                   type = Type::STRING;
+        if (spec.occurrence == CustomFieldSpec::Occurrence::COUNT)
+        {
+            type = Type::INT32;
+        }
+        else if (spec.occurrence != CustomFieldSpec::Occurrence::ALL)
+        {
+            type = spec.type == CustomFieldSpec::Type::DOUBLE ? Type::FLOAT64
+                 : spec.type == CustomFieldSpec::Type::INT    ? Type::INT32
+                                                              : Type::STRING;
+        }
+        columns.push_back({spec.name, type});
+    }
+    return columns;
+}
+
+std::string CustomFieldSet::format_double(double value)
+{
+    // 15 significant digits give back every decimal a log prints, without binary noise
+    char text[32];
+    std::snprintf(text, sizeof(text), "%.15g", value);
+    return text;
+}
+
+std::vector<std::string> CustomFieldSet::values(const std::vector<std::string>& collected) const
+{
+    std::vector<std::string> values(collected);
+    values.resize(fields_.size());
+    for (size_t i = 0; i < fields_.size(); ++i)
+    {
+        if (fields_[i].spec.occurrence == CustomFieldSpec::Occurrence::COUNT && values[i].empty())
+        {
+            values[i] = "0";
+        }
+    }
+    return values;
+}
+
+void CustomFieldSet::apply(std::string_view line, unsigned anchors, std::vector<std::string>& values) const
+{
+    if (values.size() < fields_.size())
+    {
+        values.resize(fields_.size());
+    }
+
+    for (size_t i = 0; i < fields_.size(); ++i)
+    {
+        const Compiled& field = fields_[i];
+        std::string&    value = values[i];
+        if (anchors & field.reset_bits)
+        {
+            value.clear();
+        }
+        if (!(anchors & field.anchor_bits))
+        {
+            continue;
+        }
+
+        std::string read;
+        switch (field.spec.occurrence)
+        {
+            case CustomFieldSpec::Occurrence::COUNT:
+            {
+                long long count = 0;
+                parse_int(value, count);
+                value = std::to_string(count + 1);
+                break;
+            }
+            case CustomFieldSpec::Occurrence::FIRST:
+                if (value.empty())
+                {
+                    read_value(line, field, value);
+                }
+                break;
+            case CustomFieldSpec::Occurrence::ALL:
+                if (read_value(line, field, read))
+                {
+                    if (!value.empty())
+                    {
+                        value += ';';
+                    }
+                    value += read;
+                }
+                break;
+            case CustomFieldSpec::Occurrence::LAST:
+            default:
+                if (read_value(line, field, read))
+                {
+                    value.swap(read);
+                }
+                break;
+        }
+    }
+}
+
+void CustomFieldSet::merge(std::vector<std::string>& values, const std::vector<std::string>& later) const
+{
+    if (values.size() < fields_.size())
+    {
+        values.resize(fields_.size());
+    }
+
+    for (size_t i = 0; i < fields_.size() && i < later.size(); ++i)
+    {
+        std::string&       value = values[i];
+        const std::string& next  = later[i];
+        if (next.empty())
+        {
+            continue;
+        }
+        switch (fields_[i].spec.occurrence)
+        {
+            case CustomFieldSpec::Occurrence::COUNT:
+            {
+                long long count = 0, more = 0;
+                parse_int(value, count);
+                parse_int(next, more);
+                value = std::to_string(count + more);
+                break;
+            }
+            case CustomFieldSpec::Occurrence::FIRST:
+                if (value.empty())
+                {
+                    value = next;
+                }
+                break;
+            case CustomFieldSpec::Occurrence::ALL:
+                if (!value.empty())
+                {
+                    value += ';';
+                }
+                value += next;
+                break;
+            case CustomFieldSpec::Occurrence::LAST:
+            default:
+                value = next;
+                break;
+        }
+    }
+}
+
+bool CustomFieldSet::read_value(std::string_view line, const Compiled& field, std::string& value) const
+{
+    const CustomFieldSpec& spec = field.spec;
+    std::string_view       token;
+    if (spec.token != 0)
+    {
+        token = token_at(line, spec.token);
+    }
+    else
+    {
+        size_t at = line.find(spec.anchor);
+        if (at == std::string_view::npos || at + spec.anchor.size() + spec.offset > line.size())
+        {
+            return false;
+        }
+        size_t start = at + spec.anchor.size() + spec.offset;
+        while (start < line.size() && is_blank(line[start]))
+        {
+            ++start;
+        }
+        size_t end = start;
+        while (end < line.size() && !is_blank(line[end]))
+        {
+            ++end;
+        }
+        token = line.substr(start, end - start);
+    }
+    if (token.empty())
+    {
+        return false;
+    }
+
+    switch (spec.type)
+    {
+        case CustomFieldSpec::Type::DOUBLE:
+        {
+            // Fortran exponents (1.0D-02) are read as 1.0E-02; the value is printed back in one canonical form
+            std::string number(token);
+            std::replace(number.begin(), number.end(), 'D', 'E');
+            std::replace(number.begin(), number.end(), 'd', 'e');
+            double parsed = 0.0;
+            if (!LogScanner::parse_leading_double(number, parsed))
+            {
+                return false;
+            }
+            value = format_double(parsed);
+            return true;
+        }
+        case CustomFieldSpec::Type::INT:
+        {
+            long long parsed = 0;
+            if (!parse_int(token, parsed))
+            {
+                return false;
+            }
+            value = std::to_string(parsed);
+            return true;
+        }
+        case CustomFieldSpec::Type::STRING:
+        default:
+            value = std::string(token);
+            return true;
+    }
+}
@@ -0,0 +1,256 @@
+/**
+ * @file custom_fields.h
+ * @brief User-defined extraction fields collected by the extract scan
+ * @author Le Nhan Pham
+ * @date 2025
+ *
+ * This header provides the declarative fields that users add to the results
+ * table through the configuration file. Every field names an anchor phrase and
+ * where its value sits on the anchor line; the anchors are compiled into the
+ * same LogScanner::AnchorSet as the built-in extract() anchors, so the values
+ * are picked up in the single pass that already reads each log.
+ *
+ * @section Field Specification
+ * A field is one configuration line "field.<name> = <spec>", where the spec is
+ * a list of "key=value" pairs separated by ';':
+ * - anchor=<text>: literal phrase marking the line (at least two characters;
+ *   quote it with ' to keep leading or trailing blanks)
+ * - field=<N>: the value is the N-th whitespace-separated token of the line
+ *   (1-based; negative counts from the end of the line)
+ * - offset=<N>: the value is the first token starting N bytes after the end of
+ *   the anchor (default when neither is given: offset=0)
+ * - type=double|int|string: how the token is read (default double)
+ * - occurrence=first|last|all|count: which anchor lines count (default last);
+ *   "all" joins the values with ';', "count" is the number of anchor lines
+ * - reset=<text>: a phrase that clears the value collected so far, so "first"
+ *   is the first occurrence after the last reset (e.g. the LUMO is the first
+ *   virtual eigenvalue after the last "Alpha  occ. eigenvalues" block)
+ *
+ * Example:
+ * @code
+ * field.dipole = "anchor=' Tot='; type=double; occurrence=last"
+ * field.s2     = "anchor=S**2 before annihilation; field=4; occurrence=last"
+ * field.nimag  = "anchor=imaginary frequencies; field=2; type=int"
+ * @endcode
+ *
+ * @section Limits
+ * A field is read from its anchor line only. Multi-line blocks (Mulliken or
+ * NBO charge tables, orbital lists spanning lines) have no single-line value
+ * and are not expressible. The anchor set holds 32 phrases, of which the
+ * built-in scan uses 16, so the distinct anchor and reset phrases of all
+ * fields are limited to 16.
+ */
+
+#ifndef CUSTOM_FIELDS_H
+#define CUSTOM_FIELDS_H
+
+#include "extraction/log_scanner.h"
+#include "utilities/columnar_writer.h"
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+/**
+ * @struct CustomFieldSpec
+ * @brief One parsed "field.<name>" configuration entry
+ */
+struct CustomFieldSpec
+{
+    /**
+     * @enum Type
+     * @brief How the value token is read
+     */
+    enum class Type
+    {
+        DOUBLE,  ///< Floating point number (Fortran 'D' exponents accepted)
+        INT,     ///< Integer
+        STRING   ///< Token as written
+    };
+
+    /**
+     * @enum Occurrence
+     * @brief Which anchor lines contribute to the value
+     */
+    enum class Occurrence
+    {
+        FIRST,  ///< First anchor line since the last reset
+        LAST,   ///< Last anchor line
+        ALL,    ///< Every anchor line, joined with ';'
+        COUNT   ///< Number of anchor lines
+    };
+
+    std::string name;                            ///< Column name
+    std::string anchor;                          ///< Phrase marking the value's line
+    std::string reset;                           ///< Phrase clearing the value (empty = none)
+    int         token      = 0;                  ///< 1-based token index of the line (negative from the end, 0 = unused)
+    size_t      offset     = 0;                  ///< Bytes after the anchor where the value starts (token == 0)
+    Type        type       = Type::DOUBLE;       ///< Value type
+    Occurrence  occurrence = Occurrence::LAST;   ///< Contributing occurrences
+};
+
+/**
+ * @class CustomFieldSet
+ * @brief Compiled user-defined fields and the anchor set that finds them
+ *
+ * Immutable after compile() and shared between worker threads. Per-log state
+ * is LogScanData::field_values, one display string per field ("" while no
+ * value was found).
+ */
+class CustomFieldSet
+{
+public:
+    /**
+     * @brief Parse the spec of one field
+     * @param name Field name (the part after "field.")
+     * @param text Spec text (see the file documentation)
+     * @param spec Receives the parsed field
+     * @param error Receives a message when the spec is invalid
+     * @return false if the spec is invalid
+     */
+    static bool parse_spec(const std::string& name, const std::string& text, CustomFieldSpec& spec, std::string& error);
+
+    /**
+     * @brief Compile parsed fields into one anchor set with the extract() anchors
+     * @param fields Fields in column order
+     * @param error Receives a message when the fields cannot be compiled
+     * @return The compiled set; nullptr when @p fields is empty or on error
+     */
+    static std::shared_ptr<const CustomFieldSet> compile(const std::vector<CustomFieldSpec>& fields, std::string& error);
+
+    /**
+     * @brief Parse and compile "field.<name>" configuration entries
+     * @param entries (name, spec) pairs in file order (ConfigManager::get_custom_fields())
+     * @param errors Receives one message per field that is skipped
+     * @return The compiled valid fields; nullptr when there are none
+     */
+    static std::shared_ptr<const CustomFieldSet>
+    from_config(const std::vector<std::pair<std::string, std::string>>& entries, std::vector<std::string>& errors);
+
+    /**
+     * @brief Make a set the one extract uses (nullptr = no custom fields)
+     *
+     * Set by the command layer from the configuration before extract runs,
+     * the way TaskExecutor::set_placement() is.
+     */
+    static void install(std::shared_ptr<const CustomFieldSet> fields);
+
+    /**
+     * @brief The set extract uses; nullptr when no fields are configured
+     */
+    static std::shared_ptr<const CustomFieldSet> installed();
+
+    /**
+     * @brief Built-in extract() anchors (bits 0-15) followed by the field phrases
+     */
+    const LogScanner::AnchorSet& anchors() const
+    {
+        return anchors_;
+    }
+
+    /**
+     * @brief Bits of @ref anchors() that any field or reset phrase uses
+     */
+    unsigned anchor_mask() const
+    {
+        return mask_;
+    }
+
+    /**
+     * @brief Number of fields
+     */
+    size_t size() const
+    {
+        return fields_.size();
+    }
+
+    /**
+     * @brief Parsed field @p index
+     */
+    const CustomFieldSpec& field(size_t index) const
+    {
+        return fields_[index].spec;
+    }
+
+    /**
+     * @brief Results table columns of the fields, in field order
+     *
+     * double fields are FLOAT64, int and count fields INT32, string and "all"
+     * fields STRING.
+     */
+    std::vector<ColumnarWriter::Column> columns() const;
+
+    /**
+     * @brief Identifies the field specs, so result index entries of other specs are not reused
+     */
+    const std::string& signature() const
+    {
+        return signature_;
+    }
+
+    /**
+     * @brief Canonical text of a double value, as fields and merged partial results print it
+     */
+    static std::string format_double(double value);
+
+    /**
+     * @brief Field values of a log for the results table
+     * @param collected LogScanData::field_values of the log
+     * @return One value per field; "" when the anchor was not found, "0" for counts
+     */
+    std::vector<std::string> values(const std::vector<std::string>& collected) const;
+
+    /**
+     * @brief Update the field values from one anchor line
+     * @param line Line holding at least one anchor of anchors()
+     * @param anchors Bitmask of anchors() found in the line
+     * @param values Per-field values of the log, resized to size() if needed
+     */
+    void apply(std::string_view line, unsigned anchors, std::vector<std::string>& values) const;
+
+    /**
+     * @brief Whether the values of consecutive parts of a log can be merged (see merge())
+     *
+     * False when a field has a reset phrase: a part cannot tell whether an
+     * earlier part's value was cleared before its first anchor line.
+     */
+    bool mergeable() const
+    {
+        return mergeable_;
+    }
+
+    /**
+     * @brief Combine the values of a log part with those of the part after it
+     * @param values Values collected up to the end of the earlier part; updated in place
+     * @param later Values collected by the next part alone
+     *
+     * Counts add up, "first" keeps the earlier value, "last" takes the later
+     * one and "all" joins both lists.
+     */
+    void merge(std::vector<std::string>& values, const std::vector<std::string>& later) const;
+
+private:
+    /**
+     * @struct Compiled
+     * @brief A field with the bits of its phrases in anchors_
+     */
+    struct Compiled
+    {
+        CustomFieldSpec spec;
+        unsigned        anchor_bits = 0;  ///< Bit of spec.anchor
+        unsigned        reset_bits  = 0;  ///< Bit of spec.reset (0 = no reset)
+    };
+
+    CustomFieldSet(std::vector<Compiled> fields, const std::vector<std::string_view>& phrases);
+
+    bool read_value(std::string_view line, const Compiled& field, std::string& value) const;
+
+    std::vector<Compiled> fields_;             ///< Fields in column order
+    LogScanner::AnchorSet anchors_;            ///< Built-in anchors followed by the field phrases
+    unsigned              mask_      = 0;      ///< Bits of field and reset phrases
+    bool                  mergeable_ = true;   ///< No field has a reset phrase
+    std::string           signature_;          ///< Hash of the specs
+};
+
+#endif  // CUSTOM_FIELDS_H
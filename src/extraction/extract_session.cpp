@@ -0,0 +1,119 @@
+/**
+ * @file extract_session.cpp
+ * @brief Implementation of the in-process extraction API
+ * @author Le Nhan Pham
+ * @date 2025
+ */
+
+#include "extract_session.h"
+#include "extraction/custom_fields.h"
+#include "job_management/job_scheduler.h"
+#include "utilities/task_executor.h"
+#include <algorithm>
+#include <exception>
+#include <limits>
+#include <thread>
+
+ExtractSession::ExtractSession(const ExtractOptions& options) : threads_(1)
+{
+    JobResources resources = JobSchedulerDetector::detect_job_resources();
+
+    // The thread count does not depend on the batch, so the shared executor is built once and reused
+    unsigned int requested = options.threads;
+    if (requested == 0)
+    {
+        unsigned int cores = resources.cpu_set.empty() ? std::thread::hardware_concurrency()
+                                                       : static_cast<unsigned int>(resources.cpu_set.size());
+        requested          = std::max(1u, cores / 2);
+    }
+    threads_ = std::max(1u, calculateSafeThreadCount(requested, std::numeric_limits<unsigned int>::max(), resources));
+
+    context_ = std::make_shared<ProcessingContext>(options.temp,
+                                                   options.concentration,
+                                                   options.use_input_temp,
+                                                   threads_,
+                                                   ".log",
+                                                   DEFAULT_MAX_FILE_SIZE_MB,
+                                                   resources);
+    if (options.memory_limit_mb > 0)
+    {
+        context_->memory_monitor->set_memory_limit(options.memory_limit_mb);
+    }
+    context_->scan_mode     = options.scan_mode;
+    context_->custom_fields = options.custom_fields;
+    if (options.custom_fields)
+    {
+        field_columns_ = options.custom_fields->columns();
+    }
+    if (options.use_result_index)
+    {
+        context_->result_index = std::make_shared<ResultIndex>(options.index_path);
+        context_->result_index->load();
+    }
+}
+
+ExtractSession::~ExtractSession()
+{
+    save_index();
+}
+
+ColumnarBatch ExtractSession::extract_many(const std::vector<std::string>& paths)
+{
+    std::vector<Result> results(paths.size());
+    std::vector<char>   scanned(paths.size(), 0);
+
+    auto process_file = [&](size_t i) {
+        try
+        {
+            results[i] = extract(paths[i], *context_);
+            scanned[i] = 1;
+        }
+        catch (const std::exception& e)
+        {
+            context_->error_collector->add_error("Error processing file '" + paths[i] + "': " + e.what());
+        }
+        catch (...)
+        {
+            context_->error_collector->add_error("Unknown error processing file: " + paths[i]);
+        }
+    };
+    TaskExecutor::shared(threads_).run(paths.size(), process_file, TaskExecutor::file_sizes(paths));
+
+    const double  nan = std::numeric_limits<double>::quiet_NaN();
+    ColumnarBatch batch(resultTableColumns(field_columns_));
+    for (size_t i = 0; i < paths.size(); ++i)
+    {
+        // Rows stay aligned with paths: logs that failed or were not reached after a shutdown are ERROR rows
+        if (!scanned[i])
+        {
+            Result& res          = results[i];
+            res.file_name        = paths[i];
+            res.etgkj            = nan;
+            res.lf               = nan;
+            res.GibbsFreeHartree = nan;
+            res.nucleare         = nan;
+            res.scf              = nan;
+            res.zpe              = nan;
+            res.copyright_count  = 0;
+            res.status           = ResultStatus::FAILED;
+            res.phaseCorr        = false;
+            res.field_values.clear();
+        }
+        appendResultRow(batch, results[i], field_columns_);
+    }
+    return batch;
+}
+
+std::vector<std::string> ExtractSession::take_errors()
+{
+    std::vector<std::string> messages = context_->error_collector->get_errors();
+    std::vector<std::string> warnings = context_->error_collector->get_warnings();
+    messages.insert(messages.end(), warnings.begin(), warnings.end());
+    context_->error_collector->clear();
+    return messages;
+}
+
+bool ExtractSession::save_index()
+{
+    return context_->result_index && context_->result_index->save();
+}
@@ -0,0 +1,122 @@
+/**
+ * @file extract_session.h
+ * @brief In-process extraction API of libgaussian_extractor
+ * @author Le Nhan Pham
+ * @date 2025
+ *
+ * This header is the entry point for programs that link the extractor as a
+ * library instead of running gaussian_extractor.x and parsing its table. A
+ * session is set up once; each extract_many() call then scans the given logs
+ * on the session's threads and returns the results table as a ColumnarBatch,
+ * one contiguous array per column, with no text formatted or parsed.
+ *
+ * @section Session State
+ * Everything that the command line rebuilds on every run stays alive between
+ * calls: the worker threads (TaskExecutor::shared()), the file handle and
+ * memory limits, the compiled custom fields and, when enabled, the result
+ * index, so logs that did not change since an earlier call are not read
+ * again. No configuration file is loaded and no directory is listed.
+ *
+ * Example:
+ * @code
+ * ExtractOptions options;
+ * options.use_result_index = true;
+ * ExtractSession session(options);
+ * ColumnarBatch batch = session.extract_many({"ts1.log", "ts2.log"});
+ * const std::vector<double>& gibbs = batch.doubles(batch.find("etg_hartree"));
+ * @endcode
+ *
+ * The job checks, high-level energies and geometries are in the library as
+ * well, through JobChecker, HighLevelEnergyCalculator and CoordExtractor.
+ */
+
+#ifndef EXTRACT_SESSION_H
+#define EXTRACT_SESSION_H
+
+#include "extraction/gaussian_extractor.h"
+#include "utilities/columnar_writer.h"
+#include "utilities/result_index.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+class CustomFieldSet;
+
+/**
+ * @struct ExtractOptions
+ * @brief Settings of an ExtractSession, the library counterpart of the extract options
+ */
+struct ExtractOptions
+{
+    double                                temp             = 298.15;                 ///< Temperature (K) for logs without one
+    int                                   concentration    = 1000;                   ///< Concentration for the phase correction (mM)
+    bool                                  use_input_temp   = false;                  ///< Use the temperature printed in each log
+    unsigned int                          threads          = 0;                      ///< Worker threads (0 = half of the allowed CPUs)
+    ScanMode                              scan_mode        = ScanMode::FAST;         ///< Engine used to parse each log
+    size_t                                memory_limit_mb  = 0;                      ///< Memory limit (0 = from the thread count)
+    bool                                  use_result_index = false;                  ///< Reuse results of unchanged logs
+    std::string                           index_path       = RESULT_INDEX_FILENAME;  ///< Result index file
+    std::shared_ptr<const CustomFieldSet> custom_fields;                             ///< User-defined fields (nullptr = none)
+};
+
+/**
+ * @class ExtractSession
+ * @brief Long-lived extraction state serving repeated extract_many() calls
+ *
+ * A session is used by one thread at a time; calls on different sessions
+ * must not overlap either, since they share the process-wide executor.
+ */
+class ExtractSession
+{
+public:
+    /**
+     * @brief Set up threads, resource limits and the result index
+     * @param options Session settings
+     */
+    explicit ExtractSession(const ExtractOptions& options = ExtractOptions());
+
+    /**
+     * @brief Save the result index, if one is used
+     */
+    ~ExtractSession();
+
+    ExtractSession(const ExtractSession&)            = delete;
+    ExtractSession& operator=(const ExtractSession&) = delete;
+
+    /**
+     * @brief Scan logs and return their results table
+     * @param paths Log files (plain, .gz or .zst)
+     * @return One row per path, in the order of @p paths, with the columns of
+     *         resultTableColumns() followed by the custom fields
+     *
+     * A log that cannot be scanned keeps its row, with status "ERROR" and NaN
+     * energies; the reason is available from take_errors().
+     */
+    ColumnarBatch extract_many(const std::vector<std::string>& paths);
+
+    /**
+     * @brief Errors and warnings collected since the last call, which are then cleared
+     */
+    std::vector<std::string> take_errors();
+
+    /**
+     * @brief Write the result index now instead of when the session ends
+     * @return false if no index is used or it could not be written
+     */
+    bool save_index();
+
+    /**
+     * @brief Worker threads used by extract_many()
+     */
+    unsigned int thread_count() const
+    {
+        return threads_;
+    }
+
+private:
+    std::shared_ptr<ProcessingContext>  context_;        ///< Limits, index and fields shared by all calls
+    std::vector<ColumnarWriter::Column> field_columns_;  ///< Columns of the custom fields
+    unsigned int                        threads_;        ///< Executor size
+};
+
+#endif  // EXTRACT_SESSION_H
@@ -37,6 +37,19 @@
  */
 
 #include "gaussian_extractor.h"
+#include "extraction/coord_extractor.h"
+#include "extraction/custom_fields.h"
+#include "extraction/log_scanner.h"
+#include "extraction/result_filter.h"
+#include "utilities/compressed_input.h"
+#include "utilities/columnar_writer.h"
+#include "utilities/file_discovery.h"
+#include "utilities/profiler.h"
+#include "utilities/readahead.h"
+#include "utilities/result_index.h"
+#include "utilities/run_journal.h"
+#include "utilities/session_state.h"
+#include "utilities/task_executor.h"
 #include "job_management/job_scheduler.h"
 #include "utilities/metadata.h"
 #include <algorithm>
@@ -48,13 +61,18 @@
 #include <exception>
 #include <filesystem>
 #include <fstream>
-#include <future>
 #include <iomanip>
 #include <iostream>
+#include <limits>
+#include <map>
+#include <memory>
 #include <mutex>
+#include <queue>
 #include <regex>
 #include <sstream>
+#include <string_view>
 #include <thread>
+#include <unordered_map>
 #include <vector>
 
 #ifdef _WIN32
@@ -88,8 +106,8 @@ const double kB = 0.000003166811563;
 
 /** @} */  // end of PhysicalConstants group
 
-// External global variable for shutdown handling
-extern std::atomic<bool> g_shutdown_requested;
+// Global shutdown flag, set by the signal handler of main.cpp (see gaussian_extractor.h)
+std::atomic<bool> g_shutdown_requested{false};
 
 /**
  * @defgroup MemoryMonitorImpl MemoryMonitor Implementation
@@ -149,6 +167,107 @@ void MemoryMonitor::add_usage(size_t bytes)
 void MemoryMonitor::remove_usage(size_t bytes)
 {
     current_usage_bytes.fetch_sub(bytes);
+    {
+        // Taking the lock orders this release before a waiter's next admission check
+        std::lock_guard<std::mutex> lock(reservation_mutex_);
+    }
+    reservation_released_.notify_all();
+}
+
+/**
+ * @brief Reserve memory, blocking until the limit admits it
+ * @param bytes Number of bytes to reserve
+ * @return Reservation holding the bytes; not acquired only after a shutdown request
+ */
+MemoryMonitor::Reservation MemoryMonitor::reserve(size_t bytes)
+{
+    return acquire(bytes, nullptr) ? Reservation(this, bytes) : Reservation();
+}
+
+/**
+ * @brief Reserve memory, waiting at most the given timeout
+ * @param bytes Number of bytes to reserve
+ * @param timeout Longest time to wait
+ * @return Reservation holding the bytes; not acquired on timeout or shutdown
+ */
+MemoryMonitor::Reservation MemoryMonitor::try_reserve(size_t bytes, std::chrono::milliseconds timeout)
+{
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    return acquire(bytes, &deadline) ? Reservation(this, bytes) : Reservation();
+}
+
+/**
+ * @brief Number of reservations that waited for memory
+ * @return Count since monitor creation
+ */
+size_t MemoryMonitor::get_delayed_reservations() const
+{
+    return delayed_reservations_.load();
+}
+
+/**
+ * @brief Admit bytes against the limit and charge them in one step
+ * @param bytes Number of bytes to admit
+ * @param deadline Give up at this time; null to wait indefinitely
+ * @return true if the bytes were charged
+ *
+ * The check and the update happen under reservation_mutex_, so concurrent
+ * callers cannot both pass the check for the last free bytes. The wait is
+ * woken by every release and, at the latest, every 100 ms to notice a
+ * shutdown request.
+ */
+bool MemoryMonitor::acquire(size_t bytes, const std::chrono::steady_clock::time_point* deadline)
+{
+    const auto poll_interval = std::chrono::milliseconds(100);
+
+    std::unique_lock<std::mutex> lock(reservation_mutex_);
+    auto                         admissible = [this, bytes] {
+        return outstanding_ == 0 || current_usage_bytes.load() + bytes <= max_bytes.load();
+    };
+
+    bool            waited = false;
+    Profiler::Scope wait(Profiler::Phase::MEMORY_WAIT, !admissible());
+    while (!admissible())
+    {
+        if (g_shutdown_requested.load())
+        {
+            return false;
+        }
+        auto now = std::chrono::steady_clock::now();
+        if (deadline && now >= *deadline)
+        {
+            return false;
+        }
+        auto wake = now + poll_interval;
+        if (deadline && *deadline < wake)
+        {
+            wake = *deadline;
+        }
+        waited = true;
+        reservation_released_.wait_until(lock, wake);
+    }
+
+    ++outstanding_;
+    add_usage(bytes);
+    if (waited)
+    {
+        delayed_reservations_.fetch_add(1);
+    }
+    return true;
+}
+
+/**
+ * @brief Return the bytes of a reservation and wake waiting threads
+ * @param bytes Number of bytes the reservation held
+ */
+void MemoryMonitor::release(size_t bytes)
+{
+    {
+        std::lock_guard<std::mutex> lock(reservation_mutex_);
+        --outstanding_;
+        current_usage_bytes.fetch_sub(bytes);
+    }
+    reservation_released_.notify_all();
 }
 
 /**
@@ -187,11 +306,16 @@ size_t MemoryMonitor::get_max_usage() const
  * @param max_memory_mb New memory limit in megabytes
  *
  * Allows dynamic adjustment of memory limits based on system conditions
- * or user preferences. Not thread-safe for concurrent limit changes.
+ * or user preferences. Waiting reservations are re-evaluated against the
+ * new limit.
  */
 void MemoryMonitor::set_memory_limit(size_t max_memory_mb)
 {
-    max_bytes = max_memory_mb * 1024 * 1024;
+    {
+        std::lock_guard<std::mutex> lock(reservation_mutex_);
+        max_bytes = max_memory_mb * 1024 * 1024;
+    }
+    reservation_released_.notify_all();  // A larger limit may admit waiting reservations
 }
 
 /**
@@ -287,6 +411,7 @@ FileHandleManager::FileGuard::FileGuard(FileHandleManager* mgr) : manager(mgr),
 {
     if (manager)
     {
+        Profiler::Scope wait(Profiler::Phase::HANDLE_WAIT);
 #if __cpp_lib_semaphore >= 201907L
         manager->semaphore.acquire();
 #else
@@ -515,173 +640,35 @@ bool validateFileSize(const std::string& filename, size_t max_size_mb)
 //    return log_files;
 //}
 
-// Function to find log files with multiple extensions
-std::vector<std::string> findLogFiles(const std::vector<std::string>& extensions, size_t max_file_size_mb)
+// Function to find log files with multiple extensions; one directory walk matches all of them
+std::vector<std::string>
+findLogFiles(const std::vector<std::string>& extensions, size_t max_file_size_mb, bool recursive)
 {
-    std::vector<std::string> all_log_files;
-
-    for (const auto& extension : extensions)
-    {
-        auto files = findLogFiles(extension, max_file_size_mb);
-        all_log_files.insert(all_log_files.end(), files.begin(), files.end());
-    }
-
-    // Remove duplicates and sort
-    std::sort(all_log_files.begin(), all_log_files.end());
-    auto last = std::unique(all_log_files.begin(), all_log_files.end());
-    all_log_files.erase(last, all_log_files.end());
-
-    return all_log_files;
+    FileDiscovery::Options options;
+    options.extensions       = extensions;
+    options.max_file_size_mb = max_file_size_mb;
+    options.recursive        = recursive;
+    return FileDiscovery::collect(options);
 }
 
 // Batch processing version for multiple extensions
 std::vector<std::string>
-findLogFiles(const std::vector<std::string>& extensions, size_t max_file_size_mb, size_t batch_size)
+findLogFiles(const std::vector<std::string>& extensions, size_t max_file_size_mb, size_t batch_size, bool recursive)
 {
-    std::vector<std::string> all_log_files;
-
-    for (const auto& extension : extensions)
-    {
-        auto files = findLogFiles(extension, max_file_size_mb, batch_size);
-        all_log_files.insert(all_log_files.end(), files.begin(), files.end());
-    }
-
-    // Remove duplicates and sort
-    std::sort(all_log_files.begin(), all_log_files.end());
-    auto last = std::unique(all_log_files.begin(), all_log_files.end());
-    all_log_files.erase(last, all_log_files.end());
-
-    return all_log_files;
+    // The walk holds one entry per matching file, so batching no longer changes memory use or order
+    (void)batch_size;
+    return findLogFiles(extensions, max_file_size_mb, recursive);
 }
 
-// A better version of findLogfiles
-// Helper to collect all files using batches
 std::vector<std::string> findLogFiles(const std::string& extension, size_t max_file_size_mb)
 {
-    std::vector<std::string> log_files;
-
-    try
-    {
-        // Use single directory iteration with direct push_back for better performance
-        for (const auto& entry : std::filesystem::directory_iterator("."))
-        {
-            if (g_shutdown_requested.load())
-            {
-                break;
-            }
-
-            if (entry.is_regular_file())
-            {
-                std::string file_ext = entry.path().extension().string();
-                // Case-insensitive extension comparison
-                bool extension_match = false;
-                if (file_ext.length() == extension.length())
-                {
-                    extension_match = true;
-                    for (size_t i = 0; i < file_ext.length(); ++i)
-                    {
-                        if (std::tolower(file_ext[i]) != std::tolower(extension[i]))
-                        {
-                            extension_match = false;
-                            break;
-                        }
-                    }
-                }
-                if (extension_match)
-                {
-                    auto file_size = entry.file_size();
-                    if (file_size <= max_file_size_mb * 1024 * 1024)
-                    {
-                        log_files.push_back(entry.path().filename().string());
-                    }
-                }
-            }
-        }
-
-        // Sort the files for consistent processing order
-        std::sort(log_files.begin(), log_files.end());
-    }
-    catch (const std::filesystem::filesystem_error& e)
-    {
-        throw std::runtime_error("Error accessing directory: " + std::string(e.what()));
-    }
-
-    return log_files;
+    return findLogFiles(std::vector<std::string>{extension}, max_file_size_mb, false);
 }
 
 // Batch processing version for handling millions of files with controlled memory usage
 std::vector<std::string> findLogFiles(const std::string& extension, size_t max_file_size_mb, size_t batch_size)
 {
-    std::vector<std::string> all_log_files;
-    std::vector<std::string> batch_files;
-    batch_files.reserve(batch_size);
-
-    try
-    {
-        // Process files in batches to control memory usage
-        for (const auto& entry : std::filesystem::directory_iterator("."))
-        {
-            if (g_shutdown_requested.load())
-            {
-                break;
-            }
-
-            if (entry.is_regular_file())
-            {
-                std::string file_ext = entry.path().extension().string();
-                // Case-insensitive extension comparison
-                bool extension_match = false;
-                if (file_ext.length() == extension.length())
-                {
-                    extension_match = true;
-                    for (size_t i = 0; i < file_ext.length(); ++i)
-                    {
-                        if (std::tolower(file_ext[i]) != std::tolower(extension[i]))
-                        {
-                            extension_match = false;
-                            break;
-                        }
-                    }
-                }
-                if (extension_match)
-                {
-                    auto file_size = entry.file_size();
-                    if (file_size <= max_file_size_mb * 1024 * 1024)
-                    {
-                        batch_files.push_back(entry.path().filename().string());
-
-                        // When batch is full, sort and move to main vector
-                        if (batch_files.size() >= batch_size)
-                        {
-                            std::sort(batch_files.begin(), batch_files.end());
-                            all_log_files.insert(all_log_files.end(),
-                                                 std::make_move_iterator(batch_files.begin()),
-                                                 std::make_move_iterator(batch_files.end()));
-                            batch_files.clear();
-                        }
-                    }
-                }
-            }
-        }
-
-        // Handle remaining files in last batch
-        if (!batch_files.empty())
-        {
-            std::sort(batch_files.begin(), batch_files.end());
-            all_log_files.insert(all_log_files.end(),
-                                 std::make_move_iterator(batch_files.begin()),
-                                 std::make_move_iterator(batch_files.end()));
-        }
-
-        // Final sort of all batches together to maintain global order
-        std::sort(all_log_files.begin(), all_log_files.end());
-    }
-    catch (const std::filesystem::filesystem_error& e)
-    {
-        throw std::runtime_error("Error accessing directory: " + std::string(e.what()));
-    }
-
-    return all_log_files;
+    return findLogFiles(std::vector<std::string>{extension}, max_file_size_mb, batch_size, false);
 }
 
 
@@ -734,7 +721,9 @@ void printJobResourceInfo(const JobResources& job_resources, bool quiet)
 unsigned int
 calculateSafeThreadCount(unsigned int requested_threads, unsigned int file_count, const JobResources& job_resources)
 {
-    unsigned int hardware_cores = std::thread::hardware_concurrency();
+    // CPUs of the process's cpuset, not of the node: co-scheduled jobs own the rest
+    unsigned int hardware_cores = job_resources.cpu_set.empty() ? std::thread::hardware_concurrency()
+                                                                : static_cast<unsigned int>(job_resources.cpu_set.size());
     if (hardware_cores == 0)
         hardware_cores = 4;
 
@@ -783,6 +772,12 @@ calculateSafeThreadCount(unsigned int requested_threads, unsigned int file_count
         max_safe_threads = std::min(max_safe_threads, job_resources.allocated_cpus);
     }
 
+    // More threads than allowed CPUs only take turns on them
+    if (!job_resources.cpu_set.empty())
+    {
+        max_safe_threads = std::min(max_safe_threads, static_cast<unsigned int>(job_resources.cpu_set.size()));
+    }
+
     // Never exceed file count
     max_safe_threads = std::min(max_safe_threads, file_count);
 
@@ -815,6 +810,50 @@ calculateSafeMemoryLimit(size_t requested_memory_mb, unsigned int thread_count,
     return calculated_memory;
 }
 
+const char* resultStatusName(ResultStatus status)
+{
+    switch (status)
+    {
+        case ResultStatus::DONE:
+            return "DONE";
+        case ResultStatus::FAILED:
+            return "ERROR";
+        case ResultStatus::UNDONE:
+        default:
+            return "UNDONE";
+    }
+}
+
+/**
+ * @brief Column text of the phase correction flag
+ */
+static const char* phaseCorrName(bool phaseCorr)
+{
+    return phaseCorr ? "YES" : "NO";
+}
+
+/**
+ * @brief Status of a column text written by resultStatusName()
+ */
+static ResultStatus parseResultStatus(std::string_view name)
+{
+    if (name == "DONE")
+    {
+        return ResultStatus::DONE;
+    }
+    return name == "ERROR" ? ResultStatus::FAILED : ResultStatus::UNDONE;
+}
+
+/**
+ * @brief Whether compareResults() orders results by the given column
+ *
+ * Columns 1, 8 and 9 (name, status, phase correction) keep completion order.
+ */
+static bool isSortableColumn(int column)
+{
+    return (column >= 2 && column <= 7) || column == 10;
+}
+
 bool compareResults(const Result& a, const Result& b, int column)
 {
     switch (column)
@@ -838,105 +877,72 @@ bool compareResults(const Result& a, const Result& b, int column)
     }
 }
 
-Result extract(const std::string& file_name_param, const ProcessingContext& context)
+/**
+ * @brief Original line-by-line extraction engine (ScanMode::LEGACY)
+ *
+ * Reads the file with std::getline and tests each line with std::string::find
+ * and std::regex_search. Kept as the reference implementation for
+ * ScanMode::VERIFY.
+ */
+static LogScanData scanLogLegacy(const std::string&        file_name_param,
+                                 const std::string&        file_name,
+                                 const ProcessingContext&  context,
+                                 ThreadSafeErrorCollector& errors)
 {
-    // Check for shutdown signal
-    if (g_shutdown_requested.load())
-    {
-        throw std::runtime_error("Processing interrupted by shutdown signal");
-    }
-
-    // Acquire file handle
-    auto file_guard = context.file_manager->acquire();
-    if (!file_guard.is_acquired())
-    {
-        throw std::runtime_error("Could not acquire file handle for: " + file_name_param);
-    }
-
-    // Estimate memory usage for this file (simplified without content buffer overhead)
-    size_t estimated_memory = 0;
-    try
-    {
-        auto file_size   = std::filesystem::file_size(file_name_param);
-        estimated_memory = file_size / 10;  // Rough estimate for processing overhead only
-    }
-    catch (const std::filesystem::filesystem_error&)
-    {
-        estimated_memory = 102400;  // 100KB default estimate
-    }
-
-    if (!context.memory_monitor->can_allocate(estimated_memory))
-    {
-        throw std::runtime_error("Insufficient memory to process file: " + file_name_param);
-    }
-
-    context.memory_monitor->add_usage(estimated_memory);
-
-    // RAII class for memory cleanup
-    struct MemoryGuard
-    {
-        std::shared_ptr<MemoryMonitor> monitor;
-        size_t                         bytes;
-
-        MemoryGuard(std::shared_ptr<MemoryMonitor> m, size_t b) : monitor(m), bytes(b) {}
-        ~MemoryGuard()
-        {
-            if (monitor)
-                monitor->remove_usage(bytes);
-        }
-    };
-    MemoryGuard memory_guard(context.memory_monitor, estimated_memory);
-
-    std::ifstream file(file_name_param);
-    if (!file.is_open())
+    // Reading and parsing are interleaved line by line, so the whole scan counts as parsing
+    Profiler::Scope               parse(Profiler::Phase::PARSE);
+    std::unique_ptr<std::istream> stream = CompressedInput::open(file_name_param);
+    std::istream&                 file   = *stream;
+    if (!file)
     {
         throw std::runtime_error("Could not open file: " + file_name_param);
     }
 
-    std::string file_name = file_name_param;
-    if (file_name.substr(0, 2) == "./")
-    {
-        file_name = file_name.substr(2);
-    }
+    LogScanData data;
+    data.temp = context.base_temp;  // Local copy for this file
 
-    std::string         line;
-    int                 copyright_count = 0;
-    int                 normal_count    = 0;  // Count of "Normal termination" messages
-    int                 error_count     = 0;  // Count of "Error termination" messages
-    double              scf = 0, zpe = 0, tcg = 0, etg = 0, ezpe = 0, nucleare = 0;
-    double              scfEqui = 0, scftd = 0;
-    double              temp = context.base_temp;  // Local copy for this file
-    std::vector<double> negative_freqs, positive_freqs;
-    std::string         status    = "UNDONE";
-    std::string         phaseCorr = "NO";
+    std::string line;
 
     // Pre-compile regex patterns for better performance
     static const std::regex scf_pattern(R"(SCF Done.*?=\s+(-?\d+\.\d+))");
     static const std::regex freq_pattern(R"(Frequencies\s+--\s+(.*))");
 
-    std::vector<double> scf_values;
-    size_t              line_count = 0;
+    size_t         line_count = 0;
+    uint64_t       line_bytes = 0;
+    std::streamoff line_start = 0;  // Offset of the current line, tracked for the geometry writer only
 
     try
     {
         while (std::getline(file, line) && !g_shutdown_requested.load())
         {
             line_count++;
+            line_bytes += line.size() + 1;
+
+            if (context.geometry_writer)
+            {
+                if (line.find("Standard orientation:") != std::string::npos ||
+                    line.find("Input orientation:") != std::string::npos)
+                {
+                    data.has_orientation    = true;
+                    data.orientation_offset = static_cast<uint64_t>(line_start);
+                }
+                line_start = file.tellg();
+            }
 
             // Count termination status messages
             if (line.find("Normal termination") != std::string::npos)
             {
-                normal_count++;
+                data.normal_count++;
             }
             else if (line.find("Error termination") != std::string::npos)
             {
-                error_count++;
+                data.error_count++;
             }
 
             // Process line content
             if (line.find("Copyright") != std::string::npos)
             {
-                ++copyright_count;
+                ++data.copyright_count;
             }
 
             std::smatch match;
@@ -947,7 +953,8 @@ Result extract(const std::string& file_name_param, const ProcessingContext& cont
                     double value;
                     if (safe_stod(match[1], value))
                     {
-                        scf_values.push_back(value);
+                        data.has_scf  = true;
+                        data.last_scf = value;
                     }
                 }
                 else if (line.find("Total Energy, E(CIS") != std::string::npos)
@@ -956,7 +963,7 @@ Result extract(const std::string& file_name_param, const ProcessingContext& cont
                     if (eq_pos != std::string::npos)
                     {
                         std::string value_str = line.substr(eq_pos + 1);
-                        safe_stod(value_str, scftd);
+                        safe_stod(value_str, data.scftd);
                     }
                 }
                 else if (line.find("After PCM corrections, the energy is") != std::string::npos)
@@ -965,7 +972,7 @@ Result extract(const std::string& file_name_param, const ProcessingContext& cont
                     if (is_pos != std::string::npos)
                     {
                         std::string value_str = line.substr(is_pos + 2);
-                        safe_stod(value_str, scfEqui);
+                        safe_stod(value_str, data.scf_equi);
                     }
                 }
                 else if (line.find("Zero-point correction") != std::string::npos)
@@ -974,7 +981,7 @@ Result extract(const std::string& file_name_param, const ProcessingContext& cont
                     if (eq_pos != std::string::npos)
                     {
                         std::string value_str = line.substr(eq_pos + 1);
-                        safe_stod(value_str, zpe);
+                        safe_stod(value_str, data.zpe);
                     }
                 }
                 else if (line.find("Thermal correction to Gibbs Free Energy") != std::string::npos)
@@ -983,7 +990,7 @@ Result extract(const std::string& file_name_param, const ProcessingContext& cont
                     if (eq_pos != std::string::npos)
                     {
                         std::string value_str = line.substr(eq_pos + 1);
-                        safe_stod(value_str, tcg);
+                        safe_stod(value_str, data.tcg);
                     }
                 }
                 else if (line.find("Sum of electronic and thermal Free Energies") != std::string::npos)
@@ -992,7 +999,7 @@ Result extract(const std::string& file_name_param, const ProcessingContext& cont
                     if (eq_pos != std::string::npos)
                     {
                         std::string value_str = line.substr(eq_pos + 1);
-                        safe_stod(value_str, etg);
+                        safe_stod(value_str, data.etg);
                     }
                 }
                 else if (line.find("Sum of electronic and zero-point Energies") != std::string::npos)
@@ -1001,7 +1008,7 @@ Result extract(const std::string& file_name_param, const ProcessingContext& cont
                     if (eq_pos != std::string::npos)
                     {
                         std::string value_str = line.substr(eq_pos + 1);
-                        safe_stod(value_str, ezpe);
+                        safe_stod(value_str, data.ezpe);
                     }
                 }
                 else if (line.find("nuclear repulsion energy") != std::string::npos)
@@ -1020,10 +1027,10 @@ Result extract(const std::string& file_name_param, const ProcessingContext& cont
                         }
                         num_str.erase(num_str.find_last_not_of(" \t") + 1);
 
-                        if (!num_str.empty() && !safe_stod(num_str, nucleare))
+                        if (!num_str.empty() && !safe_stod(num_str, data.nucleare))
                         {
-                            context.error_collector->add_warning("Could not parse nuclear repulsion energy from '" +
-                                                                 line + "' in file '" + file_name + "'");
+                            errors.add_warning("Could not parse nuclear repulsion energy from '" + line +
+                                               "' in file '" + file_name + "'");
                         }
                     }
                 }
@@ -1033,14 +1040,7 @@ Result extract(const std::string& file_name_param, const ProcessingContext& cont
                     double             freq;
                     while (iss >> freq)
                     {
-                        if (freq < 0)
-                        {
-                            negative_freqs.push_back(freq);
-                        }
-                        else
-                        {
-                            positive_freqs.push_back(freq);
-                        }
+                        data.add_frequency(freq);
                     }
                 }
                 else if (!context.use_input_temp && line.find("Kelvin.  Pressure") != std::string::npos)
@@ -1059,28 +1059,27 @@ Result extract(const std::string& file_name_param, const ProcessingContext& cont
 
                         if (!temp_str.empty())
                         {
-                            if (!safe_stod(temp_str, temp))
+                            if (!safe_stod(temp_str, data.temp))
                             {
-                                context.error_collector->add_warning("Could not parse temperature from '" + line +
-                                                                     "' in file '" + file_name +
-                                                                     "'. Using default 298.15 K");
-                                temp = 298.15;
+                                errors.add_warning("Could not parse temperature from '" + line + "' in file '" +
+                                                   file_name + "'. Using default 298.15 K");
+                                data.temp = 298.15;
                             }
                         }
                     }
                 }
                 else if (line.find("scrf") != std::string::npos)
                 {
-                    phaseCorr = "YES";
+                    data.has_scrf = true;
                 }
             }
             catch (const std::regex_error& e)
             {
-                context.error_collector->add_warning("Regex error in file '" + file_name + "': " + e.what());
+                errors.add_warning("Regex error in file '" + file_name + "': " + e.what());
             }
             catch (const std::exception& e)
             {
-                context.error_collector->add_warning("Error processing line in file '" + file_name + "': " + e.what());
+                errors.add_warning("Error processing line in file '" + file_name + "': " + e.what());
             }
 
             // Periodically check for shutdown
@@ -1095,31 +1094,55 @@ Result extract(const std::string& file_name_param, const ProcessingContext& cont
         throw std::runtime_error("I/O error reading file '" + file_name + "': " + e.what());
     }
 
-    file.close();
+    stream.reset();
+    Profiler::add(Profiler::Counter::BYTES_READ, line_bytes);
+    Profiler::add(Profiler::Counter::LINES_SCANNED, line_count);
 
-    // Process extracted data
-    if (!scf_values.empty())
+    // The tail is only needed to confirm completion of a job without errors
+    if (data.error_count == 0 && data.normal_count >= data.copyright_count && data.copyright_count > 0)
     {
-        scf = scf_values.back();
+        // Read approximately the last 2KB of the (decompressed) file
+        try
+        {
+            std::string tail_content     = CompressedInput::read_tail(file_name_param, LOG_TAIL_CHECK_BYTES);
+            data.tail_normal_termination = tail_content.find("Normal termination") != std::string::npos;
+        }
+        catch (const std::runtime_error& e)
+        {
+            errors.add_error("Could not reopen file for tail check: " + file_name_param + " (" + e.what() + ")");
+        }
     }
 
+    return data;
+}
+
+/**
+ * @brief Turn raw scan values into a Result (corrections, unit conversion, status)
+ */
+static Result buildResult(std::string file_name, const LogScanData& data, const ProcessingContext& context)
+{
+    double scf = data.has_scf ? data.last_scf : 0.0;
+
     double lf = 0;
-    if (!negative_freqs.empty())
+    if (data.has_negative_freq)
     {
-        lf = negative_freqs.back();
+        lf = data.last_negative_freq;
     }
-    else if (!positive_freqs.empty())
+    else if (data.has_positive_freq)
     {
-        lf = *std::min_element(positive_freqs.begin(), positive_freqs.end());
+        lf = data.min_positive_freq;
     }
 
-    scf      = scfEqui ? scfEqui : (scftd ? scftd : scf);
-    etg      = etg ? etg : 0.0;
-    nucleare = nucleare ? nucleare : 0;
-    zpe      = zpe ? zpe : 0;
+    scf             = data.scf_equi ? data.scf_equi : (data.scftd ? data.scftd : scf);
+    double etg      = data.etg ? data.etg : 0.0;
+    double nucleare = data.nucleare ? data.nucleare : 0;
+    double zpe      = data.zpe ? data.zpe : 0;
+    double temp     = data.temp;
+
+    bool phaseCorr = data.has_scrf;
 
     double GphaseCorr       = R * temp * std::log(context.concentration * R * temp / Po) * 0.0003808798033989866 / 1000;
-    double GibbsFreeHartree = (phaseCorr == "YES" && etg != 0.0) ? etg + GphaseCorr : etg;
+    double GibbsFreeHartree = (phaseCorr && etg != 0.0) ? etg + GphaseCorr : etg;
     double etgkj            = GibbsFreeHartree * 2625.5002;
 
     // Set status based on termination counts and final job state
@@ -1132,79 +1155,1011 @@ Result extract(const std::string& file_name_param, const ProcessingContext& cont
     // 1. If any errors found, mark as ERROR
     // 2. If normal_count >= copyright_count AND "Normal termination" is in the last lines, mark as DONE
     // 3. Otherwise, mark as UNDONE (incomplete job)
-    if (error_count > 0)
+    ResultStatus status = ResultStatus::UNDONE;
+    if (data.error_count > 0)
     {
-        status = "ERROR";
+        status = ResultStatus::FAILED;
     }
-    else if (normal_count >= copyright_count && copyright_count > 0)
+    else if (data.normal_count >= data.copyright_count && data.copyright_count > 0)
     {
-        // Reopen the file to read the tail
-        std::ifstream tail_file(file_name_param);
-        if (!tail_file.is_open())
-        {
-            context.error_collector->add_error("Could not reopen file for tail check: " + file_name_param);
-            status = "UNDONE";  // Fallback on error
-        }
-        else
-        {
-            tail_file.seekg(0, std::ios::end);
-            std::streampos file_size = tail_file.tellg();
+        // Confirms the job actually completed, not just had intermediate completions
+        status = data.tail_normal_termination ? ResultStatus::DONE : ResultStatus::UNDONE;
+    }
 
-            // Read approximately last 2KB of file
-            std::streampos read_pos;
-            if (file_size > std::streampos(2048))
-            {
-                read_pos = file_size - std::streamoff(2048);
-            }
-            else
-            {
-                read_pos = std::streampos(0);
-            }
-            tail_file.seekg(read_pos);
+    // Truncate filename if too long
+    if (file_name.length() > 53)
+    {
+        file_name = file_name.substr(file_name.length() - 53);
+    }
 
-            std::string tail_content;
-            std::string tail_line;
-            while (std::getline(tail_file, tail_line))
-            {
-                tail_content += tail_line + "\n";
-            }
+    std::vector<std::string> field_values;
+    if (context.custom_fields)
+    {
+        field_values = context.custom_fields->values(data.field_values);
+    }
 
-            // Check if "Normal termination" appears in the final part of the file
-            // This confirms the job actually completed, not just had intermediate completions
-            if (tail_content.find("Normal termination") != std::string::npos)
-            {
-                status = "DONE";
-            }
-            else
-            {
-                status = "UNDONE";
-            }
+    return Result{file_name, etgkj, lf, GibbsFreeHartree, nucleare, scf, zpe, data.copyright_count, status, phaseCorr,
+                  std::move(field_values)};
+}
+
+/**
+ * @brief Report every Result field on which the fast scanner disagrees with the legacy engine
+ */
+static void crossCheckResults(const Result&             legacy,
+                              const Result&             fast,
+                              const std::string&        file_name,
+                              ThreadSafeErrorCollector& errors)
+{
+    std::ostringstream diff;
+    diff << std::setprecision(17);
 
-            tail_file.close();
+    auto check = [&diff](const char* field, double a, double b) {
+        if (a != b && !(std::isnan(a) && std::isnan(b)))
+        {
+            diff << " " << field << " legacy=" << a << " fast=" << b << ";";
         }
+    };
+    check("etgkj", legacy.etgkj, fast.etgkj);
+    check("lf", legacy.lf, fast.lf);
+    check("GibbsFreeHartree", legacy.GibbsFreeHartree, fast.GibbsFreeHartree);
+    check("nucleare", legacy.nucleare, fast.nucleare);
+    check("scf", legacy.scf, fast.scf);
+    check("zpe", legacy.zpe, fast.zpe);
+
+    if (legacy.status != fast.status)
+    {
+        diff << " status legacy=" << resultStatusName(legacy.status) << " fast=" << resultStatusName(fast.status)
+             << ";";
     }
-    else
+    if (legacy.phaseCorr != fast.phaseCorr)
     {
-        status = "UNDONE";
+        diff << " phaseCorr legacy=" << phaseCorrName(legacy.phaseCorr) << " fast=" << phaseCorrName(fast.phaseCorr)
+             << ";";
     }
-
-    // Truncate filename if too long
-    if (file_name.length() > 53)
+    if (legacy.copyright_count != fast.copyright_count)
     {
-        file_name = file_name.substr(file_name.length() - 53);
+        diff << " copyright_count legacy=" << legacy.copyright_count << " fast=" << fast.copyright_count << ";";
     }
 
-    return Result{file_name, etgkj, lf, GibbsFreeHartree, nucleare, scf, zpe, status, phaseCorr, copyright_count};
+    if (!diff.str().empty())
+    {
+        errors.add_warning("Scanner cross-check mismatch in '" + file_name + "':" + diff.str());
+    }
 }
 
-// Legacy function - now wraps the new job-aware implementation
-unsigned int getSafeThreadCount(unsigned int requested_threads, unsigned int file_count)
+/**
+ * @brief Result index section holding raw extract() scan values
+ */
+static const std::string EXTRACT_INDEX_SECTION = "extract";
+
+/**
+ * @brief Serialise raw scan values for the result index
+ *
+ * The entry records which engine produced it and the temperature options in
+ * effect, because the temperature is the only raw value that depends on them.
+ */
+static std::vector<std::string> encodeScanData(const LogScanData& data, const ProcessingContext& context)
 {
-    JobResources job_resources = JobSchedulerDetector::detect_job_resources();
-    return calculateSafeThreadCount(requested_threads, file_count, job_resources);
+    auto d = [](double value) { return ResultIndex::format_double(value); };
+    auto b = [](bool value) { return std::string(value ? "1" : "0"); };
+
+    std::vector<std::string> fields = {context.scan_mode == ScanMode::TAIL ? "tail" : "full",
+                                       b(context.use_input_temp),
+                                       d(context.base_temp),
+                                       std::to_string(data.copyright_count),
+                                       std::to_string(data.normal_count),
+                                       std::to_string(data.error_count),
+                                       b(data.has_scf),
+                                       d(data.last_scf),
+                                       d(data.scftd),
+                                       d(data.scf_equi),
+                                       d(data.zpe),
+                                       d(data.tcg),
+                                       d(data.etg),
+                                       d(data.ezpe),
+                                       d(data.nucleare),
+                                       d(data.temp),
+                                       b(data.has_negative_freq),
+                                       d(data.last_negative_freq),
+                                       b(data.has_positive_freq),
+                                       d(data.min_positive_freq),
+                                       b(data.has_scrf),
+                                       b(data.tail_normal_termination)};
+
+    // User-defined field values follow, behind the signature of the specs that produced them
+    if (context.custom_fields)
+    {
+        fields.push_back(context.custom_fields->signature());
+        std::vector<std::string> values = context.custom_fields->values(data.field_values);
+        fields.insert(fields.end(), values.begin(), values.end());
+    }
+    return fields;
 }
 
-void processAndOutputResults(double                          temp,
+/**
+ * @brief Restore raw scan values from a result index entry
+ * @return false if the entry is malformed or cannot serve the current options
+ */
+static bool decodeScanData(const std::vector<std::string>& fields, const ProcessingContext& context, LogScanData& data)
+{
+    // Entries carry user-defined field values exactly when fields are configured, and only for the same specs
+    const CustomFieldSet* custom = context.custom_fields.get();
+    if (custom ? fields.size() != 23 + custom->size() || fields[22] != custom->signature() : fields.size() != 22)
+    {
+        return false;
+    }
+
+    // Tail scans skip the middle of a file, so they only stand in for other tail scans
+    if (fields[0] != "full" && !(fields[0] == "tail" && context.scan_mode == ScanMode::TAIL))
+    {
+        return false;
+    }
+
+    bool   ok          = true;
+    size_t next        = 1;
+    auto   read_double = [&](double& value) { ok = ok && ResultIndex::parse_double(fields[next++], value); };
+    auto   read_bool   = [&](bool& value) {
+        const std::string& field = fields[next++];
+        ok                       = ok && (field == "0" || field == "1");
+        value                    = field == "1";
+    };
+    auto read_int = [&](int& value) {
+        double number = 0.0;
+        read_double(number);
+        value = static_cast<int>(number);
+    };
+
+    bool   indexed_use_input_temp = false;
+    double indexed_base_temp      = 0.0;
+    read_bool(indexed_use_input_temp);
+    read_double(indexed_base_temp);
+    read_int(data.copyright_count);
+    read_int(data.normal_count);
+    read_int(data.error_count);
+    read_bool(data.has_scf);
+    read_double(data.last_scf);
+    read_double(data.scftd);
+    read_double(data.scf_equi);
+    read_double(data.zpe);
+    read_double(data.tcg);
+    read_double(data.etg);
+    read_double(data.ezpe);
+    read_double(data.nucleare);
+    read_double(data.temp);
+    read_bool(data.has_negative_freq);
+    read_double(data.last_negative_freq);
+    read_bool(data.has_positive_freq);
+    read_double(data.min_positive_freq);
+    read_bool(data.has_scrf);
+    read_bool(data.tail_normal_termination);
+    if (!ok)
+    {
+        return false;
+    }
+    if (custom)
+    {
+        data.field_values.assign(fields.begin() + 23, fields.end());
+    }
+
+    if (context.use_input_temp)
+    {
+        data.temp = context.base_temp;  // The file temperature is not used at all
+        return true;
+    }
+
+    // The file temperature is needed: it must have been read, and an entry that
+    // fell back to a different default temperature cannot tell them apart
+    if (indexed_use_input_temp)
+    {
+        return false;
+    }
+    return data.temp != indexed_base_temp || indexed_base_temp == context.base_temp;
+}
+
+/**
+ * @brief Settings the Results in an extract journal depend on (extract --resume)
+ *
+ * Unlike the result index, the journal holds finished Results, so the
+ * temperature and concentration are part of the signature as well.
+ */
+static std::string journalSignature(const ProcessingContext& context)
+{
+    std::string signature = "extract\t" + ResultIndex::format_double(context.base_temp) + '\t' +
+                            std::to_string(context.concentration) + '\t' + (context.use_input_temp ? "1" : "0") +
+                            '\t' + std::to_string(static_cast<int>(context.scan_mode)) + '\t' +
+                            (context.done_only ? "1" : "0");
+    if (context.custom_fields)
+    {
+        signature += '\t' + context.custom_fields->signature();
+    }
+    return signature;
+}
+
+/**
+ * @brief Journal payload of one extracted log: its stamp when it was parsed and its Result
+ */
+static std::string encodeJournalResult(const std::string& path, const FileStamp& stamp, const Result& result)
+{
+    std::string payload;
+    RunJournal::put(payload, static_cast<uint64_t>(stamp.size));
+    RunJournal::put(payload, static_cast<int64_t>(stamp.mtime_ns));
+    RunJournal::put(payload, stamp.inode);
+    RunJournal::put(payload, result.etgkj);
+    RunJournal::put(payload, result.lf);
+    RunJournal::put(payload, result.GibbsFreeHartree);
+    RunJournal::put(payload, result.nucleare);
+    RunJournal::put(payload, result.scf);
+    RunJournal::put(payload, result.zpe);
+    RunJournal::put(payload, static_cast<int32_t>(result.copyright_count));
+    RunJournal::put(payload, static_cast<uint8_t>(result.status));
+    RunJournal::put(payload, static_cast<uint8_t>(result.phaseCorr ? 1 : 0));
+    RunJournal::put_string(payload, path);
+    RunJournal::put_string(payload, result.file_name);
+    RunJournal::put(payload, static_cast<uint32_t>(result.field_values.size()));
+    for (const auto& value : result.field_values)
+    {
+        RunJournal::put_string(payload, value);
+    }
+    return payload;
+}
+
+/**
+ * @brief Restore a log's path, stamp and Result from an extract journal entry
+ * @return false if the entry is malformed
+ */
+static bool decodeJournalResult(std::string_view payload, std::string& path, FileStamp& stamp, Result& result)
+{
+    uint64_t size        = 0;
+    int64_t  mtime_ns    = 0;
+    int32_t  copyrights  = 0;
+    uint8_t  status      = 0;
+    uint8_t  phase       = 0;
+    uint32_t field_count = 0;
+    bool     ok = RunJournal::get(payload, size) && RunJournal::get(payload, mtime_ns) &&
+              RunJournal::get(payload, stamp.inode) && RunJournal::get(payload, result.etgkj) &&
+              RunJournal::get(payload, result.lf) && RunJournal::get(payload, result.GibbsFreeHartree) &&
+              RunJournal::get(payload, result.nucleare) && RunJournal::get(payload, result.scf) &&
+              RunJournal::get(payload, result.zpe) && RunJournal::get(payload, copyrights) &&
+              RunJournal::get(payload, status) && RunJournal::get(payload, phase) &&
+              RunJournal::get_string(payload, path) && RunJournal::get_string(payload, result.file_name) &&
+              RunJournal::get(payload, field_count);
+    result.field_values.resize(ok ? field_count : 0);
+    for (auto& value : result.field_values)
+    {
+        ok = ok && RunJournal::get_string(payload, value);
+    }
+    if (!ok || status > static_cast<uint8_t>(ResultStatus::FAILED))
+    {
+        return false;
+    }
+    stamp.size             = static_cast<uintmax_t>(size);
+    stamp.mtime_ns         = static_cast<long long>(mtime_ns);
+    result.copyright_count = copyrights;
+    result.status          = static_cast<ResultStatus>(status);
+    result.phaseCorr       = phase != 0;
+    return true;
+}
+
+/**
+ * @brief Write the final geometry located by the scan (extract --with-xyz)
+ *
+ * Jobs whose log ends in "Normal termination" go to the final_coord
+ * directory, all others to running_coord, as with the xyz command. A missing
+ * or damaged geometry is a warning; the Result row is kept.
+ */
+static void writeFinalGeometry(const std::string&       file_name_param,
+                               const std::string&       file_name,
+                               const LogScanData&       data,
+                               const ProcessingContext& context,
+                               const std::string_view*  content = nullptr)
+{
+    std::string error_msg = "No orientation section found";
+    bool        written   = false;
+    if (data.has_orientation)
+    {
+        written = content ? context.geometry_writer->write(file_name_param, *content, data.orientation_offset,
+                                                           data.tail_normal_termination, error_msg)
+                          : context.geometry_writer->write(file_name_param, data.orientation_offset,
+                                                           data.tail_normal_termination, error_msg);
+    }
+    if (!written)
+    {
+        context.error_collector->add_warning("Could not write geometry of '" + file_name + "': " + error_msg);
+    }
+}
+
+/**
+ * @brief extract() for runs with a ScanObserver: the log is read once, whole, for the scan and the observer
+ */
+static Result extractObserved(const std::string&       file_name_param,
+                              const std::string&       file_name,
+                              const ProcessingContext& context)
+{
+    std::unique_ptr<MappedFile> mapped;
+    std::string                 buffer;
+    std::string_view            content;
+    if (!CompressedInput::is_compressed(file_name_param))
+    {
+        mapped = std::make_unique<MappedFile>(file_name_param);
+    }
+    if (mapped && mapped->is_mapped())
+    {
+        content = mapped->view();
+    }
+    else
+    {
+        Profiler::Scope read(Profiler::Phase::READ);
+        buffer  = CompressedInput::read_all(file_name_param);
+        content = buffer;
+    }
+    Profiler::add(Profiler::Counter::BYTES_READ, content.size());
+
+    LogScanData data = LogScanner::scan_content(content, file_name, context, *context.error_collector);
+    if (context.geometry_writer)
+    {
+        writeFinalGeometry(file_name_param, file_name, data, context, &content);
+    }
+    context.scan_observer(file_name_param, content, data);
+    return buildResult(file_name, data, context);
+}
+
+Result extract(const std::string& file_name_param, const ProcessingContext& context)
+{
+    // Check for shutdown signal
+    if (g_shutdown_requested.load())
+    {
+        throw std::runtime_error("Processing interrupted by shutdown signal");
+    }
+
+    // Unchanged files are served from the result index without being opened. The geometry and the observer need
+    // the scan, so runs with either neither read nor update the index (store() ignores the empty stamp).
+    ResultIndex* index = context.result_index.get();
+    FileStamp    stamp;
+    if (index && !context.geometry_writer && !context.scan_observer)
+    {
+        std::vector<std::string> fields;
+        LogScanData              cached;
+        if (index->lookup(EXTRACT_INDEX_SECTION, file_name_param, stamp, fields) &&
+            decodeScanData(fields, context, cached))
+        {
+            std::string file_name = file_name_param;
+            if (file_name.substr(0, 2) == "./")
+            {
+                file_name = file_name.substr(2);
+            }
+            return buildResult(file_name, cached, context);
+        }
+    }
+
+    std::string file_name = file_name_param;
+    if (file_name.substr(0, 2) == "./")
+    {
+        file_name = file_name.substr(2);
+    }
+
+    // Logs that did not end normally cannot pass a filter on finished jobs; their status is all the row needs
+    auto rejected_at_tail = [&file_name, &context]() {
+        Profiler::add(Profiler::Counter::TAIL_REJECTS);
+        LogScanData data;
+        data.temp = context.base_temp;
+        return buildResult(file_name, data, context);
+    };
+
+    // A log read ahead is already in memory and charged to the monitor: no reservation, no file handle
+    Readahead::Buffer ahead;
+    if (context.readahead && context.readahead->take(file_name_param, ahead))
+    {
+        std::string_view content = ahead.view();
+        if (context.done_only && !LogScanner::tail_has_normal_termination(content))
+        {
+            return rejected_at_tail();
+        }
+        LogScanData      data    = LogScanner::scan_content(content, file_name, context, *context.error_collector);
+        if (context.geometry_writer)
+        {
+            writeFinalGeometry(file_name_param, file_name, data, context, &content);
+        }
+        if (context.scan_observer)
+        {
+            context.scan_observer(file_name_param, content, data);
+        }
+        return buildResult(file_name, data, context);
+    }
+
+    if (context.done_only && !LogScanner::tail_has_normal_termination(file_name_param))
+    {
+        return rejected_at_tail();
+    }
+
+    // The scanner maps the whole log (or buffers it around the final job step), so its pages are the bytes in
+    // flight. Waiting for them delays the file under memory pressure instead of dropping it from the output.
+    size_t          in_flight_bytes = 102400;  // 100KB when the size cannot be read
+    std::error_code size_error;
+    auto            file_size = std::filesystem::file_size(file_name_param, size_error);
+    if (!size_error)
+    {
+        in_flight_bytes = static_cast<size_t>(file_size);
+    }
+
+    MemoryMonitor::Reservation memory = context.memory_monitor->reserve(in_flight_bytes);
+    if (!memory.is_acquired())
+    {
+        throw std::runtime_error("Processing interrupted by shutdown signal");
+    }
+
+    // Acquire file handle
+    auto file_guard = context.file_manager->acquire();
+    if (!file_guard.is_acquired())
+    {
+        throw std::runtime_error("Could not acquire file handle for: " + file_name_param);
+    }
+
+    if (context.scan_observer)
+    {
+        return extractObserved(file_name_param, file_name, context);
+    }
+
+    LogScanData data;
+    switch (context.scan_mode)
+    {
+        case ScanMode::LEGACY:
+            data = scanLogLegacy(file_name_param, file_name, context, *context.error_collector);
+            break;
+
+        case ScanMode::TAIL:
+            data = LogScanner::scan_file_tail(file_name_param, file_name, context, *context.error_collector);
+            break;
+
+        case ScanMode::VERIFY:
+        {
+            data          = scanLogLegacy(file_name_param, file_name, context, *context.error_collector);
+            Result legacy = buildResult(file_name, data, context);
+
+            // Parse warnings were already reported by the legacy pass
+            ThreadSafeErrorCollector scratch;
+            LogScanData              fast_data = LogScanner::scan_file(file_name_param, file_name, context, scratch);
+            Result                   fast      = buildResult(file_name, fast_data, context);
+
+            // The legacy engine does not read user-defined fields; they come from the fast pass
+            crossCheckResults(legacy, fast, file_name, *context.error_collector);
+            data.field_values = std::move(fast_data.field_values);
+            break;
+        }
+
+        case ScanMode::FAST:
+        default:
+            data = LogScanner::scan_file(file_name_param, file_name, context, *context.error_collector);
+            break;
+    }
+
+    if (index)
+    {
+        index->store(EXTRACT_INDEX_SECTION, file_name_param, stamp, encodeScanData(data, context));
+    }
+
+    if (context.geometry_writer)
+    {
+        writeFinalGeometry(file_name_param, file_name, data, context);
+    }
+    return buildResult(file_name, data, context);
+}
+
+/**
+ * @struct SplitLog
+ * @brief A large log whose parts are scanned as separate executor tasks (see LogScanner::scan_part())
+ *
+ * The first part to start consults the result index and the tail check and
+ * maps the log; every part then scans its own range, and the part that
+ * finishes last merges the partial states in file order (finishSplitLog()).
+ */
+struct SplitLog
+{
+    std::string                 path;              ///< Path as discovered
+    std::string                 file_name;         ///< Display name
+    std::once_flag              opened;            ///< Guards openSplitLog()
+    bool                        settled = false;   ///< Values known without a scan (index hit or tail reject)
+    LogScanData                 settled_data;      ///< Values of a settled log
+    FileStamp                   stamp;             ///< Stamp for the result index
+    MemoryMonitor::Reservation  memory;            ///< Bytes of the mapping
+    std::unique_ptr<MappedFile> mapped;            ///< Whole log (view() is empty when not mapped)
+    std::vector<LogScanData>    parts;             ///< Partial state of each part
+    std::atomic<size_t>         remaining{0};      ///< Parts not finished yet
+    std::atomic<bool>           failed{false};     ///< A part could not be scanned
+    std::mutex                  error_mutex;       ///< Guards error
+    std::string                 error;             ///< First failure
+
+    /**
+     * @brief Record a failed part; only the first message is kept
+     */
+    void fail(const std::string& message)
+    {
+        std::lock_guard<std::mutex> lock(error_mutex);
+        if (!failed.exchange(true))
+        {
+            error = message;
+        }
+    }
+};
+
+/**
+ * @brief Work done once per split log, by whichever part starts first
+ */
+static void openSplitLog(SplitLog& log, const ProcessingContext& context)
+{
+    ResultIndex* index = context.result_index.get();
+    if (index && !context.geometry_writer && !context.scan_observer)
+    {
+        std::vector<std::string> fields;
+        if (index->lookup(EXTRACT_INDEX_SECTION, log.path, log.stamp, fields) &&
+            decodeScanData(fields, context, log.settled_data))
+        {
+            log.settled = true;
+            return;
+        }
+    }
+
+    if (context.done_only && !LogScanner::tail_has_normal_termination(log.path))
+    {
+        Profiler::add(Profiler::Counter::TAIL_REJECTS);
+        log.settled_data.temp = context.base_temp;
+        log.settled           = true;
+        return;
+    }
+
+    std::error_code size_error;
+    auto            file_size = std::filesystem::file_size(log.path, size_error);
+    log.memory                = context.memory_monitor->reserve(size_error ? 0 : static_cast<size_t>(file_size));
+    if (!log.memory.is_acquired())
+    {
+        throw std::runtime_error("Processing interrupted by shutdown signal");
+    }
+
+    // The mapping stays valid after the descriptor is closed, so the handle is held only while opening
+    auto file_guard = context.file_manager->acquire();
+    if (!file_guard.is_acquired())
+    {
+        throw std::runtime_error("Could not acquire file handle for: " + log.path);
+    }
+    log.mapped = std::make_unique<MappedFile>(log.path);
+    if (log.mapped->is_mapped())
+    {
+        Profiler::add(Profiler::Counter::BYTES_READ, log.mapped->size());
+    }
+}
+
+/**
+ * @brief Scan one part of a split log
+ */
+static void scanSplitPart(SplitLog& log, size_t part, const ProcessingContext& context)
+{
+    if (g_shutdown_requested.load())
+    {
+        throw std::runtime_error("Processing interrupted by shutdown signal");
+    }
+    std::call_once(log.opened, openSplitLog, std::ref(log), std::cref(context));
+    if (log.settled || log.failed.load())
+    {
+        return;
+    }
+
+    // Logs that could not be mapped are read part by part, each part with its own handle
+    if (!log.mapped->is_mapped())
+    {
+        auto file_guard = context.file_manager->acquire();
+        if (!file_guard.is_acquired())
+        {
+            throw std::runtime_error("Could not acquire file handle for: " + log.path);
+        }
+        log.parts[part] = LogScanner::scan_part(log.path, std::string_view(), log.mapped->size(), part,
+                                                log.parts.size(), log.file_name, context, *context.error_collector);
+        return;
+    }
+    log.parts[part] = LogScanner::scan_part(log.path, log.mapped->view(), log.mapped->size(), part,
+                                            log.parts.size(), log.file_name, context, *context.error_collector);
+}
+
+/**
+ * @brief Merge the parts of a split log into its Result, once all parts are done
+ */
+static Result finishSplitLog(SplitLog& log, const ProcessingContext& context)
+{
+    if (log.settled)
+    {
+        return buildResult(log.file_name, log.settled_data, context);
+    }
+
+    LogScanData      data    = LogScanner::merge_parts(log.parts, context);
+    std::string_view content = log.mapped->view();
+    data.tail_normal_termination = content.empty() ? LogScanner::tail_has_normal_termination(log.path)
+                                                   : LogScanner::tail_has_normal_termination(content);
+    if (context.result_index)
+    {
+        context.result_index->store(EXTRACT_INDEX_SECTION, log.path, log.stamp, encodeScanData(data, context));
+    }
+    if (context.geometry_writer)
+    {
+        writeFinalGeometry(log.path, log.file_name, data, context, content.empty() ? nullptr : &content);
+    }
+
+    log.mapped.reset();
+    log.memory.release();
+    return buildResult(log.file_name, data, context);
+}
+
+/**
+ * @brief Text table width of a user-defined field column (values are right-aligned after two spaces)
+ */
+static int fieldColumnWidth(const ColumnarWriter::Column& field)
+{
+    return static_cast<int>(std::max<size_t>(12, field.name.size()));
+}
+
+/**
+ * @brief Column header lines of the results table ("text" or "csv")
+ * @param fields Columns of the user-defined fields, appended after "Round"
+ */
+static std::string formatTableHeader(const std::string& format, const std::vector<ColumnarWriter::Column>& fields)
+{
+    std::ostringstream header;
+    if (format == "csv")
+    {
+        header << "Output name,ETG kJ/mol,Low FC,ETG a.u,Nuclear E au,SCFE,ZPE,Status,PCorr,Round";
+        for (const auto& field : fields)
+        {
+            header << "," << field.name;
+        }
+        header << "\n";
+        return header.str();
+    }
+
+    header << std::setw(53) << std::left << "Output name" << std::setw(18) << std::right << "ETG kJ/mol"
+           << std::setw(10) << std::right << "Low FC" << std::setw(18) << std::right << "ETG a.u" << std::setw(18)
+           << std::right << "Nuclear E au" << std::setw(18) << std::right << "SCFE" << std::setw(10) << std::right
+           << "ZPE " << std::setw(8) << std::right << "Status" << std::setw(6) << std::right << "PCorr"
+           << std::setw(6) << std::right << "Round";
+    for (const auto& field : fields)
+    {
+        header << "  " << std::setw(fieldColumnWidth(field)) << std::right << field.name;
+    }
+    header << "\n";
+
+    header << std::setw(53) << std::left << std::string(53, '-') << std::setw(18) << std::right
+           << std::string(18, '-') << std::setw(10) << std::right << std::string(10, '-') << std::setw(18)
+           << std::right << std::string(18, '-') << std::setw(18) << std::right << std::string(18, '-')
+           << std::setw(18) << std::right << std::string(18, '-') << std::setw(10) << std::right
+           << std::string(10, '-') << std::setw(8) << std::right << std::string(8, '-') << std::setw(6) << std::right
+           << std::string(6, '-') << std::setw(6) << std::right << std::string(6, '-');
+    for (const auto& field : fields)
+    {
+        header << "  " << std::string(static_cast<size_t>(fieldColumnWidth(field)), '-');
+    }
+    header << "\n";
+    return header.str();
+}
+
+/**
+ * @brief Append one row of the results table ("text" or "csv") to a stream
+ * @param fields Columns of the user-defined fields, as given to formatTableHeader()
+ *
+ * A field without a value is "-" in the text table and empty in CSV; string
+ * fields are quoted in CSV.
+ */
+static void writeResultRow(std::ostream&                              out,
+                           const Result&                              result,
+                           const std::string&                         format,
+                           const std::vector<ColumnarWriter::Column>& fields)
+{
+    auto field_value = [&result](size_t i) -> const std::string& {
+        static const std::string missing;
+        return i < result.field_values.size() ? result.field_values[i] : missing;
+    };
+
+    if (format == "csv")
+    {
+        out << "\"" << result.file_name << "\"," << std::fixed << std::setprecision(6) << result.etgkj << ","
+            << std::fixed << std::setprecision(2) << result.lf << "," << std::fixed << std::setprecision(6)
+            << result.GibbsFreeHartree << "," << std::fixed << std::setprecision(6) << result.nucleare << ","
+            << std::fixed << std::setprecision(6) << result.scf << "," << std::fixed << std::setprecision(6)
+            << result.zpe << "," << resultStatusName(result.status) << "," << phaseCorrName(result.phaseCorr) << ","
+            << result.copyright_count;
+        for (size_t i = 0; i < fields.size(); ++i)
+        {
+            const std::string& value = field_value(i);
+            if (fields[i].type == ColumnarWriter::Type::STRING && !value.empty())
+            {
+                out << ",\"" << value << "\"";
+            }
+            else
+            {
+                out << "," << value;
+            }
+        }
+        out << "\n";
+        return;
+    }
+
+    out << std::setw(53) << std::left << result.file_name << std::setw(18) << std::right << std::fixed
+        << std::setprecision(6) << result.etgkj << std::setw(10) << std::right << std::fixed << std::setprecision(2)
+        << result.lf << std::setw(18) << std::right << std::fixed << std::setprecision(6) << result.GibbsFreeHartree
+        << std::setw(18) << std::right << std::fixed << std::setprecision(6) << result.nucleare << std::setw(18)
+        << std::right << std::fixed << std::setprecision(6) << result.scf << std::setw(10) << std::right << std::fixed
+        << std::setprecision(6) << result.zpe << std::setw(8) << std::right << resultStatusName(result.status)
+        << std::setw(6) << std::right << phaseCorrName(result.phaseCorr) << std::setw(6) << std::right
+        << result.copyright_count;
+    for (size_t i = 0; i < fields.size(); ++i)
+    {
+        const std::string& value = field_value(i);
+        out << "  " << std::setw(fieldColumnWidth(fields[i])) << std::right << (value.empty() ? "-" : value);
+    }
+    out << "\n";
+}
+
+/**
+ * @brief Columns of the "bin" results table, in the order of the text table
+ * @param fields Columns of the user-defined fields, appended after "round"
+ */
+static std::vector<ColumnarWriter::Column> resultColumns(const std::vector<ColumnarWriter::Column>& fields = {})
+{
+    using Type                                  = ColumnarWriter::Type;
+    std::vector<ColumnarWriter::Column> columns = {{"file_name", Type::STRING},
+                                                   {"etg_kj_mol", Type::FLOAT64},
+                                                   {"lowest_frequency", Type::FLOAT64},
+                                                   {"etg_hartree", Type::FLOAT64},
+                                                   {"nuclear_energy", Type::FLOAT64},
+                                                   {"scf_energy", Type::FLOAT64},
+                                                   {"zpe", Type::FLOAT64},
+                                                   {"status", Type::STRING},
+                                                   {"phase_correction", Type::BOOL},
+            {"round", Type::INT32}};
+    columns.insert(columns.end(), fields.begin(), fields.end());
+    return columns;
+}
+
+/**
+ * @brief Number of built-in columns of the results table; user-defined fields follow them
+ */
+static const size_t RESULT_COLUMN_COUNT = 10;
+
+/**
+ * @brief INT32 value of an int field that was not found ("bin" has no null)
+ */
+static const int MISSING_INT_FIELD = std::numeric_limits<int>::min();
+
+/**
+ * @brief Append one row of the "bin" results table (a ColumnarWriter or a ColumnarBatch)
+ * @param fields Columns of the user-defined fields, as given to resultColumns()
+ *
+ * A double field without a value is NaN, an int field MISSING_INT_FIELD and a
+ * string field "".
+ */
+template <typename Sink>
+static void writeResultColumns(Sink& out, const Result& result, const std::vector<ColumnarWriter::Column>& fields)
+{
+    out.add_string(result.file_name);
+    out.add_double(result.etgkj);
+    out.add_double(result.lf);
+    out.add_double(result.GibbsFreeHartree);
+    out.add_double(result.nucleare);
+    out.add_double(result.scf);
+    out.add_double(result.zpe);
+    out.add_string(resultStatusName(result.status));
+    out.add_bool(result.phaseCorr);
+    out.add_int(result.copyright_count);
+    for (size_t i = 0; i < fields.size(); ++i)
+    {
+        std::string value = i < result.field_values.size() ? result.field_values[i] : std::string();
+        switch (fields[i].type)
+        {
+            case ColumnarWriter::Type::FLOAT64:
+            {
+                double number = std::numeric_limits<double>::quiet_NaN();
+                if (!value.empty())
+                {
+                    LogScanner::parse_leading_double(value, number);
+                }
+                out.add_double(number);
+                break;
+            }
+            case ColumnarWriter::Type::INT32:
+            {
+                int number = MISSING_INT_FIELD;
+                if (value.empty() || !safe_stoi(value, number))
+                {
+                    number = MISSING_INT_FIELD;  // Also for counts beyond the INT32 range
+                }
+                out.add_int(number);
+                break;
+            }
+            case ColumnarWriter::Type::BOOL:
+                out.add_bool(value == "1");
+                break;
+            case ColumnarWriter::Type::STRING:
+            default:
+                out.add_string(value);
+                break;
+        }
+    }
+    out.end_row();
+}
+
+std::vector<ColumnarWriter::Column> resultTableColumns(const std::vector<ColumnarWriter::Column>& fields)
+{
+    return resultColumns(fields);
+}
+
+void appendResultRow(ColumnarBatch& batch, const Result& result, const std::vector<ColumnarWriter::Column>& fields)
+{
+    writeResultColumns(batch, result, fields);
+}
+
+/**
+ * @brief Visit the results of several sorted runs in merged order
+ * @param runs Per-thread result runs, each already sorted by column
+ * @param column Sort column (see compareResults)
+ * @param visit Called once per result, in output order
+ * @param limit Stop after this many results (0 = all)
+ *
+ * Ties, including every pair for unsortable columns, are taken from the
+ * lower-numbered run first, so unsorted output is the runs concatenated.
+ */
+template <typename Visitor>
+static void
+mergeSortedRuns(const std::vector<std::vector<Result>>& runs, int column, Visitor&& visit, size_t limit = 0)
+{
+    using Cursor = std::pair<size_t, size_t>;  // (run, position)
+
+    auto comes_later = [&runs, column](const Cursor& a, const Cursor& b) {
+        const Result& ra = runs[a.first][a.second];
+        const Result& rb = runs[b.first][b.second];
+        if (compareResults(rb, ra, column))
+        {
+            return true;
+        }
+        if (compareResults(ra, rb, column))
+        {
+            return false;
+        }
+        return a.first > b.first;
+    };
+
+    std::priority_queue<Cursor, std::vector<Cursor>, decltype(comes_later)> heap(comes_later);
+    for (size_t run = 0; run < runs.size(); ++run)
+    {
+        if (!runs[run].empty())
+        {
+            heap.push({run, 0});
+        }
+    }
+
+    for (size_t visited = 0; !heap.empty() && (limit == 0 || visited < limit); ++visited)
+    {
+        Cursor cursor = heap.top();
+        heap.pop();
+        visit(runs[cursor.first][cursor.second]);
+        if (++cursor.second < runs[cursor.first].size())
+        {
+            heap.push(cursor);
+        }
+    }
+}
+
+bool ShardSpec::contains(const std::string& path) const
+{
+    if (count == 0)
+    {
+        return true;
+    }
+
+    uint64_t hash = 14695981039346656037ULL;
+    for (unsigned char c : path)
+    {
+        hash ^= c;
+        hash *= 1099511628211ULL;
+    }
+    return hash % count == index;
+}
+
+std::string ShardSpec::suffix() const
+{
+    return ".shard-" + std::to_string(index) + "-of-" + std::to_string(count);
+}
+
+/**
+ * @brief Shard numbers encoded in a partial results file name ("*.shard-<i>-of-<N>.bin")
+ */
+static bool parseShardFilename(const std::string& filename, ShardSpec& shard)
+{
+    static const std::regex pattern(R"(\.shard-(\d+)-of-(\d+)\.bin$)");
+    std::smatch             match;
+    unsigned long           index = 0;
+    unsigned long           count = 0;
+    if (!std::regex_search(filename, match, pattern) || !safe_stoul(match[1].str(), index) ||
+        !safe_stoul(match[2].str(), count) || count == 0 || index >= count)
+    {
+        return false;
+    }
+    shard.index = static_cast<unsigned int>(index);
+    shard.count = static_cast<unsigned int>(count);
+    return true;
+}
+
+/**
+ * @brief Load the rows of a partial results file written by a sharded extract
+ * @param path Partial results file
+ * @param fields Receives the columns of the user-defined fields that follow the built-in ones
+ * @throws std::runtime_error if the file is unreadable or was not written by extract
+ */
+static std::vector<Result> readPartialResults(const std::string& path, std::vector<ColumnarWriter::Column>& fields)
+{
+    ColumnarReader reader(path);
+
+    auto expected = resultColumns();
+    bool matches  = reader.columns().size() >= expected.size();
+    for (size_t c = 0; matches && c < expected.size(); ++c)
+    {
+        matches = reader.columns()[c].name == expected[c].name && reader.columns()[c].type == expected[c].type;
+    }
+    if (!matches)
+    {
+        throw std::runtime_error("Not an extract results file: " + path);
+    }
+    fields.assign(reader.columns().begin() + static_cast<std::ptrdiff_t>(RESULT_COLUMN_COUNT), reader.columns().end());
+
+    std::vector<Result> results(reader.row_count());
+    for (uint64_t row = 0; row < reader.row_count(); ++row)
+    {
+        Result& result          = results[row];
+        result.file_name        = std::string(reader.get_string(0, row));
+        result.etgkj            = reader.get_double(1, row);
+        result.lf               = reader.get_double(2, row);
+        result.GibbsFreeHartree = reader.get_double(3, row);
+        result.nucleare         = reader.get_double(4, row);
+        result.scf              = reader.get_double(5, row);
+        result.zpe              = reader.get_double(6, row);
+        result.status           = parseResultStatus(reader.get_string(7, row));
+        result.phaseCorr        = reader.get_bool(8, row);
+        result.copyright_count  = reader.get_int(9, row);
+
+        // Field values are read back into the text they were written from
+        for (size_t c = RESULT_COLUMN_COUNT; c < fields.size() + RESULT_COLUMN_COUNT; ++c)
+        {
+            std::string value;
+            switch (fields[c - RESULT_COLUMN_COUNT].type)
+            {
+                case ColumnarWriter::Type::FLOAT64:
+                {
+                    double number = reader.get_double(c, row);
+                    value         = std::isnan(number) ? std::string() : CustomFieldSet::format_double(number);
+                    break;
+                }
+                case ColumnarWriter::Type::INT32:
+                {
+                    int number = reader.get_int(c, row);
+                    value      = number == MISSING_INT_FIELD ? std::string() : std::to_string(number);
+                    break;
+                }
+                case ColumnarWriter::Type::BOOL:
+                    value = reader.get_bool(c, row) ? "1" : "0";
+                    break;
+                case ColumnarWriter::Type::STRING:
+                default:
+                    value = std::string(reader.get_string(c, row));
+                    break;
+            }
+            result.field_values.push_back(std::move(value));
+        }
+    }
+    return results;
+}
+
+// Legacy function - now wraps the new job-aware implementation
+unsigned int getSafeThreadCount(unsigned int requested_threads, unsigned int file_count)
+{
+    JobResources job_resources = JobSchedulerDetector::detect_job_resources();
+    return calculateSafeThreadCount(requested_threads, file_count, job_resources);
+}
+
+void processAndOutputResults(double                          temp,
                              int                             C,
                              int                             column,
                              const std::string&              extension,
@@ -1216,237 +2171,619 @@ void processAndOutputResults(double                          temp,
                              size_t                          memory_limit_mb,
                              const std::vector<std::string>& warnings,
                              const JobResources&             job_resources,
-                             size_t                          batch_size)
+                             size_t                          batch_size,
+                             ScanMode                        scan_mode,
+                             bool                            use_result_index,
+                             bool                            stream_output,
+                             bool                            recursive,
+                             bool                            with_xyz,
+                             const ShardSpec&                shard,
+                             const ScanObserver&             observer,
+                             int                             io_depth,
+                             const ResultSelection&          selection,
+                             bool                            resume)
 {
 
     auto start_time = std::chrono::high_resolution_clock::now();
 
     try
     {
-        // Detect job scheduler resources if not provided
-        JobResources final_job_resources = job_resources;
+        // Detect job scheduler resources if not provided; an interactive session detects them once
+        SessionState* session             = shard.enabled() ? nullptr : SessionState::active();
+        JobResources  final_job_resources = job_resources;
         if (final_job_resources.scheduler_type == SchedulerType::NONE)
         {
-            final_job_resources = JobSchedulerDetector::detect_job_resources();
+            final_job_resources =
+                session ? session->job_resources() : JobSchedulerDetector::detect_job_resources();
         }
 
         // Print job information
         printJobResourceInfo(final_job_resources, quiet);
 
-        // Find and validate log files using batch processing if specified
-        std::vector<std::string> log_files;
-
         // If using default extension (.log), search for both .log and .out files (case-insensitive)
         bool is_log_extension = (extension.length() == 4 && std::tolower(extension[1]) == 'l' &&
                                  std::tolower(extension[2]) == 'o' && std::tolower(extension[3]) == 'g');
-        if (is_log_extension)
+
+        // One directory walk for all extensions; it needs no batching, so batch_size is not used here
+        (void)batch_size;
+        FileDiscovery::Options discovery;
+        discovery.extensions       = is_log_extension ? std::vector<std::string>{".log", ".out"}
+                                                      : std::vector<std::string>{extension};
+        discovery.max_file_size_mb = max_file_size_mb;
+        discovery.recursive        = recursive;
+
+        // Files are parsed while the directory is still being walked, so the file count is not known yet
+        unsigned int num_threads = calculateSafeThreadCount(
+            requested_threads, std::numeric_limits<unsigned int>::max(), final_job_resources);
+
+        // Calculate job-aware memory limit
+        size_t calculated_memory_limit = calculateSafeMemoryLimit(memory_limit_mb, num_threads, final_job_resources);
+
+        if (!quiet)
         {
-            std::vector<std::string> extensions = {".log", ".out"};
-            if (batch_size > 0)
+            // Debug thread calculation with detailed reasoning
+            unsigned int hardware_cores = std::thread::hardware_concurrency();
+            std::cout << "System: " << hardware_cores << " cores detected" << std::endl;
+            std::cout << "Requested: " << requested_threads << " threads";
+            if (requested_threads == hardware_cores / 2)
+            {
+                std::cout << " (default: half cores)";
+            }
+            std::cout << std::endl;
+
+            // Show job environment
+            if (final_job_resources.scheduler_type != SchedulerType::NONE)
             {
-                log_files = findLogFiles(extensions, max_file_size_mb, batch_size);
+                std::cout << "Job scheduler: "
+                          << JobSchedulerDetector::scheduler_name(final_job_resources.scheduler_type);
+                if (final_job_resources.has_cpu_limit)
+                {
+                    std::cout << " (CPU limit: " << final_job_resources.allocated_cpus << ")";
+                }
+                else
+                {
+                    std::cout << " (no CPU limits detected - interactive session)";
+                }
+                std::cout << std::endl;
             }
             else
             {
-                log_files = findLogFiles(extensions, max_file_size_mb);
+                std::cout << "Environment: Interactive/local execution" << std::endl;
+            }
+
+            std::cout << "Using: " << num_threads << " threads";
+            if (num_threads < requested_threads)
+            {
+                std::cout << " (reduced for safety)";
+            }
+            else if (num_threads == requested_threads)
+            {
+                std::cout << " (as requested)";
+            }
+            std::cout << std::endl;
+
+            std::cout << "Max file size limit: " << max_file_size_mb << " MB" << std::endl;
+
+            if (shard.enabled())
+            {
+                std::cout << "Shard: " << shard.index << "/" << shard.count << " (partial results for merge)"
+                          << std::endl;
+            }
+
+            if (memory_limit_mb > 0 && calculated_memory_limit < memory_limit_mb)
+            {
+                std::cout << "Note: Memory limit reduced from " << memory_limit_mb << " MB to "
+                          << calculated_memory_limit << " MB due to job allocation" << std::endl;
             }
         }
-        else
+
+        if (format != "text" && format != "csv" && format != "bin")
+        {
+            throw std::runtime_error("Invalid format '" + format + "'. Supported formats: 'text', 'csv', 'bin'.");
+        }
+
+        // User-defined fields are collected by the full fast scan; the tail scan skips most of a log and the
+        // legacy engine has no anchor set
+        std::shared_ptr<const CustomFieldSet> custom_fields = CustomFieldSet::installed();
+        std::vector<ColumnarWriter::Column>   field_columns;
+        if (custom_fields)
         {
-            if (batch_size > 0)
+            field_columns = custom_fields->columns();
+            if (scan_mode == ScanMode::TAIL || scan_mode == ScanMode::LEGACY)
             {
-                log_files = findLogFiles(extension, max_file_size_mb, batch_size);
+                scan_mode = ScanMode::FAST;
+                if (!quiet)
+                {
+                    std::cout << "Note: Custom fields are read by the full scan; using scan mode 'fast'"
+                              << std::endl;
+                }
             }
-            else
+        }
+
+        // Filters were checked when the options were parsed; names of user-defined fields are known only now
+        ResultFilter filter;
+        for (const auto& expression : selection.where)
+        {
+            std::string error;
+            if (!filter.add(expression, error) || !filter.bind(field_columns, error))
             {
-                log_files = findLogFiles(extension, max_file_size_mb);
+                throw std::runtime_error("Invalid --where filter: " + error);
             }
         }
+        size_t top = selection.top;
 
-        if (log_files.empty())
+        // Set up output file; a shard always writes "bin" so merge gets the values back losslessly
+        bool                  binary           = format == "bin" || shard.enabled();
+        std::filesystem::path cwd              = std::filesystem::current_path();
+        std::string           dir_name         = cwd.filename().string();
+        std::string           output_extension = (format == "csv") ? ".csv" : binary ? ".bin" : ".results";
+        std::string           output_filename  = dir_name + output_extension;
+        if (shard.enabled())
         {
-            if (is_log_extension)
+            output_filename = dir_name + shard.suffix() + ".bin";
+        }
+
+        // Text formats go to output_file; "bin" rows go to the columnar writer and only the summary to the console
+        std::ofstream                   output_file;
+        std::unique_ptr<ColumnarWriter> columnar;
+        auto open_output_file = [&output_file, &columnar, &output_filename, &field_columns, binary]() {
+            if (binary)
             {
-                std::cerr << "No .log or .out files found in the current directory." << std::endl;
+                columnar = std::make_unique<ColumnarWriter>(output_filename, resultColumns(field_columns));
+                return;
             }
-            else
+            output_file.open(output_filename);
+            if (!output_file.is_open())
             {
-                std::cerr << "No " << extension << " files found in the current directory." << std::endl;
+                throw std::runtime_error("Could not open output file: " + output_filename);
             }
-            return;
-        }
+        };
 
-        if (g_shutdown_requested.load())
+        // Create processing context with job-aware memory limit
+        ProcessingContext context(temp, C, use_input_temp, num_threads, extension, max_file_size_mb, job_resources);
+
+        // Apply calculated memory limit
+        context.memory_monitor->set_memory_limit(calculated_memory_limit);
+        context.scan_mode = scan_mode;
+        if (session)
         {
-            std::cerr << "Shutdown requested during file discovery." << std::endl;
-            return;
+            // Logs parsed by earlier commands of the session are reused, with or without --index
+            context.result_index = session->result_index(use_result_index);
+        }
+        else if (use_result_index)
+        {
+            // Each shard keeps its own index; tasks sharing one would drop each other's entries on save
+            context.result_index = std::make_shared<ResultIndex>(
+                shard.enabled() ? ".gaussian_extractor" + shard.suffix() + ".idx" : RESULT_INDEX_FILENAME);
+            context.result_index->load();
+        }
+        if (with_xyz)
+        {
+            context.geometry_writer = std::make_shared<GeometryWriter>();
+        }
+        context.scan_observer = observer;
+        context.custom_fields = custom_fields;
+
+        // Logs that did not end normally are rejected from their tail; geometries and the observer need the scan
+        context.done_only = filter.needs_normal_termination() && !context.geometry_writer && !observer;
+
+        // Read-ahead feeds the whole-log scan only; the other modes read parts of each log, and logs served by
+        // the result index would be read for nothing
+        bool   index_consulted = context.result_index && !context.geometry_writer && !context.scan_observer;
+        size_t readahead_depth =
+            io_depth < 0 ? Readahead::auto_depth(discovery.root) : static_cast<size_t>(io_depth);
+        if (readahead_depth > 0 && (scan_mode == ScanMode::FAST || observer) && !index_consulted)
+        {
+            context.readahead = std::make_shared<Readahead>(readahead_depth, context.memory_monitor.get());
         }
 
-        // Calculate job-aware safe thread count
-        unsigned int num_threads = calculateSafeThreadCount(
-            requested_threads, static_cast<unsigned int>(log_files.size()), final_job_resources);
+        // Logs an interrupted run already parsed, reused while they are unchanged; geometries and the observer need
+        // every log scanned again
+        struct JournaledResult
+        {
+            FileStamp stamp;
+            Result    result;
+        };
+        std::unique_ptr<RunJournal>                      journal;
+        std::unordered_map<std::string, JournaledResult> journaled;
+        if (resume && !context.geometry_writer && !observer)
+        {
+            journal = std::make_unique<RunJournal>(
+                RunJournal::path_for(shard.enabled() ? "extract" + shard.suffix() : std::string("extract")));
+            std::string error;
+            if (!journal->open(journalSignature(context), error))
+            {
+                throw std::runtime_error(error);
+            }
+            for (const auto& entry : journal->recovered())
+            {
+                std::string     path;
+                JournaledResult saved;
+                if (entry.type == RunJournal::EntryType::RESULT &&
+                    decodeJournalResult(entry.payload, path, saved.stamp, saved.result))
+                {
+                    journaled[path] = std::move(saved);
+                }
+            }
+            if (!quiet && journal->discarded())
+            {
+                std::cout << "Note: " << journal->path() << " was written with other settings; starting over"
+                          << std::endl;
+            }
+            if (!quiet && !journaled.empty())
+            {
+                std::cout << "Resuming: " << journaled.size() << " logs already parsed in " << journal->path()
+                          << std::endl;
+            }
+        }
+        else if (resume && !quiet)
+        {
+            std::cout << "Note: --resume is not used with --with-xyz; every log is scanned" << std::endl;
+        }
 
-        // Calculate job-aware memory limit
-        size_t calculated_memory_limit = calculateSafeMemoryLimit(memory_limit_mb, num_threads, final_job_resources);
+        // A run that ends normally removes its journal; an interrupted one leaves it for the next --resume
+        auto finish_journal = [&journal]() {
+            if (journal && !g_shutdown_requested.load())
+            {
+                journal->finish();
+            }
+        };
 
         if (!quiet)
         {
-            if (is_log_extension)
+            std::cout << "Memory limit: " << formatMemorySize(context.memory_monitor->get_max_usage());
+            if (final_job_resources.has_memory_limit)
+            {
+                std::cout << " (job allocation: "
+                          << formatMemorySize(final_job_resources.allocated_memory_mb * 1024 * 1024) << ")";
+            }
+            std::cout << std::endl;
+        }
+
+        // Run parameters, known before any file is processed
+        std::ostringstream preamble;
+
+        // Standard header from Metadata module
+        preamble << Metadata::header();
+
+        if (use_input_temp)
+        {
+            preamble << "Using specified temperature for all files: " << std::fixed << std::setprecision(3) << temp
+                     << " K\n";
+        }
+        else
+        {
+            preamble << "Default temperature for files without specified temp: " << std::fixed
+                     << std::setprecision(3) << temp << " K\n";
+        }
+
+        preamble << "The concentration for phase correction: " << C / 1000 << " M or " << C << " mol/m3\n";
+        double representative_GphaseCorr = R * temp * std::log(C * R * temp / Po) * 0.0003808798033989866 / 1000;
+        preamble << "Representative Gibbs free correction for phase changing at " << std::fixed
+                 << std::setprecision(3) << temp << " K: " << std::fixed << std::setprecision(6)
+                 << representative_GphaseCorr << " au\n";
+        preamble << "Using " << num_threads << " threads for processing.\n";
+
+        std::string table_header = binary ? std::string() : formatTableHeader(format, field_columns);
+
+        // Streaming writes the table before the summary; unsorted rows go out as each file completes
+        bool stream_rows = stream_output && !isSortableColumn(column);
+        if (stream_output)
+        {
+            open_output_file();
+            if (!binary)
+            {
+                output_file << preamble.str() << table_header;
+            }
+            if (!quiet)
+            {
+                std::cout << preamble.str() << table_header;
+            }
+        }
+
+        // One result buffer per executor thread, so collecting a result takes no lock
+        TaskExecutor&                    executor = TaskExecutor::shared(num_threads);
+        std::vector<std::vector<Result>> thread_results(executor.thread_count());
+        std::mutex                       output_mutex;
+        std::atomic<size_t>              completed_files(0);
+        std::atomic<size_t>              extracted_files(0);
+        std::atomic<size_t>              selected_files(0);
+        std::atomic<size_t>              kept_in_order(0);  // Rows kept for --top of an unsortable column
+        bool                             bounded = top > 0 && isSortableColumn(column);
+
+        // Split scanning needs the fast engine, no observer wanting the whole content, and mergeable fields
+        bool split_logs = context.scan_mode == ScanMode::FAST && !context.scan_observer &&
+                          (!context.custom_fields || context.custom_fields->mergeable());
+
+        // Paths found so far; appended by the directory walk while workers read earlier entries. A task is a
+        // whole log, or one part of a large log that several threads scan (see SplitLog).
+        struct ScanTask
+        {
+            size_t                    file;     // Index in log_files
+            size_t                    part;     // Part of a split log
+            std::shared_ptr<SplitLog> split;    // nullptr = scanned whole by extract()
+            const Result*             resumed;  // Result from the journal, or nullptr = the log is scanned
+        };
+        std::vector<std::string> log_files;
+        std::vector<FileStamp>   log_stamps;  // Stamp of each log when it was found (journaled runs only)
+        std::vector<ScanTask>    tasks;
+        std::mutex               log_files_mutex;
+        std::atomic<size_t>      total_files(0);     // Set once discovery has finished
+        size_t                   discovered_files = 0;  // Matches in the directory, including other shards'
+
+        // Discovery on the calling thread; every match is handed to the workers immediately
+        auto discover_files = [&](const TaskExecutor::Submit& submit) {
+            FileDiscovery::walk(discovery, [&](const std::string& path, uintmax_t size) {
+                ++discovered_files;
+                if (!shard.contains(path))
+                {
+                    return;
+                }
+
+                // Logs the journal holds unchanged are not read again
+                FileStamp     stamp;
+                const Result* resumed = nullptr;
+                if (journal && FileStamp::from_path(path, stamp))
+                {
+                    auto it = journaled.find(path);
+                    if (it != journaled.end() && it->second.stamp == stamp)
+                    {
+                        resumed = &it->second.result;
+                    }
+                }
+
+                // Large logs are mapped and scanned in parts instead of being read ahead
+                size_t parts = split_logs && !resumed && !CompressedInput::is_compressed(path)
+                                   ? LogScanner::split_part_count(size, executor.thread_count())
+                                   : 1;
+                std::shared_ptr<SplitLog> split;
+                if (parts > 1)
+                {
+                    split            = std::make_shared<SplitLog>();
+                    split->path      = path;
+                    split->file_name = path.compare(0, 2, "./") == 0 ? path.substr(2) : path;
+                    split->parts.resize(parts);
+                    split->remaining.store(parts);
+                }
+
+                size_t first_task;
+                {
+                    std::lock_guard<std::mutex> lock(log_files_mutex);
+                    first_task = tasks.size();
+                    for (size_t part = 0; part < parts; ++part)
+                    {
+                        tasks.push_back({log_files.size(), part, split, resumed});
+                    }
+                    log_files.push_back(path);
+                    if (journal)
+                    {
+                        log_stamps.push_back(stamp);
+                    }
+                }
+                if (context.geometry_writer)
+                {
+                    context.geometry_writer->add_log(path);
+                }
+                if (context.readahead && !split && !resumed)
+                {
+                    context.readahead->post(path, size);
+                }
+                for (size_t part = 0; part < parts; ++part)
+                {
+                    submit(first_task + part);
+                }
+            });
+
+            std::lock_guard<std::mutex> lock(log_files_mutex);
+            total_files.store(log_files.size());
+            if (!quiet && !log_files.empty())
+            {
+                std::lock_guard<std::mutex> output_lock(output_mutex);
+                if (is_log_extension)
+                {
+                    std::cout << "Found " << log_files.size() << " .log/.out files" << std::endl;
+                }
+                else
+                {
+                    std::cout << "Found " << log_files.size() << " " << extension << " files" << std::endl;
+                }
+            }
+        };
+
+        // Filter, keep or stream one scanned log and report progress
+        auto collect = [&](Result res) {
+            extracted_files.fetch_add(1);
+
+            bool keep = filter.matches(res);
+            if (keep)
             {
-                std::cout << "Found " << log_files.size() << " .log/.out files" << std::endl;
+                selected_files.fetch_add(1);
             }
-            else
+
+            // Unsortable columns keep the first rows to complete; sorted ones the first in order (below)
+            if (keep && top > 0 && !bounded)
             {
-                std::cout << "Found " << log_files.size() << " " << extension << " files" << std::endl;
+                keep = kept_in_order.fetch_add(1) < top;
             }
 
-            // Debug thread calculation with detailed reasoning
-            unsigned int hardware_cores = std::thread::hardware_concurrency();
-            std::cout << "System: " << hardware_cores << " cores detected" << std::endl;
-            std::cout << "Requested: " << requested_threads << " threads";
-            if (requested_threads == hardware_cores / 2)
+            if (!keep)
             {
-                std::cout << " (default: half cores)";
+                // Left out of the table; still counted as processed
             }
-            std::cout << std::endl;
-
-            // Show job environment
-            if (final_job_resources.scheduler_type != SchedulerType::NONE)
+            else if (stream_rows && binary)
             {
-                std::cout << "Job scheduler: "
-                          << JobSchedulerDetector::scheduler_name(final_job_resources.scheduler_type);
-                if (final_job_resources.has_cpu_limit)
+                auto            lock = Profiler::lock(output_mutex);
+                Profiler::Scope write(Profiler::Phase::FORMAT);
+                writeResultColumns(*columnar, res, field_columns);
+            }
+            else if (stream_rows)
+            {
+                std::ostringstream row;
                 {
-                    std::cout << " (CPU limit: " << final_job_resources.allocated_cpus << ")";
+                    Profiler::Scope write(Profiler::Phase::FORMAT);
+                    writeResultRow(row, res, format, field_columns);
                 }
-                else
+
+                auto            lock = Profiler::lock(output_mutex);
+                Profiler::Scope write(Profiler::Phase::FORMAT);
+                output_file << row.str();
+                if (!quiet)
                 {
-                    std::cout << " (no CPU limits detected - interactive session)";
+                    std::cout << row.str();
                 }
-                std::cout << std::endl;
             }
-            else
-            {
-                std::cout << "Environment: Interactive/local execution" << std::endl;
-            }
-
-            std::cout << "Using: " << num_threads << " threads";
-            if (num_threads < requested_threads)
+            else if (bounded)
             {
-                std::cout << " (reduced for safety)";
+                // Max-heap of this thread's first rows in sort order: the last row leaves once it holds top + 1
+                auto  later = [column](const Result& a, const Result& b) {
+                    return compareResults(a, b, column);
+                };
+                auto& run   = thread_results[TaskExecutor::current_slot()];
+                run.push_back(std::move(res));
+                std::push_heap(run.begin(), run.end(), later);
+                if (run.size() > top)
+                {
+                    std::pop_heap(run.begin(), run.end(), later);
+                    run.pop_back();
+                }
             }
-            else if (num_threads == requested_threads)
+            else
             {
-                std::cout << " (as requested)";
+                thread_results[TaskExecutor::current_slot()].push_back(std::move(res));
             }
-            std::cout << std::endl;
 
-            std::cout << "Max file size limit: " << max_file_size_mb << " MB" << std::endl;
+            size_t completed = completed_files.fetch_add(1) + 1;
 
-            if (memory_limit_mb > 0 && calculated_memory_limit < memory_limit_mb)
+            // Progress reporting (every 10% or every 100 files, whichever is smaller) once the total is known;
+            // streamed text rows show progress themselves
+            size_t total = total_files.load();
+            size_t progress_interval =
+                std::max(static_cast<size_t>(1), std::min(total / 10, static_cast<size_t>(100)));
+            if (!quiet && (!stream_rows || binary) && total > 0 && completed % progress_interval == 0)
             {
-                std::cout << "Note: Memory limit reduced from " << memory_limit_mb << " MB to "
-                          << calculated_memory_limit << " MB due to job allocation" << std::endl;
+                std::lock_guard<std::mutex> lock(output_mutex);
+                std::cout << "Processed " << completed << "/" << total << " files ("
+                          << (completed * 100 / total) << "%)" << std::endl;
             }
-        }
-
-        // Set up output file
-        std::filesystem::path cwd              = std::filesystem::current_path();
-        std::string           dir_name         = cwd.filename().string();
-        std::string           output_extension = (format == "csv") ? ".csv" : ".results";
-        std::string           output_filename  = dir_name + output_extension;
-
-        std::ofstream output_file(output_filename);
-        if (!output_file.is_open())
-        {
-            throw std::runtime_error("Could not open output file: " + output_filename);
-        }
-
-        // Create processing context with job-aware memory limit
-        ProcessingContext context(temp, C, use_input_temp, num_threads, extension, max_file_size_mb, job_resources);
-
-        // Apply calculated memory limit
-        context.memory_monitor->set_memory_limit(calculated_memory_limit);
+        };
 
-        if (!quiet)
-        {
-            std::cout << "Memory limit: " << formatMemorySize(context.memory_monitor->get_max_usage());
-            if (final_job_resources.has_memory_limit)
+        // Task body with comprehensive error handling
+        auto process_file = [&](size_t i) {
+            std::string file;
+            ScanTask    task;
+            FileStamp   stamp;
             {
-                std::cout << " (job allocation: "
-                          << formatMemorySize(final_job_resources.allocated_memory_mb * 1024 * 1024) << ")";
+                std::lock_guard<std::mutex> lock(log_files_mutex);
+                task = tasks[i];
+                file = log_files[task.file];
+                if (journal)
+                {
+                    stamp = log_stamps[task.file];
+                }
             }
-            std::cout << std::endl;
-        }
 
-        // Thread-safe result collection
-        std::vector<Result> results;
-        std::mutex          results_mutex;
-        std::atomic<size_t> file_index(0);
-        std::atomic<size_t> completed_files(0);
+            // Parsed logs are journaled before they are collected, so an interruption loses at most the last batch
+            auto record = [&](Result res) {
+                if (journal && stamp.mtime_ns != 0)
+                {
+                    journal->append(RunJournal::EntryType::RESULT, encodeJournalResult(file, stamp, res));
+                }
+                collect(std::move(res));
+            };
 
-        // Worker function with comprehensive error handling
-        auto worker_function = [&]() {
-            while (!g_shutdown_requested.load())
+            try
             {
-                size_t i = file_index.fetch_add(1);
-                if (i >= log_files.size())
+                if (task.resumed)
                 {
-                    break;
+                    collect(*task.resumed);
+                    return;
+                }
+                if (!task.split)
+                {
+                    record(extract(file, context));
+                    return;
                 }
 
-                const std::string& file = log_files[i];
-
+                // Every part records its failure; the last part to finish merges them or reports the first error
+                SplitLog& log = *task.split;
                 try
                 {
-                    Result res = extract(file, context);
-
-                    {
-                        std::lock_guard<std::mutex> lock(results_mutex);
-                        results.push_back(res);
-                    }
-
-                    size_t completed = completed_files.fetch_add(1) + 1;
-
-                    // Progress reporting (every 10% or every 100 files, whichever is smaller)
-                    size_t progress_interval =
-                        std::max(static_cast<size_t>(1), std::min(log_files.size() / 10, static_cast<size_t>(100)));
-                    if (!quiet && completed % progress_interval == 0)
-                    {
-                        std::cout << "Processed " << completed << "/" << log_files.size() << " files ("
-                                  << (completed * 100 / log_files.size()) << "%)" << std::endl;
-                    }
+                    scanSplitPart(log, task.part, context);
                 }
                 catch (const std::exception& e)
                 {
-                    context.error_collector->add_error("Error processing file '" + file + "': " + e.what());
-                    completed_files.fetch_add(1);
+                    log.fail(e.what());
                 }
                 catch (...)
                 {
-                    context.error_collector->add_error("Unknown error processing file: " + file);
-                    completed_files.fetch_add(1);
+                    log.fail("Unknown error");
+                }
+                if (log.remaining.fetch_sub(1) != 1)
+                {
+                    return;
+                }
+                if (log.failed.load())
+                {
+                    throw std::runtime_error(log.error);
                 }
+                record(finishSplitLog(log, context));
+            }
+            catch (const std::exception& e)
+            {
+                context.error_collector->add_error("Error processing file '" + file + "': " + e.what());
+                completed_files.fetch_add(1);
+            }
+            catch (...)
+            {
+                context.error_collector->add_error("Unknown error processing file: " + file);
+                completed_files.fetch_add(1);
             }
         };
 
-        // Launch worker threads
-        std::vector<std::future<void>> futures;
-        for (unsigned int i = 0; i < num_threads; ++i)
+        // Parsing starts with the first file found instead of after the whole directory has been listed
+        try
+        {
+            executor.run_streaming(discover_files, process_file);
+        }
+        catch (const std::exception& e)
         {
-            futures.emplace_back(std::async(std::launch::async, worker_function));
+            context.error_collector->add_error("Thread execution error: " + std::string(e.what()));
         }
 
-        // Wait for all threads to complete
-        for (auto& future : futures)
+        if (context.geometry_writer)
         {
-            try
+            std::vector<std::string> rename_errors;
+            context.geometry_writer->finish(rename_errors);
+            for (const auto& error : rename_errors)
             {
-                future.get();
+                context.error_collector->add_error(error);
             }
-            catch (const std::exception& e)
+        }
+
+        if (context.readahead && !quiet)
+        {
+            std::cout << "Read-ahead: " << context.readahead->hit_count() << " logs read ahead, "
+                      << context.readahead->miss_count() << " read by the workers" << std::endl;
+        }
+
+        if (context.result_index && !use_result_index)
+        {
+            if (!quiet)
             {
-                context.error_collector->add_error("Thread execution error: " + std::string(e.what()));
+                std::cout << "Session: " << context.result_index->hit_count() << " logs reused, "
+                          << context.result_index->miss_count() << " parsed" << std::endl;
+            }
+        }
+        else if (context.result_index)
+        {
+            if (!context.result_index->save())
+            {
+                context.error_collector->add_warning("Could not write result index: " + context.result_index->path());
+            }
+            else if (!quiet)
+            {
+                std::cout << "Result index: " << context.result_index->hit_count() << " reused, "
+                          << context.result_index->miss_count() << " parsed" << std::endl;
             }
         }
 
@@ -1456,9 +2793,50 @@ void processAndOutputResults(double                          temp,
             std::cerr << "Processing interrupted by shutdown signal." << std::endl;
             std::cerr << "Processed " << completed_files.load() << "/" << log_files.size()
                       << " files before interruption." << std::endl;
+            if (journal && journal->flush())
+            {
+                std::cerr << "Parsed logs are kept in " << journal->path()
+                          << "; run again with --resume to continue." << std::endl;
+            }
+        }
+
+        // A shard without files still writes its (empty) partial, so merge sees that it has run
+        if (log_files.empty() && shard.enabled() && discovered_files > 0 && !g_shutdown_requested.load())
+        {
+            if (!columnar)
+            {
+                open_output_file();
+            }
+            columnar->close();
+            finish_journal();
+            std::cout << "No files belong to shard " << shard.index << "/" << shard.count << " ("
+                      << discovered_files << " found). Empty partial results written to " << output_filename
+                      << std::endl;
+            return;
+        }
+
+        if (log_files.empty())
+        {
+            if (is_log_extension)
+            {
+                std::cerr << "No .log or .out files found in the current directory." << std::endl;
+            }
+            else
+            {
+                std::cerr << "No " << extension << " files found in the current directory." << std::endl;
+            }
+            if (output_file.is_open() || columnar)
+            {
+                output_file.close();
+                columnar.reset();
+                std::filesystem::remove(output_filename);
+            }
+            finish_journal();
+            return;
         }
 
-        if (results.empty())
+        size_t result_count = extracted_files.load();
+        if (result_count == 0)
         {
             std::cerr << "No valid results were extracted." << std::endl;
 
@@ -1472,41 +2850,54 @@ void processAndOutputResults(double                          temp,
                     std::cerr << "  " << error << std::endl;
                 }
             }
+            finish_journal();
             return;
         }
 
-        // Sort results
-        std::sort(results.begin(), results.end(), [column](const Result& a, const Result& b) {
-            return compareResults(a, b, column);
-        });
-
-        // Prepare header information
-        std::ostringstream params;
-
-
-        // Standard header from Metadata module
-        params << Metadata::header();
-
-        if (use_input_temp)
+        // Sort each thread's run in parallel; the runs are merged while writing
+        if (isSortableColumn(column))
         {
-            params << "Using specified temperature for all files: " << std::fixed << std::setprecision(3) << temp
-                   << " K\n";
+            executor.run(thread_results.size(), [&thread_results, column](size_t run) {
+                Profiler::Scope sort(Profiler::Phase::SORT);
+                std::sort(thread_results[run].begin(), thread_results[run].end(),
+                          [column](const Result& a, const Result& b) {
+                              return compareResults(a, b, column);
+                          });
+            });
         }
-        else
+
+        // Processing summary, written after the table when streaming
+        std::ostringstream summary;
+        summary << "Successfully processed " << result_count << "/" << log_files.size() << " files.\n";
+        if (selection.active())
         {
-            params << "Default temperature for files without specified temp: " << std::fixed << std::setprecision(3)
-                   << temp << " K\n";
+            size_t selected = selected_files.load();
+            summary << "Selected " << (top > 0 ? std::min(selected, top) : selected) << " of " << result_count
+                    << " results (";
+            if (!filter.empty())
+            {
+                summary << "where " << filter.describe() << (top > 0 ? "; " : "");
+            }
+            if (top > 0)
+            {
+                summary << "top " << top << (isSortableColumn(column) ? " by column " + std::to_string(column)
+                                                                      : std::string(" in completion order"));
+            }
+            summary << ")\n";
         }
 
-        params << "The concentration for phase correction: " << C / 1000 << " M or " << C << " mol/m3\n";
-        double representative_GphaseCorr = R * temp * std::log(C * R * temp / Po) * 0.0003808798033989866 / 1000;
-        params << "Representative Gibbs free correction for phase changing at " << std::fixed << std::setprecision(3)
-               << temp << " K: " << std::fixed << std::setprecision(6) << representative_GphaseCorr << " au\n";
-        params << "Using " << num_threads << " threads for processing.\n";
-        params << "Successfully processed " << results.size() << "/" << log_files.size() << " files.\n";
-
         // Add resource usage info
-        params << "Peak memory usage: " << formatMemorySize(context.memory_monitor->get_peak_usage()) << "\n";
+        summary << "Peak memory usage: " << formatMemorySize(context.memory_monitor->get_peak_usage()) << "\n";
+        if (size_t delayed = context.memory_monitor->get_delayed_reservations())
+        {
+            summary << "Files delayed by the memory limit: " << delayed << "\n";
+        }
+        if (context.geometry_writer)
+        {
+            summary << "Final geometries written: " << context.geometry_writer->final_count() << " to "
+                    << context.geometry_writer->final_directory() << ", " << context.geometry_writer->running_count()
+                    << " to " << context.geometry_writer->running_directory() << "\n";
+        }
 
         // Add warnings and errors
         std::vector<std::string> all_warnings        = warnings;
@@ -1517,95 +2908,94 @@ void processAndOutputResults(double                          temp,
 
         if (!all_warnings.empty() || !processing_errors.empty())
         {
-            params << "\n-------------------------------------------------------------\n";
+            summary << "\n-------------------------------------------------------------\n";
 
             if (!all_warnings.empty())
             {
-                params << "Warnings:\n";
+                summary << "Warnings:\n";
                 for (const auto& warning : all_warnings)
                 {
-                    params << "- " << warning << "\n";
+                    summary << "- " << warning << "\n";
                 }
             }
 
             if (!processing_errors.empty())
             {
-                params << "Errors:\n";
+                summary << "Errors:\n";
                 for (const auto& error : processing_errors)
                 {
-                    params << "- " << error << "\n";
+                    summary << "- " << error << "\n";
                 }
             }
 
-            params << "-------------------------------------------------------------\n";
+            summary << "-------------------------------------------------------------\n";
         }
 
-        // Generate output
-        std::ostringstream output_stream;
+        Profiler::Scope write(Profiler::Phase::FORMAT);
+        if (binary)
+        {
+            // Rows not streamed yet are merged straight into the row groups
+            if (!columnar)
+            {
+                open_output_file();
+            }
+            mergeSortedRuns(
+                thread_results, column,
+                [&](const Result& result) {
+                    writeResultColumns(*columnar, result, field_columns);
+                },
+                top);
+            columnar->close();
 
-        if (format == "text")
-        {
-            // Text format output
-            std::ostringstream header;
-            header << std::setw(53) << std::left << "Output name" << std::setw(18) << std::right << "ETG kJ/mol"
-                   << std::setw(10) << std::right << "Low FC" << std::setw(18) << std::right << "ETG a.u"
-                   << std::setw(18) << std::right << "Nuclear E au" << std::setw(18) << std::right << "SCFE"
-                   << std::setw(10) << std::right << "ZPE " << std::setw(8) << std::right << "Status" << std::setw(6)
-                   << std::right << "PCorr" << std::setw(6) << std::right << "Round" << "\n";
-
-            std::ostringstream separator;
-            separator << std::setw(53) << std::left << std::string(53, '-') << std::setw(18) << std::right
-                      << std::string(18, '-') << std::setw(10) << std::right << std::string(10, '-') << std::setw(18)
-                      << std::right << std::string(18, '-') << std::setw(18) << std::right << std::string(18, '-')
-                      << std::setw(18) << std::right << std::string(18, '-') << std::setw(10) << std::right
-                      << std::string(10, '-') << std::setw(8) << std::right << std::string(8, '-') << std::setw(6)
-                      << std::right << std::string(6, '-') << std::setw(6) << std::right << std::string(6, '-') << "\n";
-
-            for (const auto& result : results)
-            {
-                output_stream << std::setw(53) << std::left << result.file_name << std::setw(18) << std::right
-                              << std::fixed << std::setprecision(6) << result.etgkj << std::setw(10) << std::right
-                              << std::fixed << std::setprecision(2) << result.lf << std::setw(18) << std::right
-                              << std::fixed << std::setprecision(6) << result.GibbsFreeHartree << std::setw(18)
-                              << std::right << std::fixed << std::setprecision(6) << result.nucleare << std::setw(18)
-                              << std::right << std::fixed << std::setprecision(6) << result.scf << std::setw(10)
-                              << std::right << std::fixed << std::setprecision(6) << result.zpe << std::setw(8)
-                              << std::right << result.status << std::setw(6) << std::right << result.phaseCorr
-                              << std::setw(6) << std::right << result.copyright_count << "\n";
-            }
-
-            output_file << params.str() << header.str() << separator.str() << output_stream.str();
             if (!quiet)
             {
-                std::cout << params.str() << header.str() << separator.str() << output_stream.str();
+                std::cout << (stream_output ? "\n" : preamble.str()) << summary.str();
             }
         }
-        else if (format == "csv")
+        else if (stream_output)
         {
-            // CSV format output
-            output_stream << "Output name,ETG kJ/mol,Low FC,ETG a.u,Nuclear E au,SCFE,ZPE,Status,PCorr,Round\n";
-            for (const auto& result : results)
-            {
-                output_stream << "\"" << result.file_name << "\"," << std::fixed << std::setprecision(6) << result.etgkj
-                              << "," << std::fixed << std::setprecision(2) << result.lf << "," << std::fixed
-                              << std::setprecision(6) << result.GibbsFreeHartree << "," << std::fixed
-                              << std::setprecision(6) << result.nucleare << "," << std::fixed << std::setprecision(6)
-                              << result.scf << "," << std::fixed << std::setprecision(6) << result.zpe << ","
-                              << result.status << "," << result.phaseCorr << "," << result.copyright_count << "\n";
-            }
+            // Sorted columns: k-way merge of the per-thread runs straight into the output
+            mergeSortedRuns(
+                thread_results, column,
+                [&](const Result& result) {
+                    std::ostringstream row;
+                    writeResultRow(row, result, format, field_columns);
+                    output_file << row.str();
+                    if (!quiet)
+                    {
+                        std::cout << row.str();
+                    }
+                },
+                top);
 
-            output_file << params.str() << output_stream.str();
+            output_file << "\n" << summary.str();
             if (!quiet)
             {
-                std::cout << params.str() << output_stream.str();
+                std::cout << "\n" << summary.str();
             }
         }
         else
         {
-            throw std::runtime_error("Invalid format '" + format + "'. Supported formats: 'text', 'csv'.");
+            open_output_file();
+
+            // Generate output
+            std::ostringstream output_stream;
+            mergeSortedRuns(
+                thread_results, column,
+                [&](const Result& result) {
+                    writeResultRow(output_stream, result, format, field_columns);
+                },
+                top);
+
+            output_file << preamble.str() << summary.str() << table_header << output_stream.str();
+            if (!quiet)
+            {
+                std::cout << preamble.str() << summary.str() << table_header << output_stream.str();
+            }
         }
 
         output_file.close();
+        finish_journal();
 
         // Final summary
         auto                          end_time = std::chrono::high_resolution_clock::now();
@@ -1614,6 +3004,11 @@ void processAndOutputResults(double                          temp,
         if (!quiet)
         {
             std::cout << "\nResults written to " << output_filename << std::endl;
+            if (shard.enabled())
+            {
+                std::cout << "Combine the partial results with 'merge' once all " << shard.count
+                          << " shards have finished." << std::endl;
+            }
             std::cout << "Total execution time: " << std::fixed << std::setprecision(3) << duration.count()
                       << " seconds" << std::endl;
 
@@ -1622,7 +3017,7 @@ void processAndOutputResults(double                          temp,
         }
         else
         {
-            std::cout << "Processed " << results.size() << "/" << log_files.size() << " files. Results written to "
+            std::cout << "Processed " << result_count << "/" << log_files.size() << " files. Results written to "
                       << output_filename << " (execution time: " << std::fixed << std::setprecision(1)
                       << duration.count() << "s)" << std::endl;
         }
@@ -1638,3 +3033,197 @@ void processAndOutputResults(double                          temp,
         throw;
     }
 }
+
+bool mergeShardResults(const std::vector<std::string>& partial_files,
+                       int                             column,
+                       const std::string&              format,
+                       bool                            quiet,
+                       unsigned int                    requested_threads)
+{
+    auto start_time = std::chrono::high_resolution_clock::now();
+
+    if (format != "text" && format != "csv" && format != "bin")
+    {
+        throw std::runtime_error("Invalid format '" + format + "'. Supported formats: 'text', 'csv', 'bin'.");
+    }
+
+    // Partials of the current directory, ordered by shard so ties keep shard order
+    std::vector<std::string> files = partial_files;
+    if (files.empty())
+    {
+        std::vector<std::pair<ShardSpec, std::string>> found;
+        std::error_code                                ec;
+        for (std::filesystem::directory_iterator it(".", ec), end; !ec && it != end; it.increment(ec))
+        {
+            std::string name = it->path().filename().string();
+            ShardSpec   shard;
+            if (it->is_regular_file(ec) && parseShardFilename(name, shard))
+            {
+                found.emplace_back(shard, name);
+            }
+        }
+        std::sort(found.begin(), found.end(), [](const auto& a, const auto& b) {
+            if (a.first.count != b.first.count)
+            {
+                return a.first.count < b.first.count;
+            }
+            return a.first.index != b.first.index ? a.first.index < b.first.index : a.second < b.second;
+        });
+        for (const auto& entry : found)
+        {
+            files.push_back(entry.second);
+        }
+    }
+
+    if (files.empty())
+    {
+        std::cerr << "No partial results (*.shard-<i>-of-<N>.bin) found in the current directory." << std::endl;
+        return false;
+    }
+
+    // Check that the partials form one complete set of shards
+    std::vector<std::string>                         warnings;
+    std::map<unsigned int, std::vector<unsigned int>> shards_by_count;
+    for (const auto& file : files)
+    {
+        ShardSpec shard;
+        if (parseShardFilename(std::filesystem::path(file).filename().string(), shard))
+        {
+            shards_by_count[shard.count].push_back(shard.index);
+        }
+    }
+    if (shards_by_count.size() > 1)
+    {
+        warnings.push_back("Partial results of runs with different shard counts were merged");
+    }
+    for (auto& [count, indices] : shards_by_count)
+    {
+        std::sort(indices.begin(), indices.end());
+        std::ostringstream missing;
+        size_t             missing_count = 0;
+        for (unsigned int index = 0; index < count; ++index)
+        {
+            if (!std::binary_search(indices.begin(), indices.end(), index))
+            {
+                missing << (missing_count++ > 0 ? ", " : "") << index;
+            }
+        }
+        if (missing_count > 0)
+        {
+            warnings.push_back("Missing partial results of " + std::to_string(missing_count) + "/" +
+                               std::to_string(count) + " shards: " + missing.str());
+        }
+        if (std::adjacent_find(indices.begin(), indices.end()) != indices.end())
+        {
+            warnings.push_back("Some shards of " + std::to_string(count) + " were given more than once");
+        }
+    }
+
+    // One run per partial, read and sorted in parallel, then merged while writing
+    TaskExecutor&                    executor = TaskExecutor::shared(std::max(1u, requested_threads));
+    std::vector<std::vector<Result>>                 runs(files.size());
+    std::vector<std::vector<ColumnarWriter::Column>> run_fields(files.size());
+    executor.run(files.size(), [&](size_t i) {
+        runs[i] = readPartialResults(files[i], run_fields[i]);
+        if (isSortableColumn(column))
+        {
+            std::sort(runs[i].begin(), runs[i].end(), [column](const Result& a, const Result& b) {
+                return compareResults(a, b, column);
+            });
+        }
+    });
+
+    // Shards of one run carry the same user-defined fields
+    const std::vector<ColumnarWriter::Column>& field_columns = run_fields.front();
+    for (size_t i = 1; i < files.size(); ++i)
+    {
+        bool same = run_fields[i].size() == field_columns.size();
+        for (size_t c = 0; same && c < field_columns.size(); ++c)
+        {
+            same = run_fields[i][c].name == field_columns[c].name && run_fields[i][c].type == field_columns[c].type;
+        }
+        if (!same)
+        {
+            throw std::runtime_error("Partial results file has other custom fields than " + files.front() + ": " +
+                                     files[i]);
+        }
+    }
+
+    size_t result_count = 0;
+    for (const auto& run : runs)
+    {
+        result_count += run.size();
+    }
+
+    std::string dir_name         = std::filesystem::current_path().filename().string();
+    std::string output_extension = (format == "csv") ? ".csv" : (format == "bin") ? ".bin" : ".results";
+    std::string output_filename  = dir_name + output_extension;
+
+    std::ostringstream preamble;
+    preamble << Metadata::header();
+    preamble << "Merged partial results of " << files.size() << " shard files.\n";
+
+    std::ostringstream summary;
+    summary << "Successfully merged " << result_count << " results from " << files.size() << " files.\n";
+    if (!warnings.empty())
+    {
+        summary << "\n-------------------------------------------------------------\n";
+        summary << "Warnings:\n";
+        for (const auto& warning : warnings)
+        {
+            summary << "- " << warning << "\n";
+        }
+        summary << "-------------------------------------------------------------\n";
+    }
+
+    if (format == "bin")
+    {
+        ColumnarWriter columnar(output_filename, resultColumns(field_columns));
+        mergeSortedRuns(runs, column, [&columnar, &field_columns](const Result& result) {
+            writeResultColumns(columnar, result, field_columns);
+        });
+        columnar.close();
+
+        if (!quiet)
+        {
+            std::cout << preamble.str() << summary.str();
+        }
+    }
+    else
+    {
+        std::ofstream output_file(output_filename);
+        if (!output_file.is_open())
+        {
+            throw std::runtime_error("Could not open output file: " + output_filename);
+        }
+
+        std::ostringstream output_stream;
+        mergeSortedRuns(runs, column, [&](const Result& result) {
+            writeResultRow(output_stream, result, format, field_columns);
+        });
+
+        std::string table_header = formatTableHeader(format, field_columns);
+        output_file << preamble.str() << summary.str() << table_header << output_stream.str();
+        if (!quiet)
+        {
+            std::cout << preamble.str() << summary.str() << table_header << output_stream.str();
+        }
+    }
+
+    auto                          end_time = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> duration = end_time - start_time;
+
+    if (!quiet)
+    {
+        std::cout << "\nResults written to " << output_filename << std::endl;
+        std::cout << "Total execution time: " << std::fixed << std::setprecision(3) << duration.count() << " seconds"
+                  << std::endl;
+    }
+    else
+    {
+        std::cout << "Merged " << result_count << " results from " << files.size() << " files. Results written to "
+                  << output_filename << " (execution time: " << std::fixed << std::setprecision(1)
+                  << duration.count() << "s)" << std::endl;
+    }
+    return true;
+}
@@ -37,10 +37,14 @@
 #define GAUSSIAN_EXTRACTOR_H
 
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
+#include <cstdint>
+#include <functional>
 #include <memory>
 #include <mutex>
 #include <string>
+#include <string_view>
 #include <vector>
 #if __cpp_lib_semaphore >= 201907L
     #include <semaphore>
@@ -50,6 +54,7 @@
     #include <mutex>
 #endif
 #include "job_management/job_scheduler.h"
+#include "utilities/columnar_writer.h"
 
 /**
  * @brief Global flag for graceful termination of long-running operations
@@ -58,7 +63,8 @@
  * when a termination signal is received or when the user requests cancellation.
  * All long-running loops and operations should periodically check this flag.
  *
- * @note This is defined in main.cpp and set by the signal handler
+ * @note This is defined with the extraction core, so programs linking the
+ *       library have it too, and set by the signal handler of main.cpp
  */
 extern std::atomic<bool> g_shutdown_requested;
 
@@ -107,6 +113,24 @@ const size_t DEFAULT_MAX_FILE_SIZE_MB = 100;    ///< Default maximum individual
 
 /** @} */  // end of SafetyLimits group
 
+/**
+ * @enum ResultStatus
+ * @brief Job termination status of an extracted log file
+ *
+ * Stored as one byte in Result; resultStatusName() gives the column text.
+ */
+enum class ResultStatus : uint8_t
+{
+    DONE,    ///< Every job step terminated normally
+    UNDONE,  ///< Job still running or stopped without a termination message
+    FAILED   ///< At least one "Error termination" (shown as "ERROR"; named to avoid the Windows ERROR macro)
+};
+
+/**
+ * @brief Column text of a status ("DONE", "UNDONE", "ERROR")
+ */
+const char* resultStatusName(ResultStatus status);
+
 /**
  * @struct Result
  * @brief Structure containing extracted thermodynamic data from a single Gaussian log file
@@ -114,6 +138,10 @@ const size_t DEFAULT_MAX_FILE_SIZE_MB = 100;    ///< Default maximum individual
  * This structure holds all relevant thermodynamic and electronic structure data
  * extracted from a Gaussian calculation log file. It serves as the primary data
  * container for results that are collected, sorted, and output by the system.
+ * Status and phase correction are kept as one-byte values rather than strings
+ * so that large runs hold a single string (the file name) per result.
+ * Values of user-defined fields (see CustomFieldSet) are kept as display
+ * strings, one per configured field.
  *
  * @section Energy Units
  * - Electronic energies: Hartree (atomic units)
@@ -128,16 +156,17 @@ const size_t DEFAULT_MAX_FILE_SIZE_MB = 100;    ///< Default maximum individual
  */
 struct Result
 {
-    std::string file_name;         ///< Original log file name (without path)
-    double      etgkj;             ///< Electronic + thermal energy in kJ/mol
-    double      lf;                ///< Lowest vibrational frequency (cm⁻¹)
-    double      GibbsFreeHartree;  ///< Gibbs free energy in Hartree (with corrections)
-    double      nucleare;          ///< Nuclear repulsion energy in Hartree
-    double      scf;               ///< Final SCF energy in Hartree
-    double      zpe;               ///< Zero-point energy correction in Hartree
-    std::string status;            ///< Job termination status ("DONE", "ERROR", etc.)
-    std::string phaseCorr;         ///< Phase correction applied ("Yes", "No", or value)
-    int         copyright_count;   ///< Number of Gaussian copyright notices (job progress indicator)
+    std::string              file_name;         ///< Original log file name (without path)
+    double                   etgkj;             ///< Electronic + thermal energy in kJ/mol
+    double                   lf;                ///< Lowest vibrational frequency (cm⁻¹)
+    double                   GibbsFreeHartree;  ///< Gibbs free energy in Hartree (with corrections)
+    double                   nucleare;          ///< Nuclear repulsion energy in Hartree
+    double                   scf;               ///< Final SCF energy in Hartree
+    double                   zpe;               ///< Zero-point energy correction in Hartree
+    int                      copyright_count;   ///< Number of Gaussian copyright notices (job progress indicator)
+    ResultStatus             status;            ///< Job termination status
+    bool                     phaseCorr;         ///< Whether the phase correction was applied (PCorr column "YES"/"NO")
+    std::vector<std::string> field_values;      ///< User-defined field values, empty when none are configured
 };
 
 /**
@@ -158,12 +187,21 @@ struct Result
  *
  * @section MemoryMonitor Usage Pattern
  * 1. Create MemoryMonitor with desired limit
- * 2. Check can_allocate() before
- * large allocations
- * 3. Call add_usage() when allocating memory
- * 4. Call remove_usage() when freeing memory
- * 5.
- * Monitor current and peak usage for optimization
+ * 2. Before reading a file, call reserve() (or try_reserve()) with the bytes
+ *    the module will hold for it and keep the Reservation while they are held
+ * 3. The Reservation destructor returns the bytes and wakes waiting threads
+ * 4. Caches that hold memory beyond one file use add_usage()/remove_usage()
+ *    and back off with can_allocate()
+ * 5. Monitor current and peak usage for optimization
+ *
+ * @section Admission Control
+ * reserve() checks the limit and charges the bytes in one step, so threads
+ * cannot overshoot the limit between the check and the update. When the
+ * budget is exhausted the calling thread waits until other reservations are
+ * released: under memory pressure processing slows down instead of dropping
+ * files. A reservation is always granted when no other reservation is
+ * outstanding, so a single file larger than the budget is still processed
+ * (alone) and bytes held by caches cannot block progress.
  *
  * @note All methods are thread-safe and can be called from multiple threads
  *       simultaneously without external synchronization
@@ -173,9 +211,110 @@ class MemoryMonitor
 private:
     std::atomic<size_t> current_usage_bytes{0};
     std::atomic<size_t> peak_usage_bytes{0};
-    size_t              max_bytes;
+    std::atomic<size_t> max_bytes;
+
+    std::mutex              reservation_mutex_;        ///< Serialises admission decisions
+    std::condition_variable reservation_released_;     ///< Signals waiting reserve() calls
+    size_t                  outstanding_{0};           ///< Reservations not yet released
+    std::atomic<size_t>     delayed_reservations_{0};  ///< Reservations that had to wait for memory
+
+    bool acquire(size_t bytes, const std::chrono::steady_clock::time_point* deadline);
+    void release(size_t bytes);
 
 public:
+    /**
+     * @class Reservation
+     * @brief RAII token for bytes admitted by reserve() or try_reserve()
+     *
+     * Holds its bytes against the monitor's limit until it is destroyed or
+     * release() is called. Move-only, like FileHandleManager::FileGuard.
+     */
+    class Reservation
+    {
+    private:
+        MemoryMonitor* monitor;  ///< Monitor the bytes were reserved from; null when not acquired
+        size_t         bytes;    ///< Reserved bytes
+
+    public:
+        /**
+         * @brief Create an empty (not acquired) reservation
+         */
+        Reservation() : monitor(nullptr), bytes(0) {}
+
+        /**
+         * @brief Wrap bytes already charged to a monitor
+         * @param mgr Monitor holding the bytes
+         * @param reserved Number of bytes
+         */
+        Reservation(MemoryMonitor* mgr, size_t reserved) : monitor(mgr), bytes(reserved) {}
+
+        /**
+         * @brief Destructor - returns the bytes to the monitor
+         */
+        ~Reservation()
+        {
+            release();
+        }
+
+        Reservation(const Reservation&)            = delete;
+        Reservation& operator=(const Reservation&) = delete;
+
+        /**
+         * @brief Move constructor; the source no longer holds the bytes
+         */
+        Reservation(Reservation&& other) noexcept : monitor(other.monitor), bytes(other.bytes)
+        {
+            other.monitor = nullptr;
+            other.bytes   = 0;
+        }
+
+        /**
+         * @brief Move assignment; releases the bytes currently held first
+         */
+        Reservation& operator=(Reservation&& other) noexcept
+        {
+            if (this != &other)
+            {
+                release();
+                monitor       = other.monitor;
+                bytes         = other.bytes;
+                other.monitor = nullptr;
+                other.bytes   = 0;
+            }
+            return *this;
+        }
+
+        /**
+         * @brief Return the bytes to the monitor before the token goes out of scope
+         */
+        void release()
+        {
+            if (monitor)
+            {
+                monitor->release(bytes);
+                monitor = nullptr;
+                bytes   = 0;
+            }
+        }
+
+        /**
+         * @brief Whether the bytes were admitted
+         * @return false after a timeout or a shutdown request
+         */
+        bool is_acquired() const
+        {
+            return monitor != nullptr;
+        }
+
+        /**
+         * @brief Number of bytes held
+         */
+        size_t size() const
+        {
+            return bytes;
+        }
+    };
+
     /**
      * @brief Constructor with memory limit specification
      * @param max_memory_mb Maximum memory usage limit in megabytes
@@ -195,6 +334,31 @@ public:
      */
     bool can_allocate(size_t bytes);
 
+    /**
+     * @brief Reserve memory, waiting until the limit admits it
+     * @param bytes Bytes the caller will hold while the reservation lives
+     * @return Acquired reservation; not acquired only if a shutdown was requested while waiting
+     *
+     * Blocks while the bytes would exceed the limit and other reservations
+     * are outstanding. For example, a thread about to map a 300 MB log under
+     * a 1 GB limit waits until enough of the other threads' files are done.
+     */
+    Reservation reserve(size_t bytes);
+
+    /**
+     * @brief Reserve memory, waiting at most a given time
+     * @param bytes Bytes the caller will hold while the reservation lives
+     * @param timeout Longest time to wait for the limit to admit the bytes
+     * @return Reservation; not acquired on timeout or shutdown
+     */
+    Reservation try_reserve(size_t bytes, std::chrono::milliseconds timeout);
+
+    /**
+     * @brief Number of reservations that had to wait for memory
+     * @return Count since monitor creation; non-zero means the limit throttled processing
+     */
+    size_t get_delayed_reservations() const;
+
     /**
      * @brief Record memory allocation in usage tracking
      * @param bytes Number of bytes allocated
@@ -508,6 +672,105 @@ public:
 };
 
 
+/**
+ * @enum ScanMode
+ * @brief Selects the engine used by extract() to read and parse a log file
+ *
+ * - FAST: Memory-mapped, regex-free single-pass scanner (see log_scanner.h)
+ * - TAIL: FAST scanner applied backwards from end of file; reads only the
+ *         final job step plus the file header, falling back to a full scan
+ *         when the tail does not contain every section a Result needs
+ * - LEGACY: Original line-by-line std::getline/std::regex implementation
+ * - VERIFY: Run both engines, report any field mismatch as a warning and
+ *           return the legacy result (for validating the fast scanner)
+ */
+enum class ScanMode
+{
+    FAST,    ///< Memory-mapped multi-pattern scanner (default)
+    TAIL,    ///< Tail-first scanner with full-scan fallback
+    LEGACY,  ///< Line-by-line getline/regex scanner
+    VERIFY   ///< Cross-check FAST against LEGACY
+};
+
+/**
+ * @struct ShardSpec
+ * @brief Subset of the log files processed by one task of a distributed extract (--shard i/N)
+ *
+ * Every task of an array job walks the same directory and keeps the files
+ * whose path hashes to its index, so the shards are disjoint, cover every file
+ * and do not depend on the order in which the directory is listed. Each task
+ * writes its rows to a partial results file in the "bin" format (see
+ * suffix()) that the merge command combines and sorts.
+ */
+struct ShardSpec
+{
+    unsigned int index = 0;  ///< Zero-based shard of this process
+    unsigned int count = 0;  ///< Number of shards (0 = not sharded)
+
+    /**
+     * @brief Whether extract runs as one shard of a distributed run
+     */
+    bool enabled() const
+    {
+        return count > 0;
+    }
+
+    /**
+     * @brief Whether a discovered log file belongs to this shard
+     * @param path Path as reported by the directory walk
+     *
+     * Uses a 64-bit FNV-1a hash of the path, which is the same on every
+     * platform and build, so all tasks agree on the partition.
+     */
+    bool contains(const std::string& path) const;
+
+    /**
+     * @brief File name suffix of this shard (".shard-<i>-of-<N>")
+     *
+     * The partial results file is "<dir>.shard-<i>-of-<N>.bin" and the result
+     * index, when enabled, ".gaussian_extractor.shard-<i>-of-<N>.idx", so tasks
+     * sharing a directory never write the same file.
+     */
+    std::string suffix() const;
+};
+
+/**
+ * @struct ResultSelection
+ * @brief Rows of the results table kept by extract (--where, --top)
+ *
+ * Filters are tested in the worker that scanned each log and the first rows
+ * in sort order are kept in a bounded heap per thread, so the memory held and
+ * the rows formatted depend on the selection, not on the number of logs.
+ */
+struct ResultSelection
+{
+    std::vector<std::string> where;    ///< Filter expressions, all of which must hold (see ResultFilter)
+    size_t                   top = 0;  ///< Keep the first N rows in sort order (0 = all)
+
+    /**
+     * @brief Whether any row may be left out
+     */
+    bool active() const
+    {
+        return !where.empty() || top > 0;
+    }
+};
+
+class ResultIndex;
+class GeometryWriter;
+class Readahead;
+class CustomFieldSet;
+struct LogScanData;
+
+/**
+ * @brief Receiver of every log extract() scans, with the content it was scanned from
+ *
+ * Set by commands that fuse further work into the extract scan (pipeline):
+ * the content stays valid for the duration of the call only. Called from
+ * worker threads, so the receiver must be thread-safe.
+ */
+using ScanObserver = std::function<void(const std::string& path, std::string_view content, const LogScanData& data)>;
+
 /**
  * @struct ProcessingContext
  * @brief Complete context for thread-safe file processing operations
@@ -528,6 +791,16 @@ public:
  * - System memory through MemoryMonitor
  * - File handles through FileHandleManager
  * - Error collection through ThreadSafeErrorCollector
+ * - Optionally, previously parsed results through ResultIndex
+ * - Optionally, final geometries written during the scan through GeometryWriter
+ * - Optionally, further per-log work fed from the same read through a ScanObserver
+ * - Optionally, logs read ahead by dedicated I/O threads through Readahead
+ * - Optionally, user-defined fields collected in the same scan through CustomFieldSet
+ *
+ * With done_only set, extract() returns logs that cannot have status DONE
+ * (no "Normal termination" at the end) as UNDONE results without values,
+ * read from the tail only; it is set when a --where filter keeps finished
+ * jobs only.
  *
  * @note All resource managers are thread-safe and can be accessed
  *       simultaneously from multiple processing threads
@@ -544,6 +817,13 @@ struct ProcessingContext
     unsigned int                              requested_threads;  ///< Number of requested processing threads
     size_t                                    max_file_size_mb;   ///< Maximum individual file size in MB
     JobResources                              job_resources;      ///< Job scheduler resource information
+    ScanMode                                  scan_mode;          ///< Engine used by extract() to parse files
+    std::shared_ptr<ResultIndex>              result_index;       ///< Persistent result index (nullptr = disabled)
+    std::shared_ptr<GeometryWriter>           geometry_writer;    ///< Final geometry output (nullptr = disabled)
+    ScanObserver                              scan_observer;      ///< Receives each scanned log (empty = disabled)
+    std::shared_ptr<Readahead>                readahead;          ///< Logs read ahead of the workers (nullptr = disabled)
+    std::shared_ptr<const CustomFieldSet>     custom_fields;      ///< User-defined fields collected by the scan (nullptr = none)
+    bool                                      done_only;          ///< Skip the scan of logs whose tail lacks "Normal termination"
 
     /**
      * @brief Constructor with parameter validation and resource setup
@@ -575,7 +855,8 @@ struct ProcessingContext
           file_manager(std::make_shared<FileHandleManager>()),
           error_collector(std::make_shared<ThreadSafeErrorCollector>()), base_temp(temp), concentration(C),
           use_input_temp(use_temp), extension(ext), requested_threads(thread_count), max_file_size_mb(max_file_mb),
-          job_resources(job_res)
+          job_resources(job_res), scan_mode(ScanMode::FAST), result_index(nullptr),
+          geometry_writer(nullptr), readahead(nullptr), custom_fields(nullptr), done_only(false)
     {}
 };
 
@@ -647,6 +928,21 @@ Result extract(const std::string& file_name_param, const ProcessingContext& cont
  * @param memory_limit_mb Total memory usage limit (MB, 0 = auto)
  * @param warnings Vector of warnings to display before processing
  * @param job_resources Job scheduler resource information
+ * @param batch_size Batch size for directory scanning (0 = disabled)
+ * @param scan_mode Engine used to parse each log file
+ * @param use_result_index Reuse and update the persistent result index in the working directory
+ * @param stream_output Write result rows as they complete, summary after the table
+ * @param recursive Also process logs in subdirectories
+ * @param with_xyz Write the final geometry of every log during the same scan (see GeometryWriter)
+ * @param shard Process only this shard's logs and write them to its partial results file (see ShardSpec)
+ * @param observer Receives every scanned log with its content (see ScanObserver); each log is then read
+ *                 once, whole, and the scan mode and result index are not used
+ * @param io_depth Logs read ahead of the workers by dedicated I/O threads (see Readahead);
+ *                 0 = off, -1 = auto (on for network and parallel file systems)
+ * @param selection Filters and row limit of the table (see ResultSelection); with top, an unsortable
+ *                  column keeps the first rows to complete
+ * @param resume Journal every parsed log and reuse the logs an interrupted run already parsed (see RunJournal);
+ *               not used with with_xyz or an observer
  *
  * This is the main orchestration function that coordinates the complete
  * processing workflow:
@@ -668,7 +964,8 @@ Result extract(const std::string& file_name_param, const ProcessingContext& cont
  * @section Output Formats
  * - text: Human-readable tabular format
  * - csv: Comma-separated values for spreadsheet import
- * - Additional formats may be supported in future versions
+ * - bin: Typed columnar binary (see ColumnarWriter), written in row groups
+ *   as results arrive; the run summary goes to the console only
  *
  * @note This function handles all aspects of multi-threaded processing
  *       including graceful shutdown, error collection, and resource cleanup
@@ -684,8 +981,58 @@ void processAndOutputResults(double                          temp,
                              size_t                          max_file_size_mb,
                              size_t                          memory_limit_mb,
                              const std::vector<std::string>& warnings,
-                             const JobResources&             job_resources = JobResources{},
-                             size_t                          batch_size    = 0);
+                             const JobResources&             job_resources    = JobResources{},
+                             size_t                          batch_size       = 0,
+                             ScanMode                        scan_mode        = ScanMode::FAST,
+                             bool                            use_result_index = false,
+                             bool                            stream_output    = false,
+                             bool                            recursive        = false,
+                             bool                            with_xyz         = false,
+                             const ShardSpec&                shard            = ShardSpec{},
+                             const ScanObserver&             observer         = ScanObserver(),
+                             int                             io_depth         = -1,
+                             const ResultSelection&          selection        = ResultSelection{},
+                             bool                            resume           = false);
+
+/**
+ * @brief Combine the partial results of a sharded extract into one results table
+ * @param partial_files Partial results files; empty = every "*.shard-*-of-*.bin" in the current directory
+ * @param column Column number for result sorting (1-based, as for extract)
+ * @param format Output format ("text", "csv" or "bin")
+ * @param quiet Suppress non-essential output
+ * @param requested_threads Number of threads used to sort the partials
+ * @return true if a results file was written
+ *
+ * The partials are read back with ColumnarReader, sorted and merged exactly
+ * as the per-thread runs of a single extract, and written to "<dir>.results",
+ * "<dir>.csv" or "<dir>.bin". Shards missing from a numbered set, repeated
+ * shards and partials of runs with a different number of shards are reported
+ * as warnings in the summary.
+ *
+ * @throws std::runtime_error if a partial cannot be read or has another schema
+ */
+bool mergeShardResults(const std::vector<std::string>& partial_files,
+                       int                             column,
+                       const std::string&              format,
+                       bool                            quiet,
+                       unsigned int                    requested_threads);
+
+/**
+ * @brief Columns of the results table, as "--format bin" writes them
+ * @param fields Columns of the user-defined fields (CustomFieldSet::columns()), appended after "round"
+ */
+std::vector<ColumnarWriter::Column> resultTableColumns(const std::vector<ColumnarWriter::Column>& fields = {});
+
+/**
+ * @brief Append one result to an in-memory results table
+ * @param batch Batch created with resultTableColumns(fields)
+ * @param result Row to append
+ * @param fields Columns of the user-defined fields, as given to resultTableColumns()
+ *
+ * Values are those of "--format bin": a double field without a value is NaN,
+ * an int field INT32_MIN and a string field "".
+ */
+void appendResultRow(ColumnarBatch& batch, const Result& result, const std::vector<ColumnarWriter::Column>& fields);
 
 /** @} */  // end of CoreFunctions group
 
@@ -699,24 +1046,31 @@ void processAndOutputResults(double                          temp,
  * @brief Find all Gaussian log files in the current directory
  * @param extension File extension to search for (e.g., ".log", ".out")
  * @param max_file_size_mb Maximum file size to include (MB)
- * @return Vector of file paths that match the criteria
+ * @return Sorted vector of file names that match the criteria
  *
- * Recursively searches the current directory for files matching the specified
- * extension and size constraints. Files exceeding the size limit are skipped
- * with warnings to prevent memory exhaustion.
- *
- * @note The function filters out files that are too large to process safely
- *       based on available system resources
+ * Searches the current directory for files matching the specified extension
+ * (case-insensitively) and size constraint. Files exceeding the size limit are
+ * skipped to prevent memory exhaustion. The directory walk is done by
+ * FileDiscovery.
  */
-// Optimized version that uses direct iteration and sorting for consistent file processing order
 std::vector<std::string> findLogFiles(const std::string& extension, size_t max_file_size_mb = DEFAULT_MAX_FILE_SIZE_MB);
-// Batch processing version for handling millions of files with controlled memory usage
+// Batch processing version; kept for callers, batch_size no longer changes the result
 std::vector<std::string> findLogFiles(const std::string& extension, size_t max_file_size_mb, size_t batch_size);
-// Multiple extensions version
-std::vector<std::string> findLogFiles(const std::vector<std::string>& extensions, size_t max_file_size_mb);
-// Batch processing version for multiple extensions
+
+/**
+ * @brief Find Gaussian log files matching any of several extensions in one directory walk
+ * @param extensions Extensions to search for (e.g., {".log", ".out"})
+ * @param max_file_size_mb Maximum file size to include (MB)
+ * @param recursive Also search subdirectories; paths are then relative to the current directory
+ * @return Sorted vector of paths
+ */
 std::vector<std::string>
-findLogFiles(const std::vector<std::string>& extensions, size_t max_file_size_mb, size_t batch_size);
+findLogFiles(const std::vector<std::string>& extensions, size_t max_file_size_mb, bool recursive = false);
+// Batch processing version for multiple extensions
+std::vector<std::string> findLogFiles(const std::vector<std::string>& extensions,
+                                      size_t                          max_file_size_mb,
+                                      size_t                          batch_size,
+                                      bool                            recursive = false);
 /**
  * @brief Validate that a file size is within processing limits
  * @param filename Path to file to check
@@ -0,0 +1,1290 @@
+/**
+ * @file log_scanner.cpp
+ * @brief Implementation of the memory-mapped single-pass log scanner
+ * @author Le Nhan Pham
+ * @date 2025
+ *
+ * The scanner walks the raw file bytes once. A bigram lookup table flags every
+ * position where one of the anchor phrases may start; confirmed hits are
+ * grouped per line and dispatched through the same decision ladder as the
+ * legacy getline-based extract() so both engines agree on every value.
+ */
+
+#include "log_scanner.h"
+#include "extraction/custom_fields.h"
+#include "utilities/compressed_input.h"
+#include "utilities/profiler.h"
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+
+#ifndef _WIN32
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+    #ifdef __linux__
+        #include <sys/vfs.h>
+    #endif
+#endif
+
+namespace
+{
+    /**
+     * @brief Anchor phrases recognised by the scanner, in ladder order
+     */
+    enum Anchor : unsigned
+    {
+        ANCHOR_NORMAL_TERMINATION,
+        ANCHOR_ERROR_TERMINATION,
+        ANCHOR_COPYRIGHT,
+        ANCHOR_SCF_DONE,
+        ANCHOR_CIS_ENERGY,
+        ANCHOR_PCM_ENERGY,
+        ANCHOR_ZERO_POINT,
+        ANCHOR_THERMAL_GIBBS,
+        ANCHOR_SUM_THERMAL_FREE,
+        ANCHOR_SUM_ZERO_POINT,
+        ANCHOR_NUCLEAR_REPULSION,
+        ANCHOR_FREQUENCIES,
+        ANCHOR_TEMPERATURE,
+        ANCHOR_SCRF,
+        ANCHOR_STANDARD_ORIENTATION,  // Geometry anchors, searched for extract --with-xyz only
+        ANCHOR_INPUT_ORIENTATION,
+        ANCHOR_COUNT
+    };
+
+    constexpr unsigned LADDER_ANCHOR_COUNT = ANCHOR_STANDARD_ORIENTATION;
+
+    constexpr std::string_view ANCHOR_TEXT[ANCHOR_COUNT] = {
+        "Normal termination",
+        "Error termination",
+        "Copyright",
+        "SCF Done",
+        "Total Energy, E(CIS",
+        "After PCM corrections, the energy is",
+        "Zero-point correction",
+        "Thermal correction to Gibbs Free Energy",
+        "Sum of electronic and thermal Free Energies",
+        "Sum of electronic and zero-point Energies",
+        "nuclear repulsion energy",
+        "Frequencies",
+        "Kelvin.  Pressure",
+        "scrf",
+        "Standard orientation:",
+        "Input orientation:",
+    };
+
+    constexpr unsigned bit(Anchor anchor)
+    {
+        return 1u << anchor;
+    }
+
+    inline unsigned bigram_key(const char* p)
+    {
+        return (static_cast<unsigned>(static_cast<unsigned char>(p[0])) << 8) |
+               static_cast<unsigned>(static_cast<unsigned char>(p[1]));
+    }
+
+    /**
+     * @brief Anchor set of the extract() decision ladder, optionally with the geometry anchors
+     */
+    const LogScanner::AnchorSet& extract_anchors(bool with_geometry)
+    {
+        static const LogScanner::AnchorSet ladder(
+            std::vector<std::string_view>(std::begin(ANCHOR_TEXT), std::begin(ANCHOR_TEXT) + LADDER_ANCHOR_COUNT));
+        static const LogScanner::AnchorSet geometry(
+            std::vector<std::string_view>(std::begin(ANCHOR_TEXT), std::end(ANCHOR_TEXT)));
+        return with_geometry ? geometry : ladder;
+    }
+
+    inline bool is_blank(char c)
+    {
+        return c == ' ' || c == '\t';
+    }
+
+    inline bool is_space(char c)
+    {
+        return c == ' ' || c == '\t' || c == '\n' || c == '\v' || c == '\f' || c == '\r';
+    }
+
+    inline bool is_digit(char c)
+    {
+        return c >= '0' && c <= '9';
+    }
+
+    std::string_view trim_blanks(std::string_view text)
+    {
+        while (!text.empty() && is_blank(text.front()))
+        {
+            text.remove_prefix(1);
+        }
+        while (!text.empty() && is_blank(text.back()))
+        {
+            text.remove_suffix(1);
+        }
+        return text;
+    }
+
+    /**
+     * @brief safe_stod() equivalent: value is set from the numeric prefix, success requires full consumption
+     */
+    bool parse_whole_double(std::string_view text, double& value)
+    {
+        size_t consumed = 0;
+        return LogScanner::parse_leading_double(text, value, &consumed) && consumed == text.size();
+    }
+
+    /**
+     * @brief Match R"(SCF Done.*?=\s+(-?\d+\.\d+))" and parse the captured energy
+     */
+    bool parse_scf_done(std::string_view line, double& value)
+    {
+        size_t anchor = line.find(ANCHOR_TEXT[ANCHOR_SCF_DONE]);
+        if (anchor == std::string_view::npos)
+        {
+            return false;
+        }
+
+        // '.*?' cannot cross a carriage return
+        size_t limit = line.find('\r', anchor);
+
+        for (size_t eq = line.find('=', anchor + ANCHOR_TEXT[ANCHOR_SCF_DONE].size()); eq < limit;
+             eq        = line.find('=', eq + 1))
+        {
+            size_t pos = eq + 1;
+            if (pos >= line.size() || !is_space(line[pos]))
+            {
+                continue;
+            }
+            while (pos < line.size() && is_space(line[pos]))
+            {
+                ++pos;
+            }
+
+            size_t start = pos;
+            if (pos < line.size() && line[pos] == '-')
+            {
+                ++pos;
+            }
+            size_t int_start = pos;
+            while (pos < line.size() && is_digit(line[pos]))
+            {
+                ++pos;
+            }
+            if (pos == int_start || pos >= line.size() || line[pos] != '.')
+            {
+                continue;
+            }
+            size_t frac_start = ++pos;
+            while (pos < line.size() && is_digit(line[pos]))
+            {
+                ++pos;
+            }
+            if (pos == frac_start)
+            {
+                continue;
+            }
+
+            auto result = std::from_chars(line.data() + start, line.data() + pos, value);
+            return result.ec == std::errc();
+        }
+        return false;
+    }
+
+    /**
+     * @brief Header line of a vibrational analysis, printed before its "Frequencies --" lines
+     */
+    constexpr std::string_view FREQUENCY_TABLE_HEADER = "Harmonic frequencies";
+
+    /**
+     * @brief Match R"(Frequencies\s+--\s+(.*))" and return the capture
+     * @param line Log line
+     * @param values Receives the text after "--", up to a carriage return
+     * @return true if the line is a frequency line
+     */
+    bool frequency_values(std::string_view line, std::string_view& values)
+    {
+        const std::string_view anchor = ANCHOR_TEXT[ANCHOR_FREQUENCIES];
+        for (size_t at = line.find(anchor); at != std::string_view::npos; at = line.find(anchor, at + 1))
+        {
+            size_t pos = at + anchor.size();
+            if (pos >= line.size() || !is_space(line[pos]))
+            {
+                continue;
+            }
+            while (pos < line.size() && is_space(line[pos]))
+            {
+                ++pos;
+            }
+            if (line.compare(pos, 2, "--") != 0)
+            {
+                continue;
+            }
+            pos += 2;
+            if (pos >= line.size() || !is_space(line[pos]))
+            {
+                continue;
+            }
+            while (pos < line.size() && is_space(line[pos]))
+            {
+                ++pos;
+            }
+
+            // '.' in the legacy pattern stops at a carriage return
+            values    = line.substr(pos);
+            size_t cr = values.find('\r');
+            if (cr != std::string_view::npos)
+            {
+                values = values.substr(0, cr);
+            }
+            return true;
+        }
+        return false;
+    }
+
+    /**
+     * @brief Match R"(Frequencies\s+--\s+(.*))" and record every number of the capture
+     */
+    bool parse_frequencies(std::string_view line, LogScanData& data)
+    {
+        std::string_view values;
+        if (!frequency_values(line, values))
+        {
+            return false;
+        }
+
+        double freq;
+        size_t consumed;
+        while (LogScanner::parse_leading_double(values, freq, &consumed))
+        {
+            data.add_frequency(freq);
+            values.remove_prefix(consumed);
+        }
+        return true;
+    }
+
+    /**
+     * @brief Parse every number of a frequency line's values into @p frequencies
+     */
+    void collect_frequencies(std::string_view values, std::vector<double>& frequencies)
+    {
+        double freq;
+        size_t consumed;
+        while (LogScanner::parse_leading_double(values, freq, &consumed))
+        {
+            frequencies.push_back(freq);
+            values.remove_prefix(consumed);
+        }
+    }
+
+    /**
+     * @brief Apply the extract() decision ladder to one line carrying @p anchors
+     */
+    void process_line(std::string_view          line,
+                      unsigned                  anchors,
+                      const std::string&        file_name,
+                      const ProcessingContext&  context,
+                      ThreadSafeErrorCollector& errors,
+                      LogScanData&              data)
+    {
+        if (anchors & bit(ANCHOR_NORMAL_TERMINATION))
+        {
+            data.normal_count++;
+        }
+        else if (anchors & bit(ANCHOR_ERROR_TERMINATION))
+        {
+            data.error_count++;
+        }
+
+        if (anchors & bit(ANCHOR_COPYRIGHT))
+        {
+            ++data.copyright_count;
+        }
+
+        double value = 0.0;
+        if ((anchors & bit(ANCHOR_SCF_DONE)) && parse_scf_done(line, value))
+        {
+            data.has_scf  = true;
+            data.last_scf = value;
+        }
+        else if (anchors & bit(ANCHOR_CIS_ENERGY))
+        {
+            size_t eq_pos = line.find('=');
+            if (eq_pos != std::string_view::npos)
+            {
+                LogScanner::parse_leading_double(line.substr(eq_pos + 1), data.scftd);
+            }
+        }
+        else if (anchors & bit(ANCHOR_PCM_ENERGY))
+        {
+            size_t is_pos = line.find("is");
+            if (is_pos != std::string_view::npos)
+            {
+                LogScanner::parse_leading_double(line.substr(is_pos + 2), data.scf_equi);
+            }
+        }
+        else if (anchors & bit(ANCHOR_ZERO_POINT))
+        {
+            size_t eq_pos = line.find('=');
+            if (eq_pos != std::string_view::npos)
+            {
+                LogScanner::parse_leading_double(line.substr(eq_pos + 1), data.zpe);
+            }
+        }
+        else if (anchors & bit(ANCHOR_THERMAL_GIBBS))
+        {
+            size_t eq_pos = line.find('=');
+            if (eq_pos != std::string_view::npos)
+            {
+                LogScanner::parse_leading_double(line.substr(eq_pos + 1), data.tcg);
+            }
+        }
+        else if (anchors & bit(ANCHOR_SUM_THERMAL_FREE))
+        {
+            size_t eq_pos = line.find('=');
+            if (eq_pos != std::string_view::npos)
+            {
+                LogScanner::parse_leading_double(line.substr(eq_pos + 1), data.etg);
+            }
+        }
+        else if (anchors & bit(ANCHOR_SUM_ZERO_POINT))
+        {
+            size_t eq_pos = line.find('=');
+            if (eq_pos != std::string_view::npos)
+            {
+                LogScanner::parse_leading_double(line.substr(eq_pos + 1), data.ezpe);
+            }
+        }
+        else if (anchors & bit(ANCHOR_NUCLEAR_REPULSION))
+        {
+            size_t pos = line.find(ANCHOR_TEXT[ANCHOR_NUCLEAR_REPULSION]) + 25;
+            if (pos < line.length())
+            {
+                std::string_view num = line.substr(pos);
+                while (!num.empty() && is_blank(num.front()))
+                {
+                    num.remove_prefix(1);
+                }
+                size_t end_pos = num.find("Hartrees");
+                if (end_pos != std::string_view::npos)
+                {
+                    num = num.substr(0, end_pos);
+                }
+                num = trim_blanks(num);
+
+                if (!num.empty() && !parse_whole_double(num, data.nucleare))
+                {
+                    errors.add_warning("Could not parse nuclear repulsion energy from '" + std::string(line) +
+                                       "' in file '" + file_name + "'");
+                }
+            }
+        }
+        else if ((anchors & bit(ANCHOR_FREQUENCIES)) && parse_frequencies(line, data))
+        {
+            // Frequencies recorded by parse_frequencies()
+        }
+        else if (!context.use_input_temp && (anchors & bit(ANCHOR_TEMPERATURE)))
+        {
+            size_t start_pos = line.find("Temperature");
+            size_t end_pos   = line.find("Kelvin");
+
+            if (start_pos != std::string_view::npos && end_pos != std::string_view::npos && start_pos < end_pos)
+            {
+                start_pos += 11;  // Length of "Temperature"
+                std::string_view temp_str = trim_blanks(line.substr(start_pos, end_pos - start_pos));
+
+                if (!temp_str.empty() && !parse_whole_double(temp_str, data.temp))
+                {
+                    errors.add_warning("Could not parse temperature from '" + std::string(line) + "' in file '" +
+                                       file_name + "'. Using default 298.15 K");
+                    data.temp = 298.15;
+                }
+            }
+        }
+        else if (anchors & bit(ANCHOR_SCRF))
+        {
+            data.has_scrf = true;
+        }
+    }
+
+    /**
+     * @brief Keep the last LOG_TAIL_CHECK_BYTES bytes seen by a streaming reader
+     */
+    void append_tail(std::string& tail, const char* data, size_t size)
+    {
+        if (size >= LOG_TAIL_CHECK_BYTES)
+        {
+            tail.assign(data + size - LOG_TAIL_CHECK_BYTES, LOG_TAIL_CHECK_BYTES);
+            return;
+        }
+        tail.append(data, size);
+        if (tail.size() > LOG_TAIL_CHECK_BYTES)
+        {
+            tail.erase(0, tail.size() - LOG_TAIL_CHECK_BYTES);
+        }
+    }
+
+    /**
+     * @brief Read bytes [offset, offset + length) of an open file into out
+     */
+    void read_range(std::ifstream& file, size_t offset, size_t length, char* out, const std::string& file_name)
+    {
+        Profiler::Scope read(Profiler::Phase::READ);
+        Profiler::add(Profiler::Counter::BYTES_READ, length);
+        file.clear();
+        file.seekg(static_cast<std::streamoff>(offset));
+        file.read(out, static_cast<std::streamsize>(length));
+        if (static_cast<size_t>(file.gcount()) != length)
+        {
+            throw std::runtime_error("I/O error reading file '" + file_name + "'");
+        }
+    }
+
+    /**
+     * @brief Offset of the first line starting at or after @p nominal in a mapped log
+     */
+    uint64_t line_start_at(std::string_view content, uint64_t nominal)
+    {
+        if (nominal == 0 || nominal >= content.size())
+        {
+            return std::min<uint64_t>(nominal, content.size());
+        }
+        size_t newline = content.find('\n', static_cast<size_t>(nominal - 1));
+        return newline == std::string_view::npos ? content.size() : newline + 1;
+    }
+
+    /**
+     * @brief Offset of the first line starting at or after @p nominal, read from an open log
+     */
+    uint64_t line_start_at(std::ifstream& file, uint64_t nominal, uint64_t size, const std::string& file_name)
+    {
+        if (nominal == 0 || nominal >= size)
+        {
+            return std::min(nominal, size);
+        }
+        const size_t probe = 64 * 1024;
+        std::string  buffer(probe, '\0');
+        for (uint64_t offset = nominal - 1; offset < size; offset += probe)
+        {
+            size_t length = static_cast<size_t>(std::min<uint64_t>(probe, size - offset));
+            read_range(file, static_cast<size_t>(offset), length, &buffer[0], file_name);
+            const void* newline = std::memchr(buffer.data(), '\n', length);
+            if (newline)
+            {
+                return offset + static_cast<uint64_t>(static_cast<const char*>(newline) - buffer.data()) + 1;
+            }
+        }
+        return size;
+    }
+
+    /**
+     * @brief Marks a value of a partial state that its part did not find (parsers never produce NaN)
+     */
+    const double UNSET = std::numeric_limits<double>::quiet_NaN();
+
+    /**
+     * @brief Take @p later when its part found the value
+     */
+    inline void merge_value(double& value, double later)
+    {
+        if (!std::isnan(later))
+        {
+            value = later;
+        }
+    }
+
+    /**
+     * @brief Whether a backward window holds every section of the final job step
+     *
+     * The last SCF energy is printed after the nuclear repulsion energy of the
+     * same cycle, and a frequency job prints its harmonic frequency table
+     * before the thermochemistry, so once the window contains the table header
+     * every later anchor of that step is inside it as well.
+     */
+    bool tail_window_complete(std::string_view window, const LogScanData& data)
+    {
+        if (!data.has_scf || window.find(ANCHOR_TEXT[ANCHOR_NUCLEAR_REPULSION]) == std::string_view::npos)
+        {
+            return false;
+        }
+
+        bool has_thermochemistry = data.has_negative_freq || data.has_positive_freq ||
+                                   window.find(ANCHOR_TEXT[ANCHOR_ZERO_POINT]) != std::string_view::npos ||
+                                   window.find(ANCHOR_TEXT[ANCHOR_TEMPERATURE]) != std::string_view::npos;
+        return !has_thermochemistry || window.find(FREQUENCY_TABLE_HEADER) != std::string_view::npos;
+    }
+
+    /**
+     * @brief Whether text holds a job banner or a termination line
+     *
+     * These are the anchors whose count a tail scan takes from the header probe
+     * alone; any of them between the probe and the window changes Round or
+     * Status.
+     */
+    bool holds_step_boundary(std::string_view text)
+    {
+        return text.find(ANCHOR_TEXT[ANCHOR_COPYRIGHT]) != std::string_view::npos ||
+               text.find(ANCHOR_TEXT[ANCHOR_NORMAL_TERMINATION]) != std::string_view::npos ||
+               text.find(ANCHOR_TEXT[ANCHOR_ERROR_TERMINATION]) != std::string_view::npos;
+    }
+
+    /**
+     * @brief Whether bytes [begin, end) of a log hold a job banner or a termination line
+     *
+     * A plain substring search without line splitting or value parsing; read in
+     * chunks that overlap by the longest anchor when the log is not mapped.
+     */
+    bool middle_holds_step_boundary(const MappedFile& mapped,
+                                    std::ifstream&    file,
+                                    size_t            begin,
+                                    size_t            end,
+                                    const std::string& file_name)
+    {
+        if (begin >= end)
+        {
+            return false;
+        }
+        if (mapped.is_mapped())
+        {
+            Profiler::Scope parse(Profiler::Phase::PARSE);
+            Profiler::add(Profiler::Counter::BYTES_READ, end - begin);
+            return holds_step_boundary(mapped.view().substr(begin, end - begin));
+        }
+
+        constexpr size_t chunk_size = 1024 * 1024;
+        const size_t     overlap    = ANCHOR_TEXT[ANCHOR_NORMAL_TERMINATION].size() - 1;
+        std::string      chunk;
+        for (size_t offset = begin; offset < end;)
+        {
+            size_t length = std::min(chunk_size, end - offset);
+            chunk.resize(length);
+            read_range(file, offset, length, &chunk[0], file_name);
+            if (holds_step_boundary(chunk))
+            {
+                return true;
+            }
+            if (offset + length >= end)
+            {
+                break;
+            }
+            offset += length - std::min(overlap, length);
+        }
+        return false;
+    }
+}  // namespace
+
+// =============================================================================
+// MappedFile Implementation
+// =============================================================================
+
+MappedFile::MappedFile(const std::string& path) : data_(nullptr), size_(0), mapped_(false)
+{
+    Profiler::Scope read(Profiler::Phase::READ);
+#ifndef _WIN32
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        throw std::runtime_error("Could not open file: " + path);
+    }
+
+    struct stat st;
+    if (::fstat(fd, &st) != 0)
+    {
+        ::close(fd);
+        throw std::runtime_error("Could not stat file: " + path);
+    }
+    size_ = static_cast<size_t>(st.st_size);
+
+    bool map_allowed = size_ > 0;
+    #ifdef __linux__
+    // A job truncating its log on NFS would turn page faults into SIGBUS
+    const long NFS_MAGIC = 0x6969;
+    struct statfs fs;
+    if (map_allowed && ::fstatfs(fd, &fs) == 0 && static_cast<long>(fs.f_type) == NFS_MAGIC)
+    {
+        map_allowed = false;
+    }
+    #endif
+
+    if (map_allowed)
+    {
+        void* addr = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (addr != MAP_FAILED)
+        {
+            ::madvise(addr, size_, MADV_SEQUENTIAL);
+            data_   = static_cast<const char*>(addr);
+            mapped_ = true;
+        }
+    }
+
+    // The mapping stays valid after the descriptor is closed
+    ::close(fd);
+#else
+    std::ifstream probe(path, std::ios::binary | std::ios::ate);
+    if (!probe.is_open())
+    {
+        throw std::runtime_error("Could not open file: " + path);
+    }
+    size_ = static_cast<size_t>(probe.tellg());
+#endif
+}
+
+MappedFile::~MappedFile()
+{
+#ifndef _WIN32
+    if (mapped_)
+    {
+        ::munmap(const_cast<char*>(data_), size_);
+    }
+#endif
+}
+
+// =============================================================================
+// LogScanner Implementation
+// =============================================================================
+
+namespace LogScanner
+{
+    AnchorSet::AnchorSet(const std::vector<std::string_view>& phrases) : bigram_{}
+    {
+        if (phrases.size() > 32)
+        {
+            throw std::invalid_argument("Anchor masks are stored in 32-bit bigram entries");
+        }
+        for (unsigned i = 0; i < phrases.size(); ++i)
+        {
+            if (phrases[i].size() < 2)
+            {
+                throw std::invalid_argument("Anchor phrases need at least two bytes");
+            }
+            phrases_.emplace_back(phrases[i]);
+            bigram_[bigram_key(phrases[i].data())] |= static_cast<uint32_t>(1u << i);
+        }
+    }
+
+    unsigned AnchorSet::match_candidates(const char* p, const char* end, unsigned candidates) const
+    {
+        unsigned matched   = 0;
+        size_t   available = static_cast<size_t>(end - p);
+        for (unsigned index = 0; candidates != 0; ++index, candidates >>= 1)
+        {
+            const std::string& text = phrases_[index];
+            if ((candidates & 1u) && available >= text.size() && std::memcmp(p, text.data(), text.size()) == 0)
+            {
+                matched |= 1u << index;
+            }
+        }
+        return matched;
+    }
+
+    std::vector<std::string_view> extract_anchor_phrases()
+    {
+        return std::vector<std::string_view>(std::begin(ANCHOR_TEXT), std::end(ANCHOR_TEXT));
+    }
+
+    void AnchorSet::for_each_line(std::string_view content, const LineVisitor& visit) const
+    {
+        const char* cur   = content.data();
+        const char* end   = content.data() + content.size();
+        uint64_t    lines = 0;
+
+        while (cur < end)
+        {
+            // Find the next position where any anchor starts
+            const char* hit     = cur;
+            unsigned    anchors = 0;
+            for (; hit + 1 < end; ++hit)
+            {
+                unsigned candidates = bigram_[bigram_key(hit)];
+                if (candidates && (anchors = match_candidates(hit, end, candidates)) != 0)
+                {
+                    break;
+                }
+            }
+            if (anchors == 0)
+            {
+                break;
+            }
+
+            const char* line_start = hit;
+            while (line_start > cur && line_start[-1] != '\n')
+            {
+                --line_start;
+            }
+            const char* newline  = static_cast<const char*>(std::memchr(hit, '\n', static_cast<size_t>(end - hit)));
+            const char* line_end = newline ? newline : end;
+
+            // Collect the remaining anchors of this line
+            for (const char* p = hit + 1; p + 1 < line_end; ++p)
+            {
+                unsigned candidates = bigram_[bigram_key(p)];
+                if (candidates)
+                {
+                    anchors |= match_candidates(p, line_end, candidates);
+                }
+            }
+
+            visit(std::string_view(line_start, static_cast<size_t>(line_end - line_start)), anchors);
+            ++lines;
+
+            if (g_shutdown_requested.load(std::memory_order_relaxed))
+            {
+                throw std::runtime_error("Processing interrupted by shutdown signal");
+            }
+
+            cur = newline ? newline + 1 : end;
+        }
+        Profiler::add(Profiler::Counter::LINES_SCANNED, lines);
+    }
+
+    bool parse_leading_double(std::string_view text, double& value, size_t* consumed)
+    {
+        size_t pos = 0;
+        while (pos < text.size() && is_space(text[pos]))
+        {
+            ++pos;
+        }
+
+        size_t start = pos;
+        if (pos < text.size() && text[pos] == '+')
+        {
+            ++pos;
+            start = pos;
+        }
+        else if (pos < text.size() && text[pos] == '-')
+        {
+            ++pos;
+        }
+
+        // Require a digit or '.' so that from_chars does not accept "inf"/"nan" or a second sign
+        if (pos >= text.size() || !(is_digit(text[pos]) || text[pos] == '.'))
+        {
+            return false;
+        }
+
+        double parsed = 0.0;
+        auto   result = std::from_chars(text.data() + start, text.data() + text.size(), parsed);
+        if (result.ec != std::errc())
+        {
+            return false;
+        }
+
+        value = parsed;
+        if (consumed)
+        {
+            *consumed = static_cast<size_t>(result.ptr - text.data());
+        }
+        return true;
+    }
+
+    void scan_buffer(std::string_view          content,
+                     const std::string&        file_name,
+                     const ProcessingContext&  context,
+                     ThreadSafeErrorCollector& errors,
+                     LogScanData&              data,
+                     uint64_t                  content_offset)
+    {
+        Profiler::Scope parse(Profiler::Phase::PARSE);
+
+        // Field sets always carry the orientation anchors; they only count when geometries are written
+        const CustomFieldSet* fields      = context.custom_fields.get();
+        const unsigned        orientation = context.geometry_writer
+                                                ? bit(ANCHOR_STANDARD_ORIENTATION) | bit(ANCHOR_INPUT_ORIENTATION)
+                                                : 0u;
+        const unsigned        field_mask  = fields ? fields->anchor_mask() : 0u;
+        const AnchorSet&      anchor_set  = fields ? fields->anchors() : extract_anchors(context.geometry_writer != nullptr);
+
+        anchor_set.for_each_line(content, [&](std::string_view line, unsigned anchors) {
+            if (anchors & orientation)
+            {
+                data.has_orientation    = true;
+                data.orientation_offset = content_offset + static_cast<uint64_t>(line.data() - content.data());
+            }
+            process_line(line, anchors, file_name, context, errors, data);
+            if (anchors & field_mask)
+            {
+                fields->apply(line, anchors, data.field_values);
+            }
+        });
+    }
+
+    LogScanData scan_content(std::string_view          content,
+                             const std::string&        file_name,
+                             const ProcessingContext&  context,
+                             ThreadSafeErrorCollector& errors)
+    {
+        LogScanData data;
+        data.temp = context.base_temp;
+        scan_buffer(content, file_name, context, errors, data);
+
+        std::string_view tail =
+            content.substr(content.size() > LOG_TAIL_CHECK_BYTES ? content.size() - LOG_TAIL_CHECK_BYTES : 0);
+        data.tail_normal_termination = tail.find(ANCHOR_TEXT[ANCHOR_NORMAL_TERMINATION]) != std::string_view::npos;
+        return data;
+    }
+
+    bool tail_has_normal_termination(std::string_view content)
+    {
+        std::string_view tail =
+            content.substr(content.size() > LOG_TAIL_CHECK_BYTES ? content.size() - LOG_TAIL_CHECK_BYTES : 0);
+        return tail.find(ANCHOR_TEXT[ANCHOR_NORMAL_TERMINATION]) != std::string_view::npos;
+    }
+
+    bool tail_has_normal_termination(const std::string& path)
+    {
+        if (CompressedInput::is_compressed(path))
+        {
+            return true;
+        }
+        std::string tail = CompressedInput::read_tail(path, LOG_TAIL_CHECK_BYTES);
+        Profiler::add(Profiler::Counter::BYTES_READ, tail.size());
+        return tail_has_normal_termination(std::string_view(tail));
+    }
+
+    size_t split_part_count(uintmax_t file_size, unsigned int threads)
+    {
+        if (file_size < LOG_SPLIT_MIN_BYTES || threads < 2)
+        {
+            return 1;
+        }
+        return static_cast<size_t>(std::min<uintmax_t>(threads, file_size / LOG_SPLIT_PART_BYTES));
+    }
+
+    LogScanData scan_part(const std::string&        path,
+                          std::string_view          mapped,
+                          uint64_t                  file_size,
+                          size_t                    part,
+                          size_t                    parts,
+                          const std::string&        file_name,
+                          const ProcessingContext&  context,
+                          ThreadSafeErrorCollector& errors)
+    {
+        // Values found by this part overwrite those of earlier parts in merge_parts()
+        LogScanData data;
+        data.scftd = data.scf_equi = data.zpe = data.tcg = data.etg = data.ezpe = data.nucleare = data.temp = UNSET;
+
+        uint64_t nominal_begin = file_size * part / parts;
+        uint64_t nominal_end   = file_size * (part + 1) / parts;
+        if (!mapped.empty())
+        {
+            uint64_t begin = line_start_at(mapped, nominal_begin);
+            uint64_t end   = part + 1 == parts ? mapped.size() : line_start_at(mapped, nominal_end);
+            if (begin < end)
+            {
+                scan_buffer(mapped.substr(static_cast<size_t>(begin), static_cast<size_t>(end - begin)), file_name,
+                            context, errors, data, begin);
+            }
+            return data;
+        }
+
+        std::ifstream file(path, std::ios::binary);
+        if (!file.is_open())
+        {
+            throw std::runtime_error("Could not open file: " + path);
+        }
+        uint64_t begin = line_start_at(file, nominal_begin, file_size, file_name);
+        uint64_t end   = part + 1 == parts ? file_size : line_start_at(file, nominal_end, file_size, file_name);
+        if (begin < end)
+        {
+            std::string buffer(static_cast<size_t>(end - begin), '\0');
+            read_range(file, static_cast<size_t>(begin), buffer.size(), &buffer[0], file_name);
+            scan_buffer(buffer, file_name, context, errors, data, begin);
+        }
+        return data;
+    }
+
+    LogScanData merge_parts(const std::vector<LogScanData>& parts, const ProcessingContext& context)
+    {
+        LogScanData data;
+        data.temp = context.base_temp;
+        for (const LogScanData& part : parts)
+        {
+            data.copyright_count += part.copyright_count;
+            data.normal_count += part.normal_count;
+            data.error_count += part.error_count;
+            if (part.has_scf)
+            {
+                data.has_scf  = true;
+                data.last_scf = part.last_scf;
+            }
+            merge_value(data.scftd, part.scftd);
+            merge_value(data.scf_equi, part.scf_equi);
+            merge_value(data.zpe, part.zpe);
+            merge_value(data.tcg, part.tcg);
+            merge_value(data.etg, part.etg);
+            merge_value(data.ezpe, part.ezpe);
+            merge_value(data.nucleare, part.nucleare);
+            merge_value(data.temp, part.temp);
+
+            if (part.has_negative_freq)
+            {
+                data.has_negative_freq  = true;
+                data.last_negative_freq = part.last_negative_freq;
+            }
+            if (part.has_positive_freq)
+            {
+                data.add_frequency(part.min_positive_freq);
+            }
+            data.has_scrf = data.has_scrf || part.has_scrf;
+            if (part.has_orientation)
+            {
+                data.has_orientation    = true;
+                data.orientation_offset = part.orientation_offset;
+            }
+            if (context.custom_fields)
+            {
+                context.custom_fields->merge(data.field_values, part.field_values);
+            }
+        }
+        return data;
+    }
+
+    LogScanData scan_file(const std::string&        path,
+                          const std::string&        file_name,
+                          const ProcessingContext&  context,
+                          ThreadSafeErrorCollector& errors)
+    {
+        LogScanData data;
+        data.temp = context.base_temp;
+
+        if (!CompressedInput::is_compressed(path))
+        {
+            MappedFile mapped(path);
+            if (mapped.is_mapped())
+            {
+                Profiler::add(Profiler::Counter::BYTES_READ, mapped.size());
+                return scan_content(mapped.view(), file_name, context, errors);
+            }
+        }
+
+        // Buffered fallback: scan complete lines of each chunk, carry the partial last line over.
+        // Compressed logs always take this path and are decompressed chunk by chunk.
+        std::unique_ptr<std::istream> stream = CompressedInput::open(path);
+        std::istream&                 file   = *stream;
+        if (!file)
+        {
+            throw std::runtime_error("Could not open file: " + path);
+        }
+
+        const size_t chunk_size = 1024 * 1024;
+        std::string  buffer(chunk_size, '\0');
+        std::string  tail;
+        size_t       carry        = 0;
+        uint64_t     block_offset = 0;  // File offset of buffer[0]
+
+        while (true)
+        {
+            if (buffer.size() < carry + chunk_size)
+            {
+                buffer.resize(carry + chunk_size);
+            }
+            size_t got = 0;
+            {
+                Profiler::Scope read(Profiler::Phase::READ);
+                file.read(&buffer[carry], static_cast<std::streamsize>(chunk_size));
+                got = static_cast<size_t>(file.gcount());
+            }
+            Profiler::add(Profiler::Counter::BYTES_READ, got);
+            if (file.bad())
+            {
+                throw std::runtime_error("I/O error reading file '" + file_name + "'");
+            }
+            append_tail(tail, buffer.data() + carry, got);
+
+            std::string_view block(buffer.data(), carry + got);
+            if (got < chunk_size)
+            {
+                scan_buffer(block, file_name, context, errors, data, block_offset);
+                break;
+            }
+
+            size_t last_newline = block.rfind('\n');
+            if (last_newline == std::string_view::npos)
+            {
+                carry = block.size();  // Line longer than the buffer, keep reading
+                continue;
+            }
+
+            scan_buffer(block.substr(0, last_newline + 1), file_name, context, errors, data, block_offset);
+            block_offset += last_newline + 1;
+            carry = block.size() - (last_newline + 1);
+            std::memmove(&buffer[0], buffer.data() + last_newline + 1, carry);
+        }
+
+        data.tail_normal_termination = tail.find(ANCHOR_TEXT[ANCHOR_NORMAL_TERMINATION]) != std::string::npos;
+        return data;
+    }
+
+    LogScanData scan_file_tail(const std::string&        path,
+                               const std::string&        file_name,
+                               const ProcessingContext&  context,
+                               ThreadSafeErrorCollector& errors)
+    {
+        // A compressed log has no random access to its middle; scan it front to back
+        if (CompressedInput::is_compressed(path))
+        {
+            return scan_file(path, file_name, context, errors);
+        }
+
+        MappedFile mapped(path);
+        size_t     file_size = mapped.size();
+        if (file_size <= LOG_HEAD_PROBE_BYTES + LOG_TAIL_WINDOW_BYTES)
+        {
+            return scan_file(path, file_name, context, errors);
+        }
+
+        std::ifstream file;
+        if (!mapped.is_mapped())
+        {
+            file.open(path, std::ios::binary);
+            if (!file.is_open())
+            {
+                throw std::runtime_error("Could not open file: " + path);
+            }
+        }
+
+        // Header probe: complete lines holding the run banner and route section
+        std::string      head_buffer;
+        std::string_view head;
+        if (mapped.is_mapped())
+        {
+            head = mapped.view().substr(0, LOG_HEAD_PROBE_BYTES);
+        }
+        else
+        {
+            head_buffer.resize(LOG_HEAD_PROBE_BYTES);
+            read_range(file, 0, LOG_HEAD_PROBE_BYTES, &head_buffer[0], file_name);
+            head = head_buffer;
+        }
+
+        size_t head_newline = head.rfind('\n');
+        if (head_newline == std::string_view::npos)
+        {
+            return scan_file(path, file_name, context, errors);
+        }
+        head = head.substr(0, head_newline + 1);
+
+        LogScanData              head_data;
+        ThreadSafeErrorCollector head_errors;
+        head_data.temp = context.base_temp;
+        scan_buffer(head, file_name, context, head_errors, head_data);
+        if (head_data.copyright_count != 1)
+        {
+            return scan_file(path, file_name, context, errors);
+        }
+
+        // Backward window: double it until the final job step is complete
+        LogScanData              data;
+        ThreadSafeErrorCollector tail_errors;
+        std::string              tail_buffer;
+        std::string_view         window;
+        size_t                   window_start  = file_size;
+        size_t                   window_offset = file_size;  // File offset of the first complete line of window
+        size_t                   window_size   = LOG_TAIL_WINDOW_BYTES;
+
+        while (true)
+        {
+            if (window_size > (file_size - head.size()) / 2)
+            {
+                // The final step spans most of the file: reading backwards saves nothing
+                return scan_file(path, file_name, context, errors);
+            }
+
+            size_t new_start = file_size - window_size;
+            if (mapped.is_mapped())
+            {
+                window = mapped.view().substr(new_start);
+            }
+            else
+            {
+                std::string chunk(window_start - new_start, '\0');
+                read_range(file, new_start, chunk.size(), &chunk[0], file_name);
+                tail_buffer.insert(0, chunk);
+                window = tail_buffer;
+            }
+            window_start = new_start;
+            window_size *= 2;
+
+            // Drop the partial first line; it is scanned once the window grows
+            size_t first_newline = window.find('\n');
+            if (first_newline == std::string_view::npos)
+            {
+                continue;
+            }
+            window.remove_prefix(first_newline + 1);
+            window_offset = window_start + first_newline + 1;
+
+            data      = LogScanData();
+            data.temp = context.base_temp;
+            tail_errors.clear();
+            scan_buffer(window, file_name, context, tail_errors, data, window_start + first_newline + 1);
+
+            if (data.copyright_count > 0)
+            {
+                // A run restarted inside the log: only a full scan gives the exact Round
+                return scan_file(path, file_name, context, errors);
+            }
+            if (tail_window_complete(window, data) && (!context.geometry_writer || data.has_orientation))
+            {
+                break;
+            }
+        }
+
+        if (mapped.is_mapped())
+        {
+            // Pages touched: the header probe and the final window
+            Profiler::add(Profiler::Counter::BYTES_READ, head.size() + (file_size - window_start));
+        }
+
+        // Round and Status come from the header: prove that no step starts or ends between it and the window
+        if (middle_holds_step_boundary(mapped, file, head.size(), window_offset, file_name))
+        {
+            return scan_file(path, file_name, context, errors);
+        }
+
+        data.copyright_count = head_data.copyright_count;
+        data.normal_count += head_data.normal_count;
+        data.error_count += head_data.error_count;
+        data.has_scrf = data.has_scrf || head_data.has_scrf;
+
+        std::string_view tail =
+            window.substr(window.size() > LOG_TAIL_CHECK_BYTES ? window.size() - LOG_TAIL_CHECK_BYTES : 0);
+        data.tail_normal_termination = tail.find(ANCHOR_TEXT[ANCHOR_NORMAL_TERMINATION]) != std::string_view::npos;
+
+        for (const auto& warning : head_errors.get_warnings())
+        {
+            errors.add_warning(warning);
+        }
+        for (const auto& warning : tail_errors.get_warnings())
+        {
+            errors.add_warning(warning);
+        }
+        return data;
+    }
+
+    bool read_last_frequencies(const std::string& path, std::vector<double>& frequencies)
+    {
+        frequencies.clear();
+        const std::string_view header = FREQUENCY_TABLE_HEADER;
+
+        if (CompressedInput::is_compressed(path))
+        {
+            // No random access: stream forward, keeping the first frequency line after each header
+            Profiler::Scope read(Profiler::Phase::READ);
+            auto            stream = CompressedInput::open(path);
+            if (!*stream)
+            {
+                throw std::runtime_error("Could not open file: " + path);
+            }
+
+            std::string line;
+            std::string last_values;
+            bool        found        = false;
+            bool        after_header = false;
+            size_t      line_count   = 0;
+            uint64_t    bytes        = 0;
+            while (std::getline(*stream, line))
+            {
+                bytes += line.size() + 1;
+                if ((++line_count & 0xFFF) == 0 && g_shutdown_requested.load(std::memory_order_relaxed))
+                {
+                    throw std::runtime_error("Shutdown requested");
+                }
+
+                std::string_view values;
+                if (line.find(header) != std::string::npos)
+                {
+                    after_header = true;
+                }
+                else if (after_header && frequency_values(line, values))
+                {
+                    last_values.assign(values.data(), values.size());
+                    found        = true;
+                    after_header = false;
+                }
+            }
+            Profiler::add(Profiler::Counter::BYTES_READ, bytes);
+            if (found)
+            {
+                collect_frequencies(last_values, frequencies);
+            }
+            return found;
+        }
+
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (!file.is_open())
+        {
+            throw std::runtime_error("Could not open file: " + path);
+        }
+        const size_t file_size = static_cast<size_t>(file.tellg());
+
+        // Backward search for the last header; chunks overlap so a header across a boundary is found
+        size_t      header_offset = std::string::npos;
+        size_t      chunk_end     = file_size;
+        std::string buffer;
+        while (chunk_end > 0 && header_offset == std::string::npos)
+        {
+            if (g_shutdown_requested.load(std::memory_order_relaxed))
+            {
+                throw std::runtime_error("Shutdown requested");
+            }
+
+            size_t      chunk_start = chunk_end - std::min(chunk_end, LOG_FREQUENCY_CHUNK_BYTES);
+            std::string chunk(chunk_end - chunk_start, '\0');
+            read_range(file, chunk_start, chunk.size(), &chunk[0], path);
+            buffer = chunk + buffer.substr(0, std::min(buffer.size(), header.size() - 1));
+
+            size_t found = buffer.rfind(header);
+            if (found != std::string::npos)
+            {
+                header_offset = chunk_start + found;
+            }
+            chunk_end = chunk_start;
+        }
+        if (header_offset == std::string::npos)
+        {
+            return false;
+        }
+
+        // Forward from the header, one chunk at a time, to its first frequency line
+        std::string table;
+        size_t      line_start = 0;
+        size_t      read_end   = header_offset;
+        while (true)
+        {
+            bool   at_end = read_end >= file_size;
+            size_t eol    = table.find('\n', line_start);
+            if (eol == std::string::npos && !at_end)
+            {
+                size_t length = std::min(file_size - read_end, LOG_FREQUENCY_CHUNK_BYTES);
+                size_t old    = table.size();
+                table.resize(old + length);
+                read_range(file, read_end, length, &table[old], path);
+                read_end += length;
+                continue;
+            }
+
+            std::string_view line(table.data() + line_start,
+                                  (eol == std::string::npos ? table.size() : eol) - line_start);
+            std::string_view values;
+            if (frequency_values(line, values))
+            {
+                collect_frequencies(values, frequencies);
+                return true;
+            }
+            if (eol == std::string::npos)
+            {
+                return false;  // Truncated after the header
+            }
+            line_start = eol + 1;
+        }
+    }
+}  // namespace LogScanner
@@ -0,0 +1,437 @@
+/**
+ * @file log_scanner.h
+ * @brief Memory-mapped, regex-free single-pass scanner for Gaussian log files
+ * @author Le Nhan Pham
+ * @date 2025
+ *
+ * This header provides the fast extraction engine used by extract(). Instead of
+ * reading a log line by line with std::getline and testing every line with a
+ * series of std::string::find and std::regex_search calls, the scanner maps the
+ * file into memory and locates all anchors in a single pass over the raw bytes.
+ *
+ * @section Scanning Strategy
+ * - A 64K-entry bigram table maps the first two bytes of every anchor phrase
+ *   to a bitmask of candidate anchors, so each byte costs one table lookup
+ * - Only lines that contain at least one anchor are materialised as a
+ *   std::string_view; all other lines are skipped without being copied
+ * - Numbers are parsed in place with std::from_chars (no temporary strings)
+ * - The per-line decision ladder is identical to the legacy implementation so
+ *   both engines produce bit-identical Result values
+ *
+ * @section IO Backends
+ * - POSIX mmap() with MADV_SEQUENTIAL for local and parallel file systems
+ * - Buffered chunked reads on Windows, on NFS mounts (where a concurrently
+ *   truncated file would raise SIGBUS on a mapping) or when mmap() fails
+ *
+ * @section Tail-First Scanning
+ * ScanMode::TAIL reads a finished job backwards: the window at the end of the
+ * file doubles until it holds the last "SCF Done", the last nuclear repulsion
+ * energy and, for frequency jobs, the complete harmonic frequency and
+ * thermochemistry block. Run-level information (the "Copyright" banner and
+ * the route section with "scrf") is taken from a short probe of the file
+ * header. Everything in between is not parsed; it is only searched for a
+ * banner or a termination line (a plain substring search), since a Link1 step
+ * starting there would change Round and Status. A full scan is done instead
+ * when the two windows meet, the header does not hold exactly one banner, or
+ * the tail or the searched middle holds a banner or termination line (a
+ * multi-step or restarted run whose Round must be exact).
+ *
+ * @section Geometry
+ * When the context carries a GeometryWriter (extract --with-xyz) two more
+ * anchors, "Standard orientation:" and "Input orientation:", are searched in
+ * the same pass and the file offset of the last one is recorded, so the final
+ * geometry can be read without scanning the log again. A tail scan then also
+ * grows its window until it holds an orientation block.
+ *
+ * @section Split Scanning
+ * A log of LOG_SPLIT_MIN_BYTES or more is cut into parts at byte offsets;
+ * each part owns the lines that start inside its range, so no line is seen
+ * twice or cut. The parts are scanned by different threads (scan_part())
+ * into partial states in which every value the part did not find is left
+ * unset, and merge_parts() combines them in file order: counts add up, the
+ * last part that found a value supplies it and the smallest frequency wins,
+ * which gives the values of a scan of the whole log.
+ *
+ * @section Cross Checking
+ * ScanMode::VERIFY runs this scanner and the legacy engine on the same file and
+ * reports every differing Result field through the error collector.
+ *
+ * @section User-Defined Fields
+ * When the context carries a CustomFieldSet, its anchor set (the extract()
+ * anchors followed by the field phrases) replaces the built-in one and every
+ * line with a field phrase is handed to the set, so configured fields cost no
+ * extra pass.
+ *
+ * @section Reuse
+ * The anchor search itself is exposed as LogScanner::AnchorSet so that other
+ * modules (the high-level energy calculator) can collect their own fields in
+ * one pass with the same engine.
+ */
+
+#ifndef LOG_SCANNER_H
+#define LOG_SCANNER_H
+
+#include "extraction/gaussian_extractor.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @struct LogScanData
+ * @brief Raw values collected from a log file before corrections are applied
+ *
+ * Both the fast scanner and the legacy line reader fill this structure. The
+ * derived quantities of Result (phase-corrected Gibbs energy, kJ/mol values,
+ * job status) are computed from it afterwards, so the temperature and
+ * concentration dependent corrections live in exactly one place.
+ */
+struct LogScanData
+{
+    int    copyright_count = 0;       ///< Number of "Copyright" lines (one per job step)
+    int    normal_count    = 0;       ///< Number of "Normal termination" lines
+    int    error_count     = 0;       ///< Number of "Error termination" lines
+    bool   has_scf         = false;   ///< Whether any "SCF Done" energy was parsed
+    double last_scf        = 0.0;     ///< Last "SCF Done" energy (Hartree)
+    double scftd           = 0.0;     ///< Last CIS/TD-DFT total energy (Hartree)
+    double scf_equi        = 0.0;     ///< Last PCM-corrected energy (Hartree)
+    double zpe             = 0.0;     ///< Zero-point correction (Hartree)
+    double tcg             = 0.0;     ///< Thermal correction to Gibbs free energy (Hartree)
+    double etg             = 0.0;     ///< Sum of electronic and thermal free energies (Hartree)
+    double ezpe            = 0.0;     ///< Sum of electronic and zero-point energies (Hartree)
+    double nucleare        = 0.0;     ///< Nuclear repulsion energy (Hartree)
+    double temp            = 298.15;  ///< Temperature used for corrections (K)
+
+    bool   has_negative_freq  = false;  ///< Whether an imaginary frequency was seen
+    double last_negative_freq = 0.0;    ///< Last negative frequency (cm⁻¹)
+    bool   has_positive_freq  = false;  ///< Whether a real frequency was seen
+    double min_positive_freq  = 0.0;    ///< Smallest non-negative frequency (cm⁻¹)
+
+    bool has_scrf                = false;  ///< Whether the route contains "scrf"
+    bool tail_normal_termination = false;  ///< "Normal termination" within the last 2 KB
+
+    bool     has_orientation    = false;  ///< Whether an orientation block was seen (geometry scans only)
+    uint64_t orientation_offset = 0;      ///< File offset of the last "Standard/Input orientation:" line
+
+    std::vector<std::string> field_values;  ///< Values of the user-defined fields (see CustomFieldSet)
+
+    /**
+     * @brief Record one vibrational frequency
+     * @param freq Frequency in cm⁻¹ (negative for imaginary modes)
+     */
+    void add_frequency(double freq)
+    {
+        if (freq < 0)
+        {
+            has_negative_freq  = true;
+            last_negative_freq = freq;
+        }
+        else if (!has_positive_freq || freq < min_positive_freq)
+        {
+            has_positive_freq = true;
+            min_positive_freq = freq;
+        }
+    }
+};
+
+/**
+ * @brief Number of trailing bytes inspected for the final "Normal termination"
+ */
+const size_t LOG_TAIL_CHECK_BYTES = 2048;
+
+/**
+ * @brief Bytes read from the start of a log for the run banner and route section
+ */
+const size_t LOG_HEAD_PROBE_BYTES = 64 * 1024;
+
+/**
+ * @brief Initial size of the backward window of the tail-first scanner
+ */
+const size_t LOG_TAIL_WINDOW_BYTES = 64 * 1024;
+
+/**
+ * @brief Chunk size of the backward search for the last frequency table
+ */
+const size_t LOG_FREQUENCY_CHUNK_BYTES = 16 * 1024;
+
+/**
+ * @brief Logs at least this large are split into parts scanned by several threads
+ */
+const size_t LOG_SPLIT_MIN_BYTES = 128 * 1024 * 1024;
+
+/**
+ * @brief Target size of one part of a split log
+ */
+const size_t LOG_SPLIT_PART_BYTES = 32 * 1024 * 1024;
+
+/**
+ * @class MappedFile
+ * @brief Read-only view of a whole file, memory-mapped when possible
+ *
+ * RAII wrapper that maps a file with mmap() and unmaps it on destruction.
+ * When mapping is not possible or not advisable (Windows, NFS, empty files,
+ * mmap() failure) is_mapped() returns false and callers are expected to fall
+ * back to buffered reads of the same path.
+ */
+class MappedFile
+{
+public:
+    /**
+     * @brief Map the given file read-only
+     * @param path Path to the file
+     * @throws std::runtime_error if the file cannot be opened
+     */
+    explicit MappedFile(const std::string& path);
+
+    /**
+     * @brief Unmap the file
+     */
+    ~MappedFile();
+
+    MappedFile(const MappedFile&)            = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /**
+     * @brief Whether the file content is available through view()
+     */
+    bool is_mapped() const
+    {
+        return mapped_;
+    }
+
+    /**
+     * @brief File size in bytes at the time of opening
+     */
+    size_t size() const
+    {
+        return size_;
+    }
+
+    /**
+     * @brief Mapped file content (empty when not mapped)
+     */
+    std::string_view view() const
+    {
+        return mapped_ ? std::string_view(data_, size_) : std::string_view();
+    }
+
+private:
+    const char* data_;    ///< Start of the mapping
+    size_t      size_;    ///< Length of the mapping in bytes
+    bool        mapped_;  ///< Whether data_ refers to a live mapping
+};
+
+/**
+ * @namespace LogScanner
+ * @brief Single-pass anchor scanner behind ScanMode::FAST
+ */
+namespace LogScanner
+{
+    /**
+     * @class AnchorSet
+     * @brief Compiled set of literal anchor phrases searched in one pass
+     *
+     * Up to 32 phrases of at least two bytes each. A 64K-entry bigram table maps
+     * the first two bytes of every phrase to a bitmask of candidates, so lines
+     * without any anchor cost one table lookup per byte and are never copied.
+     * Construct once (typically as a function-local static) and share between
+     * threads; for_each_line() is const and keeps no state.
+     */
+    class AnchorSet
+    {
+    public:
+        /**
+         * @brief Callback receiving one line and the bitmask of anchors it contains
+         *
+         * Bit i is set when phrase i occurs anywhere in the line. The line excludes
+         * its terminating '\n'.
+         */
+        using LineVisitor = std::function<void(std::string_view line, unsigned anchors)>;
+
+        /**
+         * @brief Compile a set of phrases
+         * @param phrases Anchor phrases; bit i of a visitor mask refers to phrases[i]
+         * @throws std::invalid_argument if there are more than 32 phrases or one is shorter than two bytes
+         */
+        explicit AnchorSet(const std::vector<std::string_view>& phrases);
+
+        /**
+         * @brief Call @p visit for every line of @p content holding at least one anchor
+         * @param content Buffer of complete lines (the last line may lack a newline)
+         * @param visit Callback invoked in line order
+         * @throws std::runtime_error if shutdown is requested while scanning
+         */
+        void for_each_line(std::string_view content, const LineVisitor& visit) const;
+
+        /**
+         * @brief Phrase behind bit @p index of a visitor mask
+         */
+        std::string_view phrase(unsigned index) const
+        {
+            return phrases_[index];
+        }
+
+    private:
+        unsigned match_candidates(const char* p, const char* end, unsigned candidates) const;
+
+        std::vector<std::string>    phrases_;  ///< Anchor phrases in bit order
+        std::array<uint32_t, 65536> bigram_;   ///< First two bytes -> candidate phrase mask
+    };
+
+    /**
+     * @brief Phrases of the extract() anchors: the decision ladder, then the two orientation anchors
+     *
+     * A CustomFieldSet compiles these first, so bits 0-15 of its masks mean
+     * what they mean in the built-in scan.
+     */
+    std::vector<std::string_view> extract_anchor_phrases();
+
+    /**
+     * @brief Scan a log file and collect raw extraction values
+     * @param path Path to the log file
+     * @param file_name Display name used in warnings
+     * @param context Processing context (temperature options)
+     * @param errors Collector receiving parse warnings
+     * @return Raw values for building a Result
+     * @throws std::runtime_error if the file cannot be read or shutdown is requested
+     */
+    LogScanData scan_file(const std::string&        path,
+                          const std::string&        file_name,
+                          const ProcessingContext&  context,
+                          ThreadSafeErrorCollector& errors);
+
+    /**
+     * @brief Scan the final job step of a log file, reading backwards from the end
+     * @param path Path to the log file
+     * @param file_name Display name used in warnings
+     * @param context Processing context (temperature options)
+     * @param errors Collector receiving parse warnings
+     * @return Raw values for building a Result
+     * @throws std::runtime_error if the file cannot be read or shutdown is requested
+     *
+     * Values from job steps that lie entirely between the header probe and
+     * the tail window (frequencies of an earlier freq step, earlier error
+     * terminations) are not seen. Falls back to scan_file() whenever the tail
+     * window is incomplete or the run count cannot be established.
+     */
+    LogScanData scan_file_tail(const std::string&        path,
+                               const std::string&        file_name,
+                               const ProcessingContext&  context,
+                               ThreadSafeErrorCollector& errors);
+
+    /**
+     * @brief Scan an in-memory buffer holding complete log lines
+     * @param content Buffer to scan (the last line may lack a newline)
+     * @param file_name Display name used in warnings
+     * @param context Processing context (temperature options; a geometry_writer enables orientation anchors)
+     * @param errors Collector receiving parse warnings
+     * @param data Accumulator updated with every anchor found
+     * @param content_offset File offset of content[0], used for LogScanData::orientation_offset
+     */
+    void scan_buffer(std::string_view          content,
+                     const std::string&        file_name,
+                     const ProcessingContext&  context,
+                     ThreadSafeErrorCollector& errors,
+                     LogScanData&              data,
+                     uint64_t                  content_offset = 0);
+
+    /**
+     * @brief Scan the complete content of a log that is already in memory
+     * @param content Whole log (mapped or read by the caller)
+     * @param file_name Display name used in warnings
+     * @param context Processing context (temperature options; a geometry_writer enables orientation anchors)
+     * @param errors Collector receiving parse warnings
+     * @return Raw values for building a Result, as scan_file() returns them
+     * @throws std::runtime_error if shutdown is requested
+     */
+    LogScanData scan_content(std::string_view          content,
+                             const std::string&        file_name,
+                             const ProcessingContext&  context,
+                             ThreadSafeErrorCollector& errors);
+
+    /**
+     * @brief Whether the last LOG_TAIL_CHECK_BYTES of a log hold "Normal termination"
+     * @param path Path to the log file
+     * @return true also for compressed logs, whose tail costs a decompression of the whole stream
+     * @throws std::runtime_error if the file cannot be opened
+     *
+     * A log without it cannot have status DONE, so filters that keep finished
+     * jobs only skip its scan (see ResultFilter::needs_normal_termination()).
+     */
+    bool tail_has_normal_termination(const std::string& path);
+
+    /**
+     * @brief Whether a log in memory ends in "Normal termination" (see the file overload)
+     */
+    bool tail_has_normal_termination(std::string_view content);
+
+    /**
+     * @brief Number of parts a log is split into for scanning by several threads
+     * @param file_size Size of the log in bytes
+     * @param threads Threads available to the scan
+     * @return 1 when the log is scanned whole (smaller than LOG_SPLIT_MIN_BYTES or one thread)
+     */
+    size_t split_part_count(uintmax_t file_size, unsigned int threads);
+
+    /**
+     * @brief Scan the lines starting in one part of a split log
+     * @param path Path to the (uncompressed) log file
+     * @param mapped Whole log when mapped; empty to read the part from @p path
+     * @param file_size Size of the log in bytes
+     * @param part Zero-based part
+     * @param parts Number of parts (split_part_count())
+     * @param file_name Display name used in warnings
+     * @param context Processing context (as for scan_file())
+     * @param errors Collector receiving parse warnings
+     * @return Partial state for merge_parts(); values not found in the part are unset
+     * @throws std::runtime_error if the part cannot be read or shutdown is requested
+     */
+    LogScanData scan_part(const std::string&        path,
+                          std::string_view          mapped,
+                          uint64_t                  file_size,
+                          size_t                    part,
+                          size_t                    parts,
+                          const std::string&        file_name,
+                          const ProcessingContext&  context,
+                          ThreadSafeErrorCollector& errors);
+
+    /**
+     * @brief Combine the partial states of all parts of a log, in file order
+     * @param parts Result of scan_part() for every part
+     * @param context Processing context (defaults for values no part found)
+     * @return The values a scan of the whole log gives, except tail_normal_termination
+     */
+    LogScanData merge_parts(const std::vector<LogScanData>& parts, const ProcessingContext& context);
+
+    /**
+     * @brief Parse a floating point number in place, strtod-style
+     * @param text Text starting with optional whitespace and a number
+     * @param value Receives the parsed number; untouched on failure
+     * @param consumed Optional; receives the number of characters used
+     * @return true if a number was parsed
+     *
+     * Mirrors the prefix semantics of std::stod (leading whitespace and an
+     * optional '+' sign are accepted) without allocating a std::string.
+     */
+    bool parse_leading_double(std::string_view text, double& value, size_t* consumed = nullptr);
+
+    /**
+     * @brief Read the first "Frequencies --" line of the last vibrational analysis
+     * @param path Path to the log file (compressed logs are accepted)
+     * @param frequencies Receives the values of that line, lowest modes first
+     * @return true if the log holds a frequency table
+     * @throws std::runtime_error if the file cannot be read or shutdown is requested
+     *
+     * Gaussian prints the modes of a table in ascending order, so the first
+     * line carries every imaginary mode that fits its columns. An uncompressed
+     * log is searched backwards from its end for the last "Harmonic
+     * frequencies" header in LOG_FREQUENCY_CHUNK_BYTES steps and only the lines
+     * after it are read; a compressed log is streamed once, holding one line.
+     */
+    bool read_last_frequencies(const std::string& path, std::vector<double>& frequencies);
+}  // namespace LogScanner
+
+#endif  // LOG_SCANNER_H
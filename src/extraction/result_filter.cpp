@@ -0,0 +1,382 @@
+/**
+ * @file result_filter.cpp
+ * @brief Implementation of the --where row filter
+ * @author Le Nhan Pham
+ * @date 2025
+ */
+
+#include "result_filter.h"
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstdlib>
+
+namespace
+{
+    /**
+     * @brief Column names accepted by --where and --sort, indexed by column number - 1
+     */
+    const char* const COLUMN_NAMES[] = {"name", "etg", "lf", "gibbs", "nuclear", "scf", "zpe", "status", "pcorr",
+                                        "round"};
+
+    const int COLUMN_COUNT = sizeof(COLUMN_NAMES) / sizeof(COLUMN_NAMES[0]);
+
+    std::string trim(const std::string& text)
+    {
+        size_t begin = text.find_first_not_of(" \t");
+        if (begin == std::string::npos)
+        {
+            return std::string();
+        }
+        size_t end = text.find_last_not_of(" \t\r");
+        return text.substr(begin, end - begin + 1);
+    }
+
+    std::string upper(std::string text)
+    {
+        std::transform(text.begin(), text.end(), text.begin(), [](unsigned char c) {
+            return static_cast<char>(std::toupper(c));
+        });
+        return text;
+    }
+
+    /**
+     * @brief Whole-string number (leading and trailing blanks are not accepted)
+     */
+    bool parse_number(const std::string& text, double& value)
+    {
+        if (text.empty())
+        {
+            return false;
+        }
+        char* end = nullptr;
+        errno     = 0;
+        value     = std::strtod(text.c_str(), &end);
+        return errno == 0 && end == text.c_str() + text.size();
+    }
+
+    /**
+     * @brief Match @p text against a pattern where * is any run and ? any one character
+     */
+    bool glob_match(const std::string& pattern, const std::string& text)
+    {
+        size_t p = 0, t = 0;
+        size_t star = std::string::npos, resume = 0;
+        while (t < text.size())
+        {
+            if (p < pattern.size() && (pattern[p] == '?' || pattern[p] == text[t]))
+            {
+                ++p;
+                ++t;
+            }
+            else if (p < pattern.size() && pattern[p] == '*')
+            {
+                star   = p++;
+                resume = t;
+            }
+            else if (star != std::string::npos)
+            {
+                p = star + 1;
+                t = ++resume;
+            }
+            else
+            {
+                return false;
+            }
+        }
+        while (p < pattern.size() && pattern[p] == '*')
+        {
+            ++p;
+        }
+        return p == pattern.size();
+    }
+}  // namespace
+
+int ResultFilter::column_number(const std::string& name)
+{
+    std::string key = trim(name);
+    if (!key.empty() && std::all_of(key.begin(), key.end(), [](unsigned char c) {
+            return std::isdigit(c);
+        }))
+    {
+        int column = key.size() <= 2 ? std::atoi(key.c_str()) : 0;
+        return column >= 1 && column <= COLUMN_COUNT ? column : 0;
+    }
+
+    std::transform(key.begin(), key.end(), key.begin(), [](unsigned char c) {
+        return static_cast<char>(std::tolower(c));
+    });
+    for (int column = 0; column < COLUMN_COUNT; ++column)
+    {
+        if (key == COLUMN_NAMES[column])
+        {
+            return column + 1;
+        }
+    }
+    return 0;
+}
+
+bool ResultFilter::parse_predicate(const std::string& term, Predicate& predicate, std::string& error)
+{
+    size_t op_pos = term.find_first_of("<>=!");
+    if (op_pos == std::string::npos || op_pos == 0)
+    {
+        error = "'" + term + "' is not <column><op><value>";
+        return false;
+    }
+
+    size_t op_end = op_pos + 1;
+    char   first  = term[op_pos];
+    bool   equals = op_end < term.size() && term[op_end] == '=';
+    switch (first)
+    {
+        case '<':
+            predicate.op = equals ? Op::LESS_EQUAL : Op::LESS;
+            break;
+        case '>':
+            predicate.op = equals ? Op::GREATER_EQUAL : Op::GREATER;
+            break;
+        case '=':
+            predicate.op = Op::EQUAL;
+            break;
+        default:
+            if (!equals)
+            {
+                error = "'" + term + "' uses '!' without '='";
+                return false;
+            }
+            predicate.op = Op::NOT_EQUAL;
+            break;
+    }
+    if (equals)
+    {
+        ++op_end;
+    }
+
+    std::string column = trim(term.substr(0, op_pos));
+    predicate.text     = trim(term.substr(op_end));
+    if (column.empty() || predicate.text.empty())
+    {
+        error = "'" + term + "' is not <column><op><value>";
+        return false;
+    }
+    predicate.numeric = parse_number(predicate.text, predicate.number);
+
+    bool equality    = predicate.op == Op::EQUAL || predicate.op == Op::NOT_EQUAL;
+    predicate.column = column_number(column);
+    switch (predicate.column)
+    {
+        case 0:
+            predicate.field = column;
+            break;
+
+        case 1:
+            break;
+
+        case 8:
+            predicate.text = upper(predicate.text);
+            if (!equality || (predicate.text != "DONE" && predicate.text != "UNDONE" && predicate.text != "ERROR"))
+            {
+                error = "'" + term + "': status takes = or != with DONE, UNDONE or ERROR";
+                return false;
+            }
+            break;
+
+        case 9:
+            predicate.text = upper(predicate.text);
+            if (!equality || (predicate.text != "YES" && predicate.text != "NO"))
+            {
+                error = "'" + term + "': pcorr takes = or != with YES or NO";
+                return false;
+            }
+            break;
+
+        default:
+            if (!predicate.numeric)
+            {
+                error = "'" + term + "': " + COLUMN_NAMES[predicate.column - 1] + " is compared with a number";
+                return false;
+            }
+            break;
+    }
+    return true;
+}
+
+bool ResultFilter::add(const std::string& expression, std::string& error)
+{
+    std::vector<Predicate> parsed;
+    size_t                 start = 0;
+    while (start <= expression.size())
+    {
+        size_t      comma = expression.find(',', start);
+        std::string term  = trim(expression.substr(start, comma == std::string::npos ? std::string::npos
+                                                                                     : comma - start));
+        if (!term.empty())
+        {
+            Predicate predicate;
+            if (!parse_predicate(term, predicate, error))
+            {
+                return false;
+            }
+            parsed.push_back(std::move(predicate));
+        }
+        if (comma == std::string::npos)
+        {
+            break;
+        }
+        start = comma + 1;
+    }
+
+    if (parsed.empty())
+    {
+        error = "empty filter expression";
+        return false;
+    }
+    predicates_.insert(predicates_.end(), parsed.begin(), parsed.end());
+    expressions_.push_back(trim(expression));
+    return true;
+}
+
+bool ResultFilter::bind(const std::vector<ColumnarWriter::Column>& fields, std::string& error)
+{
+    for (auto& predicate : predicates_)
+    {
+        if (predicate.column != 0)
+        {
+            continue;
+        }
+        auto it = std::find_if(fields.begin(), fields.end(), [&predicate](const ColumnarWriter::Column& column) {
+            return column.name == predicate.field;
+        });
+        if (it == fields.end())
+        {
+            error = "unknown column '" + predicate.field + "' in --where";
+            return false;
+        }
+        predicate.field_index = static_cast<size_t>(it - fields.begin());
+    }
+    return true;
+}
+
+template <typename T>
+bool ResultFilter::compare(const T& value, Op op, const T& reference)
+{
+    switch (op)
+    {
+        case Op::LESS:
+            return value < reference;
+        case Op::LESS_EQUAL:
+            return value <= reference;
+        case Op::GREATER:
+            return value > reference;
+        case Op::GREATER_EQUAL:
+            return value >= reference;
+        case Op::EQUAL:
+            return value == reference;
+        case Op::NOT_EQUAL:
+        default:
+            return value != reference;
+    }
+}
+
+bool ResultFilter::matches(const Result& result) const
+{
+    for (const auto& predicate : predicates_)
+    {
+        bool pass = false;
+        switch (predicate.column)
+        {
+            case 0:
+            {
+                if (predicate.field_index >= result.field_values.size())
+                {
+                    return false;
+                }
+                const std::string& value = result.field_values[predicate.field_index];
+                double             number;
+                if (value.empty())
+                {
+                    return false;
+                }
+                if (predicate.numeric && parse_number(value, number))
+                {
+                    pass = compare(number, predicate.op, predicate.number);
+                }
+                else if (predicate.op == Op::EQUAL || predicate.op == Op::NOT_EQUAL)
+                {
+                    pass = glob_match(predicate.text, value) == (predicate.op == Op::EQUAL);
+                }
+                else
+                {
+                    pass = compare(value, predicate.op, predicate.text);
+                }
+                break;
+            }
+            case 1:
+                if (predicate.op == Op::EQUAL || predicate.op == Op::NOT_EQUAL)
+                {
+                    pass = glob_match(predicate.text, result.file_name) == (predicate.op == Op::EQUAL);
+                }
+                else
+                {
+                    pass = compare(result.file_name, predicate.op, predicate.text);
+                }
+                break;
+            case 2:
+                pass = compare(result.etgkj, predicate.op, predicate.number);
+                break;
+            case 3:
+                pass = compare(result.lf, predicate.op, predicate.number);
+                break;
+            case 4:
+                pass = compare(result.GibbsFreeHartree, predicate.op, predicate.number);
+                break;
+            case 5:
+                pass = compare(result.nucleare, predicate.op, predicate.number);
+                break;
+            case 6:
+                pass = compare(result.scf, predicate.op, predicate.number);
+                break;
+            case 7:
+                pass = compare(result.zpe, predicate.op, predicate.number);
+                break;
+            case 8:
+                pass = compare(std::string(resultStatusName(result.status)), predicate.op, predicate.text);
+                break;
+            case 9:
+                pass = compare(std::string(result.phaseCorr ? "YES" : "NO"), predicate.op, predicate.text);
+                break;
+            case 10:
+                pass = compare(static_cast<double>(result.copyright_count), predicate.op, predicate.number);
+                break;
+            default:
+                break;
+        }
+        if (!pass)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool ResultFilter::needs_normal_termination() const
+{
+    return std::any_of(predicates_.begin(), predicates_.end(), [](const Predicate& predicate) {
+        return predicate.column == 8 && predicate.op == Op::EQUAL && predicate.text == "DONE";
+    });
+}
+
+std::string ResultFilter::describe() const
+{
+    std::string text;
+    for (const auto& expression : expressions_)
+    {
+        if (!text.empty())
+        {
+            text += ", ";
+        }
+        text += expression;
+    }
+    return text;
+}
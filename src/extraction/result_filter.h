@@ -0,0 +1,140 @@
+/**
+ * @file result_filter.h
+ * @brief Row predicates of extract --where, evaluated as each log is scanned
+ * @author Le Nhan Pham
+ * @date 2025
+ *
+ * This header provides the filter that decides which results reach the
+ * results table. Rows are tested in the worker that scanned the log, so
+ * rejected results are never collected, sorted or formatted.
+ *
+ * @section Expression Syntax
+ * An expression is a comma-separated list of predicates "<column><op><value>";
+ * all predicates of all --where options must hold (logical AND):
+ * - column: a results table column by number (1-10) or name (name, etg, lf,
+ *   gibbs, nuclear, scf, zpe, status, pcorr, round), or the name of a
+ *   user-defined field (see CustomFieldSet)
+ * - op: <, <=, >, >=, = (also ==) or !=
+ * - value: a number for the numeric columns; DONE, UNDONE or ERROR for status;
+ *   YES or NO for pcorr; a pattern with * and ? for name
+ *
+ * Example:
+ * @code
+ * --where "lf<0"                      # transition states
+ * --where "status=DONE,etg<-1000000"  # finished jobs below an energy
+ * --where "name=ts-*"                 # logs whose name starts with ts-
+ * @endcode
+ *
+ * User-defined fields compare as numbers when both sides are numbers and as
+ * text (with * and ? for = and !=) otherwise; a field without a value never
+ * matches.
+ */
+
+#ifndef RESULT_FILTER_H
+#define RESULT_FILTER_H
+
+#include "extraction/gaussian_extractor.h"
+#include "utilities/columnar_writer.h"
+#include <string>
+#include <vector>
+
+/**
+ * @class ResultFilter
+ * @brief Conjunction of --where predicates over the results table columns
+ *
+ * Built once before extract runs and shared read-only by the worker threads.
+ */
+class ResultFilter
+{
+public:
+    /**
+     * @brief Add the predicates of one --where expression
+     * @param expression Comma-separated predicates (see the file documentation)
+     * @param error Receives a message when the expression is invalid
+     * @return false if the expression is invalid; no predicate of it is added
+     *
+     * Names that are not results table columns are kept for bind().
+     */
+    bool add(const std::string& expression, std::string& error);
+
+    /**
+     * @brief Resolve predicates on user-defined fields
+     * @param fields User-defined field columns of the run, in Result::field_values order
+     * @param error Receives a message naming the first unknown column
+     * @return false if a predicate names neither a results column nor a field
+     */
+    bool bind(const std::vector<ColumnarWriter::Column>& fields, std::string& error);
+
+    /**
+     * @brief Whether no predicate was added (every result matches)
+     */
+    bool empty() const
+    {
+        return predicates_.empty();
+    }
+
+    /**
+     * @brief Whether a result passes every predicate
+     */
+    bool matches(const Result& result) const;
+
+    /**
+     * @brief Whether only logs with status DONE can match
+     *
+     * Such logs end in "Normal termination", so extract() can reject the rest
+     * from the last LOG_TAIL_CHECK_BYTES without scanning them.
+     */
+    bool needs_normal_termination() const;
+
+    /**
+     * @brief The expressions as given, joined with ", "
+     */
+    std::string describe() const;
+
+    /**
+     * @brief Results table column of a name or number
+     * @param name Column number (1-10) or name (see the file documentation)
+     * @return Column number; 0 if @p name is neither
+     */
+    static int column_number(const std::string& name);
+
+private:
+    /**
+     * @enum Op
+     * @brief Comparison of a predicate
+     */
+    enum class Op
+    {
+        LESS,
+        LESS_EQUAL,
+        GREATER,
+        GREATER_EQUAL,
+        EQUAL,
+        NOT_EQUAL
+    };
+
+    /**
+     * @struct Predicate
+     * @brief One "<column><op><value>" term
+     */
+    struct Predicate
+    {
+        int         column = 0;       ///< Results table column (1-10); 0 for a user-defined field
+        std::string field;            ///< Name of the user-defined field (column == 0)
+        size_t      field_index = 0;  ///< Position in Result::field_values, set by bind()
+        Op          op = Op::EQUAL;   ///< Comparison
+        std::string text;             ///< Value as written (status and pcorr upper-cased)
+        double      number = 0.0;     ///< Value as a number, when it is one
+        bool        numeric = false;  ///< Whether text is a number
+    };
+
+    static bool parse_predicate(const std::string& term, Predicate& predicate, std::string& error);
+
+    template <typename T>
+    static bool compare(const T& value, Op op, const T& reference);
+
+    std::vector<Predicate>   predicates_;   ///< All predicates, ANDed
+    std::vector<std::string> expressions_;  ///< Expressions as given, for describe()
+};
+
+#endif  // RESULT_FILTER_H
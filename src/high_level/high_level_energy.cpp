@@ -1,18 +1,29 @@
 #include "high_level_energy.h"
 #include "extraction/gaussian_extractor.h"
+#include "extraction/log_scanner.h"
+#include "utilities/columnar_writer.h"
+#include "utilities/compressed_input.h"
 #include "utilities/metadata.h"
+#include "utilities/profiler.h"
+#include "utilities/result_index.h"
+#include "utilities/task_executor.h"
+#include "utilities/utils.h"
 #include <algorithm>
+#include <array>
 #include <atomic>
 #include <chrono>
 #include <cmath>
+#include <cstdint>
 #include <exception>
 #include <filesystem>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <list>
 #include <mutex>
 #include <regex>
 #include <sstream>
+#include <string_view>
 #include <thread>
 #include <unordered_map>
 #include <vector>
@@ -27,85 +38,6 @@
     #include <unistd.h>
 #endif
 
-// =============================================================================
-// ThreadPool Implementation
-// =============================================================================
-
-/**
- * @brief ThreadPool constructor implementation
- */
-ThreadPool::ThreadPool(size_t num_threads)
-{
-    for (size_t i = 0; i < num_threads; ++i)
-    {
-        workers_.emplace_back([this] {
-            for (;;)
-            {
-                std::function<void()> task;
-
-                {
-                    std::unique_lock<std::mutex> lock(queue_mutex_);
-                    condition_.wait(lock, [this] {
-                        return stop_flag_ || !tasks_.empty();
-                    });
-
-                    if (stop_flag_ && tasks_.empty())
-                    {
-                        return;
-                    }
-
-                    task = std::move(tasks_.front());
-                    tasks_.pop();
-                }
-
-                active_tasks_.fetch_add(1);
-                try
-                {
-                    task();
-                }
-                catch (...)
-                {
-                    // Task exceptions are handled by the future mechanism
-                }
-                active_tasks_.fetch_sub(1);
-            }
-        });
-    }
-}
-
-/**
- * @brief ThreadPool destructor implementation
- */
-ThreadPool::~ThreadPool()
-{
-    {
-        std::unique_lock<std::mutex> lock(queue_mutex_);
-        stop_flag_.store(true);
-    }
-    condition_.notify_all();
-
-    for (std::thread& worker : workers_)
-    {
-        if (worker.joinable())
-        {
-            worker.join();
-        }
-    }
-}
-
-// Template method implementation moved to header file for proper instantiation
-
-/**
- * @brief Wait for all tasks to complete implementation
- */
-void ThreadPool::wait_for_completion()
-{
-    while (active_tasks_.load() > 0 || !tasks_.empty())
-    {
-        std::this_thread::sleep_for(std::chrono::milliseconds(10));
-    }
-}
-
 // =============================================================================
 // Pre-compiled Regex Patterns for Performance
 // =============================================================================
@@ -142,66 +74,502 @@ private:
 // File Content Cache for Reducing I/O
 // =============================================================================
 
+/**
+ * @brief Sharded, byte-bounded LRU cache of whole file contents
+ *
+ * Files are spread over independently locked shards by path hash. The byte
+ * budget is shared by all shards: once it is exceeded, the least recently used
+ * entries are evicted from whichever shard holds them, one shard lock at a
+ * time. A file larger than a quarter of the budget is handed out uncached (and
+ * counted as such), since caching it would evict most of the other logs. Files
+ * are read outside the shard lock, so concurrent misses on different files
+ * never wait for each other's I/O. Hits hand out a shared handle to immutable
+ * content instead of a copy; evicted content stays alive until the last handle
+ * is released.
+ *
+ * When a MemoryMonitor is attached, cached bytes are charged to it, and a
+ * file is only cached after the shard has evicted enough to fit the monitor's
+ * limit.
+ */
 class FileContentCache
 {
-private:
-    mutable std::unordered_map<std::string, std::string> cache_;
-    mutable std::mutex                                   cache_mutex_;
-    size_t                                               max_cache_size_mb_;
-    size_t                                               current_size_bytes_;
-
 public:
-    FileContentCache(size_t max_cache_mb = 500) : max_cache_size_mb_(max_cache_mb), current_size_bytes_(0) {}
+    using Handle = std::shared_ptr<const std::string>;
+
+    /**
+     * @brief Cache counters since the last clear()
+     */
+    struct Stats
+    {
+        size_t hits      = 0;  ///< Lookups served from the cache
+        size_t misses    = 0;  ///< Lookups that read the file
+        size_t evictions = 0;  ///< Entries dropped to stay within budget
+        size_t oversized = 0;  ///< Files read but not cached because they exceed max_entry_bytes()
+        size_t bytes     = 0;  ///< Bytes currently cached
+    };
+
+    explicit FileContentCache(size_t max_cache_mb = 500)
+        : budget_(max_cache_mb * 1024 * 1024), bytes_(0), clock_(0), hits_(0), misses_(0), evictions_(0),
+          oversized_(0)
+    {}
 
-    std::string get_or_read(const std::string& filename)
+    /**
+     * @brief Largest file that is cached; larger files are read for each use
+     */
+    size_t max_entry_bytes() const
     {
-        std::lock_guard<std::mutex> lock(cache_mutex_);
+        return budget_ / 4;
+    }
+
+    ~FileContentCache()
+    {
+        clear();
+    }
+
+    /**
+     * @brief Charge cached bytes to a memory monitor (nullptr to detach)
+     */
+    void attach_memory_monitor(std::shared_ptr<MemoryMonitor> monitor)
+    {
+        clear();
+        std::lock_guard<std::mutex> lock(monitor_mutex_);
+        monitor_ = std::move(monitor);
+    }
 
-        auto it = cache_.find(filename);
-        if (it != cache_.end())
+    /**
+     * @brief Return the content of a file, reading it on a miss
+     * @param filename Path to the file
+     * @return Shared handle to the content, or nullptr if the file cannot be read
+     */
+    Handle get_or_read(const std::string& filename)
+    {
+        Shard& shard = shard_for(filename);
         {
-            return it->second;
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            auto                        it = shard.entries.find(filename);
+            if (it != shard.entries.end())
+            {
+                shard.lru.splice(shard.lru.begin(), shard.lru, it->second.lru_position);
+                it->second.last_use = ++clock_;
+                hits_++;
+                Profiler::add(Profiler::Counter::CACHE_HITS);
+                return it->second.content;
+            }
         }
+        misses_++;
+        Profiler::add(Profiler::Counter::CACHE_MISSES);
 
-        // Read file
-        std::ifstream file(filename, std::ios::binary | std::ios::ate);
-        if (!file.is_open())
+        // Read without holding the shard lock
+        Profiler::Scope read(Profiler::Phase::READ);
+        std::string     buffer;
+        if (CompressedInput::is_compressed(filename))
         {
-            return "";
+            try
+            {
+                buffer = CompressedInput::read_all(filename);
+            }
+            catch (const std::runtime_error&)
+            {
+                return nullptr;
+            }
         }
+        else
+        {
+            std::ifstream file(filename, std::ios::binary | std::ios::ate);
+            if (!file.is_open())
+            {
+                return nullptr;
+            }
+            auto file_size = file.tellg();
+            file.seekg(0, std::ios::beg);
 
-        auto file_size = file.tellg();
-        file.seekg(0, std::ios::beg);
+            buffer.resize(static_cast<size_t>(file_size));
+            file.read(&buffer[0], file_size);
+            buffer.resize(static_cast<size_t>(file.gcount()));
+        }
+        Profiler::add(Profiler::Counter::BYTES_READ, buffer.size());
+        Handle content = std::make_shared<const std::string>(std::move(buffer));
 
-        // Check cache size limit
-        if (current_size_bytes_ + file_size > max_cache_size_mb_ * 1024 * 1024)
+        if (content->size() > max_entry_bytes())
         {
-            // Cache is full, don't cache this file
-            std::string content(file_size, '\0');
-            file.read(&content[0], file_size);
+            oversized_++;
+            Profiler::add(Profiler::Counter::CACHE_OVERSIZED);
             return content;
         }
 
-        std::string content(file_size, '\0');
-        file.read(&content[0], file_size);
+        std::shared_ptr<MemoryMonitor> monitor = memory_monitor();
+        {
+            std::lock_guard<std::mutex> lock(shard.mutex);
 
-        // Cache the content
-        cache_[filename] = content;
-        current_size_bytes_ += content.size();
+            // Another thread may have read the same file meanwhile
+            auto it = shard.entries.find(filename);
+            if (it != shard.entries.end())
+            {
+                return it->second.content;
+            }
+
+            while (!shard.lru.empty() && monitor && !monitor->can_allocate(content->size()))
+            {
+                evict_oldest(shard, monitor.get());
+            }
+            if (monitor && !monitor->can_allocate(content->size()))
+            {
+                return content;
+            }
 
+            shard.lru.push_front(filename);
+            shard.entries[filename] = Entry{content, shard.lru.begin(), ++clock_};
+            shard.bytes += content->size();
+            bytes_ += content->size();
+            if (monitor)
+            {
+                monitor->add_usage(content->size());
+            }
+        }
+        trim(monitor.get());
         return content;
     }
 
+    /**
+     * @brief Drop all entries and reset the counters
+     */
     void clear()
     {
-        std::lock_guard<std::mutex> lock(cache_mutex_);
-        cache_.clear();
-        current_size_bytes_ = 0;
+        std::shared_ptr<MemoryMonitor> monitor = memory_monitor();
+        for (Shard& shard : shards_)
+        {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            if (monitor)
+            {
+                monitor->remove_usage(shard.bytes);
+            }
+            bytes_ -= shard.bytes;
+            shard.entries.clear();
+            shard.lru.clear();
+            shard.bytes = 0;
+        }
+        hits_      = 0;
+        misses_    = 0;
+        evictions_ = 0;
+        oversized_ = 0;
+    }
+
+    /**
+     * @brief Snapshot of the cache counters
+     */
+    Stats stats() const
+    {
+        Stats result;
+        result.hits      = hits_.load();
+        result.misses    = misses_.load();
+        result.evictions = evictions_.load();
+        result.oversized = oversized_.load();
+        for (const Shard& shard : shards_)
+        {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            result.bytes += shard.bytes;
+        }
+        return result;
+    }
+
+private:
+    static constexpr size_t SHARD_COUNT = 16;
+
+    struct Entry
+    {
+        Handle                           content;       ///< Cached file content
+        std::list<std::string>::iterator lru_position;  ///< Position in the shard's LRU list
+        uint64_t                         last_use;      ///< Value of clock_ at the last lookup
+    };
+
+    struct Shard
+    {
+        mutable std::mutex                     mutex;      ///< Guards this shard only
+        std::list<std::string>                 lru;        ///< Most recently used first
+        std::unordered_map<std::string, Entry> entries;    ///< Cached files by path
+        size_t                                 bytes = 0;  ///< Bytes cached in this shard
+    };
+
+    Shard& shard_for(const std::string& filename)
+    {
+        return shards_[std::hash<std::string>{}(filename) % SHARD_COUNT];
+    }
+
+    std::shared_ptr<MemoryMonitor> memory_monitor() const
+    {
+        std::lock_guard<std::mutex> lock(monitor_mutex_);
+        return monitor_;
+    }
+
+    /**
+     * @brief Evict the least recently used entries of all shards until the cache is within budget
+     *
+     * Holds one shard lock at a time: the shard with the oldest tail is found
+     * first and then evicted from, so concurrent lookups may reorder entries in
+     * between, which only makes the choice slightly less exact.
+     */
+    void trim(MemoryMonitor* monitor)
+    {
+        while (bytes_.load() > budget_)
+        {
+            Shard*   oldest_shard = nullptr;
+            uint64_t oldest_use   = 0;
+            for (Shard& shard : shards_)
+            {
+                std::lock_guard<std::mutex> lock(shard.mutex);
+                if (!shard.lru.empty())
+                {
+                    uint64_t use = shard.entries.find(shard.lru.back())->second.last_use;
+                    if (!oldest_shard || use < oldest_use)
+                    {
+                        oldest_shard = &shard;
+                        oldest_use   = use;
+                    }
+                }
+            }
+            if (!oldest_shard)
+            {
+                return;
+            }
+            std::lock_guard<std::mutex> lock(oldest_shard->mutex);
+            if (!oldest_shard->lru.empty())
+            {
+                evict_oldest(*oldest_shard, monitor);
+            }
+        }
+    }
+
+    void evict_oldest(Shard& shard, MemoryMonitor* monitor)
+    {
+        auto   it   = shard.entries.find(shard.lru.back());
+        size_t size = it->second.content->size();
+        shard.bytes -= size;
+        bytes_ -= size;
+        if (monitor)
+        {
+            monitor->remove_usage(size);
+        }
+        shard.entries.erase(it);
+        shard.lru.pop_back();
+        evictions_++;
     }
+
+    std::array<Shard, SHARD_COUNT> shards_;         ///< Lock-striped partitions of the cache
+    size_t                         budget_;         ///< Byte budget shared by all shards
+    std::atomic<size_t>            bytes_;          ///< Bytes cached in all shards
+    std::atomic<uint64_t>          clock_;          ///< Lookup counter that orders entries by last use
+    std::atomic<size_t>            hits_;           ///< Lookups served from the cache
+    std::atomic<size_t>            misses_;         ///< Lookups that read the file
+    std::atomic<size_t>            evictions_;      ///< Entries evicted
+    std::atomic<size_t>            oversized_;      ///< Files handed out uncached because of their size
+    mutable std::mutex             monitor_mutex_;  ///< Guards monitor_
+    std::shared_ptr<MemoryMonitor> monitor_;        ///< Receives cached byte accounting
 };
 
 // Global file cache instance
-static FileContentCache g_file_cache(500);  // 500MB cache
+static FileContentCache g_file_cache(500);  // 500MB budget
+
+// =============================================================================
+// Single-Pass Field Collection
+// =============================================================================
+
+namespace
+{
+    /**
+     * @brief Anchors of every value read from a high-level log or its parent
+     */
+    enum EnergyAnchor : unsigned
+    {
+        ENERGY_SCF_DONE,
+        ENERGY_CIS,
+        ENERGY_PCM,
+        ENERGY_CLR,
+        ENERGY_ZERO_POINT,
+        ENERGY_THERMAL_ENTHALPY,
+        ENERGY_THERMAL_GIBBS,
+        ENERGY_THERMAL_ENERGY,
+        ENERGY_TOTAL_ENTROPY,
+        ENERGY_TEMPERATURE,
+        ENERGY_FREQUENCIES,
+        ENERGY_SCRF,
+        ENERGY_ANCHOR_COUNT
+    };
+
+    /**
+     * @brief Pattern names used in warnings, as passed to extract_value_from_file()
+     */
+    const char* const ENERGY_PATTERN_NAME[ENERGY_ANCHOR_COUNT] = {
+        "SCF Done",
+        "Total Energy, E\\(CIS",
+        "After PCM corrections, the energy is",
+        "Total energy after correction",
+        "Zero-point correction",
+        "Thermal correction to Enthalpy",
+        "Thermal correction to Gibbs Free Energy",
+        "Thermal correction to Energy",
+        "Total\\s+S",
+        "Kelvin\\.\\s+Pressure",
+        "Frequencies",
+        "scrf",
+    };
+
+    const LogScanner::AnchorSet& energy_anchors()
+    {
+        // "Total" and "Kelvin." are confirmed against the full patterns in scan_energy_lines()
+        static const LogScanner::AnchorSet anchors({"SCF Done",
+                                                    "Total Energy, E(CIS",
+                                                    "After PCM corrections, the energy is",
+                                                    "Total energy after correction",
+                                                    "Zero-point correction",
+                                                    "Thermal correction to Enthalpy",
+                                                    "Thermal correction to Gibbs Free Energy",
+                                                    "Thermal correction to Energy",
+                                                    "Total",
+                                                    "Kelvin.",
+                                                    "Frequencies",
+                                                    "scrf"});
+        return anchors;
+    }
+
+    /**
+     * @brief Last line of each anchor and the frequency summary of one log
+     *
+     * Line views point into the scanned content and are only valid while it is alive.
+     */
+    struct EnergyLogLines
+    {
+        std::string_view last[ENERGY_ANCHOR_COUNT];          ///< Last line holding each anchor (empty if none)
+        bool             found[ENERGY_ANCHOR_COUNT] = {};    ///< Whether each anchor was seen
+        bool             has_frequencies            = false; ///< Whether any frequency was parsed
+        double           lowest_frequency           = 0.0;   ///< Lowest frequency (cm⁻¹)
+    };
+
+    inline bool is_space_char(char c)
+    {
+        return c == ' ' || c == '\t' || c == '\n' || c == '\v' || c == '\f' || c == '\r';
+    }
+
+    /**
+     * @brief Whether @p phrase occurs in @p line followed by whitespace and then @p follower (phrase\s+follower)
+     */
+    bool has_spaced_sequence(std::string_view line, std::string_view phrase, std::string_view follower)
+    {
+        for (size_t at = line.find(phrase); at != std::string_view::npos; at = line.find(phrase, at + 1))
+        {
+            size_t pos = at + phrase.size();
+            if (pos >= line.size() || !is_space_char(line[pos]))
+            {
+                continue;
+            }
+            while (pos < line.size() && is_space_char(line[pos]))
+            {
+                ++pos;
+            }
+            if (line.compare(pos, follower.size(), follower) == 0)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief Whitespace-separated field of a line, matching repeated operator>> reads
+     * @param field_index 1-based field number; the last field is returned when the line is shorter
+     */
+    std::string line_field(std::string_view line, int field_index)
+    {
+        std::string_view field;
+        size_t           pos = 0;
+        for (int i = 0; i < field_index; ++i)
+        {
+            while (pos < line.size() && is_space_char(line[pos]))
+            {
+                ++pos;
+            }
+            if (pos >= line.size())
+            {
+                break;
+            }
+            size_t start = pos;
+            while (pos < line.size() && !is_space_char(line[pos]))
+            {
+                ++pos;
+            }
+            field = line.substr(start, pos - start);
+        }
+        return std::string(field);
+    }
+
+    /**
+     * @brief Record the frequencies of a "Frequencies --" line, as HighLevelEnergyUtils::extract_frequencies()
+     */
+    void record_frequencies(std::string_view line, EnergyLogLines& lines)
+    {
+        std::istringstream line_iss{std::string(line)};
+        std::string        word;
+        bool               found_frequencies = false;
+
+        while (line_iss >> word)
+        {
+            if (word == "--")
+            {
+                found_frequencies = true;
+                continue;
+            }
+            if (found_frequencies)
+            {
+                try
+                {
+                    double freq = std::stod(word);
+                    if (!lines.has_frequencies || freq < lines.lowest_frequency)
+                    {
+                        lines.lowest_frequency = freq;
+                    }
+                    lines.has_frequencies = true;
+                }
+                catch (const std::exception&)
+                {
+                    // Skip non-numeric words
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Collect every energy anchor of a log in one pass
+     */
+    EnergyLogLines scan_energy_lines(std::string_view content)
+    {
+        Profiler::Scope parse(Profiler::Phase::PARSE);
+        EnergyLogLines  lines;
+        energy_anchors().for_each_line(content, [&lines](std::string_view line, unsigned anchors) {
+            if ((anchors & (1u << ENERGY_TOTAL_ENTROPY)) && !has_spaced_sequence(line, "Total", "S"))
+            {
+                anchors &= ~(1u << ENERGY_TOTAL_ENTROPY);
+            }
+            if ((anchors & (1u << ENERGY_TEMPERATURE)) && !has_spaced_sequence(line, "Kelvin.", "Pressure"))
+            {
+                anchors &= ~(1u << ENERGY_TEMPERATURE);
+            }
+            if (anchors & (1u << ENERGY_FREQUENCIES))
+            {
+                record_frequencies(line, lines);
+            }
+
+            for (unsigned i = 0; i < ENERGY_ANCHOR_COUNT; ++i)
+            {
+                if (anchors & (1u << i))
+                {
+                    lines.last[i]  = line;
+                    lines.found[i] = true;
+                }
+            }
+        });
+        return lines;
+    }
+}  // namespace
+
 
 // =============================================================================
 // HighLevelEnergyCalculator Implementation
@@ -219,7 +587,7 @@ HighLevelEnergyCalculator::HighLevelEnergyCalculator(double temp,
                                                      int    sort_column,
                                                      bool   is_au_format)
     : temperature_(temp), concentration_m_(concentration_m), sort_column_(sort_column), is_au_format_(is_au_format),
-      context_(nullptr), has_context_(false), thread_pool_(nullptr)
+      context_(nullptr), has_context_(false)
 {
     concentration_mol_m3_ = concentration_m * 1000.0;
 }
@@ -231,7 +599,7 @@ HighLevelEnergyCalculator::HighLevelEnergyCalculator(std::shared_ptr<ProcessingC
                                                      int                                sort_column,
                                                      bool                               is_au_format)
     : temperature_(temp), concentration_m_(concentration_m), sort_column_(sort_column), is_au_format_(is_au_format),
-      context_(context), has_context_(true), thread_pool_(nullptr)
+      context_(context), has_context_(true)
 {
     concentration_mol_m3_ = concentration_m * 1000.0;
 
@@ -250,46 +618,186 @@ HighLevelEnergyCalculator::HighLevelEnergyCalculator(std::shared_ptr<ProcessingC
     }
 }
 
+// =============================================================================
+// Result Index Serialisation
+// =============================================================================
+
+/**
+ * @brief Result index section holding raw high-level/low-level values
+ */
+static const std::string HIGH_LEVEL_INDEX_SECTION = "high";
+
+/**
+ * @brief Serialise the raw values read from a high-level log and its parent
+ *
+ * The parent's stamp is stored so that a re-run frequency job in the parent
+ * directory invalidates the entry, together with the default temperature the
+ * entry fell back to when the parent printed none.
+ */
+static std::vector<std::string> encode_high_level_raw(const HighLevelEnergyData& data,
+                                                      const std::string&         parent_file,
+                                                      double                     default_temperature)
+{
+    FileStamp parent_stamp;
+    FileStamp::from_path(parent_file, parent_stamp);
+
+    std::vector<std::string> fields = {parent_stamp.to_string(), ResultIndex::format_double(default_temperature)};
+    for (double value : {data.scf_high,
+                         data.scf_td_high,
+                         data.scf_equi_high,
+                         data.scf_clr_high,
+                         data.scf_low,
+                         data.scf_td_low,
+                         data.zpe,
+                         data.tc_enthalpy,
+                         data.tc_gibbs,
+                         data.tc_energy,
+                         data.entropy_total,
+                         data.temperature,
+                         data.lowest_frequency})
+    {
+        fields.push_back(ResultIndex::format_double(value));
+    }
+    fields.push_back(data.has_scrf ? "1" : "0");
+    fields.push_back(data.status);
+    return fields;
+}
+
+/**
+ * @brief Restore raw values from a result index entry
+ * @return false if the entry is malformed, the parent changed, or the stored
+ *         temperature may be a default that differs from the current one
+ */
+static bool decode_high_level_raw(const std::vector<std::string>& fields,
+                                  const std::string&              parent_file,
+                                  double                          default_temperature,
+                                  HighLevelEnergyData&            data)
+{
+    if (fields.size() != 17)
+    {
+        return false;
+    }
+
+    FileStamp parent_stamp;
+    if (!FileStamp::from_path(parent_file, parent_stamp) || parent_stamp.to_string() != fields[0])
+    {
+        return false;
+    }
+
+    double values[14];
+    for (size_t i = 0; i < 14; ++i)
+    {
+        if (!ResultIndex::parse_double(fields[i + 1], values[i]))
+        {
+            return false;
+        }
+    }
+
+    double indexed_default = values[0];
+    double temperature     = values[12];
+    if (temperature == indexed_default && indexed_default != default_temperature)
+    {
+        return false;
+    }
+
+    data.scf_high         = values[1];
+    data.scf_td_high      = values[2];
+    data.scf_equi_high    = values[3];
+    data.scf_clr_high     = values[4];
+    data.scf_low          = values[5];
+    data.scf_td_low       = values[6];
+    data.zpe              = values[7];
+    data.tc_enthalpy      = values[8];
+    data.tc_gibbs         = values[9];
+    data.tc_energy        = values[10];
+    data.entropy_total    = values[11];
+    data.temperature      = temperature;
+    data.lowest_frequency = values[13];
+    data.final_scf_low    = data.scf_td_low != 0.0 ? data.scf_td_low : data.scf_low;
+    data.has_scrf         = fields[15] == "1";
+    data.status           = fields[16];
+    return true;
+}
+
 // Main calculation function
 HighLevelEnergyData HighLevelEnergyCalculator::calculate_high_level_energy(const std::string& high_level_file)
+{
+    return calculate(high_level_file, nullptr);
+}
+
+HighLevelEnergyData HighLevelEnergyCalculator::calculate_high_level_energy(const std::string& high_level_file,
+                                                                           std::string_view   content)
+{
+    return calculate(high_level_file, &content);
+}
+
+HighLevelEnergyData HighLevelEnergyCalculator::calculate(const std::string&      high_level_file,
+                                                         const std::string_view* content)
 {
     HighLevelEnergyData data(high_level_file);
 
     try
     {
-        // Memory guard for large calculations
-        struct MemoryGuard
+        const std::string parent_file = get_parent_file(high_level_file);
+
+        // Raw values of unchanged high-level/parent pairs come from the result index; content that has been
+        // read already is parsed instead
+        ResultIndex*             index = has_context_ && !content ? context_->result_index.get() : nullptr;
+        FileStamp                stamp;
+        std::vector<std::string> fields;
+        bool                     cached = index &&
+                                          index->lookup(HIGH_LEVEL_INDEX_SECTION, high_level_file, stamp, fields) &&
+                                          decode_high_level_raw(fields, parent_file, temperature_, data);
+
+        if (!cached)
         {
-            std::shared_ptr<MemoryMonitor> monitor;
-            size_t                         bytes;
-            MemoryGuard(std::shared_ptr<MemoryMonitor> m, size_t b) : monitor(m), bytes(b)
+            // Both logs are read whole (through the file cache); reserve their contents first so a tight
+            // memory limit delays this pair instead of failing it
+            MemoryMonitor::Reservation memory;
+            if (has_context_ && context_->memory_monitor)
+            {
+                size_t bytes = 0;
+                for (const std::string* path : {&high_level_file, &parent_file})
+                {
+                    if (content && path == &high_level_file)
+                    {
+                        continue;
+                    }
+                    std::error_code ec;
+                    uintmax_t       size = std::filesystem::file_size(*path, ec);
+                    bytes += ec ? 0 : static_cast<size_t>(size);
+                }
+                memory = context_->memory_monitor->reserve(bytes);
+                if (!memory.is_acquired())
+                {
+                    throw std::runtime_error("Processing interrupted by shutdown signal");
+                }
+            }
+
+            // Extract high-level electronic energies, SCRF flag and status from current directory file
+            if (content)
             {
-                if (monitor)
-                    monitor->add_usage(bytes);
+                extract_high_level_data(high_level_file, *content, data);
             }
-            ~MemoryGuard()
+            else
             {
-                if (monitor)
-                    monitor->remove_usage(bytes);
+                extract_high_level_data(high_level_file, data);
             }
-        };
 
-        std::unique_ptr<MemoryGuard> memory_guard;
-        if (has_context_ && context_->memory_monitor)
-        {
-            if (!context_->memory_monitor->can_allocate(10 * 1024 * 1024))
-            {  // 10MB safety check
-                throw std::runtime_error("Insufficient memory to process " + high_level_file);
+            // Extract low-level thermal data and lowest frequency from parent directory
+            if (!extract_low_level_thermal_data(parent_file, data))
+            {
+                throw std::runtime_error("Failed to extract thermal data from " + parent_file);
             }
-            memory_guard = std::make_unique<MemoryGuard>(context_->memory_monitor, 10 * 1024 * 1024);
-        }
 
-        // Extract high-level electronic energies from current directory file
-        data.scf_high    = extract_value_from_file(high_level_file, "SCF Done", 5, -1);
-        data.scf_td_high = extract_value_from_file(high_level_file, "Total Energy, E\\(CIS", 5, -1, false);
-        data.scf_equi_high =
-            extract_value_from_file(high_level_file, "After PCM corrections, the energy is", 7, -1, false);
-        data.scf_clr_high = extract_value_from_file(high_level_file, "Total energy after correction", 6, -1, false);
+            if (index)
+            {
+                index->store(HIGH_LEVEL_INDEX_SECTION,
+                             high_level_file,
+                             stamp,
+                             encode_high_level_raw(data, parent_file, temperature_));
+            }
+        }
 
         // Determine final high-level electronic energy (priority order from bash script)
         if (data.scf_equi_high != 0.0)
@@ -309,13 +817,6 @@ HighLevelEnergyData HighLevelEnergyCalculator::calculate_high_level_energy(const
             data.final_scf_high = data.scf_high;
         }
 
-        // Extract low-level thermal data from parent directory
-        std::string parent_file = get_parent_file(high_level_file);
-        if (!extract_low_level_thermal_data(parent_file, data))
-        {
-            throw std::runtime_error("Failed to extract thermal data from " + parent_file);
-        }
-
         // Calculate derived quantities
         data.tc_only  = calculate_thermal_only(data.tc_energy, data.zpe);
         data.ts_value = data.tc_enthalpy - data.tc_gibbs;
@@ -324,10 +825,7 @@ HighLevelEnergyData HighLevelEnergyCalculator::calculate_high_level_energy(const
         data.enthalpy_hartree = data.final_scf_high + data.tc_enthalpy;
         data.gibbs_hartree    = data.final_scf_high + data.tc_gibbs;
 
-        // Check for SCRF and apply phase correction
-        std::string file_content = has_context_ ? safe_read_file(high_level_file) : read_file_content(high_level_file);
-        data.has_scrf            = (file_content.find("scrf") != std::string::npos);
-
+        // Apply phase correction for solvated systems
         if (data.has_scrf)
         {
             data.phase_correction        = calculate_phase_correction(data.temperature, concentration_mol_m3_);
@@ -344,10 +842,6 @@ HighLevelEnergyData HighLevelEnergyCalculator::calculate_high_level_energy(const
         data.gibbs_kj_mol = data.gibbs_hartree_corrected * HARTREE_TO_KJ_MOL;
         data.gibbs_ev     = data.gibbs_hartree_corrected * HARTREE_TO_EV;
 
-        // Extract additional data
-        data.lowest_frequency = extract_lowest_frequency(parent_file);
-        data.status           = determine_job_status(high_level_file);
-
         // Validate final data
         if (has_context_ && !HighLevelEnergyUtils::validate_energy_data(data))
         {
@@ -545,92 +1039,8 @@ HighLevelEnergyCalculator::process_files_with_limits(const std::vector<std::stri
     }
     else
     {
-        // Enhanced parallel processing with thread pool
-        if (files.size() > 50)
-        {
-            // Use optimized thread pool for large datasets
-            return process_files_with_thread_pool(files, thread_count, memory_limit_mb, quiet);
-        }
-
-        // Use original approach for smaller datasets to avoid thread pool overhead
-        results.resize(files.size());
-        std::vector<std::thread> workers;
-        std::mutex               results_mutex;
-        std::atomic<size_t>      progress_counter{0};
-        std::atomic<bool>        should_stop{false};
-
-        auto start_time = std::chrono::steady_clock::now();
-
-        // Launch progress monitor
-        std::thread monitor_thread;
-        if (thread_count > 1)
-        {  // Only show progress for parallel processing
-            monitor_thread = std::thread([this, &progress_counter, &should_stop, start_time, files, quiet]() {
-                while (!should_stop.load() && progress_counter.load() < files.size())
-                {
-                    monitor_progress(files.size(), progress_counter, start_time, quiet);
-                    std::this_thread::sleep_for(std::chrono::milliseconds(500));  // Faster updates
-                }
-            });
-        }
-
-        // Launch worker threads
-        size_t files_per_thread = files.size() / thread_count;
-        size_t remaining_files  = files.size() % thread_count;
-
-        for (unsigned int i = 0; i < thread_count; ++i)
-        {
-            size_t start_index = i * files_per_thread;
-            size_t end_index   = start_index + files_per_thread;
-
-            // Distribute remaining files
-            if (i < remaining_files)
-            {
-                end_index += 1;
-                start_index += i;
-            }
-            else
-            {
-                start_index += remaining_files;
-                end_index += remaining_files;
-            }
-
-            if (start_index < files.size())
-            {
-                workers.emplace_back(&HighLevelEnergyCalculator::process_files_worker,
-                                     this,
-                                     std::cref(files),
-                                     start_index,
-                                     std::min(end_index, files.size()),
-                                     std::ref(results),
-                                     std::ref(results_mutex),
-                                     std::ref(progress_counter));
-            }
-        }
-
-        // Wait for all workers to complete
-        for (auto& worker : workers)
-        {
-            if (worker.joinable())
-            {
-                worker.join();
-            }
-        }
-
-        // Stop progress monitor
-        should_stop.store(true);
-        if (monitor_thread.joinable())
-        {
-            monitor_thread.join();
-        }
-
-        // Remove any failed results (empty entries)
-        results.erase(std::remove_if(results.begin(),
-                                     results.end(),
-                                     [](const HighLevelEnergyData& data) {
-                                         return data.filename.empty();
-                                     }),
-                      results.end());
+        // Parallel processing on the shared task executor
+        return process_files_with_thread_pool(files, thread_count, memory_limit_mb, quiet);
     }
 
     // Sort results by specified column
@@ -641,6 +1051,14 @@ HighLevelEnergyCalculator::process_files_with_limits(const std::vector<std::stri
     return results;
 }
 
+void HighLevelEnergyCalculator::sort_results(std::vector<HighLevelEnergyData>& results)
+{
+    Profiler::Scope sort(Profiler::Phase::SORT);
+    std::sort(results.begin(), results.end(), [this](const HighLevelEnergyData& a, const HighLevelEnergyData& b) {
+        return compare_results(a, b, sort_column_);
+    });
+}
+
 // Print Gibbs-focused format (first bash script)
 void HighLevelEnergyCalculator::print_gibbs_format(const std::vector<HighLevelEnergyData>& results,
                                                    bool                                    quiet,
@@ -664,6 +1082,8 @@ void HighLevelEnergyCalculator::print_gibbs_csv_format(const std::vector<HighLev
                                                        bool                                    quiet,
                                                        std::ostream*                           output_file)
 {
+    Profiler::Scope write(Profiler::Phase::FORMAT);
+
     // In quiet mode, only write to file if output_file is provided
     if (quiet && !output_file)
     {
@@ -695,11 +1115,71 @@ void HighLevelEnergyCalculator::print_gibbs_csv_format(const std::vector<HighLev
     }
 }
 
+// Write all fields in the columnar binary format (--format bin)
+void HighLevelEnergyCalculator::write_columnar(const std::vector<HighLevelEnergyData>& results,
+                                               const std::string&                      path) const
+{
+    Profiler::Scope write(Profiler::Phase::FORMAT);
+    using Type = ColumnarWriter::Type;
+
+    // (name, member) pairs of the FLOAT64 columns, in declaration order
+    static const std::vector<std::pair<const char*, double HighLevelEnergyData::*>> energies = {
+        {"scf_high", &HighLevelEnergyData::scf_high},
+        {"scf_td_high", &HighLevelEnergyData::scf_td_high},
+        {"scf_equi_high", &HighLevelEnergyData::scf_equi_high},
+        {"scf_clr_high", &HighLevelEnergyData::scf_clr_high},
+        {"scf_low", &HighLevelEnergyData::scf_low},
+        {"scf_td_low", &HighLevelEnergyData::scf_td_low},
+        {"zpe", &HighLevelEnergyData::zpe},
+        {"tc_enthalpy", &HighLevelEnergyData::tc_enthalpy},
+        {"tc_gibbs", &HighLevelEnergyData::tc_gibbs},
+        {"tc_energy", &HighLevelEnergyData::tc_energy},
+        {"entropy_total", &HighLevelEnergyData::entropy_total},
+        {"tc_only", &HighLevelEnergyData::tc_only},
+        {"ts_value", &HighLevelEnergyData::ts_value},
+        {"final_scf_high", &HighLevelEnergyData::final_scf_high},
+        {"final_scf_low", &HighLevelEnergyData::final_scf_low},
+        {"enthalpy_hartree", &HighLevelEnergyData::enthalpy_hartree},
+        {"gibbs_hartree", &HighLevelEnergyData::gibbs_hartree},
+        {"gibbs_hartree_corrected", &HighLevelEnergyData::gibbs_hartree_corrected},
+        {"gibbs_kj_mol", &HighLevelEnergyData::gibbs_kj_mol},
+        {"gibbs_ev", &HighLevelEnergyData::gibbs_ev},
+        {"lowest_frequency", &HighLevelEnergyData::lowest_frequency},
+        {"temperature", &HighLevelEnergyData::temperature},
+        {"phase_correction", &HighLevelEnergyData::phase_correction}};
+
+    std::vector<ColumnarWriter::Column> columns = {{"filename", Type::STRING}};
+    for (const auto& energy : energies)
+    {
+        columns.push_back({energy.first, Type::FLOAT64});
+    }
+    columns.push_back({"has_scrf", Type::BOOL});
+    columns.push_back({"phase_corr_applied", Type::BOOL});
+    columns.push_back({"status", Type::STRING});
+
+    ColumnarWriter out(path, columns);
+    for (const auto& data : results)
+    {
+        out.add_string(data.filename);
+        for (const auto& energy : energies)
+        {
+            out.add_double(data.*(energy.second));
+        }
+        out.add_bool(data.has_scrf);
+        out.add_bool(data.phase_corr_applied);
+        out.add_string(data.status);
+        out.end_row();
+    }
+    out.close();
+}
+
 // Print components breakdown CSV format (high-au command)
 void HighLevelEnergyCalculator::print_components_csv_format(const std::vector<HighLevelEnergyData>& results,
                                                             bool                                    quiet,
                                                             std::ostream*                           output_file)
 {
+    Profiler::Scope write(Profiler::Phase::FORMAT);
+
     // In quiet mode, only write to file if output_file is provided
     if (quiet && !output_file)
     {
@@ -741,11 +1221,12 @@ double HighLevelEnergyCalculator::extract_value_from_file(const std::string& fil
                                                           int                occurrence,
                                                           bool               warn_if_missing)
 {
+    Profiler::add(Profiler::Counter::REGEX_FALLBACKS);
     try
     {
         // Use cached file content to avoid redundant I/O
-        std::string file_content = g_file_cache.get_or_read(filename);
-        if (file_content.empty())
+        FileContentCache::Handle cached_content = g_file_cache.get_or_read(filename);
+        if (!cached_content || cached_content->empty())
         {
             if (has_context_ && context_->error_collector)
             {
@@ -807,7 +1288,7 @@ double HighLevelEnergyCalculator::extract_value_from_file(const std::string& fil
         }
 
         std::vector<std::string> matches;
-        std::istringstream       stream(file_content);
+        std::istringstream       stream(*cached_content);
         std::string              line;
 
         while (std::getline(stream, line))
@@ -872,6 +1353,76 @@ double HighLevelEnergyCalculator::extract_value_from_file(const std::string& fil
 }
 
 
+double HighLevelEnergyCalculator::parse_line_field(std::string_view   line,
+                                                   bool               found,
+                                                   int                field_index,
+                                                   const std::string& filename,
+                                                   const std::string& pattern,
+                                                   bool               warn_if_missing)
+{
+    if (!found)
+    {
+        if (warn_if_missing && has_context_ && context_->error_collector)
+        {
+            context_->error_collector->add_warning("Pattern '" + pattern + "' not found in: " + filename);
+        }
+        return 0.0;
+    }
+
+    std::string field = line_field(line, field_index);
+    if (field.empty())
+    {
+        return 0.0;
+    }
+    return safe_parse_energy(field, filename + " (pattern: " + pattern + ")");
+}
+
+void HighLevelEnergyCalculator::extract_high_level_data(const std::string& high_level_file, HighLevelEnergyData& data)
+{
+    FileContentCache::Handle content = g_file_cache.get_or_read(high_level_file);
+    if (!content || content->empty())
+    {
+        if (has_context_ && context_->error_collector)
+        {
+            context_->error_collector->add_warning("Cannot read file: " + high_level_file);
+        }
+        data.status = "UNKNOWN";
+        return;
+    }
+
+    extract_high_level_energies(high_level_file, *content, data);
+    data.status = determine_job_status(high_level_file);
+}
+
+void HighLevelEnergyCalculator::extract_high_level_data(const std::string&   high_level_file,
+                                                        std::string_view     content,
+                                                        HighLevelEnergyData& data)
+{
+    extract_high_level_energies(high_level_file, content, data);
+    data.status = job_status_from_tail(Utils::tail_lines(content, 10));
+}
+
+void HighLevelEnergyCalculator::extract_high_level_energies(const std::string&   high_level_file,
+                                                            std::string_view     content,
+                                                            HighLevelEnergyData& data)
+{
+    EnergyLogLines lines = scan_energy_lines(content);
+    auto           value = [&](EnergyAnchor anchor, int field_index, bool warn_if_missing) {
+        return parse_line_field(lines.last[anchor],
+                                lines.found[anchor],
+                                field_index,
+                                high_level_file,
+                                ENERGY_PATTERN_NAME[anchor],
+                                warn_if_missing);
+    };
+
+    data.scf_high      = value(ENERGY_SCF_DONE, 5, true);
+    data.scf_td_high   = value(ENERGY_CIS, 5, false);
+    data.scf_equi_high = value(ENERGY_PCM, 7, false);
+    data.scf_clr_high  = value(ENERGY_CLR, 6, false);
+    data.has_scrf      = lines.found[ENERGY_SCRF];
+}
+
 bool HighLevelEnergyCalculator::extract_low_level_thermal_data(const std::string&   parent_file,
                                                                HighLevelEnergyData& data)
 {
@@ -887,14 +1438,35 @@ bool HighLevelEnergyCalculator::extract_low_level_thermal_data(const std::string
             return false;
         }
 
-        // Extract thermal corrections from parent directory file
-        data.scf_low       = extract_value_from_file(parent_file, "SCF Done", 5, -1);
-        data.scf_td_low    = extract_value_from_file(parent_file, "Total Energy, E\\(CIS", 5, -1, false);
-        data.zpe           = extract_value_from_file(parent_file, "Zero-point correction", 3, -1);
-        data.tc_enthalpy   = extract_value_from_file(parent_file, "Thermal correction to Enthalpy", 5, -1);
-        data.tc_gibbs      = extract_value_from_file(parent_file, "Thermal correction to Gibbs Free Energy", 7, -1);
-        data.tc_energy     = extract_value_from_file(parent_file, "Thermal correction to Energy", 5, -1);
-        data.entropy_total = extract_value_from_file(parent_file, "Total\\s+S", 2, -1, false);
+        FileContentCache::Handle content = g_file_cache.get_or_read(parent_file);
+        if (!content || content->empty())
+        {
+            if (has_context_ && context_->error_collector)
+            {
+                context_->error_collector->add_warning("Cannot read file: " + parent_file);
+            }
+            content = std::make_shared<const std::string>();
+        }
+
+        // Collect every thermal value of the parent file in one pass
+        EnergyLogLines lines = scan_energy_lines(*content);
+        auto           value = [&](EnergyAnchor anchor, int field_index, bool warn_if_missing) {
+            return parse_line_field(lines.last[anchor],
+                                    lines.found[anchor],
+                                    field_index,
+                                    parent_file,
+                                    ENERGY_PATTERN_NAME[anchor],
+                                    warn_if_missing && !content->empty());
+        };
+
+        data.scf_low          = value(ENERGY_SCF_DONE, 5, true);
+        data.scf_td_low       = value(ENERGY_CIS, 5, false);
+        data.zpe              = value(ENERGY_ZERO_POINT, 3, true);
+        data.tc_enthalpy      = value(ENERGY_THERMAL_ENTHALPY, 5, true);
+        data.tc_gibbs         = value(ENERGY_THERMAL_GIBBS, 7, true);
+        data.tc_energy        = value(ENERGY_THERMAL_ENERGY, 5, true);
+        data.entropy_total    = value(ENERGY_TOTAL_ENTROPY, 2, false);
+        data.lowest_frequency = lines.lowest_frequency;
 
         // Validate extracted thermal data
         if (data.zpe == 0.0 && data.tc_enthalpy == 0.0 && data.tc_gibbs == 0.0)
@@ -916,7 +1488,7 @@ bool HighLevelEnergyCalculator::extract_low_level_thermal_data(const std::string
         }
 
         // Extract temperature from parent file
-        double temp = extract_value_from_file(parent_file, "Kelvin\\.\\s+Pressure", 2, -1, false);
+        double temp = value(ENERGY_TEMPERATURE, 2, false);
         if (temp > 0.0 && HighLevelEnergyUtils::validate_temperature(temp))
         {
             data.temperature = temp;
@@ -968,8 +1540,12 @@ double HighLevelEnergyCalculator::extract_lowest_frequency(const std::string& pa
 {
     try
     {
-        std::string content     = read_file_content(parent_file);
-        auto        frequencies = HighLevelEnergyUtils::extract_frequencies(content);
+        FileContentCache::Handle content = g_file_cache.get_or_read(parent_file);
+        if (!content)
+        {
+            return 0.0;
+        }
+        auto frequencies = HighLevelEnergyUtils::extract_frequencies(*content);
         return HighLevelEnergyUtils::find_lowest_frequency(frequencies);
     }
     catch (const std::exception& e)
@@ -982,42 +1558,47 @@ std::string HighLevelEnergyCalculator::determine_job_status(const std::string& f
 {
     try
     {
-        std::string tail_content = read_file_tail(filename, 10);
+        return job_status_from_tail(read_file_tail(filename, 10));
+    }
+    catch (const std::exception& e)
+    {
+        return "UNKNOWN";
+    }
+}
 
-        if (tail_content.find("Normal") != std::string::npos)
-        {
-            return "DONE";
-        }
+std::string HighLevelEnergyCalculator::job_status_from_tail(std::string_view tail_content)
+{
+    if (tail_content.find("Normal") != std::string_view::npos)
+    {
+        return "DONE";
+    }
 
-        // Check for error patterns
-        bool has_error    = false;
-        bool has_error_on = false;
+    // Check for error patterns
+    bool has_error    = false;
+    bool has_error_on = false;
 
-        std::istringstream iss(tail_content);
-        std::string        line;
-        while (std::getline(iss, line))
+    size_t start = 0;
+    while (start < tail_content.size())
+    {
+        size_t           end  = std::min(tail_content.find('\n', start), tail_content.size());
+        std::string_view line = tail_content.substr(start, end - start);
+        if (line.find("Error") != std::string_view::npos)
         {
-            if (line.find("Error") != std::string::npos)
+            has_error = true;
+            if (line.find("Error on") != std::string_view::npos)
             {
-                has_error = true;
-                if (line.find("Error on") != std::string::npos)
-                {
-                    has_error_on = true;
-                }
+                has_error_on = true;
             }
         }
-
-        if (has_error && !has_error_on)
-        {
-            return "ERROR";
-        }
-
-        return "UNDONE";
+        start = end + 1;
     }
-    catch (const std::exception& e)
+
+    if (has_error && !has_error_on)
     {
-        return "UNKNOWN";
+        return "ERROR";
     }
+
+    return "UNDONE";
 }
 
 std::string HighLevelEnergyCalculator::get_parent_file(const std::string& high_level_file)
@@ -1033,43 +1614,34 @@ bool HighLevelEnergyCalculator::file_exists(const std::string& filename)
 std::string HighLevelEnergyCalculator::read_file_content(const std::string& filename)
 {
     // Use file cache for better performance
-    return g_file_cache.get_or_read(filename);
+    FileContentCache::Handle cached_content = g_file_cache.get_or_read(filename);
+    return cached_content ? *cached_content : std::string();
 }
 
 std::string HighLevelEnergyCalculator::read_file_tail(const std::string& filename, int lines)
 {
     // Use cached content when possible
-    std::string content = g_file_cache.get_or_read(filename);
-    if (content.empty())
+    FileContentCache::Handle cached_content = g_file_cache.get_or_read(filename);
+    if (!cached_content || cached_content->empty())
     {
         throw std::runtime_error("Cannot read file: " + filename);
     }
+    const std::string& content = *cached_content;
 
-    // Efficiently extract last N lines
-    std::vector<std::string> all_lines;
-    all_lines.reserve(lines * 2);  // Pre-allocate for efficiency
-
-    std::istringstream stream(content);
-    std::string        line;
-    while (std::getline(stream, line))
+    // Walk back over the last N lines instead of splitting the whole file
+    size_t body_end = content.back() == '\n' ? content.size() - 1 : content.size();
+    size_t start    = body_end;
+    int    found    = 0;
+    while (start > 0 && found < lines)
     {
-        all_lines.push_back(line);
-        // Keep only the last 'lines' entries for memory efficiency
-        if (all_lines.size() > static_cast<size_t>(lines * 2))
+        if (content[start - 1] == '\n' && ++found == lines)
         {
-            all_lines.erase(all_lines.begin(), all_lines.begin() + lines);
+            break;
         }
+        --start;
     }
 
-    std::ostringstream result;
-    size_t             start_index = (all_lines.size() > static_cast<size_t>(lines)) ? all_lines.size() - lines : 0;
-
-    for (size_t i = start_index; i < all_lines.size(); ++i)
-    {
-        result << all_lines[i] << "\n";
-    }
-
-    return result.str();
+    return content.substr(start, body_end - start) + "\n";
 }
 
 void HighLevelEnergyCalculator::print_gibbs_header(std::ostream* output_file)
@@ -1308,6 +1880,8 @@ void HighLevelEnergyCalculator::print_gibbs_format_dynamic(const std::vector<Hig
                                                            bool                                    quiet,
                                                            std::ostream*                           output_file)
 {
+    Profiler::Scope write(Profiler::Phase::FORMAT);
+
     // In quiet mode, only write to file if output_file is provided
     if (quiet && !output_file)
     {
@@ -1345,6 +1919,8 @@ void HighLevelEnergyCalculator::print_components_format_dynamic(const std::vecto
                                                                 bool                                    quiet,
                                                                 std::ostream*                           output_file)
 {
+    Profiler::Scope write(Profiler::Phase::FORMAT);
+
     // In quiet mode, only write to file if output_file is provided
     if (quiet && !output_file)
     {
@@ -1453,65 +2029,6 @@ void HighLevelEnergyCalculator::print_components_format_static(const std::vector
             << std::fixed << std::setprecision(4) << data.lowest_frequency << std::setw(10) << phase_corr << std::endl;
     }
 }
-// Enhanced worker function for parallel processing
-void HighLevelEnergyCalculator::process_files_worker(const std::vector<std::string>&   files,
-                                                     size_t                            start_index,
-                                                     size_t                            end_index,
-                                                     std::vector<HighLevelEnergyData>& results,
-                                                     std::mutex&                       results_mutex,
-                                                     std::atomic<size_t>&              progress_counter)
-{
-    for (size_t i = start_index; i < end_index; ++i)
-    {
-        try
-        {
-            // Memory check before processing
-            if (has_context_ && context_->memory_monitor)
-            {
-                if (!context_->memory_monitor->can_allocate(50 * 1024 * 1024))
-                {  // 50MB safety margin
-                    if (context_->error_collector)
-                    {
-                        context_->error_collector->add_warning("Memory limit reached, skipping " + files[i]);
-                    }
-                    continue;
-                }
-            }
-
-            // Process the file
-            auto data = calculate_high_level_energy(files[i]);
-
-            // Thread-safe result storage
-            {
-                std::lock_guard<std::mutex> lock(results_mutex);
-                if (i < results.size())
-                {
-                    results[i] = data;
-                }
-            }
-        }
-        catch (const std::exception& e)
-        {
-            if (has_context_ && context_->error_collector)
-            {
-                context_->error_collector->add_error("Worker failed to process " + files[i] + ": " + e.what());
-            }
-
-            // Store empty result to maintain indexing
-            {
-                std::lock_guard<std::mutex> lock(results_mutex);
-                if (i < results.size())
-                {
-                    results[i]        = HighLevelEnergyData(files[i]);
-                    results[i].status = "ERROR";
-                }
-            }
-        }
-
-        // Update progress
-        progress_counter.fetch_add(1);
-    }
-}
 
 unsigned int HighLevelEnergyCalculator::calculate_optimal_threads(size_t file_count, size_t available_memory)
 {
@@ -1671,16 +2188,14 @@ std::string HighLevelEnergyCalculator::safe_read_file(const std::string& filenam
             file_size = max_size_bytes;
         }
 
-        // Memory allocation check
+        // Wait until the buffer fits the memory limit instead of returning an empty result
+        MemoryMonitor::Reservation memory;
         if (has_context_ && context_->memory_monitor)
         {
-            if (!context_->memory_monitor->can_allocate(file_size))
+            memory = context_->memory_monitor->reserve(static_cast<size_t>(file_size));
+            if (!memory.is_acquired())
             {
-                if (context_->error_collector)
-                {
-                    context_->error_collector->add_error("Insufficient memory to read file: " + filename);
-                }
-                return content;
+                return content;  // Shutdown requested
             }
         }
 
@@ -1697,6 +2212,11 @@ std::string HighLevelEnergyCalculator::safe_read_file(const std::string& filenam
                 return content;
             }
 
+            if (CompressedInput::is_compressed(filename))
+            {
+                content = CompressedInput::read_all(filename, max_size_bytes);
+                return content;
+            }
             std::ifstream file(filename, std::ios::binary);
             if (file.is_open())
             {
@@ -1708,6 +2228,11 @@ std::string HighLevelEnergyCalculator::safe_read_file(const std::string& filenam
         else
         {
             // Fallback without file handle management
+            if (CompressedInput::is_compressed(filename))
+            {
+                content = CompressedInput::read_all(filename, max_size_bytes);
+                return content;
+            }
             std::ifstream file(filename, std::ios::binary);
             if (file.is_open())
             {
@@ -2040,8 +2565,8 @@ HighLevelEnergyCalculator::process_files_with_thread_pool(const std::vector<std:
         return results;
     }
 
-    // Clear file cache at the beginning for fresh processing
-    g_file_cache.clear();
+    // Clear file cache at the beginning for fresh processing and charge it to this run's monitor
+    g_file_cache.attach_memory_monitor(has_context_ ? context_->memory_monitor : nullptr);
 
     // Enhanced memory limit calculation
     if (memory_limit_mb == 0)
@@ -2089,9 +2614,10 @@ HighLevelEnergyCalculator::process_files_with_thread_pool(const std::vector<std:
         }
     }
 
-    // Optimize thread count
-    thread_count = std::min(thread_count, std::thread::hardware_concurrency());
-    thread_count = std::max(1u, thread_count);  // Minimum 1 thread
+    // Respect interactive caps and job scheduler CPU allocations
+    thread_count = has_context_ ? calculateSafeThreadCount(
+                                      thread_count, static_cast<unsigned int>(files.size()), context_->job_resources)
+                                : std::max(1u, std::min(thread_count, std::thread::hardware_concurrency()));
 
     if (!quiet)
     {
@@ -2099,39 +2625,45 @@ HighLevelEnergyCalculator::process_files_with_thread_pool(const std::vector<std:
                   << " threads (Memory limit: " << memory_limit_mb << " MB)" << std::endl;
     }
 
-    // Optimized work-stealing approach instead of thread pool for better performance
-    std::atomic<size_t> file_index{0};
     results.resize(files.size());
     std::atomic<size_t> progress_counter{0};
     auto                start_time = std::chrono::steady_clock::now();
 
-    // Worker function with work stealing
-    auto worker = [&]() {
-        while (true)
+    auto process_file = [&](size_t idx) {
+        try
         {
-            size_t idx = file_index.fetch_add(1);
-            if (idx >= files.size())
-                break;
-
-            try
-            {
-                // Process with cached file reading
-                results[idx] = calculate_high_level_energy(files[idx]);
-                progress_counter.fetch_add(1);
-            }
-            catch (const std::exception& e)
+            // Process with cached file reading
+            results[idx] = calculate_high_level_energy(files[idx]);
+        }
+        catch (const std::exception& e)
+        {
+            if (has_context_ && context_->error_collector)
             {
-                if (has_context_ && context_->error_collector)
-                {
-                    context_->error_collector->add_error("Failed to process " + files[idx] + ": " + e.what());
-                }
-                results[idx]        = HighLevelEnergyData(files[idx]);
-                results[idx].status = "ERROR";
-                progress_counter.fetch_add(1);
+                context_->error_collector->add_error("Failed to process " + files[idx] + ": " + e.what());
             }
+            results[idx]        = HighLevelEnergyData(files[idx]);
+            results[idx].status = "ERROR";
         }
+        progress_counter.fetch_add(1);
     };
 
+    // Weight each task by the size of the high-level log and its parent
+    std::vector<uintmax_t> weights = TaskExecutor::file_sizes(files);
+    std::vector<uintmax_t> parent_sizes;
+    {
+        std::vector<std::string> parents;
+        parents.reserve(files.size());
+        for (const auto& file : files)
+        {
+            parents.push_back(get_parent_file(file));
+        }
+        parent_sizes = TaskExecutor::file_sizes(parents);
+    }
+    for (size_t i = 0; i < weights.size(); ++i)
+    {
+        weights[i] += parent_sizes[i];
+    }
+
     // Start progress monitor thread
     std::atomic<bool> should_stop{false};
     std::thread       monitor_thread;
@@ -2146,22 +2678,7 @@ HighLevelEnergyCalculator::process_files_with_thread_pool(const std::vector<std:
         });
     }
 
-    // Launch worker threads
-    std::vector<std::thread> workers;
-    workers.reserve(thread_count);
-    for (unsigned i = 0; i < thread_count; ++i)
-    {
-        workers.emplace_back(worker);
-    }
-
-    // Wait for all workers to complete
-    for (auto& w : workers)
-    {
-        if (w.joinable())
-        {
-            w.join();
-        }
-    }
+    TaskExecutor::shared(thread_count).run(files.size(), process_file, weights);
 
     // Remove any failed results (empty entries)
     results.erase(std::remove_if(results.begin(),
@@ -2179,6 +2696,7 @@ HighLevelEnergyCalculator::process_files_with_thread_pool(const std::vector<std:
     }
 
 // Sort results using parallel sort if available
+    Profiler::Scope sort(Profiler::Phase::SORT);
 #ifdef __cpp_lib_execution
     if (results.size() > 100)
     {
@@ -2214,8 +2732,21 @@ HighLevelEnergyCalculator::process_files_with_thread_pool(const std::vector<std:
         auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
         std::cout << "Completed processing " << results.size() << " files in " << duration.count() << " ms"
                   << std::endl;
+
+        FileContentCache::Stats cache_stats = g_file_cache.stats();
+        std::cout << "File cache: " << cache_stats.hits << " hits, " << cache_stats.misses << " misses, "
+                  << cache_stats.evictions << " evictions";
+        if (cache_stats.oversized > 0)
+        {
+            std::cout << ", " << cache_stats.oversized << " uncached (too large, over "
+                      << g_file_cache.max_entry_bytes() / (1024 * 1024) << " MB)";
+        }
+        std::cout << std::endl;
     }
 
+    // Release cached content and its memory accounting
+    g_file_cache.attach_memory_monitor(nullptr);
+
     return results;
 }
 
@@ -2293,19 +2824,3 @@ HighLevelEnergyData HighLevelEnergyCalculator::process_single_file_enhanced(cons
     }
 }
 
-ThreadPool& HighLevelEnergyCalculator::get_thread_pool(unsigned int thread_count)
-{
-    if (!thread_pool_ || thread_pool_->is_shutting_down())
-    {
-        // Adjust thread count for cluster safety
-        if (has_context_ && context_->job_resources.scheduler_type != SchedulerType::NONE)
-        {
-            // More conservative on clusters - use half of allocated CPUs
-            thread_count = std::min(thread_count, context_->job_resources.allocated_cpus / 2);
-            thread_count = std::max(1u, thread_count);
-        }
-
-        thread_pool_ = std::make_unique<ThreadPool>(thread_count);
-    }
-    return *thread_pool_;
-}
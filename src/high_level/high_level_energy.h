@@ -33,13 +33,10 @@
 #define HIGH_LEVEL_ENERGY_H
 
 #include <atomic>
-#include <condition_variable>
-#include <functional>
-#include <future>
 #include <memory>
 #include <mutex>
-#include <queue>
 #include <string>
+#include <string_view>
 #include <thread>
 #include <vector>
 // Conditional include for execution policies
@@ -259,131 +256,6 @@ struct HighLevelEnergyData
  * - Comprehensive error handling and validation
  * - Integration with job scheduler resource management
  */
-
-/**
- * @class ThreadPool
- * @brief High-performance thread pool for parallel file processing
- *
- * A thread-safe, efficient thread pool implementation designed specifically for
- * high-throughput file processing tasks. Features dynamic work distribution,
- * resource-aware task scheduling, and cluster-safe operation.
- *
- * @section Features
- * - Fixed-size thread pool to avoid creation/destruction overhead
- * - Task queue with condition variable synchronization
- * - Exception-safe task execution with error propagation
- * - Graceful shutdown with proper thread joining
- * - Memory-efficient task storage using std::function
- *
- * @section Performance Characteristics
- * - Zero allocation after initialization for task submission
- * - Lock-free task completion detection using atomics
- * - Optimized for I/O-bound tasks (file reading/parsing)
- * - Scales efficiently up to hardware thread limits
- */
-class ThreadPool
-{
-private:
-    std::vector<std::thread>          workers_;           ///< Worker thread pool
-    std::queue<std::function<void()>> tasks_;             ///< Task queue for pending work
-    std::mutex                        queue_mutex_;       ///< Mutex protecting task queue
-    std::condition_variable           condition_;         ///< Condition variable for task availability
-    std::atomic<bool>                 stop_flag_{false};  ///< Atomic flag for graceful shutdown
-    std::atomic<size_t>               active_tasks_{0};   ///< Count of currently executing tasks
-
-public:
-    /**
-     * @brief Constructor with thread count specification
-     * @param num_threads Number of worker threads to create
-     *
-     * Creates a fixed-size thread pool with the specified number of workers.
-     * Threads are created immediately and remain active until destruction.
-     *
-     * @note Recommended thread count is typically between hardware_concurrency/2
-     *       and hardware_concurrency for I/O-bound workloads on clusters
-     */
-    explicit ThreadPool(size_t num_threads);
-
-    /**
-     * @brief Destructor with graceful shutdown
-     *
-     * Stops accepting new tasks, completes all pending tasks, and joins all
-     * worker threads. Ensures all resources are properly cleaned up.
-     */
-    ~ThreadPool();
-
-    /**
-     * @brief Submit a task for asynchronous execution
-     * @tparam F Function type (automatically deduced)
-     * @tparam Args Argument types (automatically deduced)
-     * @param f Function or callable to execute
-     * @param args Arguments to pass to the function
-     * @return std::future<return_type> Future for task result
-     *
-     * Submits a task to the thread pool for asynchronous execution. The task
-     * will be executed by the next available worker thread. Returns a future
-     * that can be used to retrieve the result or wait for completion.
-     *
-     * @note This method is thread-safe and can be called concurrently
-     * @throws std::runtime_error if pool is shutting down
-     */
-    template <typename F, typename... Args>
-    auto enqueue(F&& f, Args&&... args) -> std::future<typename std::invoke_result<F, Args...>::type>
-    {
-        using return_type = typename std::invoke_result<F, Args...>::type;
-
-        auto task = std::make_shared<std::packaged_task<return_type()>>(
-            std::bind(std::forward<F>(f), std::forward<Args>(args)...));
-
-        std::future<return_type> result = task->get_future();
-
-        {
-            std::unique_lock<std::mutex> lock(queue_mutex_);
-
-            if (stop_flag_.load())
-            {
-                throw std::runtime_error("ThreadPool is shutting down, cannot enqueue new tasks");
-            }
-
-            tasks_.emplace([task]() {
-                (*task)();
-            });
-        }
-        condition_.notify_one();
-
-        return result;
-    }
-
-    /**
-     * @brief Get number of active (executing) tasks
-     * @return Current number of tasks being executed
-     *
-     * Returns the number of tasks currently being executed by worker threads.
-     * Useful for monitoring load and determining when processing is complete.
-     */
-    size_t active_count() const
-    {
-        return active_tasks_.load();
-    }
-
-    /**
-     * @brief Wait for all tasks to complete
-     *
-     * Blocks until all submitted tasks have completed execution. Does not
-     * prevent new tasks from being submitted during the wait.
-     */
-    void wait_for_completion();
-
-    /**
-     * @brief Check if thread pool is shutting down
-     * @return true if shutdown has been initiated
-     */
-    bool is_shutting_down() const
-    {
-        return stop_flag_.load();
-    }
-};
-
 class HighLevelEnergyCalculator
 {
 public:
@@ -443,6 +315,18 @@ public:
      */
     HighLevelEnergyData calculate_high_level_energy(const std::string& high_level_file);
 
+    /**
+     * @brief Calculate high-level energy for a file whose content is already in memory
+     * @param high_level_file Path to high-level calculation log file (locates the parent file)
+     * @param content Whole content of @p high_level_file
+     * @return HighLevelEnergyData with complete energy analysis
+     *
+     * Same as calculate_high_level_energy(high_level_file) without reading the
+     * high-level file again; only the parent file is read. The result index is
+     * not used. Called by the pipeline command from the extract scan.
+     */
+    HighLevelEnergyData calculate_high_level_energy(const std::string& high_level_file, std::string_view content);
+
     /**
      * @brief Process entire directory of high-level calculations
      * @param extension File extension to process (default: ".log")
@@ -548,6 +432,18 @@ public:
                                      bool                                    quiet       = false,
                                      std::ostream*                           output_file = nullptr);
 
+    /**
+     * @brief Write every field of the results as a typed columnar file (--format bin)
+     * @param results Vector of calculation results, in output order
+     * @param path Output file path
+     * @throws std::runtime_error if the file cannot be written
+     *
+     * One column per HighLevelEnergyData field, in declaration order, in the
+     * layout described in columnar_writer.h. The same file serves high-kj and
+     * high-au, since it holds the values behind both tables.
+     */
+    void write_columnar(const std::vector<HighLevelEnergyData>& results, const std::string& path) const;
+
     /** @} */  // end of OutputFunctions group
 
     /**
@@ -629,6 +525,12 @@ public:
         return sort_column_;
     }
 
+    /**
+     * @brief Sort results by the configured sort column, as process_directory() does
+     * @param results Results collected outside process_directory(), e.g. by the pipeline command
+     */
+    void sort_results(std::vector<HighLevelEnergyData>& results);
+
     /** @} */  // end of Configuration group
 
 private:
@@ -642,9 +544,6 @@ private:
     std::shared_ptr<ProcessingContext> context_;      ///< Processing context with resource managers
     bool                               has_context_;  ///< Whether enhanced context is available
 
-    // Thread pool for optimized parallel processing
-    std::unique_ptr<ThreadPool> thread_pool_;  ///< Reusable thread pool for file processing
-
     /**
      * @defgroup EnergyExtraction Energy Extraction Helper Functions
      * @brief Private functions for extracting energy values from log files
@@ -672,14 +571,68 @@ private:
                                    int                occurrence      = -1,
                                    bool               warn_if_missing = true);
 
+    /**
+     * @brief Extract high-level energies, SCRF flag and job status in one pass
+     * @param high_level_file Path to high-level log file
+     * @param data Reference to HighLevelEnergyData to populate
+     */
+    void extract_high_level_data(const std::string& high_level_file, HighLevelEnergyData& data);
+
+    /**
+     * @brief Extract high-level data from content that is already in memory
+     * @param high_level_file Path to high-level calculation file (used in warnings)
+     * @param content Whole content of the file
+     * @param data Reference to data structure to populate
+     */
+    void extract_high_level_data(const std::string&   high_level_file,
+                                 std::string_view     content,
+                                 HighLevelEnergyData& data);
+
+    /**
+     * @brief Parse the high-level energies and SCRF flag (everything but the status)
+     * @param high_level_file Path to high-level calculation file (used in warnings)
+     * @param content Whole content of the file
+     * @param data Reference to data structure to populate
+     */
+    void extract_high_level_energies(const std::string&   high_level_file,
+                                     std::string_view     content,
+                                     HighLevelEnergyData& data);
+
+    /**
+     * @brief Shared body of both calculate_high_level_energy() overloads
+     * @param high_level_file Path to high-level calculation log file
+     * @param content Content of the file, or nullptr to read it
+     */
+    HighLevelEnergyData calculate(const std::string& high_level_file, const std::string_view* content);
+
     /**
      * @brief Extract thermal correction data from low-level calculation
      * @param parent_file Path to parent directory log file
      * @param data Reference to HighLevelEnergyData to populate
      * @return true if thermal data successfully extracted, false otherwise
+     *
+     * Energies, thermal corrections, temperature and the lowest frequency are
+     * all collected in a single pass over the parent file.
      */
     bool extract_low_level_thermal_data(const std::string& parent_file, HighLevelEnergyData& data);
 
+    /**
+     * @brief Parse one field of a line found by the single-pass scanner
+     * @param line Last line holding the pattern
+     * @param found Whether the pattern occurred at all
+     * @param field_index Field index in the line (1-based, whitespace separated)
+     * @param filename Log file, used in warnings
+     * @param pattern Pattern name, used in warnings
+     * @param warn_if_missing Whether to warn when the pattern did not occur
+     * @return Parsed value, or 0.0 when missing or invalid
+     */
+    double parse_line_field(std::string_view   line,
+                            bool               found,
+                            int                field_index,
+                            const std::string& filename,
+                            const std::string& pattern,
+                            bool               warn_if_missing);
+
     /** @} */  // end of EnergyExtraction group
 
     /**
@@ -726,6 +679,13 @@ private:
      */
     std::string determine_job_status(const std::string& filename);
 
+    /**
+     * @brief Determine job completion status from the last lines of a log
+     * @param tail_content Last 10 lines of the log
+     * @return Status string ("DONE", "ERROR", "UNDONE")
+     */
+    std::string job_status_from_tail(std::string_view tail_content);
+
     /** @} */  // end of CalculationHelpers group
 
     /**
@@ -919,26 +879,7 @@ private:
     bool compare_results(const HighLevelEnergyData& a, const HighLevelEnergyData& b, int column);
 
     /**
-     * @brief Worker function for parallel file processing
-     * @param files Vector of files to process
-     * @param start_index Starting index for this worker
-     * @param end_index Ending index for this worker
-     * @param results Shared results vector (thread-safe access required)
-     * @param results_mutex Mutex for results vector access
-     * @param progress_counter Atomic counter for progress tracking
-     *
-     * Processes a subset of files assigned to this worker thread.
-     * Includes proper resource management and error handling.
-     */
-    void process_files_worker(const std::vector<std::string>&   files,
-                              size_t                            start_index,
-                              size_t                            end_index,
-                              std::vector<HighLevelEnergyData>& results,
-                              std::mutex&                       results_mutex,
-                              std::atomic<size_t>&              progress_counter);
-
-    /**
-     * @brief Enhanced parallel processing using thread pool
+     * @brief Enhanced parallel processing on the shared task executor
      * @param files List of files to process
      * @param thread_count Number of threads to use
      * @param memory_limit_mb Memory limit in MB
@@ -946,11 +887,10 @@ private:
      * @return Vector of processed results
      *
      * Improved parallel processing implementation featuring:
-     * - Reusable thread pool to eliminate creation overhead
-     * - Asynchronous I/O with batched file operations
-     * - Dynamic task distribution for optimal load balancing
+     * - Shared work-stealing executor (TaskExecutor) reused across commands
+     * - Largest high-level/parent pairs scheduled first
      * - Enhanced memory management and progress reporting
-     * - Cluster-safe resource utilization
+     * - Cluster-safe thread count from calculateSafeThreadCount()
      */
     std::vector<HighLevelEnergyData> process_files_with_thread_pool(const std::vector<std::string>& files,
                                                                     unsigned int                    thread_count,
@@ -984,17 +924,6 @@ private:
      */
     HighLevelEnergyData process_single_file_enhanced(const std::string& filename, const std::string& file_content = "");
 
-    /**
-     * @brief Get or create thread pool with optimal size
-     * @param thread_count Desired thread count
-     * @return Reference to thread pool
-     *
-     * Lazy initialization of thread pool with optimal sizing:
-     * - Creates pool only when needed
-     * - Adjusts thread count based on system resources
-     * - Respects cluster environment constraints
-     */
-    ThreadPool& get_thread_pool(unsigned int thread_count);
 
     /**
      * @brief Calculate optimal number of threads for processing
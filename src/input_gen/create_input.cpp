@@ -10,13 +10,18 @@
 
 #include "create_input.h"
 #include "parameter_parser.h"
+#include "extraction/log_scanner.h"
+#include "utilities/task_executor.h"
 #include <algorithm>
 #include <atomic>
+#include <charconv>
 #include <chrono>
+#include <deque>
 #include <filesystem>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <limits>
 #include <mutex>
 #include <thread>
 #include <vector>
@@ -25,6 +30,185 @@
 // External global for shutdown
 extern std::atomic<bool> g_shutdown_requested;
 
+namespace
+{
+    // Files at least this large are checked for streaming as a multi-frame trajectory
+    const size_t TRAJECTORY_MIN_BYTES = 1024 * 1024;
+
+    // Bytes read per block when a trajectory cannot be memory-mapped
+    const size_t TRAJECTORY_BLOCK_BYTES = 4 * 1024 * 1024;
+
+    // Frames handed to a worker thread per task
+    const size_t TRAJECTORY_FRAMES_PER_TASK = 32;
+
+    /**
+     * @brief Offset just past the line starting at pos
+     * @param at_end Whether text holds the rest of the file, so a last line without newline is complete
+     * @return npos if the line is not complete in text
+     */
+    size_t line_end(std::string_view text, size_t pos, bool at_end)
+    {
+        if (pos >= text.size())
+        {
+            return std::string_view::npos;
+        }
+        size_t newline = text.find('\n', pos);
+        if (newline != std::string_view::npos)
+        {
+            return newline + 1;
+        }
+        return at_end ? text.size() : std::string_view::npos;
+    }
+
+    /**
+     * @brief Parse the atom count line of an XYZ frame (digits with optional surrounding blanks)
+     */
+    bool parse_atom_count(std::string_view line, size_t& count)
+    {
+        size_t first = line.find_first_not_of(" \t\r\n");
+        size_t last  = line.find_last_not_of(" \t\r\n");
+        if (first == std::string_view::npos)
+        {
+            return false;
+        }
+
+        const char* begin = line.data() + first;
+        const char* end   = line.data() + last + 1;
+        auto [ptr, ec]    = std::from_chars(begin, end, count);
+        return ec == std::errc() && ptr == end && count > 0;
+    }
+
+    enum class FrameState
+    {
+        COMPLETE,    ///< Count line, comment and all atom lines are in the text
+        INCOMPLETE,  ///< The text ends inside the frame
+        INVALID      ///< The text at the position is not an atom count line
+    };
+
+    /**
+     * @brief Locate the atom lines of the frame starting at pos
+     * @param body Set to the offset of the first atom line
+     * @param end Set to the offset just past the last atom line
+     */
+    FrameState scan_frame(std::string_view text, size_t pos, bool at_end, size_t& body, size_t& end)
+    {
+        size_t comment = line_end(text, pos, at_end);
+        if (comment == std::string_view::npos)
+        {
+            return FrameState::INCOMPLETE;
+        }
+
+        size_t count = 0;
+        if (!parse_atom_count(text.substr(pos, comment - pos), count))
+        {
+            return FrameState::INVALID;
+        }
+
+        body = line_end(text, comment, at_end);
+        end  = body;
+        for (size_t atom = 0; atom < count && end != std::string_view::npos; ++atom)
+        {
+            end = line_end(text, end, at_end);
+        }
+        return end == std::string_view::npos ? FrameState::INCOMPLETE : FrameState::COMPLETE;
+    }
+
+    /**
+     * @brief Skip complete lines that hold only whitespace
+     */
+    size_t skip_blank_lines(std::string_view text, size_t pos, bool at_end)
+    {
+        while (pos < text.size())
+        {
+            size_t next = line_end(text, pos, at_end);
+            if (next == std::string_view::npos ||
+                text.substr(pos, next - pos).find_first_not_of(" \t\r\n") != std::string_view::npos)
+            {
+                break;
+            }
+            pos = next;
+        }
+        return pos;
+    }
+
+    /**
+     * @brief Split XYZ text ending in a newline into coordinate blocks
+     */
+    void split_xyz_frames(std::string_view text, std::vector<std::string_view>& frames)
+    {
+        frames.clear();
+
+        size_t pos = 0;
+        size_t body;
+        size_t end;
+        while (pos < text.size() && scan_frame(text, pos, true, body, end) == FrameState::COMPLETE)
+        {
+            frames.push_back(text.substr(body, end - body));
+            pos = skip_blank_lines(text, end, true);
+        }
+        if (frames.size() > 1 && pos == text.size())
+        {
+            return;
+        }
+
+        // Single structure: everything after the atom count and comment lines
+        frames.clear();
+        size_t comment     = line_end(text, 0, true);
+        size_t coordinates = comment == std::string_view::npos ? comment : line_end(text, comment, true);
+        if (coordinates < text.size())
+        {
+            frames.push_back(text.substr(coordinates));
+        }
+    }
+
+    /**
+     * @brief Whether a file starts with two complete frames within its first block
+     */
+    bool starts_as_trajectory(const std::string& xyz_file)
+    {
+        std::ifstream file(xyz_file, std::ios::binary);
+        if (!file.is_open())
+        {
+            return false;
+        }
+
+        std::string head(TRAJECTORY_BLOCK_BYTES, '\0');
+        file.read(&head[0], static_cast<std::streamsize>(head.size()));
+        head.resize(static_cast<size_t>(file.gcount()));
+        bool at_end = head.size() < TRAJECTORY_BLOCK_BYTES;
+
+        size_t body;
+        size_t end;
+        if (scan_frame(head, 0, at_end, body, end) != FrameState::COMPLETE)
+        {
+            return false;
+        }
+        size_t second = skip_blank_lines(head, end, at_end);
+        return second < head.size() && scan_frame(head, second, at_end, body, end) == FrameState::COMPLETE;
+    }
+
+    /**
+     * @struct TrajectoryBlock
+     * @brief Part of a trajectory read into memory when the file cannot be mapped
+     */
+    struct TrajectoryBlock
+    {
+        std::string                text;    ///< Frames of the block, starting at a frame boundary
+        MemoryMonitor::Reservation memory;  ///< Bytes held for text
+    };
+
+    /**
+     * @struct TrajectoryBatch
+     * @brief Consecutive frames of a trajectory written by one task
+     */
+    struct TrajectoryBatch
+    {
+        std::shared_ptr<const TrajectoryBlock> block;        ///< Storage of the frames (null when mapped)
+        std::vector<std::string_view>          frames;       ///< Coordinate blocks
+        size_t                                 first_frame;  ///< Index of frames[0] in the file
+    };
+}  // namespace
+
 CreateInput::CreateInput(std::shared_ptr<ProcessingContext> ctx, bool quiet)
     : context(ctx), quiet_mode(quiet), calc_type_(CalculationType::SP), functional_("UwB97XD"), basis_("Def2SVPP"),
       large_basis_(""), solvent_(""), solvent_model_("smd"), print_level_(""), extra_keywords_(""), charge_(0),
@@ -323,7 +507,28 @@ CreateSummary CreateInput::create_inputs(const std::vector<std::string>& xyz_fil
     // Thread-safe containers
     std::vector<std::string> successful_creations;  // input_file paths
     std::mutex               results_mutex;
-    std::atomic<size_t>      file_index{0};
+
+    // Everything but the name and coordinates is the same for every file
+    compile_inputs();
+
+    // Large multi-frame files are streamed frame by frame after the others
+    bool                     reads_coordinates = calc_type_ != CalculationType::IRC_FORWARD &&
+                                                 calc_type_ != CalculationType::IRC_REVERSE;
+    std::vector<std::string> files;
+    std::vector<std::string> trajectories;
+    for (const auto& xyz_file : xyz_files)
+    {
+        std::error_code ec;
+        uintmax_t       size = std::filesystem::file_size(xyz_file, ec);
+        if (reads_coordinates && !ec && size >= TRAJECTORY_MIN_BYTES && starts_as_trajectory(xyz_file))
+        {
+            trajectories.push_back(xyz_file);
+        }
+        else
+        {
+            files.push_back(xyz_file);
+        }
+    }
 
     // Calculate safe thread count
     unsigned int num_threads = calculateSafeThreadCount(
@@ -335,69 +540,74 @@ CreateSummary CreateInput::create_inputs(const std::vector<std::string>& xyz_fil
     }
 
     // Process files in parallel
-    std::vector<std::thread> threads;
-    for (unsigned int i = 0; i < num_threads; ++i)
-    {
-        threads.emplace_back([&]() {
-            size_t index;
-            while ((index = file_index.fetch_add(1)) < xyz_files.size())
+    auto process_file = [&](size_t index) {
+        try
+        {
+            // Coordinates and the generated input are held in memory until the input is written
+            MemoryMonitor::Reservation memory;
+            if (context->memory_monitor)
             {
-                if (g_shutdown_requested.load())
-                    break;
-
-                try
-                {
-                    auto file_guard = context->file_manager->acquire();
-                    if (!file_guard.is_acquired())
-                        continue;
+                std::error_code ec;
+                uintmax_t       size = std::filesystem::file_size(files[index], ec);
+                memory               = context->memory_monitor->reserve(ec ? 0 : static_cast<size_t>(2 * size));
+                if (!memory.is_acquired())
+                    return;
+            }
 
-                    std::string error_msg;
-                    if (create_from_file(xyz_files[index], error_msg))
-                    {
-                        {
-                            std::lock_guard<std::mutex> lock(results_mutex);
-                            std::vector<std::string>    input_files = generate_input_filename(xyz_files[index]);
-                            for (const auto& input_file : input_files)
-                            {
-                                successful_creations.push_back(input_file);
-                            }
-                            summary.processed_files++;
-                            summary.created_files += input_files.size();
-                        }
-                    }
-                    else
-                    {
-                        {
-                            std::lock_guard<std::mutex> lock(results_mutex);
-                            summary.processed_files++;
-                            summary.failed_files++;
-                            if (!error_msg.empty())
-                            {
-                                summary.errors.push_back("Error creating input for " + xyz_files[index] + ": " +
-                                                         error_msg);
-                            }
-                        }
-                    }
+            auto file_guard = context->file_manager->acquire();
+            if (!file_guard.is_acquired())
+                return;
 
-                    // Report progress
-                    if (!quiet_mode && summary.processed_files % 50 == 0)
+            std::string              error_msg;
+            std::vector<std::string> input_files;
+            if (create_from_file(files[index], input_files, error_msg))
+            {
+                {
+                    std::lock_guard<std::mutex> lock(results_mutex);
+                    for (const auto& input_file : input_files)
                     {
-                        report_progress(summary.processed_files, summary.total_files);
+                        successful_creations.push_back(input_file);
                     }
+                    summary.processed_files++;
+                    summary.created_files += input_files.size();
                 }
-                catch (const std::exception& e)
+            }
+            else
+            {
                 {
                     std::lock_guard<std::mutex> lock(results_mutex);
-                    summary.errors.push_back("Exception creating input for " + xyz_files[index] + ": " + e.what());
+                    summary.processed_files++;
+                    summary.failed_files++;
+                    if (!error_msg.empty())
+                    {
+                        summary.errors.push_back("Error creating input for " + files[index] + ": " +
+                                                 error_msg);
+                    }
                 }
             }
-        });
-    }
 
-    // Wait for completion
-    for (auto& thread : threads)
+            // Report progress
+            if (!quiet_mode && summary.processed_files % 50 == 0)
+            {
+                report_progress(summary.processed_files, summary.total_files);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            std::lock_guard<std::mutex> lock(results_mutex);
+            summary.errors.push_back("Exception creating input for " + files[index] + ": " + e.what());
+        }
+    };
+
+    TaskExecutor::shared(num_threads).run(files.size(), process_file);
+
+    for (const auto& trajectory : trajectories)
     {
-        thread.join();
+        if (g_shutdown_requested.load())
+        {
+            break;
+        }
+        create_from_trajectory(trajectory, summary);
     }
 
     if (!quiet_mode && summary.processed_files > 0)
@@ -412,22 +622,122 @@ CreateSummary CreateInput::create_inputs(const std::vector<std::string>& xyz_fil
     return summary;
 }
 
-bool CreateInput::create_from_file(const std::string& xyz_file, std::string& error_msg)
+void CreateInput::compile_inputs()
+{
+    std::vector<std::pair<std::string, CalculationType>> variants;
+    switch (calc_type_)
+    {
+        case CalculationType::IRC:
+            // Combined IRC writes a forward and a reverse input for every structure
+            variants = {{"F", CalculationType::IRC_FORWARD}, {"R", CalculationType::IRC_REVERSE}};
+            break;
+        case CalculationType::IRC_FORWARD:
+            variants = {{"F", calc_type_}};
+            break;
+        case CalculationType::IRC_REVERSE:
+            variants = {{"R", calc_type_}};
+            break;
+        default:
+            variants = {{"", calc_type_}};
+            break;
+    }
+
+    compiled_inputs_.clear();
+    CalculationType original_type = calc_type_;
+    for (const auto& [suffix, type] : variants)
+    {
+        CompiledInput input;
+        input.name_suffix = suffix;
+
+        calc_type_ = type;
+        try
+        {
+            input.layout =
+                InputTemplate(generate_input_content(InputTemplate::NAME_MARKER, InputTemplate::COORDINATES_MARKER));
+        }
+        catch (const std::exception& e)
+        {
+            input.error = e.what();
+        }
+        compiled_inputs_.push_back(std::move(input));
+    }
+    calc_type_ = original_type;
+}
+
+bool CreateInput::compiled_inputs_valid(std::string& error_msg) const
+{
+    for (const auto& input : compiled_inputs_)
+    {
+        if (!input.error.empty())
+        {
+            error_msg = input.error;
+            return false;
+        }
+    }
+    return true;
+}
+
+bool CreateInput::write_inputs(const std::filesystem::path& dir,
+                               const std::string&           isomer_name,
+                               std::string_view             coordinates,
+                               std::vector<std::string>&    input_files,
+                               std::string&                 error_msg)
+{
+    // Reused by every input a worker thread writes
+    thread_local std::string content;
+
+    bool all_success = true;
+    for (const auto& input : compiled_inputs_)
+    {
+        std::string input_file = (dir / (isomer_name + input.name_suffix + extension_)).string();
+        input_files.push_back(input_file);
+
+        // Check if input file already exists
+        if (std::filesystem::exists(input_file))
+        {
+            if (!quiet_mode)
+            {
+                std::cout << input_file << " exists and will not be overwritten." << std::endl;
+            }
+            continue;  // Skip this file
+        }
+
+        // Write input file
+        input.layout.render(content, isomer_name, coordinates);
+        if (!write_input_file(input_file, content))
+        {
+            error_msg   = "Failed to write input file: " + input_file;
+            all_success = false;
+        }
+        else if (!quiet_mode)
+        {
+            std::cout << input_file << " was newly created." << std::endl;
+        }
+    }
+    return all_success;
+}
+
+bool CreateInput::create_from_file(const std::string&        xyz_file,
+                                   std::vector<std::string>& input_files,
+                                   std::string&              error_msg)
 {
     try
     {
         // Extract isomer name from filename
         std::filesystem::path path(xyz_file);
-        std::string           isomer_name = path.stem().string();
+        std::filesystem::path dir  = path.parent_path();
+        std::string           stem = path.stem().string();
+
+        // Reused by every file a worker thread handles
+        thread_local std::string                   contents;
+        thread_local std::vector<std::string_view> frames;
 
-        std::string coordinates;
+        frames.clear();
         if (calc_type_ != CalculationType::IRC_FORWARD && calc_type_ != CalculationType::IRC_REVERSE)
         {
             // Read coordinates from XYZ file for non-IRC calculations
-            coordinates = read_xyz_coordinates(xyz_file);
-            if (coordinates.empty())
+            if (!read_xyz_frames(xyz_file, contents, frames, error_msg))
             {
-                error_msg = "Failed to read coordinates from XYZ file";
                 return false;
             }
         }
@@ -437,7 +747,7 @@ bool CreateInput::create_from_file(const std::string& xyz_file, std::string& err
             std::string ts_chk_path;
             if (!tschk_path_.empty())
             {
-                std::filesystem::path chk_path = std::filesystem::path(tschk_path_) / (isomer_name + ".chk");
+                std::filesystem::path chk_path = std::filesystem::path(tschk_path_) / (stem + ".chk");
                 ts_chk_path                    = chk_path.string();
             }
             else
@@ -445,7 +755,7 @@ bool CreateInput::create_from_file(const std::string& xyz_file, std::string& err
                 // Default to parent directory
                 std::filesystem::path current_path = std::filesystem::current_path();
                 std::filesystem::path parent_path  = current_path.parent_path();
-                std::filesystem::path chk_path     = parent_path / (isomer_name + ".chk");
+                std::filesystem::path chk_path     = parent_path / (stem + ".chk");
                 ts_chk_path                        = chk_path.string();
             }
 
@@ -455,67 +765,237 @@ bool CreateInput::create_from_file(const std::string& xyz_file, std::string& err
                             ". Please specify --tschk-path or ensure the TS checkpoint exists in the parent directory.";
                 return false;
             }
+
+            // The geometry is read from the checkpoint
+            frames.emplace_back();
         }
 
-        // Generate output filename(s)
-        std::vector<std::string> input_files = generate_input_filename(xyz_file);
+        if (!compiled_inputs_valid(error_msg))
+        {
+            return false;
+        }
 
         bool all_success = true;
-        for (size_t i = 0; i < input_files.size(); ++i)
+        for (size_t frame = 0; frame < frames.size(); ++frame)
+        {
+            std::string isomer_name = frames.size() > 1 ? stem + "_" + std::to_string(frame + 1) : stem;
+            if (!write_inputs(dir, isomer_name, frames[frame], input_files, error_msg))
+            {
+                all_success = false;
+            }
+        }
+
+        return all_success;
+    }
+    catch (const std::exception& e)
+    {
+        error_msg = e.what();
+        return false;
+    }
+}
+
+void CreateInput::create_from_trajectory(const std::string& xyz_file, CreateSummary& summary)
+{
+    std::filesystem::path path(xyz_file);
+    std::filesystem::path dir  = path.parent_path();
+    std::string           stem = path.stem().string();
+
+    std::mutex                  results_mutex;  // Guards batches and the counters below
+    std::deque<TrajectoryBatch> batches;
+    size_t                      frame_count = 0;
+    size_t                      created     = 0;
+    std::vector<std::string>    errors;
+
+    auto fail = [&](const std::string& error_msg) {
+        std::lock_guard<std::mutex> lock(results_mutex);
+        errors.push_back(error_msg);
+    };
+
+    // Each task writes the inputs of one batch and then releases it
+    auto write_batch = [&](size_t index) {
+        TrajectoryBatch batch;
         {
-            const auto& input_file = input_files[i];
+            std::lock_guard<std::mutex> lock(results_mutex);
+            batch = std::move(batches[index]);
+        }
 
-            // Generate appropriate content for IRC calculations
-            std::string content;
-            if (calc_type_ == CalculationType::IRC)
+        auto file_guard = context->file_manager->acquire();
+        if (!file_guard.is_acquired())
+        {
+            fail("Could not acquire a file handle");
+            return;
+        }
+
+        thread_local std::string terminated;  // Last frame of a file without final newline
+        std::vector<std::string> input_files;
+        std::string              error_msg;
+        for (size_t i = 0; i < batch.frames.size(); ++i)
+        {
+            std::string_view coordinates = batch.frames[i];
+            if (coordinates.back() != '\n')
             {
-                // For combined IRC, determine if this is forward or reverse based on filename
-                bool            is_forward = input_file.find("F" + extension_) != std::string::npos;
-                CalculationType temp_type  = is_forward ? CalculationType::IRC_FORWARD : CalculationType::IRC_REVERSE;
-
-                // Temporarily set calculation type for content generation
-                CalculationType original_type = calc_type_;
-                calc_type_                    = temp_type;
-                content                       = generate_input_content(isomer_name, coordinates);
-                calc_type_                    = original_type;
+                terminated.assign(coordinates.data(), coordinates.size());
+                terminated += '\n';
+                coordinates = terminated;
             }
-            else if (calc_type_ == CalculationType::IRC_FORWARD || calc_type_ == CalculationType::IRC_REVERSE)
+
+            std::string isomer_name = stem + "_" + std::to_string(batch.first_frame + i + 1);
+            if (!write_inputs(dir, isomer_name, coordinates, input_files, error_msg))
             {
-                content = generate_input_content(isomer_name, coordinates);
+                fail(error_msg);
             }
-            else
+        }
+
+        std::lock_guard<std::mutex> lock(results_mutex);
+        created += input_files.size();
+    };
+
+    try
+    {
+        std::string error_msg;
+        if (!compiled_inputs_valid(error_msg))
+        {
+            throw std::runtime_error(error_msg);
+        }
+
+        // Mapped files are split in place; otherwise the file is read block by block
+        MappedFile                              mapped(xyz_file);
+        std::ifstream                           stream;
+        std::shared_ptr<const TrajectoryBlock> block;
+        std::string_view                        text   = mapped.view();
+        bool                                    at_end = mapped.is_mapped();
+        if (!at_end)
+        {
+            stream.open(xyz_file, std::ios::binary);
+            if (!stream.is_open())
             {
-                content = generate_input_content(isomer_name, coordinates);
+                throw std::runtime_error("Cannot open file");
             }
+        }
 
-            // Check if input file already exists
-            if (std::filesystem::exists(input_file))
+        // Move the unfinished frame at carry_from to the start of a new block and read more
+        auto read_block = [&](size_t carry_from) {
+            std::string carry(text.substr(carry_from));
+            block.reset();  // Released once the workers are done with its frames
+
+            auto next = std::make_shared<TrajectoryBlock>();
+            if (context->memory_monitor)
             {
-                if (!quiet_mode)
+                next->memory = context->memory_monitor->reserve(carry.size() + TRAJECTORY_BLOCK_BYTES);
+                if (!next->memory.is_acquired())
                 {
-                    std::cout << input_file << " exists and will not be overwritten." << std::endl;
+                    return false;
                 }
-                continue;  // Skip this file
             }
 
-            // Write input file
-            if (!write_input_file(input_file, content))
+            next->text = std::move(carry);
+            size_t kept = next->text.size();
+            next->text.resize(kept + TRAJECTORY_BLOCK_BYTES);
+            stream.read(&next->text[kept], static_cast<std::streamsize>(TRAJECTORY_BLOCK_BYTES));
+            next->text.resize(kept + static_cast<size_t>(stream.gcount()));
+            at_end = stream.eof();
+
+            block = std::move(next);
+            text  = block->text;
+            return true;
+        };
+
+        auto producer = [&](const TaskExecutor::Submit& submit) {
+            TrajectoryBatch batch{block, {}, 0};
+            auto            flush = [&] {
+                if (!batch.frames.empty())
+                {
+                    size_t index;
+                    {
+                        std::lock_guard<std::mutex> lock(results_mutex);
+                        batches.push_back(std::move(batch));
+                        index = batches.size() - 1;
+                    }
+                    submit(index);
+                }
+                batch = TrajectoryBatch{block, {}, frame_count};
+            };
+
+            if (!at_end && !read_block(0))
             {
-                error_msg   = "Failed to write input file: " + input_file;
-                all_success = false;
+                return;
             }
-            else if (!quiet_mode)
+            batch.block = block;
+
+            size_t pos = 0;
+            while (!g_shutdown_requested.load())
             {
-                std::cout << input_file << " was newly created." << std::endl;
+                pos = skip_blank_lines(text, pos, at_end);
+                if (pos == text.size() && at_end)
+                {
+                    break;
+                }
+
+                size_t     body;
+                size_t     end;
+                FrameState state = scan_frame(text, pos, at_end, body, end);
+                if (state == FrameState::COMPLETE)
+                {
+                    batch.frames.push_back(text.substr(body, end - body));
+                    frame_count++;
+                    pos = end;
+                    if (batch.frames.size() == TRAJECTORY_FRAMES_PER_TASK)
+                    {
+                        flush();
+                    }
+                }
+                else if (state == FrameState::INCOMPLETE && !at_end)
+                {
+                    flush();
+                    if (!read_block(pos))
+                    {
+                        return;
+                    }
+                    batch.block = block;
+                    pos         = 0;
+                }
+                else
+                {
+                    fail((state == FrameState::INVALID ? "Malformed frame " : "Incomplete frame ") +
+                         std::to_string(frame_count + 1) + " in multi-frame XYZ file");
+                    break;
+                }
             }
+            flush();
+        };
+
+        std::error_code ec;
+        uintmax_t       file_size   = std::filesystem::file_size(xyz_file, ec);
+        uintmax_t       task_guess  = ec ? 1 : file_size / (64 * 1024) + 1;
+        unsigned int    num_threads = calculateSafeThreadCount(
+            context->requested_threads ? context->requested_threads : 0,
+            static_cast<unsigned int>(std::min<uintmax_t>(task_guess, std::numeric_limits<unsigned int>::max())),
+            context->job_resources);
+
+        if (!quiet_mode)
+        {
+            std::cout << "Streaming frames of " << xyz_file << " using " << num_threads << " threads" << std::endl;
         }
-
-        return all_success;
+        TaskExecutor::shared(num_threads).run_streaming(producer, write_batch);
     }
     catch (const std::exception& e)
     {
-        error_msg = e.what();
-        return false;
+        errors.push_back(e.what());
+    }
+
+    summary.processed_files++;
+    summary.created_files += created;
+    if (!errors.empty())
+    {
+        summary.failed_files++;
+        for (const auto& error_msg : errors)
+        {
+            summary.errors.push_back("Error creating input for " + xyz_file + ": " + error_msg);
+        }
+    }
+    if (!quiet_mode)
+    {
+        std::cout << xyz_file << ": " << frame_count << " frames" << std::endl;
     }
 }
 
@@ -822,36 +1302,39 @@ std::string CreateInput::generate_molecule_section(const std::string& coordinate
     return molecule.str();
 }
 
-std::string CreateInput::read_xyz_coordinates(const std::string& xyz_file)
+bool CreateInput::read_xyz_frames(const std::string&             xyz_file,
+                                  std::string&                   contents,
+                                  std::vector<std::string_view>& frames,
+                                  std::string&                   error_msg)
 {
     std::ifstream file(xyz_file);
     if (!file.is_open())
     {
-        return "";
+        error_msg = "Failed to read coordinates from XYZ file";
+        return false;
     }
 
-    std::string              line;
-    std::vector<std::string> lines;
-
-    // Read all lines
-    while (std::getline(file, line))
-    {
-        lines.push_back(line);
-    }
+    // One read of the whole file into the reused buffer
+    file.seekg(0, std::ios::end);
+    std::streamoff size = file.tellg();
+    file.seekg(0, std::ios::beg);
+    contents.resize(size > 0 ? static_cast<size_t>(size) : 0);
+    file.read(&contents[0], static_cast<std::streamsize>(contents.size()));
+    contents.resize(static_cast<size_t>(file.gcount()));
 
-    if (lines.size() < 3)
+    // Lines are terminated like getline() read them, including the last one
+    if (!contents.empty() && contents.back() != '\n')
     {
-        return "";
+        contents.push_back('\n');
     }
 
-    // Skip first two lines (atom count and comment), join the rest
-    std::ostringstream coords;
-    for (size_t i = 2; i < lines.size(); ++i)
+    split_xyz_frames(contents, frames);
+    if (frames.empty())
     {
-        coords << lines[i] << "\n";
+        error_msg = "Failed to read coordinates from XYZ file";
+        return false;
     }
-
-    return coords.str();
+    return true;
 }
 
 bool CreateInput::write_input_file(const std::string& input_path, const std::string& content)
@@ -862,37 +1345,9 @@ bool CreateInput::write_input_file(const std::string& input_path, const std::str
         return false;
     }
 
-    file << content;
+    file.write(content.data(), static_cast<std::streamsize>(content.size()));
     file.close();
-    return true;
-}
-
-std::vector<std::string> CreateInput::generate_input_filename(const std::string& xyz_file)
-{
-    std::filesystem::path path(xyz_file);
-    std::filesystem::path dir  = path.parent_path();
-    std::string           stem = path.stem().string();
-
-    if (calc_type_ == CalculationType::IRC)
-    {
-        // Combined IRC creates two files: forward and reverse
-        std::vector<std::string> files;
-        files.push_back((dir / (stem + "F" + extension_)).string());
-        files.push_back((dir / (stem + "R" + extension_)).string());
-        return files;
-    }
-    else if (calc_type_ == CalculationType::IRC_FORWARD)
-    {
-        return {(dir / (stem + "F" + extension_)).string()};
-    }
-    else if (calc_type_ == CalculationType::IRC_REVERSE)
-    {
-        return {(dir / (stem + "R" + extension_)).string()};
-    }
-    else
-    {
-        return {(dir / (stem + extension_)).string()};
-    }
+    return !file.fail();
 }
 
 void CreateInput::report_progress(size_t current, size_t total)
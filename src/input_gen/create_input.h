@@ -12,8 +12,11 @@
 #define CREATE_INPUT_H
 
 #include "extraction/gaussian_extractor.h"
+#include "input_template.h"
+#include <filesystem>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 
 /**
@@ -78,6 +81,19 @@ struct CreateSummary
  * @section CreateInput Usage
  * The class processes XYZ files and creates corresponding Gaussian input files
  * with appropriate route sections, molecular specifications, and coordinate data.
+ *
+ * @section Templates
+ * create_inputs() generates the input layout once from the parameters
+ * (an InputTemplate per output file of a structure), so each XYZ file only
+ * costs one read, the copy of its name and coordinates into a reused buffer
+ * and one write. An XYZ file holding several complete frames (conformer
+ * ensembles, trajectories) yields one input per frame, named
+ * <stem>_1, <stem>_2, ...
+ *
+ * @section Trajectories
+ * Multi-frame files of at least 1 MiB are not read as a whole by one
+ * worker: create_from_trajectory() streams them and spreads their frames
+ * over the worker threads.
  */
 class CreateInput
 {
@@ -331,12 +347,70 @@ private:
     int irc_stepsize_;   ///< Override for IRC StepSize
 
     /**
-     * @brief Create input file from single XYZ file
+     * @struct CompiledInput
+     * @brief One input file written per structure, precompiled from the parameters
+     */
+    struct CompiledInput
+    {
+        std::string   name_suffix;  ///< Appended to the isomer name in the file name ("F"/"R" for IRC)
+        InputTemplate layout;       ///< Input content with name and coordinate slots
+        std::string   error;        ///< Parameter validation failure ("" if valid)
+    };
+
+    std::vector<CompiledInput> compiled_inputs_;  ///< Built by compile_inputs()
+
+    /**
+     * @brief Precompile the inputs of the current parameters into compiled_inputs_
+     *
+     * Validation errors are kept per input and reported for every file, as
+     * when the content was generated file by file.
+     */
+    void compile_inputs();
+
+    /**
+     * @brief Check that every compiled input passed parameter validation
+     * @param error_msg Set to the first validation error
+     * @return true if all inputs can be written
+     */
+    bool compiled_inputs_valid(std::string& error_msg) const;
+
+    /**
+     * @brief Write the compiled inputs of one structure
+     * @param dir Directory of the XYZ file
+     * @param isomer_name Name of the structure
+     * @param coordinates Coordinate block, ending in a newline
+     * @param input_files Receives the input paths (including existing ones that were kept)
+     * @param error_msg Set when an input cannot be written
+     * @return true if no write failed
+     */
+    bool write_inputs(const std::filesystem::path& dir,
+                      const std::string&           isomer_name,
+                      std::string_view             coordinates,
+                      std::vector<std::string>&    input_files,
+                      std::string&                 error_msg);
+
+    /**
+     * @brief Stream a large multi-frame XYZ file and write the inputs of its frames in parallel
+     * @param xyz_file Path to the XYZ file
+     * @param summary Summary receiving the counts and errors of the file
+     *
+     * The file is memory-mapped when possible and otherwise read in blocks.
+     * The calling thread finds the frame boundaries as it goes and hands
+     * batches of frames to the shared executor, so the file is read once,
+     * sequentially, and never held in memory as a whole when it is not
+     * mapped. A malformed or truncated frame ends the file with an error;
+     * the inputs of the frames before it are kept.
+     */
+    void create_from_trajectory(const std::string& xyz_file, CreateSummary& summary);
+
+    /**
+     * @brief Create input file(s) from single XYZ file
      * @param xyz_file Path to XYZ file
+     * @param input_files Receives the input paths of the file (including existing ones that were kept)
      * @param error_msg Error message output
      * @return true if successful, false otherwise
      */
-    bool create_from_file(const std::string& xyz_file, std::string& error_msg);
+    bool create_from_file(const std::string& xyz_file, std::vector<std::string>& input_files, std::string& error_msg);
 
     /**
      * @brief Generate Gaussian input content
@@ -382,11 +456,21 @@ private:
     std::string generate_route_for_single_section_calc_type(CalculationType type, const std::string& isomer_name);
 
     /**
-     * @brief Read coordinates from XYZ file
+     * @brief Read the coordinate blocks of an XYZ file
      * @param xyz_file Path to XYZ file
-     * @return Coordinate data as string
+     * @param contents Buffer receiving the file; its capacity is reused
+     * @param frames Receives one coordinate block per frame, viewing into contents
+     * @param error_msg Error message output
+     * @return true if at least one coordinate block was found
+     *
+     * A file made of two or more complete frames (atom count, comment, that
+     * many atom lines) is split into frames. Any other file is a single
+     * structure: everything after the first two lines.
      */
-    std::string read_xyz_coordinates(const std::string& xyz_file);
+    bool read_xyz_frames(const std::string&             xyz_file,
+                         std::string&                   contents,
+                         std::vector<std::string_view>& frames,
+                         std::string&                   error_msg);
 
     /**
      * @brief Write input file to disk
@@ -396,13 +480,6 @@ private:
      */
     bool write_input_file(const std::string& input_path, const std::string& content);
 
-    /**
-     * @brief Generate output filename(s) from XYZ filename
-     * @param xyz_file Input XYZ file path
-     * @return Vector of output input file paths
-     */
-    std::vector<std::string> generate_input_filename(const std::string& xyz_file);
-
     /**
      * @brief Report progress during processing
      * @param current Current file index
@@ -0,0 +1,48 @@
+/**
+ * @file input_template.cpp
+ * @brief Implementation of the precompiled Gaussian input layout
+ * @author Le Nhan Pham
+ * @date 2025
+ */
+
+#include "input_template.h"
+
+InputTemplate::InputTemplate(const std::string& layout)
+{
+    const char name_marker        = NAME_MARKER[0];
+    const char coordinates_marker = COORDINATES_MARKER[0];
+
+    literals_.emplace_back();
+    for (char c : layout)
+    {
+        if (c == name_marker || c == coordinates_marker)
+        {
+            bool name = c == name_marker;
+            slots_.push_back(name ? Slot::NAME : Slot::COORDINATES);
+            (name ? name_slots_ : coordinate_slots_)++;
+            literals_.emplace_back();
+        }
+        else
+        {
+            literals_.back() += c;
+            literal_size_++;
+        }
+    }
+}
+
+void InputTemplate::render(std::string& out, std::string_view name, std::string_view coordinates) const
+{
+    out.clear();
+    if (literals_.empty())
+    {
+        return;
+    }
+
+    out.reserve(literal_size_ + name_slots_ * name.size() + coordinate_slots_ * coordinates.size());
+    out += literals_[0];
+    for (size_t i = 0; i < slots_.size(); ++i)
+    {
+        out += slots_[i] == Slot::NAME ? name : coordinates;
+        out += literals_[i + 1];
+    }
+}
@@ -0,0 +1,77 @@
+/**
+ * @file input_template.h
+ * @brief Precompiled Gaussian input layout with slots for the per-structure parts
+ * @author Le Nhan Pham
+ * @date 2025
+ *
+ * This header provides the template used by CreateInput. Everything in a
+ * generated input except the isomer name (checkpoint names, %OldChk paths)
+ * and the coordinate block depends only on the calculation parameters, so it
+ * is generated once per command with marker strings in place of those two
+ * parts and split into literal text and slots. Each structure then only costs
+ * copying the literals, its name and its coordinates into a reused buffer.
+ *
+ * @section Markers
+ * The markers are ASCII control characters that cannot appear in parameter
+ * files or on the command line, so the existing section generators can be
+ * reused unchanged to produce the layout.
+ */
+
+#ifndef INPUT_TEMPLATE_H
+#define INPUT_TEMPLATE_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @class InputTemplate
+ * @brief Immutable input layout made of literal text, name slots and coordinate slots
+ */
+class InputTemplate
+{
+public:
+    static constexpr const char* NAME_MARKER        = "\x1e";  ///< Stands for the isomer name
+    static constexpr const char* COORDINATES_MARKER = "\x1f";  ///< Stands for the coordinate block
+
+    InputTemplate() = default;
+
+    /**
+     * @brief Split a layout generated with the markers into literals and slots
+     * @param layout Input content generated with NAME_MARKER and COORDINATES_MARKER
+     */
+    explicit InputTemplate(const std::string& layout);
+
+    /**
+     * @brief Fill the slots of the template
+     * @param out Buffer receiving the input content; its capacity is reused
+     * @param name Isomer name
+     * @param coordinates Coordinate block, one atom per line including the final newline
+     */
+    void render(std::string& out, std::string_view name, std::string_view coordinates) const;
+
+    /**
+     * @brief Whether the layout contains the coordinate block
+     *
+     * Geom(AllCheck) inputs read the geometry from the checkpoint and have none.
+     */
+    bool uses_coordinates() const
+    {
+        return coordinate_slots_ > 0;
+    }
+
+private:
+    enum class Slot
+    {
+        NAME,
+        COORDINATES
+    };
+
+    std::vector<std::string> literals_;              ///< Text around the slots (one more than slots_)
+    std::vector<Slot>        slots_;                 ///< Slot between literals_[i] and literals_[i + 1]
+    size_t                   literal_size_     = 0;  ///< Combined size of the literals
+    size_t                   name_slots_       = 0;  ///< Number of name slots
+    size_t                   coordinate_slots_ = 0;  ///< Number of coordinate slots
+};
+
+#endif  // INPUT_TEMPLATE_H
@@ -1,5 +1,12 @@
 #include "job_checker.h"
+#include "extraction/log_scanner.h"
+#include "utilities/compressed_input.h"
 #include "utilities/config_manager.h"
+#include "utilities/move_planner.h"
+#include "utilities/profiler.h"
+#include "utilities/result_index.h"
+#include "utilities/task_executor.h"
+#include "utilities/utils.h"
 #include <iostream>
 #include <iomanip>
 #include <algorithm>
@@ -8,10 +15,21 @@
 #include <mutex>
 #include <atomic>
 #include <filesystem>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string_view>
+
+// Message Gaussian writes when the PCM cavity setup fails
+static const std::string PCM_FAILURE_MARKER = "failed in PCMMkU";
+
+// Read size for file_contains(); bounds memory per thread regardless of log size
+static const size_t SEARCH_CHUNK_SIZE = 1024 * 1024;
 
 // JobChecker Implementation
-JobChecker::JobChecker(std::shared_ptr<ProcessingContext> ctx, bool quiet, bool show_details)
-    : context(ctx), quiet_mode(quiet), show_error_details(show_details) {}
+JobChecker::JobChecker(std::shared_ptr<ProcessingContext> ctx, bool quiet, bool show_details,
+                       const MoveOptions& moves)
+    : context(ctx), quiet_mode(quiet), show_error_details(show_details), move_options(moves) {}
 
 CheckSummary JobChecker::check_completed_jobs(const std::vector<std::string>& log_files,
                                              const std::string& target_dir_suffix) {
@@ -22,7 +40,7 @@ CheckSummary JobChecker::check_completed_jobs(const std::vector<std::string>& lo
 
     // Create target directory (current_dir-suffix)
     std::string target_dir = get_current_directory_name() + "-" + target_dir_suffix;
-    if (!create_target_directory(target_dir)) {
+    if (!move_options.dry_run && !create_target_directory(target_dir)) {
         summary.errors.push_back("Failed to create target directory: " + target_dir);
         return summary;
     }
@@ -35,7 +53,6 @@ CheckSummary JobChecker::check_completed_jobs(const std::vector<std::string>& lo
     // Thread-safe containers
     std::vector<JobCheckResult> completed_jobs;
     std::mutex results_mutex;
-    std::atomic<size_t> file_index{0};
 
     // Calculate safe thread count
     unsigned int num_threads = calculateSafeThreadCount(context->requested_threads,
@@ -47,46 +64,36 @@ CheckSummary JobChecker::check_completed_jobs(const std::vector<std::string>& lo
     }
 
     // Process files in parallel
-    std::vector<std::thread> threads;
-    for (unsigned int i = 0; i < num_threads; ++i) {
-        threads.emplace_back([&]() {
-            size_t index;
-            while ((index = file_index.fetch_add(1)) < log_files.size()) {
-                if (g_shutdown_requested.load()) break;
-
-                try {
-                    auto file_guard = context->file_manager->acquire();
-                    if (!file_guard.is_acquired()) continue;
-
-                    JobCheckResult result = check_job_status(log_files[index]);
-
-                    {
-                        std::lock_guard<std::mutex> lock(results_mutex);
-                        summary.processed_files++;
-
-                        if (result.status == JobStatus::COMPLETED) {
-                            completed_jobs.push_back(result);
-                            summary.matched_files++;
-                        }
-                    }
-
-                    // Report progress
-                    if (!quiet_mode && summary.processed_files % 50 == 0) {
-                        report_progress(summary.processed_files, summary.total_files, "checking");
-                    }
-
-                } catch (const std::exception& e) {
-                    std::lock_guard<std::mutex> lock(results_mutex);
-                    summary.errors.push_back("Error checking " + log_files[index] + ": " + e.what());
+    auto process_file = [&](size_t index) {
+        try {
+            auto file_guard = context->file_manager->acquire();
+            if (!file_guard.is_acquired()) return;
+
+            JobCheckResult result = check_job_status(log_files[index]);
+
+            {
+                auto lock = Profiler::lock(results_mutex);
+                summary.processed_files++;
+
+                if (result.status == JobStatus::COMPLETED) {
+                    completed_jobs.push_back(result);
+                    summary.matched_files++;
                 }
             }
-        });
-    }
 
-    // Wait for completion
-    for (auto& thread : threads) {
-        thread.join();
-    }
+            // Report progress
+            if (!quiet_mode && summary.processed_files % 50 == 0) {
+                report_progress(summary.processed_files, summary.total_files, "checking");
+            }
+
+        } catch (const std::exception& e) {
+            auto lock = Profiler::lock(results_mutex);
+            summary.errors.push_back("Error checking " + log_files[index] + ": " + e.what());
+        }
+    };
+
+    index_related_files(log_files);
+    TaskExecutor::shared(num_threads).run(log_files.size(), process_file, TaskExecutor::file_sizes(log_files));
 
     if (!quiet_mode && summary.processed_files > 0) {
         report_progress(summary.processed_files, summary.total_files, "checking");
@@ -97,14 +104,22 @@ CheckSummary JobChecker::check_completed_jobs(const std::vector<std::string>& lo
     if (!completed_jobs.empty()) {
         if (!quiet_mode) {
             std::cout << "Found " << completed_jobs.size() << " completed jobs" << std::endl;
-            std::cout << "Moving files to " << target_dir << "/" << std::endl;
+            std::cout << (move_options.dry_run ? "Would move files to " : "Moving files to ") << target_dir << "/"
+                      << std::endl;
         }
 
+        MovePlanner planner(move_options);
         for (const auto& job : completed_jobs) {
-            if (move_job_files(job, target_dir)) {
+            planner.add(target_dir, job.filename, job.related_files);
+        }
+        run_moves(planner);
+
+        for (size_t j = 0; j < completed_jobs.size(); ++j) {
+            const auto& job = completed_jobs[j];
+            if (planner.moved(j)) {
                 summary.moved_files++;
                 if (!quiet_mode) {
-                    std::cout << job.filename << " done" << std::endl;
+                    std::cout << job.filename << (move_options.dry_run ? " would be moved" : " done") << std::endl;
                 }
             } else {
                 summary.failed_moves++;
@@ -128,7 +143,7 @@ CheckSummary JobChecker::check_error_jobs(const std::vector<std::string>& log_fi
     auto start_time = std::chrono::high_resolution_clock::now();
 
     // Create target directory
-    if (!create_target_directory(target_dir)) {
+    if (!move_options.dry_run && !create_target_directory(target_dir)) {
         summary.errors.push_back("Failed to create target directory: " + target_dir);
         return summary;
     }
@@ -141,7 +156,6 @@ CheckSummary JobChecker::check_error_jobs(const std::vector<std::string>& log_fi
     // Thread-safe containers
     std::vector<JobCheckResult> error_jobs;
     std::mutex results_mutex;
-    std::atomic<size_t> file_index{0};
 
     // Calculate safe thread count
     unsigned int num_threads = calculateSafeThreadCount(context->requested_threads,
@@ -153,47 +167,37 @@ CheckSummary JobChecker::check_error_jobs(const std::vector<std::string>& log_fi
     }
 
     // Process files in parallel
-    std::vector<std::thread> threads;
-    for (unsigned int i = 0; i < num_threads; ++i) {
-        threads.emplace_back([&]() {
-            size_t index;
-            while ((index = file_index.fetch_add(1)) < log_files.size()) {
-                if (g_shutdown_requested.load()) break;
-
-                try {
-                    auto file_guard = context->file_manager->acquire();
-                    if (!file_guard.is_acquired()) continue;
-
-                    // Use direct error checking (independent of job status)
-                    JobCheckResult result = check_error_directly(log_files[index]);
-
-                    {
-                        std::lock_guard<std::mutex> lock(results_mutex);
-                        summary.processed_files++;
-
-                        if (result.status == JobStatus::ERROR) {
-                            error_jobs.push_back(result);
-                            summary.matched_files++;
-                        }
-                    }
-
-                    // Report progress
-                    if (!quiet_mode && summary.processed_files % 50 == 0) {
-                        report_progress(summary.processed_files, summary.total_files, "checking");
-                    }
-
-                } catch (const std::exception& e) {
-                    std::lock_guard<std::mutex> lock(results_mutex);
-                    summary.errors.push_back("Error checking " + log_files[index] + ": " + e.what());
+    auto process_file = [&](size_t index) {
+        try {
+            auto file_guard = context->file_manager->acquire();
+            if (!file_guard.is_acquired()) return;
+
+            // Use direct error checking (independent of job status)
+            JobCheckResult result = check_error_directly(log_files[index]);
+
+            {
+                auto lock = Profiler::lock(results_mutex);
+                summary.processed_files++;
+
+                if (result.status == JobStatus::ERROR) {
+                    error_jobs.push_back(result);
+                    summary.matched_files++;
                 }
             }
-        });
-    }
 
-    // Wait for completion
-    for (auto& thread : threads) {
-        thread.join();
-    }
+            // Report progress
+            if (!quiet_mode && summary.processed_files % 50 == 0) {
+                report_progress(summary.processed_files, summary.total_files, "checking");
+            }
+
+        } catch (const std::exception& e) {
+            auto lock = Profiler::lock(results_mutex);
+            summary.errors.push_back("Error checking " + log_files[index] + ": " + e.what());
+        }
+    };
+
+    index_related_files(log_files);
+    TaskExecutor::shared(num_threads).run(log_files.size(), process_file, TaskExecutor::file_sizes(log_files));
 
     if (!quiet_mode && summary.processed_files > 0) {
         report_progress(summary.processed_files, summary.total_files, "checking");
@@ -204,11 +208,19 @@ CheckSummary JobChecker::check_error_jobs(const std::vector<std::string>& log_fi
     if (!error_jobs.empty()) {
         if (!quiet_mode) {
             std::cout << "Found " << error_jobs.size() << " error jobs" << std::endl;
-            std::cout << "Moving files to " << target_dir << "/" << std::endl;
+            std::cout << (move_options.dry_run ? "Would move files to " : "Moving files to ") << target_dir << "/"
+                      << std::endl;
         }
 
+        MovePlanner planner(move_options);
         for (const auto& job : error_jobs) {
-            if (move_job_files(job, target_dir)) {
+            planner.add(target_dir, job.filename, job.related_files);
+        }
+        run_moves(planner);
+
+        for (size_t j = 0; j < error_jobs.size(); ++j) {
+            const auto& job = error_jobs[j];
+            if (planner.moved(j)) {
                 summary.moved_files++;
                 if (!quiet_mode || show_error_details) {
                     std::cout << job.filename << ": " << job.error_message << std::endl;
@@ -235,7 +247,7 @@ CheckSummary JobChecker::check_pcm_failures(const std::vector<std::string>& log_
     auto start_time = std::chrono::high_resolution_clock::now();
 
     // Create target directory
-    if (!create_target_directory(target_dir)) {
+    if (!move_options.dry_run && !create_target_directory(target_dir)) {
         summary.errors.push_back("Failed to create target directory: " + target_dir);
         return summary;
     }
@@ -248,7 +260,6 @@ CheckSummary JobChecker::check_pcm_failures(const std::vector<std::string>& log_
     // Thread-safe containers
     std::vector<JobCheckResult> pcm_failed_jobs;
     std::mutex results_mutex;
-    std::atomic<size_t> file_index{0};
 
     // Calculate safe thread count
     unsigned int num_threads = calculateSafeThreadCount(context->requested_threads,
@@ -260,47 +271,37 @@ CheckSummary JobChecker::check_pcm_failures(const std::vector<std::string>& log_
     }
 
     // Process files in parallel
-    std::vector<std::thread> threads;
-    for (unsigned int i = 0; i < num_threads; ++i) {
-        threads.emplace_back([&]() {
-            size_t index;
-            while ((index = file_index.fetch_add(1)) < log_files.size()) {
-                if (g_shutdown_requested.load()) break;
-
-                try {
-                    auto file_guard = context->file_manager->acquire();
-                    if (!file_guard.is_acquired()) continue;
-
-                    // Use direct PCM checking (independent of job status)
-                    JobCheckResult result = check_pcm_directly(log_files[index]);
-
-                    {
-                        std::lock_guard<std::mutex> lock(results_mutex);
-                        summary.processed_files++;
-
-                        if (result.status == JobStatus::PCM_FAILED) {
-                            pcm_failed_jobs.push_back(result);
-                            summary.matched_files++;
-                        }
-                    }
-
-                    // Report progress
-                    if (!quiet_mode && summary.processed_files % 50 == 0) {
-                        report_progress(summary.processed_files, summary.total_files, "checking");
-                    }
-
-                } catch (const std::exception& e) {
-                    std::lock_guard<std::mutex> lock(results_mutex);
-                    summary.errors.push_back("Error checking " + log_files[index] + ": " + e.what());
+    auto process_file = [&](size_t index) {
+        try {
+            auto file_guard = context->file_manager->acquire();
+            if (!file_guard.is_acquired()) return;
+
+            // Use direct PCM checking (independent of job status)
+            JobCheckResult result = check_pcm_directly(log_files[index]);
+
+            {
+                auto lock = Profiler::lock(results_mutex);
+                summary.processed_files++;
+
+                if (result.status == JobStatus::PCM_FAILED) {
+                    pcm_failed_jobs.push_back(result);
+                    summary.matched_files++;
                 }
             }
-        });
-    }
 
-    // Wait for completion
-    for (auto& thread : threads) {
-        thread.join();
-    }
+            // Report progress
+            if (!quiet_mode && summary.processed_files % 50 == 0) {
+                report_progress(summary.processed_files, summary.total_files, "checking");
+            }
+
+        } catch (const std::exception& e) {
+            auto lock = Profiler::lock(results_mutex);
+            summary.errors.push_back("Error checking " + log_files[index] + ": " + e.what());
+        }
+    };
+
+    index_related_files(log_files);
+    TaskExecutor::shared(num_threads).run(log_files.size(), process_file, TaskExecutor::file_sizes(log_files));
 
     if (!quiet_mode && summary.processed_files > 0) {
         report_progress(summary.processed_files, summary.total_files, "checking");
@@ -311,15 +312,24 @@ CheckSummary JobChecker::check_pcm_failures(const std::vector<std::string>& log_
     if (!pcm_failed_jobs.empty()) {
         if (!quiet_mode) {
             std::cout << "Found " << pcm_failed_jobs.size() << " PCM failed jobs" << std::endl;
-            std::cout << "Moving files to " << target_dir << "/" << std::endl;
+            std::cout << (move_options.dry_run ? "Would move files to " : "Moving files to ") << target_dir << "/"
+                      << std::endl;
         }
 
+        MovePlanner planner(move_options);
         for (const auto& job : pcm_failed_jobs) {
-            if (move_job_files(job, target_dir)) {
+            planner.add(target_dir, job.filename, job.related_files);
+        }
+        run_moves(planner);
+
+        for (size_t j = 0; j < pcm_failed_jobs.size(); ++j) {
+            const auto& job = pcm_failed_jobs[j];
+            if (planner.moved(j)) {
                 summary.moved_files++;
                 if (!quiet_mode) {
                     std::cout << job.filename << " " << job.error_message << std::endl;
-                    std::cout << job.filename << " moved to " << target_dir << std::endl;
+                    std::cout << job.filename << (move_options.dry_run ? " would be moved to " : " moved to ") << target_dir
+                              << std::endl;
                 }
             } else {
                 summary.failed_moves++;
@@ -356,9 +366,10 @@ CheckSummary JobChecker::check_all_job_types_optimized(const std::vector<std::st
     std::string error_dir = "errorJobs";
     std::string pcm_dir = "PCMMkU";
 
-    bool dirs_ok = create_target_directory(done_dir) &&
-                   create_target_directory(error_dir) &&
-                   create_target_directory(pcm_dir);
+    bool dirs_ok = move_options.dry_run ||
+                   (create_target_directory(done_dir) &&
+                    create_target_directory(error_dir) &&
+                    create_target_directory(pcm_dir));
 
     if (!dirs_ok) {
         total_summary.errors.push_back("Failed to create one or more target directories");
@@ -370,7 +381,6 @@ CheckSummary JobChecker::check_all_job_types_optimized(const std::vector<std::st
     std::vector<JobCheckResult> error_jobs;
     std::vector<JobCheckResult> pcm_failed_jobs;
     std::mutex results_mutex;
-    std::atomic<size_t> file_index{0};
     std::atomic<size_t> processed_count{0};
 
     // Calculate safe thread count
@@ -383,53 +393,43 @@ CheckSummary JobChecker::check_all_job_types_optimized(const std::vector<std::st
     }
 
     // Process files in parallel with single-pass classification
-    std::vector<std::thread> threads;
-    for (unsigned int i = 0; i < num_threads; ++i) {
-        threads.emplace_back([&]() {
-            size_t index;
-            while ((index = file_index.fetch_add(1)) < log_files.size()) {
-                if (g_shutdown_requested.load()) break;
-
-                try {
-                    auto file_guard = context->file_manager->acquire();
-                    if (!file_guard.is_acquired()) continue;
-
-                    // Single comprehensive status check with priority-based classification
-                    JobCheckResult result = check_job_status(log_files[index]);
-
-                    {
-                        std::lock_guard<std::mutex> lock(results_mutex);
-
-                        // Classify based on priority: completed > error > PCM
-                        if (result.status == JobStatus::COMPLETED) {
-                            completed_jobs.push_back(result);
-                        } else if (result.status == JobStatus::ERROR) {
-                            error_jobs.push_back(result);
-                        } else if (result.status == JobStatus::PCM_FAILED) {
-                            pcm_failed_jobs.push_back(result);
-                        }
-                        // RUNNING and UNKNOWN jobs are not moved
-                    }
-
-                    size_t current = processed_count.fetch_add(1) + 1;
-
-                    // Report progress
-                    if (!quiet_mode && current % 50 == 0) {
-                        report_progress(current, total_summary.total_files, "classifying");
-                    }
-
-                } catch (const std::exception& e) {
-                    std::lock_guard<std::mutex> lock(results_mutex);
-                    total_summary.errors.push_back("Error checking " + log_files[index] + ": " + e.what());
+    auto process_file = [&](size_t index) {
+        try {
+            auto file_guard = context->file_manager->acquire();
+            if (!file_guard.is_acquired()) return;
+
+            // Single comprehensive status check with priority-based classification
+            JobCheckResult result = check_job_status(log_files[index]);
+
+            {
+                auto lock = Profiler::lock(results_mutex);
+
+                // Classify based on priority: completed > error > PCM
+                if (result.status == JobStatus::COMPLETED) {
+                    completed_jobs.push_back(result);
+                } else if (result.status == JobStatus::ERROR) {
+                    error_jobs.push_back(result);
+                } else if (result.status == JobStatus::PCM_FAILED) {
+                    pcm_failed_jobs.push_back(result);
                 }
+                // RUNNING and UNKNOWN jobs are not moved
             }
-        });
-    }
 
-    // Wait for classification to complete
-    for (auto& thread : threads) {
-        thread.join();
-    }
+            size_t current = processed_count.fetch_add(1) + 1;
+
+            // Report progress
+            if (!quiet_mode && current % 50 == 0) {
+                report_progress(current, total_summary.total_files, "classifying");
+            }
+
+        } catch (const std::exception& e) {
+            auto lock = Profiler::lock(results_mutex);
+            total_summary.errors.push_back("Error checking " + log_files[index] + ": " + e.what());
+        }
+    };
+
+    index_related_files(log_files);
+    TaskExecutor::shared(num_threads).run(log_files.size(), process_file, TaskExecutor::file_sizes(log_files));
 
     total_summary.processed_files = processed_count.load();
     total_summary.matched_files = completed_jobs.size() + error_jobs.size() + pcm_failed_jobs.size();
@@ -439,6 +439,70 @@ CheckSummary JobChecker::check_all_job_types_optimized(const std::vector<std::st
         std::cout << std::endl;
     }
 
+    move_all_job_types(completed_jobs, error_jobs, pcm_failed_jobs, done_dir, start_time, total_summary);
+    return total_summary;
+}
+
+CheckSummary JobChecker::organize_classified_jobs(const std::vector<JobCheckResult>& jobs,
+                                                  const std::string& target_dir_suffix) {
+    CheckSummary total_summary;
+    total_summary.total_files = jobs.size();
+    total_summary.processed_files = jobs.size();
+
+    auto start_time = std::chrono::high_resolution_clock::now();
+
+    std::string done_dir = get_current_directory_name() + "-" + target_dir_suffix;
+    bool dirs_ok = move_options.dry_run ||
+                   (create_target_directory(done_dir) &&
+                    create_target_directory("errorJobs") &&
+                    create_target_directory("PCMMkU"));
+
+    if (!dirs_ok) {
+        total_summary.errors.push_back("Failed to create one or more target directories");
+        return total_summary;
+    }
+
+    // Related files are looked up only now, with one listing per directory for the whole batch
+    std::vector<std::string> log_files;
+    log_files.reserve(jobs.size());
+    for (const auto& job : jobs) {
+        log_files.push_back(job.filename);
+    }
+    index_related_files(log_files);
+
+    std::vector<JobCheckResult> completed_jobs;
+    std::vector<JobCheckResult> error_jobs;
+    std::vector<JobCheckResult> pcm_failed_jobs;
+    for (const auto& job : jobs) {
+        // RUNNING and UNKNOWN jobs are not moved
+        std::vector<JobCheckResult>* group = nullptr;
+        if (job.status == JobStatus::COMPLETED) {
+            group = &completed_jobs;
+        } else if (job.status == JobStatus::ERROR) {
+            group = &error_jobs;
+        } else if (job.status == JobStatus::PCM_FAILED) {
+            group = &pcm_failed_jobs;
+        }
+        if (group) {
+            group->push_back(job);
+            group->back().related_files = find_related_files(job.filename);
+        }
+    }
+    total_summary.matched_files = completed_jobs.size() + error_jobs.size() + pcm_failed_jobs.size();
+
+    move_all_job_types(completed_jobs, error_jobs, pcm_failed_jobs, done_dir, start_time, total_summary);
+    return total_summary;
+}
+
+void JobChecker::move_all_job_types(const std::vector<JobCheckResult>& completed_jobs,
+                                    const std::vector<JobCheckResult>& error_jobs,
+                                    const std::vector<JobCheckResult>& pcm_failed_jobs,
+                                    const std::string& done_dir,
+                                    std::chrono::high_resolution_clock::time_point start_time,
+                                    CheckSummary& total_summary) {
+    const std::string error_dir = "errorJobs";
+    const std::string pcm_dir = "PCMMkU";
+
     // Move files in batches
     if (!quiet_mode) {
         std::cout << "\n=== Classification Results ===" << std::endl;
@@ -447,16 +511,30 @@ CheckSummary JobChecker::check_all_job_types_optimized(const std::vector<std::st
         std::cout << "PCM failed jobs found: " << pcm_failed_jobs.size() << std::endl;
     }
 
+    // One plan for all three directories; groups are numbered completed, error, PCM
+    MovePlanner planner(move_options);
+    for (const auto& job : completed_jobs) {
+        planner.add(done_dir, job.filename, job.related_files);
+    }
+    for (const auto& job : error_jobs) {
+        planner.add(error_dir, job.filename, job.related_files);
+    }
+    for (const auto& job : pcm_failed_jobs) {
+        planner.add(pcm_dir, job.filename, job.related_files);
+    }
+    run_moves(planner);
+    size_t group = 0;
+
     // Move completed jobs
     if (!completed_jobs.empty()) {
         if (!quiet_mode) {
-            std::cout << "\nMoving completed jobs to " << done_dir << "/" << std::endl;
+            std::cout << (move_options.dry_run ? "\nWould move completed jobs to " : "\nMoving completed jobs to ") << done_dir << "/" << std::endl;
         }
         for (const auto& job : completed_jobs) {
-            if (move_job_files(job, done_dir)) {
+            if (planner.moved(group++)) {
                 total_summary.moved_files++;
                 if (!quiet_mode) {
-                    std::cout << job.filename << " done" << std::endl;
+                    std::cout << job.filename << (move_options.dry_run ? " would be moved" : " done") << std::endl;
                 }
             } else {
                 total_summary.failed_moves++;
@@ -467,10 +545,10 @@ CheckSummary JobChecker::check_all_job_types_optimized(const std::vector<std::st
     // Move error jobs
     if (!error_jobs.empty()) {
         if (!quiet_mode) {
-            std::cout << "\nMoving error jobs to " << error_dir << "/" << std::endl;
+            std::cout << (move_options.dry_run ? "\nWould move error jobs to " : "\nMoving error jobs to ") << error_dir << "/" << std::endl;
         }
         for (const auto& job : error_jobs) {
-            if (move_job_files(job, error_dir)) {
+            if (planner.moved(group++)) {
                 total_summary.moved_files++;
                 if (!quiet_mode || show_error_details) {
                     std::cout << job.filename << ": " << job.error_message << std::endl;
@@ -484,10 +562,10 @@ CheckSummary JobChecker::check_all_job_types_optimized(const std::vector<std::st
     // Move PCM failed jobs
     if (!pcm_failed_jobs.empty()) {
         if (!quiet_mode) {
-            std::cout << "\nMoving PCM failed jobs to " << pcm_dir << "/" << std::endl;
+            std::cout << (move_options.dry_run ? "\nWould move PCM failed jobs to " : "\nMoving PCM failed jobs to ") << pcm_dir << "/" << std::endl;
         }
         for (const auto& job : pcm_failed_jobs) {
-            if (move_job_files(job, pcm_dir)) {
+            if (planner.moved(group++)) {
                 total_summary.moved_files++;
                 if (!quiet_mode) {
                     std::cout << job.filename << " " << job.error_message << std::endl;
@@ -503,11 +581,13 @@ CheckSummary JobChecker::check_all_job_types_optimized(const std::vector<std::st
 
     if (!quiet_mode) {
         std::cout << "\n=== Overall Summary ===" << std::endl;
-        std::cout << "Completed jobs moved: " << completed_jobs.size() << std::endl;
-        std::cout << "Error jobs moved: " << error_jobs.size() << std::endl;
-        std::cout << "PCM failed jobs moved: " << pcm_failed_jobs.size() << std::endl;
+        const char* moved = move_options.dry_run ? " jobs that would be moved: " : " jobs moved: ";
+        std::cout << "Completed" << moved << completed_jobs.size() << std::endl;
+        std::cout << "Error" << moved << error_jobs.size() << std::endl;
+        std::cout << "PCM failed" << moved << pcm_failed_jobs.size() << std::endl;
         std::cout << "Total files processed: " << total_summary.processed_files << std::endl;
-        std::cout << "Total files moved: " << total_summary.moved_files << std::endl;
+        std::cout << (move_options.dry_run ? "Total files that would be moved: " : "Total files moved: ")
+                  << total_summary.moved_files << std::endl;
         if (total_summary.failed_moves > 0) {
             std::cout << "Failed moves: " << total_summary.failed_moves << std::endl;
         }
@@ -515,7 +595,6 @@ CheckSummary JobChecker::check_all_job_types_optimized(const std::vector<std::st
                   << total_summary.execution_time << " seconds" << std::endl;
     }
 
-    return total_summary;
 }
 
 CheckSummary JobChecker::check_imaginary_frequencies(const std::vector<std::string>& log_files,
@@ -526,7 +605,7 @@ CheckSummary JobChecker::check_imaginary_frequencies(const std::vector<std::stri
 
 
     std::string target_dir = get_current_directory_name() + "-" + target_dir_suffix;
-    if (!create_target_directory(target_dir)) {
+    if (!move_options.dry_run && !create_target_directory(target_dir)) {
         summary.errors.push_back("Failed to create target directory: " + target_dir);
         return summary;
     }
@@ -538,7 +617,6 @@ CheckSummary JobChecker::check_imaginary_frequencies(const std::vector<std::stri
 
     std::vector<JobCheckResult> imag_freq_jobs;
     std::mutex results_mutex;
-    std::atomic<size_t> file_index{0};
 
     unsigned int num_threads = calculateSafeThreadCount(context->requested_threads,
                                                        log_files.size(),
@@ -547,62 +625,41 @@ CheckSummary JobChecker::check_imaginary_frequencies(const std::vector<std::stri
         std::cout << "Using " << num_threads << " threads" << std::endl;
     }
 
-    std::vector<std::thread> threads;
-    for (unsigned int i = 0; i < num_threads; ++i) {
-        threads.emplace_back([&]() {
-            size_t index;
-            while ((index = file_index.fetch_add(1)) < log_files.size()) {
-                if (g_shutdown_requested.load()) break;
-
-                try {
-                    auto file_guard = context->file_manager->acquire();
-                    if (!file_guard.is_acquired()) continue;
-
-                    std::string content = read_file_unified(log_files[index], FileReadMode::FULL);
-                    std::istringstream stream(content);
-                    std::string line;
-                    bool has_imag_freq = false;
-
-                    while (std::getline(stream, line)) {
-                        if (line.find("Frequencies --") != std::string::npos) {
-                            std::string freqs_line = line.substr(line.find("--") + 2);
-                            std::istringstream freq_stream(freqs_line);
-                            double freq;
-                            while (freq_stream >> freq) {
-                                if (freq < 0) {
-                                    has_imag_freq = true;
-                                    break;
-                                }
-                            }
-                        }
-                        if (has_imag_freq) break;
-                    }
-
-                    std::lock_guard<std::mutex> lock(results_mutex);
-                    summary.processed_files++;
-
-                    if (has_imag_freq) {
-                        JobCheckResult result(log_files[index], JobStatus::UNKNOWN);
-                        result.related_files = find_related_files(log_files[index]);
-                        imag_freq_jobs.push_back(result);
-                        summary.matched_files++;
-                    }
-
-                    if (!quiet_mode && summary.processed_files % 50 == 0) {
-                        report_progress(summary.processed_files, summary.total_files, "checking");
-                    }
-
-                } catch (const std::exception& e) {
-                    std::lock_guard<std::mutex> lock(results_mutex);
-                    summary.errors.push_back("Error checking " + log_files[index] + ": " + e.what());
-                }
+    auto process_file = [&](size_t index) {
+        try {
+            // Only the last frequency table is read, in bounded chunks
+            MemoryMonitor::Reservation memory = reserve_memory(2 * LOG_FREQUENCY_CHUNK_BYTES);
+
+            auto file_guard = context->file_manager->acquire();
+            if (!file_guard.is_acquired()) return;
+
+            std::vector<double> frequencies;
+            LogScanner::read_last_frequencies(log_files[index], frequencies);
+            bool has_imag_freq = std::any_of(frequencies.begin(), frequencies.end(),
+                                             [](double freq) { return freq < 0; });
+
+            auto lock = Profiler::lock(results_mutex);
+            summary.processed_files++;
+
+            if (has_imag_freq) {
+                JobCheckResult result(log_files[index], JobStatus::UNKNOWN);
+                result.related_files = find_related_files(log_files[index]);
+                imag_freq_jobs.push_back(result);
+                summary.matched_files++;
             }
-        });
-    }
 
-    for (auto& thread : threads) {
-        thread.join();
-    }
+            if (!quiet_mode && summary.processed_files % 50 == 0) {
+                report_progress(summary.processed_files, summary.total_files, "checking");
+            }
+
+        } catch (const std::exception& e) {
+            auto lock = Profiler::lock(results_mutex);
+            summary.errors.push_back("Error checking " + log_files[index] + ": " + e.what());
+        }
+    };
+
+    index_related_files(log_files);
+    TaskExecutor::shared(num_threads).run(log_files.size(), process_file, TaskExecutor::file_sizes(log_files));
 
     if (!quiet_mode && summary.processed_files > 0) {
         report_progress(summary.processed_files, summary.total_files, "checking");
@@ -612,14 +669,22 @@ CheckSummary JobChecker::check_imaginary_frequencies(const std::vector<std::stri
     if (!imag_freq_jobs.empty()) {
         if (!quiet_mode) {
             std::cout << "Found " << imag_freq_jobs.size() << " jobs with imaginary frequencies" << std::endl;
-            std::cout << "Moving files to " << target_dir << "/" << std::endl;
+            std::cout << (move_options.dry_run ? "Would move files to " : "Moving files to ") << target_dir << "/"
+                      << std::endl;
         }
 
+        MovePlanner planner(move_options);
         for (const auto& job : imag_freq_jobs) {
-            if (move_job_files(job, target_dir)) {
+            planner.add(target_dir, job.filename, job.related_files);
+        }
+        run_moves(planner);
+
+        for (size_t j = 0; j < imag_freq_jobs.size(); ++j) {
+            const auto& job = imag_freq_jobs[j];
+            if (planner.moved(j)) {
                 summary.moved_files++;
                 if (!quiet_mode) {
-                    std::cout << job.filename << " moved" << std::endl;
+                    std::cout << job.filename << (move_options.dry_run ? " would be moved" : " moved") << std::endl;
                 }
             } else {
                 summary.failed_moves++;
@@ -636,9 +701,57 @@ CheckSummary JobChecker::check_imaginary_frequencies(const std::vector<std::stri
 }
 
 
+// Result index section holding job classifications
+static const std::string CHECK_INDEX_SECTION = "check";
+
+static const char* job_status_name(JobStatus status) {
+    switch (status) {
+        case JobStatus::COMPLETED: return "COMPLETED";
+        case JobStatus::ERROR: return "ERROR";
+        case JobStatus::PCM_FAILED: return "PCM_FAILED";
+        case JobStatus::RUNNING: return "RUNNING";
+        default: return "UNKNOWN";
+    }
+}
+
+static bool parse_job_status(const std::string& name, JobStatus& status) {
+    for (JobStatus candidate : {JobStatus::COMPLETED, JobStatus::ERROR, JobStatus::PCM_FAILED, JobStatus::RUNNING}) {
+        if (name == job_status_name(candidate)) {
+            status = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
 JobCheckResult JobChecker::check_job_status(const std::string& log_file) {
     JobCheckResult result(log_file, JobStatus::UNKNOWN);
 
+    // Unchanged logs keep their classification; related files may have changed and are looked up again
+    ResultIndex* index = context ? context->result_index.get() : nullptr;
+    FileStamp stamp;
+    if (index) {
+        std::vector<std::string> fields;
+        if (index->lookup(CHECK_INDEX_SECTION, log_file, stamp, fields) && fields.size() == 2 &&
+            parse_job_status(fields[0], result.status)) {
+            result.error_message = fields[1];
+            if (result.status != JobStatus::RUNNING) {
+                result.related_files = find_related_files(log_file);
+            }
+            return result;
+        }
+    }
+
+    result = classify_job(log_file);
+    if (index && result.status != JobStatus::UNKNOWN) {
+        index->store(CHECK_INDEX_SECTION, log_file, stamp, {job_status_name(result.status), result.error_message});
+    }
+    return result;
+}
+
+JobCheckResult JobChecker::classify_job(const std::string& log_file) {
+    JobCheckResult result(log_file, JobStatus::UNKNOWN);
+
     try {
         // Use unified reading with TAIL mode for efficiency
         std::string tail_content = read_file_unified(log_file, FileReadMode::TAIL, 10);
@@ -659,9 +772,8 @@ JobCheckResult JobChecker::check_job_status(const std::string& log_file) {
             return result;
         }
 
-        // Check for PCM failure - use FULL mode since pattern can be anywhere
-        std::string full_content = read_file_unified(log_file, FileReadMode::FULL);
-        if (check_pcm_failure(full_content)) {
+        // Check for PCM failure - pattern can be anywhere, so scan the whole file in chunks
+        if (file_contains(log_file, PCM_FAILURE_MARKER)) {
             result.status = JobStatus::PCM_FAILED;
             result.error_message = "failed in PCMMkU";
             result.related_files = find_related_files(log_file);
@@ -679,6 +791,26 @@ JobCheckResult JobChecker::check_job_status(const std::string& log_file) {
     return result;
 }
 
+JobCheckResult JobChecker::classify_content(const std::string& log_file, std::string_view content) {
+    JobCheckResult result(log_file, JobStatus::UNKNOWN);
+
+    // Same rules and priority as classify_job(), applied to the content instead of reads of the file
+    std::string tail_content(Utils::tail_lines(content, 10));
+    std::string error_msg;
+    if (check_normal_termination(tail_content)) {
+        result.status = JobStatus::COMPLETED;
+    } else if (check_error_termination(tail_content, error_msg)) {
+        result.status = JobStatus::ERROR;
+        result.error_message = error_msg;
+    } else if (content.find(PCM_FAILURE_MARKER) != std::string_view::npos) {
+        result.status = JobStatus::PCM_FAILED;
+        result.error_message = "failed in PCMMkU";
+    } else {
+        result.status = JobStatus::RUNNING;
+    }
+    return result;
+}
+
 bool JobChecker::check_normal_termination(const std::string& content) {
     // Look for "Normal" - matches bash: grep Normal
     return content.find("Normal") != std::string::npos;
@@ -751,7 +883,7 @@ bool JobChecker::check_error_termination(const std::string& content, std::string
 
 bool JobChecker::check_pcm_failure(const std::string& content) {
     // Look for "failed in PCMMkU" - matches bash: grep "failed in PCMMkU"
-    return content.find("failed in PCMMkU") != std::string::npos;
+    return content.find(PCM_FAILURE_MARKER) != std::string::npos;
 }
 
 // Independent error checking - matches bash script exactly
@@ -838,9 +970,69 @@ std::string JobChecker::read_file_content(const std::string& filename) {
     return read_file_unified(filename, FileReadMode::FULL);
 }
 
+MemoryMonitor::Reservation JobChecker::reserve_memory(size_t bytes) {
+    if (!context || !context->memory_monitor) {
+        return MemoryMonitor::Reservation();
+    }
+    return context->memory_monitor->reserve(bytes);
+}
+
+bool JobChecker::file_contains(const std::string& filename, const std::string& pattern) {
+    Profiler::Scope read(Profiler::Phase::READ);
+    std::unique_ptr<std::istream> stream = CompressedInput::open(filename);
+    std::istream& file = *stream;
+    if (!file) {
+        throw std::runtime_error("Cannot open file: " + filename);
+    }
+    if (pattern.empty()) {
+        return true;
+    }
+
+    // Each read lands after the tail of the previous chunk that could start a match
+    const size_t overlap = pattern.size() - 1;
+    MemoryMonitor::Reservation memory = reserve_memory(overlap + SEARCH_CHUNK_SIZE);
+    std::vector<char> buffer(overlap + SEARCH_CHUNK_SIZE);
+    size_t carried = 0;
+
+    while (!g_shutdown_requested.load(std::memory_order_relaxed)) {
+        file.read(buffer.data() + carried, static_cast<std::streamsize>(SEARCH_CHUNK_SIZE));
+        size_t got = static_cast<size_t>(file.gcount());
+        if (got == 0) {
+            break;
+        }
+        Profiler::add(Profiler::Counter::BYTES_READ, got);
+
+        size_t filled = carried + got;
+        std::string_view window(buffer.data(), filled);
+        if (window.find(pattern) != std::string_view::npos) {
+            return true;
+        }
+
+        carried = std::min(overlap, filled);
+        std::memmove(buffer.data(), buffer.data() + filled - carried, carried);
+    }
+    return false;
+}
+
 std::string JobChecker::read_file_unified(const std::string& filename,
                                           FileReadMode mode,
                                           size_t tail_lines) {
+    Profiler::Scope read(Profiler::Phase::READ);
+    std::string content = read_log_text(filename, mode, tail_lines);
+    Profiler::add(Profiler::Counter::BYTES_READ, content.size());
+    return content;
+}
+
+std::string JobChecker::read_log_text(const std::string& filename,
+                                      FileReadMode mode,
+                                      size_t tail_lines) {
+    if (CompressedInput::is_compressed(filename)) {
+        if (mode == FileReadMode::FULL) {
+            return CompressedInput::read_all(filename);
+        }
+        return CompressedInput::read_tail_lines(filename, tail_lines);
+    }
+
     std::ifstream file(filename, std::ios::binary | std::ios::ate);
     if (!file.is_open()) {
         throw std::runtime_error("Cannot open file: " + filename);
@@ -922,7 +1114,23 @@ std::string JobChecker::read_file_unified(const std::string& filename,
 std::vector<std::string> JobChecker::find_related_files(const std::string& log_file) {
     std::vector<std::string> related_files;
     std::string base_name_with_path = extract_base_name(log_file); // This returns path/filename_without_ext
-    std::filesystem::path log_path(log_file); // For getting the log file's extension
+    std::filesystem::path log_path(CompressedInput::strip_suffix(log_file)); // For getting the log file's extension
+    std::string log_extension = log_path.extension().string();
+
+    // Answer from the directory listing when the log's directory was indexed
+    std::string parent = log_path.parent_path().string();
+    if (indexed_directories.count(parent)) {
+        auto it = related_index.find(base_name_with_path);
+        if (it == related_index.end()) {
+            return related_files;
+        }
+        for (const auto& ext : related_extensions) {
+            if (log_extension != ext && std::find(it->second.begin(), it->second.end(), ext) != it->second.end()) {
+                related_files.push_back(base_name_with_path + ext);
+            }
+        }
+        return related_files;
+    }
 
     // Get input extensions from the global config manager
     std::vector<std::string> input_extensions = g_config_manager.get_input_extensions();
@@ -934,7 +1142,7 @@ std::vector<std::string> JobChecker::find_related_files(const std::string& log_f
         std::string related_file = base_name_with_path + ext;
 
         // Avoid adding the log file itself if its extension matches an input extension
-        if (log_path.extension().string() == ext) {
+        if (log_extension == ext) {
             continue;
         }
 
@@ -946,8 +1154,48 @@ std::vector<std::string> JobChecker::find_related_files(const std::string& log_f
     return related_files;
 }
 
+void JobChecker::index_related_files(const std::vector<std::string>& log_files) {
+    related_extensions = g_config_manager.get_input_extensions();
+    related_extensions.push_back(".chk");
+    related_index.clear();
+    indexed_directories.clear();
+
+    std::unordered_set<std::string> wanted(related_extensions.begin(), related_extensions.end());
+    for (const auto& log_file : log_files) {
+        std::string parent = std::filesystem::path(log_file).parent_path().string();
+        if (!indexed_directories.insert(parent).second) {
+            continue;
+        }
+
+        // One listing per directory; entry names only, no stat per file
+        std::error_code ec;
+        std::filesystem::path directory = parent.empty() ? std::filesystem::path(".") : std::filesystem::path(parent);
+        std::filesystem::directory_iterator it(directory, ec);
+        if (ec) {
+            indexed_directories.erase(parent);  // Fall back to probing for this directory
+            continue;
+        }
+        for (; it != std::filesystem::directory_iterator(); it.increment(ec)) {
+            if (ec) {
+                break;
+            }
+            const std::filesystem::path& path = it->path();
+            std::string extension = path.extension().string();
+            if (!wanted.count(extension)) {
+                continue;
+            }
+            std::string stem = path.stem().string();
+            related_index[parent.empty() ? stem : parent + "/" + stem].push_back(extension);
+        }
+        if (ec) {
+            indexed_directories.erase(parent);
+        }
+    }
+}
+
 std::string JobChecker::extract_base_name(const std::string& log_file) {
-    std::filesystem::path path(log_file);
+    // "opt.log.gz" belongs to "opt.gjf" / "opt.chk" like "opt.log"
+    std::filesystem::path path(CompressedInput::strip_suffix(log_file));
     std::string stem = path.stem().string();
     std::string parent = path.parent_path().string();
 
@@ -958,30 +1206,33 @@ std::string JobChecker::extract_base_name(const std::string& log_file) {
     }
 }
 
-bool JobChecker::move_job_files(const JobCheckResult& result, const std::string& target_dir) {
-    try {
-        std::filesystem::path target_path = target_dir;
-
-        // Move the log file
-        std::filesystem::path log_src = result.filename;
-        std::filesystem::path log_dest = target_path / log_src.filename();
-        std::filesystem::rename(log_src, log_dest);
-
-        // Move related files
-        for (const auto& related_file : result.related_files) {
-            std::filesystem::path src = related_file;
-            std::filesystem::path dest = target_path / src.filename();
-            if (std::filesystem::exists(src)) {
-                std::filesystem::rename(src, dest);
-            }
-        }
+size_t JobChecker::run_moves(MovePlanner& planner) {
+    if (planner.group_count() == 0) {
+        return 0;
+    }
 
-        return true;
+    unsigned int num_threads = calculateSafeThreadCount(context->requested_threads,
+                                                       planner.group_count(),
+                                                       context->job_resources);
+    size_t moved = planner.execute(num_threads);
 
-    } catch (const std::filesystem::filesystem_error& e) {
-        log_error("Failed to move files for " + result.filename + ": " + e.what());
-        return false;
+    for (const auto& error : planner.general_errors()) {
+        log_error(error);
+    }
+    for (size_t group = 0; group < planner.group_count(); ++group) {
+        if (!planner.error(group).empty()) {
+            log_error(planner.error(group));
+        }
+    }
+
+    if (planner.dry_run() && !quiet_mode) {
+        std::cout << "Dry run: " << moved << " jobs would be moved, no files were touched";
+        if (!move_options.manifest_path.empty()) {
+            std::cout << " (planned moves in " << move_options.manifest_path << ")";
+        }
+        std::cout << std::endl;
     }
+    return moved;
 }
 
 bool JobChecker::create_target_directory(const std::string& target_dir) {
@@ -1020,7 +1271,8 @@ void JobChecker::print_summary(const CheckSummary& summary, const std::string& o
     std::cout << "\n" << operation << " completed:" << std::endl;
     std::cout << "Files processed: " << summary.processed_files << "/" << summary.total_files << std::endl;
     std::cout << "Files matched: " << summary.matched_files << std::endl;
-    std::cout << "Files moved: " << summary.moved_files << std::endl;
+    std::cout << (move_options.dry_run ? "Files that would be moved: " : "Files moved: ") << summary.moved_files
+              << std::endl;
 
     if (summary.failed_moves > 0) {
         std::cout << "Failed moves: " << summary.failed_moves << std::endl;
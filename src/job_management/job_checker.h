@@ -36,8 +36,13 @@
 #define JOB_CHECKER_H
 
 #include "extraction/gaussian_extractor.h"
+#include "utilities/move_planner.h"
+#include <chrono>
 #include <memory>
 #include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 /**
@@ -166,6 +171,12 @@ private:
     std::shared_ptr<ProcessingContext> context;             ///< Shared processing context for resource management
     bool                               quiet_mode;          ///< Suppress non-essential output messages
     bool                               show_error_details;  ///< Display detailed error messages from log files
+    MoveOptions                        move_options;        ///< Dry-run and manifest settings for file moves
+
+    // Related-file lookup built by index_related_files() before each check; read-only while workers run
+    std::vector<std::string> related_extensions;  ///< Input extensions from the configuration plus .chk
+    std::unordered_map<std::string, std::vector<std::string>> related_index;  ///< Base path -> extensions present
+    std::unordered_set<std::string> indexed_directories;  ///< Directories covered by related_index
 
 public:
     /**
@@ -173,12 +184,16 @@ public:
      * @param ctx Shared processing context for resource coordination
      * @param quiet Suppress non-essential output (default: false)
      * @param show_details Display detailed error messages (default: false)
+     * @param moves Dry-run and manifest settings for the file moves (default: move, no manifest)
      *
      * Creates a JobChecker instance with the specified processing context
      * and display preferences. The processing context provides access to
      * shared resource managers and coordination with other system components.
      */
-    explicit JobChecker(std::shared_ptr<ProcessingContext> ctx, bool quiet = false, bool show_details = false);
+    explicit JobChecker(std::shared_ptr<ProcessingContext> ctx,
+                        bool                               quiet        = false,
+                        bool                               show_details = false,
+                        const MoveOptions&                 moves        = MoveOptions());
 
     /**
      * @defgroup MainChecking Main Job Checking Functions
@@ -279,6 +294,19 @@ public:
      */
     CheckSummary check_all_job_types_optimized(const std::vector<std::string>& log_files);
 
+    /**
+     * @brief Move jobs that were classified elsewhere, as check_all_job_types() does
+     * @param jobs Results of classify_content(); their related files are looked up here
+     * @param target_dir_suffix Suffix of the directory for completed jobs (default: "done")
+     * @return CheckSummary with combined statistics for all moved jobs
+     *
+     * Used by the pipeline command, which classifies each log from the read
+     * that also extracts it. Completed, error and PCM jobs are moved in one
+     * batch after all logs have been read; running jobs stay in place.
+     */
+    CheckSummary organize_classified_jobs(const std::vector<JobCheckResult>& jobs,
+                                          const std::string&                 target_dir_suffix = "done");
+
     /**
      * @brief Check and organize jobs with imaginary frequencies
      * @param log_files Vector of log file paths to check
@@ -316,9 +344,24 @@ public:
      * 3. Identify specific error types if present
      * 4. Extract error messages for reporting
      * 5. Find related files for potential organization
+     *
+     * When the processing context carries a ResultIndex, logs that have not
+     * changed since they were last classified are not read again.
      */
     JobCheckResult check_job_status(const std::string& log_file);
 
+    /**
+     * @brief Determine the status of a job whose log content is already in memory
+     * @param log_file Path to the log file (recorded in the result)
+     * @param content Whole log content
+     * @return JobCheckResult with status and error message; related_files is left empty
+     *
+     * Applies the rules of check_job_status() without reading the file. The
+     * result index is not consulted, since the log has been read anyway.
+     * Safe to call from several threads at once.
+     */
+    JobCheckResult classify_content(const std::string& log_file, std::string_view content);
+
     /** @} */  // end of IndividualChecking group
 
     /**
@@ -328,22 +371,20 @@ public:
      */
 
     /**
-     * @brief Move job files to target directory with related files
-     * @param result JobCheckResult containing file information
-     * @param target_dir Target directory for file organization
-     * @return true if all files moved successfully, false otherwise
+     * @brief Move the files of all planned jobs in one batch
+     * @param planner Plan holding one group (log plus related files) per job
+     * @return Number of jobs whose files were all moved
      *
-     * Moves the main log file and all related files (.gau, .chk, etc.) to
-     * the specified target directory. Ensures all files for a calculation
-     * are kept together to maintain data integrity.
+     * Moves the main log file and all related files (.gau, .chk, etc.) of
+     * every job together, so the files of a calculation stay in one place.
      *
      * @section Move Strategy
-     * - Creates target directory if it doesn't exist
-     * - Moves files atomically when possible
-     * - Handles filename conflicts gracefully
-     * - Provides detailed error reporting for failures
+     * - Each target directory is created and listed once for the whole batch
+     * - Name conflicts are resolved in memory; existing files are never replaced
+     * - Renames run in parallel; moves across file systems copy and unlink
+     * - Failures are reported through the error collector; a dry run only reports
      */
-    bool move_job_files(const JobCheckResult& result, const std::string& target_dir);
+    size_t run_moves(MovePlanner& planner);
 
     /**
      * @brief Find all files related to a Gaussian calculation
@@ -362,6 +403,18 @@ public:
      */
     std::vector<std::string> find_related_files(const std::string& log_file);
 
+    /**
+     * @brief List the directories of a batch of log files once for find_related_files()
+     * @param log_files Log files about to be checked
+     *
+     * Reads every distinct parent directory with a single directory listing
+     * and records which input/checkpoint siblings exist for each base name,
+     * so find_related_files() answers from memory instead of probing the
+     * file system once per extension and job. Logs in directories that were
+     * not listed fall back to probing.
+     */
+    void index_related_files(const std::vector<std::string>& log_files);
+
     /**
      * @brief Create target directory for file organization
      * @param target_dir Path to directory to create
@@ -419,6 +472,29 @@ private:
      * @{
      */
 
+    /**
+     * @brief Read a log file and classify it (uncached part of check_job_status)
+     * @param log_file Path to the log file to analyze
+     * @return JobCheckResult with status, error message and related files
+     */
+    JobCheckResult classify_job(const std::string& log_file);
+
+    /**
+     * @brief Move classified jobs in one batch and report them (second half of check_all_job_types)
+     * @param completed_jobs Jobs moved to done_dir
+     * @param error_jobs Jobs moved to errorJobs
+     * @param pcm_failed_jobs Jobs moved to PCMMkU
+     * @param done_dir Directory for completed jobs
+     * @param start_time Start of the check, for the reported execution time
+     * @param total_summary Receives move counts and execution time
+     */
+    void move_all_job_types(const std::vector<JobCheckResult>&             completed_jobs,
+                            const std::vector<JobCheckResult>&             error_jobs,
+                            const std::vector<JobCheckResult>&             pcm_failed_jobs,
+                            const std::string&                             done_dir,
+                            std::chrono::high_resolution_clock::time_point start_time,
+                            CheckSummary&                                  total_summary);
+
     /**
      * @brief Check if log file shows normal termination
      * @param content Complete content of the log file
@@ -515,6 +591,29 @@ private:
      */
     std::string read_file_content(const std::string& filename);
 
+    /**
+     * @brief Search a file for a text without loading it into memory
+     * @param filename Path to file to search
+     * @param pattern Text to look for
+     * @return true at the first occurrence, false if the file does not contain it
+     * @throws std::runtime_error if the file cannot be opened
+     *
+     * Reads the file front to back in fixed-size chunks, keeping the last
+     * pattern.size() - 1 bytes of each chunk so matches that span a chunk
+     * boundary are found. Memory use is independent of the file size.
+     */
+    bool file_contains(const std::string& filename, const std::string& pattern);
+
+    /**
+     * @brief Reserve memory for a read from the context's MemoryMonitor
+     * @param bytes Bytes the caller is about to hold
+     * @return Reservation held until it goes out of scope; empty without a monitor
+     *
+     * Blocks while the memory limit is exhausted, so checks slow down under
+     * memory pressure instead of failing.
+     */
+    MemoryMonitor::Reservation reserve_memory(size_t bytes);
+
     /**
      * @brief Unified file reading function with flexible options
      * @param filename Path to file to read
@@ -538,6 +637,11 @@ private:
     std::string
     read_file_unified(const std::string& filename, FileReadMode mode = FileReadMode::TAIL, size_t tail_lines = 10);
 
+    /**
+     * @brief Reading behind read_file_unified(), which adds the profiler accounting
+     */
+    std::string read_log_text(const std::string& filename, FileReadMode mode, size_t tail_lines);
+
     /** @} */  // end of FileReading group
 
     /**
@@ -3,25 +3,45 @@
 #include <sstream>
 #include <regex>
 #include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <iterator>
+
+#ifdef __linux__
+#include <sched.h>
+#include <unistd.h>
+#endif
 
 // Main detection function
 JobResources JobSchedulerDetector::detect_job_resources() {
     SchedulerType scheduler = get_scheduler_type();
+    JobResources resources;
     
     switch (scheduler) {
         case SchedulerType::SLURM:
-            return detect_slurm_resources();
+            resources = detect_slurm_resources();
+            break;
         case SchedulerType::PBS:
-            return detect_pbs_resources();
+            resources = detect_pbs_resources();
+            break;
         case SchedulerType::SGE:
-            return detect_sge_resources();
+            resources = detect_sge_resources();
+            break;
         case SchedulerType::LSF:
-            return detect_lsf_resources();
+            resources = detect_lsf_resources();
+            break;
         default:
-            JobResources resources;
             resources.scheduler_type = scheduler;
-            return resources;
+            break;
+    }
+    
+    // A job whose environment names no CPU count is still confined to its cpuset
+    resources.cpu_set = detect_cpu_set(scheduler);
+    if (scheduler != SchedulerType::NONE && !resources.has_cpu_limit && !resources.cpu_set.empty()) {
+        resources.allocated_cpus = static_cast<unsigned int>(resources.cpu_set.size());
+        resources.has_cpu_limit = true;
     }
+    return resources;
 }
 
 SchedulerType JobSchedulerDetector::get_scheduler_type() {
@@ -82,6 +102,59 @@ std::string JobSchedulerDetector::get_job_id(SchedulerType scheduler) {
     }
 }
 
+bool JobSchedulerDetector::get_array_task(SchedulerType scheduler, unsigned int& index, unsigned int& count) {
+    long id = -1;
+    long first = -1;
+    long step = 1;
+    long last = -1;
+    long tasks = 0;
+
+    switch (scheduler) {
+        case SchedulerType::SLURM:
+            id = get_env_long("SLURM_ARRAY_TASK_ID", -1);
+            first = get_env_long("SLURM_ARRAY_TASK_MIN", -1);
+            last = get_env_long("SLURM_ARRAY_TASK_MAX", -1);
+            step = get_env_long("SLURM_ARRAY_TASK_STEP", 1);
+            tasks = get_env_long("SLURM_ARRAY_TASK_COUNT", 0);
+            break;
+        case SchedulerType::PBS:
+            id = get_env_long("PBS_ARRAY_INDEX", -1);
+            if (id < 0) id = get_env_long("PBS_ARRAYID", -1);
+            break;
+        case SchedulerType::SGE:
+            // SGE_TASK_ID is "undefined" outside array jobs, which does not parse
+            id = get_env_long("SGE_TASK_ID", -1);
+            first = get_env_long("SGE_TASK_FIRST", -1);
+            last = get_env_long("SGE_TASK_LAST", -1);
+            step = get_env_long("SGE_TASK_STEPSIZE", 1);
+            break;
+        case SchedulerType::LSF:
+            // LSB_JOBINDEX is 0 for jobs that are not part of an array
+            id = get_env_long("LSB_JOBINDEX", 0);
+            if (id == 0) id = -1;
+            break;
+        default:
+            break;
+    }
+
+    if (id < 0) {
+        return false;
+    }
+    if (step <= 0) step = 1;
+
+    if (first >= 0 && id >= first) {
+        index = static_cast<unsigned int>((id - first) / step);
+        if (tasks <= 0 && last >= first) {
+            tasks = (last - first) / step + 1;
+        }
+        count = tasks > 0 ? static_cast<unsigned int>(tasks) : 0;
+    } else {
+        index = static_cast<unsigned int>(id);
+        count = 0;
+    }
+    return true;
+}
+
 JobResources JobSchedulerDetector::detect_slurm_resources() {
     JobResources resources;
     resources.scheduler_type = SchedulerType::SLURM;
@@ -144,6 +217,8 @@ JobResources JobSchedulerDetector::detect_pbs_resources() {
     if (ncpus == 0) ncpus = get_env_long("PBS_NCPUS", 0);
     if (ncpus == 0) ncpus = get_env_long("NCPUS", 0);
     
+    if (ncpus == 0) ncpus = count_pbs_node_slots();
+    
     if (ncpus > 0) {
         resources.allocated_cpus = static_cast<unsigned int>(ncpus);
         resources.has_cpu_limit = true;
@@ -449,4 +524,165 @@ unsigned int JobSchedulerDetector::parse_cpu_range(const std::string& range_str)
     } catch (...) {
         return 0;
     }
-}
\ No newline at end of file
+}
+
+unsigned int JobSchedulerDetector::count_pbs_node_slots() {
+    std::string node_file = get_env_var("PBS_NODEFILE");
+    if (node_file.empty()) return 0;
+    
+    std::ifstream file(node_file);
+    if (!file.is_open()) return 0;
+    
+#ifdef __linux__
+    char host_buffer[256] = {};
+    if (gethostname(host_buffer, sizeof(host_buffer) - 1) != 0) return 0;
+    std::string host = host_buffer;
+#else
+    std::string host = get_env_var("COMPUTERNAME");
+#endif
+    // Node files list either short or fully qualified names
+    std::string short_host = host.substr(0, host.find('.'));
+    
+    unsigned int slots = 0;
+    std::string line;
+    while (std::getline(file, line)) {
+        line.erase(line.find_last_not_of(" \t\r") + 1);
+        if (line == host || line.substr(0, line.find('.')) == short_host) {
+            ++slots;
+        }
+    }
+    return slots;
+}
+
+std::vector<unsigned int> JobSchedulerDetector::parse_cpu_set(const std::string& list) {
+    std::vector<unsigned int> cpus;
+    std::istringstream iss(list);
+    std::string token;
+    
+    while (std::getline(iss, token, ',')) {
+        token.erase(0, token.find_first_not_of(" \t\r\n"));
+        token.erase(token.find_last_not_of(" \t\r\n") + 1);
+        if (token.empty()) continue;
+        try {
+            size_t dash_pos = token.find('-');
+            unsigned long first = std::stoul(token.substr(0, dash_pos));
+            unsigned long last = dash_pos == std::string::npos ? first : std::stoul(token.substr(dash_pos + 1));
+            if (last < first || last >= 65536) return {};
+            for (unsigned long cpu = first; cpu <= last; ++cpu) {
+                cpus.push_back(static_cast<unsigned int>(cpu));
+            }
+        } catch (...) {
+            return {};
+        }
+    }
+    
+    std::sort(cpus.begin(), cpus.end());
+    cpus.erase(std::unique(cpus.begin(), cpus.end()), cpus.end());
+    return cpus;
+}
+
+std::vector<unsigned int> JobSchedulerDetector::parse_cpu_mask(const std::string& mask) {
+    std::string digits;
+    size_t start = (mask.size() > 1 && mask[0] == '0' && (mask[1] == 'x' || mask[1] == 'X')) ? 2 : 0;
+    for (size_t i = start; i < mask.size(); ++i) {
+        if (mask[i] == ',') continue;
+        if (!std::isxdigit(static_cast<unsigned char>(mask[i]))) return {};
+        digits += mask[i];
+    }
+    
+    // The last digit holds CPUs 0-3
+    std::vector<unsigned int> cpus;
+    for (size_t i = 0; i < digits.size(); ++i) {
+        char digit = digits[digits.size() - 1 - i];
+        unsigned int value = static_cast<unsigned int>(std::stoul(std::string(1, digit), nullptr, 16));
+        for (unsigned int bit = 0; bit < 4; ++bit) {
+            if (value & (1u << bit)) {
+                cpus.push_back(static_cast<unsigned int>(i * 4 + bit));
+            }
+        }
+    }
+    return cpus;
+}
+
+/// Keeps the CPUs of @p cpus that are also in @p limit, unless none would remain
+static void narrow_cpu_set(std::vector<unsigned int>& cpus, const std::vector<unsigned int>& limit) {
+    if (limit.empty()) return;
+    if (cpus.empty()) {
+        cpus = limit;
+        return;
+    }
+    std::vector<unsigned int> common;
+    std::set_intersection(cpus.begin(), cpus.end(), limit.begin(), limit.end(), std::back_inserter(common));
+    if (!common.empty()) {
+        cpus.swap(common);
+    }
+}
+
+/// First line of a small file, "" if it cannot be read
+static std::string read_first_line(const std::string& path) {
+    std::ifstream file(path);
+    std::string line;
+    if (file.is_open()) {
+        std::getline(file, line);
+    }
+    return line;
+}
+
+std::vector<unsigned int> JobSchedulerDetector::detect_cpu_set(SchedulerType scheduler) {
+    std::vector<unsigned int> cpus;
+#ifdef __linux__
+    cpu_set_t mask;
+    CPU_ZERO(&mask);
+    if (sched_getaffinity(0, sizeof(mask), &mask) == 0) {
+        for (unsigned int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+            if (CPU_ISSET(cpu, &mask)) {
+                cpus.push_back(cpu);
+            }
+        }
+    }
+    
+    // cgroup v2: the single "0::<path>" line names the process's cgroup
+    std::ifstream cgroup_file("/proc/self/cgroup");
+    std::string line;
+    while (std::getline(cgroup_file, line)) {
+        if (line.compare(0, 3, "0::") == 0) {
+            std::string effective = read_first_line("/sys/fs/cgroup" + line.substr(3) + "/cpuset.cpus.effective");
+            narrow_cpu_set(cpus, parse_cpu_set(effective));
+            break;
+        }
+    }
+    
+    if (scheduler == SchedulerType::SLURM) {
+        // SLURM_CPU_BIND_LIST holds one mask or CPU id per local task
+        std::string bind_type = get_env_var("SLURM_CPU_BIND_TYPE");
+        std::string bind_list = get_env_var("SLURM_CPU_BIND_LIST");
+        long local_id = get_env_long("SLURM_LOCALID", 0);
+        bool masks = bind_type.find("mask_cpu") != std::string::npos;
+        bool ids = bind_type.find("map_cpu") != std::string::npos;
+        if ((masks || ids) && !bind_list.empty()) {
+            std::vector<std::string> entries;
+            std::istringstream iss(bind_list);
+            std::string entry;
+            while (std::getline(iss, entry, ',')) {
+                entries.push_back(entry);
+            }
+            if (!entries.empty()) {
+                const std::string& own = entries[static_cast<size_t>(local_id) % entries.size()];
+                narrow_cpu_set(cpus, masks ? parse_cpu_mask(own) : parse_cpu_set(own));
+            }
+        }
+    } else if (scheduler == SchedulerType::PBS) {
+        std::string job_id = get_env_var("PBS_JOBID");
+        if (!job_id.empty()) {
+            std::string cpuset = read_first_line("/dev/cpuset/torque/" + job_id + "/cpus");
+            if (cpuset.empty()) {
+                cpuset = read_first_line("/sys/fs/cgroup/cpuset/torque/" + job_id + "/cpuset.cpus");
+            }
+            narrow_cpu_set(cpus, parse_cpu_set(cpuset));
+        }
+    }
+#else
+    (void)scheduler;
+#endif
+    return cpus;
+}
@@ -39,6 +39,7 @@
 #include <algorithm>
 #include <cstdlib>
 #include <string>
+#include <vector>
 
 /**
  * @enum SchedulerType
@@ -68,7 +69,7 @@ enum class SchedulerType
  *
  * @section Resource Information
  * The structure captures:
- * - CPU allocation (cores, tasks, nodes)
+ * - CPU allocation (cores, tasks, nodes) and the CPUs the process may run on
  * - Memory allocation (total and per-node limits)
  * - Job identification and queue information
  * - Resource limit flags for validation
@@ -81,16 +82,17 @@ enum class SchedulerType
  */
 struct JobResources
 {
-    SchedulerType scheduler_type = SchedulerType::NONE;  ///< Type of detected job scheduler
-    std::string   job_id;                                ///< Unique job identifier from scheduler
-    unsigned int  allocated_cpus      = 0;               ///< Number of CPU cores allocated to job
-    size_t        allocated_memory_mb = 0;               ///< Memory allocated to job in megabytes
-    unsigned int  nodes               = 1;               ///< Number of compute nodes allocated
-    unsigned int  tasks_per_node      = 0;               ///< Number of tasks per compute node
-    bool          has_cpu_limit       = false;           ///< Whether CPU limit is explicitly specified
-    bool          has_memory_limit    = false;           ///< Whether memory limit is explicitly specified
-    std::string   partition;                             ///< Partition/queue name where job is running
-    std::string   account;                               ///< Account/project name for resource billing
+    SchedulerType             scheduler_type      = SchedulerType::NONE;  ///< Type of detected job scheduler
+    std::string               job_id;                                     ///< Unique job identifier from scheduler
+    unsigned int              allocated_cpus      = 0;                    ///< Number of CPU cores allocated to job
+    size_t                    allocated_memory_mb = 0;                    ///< Memory allocated to job in megabytes
+    unsigned int              nodes               = 1;                    ///< Number of compute nodes allocated
+    unsigned int              tasks_per_node      = 0;                    ///< Number of tasks per compute node
+    bool                      has_cpu_limit       = false;                ///< Whether CPU limit is explicitly specified
+    bool                      has_memory_limit    = false;                ///< Whether memory limit is explicitly specified
+    std::string               partition;                                  ///< Partition/queue name where job is running
+    std::string               account;                                    ///< Account/project name for resource billing
+    std::vector<unsigned int> cpu_set;                                    ///< CPU ids the process may run on (empty = unknown)
 };
 
 /**
@@ -160,6 +162,51 @@ public:
      */
     static std::string get_job_id(SchedulerType scheduler);
 
+    /**
+     * @brief Position of this process within an array job
+     * @param scheduler Type of scheduler to read the array variables of
+     * @param index Receives the task's zero-based position in the array, or the
+     *              raw array index when the scheduler does not export the first index
+     * @param count Receives the number of array tasks, 0 if the scheduler does not export it
+     * @return true if the process is a task of an array job
+     *
+     * SLURM (SLURM_ARRAY_TASK_*) and SGE (SGE_TASK_*) export the range, so index
+     * runs from 0 to count - 1. PBS (PBS_ARRAY_INDEX / PBS_ARRAYID) and LSF
+     * (LSB_JOBINDEX) only export the index itself; callers that know the number
+     * of tasks reduce it modulo that number.
+     */
+    static bool get_array_task(SchedulerType scheduler, unsigned int& index, unsigned int& count);
+
+    /**
+     * @brief CPUs this process is allowed to run on
+     * @param scheduler Type of scheduler, for its own binding information
+     * @return CPU ids in ascending order; empty if they cannot be determined (non-Linux)
+     *
+     * Starts from the affinity mask (sched_getaffinity), which already reflects
+     * cgroup cpusets and srun binding, and narrows it by every further source
+     * that is present:
+     * - cgroup v2 cpuset.cpus.effective of the process's cgroup
+     * - SLURM_CPU_BIND_TYPE/SLURM_CPU_BIND_LIST (mask_cpu or map_cpu), entry SLURM_LOCALID
+     * - the Torque job cpuset (/dev/cpuset/torque/$PBS_JOBID or its cgroup v1 mount)
+     *
+     * A source that would leave no CPU is ignored.
+     */
+    static std::vector<unsigned int> detect_cpu_set(SchedulerType scheduler);
+
+    /**
+     * @brief Parse a Linux CPU list into CPU ids
+     * @param list List such as "0-3,8,10-11" (cpuset.cpus, /sys cpulist files)
+     * @return CPU ids in ascending order, without duplicates; empty if the list is malformed
+     */
+    static std::vector<unsigned int> parse_cpu_set(const std::string& list);
+
+    /**
+     * @brief Parse a hexadecimal CPU mask into CPU ids
+     * @param mask Mask such as "0xF0" or "ff,000000ff" (comma-separated 32-bit words, most significant first)
+     * @return CPU ids in ascending order; empty if the mask is malformed
+     */
+    static std::vector<unsigned int> parse_cpu_mask(const std::string& mask);
+
     /** @} */  // end of DetectionMethods group
 
     /**
@@ -367,6 +414,15 @@ private:
      */
     static unsigned int parse_cpu_range(const std::string& range_str);
 
+    /**
+     * @brief Number of slots a PBS node file lists for this host
+     * @return Lines of $PBS_NODEFILE naming the local host, 0 if the file or the host is not found
+     *
+     * Torque writes one line per allocated core, so this is the core count of
+     * jobs submitted with nodes=N:ppn=M when PBS_NUM_PPN is not exported.
+     */
+    static unsigned int count_pbs_node_slots();
+
     /** @} */  // end of PrivateParsers group
 };
 
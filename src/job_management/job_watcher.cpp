@@ -0,0 +1,497 @@
+/**
+ * @file job_watcher.cpp
+ * @brief Implementation of the watch mode that classifies jobs as their logs terminate
+ * @author Le Nhan Pham
+ * @date 2025
+ */
+
+#include "job_watcher.h"
+#include "utilities/file_discovery.h"
+#include "utilities/task_executor.h"
+#include "utilities/utils.h"
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cerrno>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <unordered_set>
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+extern std::atomic<bool> g_shutdown_requested;
+
+namespace {
+
+// Strings that only appear once a Gaussian job has terminated; the checker decides which one applies
+const std::vector<std::string> TERMINATION_MARKERS = {"Normal", "Error", "failed in PCMMkU"};
+
+// Appended bytes are read in chunks of this size
+const size_t READ_CHUNK_BYTES = 1024 * 1024;
+
+// Bytes of the previous read kept so markers split across two writes are still found
+size_t carry_length() {
+    size_t longest = 0;
+    for (const auto& marker : TERMINATION_MARKERS) {
+        longest = std::max(longest, marker.size());
+    }
+    return longest - 1;
+}
+
+// Seconds from the command line as a steady_clock duration
+std::chrono::steady_clock::duration seconds(double value) {
+    return std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(value));
+}
+
+}  // namespace
+
+// =============================================================================
+// JobWatcher Implementation
+// =============================================================================
+
+JobWatcher::JobWatcher(std::shared_ptr<ProcessingContext> ctx,
+                       const WatchOptions& options,
+                       bool quiet,
+                       bool show_details,
+                       const MoveOptions& moves)
+    : context_(ctx), options_(options), quiet_(quiet), show_details_(show_details), move_options_(moves),
+      checker_(ctx, true, false, moves), inotify_fd_(-1), polling_(true) {
+    // The default extension follows both .log and .out files, like check
+    std::string extension = context_->extension;
+    std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+    if (extension == ".log") {
+        extensions_ = {".log", ".out"};
+    } else {
+        extensions_ = {extension};
+    }
+
+    done_dir_ = checker_.get_current_directory_name() + "-" + options_.dir_suffix;
+
+    if (!options_.force_polling && !on_network_file_system()) {
+        polling_ = !start_inotify();
+    }
+}
+
+JobWatcher::~JobWatcher() {
+#ifdef __linux__
+    if (inotify_fd_ >= 0) {
+        close(inotify_fd_);
+    }
+#endif
+}
+
+bool JobWatcher::start_inotify() {
+#ifdef __linux__
+    inotify_fd_ = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (inotify_fd_ < 0) {
+        return false;
+    }
+    uint32_t mask = IN_MODIFY | IN_CLOSE_WRITE | IN_CREATE | IN_MOVED_TO | IN_MOVED_FROM | IN_DELETE;
+    if (inotify_add_watch(inotify_fd_, ".", mask) < 0) {
+        close(inotify_fd_);
+        inotify_fd_ = -1;
+        return false;
+    }
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool JobWatcher::on_network_file_system() const {
+#ifdef __linux__
+    // Writes made on other nodes of these file systems raise no inotify events here
+    return Utils::on_network_file_system(".");
+#else
+    return true;
+#endif
+}
+
+bool JobWatcher::matches_extension(const std::string& name) const {
+    for (const auto& extension : extensions_) {
+        if (name.size() > extension.size() &&
+            std::equal(extension.begin(), extension.end(), name.end() - extension.size(), [](char a, char b) {
+                return std::tolower(static_cast<unsigned char>(a)) == std::tolower(static_cast<unsigned char>(b));
+            })) {
+            return true;
+        }
+    }
+    return false;
+}
+
+CheckSummary JobWatcher::run() {
+    auto start_time = std::chrono::high_resolution_clock::now();
+
+    if (!quiet_) {
+        std::cout << "Watching " << std::filesystem::current_path().string() << " for finished jobs ("
+                  << (polling_ ? "polling every " + std::to_string(static_cast<int>(options_.interval_seconds)) + " s"
+                               : std::string("inotify"))
+                  << ", settle " << options_.settle_seconds << " s)" << std::endl;
+        if (move_options_.dry_run) {
+            std::cout << "Dry run: jobs are reported but not moved" << std::endl;
+        }
+        std::cout << "Press Ctrl+C to stop." << std::endl;
+    }
+
+    initial_pass();
+
+    auto interval = seconds(options_.interval_seconds);
+    auto settle   = seconds(options_.settle_seconds);
+
+    while (!g_shutdown_requested.load()) {
+        // Wake up no later than the next pending log settles
+        Clock::time_point now     = Clock::now();
+        Clock::duration   timeout = interval;
+        for (const auto& entry : files_) {
+            if (entry.second.pending) {
+                timeout = std::min(timeout, std::max(Clock::duration::zero(), entry.second.changed_at + settle - now));
+            }
+        }
+
+        wait_for_changes(timeout);
+        if (g_shutdown_requested.load()) {
+            break;
+        }
+
+        std::sort(dirty_.begin(), dirty_.end());
+        dirty_.erase(std::unique(dirty_.begin(), dirty_.end()), dirty_.end());
+        for (const auto& path : dirty_) {
+            update(path);
+        }
+        dirty_.clear();
+
+        classify_settled();
+    }
+
+    auto end_time           = std::chrono::high_resolution_clock::now();
+    summary_.execution_time = std::chrono::duration<double>(end_time - start_time).count();
+
+    if (!quiet_) {
+        std::cout << "\n=== Watch Summary ===" << std::endl;
+        std::cout << "Jobs classified: " << summary_.processed_files << std::endl;
+        std::cout << (move_options_.dry_run ? "Jobs that would be moved: " : "Jobs moved: ") << summary_.moved_files
+                  << std::endl;
+        if (summary_.failed_moves > 0) {
+            std::cout << "Failed moves: " << summary_.failed_moves << std::endl;
+        }
+        std::cout << "Logs still running: " << files_.size() << std::endl;
+        std::cout << "Watched for: " << std::fixed << std::setprecision(1) << summary_.execution_time << " seconds"
+                  << std::endl;
+    }
+
+    return summary_;
+}
+
+void JobWatcher::initial_pass() {
+    FileDiscovery::Options options;
+    options.extensions       = extensions_;
+    options.max_file_size_mb = context_->max_file_size_mb;
+
+    std::vector<std::string> paths;
+    FileDiscovery::walk(options, [&](const std::string& path, uintmax_t size) {
+        // Everything up to the current size is covered by the classification below
+        WatchedFile& file = files_[path];
+        file.offset       = size;
+        file.size         = size;
+        file.changed_at   = Clock::now();
+        paths.push_back(path);
+    });
+    last_listing_ = Clock::now();
+
+    if (!quiet_) {
+        std::cout << "Found " << paths.size() << " " << context_->extension << " files" << std::endl;
+    }
+    if (!paths.empty()) {
+        classify(paths, true);
+    }
+}
+
+void JobWatcher::rescan() {
+    FileDiscovery::Options options;
+    options.extensions       = extensions_;
+    options.max_file_size_mb = context_->max_file_size_mb;
+
+    std::unordered_set<std::string> seen;
+    FileDiscovery::walk(options, [&](const std::string& path, uintmax_t size) {
+        seen.insert(path);
+        auto it = files_.find(path);
+        if (it == files_.end() || it->second.size != size) {
+            dirty_.push_back(path);
+        }
+    });
+    last_listing_ = Clock::now();
+
+    // Logs that disappeared (moved or deleted by someone else) are no longer followed
+    for (auto it = files_.begin(); it != files_.end();) {
+        it = seen.count(it->first) ? std::next(it) : files_.erase(it);
+    }
+}
+
+void JobWatcher::wait_for_changes(Clock::duration timeout) {
+    Clock::time_point deadline = Clock::now() + timeout;
+
+#ifdef __linux__
+    if (!polling_) {
+        while (!g_shutdown_requested.load()) {
+            auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - Clock::now());
+            // Short slices so a shutdown request is seen even if the signal does not interrupt poll()
+            int wait_ms = static_cast<int>(std::max<long long>(0, std::min<long long>(remaining.count(), 500)));
+
+            struct pollfd descriptor = {inotify_fd_, POLLIN, 0};
+            int ready = poll(&descriptor, 1, wait_ms);
+            if (ready > 0) {
+                alignas(struct inotify_event) char buffer[64 * 1024];
+                ssize_t length;
+                while ((length = read(inotify_fd_, buffer, sizeof(buffer))) > 0) {
+                    for (char* ptr = buffer; ptr < buffer + length;) {
+                        auto* event = reinterpret_cast<struct inotify_event*>(ptr);
+                        if (event->mask & IN_Q_OVERFLOW) {
+                            rescan();  // Events were lost
+                        } else if (event->len > 0 && !(event->mask & IN_ISDIR)) {
+                            std::string name(event->name);
+                            if (matches_extension(name)) {
+                                dirty_.push_back(name);
+                            }
+                        }
+                        ptr += sizeof(struct inotify_event) + event->len;
+                    }
+                }
+                return;
+            }
+            if (ready < 0 && errno != EINTR) {
+                // Keep watching by listing the directory instead
+                polling_ = true;
+                break;
+            }
+            if (Clock::now() >= deadline) {
+                return;
+            }
+        }
+        if (!polling_) {
+            return;
+        }
+    }
+#endif
+
+    while (!g_shutdown_requested.load() && Clock::now() < deadline) {
+        auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - Clock::now());
+        std::this_thread::sleep_for(std::min(remaining, std::chrono::milliseconds(200)));
+    }
+
+    auto interval = seconds(options_.interval_seconds);
+    if (!g_shutdown_requested.load() && Clock::now() - last_listing_ >= interval) {
+        rescan();
+    }
+}
+
+void JobWatcher::update(const std::string& path) {
+    std::error_code ec;
+    uintmax_t size = std::filesystem::file_size(path, ec);
+    if (ec) {
+        files_.erase(path);  // Moved or deleted
+        return;
+    }
+    if (size > static_cast<uintmax_t>(context_->max_file_size_mb) * 1024 * 1024) {
+        return;
+    }
+
+    WatchedFile& file = files_[path];
+    if (size < file.offset) {
+        // Truncated or replaced: start over
+        file = WatchedFile();
+    }
+    file.size = size;
+    if (size == file.offset) {
+        return;
+    }
+
+    file.changed_at = Clock::now();
+    if (read_appended(path, file)) {
+        file.pending = true;
+    }
+}
+
+bool JobWatcher::read_appended(const std::string& path, WatchedFile& file) {
+    auto file_guard = context_->file_manager->acquire();
+    if (!file_guard.is_acquired()) {
+        return false;  // Retried when the log next changes or settles
+    }
+
+    std::ifstream in(path, std::ios::binary);
+    if (!in.is_open()) {
+        return false;
+    }
+    in.seekg(static_cast<std::streamoff>(file.offset));
+
+    size_t remaining = static_cast<size_t>(file.size - file.offset);
+    auto   memory    = context_->memory_monitor->reserve(std::min(remaining, READ_CHUNK_BYTES) + file.carry.size());
+
+    bool        found = false;
+    std::string buffer;
+    while (remaining > 0 && in) {
+        size_t chunk = std::min(remaining, READ_CHUNK_BYTES);
+        buffer.assign(file.carry);
+        buffer.resize(file.carry.size() + chunk);
+        in.read(&buffer[file.carry.size()], static_cast<std::streamsize>(chunk));
+        size_t got = static_cast<size_t>(in.gcount());
+        buffer.resize(file.carry.size() + got);
+        if (got == 0) {
+            break;
+        }
+
+        for (const auto& marker : TERMINATION_MARKERS) {
+            if (buffer.find(marker) != std::string::npos) {
+                found = true;
+                break;
+            }
+        }
+
+        size_t keep = std::min(buffer.size(), carry_length());
+        file.carry.assign(buffer, buffer.size() - keep, keep);
+        file.offset += got;
+        remaining -= got;
+    }
+    return found;
+}
+
+void JobWatcher::classify_settled() {
+    auto settle = seconds(options_.settle_seconds);
+    Clock::time_point now = Clock::now();
+
+    std::vector<std::string> settled;
+    for (const auto& entry : files_) {
+        if (entry.second.pending && now - entry.second.changed_at >= settle) {
+            settled.push_back(entry.first);
+        }
+    }
+    if (!settled.empty()) {
+        std::sort(settled.begin(), settled.end());
+        classify(settled, false);
+    }
+}
+
+void JobWatcher::classify(const std::vector<std::string>& paths, bool initial) {
+    std::vector<JobCheckResult> results(paths.size());
+    std::mutex errors_mutex;
+
+    unsigned int num_threads =
+        calculateSafeThreadCount(context_->requested_threads, static_cast<unsigned int>(paths.size()),
+                                 context_->job_resources);
+
+    // Related files are listed again for every batch; checkpoints appear while a job runs
+    checker_.index_related_files(paths);
+    TaskExecutor::shared(num_threads).run(paths.size(), [&](size_t index) {
+        try {
+            auto file_guard = context_->file_manager->acquire();
+            if (!file_guard.is_acquired()) {
+                return;
+            }
+            results[index] = checker_.check_job_status(paths[index]);
+        } catch (const std::exception& e) {
+            std::lock_guard<std::mutex> lock(errors_mutex);
+            summary_.errors.push_back("Error checking " + paths[index] + ": " + e.what());
+        }
+    });
+
+    auto settle = std::chrono::duration_cast<std::filesystem::file_time_type::duration>(
+        std::chrono::duration<double>(options_.settle_seconds));
+
+    // One plan per cycle; the groups follow the order of planned
+    MovePlanner         planner(move_options_);
+    std::vector<size_t> planned;
+    for (size_t i = 0; i < paths.size(); ++i) {
+        auto it = files_.find(paths[i]);
+        if (it == files_.end()) {
+            continue;
+        }
+        JobCheckResult& result = results[i];
+        it->second.pending     = false;
+
+        std::string target;
+        if (result.status == JobStatus::COMPLETED) {
+            target = done_dir_;
+        } else if (result.status == JobStatus::ERROR) {
+            target = "errorJobs";
+        } else if (result.status == JobStatus::PCM_FAILED) {
+            target = "PCMMkU";
+        } else {
+            continue;  // Still running (or unreadable): keep following it
+        }
+        summary_.processed_files++;
+
+        // A log found terminated at startup may still be receiving its last lines
+        if (initial) {
+            std::error_code ec;
+            auto modified = std::filesystem::last_write_time(paths[i], ec);
+            if (!ec && std::filesystem::file_time_type::clock::now() - modified < settle) {
+                summary_.processed_files--;
+                it->second.pending    = true;
+                it->second.changed_at = Clock::now();
+                continue;
+            }
+        }
+
+        planner.add(target, result.filename, result.related_files);
+        planned.push_back(i);
+    }
+    summary_.total_files += planned.size();
+    summary_.matched_files += planned.size();
+
+    if (planned.empty()) {
+        return;
+    }
+    checker_.run_moves(planner);
+
+    for (size_t group = 0; group < planned.size(); ++group) {
+        const std::string&    path   = paths[planned[group]];
+        const JobCheckResult& result = results[planned[group]];
+
+        if (!planner.moved(group)) {
+            summary_.failed_moves++;
+            continue;
+        }
+        summary_.moved_files++;
+
+        if (move_options_.dry_run) {
+            // The log stays in place; it is reported again only if it grows
+            auto it = files_.find(path);
+            if (it != files_.end()) {
+                it->second.offset = it->second.size;
+            }
+        } else {
+            files_.erase(path);
+        }
+
+        if (result.status == JobStatus::COMPLETED) {
+            if (!quiet_) {
+                std::cout << timestamp() << result.filename << " done" << std::endl;
+            }
+        } else if (!quiet_ || (show_details_ && result.status == JobStatus::ERROR)) {
+            const char* separator = result.status == JobStatus::ERROR ? ": " : " ";
+            std::cout << timestamp() << result.filename << separator << result.error_message << std::endl;
+        }
+    }
+}
+
+std::string JobWatcher::timestamp() const {
+    std::time_t now = std::time(nullptr);
+    std::tm     local_time{};
+#ifdef _WIN32
+    localtime_s(&local_time, &now);
+#else
+    localtime_r(&now, &local_time);
+#endif
+    std::ostringstream out;
+    out << "[" << std::put_time(&local_time, "%Y-%m-%d %H:%M:%S") << "] ";
+    return out.str();
+}
@@ -0,0 +1,150 @@
+/**
+ * @file job_watcher.h
+ * @brief Watch mode that classifies Gaussian jobs as soon as their logs terminate
+ * @author Le Nhan Pham
+ * @date 2025
+ *
+ * This header provides the watcher behind the watch command. Instead of
+ * re-reading every log of a directory each time check is run, the watcher
+ * stays resident, follows the logs as they grow and moves a job into the
+ * done, errorJobs or PCMMkU directory as soon as it has terminated.
+ *
+ * @section Change Detection
+ * - On Linux the working directory is watched with inotify, so only logs that
+ *   were written to are looked at
+ * - On file systems where inotify does not see writes from other nodes
+ *   (Lustre, NFS, GPFS, CIFS/SMB, FUSE), on other platforms, and with --poll,
+ *   the directory is listed every interval and file sizes are compared
+ *
+ * @section Incremental Reading
+ * Every log keeps the offset up to which it has been read. When a log grows,
+ * only the appended bytes are read and searched for the termination markers
+ * ("Normal", "Error", "failed in PCMMkU"); the last bytes of the previous
+ * read are carried over so a marker split between two writes is still found.
+ * A log that shrank (truncated or replaced) is read again from the start.
+ *
+ * @section Classification
+ * A log whose appended bytes contain a marker is classified once it has not
+ * grown for the settle time, so Gaussian has finished writing its last lines.
+ * Classification reuses JobChecker::check_job_status() (and the persistent
+ * result index when --index is given), and the moves of one cycle are carried
+ * out as one MovePlanner batch together with each job's related files.
+ */
+
+#ifndef JOB_WATCHER_H
+#define JOB_WATCHER_H
+
+#include "job_management/job_checker.h"
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @struct WatchOptions
+ * @brief Timing and detection settings of the watch command
+ */
+struct WatchOptions
+{
+    double      interval_seconds;  ///< Directory listing period in polling mode, and the longest idle wait
+    double      settle_seconds;    ///< Quiet time after a termination marker before the job is classified
+    bool        force_polling;     ///< Poll even where inotify is available
+    std::string dir_suffix;        ///< Suffix of the directory for completed jobs ("<cwd>-<suffix>")
+
+    WatchOptions() : interval_seconds(10.0), settle_seconds(30.0), force_polling(false), dir_suffix("done") {}
+};
+
+/**
+ * @class JobWatcher
+ * @brief Follows the logs of the working directory and moves jobs as they terminate
+ */
+class JobWatcher
+{
+public:
+    /**
+     * @brief Create a watcher for the working directory
+     * @param ctx Shared processing context (extension, size limit, threads, result index)
+     * @param options Timing and detection settings
+     * @param quiet Suppress the per-job and status messages
+     * @param show_details Print the error messages of failed jobs even in quiet mode
+     * @param moves Dry-run setting for the file moves
+     */
+    JobWatcher(std::shared_ptr<ProcessingContext> ctx,
+               const WatchOptions&                options,
+               bool                               quiet        = false,
+               bool                               show_details = false,
+               const MoveOptions&                 moves        = MoveOptions());
+
+    /**
+     * @brief Release the inotify descriptor
+     */
+    ~JobWatcher();
+
+    JobWatcher(const JobWatcher&)            = delete;
+    JobWatcher& operator=(const JobWatcher&) = delete;
+
+    /**
+     * @brief Classify the existing logs, then watch until a shutdown is requested
+     * @return Summary of all files classified and moved while watching
+     *
+     * Returns when SIGINT or SIGTERM sets the shutdown flag.
+     */
+    CheckSummary run();
+
+    /**
+     * @brief Whether the directory is polled instead of watched with inotify
+     */
+    bool polling() const
+    {
+        return polling_;
+    }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @struct WatchedFile
+     * @brief Read position and termination state of one log
+     */
+    struct WatchedFile
+    {
+        uintmax_t         offset;      ///< Bytes read so far
+        uintmax_t         size;        ///< Size at the last check
+        Clock::time_point changed_at;  ///< When the log last grew
+        bool              pending;     ///< A termination marker was seen; classify once settled
+        std::string       carry;       ///< Last bytes of the previous read (marker split across writes)
+
+        WatchedFile() : offset(0), size(0), pending(false) {}
+    };
+
+    bool        start_inotify();
+    bool        on_network_file_system() const;
+    bool        matches_extension(const std::string& name) const;
+    void        initial_pass();
+    void        rescan();
+    void        wait_for_changes(Clock::duration timeout);
+    void        update(const std::string& path);
+    bool        read_appended(const std::string& path, WatchedFile& file);
+    void        classify(const std::vector<std::string>& paths, bool initial);
+    void        classify_settled();
+    std::string timestamp() const;
+
+    std::shared_ptr<ProcessingContext>           context_;        ///< Resources, extension and result index
+    WatchOptions                                 options_;        ///< Timing and detection settings
+    bool                                         quiet_;          ///< Suppress non-essential output
+    bool                                         show_details_;   ///< Print error messages of failed jobs
+    MoveOptions                                  move_options_;   ///< Dry-run setting
+    JobChecker                                   checker_;        ///< Classification and moves
+    std::vector<std::string>                     extensions_;     ///< Log extensions, matched case-insensitively
+    std::unordered_map<std::string, WatchedFile> files_;          ///< Followed logs by path
+    std::vector<std::string>                     dirty_;          ///< Logs to look at in this cycle
+    std::string                                  done_dir_;       ///< Target of completed jobs
+    CheckSummary                                 summary_;        ///< Totals of the whole session
+    int                                          inotify_fd_;     ///< inotify descriptor (-1 when polling)
+    bool                                         polling_;        ///< Poll instead of inotify
+    Clock::time_point                            last_listing_;   ///< Last directory listing in polling mode
+};
+
+#endif  // JOB_WATCHER_H
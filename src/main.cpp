@@ -22,10 +22,12 @@
 #include "ui/interactive_mode.h"
 #include "utilities/command_system.h"
 #include "utilities/config_manager.h"
+#include "utilities/profiler.h"
 #include "utilities/version.h"
 #include <atomic>
 #include <csignal>
 #include <iostream>
+#include <string>
 
 
 /**
@@ -33,9 +35,10 @@
  *
  * This atomic boolean is used to coordinate graceful shutdown across all threads
  * when a termination signal (SIGINT, SIGTERM) is received. All long-running
- * operations should periodically check this flag and terminate cleanly.
+ * operations should periodically check this flag and terminate cleanly. It is
+ * defined in gaussian_extractor.cpp, which is part of libgaussian_extractor.
  */
-std::atomic<bool> g_shutdown_requested{false};
+extern std::atomic<bool> g_shutdown_requested;
 
 /**
  * @brief Signal handler for graceful shutdown
@@ -56,6 +59,33 @@ void signalHandler(int signal)
 }
 
 
+/**
+ * @brief Print the banner shown when interactive mode starts
+ */
+void print_interactive_welcome()
+{
+    std::cout << std::endl;
+    std::cout << "==================================================" << std::endl;
+    std::cout << GaussianExtractor::get_version_info() << std::endl;
+    std::cout << "==================================================" << std::endl;
+    std::cout << std::endl;
+
+    std::cout << "Welcome to GX interactive mode!" << std::endl;
+    std::cout << std::endl;
+    std::cout << "This tool helps you play with computational chemistry using Gaussian:" << std::endl;
+    std::cout << "> High-performance multi-threaded extraction of thermodynamic data and energy components"
+              << std::endl;
+    std::cout << "> Job status checking and error detection" << std::endl;
+    std::cout << "> High-level theoryGibbs free energy calculations with thermal corrections " << std::endl;
+    std::cout << "> Coordinate extraction and Gaussian input file generation" << std::endl;
+    std::cout << std::endl;
+    std::cout << "For help and available commands, type 'help' in interactive mode." << std::endl;
+    std::cout << "Type 'help <command>' for command-specific help, e.g. 'help ci' for input creation." << std::endl;
+    std::cout << "To exit, type 'exit' or 'quit'." << std::endl;
+    std::cout << std::endl;
+}
+
+
 /**
  * @brief Main entry point for the Gaussian Extractor application
  *
@@ -125,33 +155,18 @@ int main(int argc, char* argv[])
         // Check if running without arguments
         bool no_arguments = (argc == 1);
 
+        // 'interactive' enters interactive mode on every platform
+        if (argc == 2 && std::string(argv[1]) == "interactive")
+        {
+            print_interactive_welcome();
+            return run_interactive_loop();
+        }
 
         if (no_arguments)
         {
 #ifdef _WIN32
             // On Windows, no arguments means double-clicked - show intro and enter interactive mode
-            std::cout << std::endl;
-            std::cout << "==================================================" << std::endl;
-            std::cout << GaussianExtractor::get_version_info() << std::endl;
-            std::cout << "==================================================" << std::endl;
-            std::cout << std::endl;
-
-            std::cout << "Welcome to GX interactive mode!" << std::endl;
-            std::cout << std::endl;
-            std::cout << "This tool helps you play with computational chemistry using Gaussian:" << std::endl;
-            std::cout << "> High-performance multi-threaded extraction of thermodynamic data and energy components"
-                      << std::endl;
-            std::cout << "> Job status checking and error detection" << std::endl;
-            std::cout << "> High-level theoryGibbs free energy calculations with thermal corrections " << std::endl;
-            std::cout << "> Coordinate extraction and Gaussian input file generation" << std::endl;
-            std::cout << std::endl;
-            std::cout << "For help and available commands, type 'help' in interactive mode." << std::endl;
-            std::cout << "Type 'help <command>' for command-specific help, e.g. 'help ci' for input creation."
-                      << std::endl;
-            std::cout << "To exit, type 'exit' or 'quit'." << std::endl;
-            std::cout << std::endl;
-
-            // Enter interactive mode for Windows users
+            print_interactive_welcome();
             return run_interactive_loop();
 #else
             // On Linux/macOS, no arguments means run default extract command and exit
@@ -169,6 +184,7 @@ int main(int argc, char* argv[])
             }
 
             // Execute EXTRACT and exit
+            apply_cpu_placement(extract_context);
             int extract_result = execute_extract_command(extract_context);
 
             // On Linux, exit immediately after command execution
@@ -190,6 +206,12 @@ int main(int argc, char* argv[])
                 std::cerr << std::endl;
             }
 
+            if (context.profile)
+            {
+                Profiler::start(!context.profile_trace.empty());
+            }
+            apply_cpu_placement(context);
+
             // Execute based on command type - dispatch to appropriate handler
             int command_result;
             switch (context.command)
@@ -234,12 +256,38 @@ int main(int argc, char* argv[])
                     command_result = execute_create_input_command(context);
                     break;
 
+                case CommandType::MERGE:
+                    command_result = execute_merge_command(context);
+                    break;
+
+                case CommandType::WATCH:
+                    command_result = execute_watch_command(context);
+                    break;
+
+                case CommandType::PIPELINE:
+                    command_result = execute_pipeline_command(context);
+                    break;
+
                 default:
                     std::cerr << "Error: Unknown command type" << std::endl;
                     command_result = 1;
                     break;
             }
 
+            if (context.profile)
+            {
+                Profiler::report(std::cout);
+                std::string error;
+                if (!context.profile_trace.empty() && !Profiler::write_trace(context.profile_trace, error))
+                {
+                    std::cerr << "Warning: " << error << std::endl;
+                }
+                else if (!context.profile_trace.empty())
+                {
+                    std::cout << "Profile trace written to " << context.profile_trace << std::endl;
+                }
+            }
+
             return command_result;
         }
     }
@@ -32,6 +32,10 @@ namespace HelpUtils
         std::cout << "  high-au           Calculate high-level energies in atomic units\n";
         std::cout << "  xyz               Extract final coordinates to XYZ format\n";
         std::cout << "  ci                Create inputs from xyz coordinate files\n";
+        std::cout << "  merge             Combine the partial results of a sharded extract\n";
+        std::cout << "  watch             Stay resident and move jobs as soon as they finish\n";
+        std::cout << "  pipeline          Run check, extract, xyz and high-level stages in one read\n";
+        std::cout << "  interactive       Enter interactive mode (state stays warm between commands)\n";
         std::cout << "\nOptions:\n";
         std::cout << "  -h, --help        Show this help message\n";
         std::cout << "  -v, --version     Show version information\n";
@@ -57,13 +61,31 @@ namespace HelpUtils
                 std::cout << "Additional Options:\n";
                 std::cout << "  -t, --temp <K>          Temperature in Kelvin (default: 298.15)\n";
                 std::cout << "  -c, --concentration <M> Concentration in M for phase correction (default: 1.0)\n";
-                std::cout << "  -f, --format <fmt>      Output format: text|csv (default: text)\n";
+                std::cout << "  -f, --format <fmt>      Output format: text|csv|bin (default: text)\n";
                 std::cout << "  -col, --column <N>      Sort column 1-7 (default: 2)\n";
                 std::cout
                     << "                        1=Name, 2=G kJ/mol, 3=G a.u, 4=G eV, 5=LowFQ, 6=Status, 7=PhCorr\n";
                 std::cout << "  --input-temp            Use temperature from input files\n";
                 std::cout << "  --show-resources        Show system resource information\n";
                 std::cout << "  --memory-limit <MB>     Maximum memory usage in MB (default: auto)\n";
+                std::cout << "  --scan-mode <mode>      Log scanner: fast|tail|legacy|verify (default: fast)\n";
+                std::cout << "                          tail reads finished jobs backwards from the end of file\n";
+                std::cout << "                          verify cross-checks fast against legacy and warns on mismatch\n";
+                std::cout << "  --stream                Write rows as files finish; summary follows the table\n";
+                std::cout << "  --io-depth <N|auto>     Logs read ahead by separate I/O threads (default: auto,\n";
+                std::cout << "                          16 on Lustre/GPFS/NFS/SMB, off on local disks; 0 = off)\n";
+                std::cout << "  -r, --recursive         Also search subdirectories for log files\n";
+                std::cout << "  --with-xyz              Also write final geometries (as xyz does) in the same scan\n";
+                std::cout << "  --where <expr>          Keep rows matching all predicates, e.g. \"lf<0,status=DONE\"\n";
+                std::cout << "                          (columns by number or name: name, etg, lf, gibbs, nuclear,\n";
+                std::cout << "                          scf, zpe, status, pcorr, round, or a custom field)\n";
+                std::cout << "  --top <K>               Write only the first K rows in sort order\n";
+                std::cout << "  --sort <col>            Sort column by number or name (same as -col)\n";
+                std::cout << "  --shard <i/N|auto[/N]>  Process shard i (0..N-1) of an array job and write\n";
+                std::cout << "                          {current_dir}.shard-i-of-N.bin for merge; auto reads the\n";
+                std::cout << "                          index (and N) from SLURM/PBS/SGE/LSF array variables\n";
+                std::cout << "  --resume                Journal parsed logs and reuse those an interrupted run\n";
+                std::cout << "                          already parsed (.gaussian_extractor.extract.journal)\n";
                 break;
 
             case CommandType::CHECK_DONE:
@@ -105,7 +127,7 @@ namespace HelpUtils
                 std::cout << "Additional Options:\n";
                 std::cout << "  -t, --temp <K>          Temperature in Kelvin (default: from input or 298.15)\n";
                 std::cout << "  -c, --concentration <M> Concentration in M for phase correction (default: 1.0)\n";
-                std::cout << "  -f, --format <fmt>      Output format: text|csv (default: text)\n";
+                std::cout << "  -f, --format <fmt>      Output format: text|csv|bin (default: text)\n";
                 std::cout << "  -col, --column <N>      Sort column 1-7 (default: 2)\n";
                 std::cout
                     << "                        1=Name, 2=G kJ/mol, 3=G a.u, 4=G eV, 5=LowFQ, 6=Status, 7=PhCorr\n\n";
@@ -121,7 +143,7 @@ namespace HelpUtils
                 std::cout << "Additional Options:\n";
                 std::cout << "  -t, --temp <K>          Temperature in Kelvin (default: from input or 298.15)\n";
                 std::cout << "  -c, --concentration <M> Concentration in M for phase correction (default: 1.0)\n";
-                std::cout << "  -f, --format <fmt>      Output format: text|csv (default: text)\n";
+                std::cout << "  -f, --format <fmt>      Output format: text|csv|bin (default: text)\n";
                 std::cout << "  -col, --column <N>      Sort column 1-10 (default: 2)\n";
                 std::cout
                     << "                          1=Name, 2=E high, 3=E low, 4=ZPE, 5=TC, 6=TS, 7=H, 8=G, 9=LowFQ, "
@@ -140,6 +162,8 @@ namespace HelpUtils
                 std::cout << "Additional Options:\n";
                 std::cout
                     << "  -f, --files <file1[,file2,...]> Single file or comma-separated list of files to process\n";
+                std::cout << "  --all-frames                    Write every geometry with its SCF energy as a\n";
+                std::cout << "                                  multi-frame XYZ file (IRC, scans, BOMD)\n";
                 break;
 
             case CommandType::CREATE_INPUT:
@@ -207,6 +231,44 @@ namespace HelpUtils
                 std::cout << "  (optionally specify a directory, defaults to current directory).\n";
                 std::cout << "  Then use --param-file to load the parameters from your customized template.\n";
                 break;
+
+            case CommandType::MERGE:
+                std::cout << "Description: Combine the partial results of a sharded extract\n\n";
+                std::cout << "Each task of an array job running 'extract --shard i/N' writes\n";
+                std::cout << "{current_dir}.shard-i-of-N.bin. This command reads the partials named on the\n";
+                std::cout << "command line, or all of them in the current directory, sorts and merges\n";
+                std::cout << "their rows and writes the usual results table. Missing shards are reported.\n\n";
+                std::cout << "Additional Options:\n";
+                std::cout << "  -f, --format <fmt>      Output format: text|csv|bin (default: text)\n";
+                std::cout << "  -col, --column <N>      Sort column, as for extract (default: 2)\n";
+                std::cout << "  <partial files>         Partial results to merge (default: *.shard-*-of-*.bin)\n\n";
+                break;
+
+            case CommandType::WATCH:
+                std::cout << "Description: Watch the current directory and organize jobs as they finish\n\n";
+                std::cout << "Existing logs are checked once, as by 'check'. The command then stays running,\n";
+                std::cout << "reads only the bytes appended to each log and moves a job to\n";
+                std::cout << "{current_dir}-{suffix}/, errorJobs/ or PCMMkU/ once its log has terminated\n";
+                std::cout << "and not changed for the settle time. Stop it with Ctrl+C.\n\n";
+                std::cout << "Changes are detected with inotify on Linux; on Lustre, NFS, GPFS and other\n";
+                std::cout << "network file systems the directory is polled instead.\n\n";
+                std::cout << "Additional Options:\n";
+                std::cout << "  --interval <s>          Seconds between listings when polling (default: 10)\n";
+                std::cout << "  --settle <s>            Seconds a finished log must stay unchanged (default: 30)\n";
+                std::cout << "  --poll                  Poll even where inotify is available\n\n";
+                break;
+
+            case CommandType::PIPELINE:
+                std::cout << "Description: Run several commands' work from one read of each log\n\n";
+                std::cout << "Logs are discovered once and each is read once by the extract scanner. The\n";
+                std::cout << "same content is classified (check), written to the results table (extract),\n";
+                std::cout << "saved as its final geometry (xyz) and combined with the parent directory's\n";
+                std::cout << "thermal data (high-kj/high-au). Checked jobs are moved after everything else.\n\n";
+                std::cout << "Additional Options:\n";
+                std::cout << "  --stages <list>         Comma-separated stages: check,extract,xyz,high-kj,high-au\n";
+                std::cout << "                          (default: pipeline_stages config, check,extract,xyz)\n";
+                std::cout << "  -t, -c, -f, -col, ...   Extract options; -col also sorts the high-level tables\n\n";
+                break;
         }
 
         std::cout << "Options:\n";
@@ -215,8 +277,12 @@ namespace HelpUtils
         std::cout << "  -q, --quiet           Quiet mode (minimal output)\n";
         std::cout << "  --max-file-size <MB>  Maximum file size in MB (default: 100)\n";
         std::cout << "  --batch-size <N>      Batch size for large directories (default: auto)\n";
+        std::cout << "  --index, --no-index   Reuse unchanged results from .gaussian_extractor.idx\n";
+        std::cout << "  --pin <policy>        Pin threads to the job's CPUs: none|compact|scatter (default: none)\n";
+        std::cout << "  --profile             Print time per phase (read, parse, sort, ...) and counters\n";
+        std::cout << "  --profile-trace <f>   Also write the timed phases as a Chrome trace (JSON)\n";
 
-        if (command == CommandType::CHECK_DONE)
+        if (command == CommandType::CHECK_DONE || command == CommandType::WATCH || command == CommandType::PIPELINE)
         {
             std::cout << "  --dir-suffix <suffix> Directory suffix (default: done)\n";
             std::cout << "                        Creates {current_dir}-{suffix}/\n";
@@ -227,11 +293,33 @@ namespace HelpUtils
             std::cout << "  --target-dir <name>   Custom target directory name\n";
         }
 
-        if (command == CommandType::CHECK_ERRORS)
+        if (command == CommandType::CHECK_ERRORS || command == CommandType::WATCH ||
+            command == CommandType::PIPELINE)
         {
             std::cout << "  --show-details        Show actual error messages found\n";
         }
 
+        if (command == CommandType::CHECK_DONE || command == CommandType::CHECK_ERRORS ||
+            command == CommandType::CHECK_PCM || command == CommandType::CHECK_IMAGINARY ||
+            command == CommandType::CHECK_ALL || command == CommandType::PIPELINE)
+        {
+            std::cout << "  --dry-run             Report the planned moves without moving any file\n";
+            std::cout << "  --manifest <file>     Write planned moves as 'source<TAB>destination' lines\n";
+        }
+
+        if (command == CommandType::CHECK_DONE || command == CommandType::CHECK_ERRORS ||
+            command == CommandType::CHECK_PCM || command == CommandType::CHECK_IMAGINARY ||
+            command == CommandType::CHECK_ALL)
+        {
+            std::cout << "  --resume              Journal moves; first complete those an interrupted run left\n";
+            std::cout << "  --undo-moves          Put back the files of interrupted moves and exit\n";
+        }
+
+        if (command == CommandType::WATCH)
+        {
+            std::cout << "  --dry-run             Report finished jobs without moving any file\n";
+        }
+
         std::cout << "  -h, --help            Show this help message\n";
         std::cout << "  -v, --version         Show version information\n\n";
 
@@ -258,6 +346,7 @@ namespace HelpUtils
             std::cout << "  " << program_name << " " << cmd_name << " -q           # Quiet mode\n";
             std::cout << "  " << program_name << " " << cmd_name
                       << " -f file1.log,file2.log  # Process specific files\n";
+            std::cout << "  " << program_name << " " << cmd_name << " --all-frames # Multi-frame trajectories\n";
         }
         else if (command == CommandType::CREATE_INPUT)
         {
@@ -311,6 +400,29 @@ namespace HelpUtils
                       << " --dir-suffix completed  # Use 'completed' suffix\n";
         }
 
+        if (command == CommandType::EXTRACT)
+        {
+            std::cout << "  " << program_name << " " << cmd_name
+                      << " --shard auto  # One shard per array task, then run merge\n";
+        }
+
+        if (command == CommandType::MERGE)
+        {
+            std::cout << "  " << program_name << " " << cmd_name << " -f csv     # Merge all partials to CSV\n";
+        }
+
+        if (command == CommandType::WATCH)
+        {
+            std::cout << "  " << program_name << " " << cmd_name
+                      << " --index --settle 60 &  # Keep a running campaign organized\n";
+        }
+
+        if (command == CommandType::PIPELINE)
+        {
+            std::cout << "  " << program_name << " " << cmd_name
+                      << " --stages check,extract,xyz,high-kj  # Nightly run, one read per log\n";
+        }
+
         std::cout << "\n";
     }
 
@@ -336,6 +448,13 @@ namespace HelpUtils
         std::cout << "  output_extensions = .log,.out\n";
         std::cout << "  input_extensions = .com,.gjf,.gau\n";
         std::cout << "  default_threads = 4\n\n";
+
+        std::cout << "Custom extract fields (extra result columns, read in the same scan):\n";
+        std::cout << "  field.<name> = \"anchor=<text>; field=<N> | offset=<N>; type=double|int|string;\n";
+        std::cout << "                  occurrence=first|last|all|count; reset=<text>\"\n";
+        std::cout << "  field.dipole = \"anchor=' Tot='; occurrence=last\"\n";
+        std::cout << "  field.lumo   = \"anchor=Alpha virt. eigenvalues; field=5; occurrence=first; "
+                     "reset=Alpha  occ. eigenvalues\"\n\n";
     }
 
     void create_default_config()
@@ -13,6 +13,7 @@
 #include "input_gen/parameter_parser.h"
 #include "utilities/command_system.h"
 #include "utilities/config_manager.h"
+#include "utilities/session_state.h"
 #include "utilities/utils.h"
 #include "utilities/version.h"
 #include <atomic>
@@ -270,6 +271,9 @@ public:
                              "high-au",
                              "xyz",
                              "ci",
+                             "merge",
+                             "watch",
+                             "pipeline",
                              "help",
                              "exit",
                              "quit",
@@ -413,6 +417,26 @@ private:
 
     void add_filesystem_completions(const std::string& prefix, std::vector<std::string>& matches)
     {
+        // Names in the working directory come from the session's listing, which is not read again per key
+        SessionState* session = SessionState::active();
+        if (session && prefix.find('\\') == std::string::npos && prefix.find('/') == std::string::npos &&
+            session->directory().watching())
+        {
+            for (const auto& entry : session->directory().entries())
+            {
+                if (istarts_with(entry.name, prefix))
+                {
+                    std::string completion = entry.directory ? entry.name + "\\" : entry.name;
+                    if (completion.find(' ') != std::string::npos)
+                    {
+                        completion = "\"" + completion + "\"";
+                    }
+                    matches.push_back(completion);
+                }
+            }
+            return;
+        }
+
         try
         {
             fs::path    prefix_path(prefix);
@@ -801,6 +825,9 @@ int run_interactive_loop()
     std::cout << "https://github.com/lenhanpham/gaussian-extractor" << std::endl;
     std::cout << "\nType 'help' for available commands, 'exit' or 'quit' to exit." << std::endl;
 
+    // Directory listing, result index and job resources stay warm between the commands of the session
+    SessionState session;
+
 #ifdef _WIN32
     // Windows with TAB completion
     std::cout << "Press TAB for command and file completion." << std::endl;
@@ -1129,7 +1156,10 @@ int run_interactive_loop()
                                                                            {"high-kj", CommandType::HIGH_LEVEL_KJ},
                                                                            {"high-au", CommandType::HIGH_LEVEL_AU},
                                                                            {"xyz", CommandType::EXTRACT_COORDS},
-                                                                           {"ci", CommandType::CREATE_INPUT}};
+                                                                           {"ci", CommandType::CREATE_INPUT},
+                                                                           {"merge", CommandType::MERGE},
+                                                                           {"watch", CommandType::WATCH},
+                                                                           {"pipeline", CommandType::PIPELINE}};
 
             auto it = command_map.find(help_arg);
             if (it != command_map.end())
@@ -1327,7 +1357,10 @@ int run_interactive_loop()
                                                                         "xyz",
                                                                         "--extract-coord",
                                                                         "ci",
-                                                                        "--create-input"};
+                                                                        "--create-input",
+                                                                        "merge",
+                                                                        "watch",
+                                                                        "pipeline"};
 
                 bool is_valid_gaussian_command = false;
                 for (const auto& cmd : valid_commands)
@@ -1372,6 +1405,8 @@ int run_interactive_loop()
                                 std::cerr << std::endl;
                             }
 
+                            apply_cpu_placement(context);
+
                             // Execute based on command type
                             int result = 0;
                             switch (context.command)
@@ -1406,6 +1441,15 @@ int run_interactive_loop()
                                 case CommandType::CREATE_INPUT:
                                     result = execute_create_input_command(context);
                                     break;
+                                case CommandType::MERGE:
+                                    result = execute_merge_command(context);
+                                    break;
+                                case CommandType::WATCH:
+                                    result = execute_watch_command(context);
+                                    break;
+                                case CommandType::PIPELINE:
+                                    result = execute_pipeline_command(context);
+                                    break;
                                 default:
                                     std::cerr << "Unknown command" << std::endl;
                                     result = 1;
@@ -25,6 +25,10 @@ int execute_high_level_kj_command(const CommandContext& context);
 int execute_high_level_au_command(const CommandContext& context);
 int execute_extract_coords_command(const CommandContext& context);
 int execute_create_input_command(const CommandContext& context);
+int execute_merge_command(const CommandContext& context);
+int execute_watch_command(const CommandContext& context);
+int execute_pipeline_command(const CommandContext& context);
+void apply_cpu_placement(const CommandContext& context);
 
 /**
  * @brief Interactive command loop for Windows double-click usage
@@ -0,0 +1,532 @@
+/**
+ * @file columnar_writer.cpp
+ * @brief Implementation of the typed, column-oriented binary output and its reader
+ * @author Le Nhan Pham
+ * @date 2025
+ */
+
+#include "columnar_writer.h"
+#include <cstring>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+
+namespace
+{
+    const char HEADER_MAGIC[]    = "GXCOLS01";
+    const char ROW_GROUP_MAGIC[] = "ROWGROUP";
+    const char FOOTER_MAGIC[]    = "GXCOLEND";
+
+    /**
+     * @brief Append the little-endian bytes of a value
+     */
+    template <typename T>
+    void append_le(std::string& buffer, T value)
+    {
+        char bytes[sizeof(T)];
+        std::memcpy(bytes, &value, sizeof(T));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+        for (size_t i = 0; i < sizeof(T) / 2; ++i)
+        {
+            std::swap(bytes[i], bytes[sizeof(T) - 1 - i]);
+        }
+#endif
+        buffer.append(bytes, sizeof(T));
+    }
+
+    /**
+     * @brief Read a little-endian value at a byte position
+     */
+    template <typename T>
+    T read_le(const char* data)
+    {
+        char bytes[sizeof(T)];
+        std::memcpy(bytes, data, sizeof(T));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+        for (size_t i = 0; i < sizeof(T) / 2; ++i)
+        {
+            std::swap(bytes[i], bytes[sizeof(T) - 1 - i]);
+        }
+#endif
+        T value;
+        std::memcpy(&value, bytes, sizeof(T));
+        return value;
+    }
+
+    /**
+     * @brief Bytes per value of a fixed-width column
+     */
+    size_t value_width(ColumnarWriter::Type type)
+    {
+        switch (type)
+        {
+            case ColumnarWriter::Type::FLOAT64:
+                return 8;
+            case ColumnarWriter::Type::INT32:
+                return 4;
+            case ColumnarWriter::Type::BOOL:
+                return 1;
+            default:
+                return 0;
+        }
+    }
+
+    /**
+     * @brief Zero bytes that bring size up to a multiple of 8
+     */
+    size_t padding(size_t size)
+    {
+        return (8 - size % 8) % 8;
+    }
+}  // namespace
+
+// =============================================================================
+// ColumnarWriter Implementation
+// =============================================================================
+
+ColumnarWriter::ColumnarWriter(const std::string& path, const std::vector<Column>& columns, size_t rows_per_group)
+    : path_(path), rows_per_group_(rows_per_group > 0 ? rows_per_group : 1), cursor_(0), group_rows_(0),
+      total_rows_(0), group_count_(0), closed_(false)
+{
+    out_.open(path, std::ios::binary | std::ios::trunc);
+    if (!out_.is_open())
+    {
+        throw std::runtime_error("Could not open output file: " + path);
+    }
+
+    std::string header(HEADER_MAGIC, 8);
+    append_le<uint32_t>(header, static_cast<uint32_t>(columns.size()));
+    append_le<uint32_t>(header, 0);
+    for (const auto& column : columns)
+    {
+        header.push_back(static_cast<char>(column.type));
+        header.push_back('\0');
+        append_le<uint16_t>(header, static_cast<uint16_t>(column.name.size()));
+        header += column.name;
+
+        ColumnBuffer buffer;
+        buffer.type = column.type;
+        if (column.type == Type::STRING)
+        {
+            buffer.offsets.push_back(0);
+        }
+        columns_.push_back(std::move(buffer));
+    }
+    header.append(padding(header.size()), '\0');
+
+    out_.write(header.data(), static_cast<std::streamsize>(header.size()));
+}
+
+ColumnarWriter::~ColumnarWriter()
+{
+    try
+    {
+        close();
+    }
+    catch (...)
+    {
+    }
+}
+
+ColumnarWriter::ColumnBuffer& ColumnarWriter::next_column(Type type)
+{
+    if (cursor_ >= columns_.size() || columns_[cursor_].type != type)
+    {
+        throw std::logic_error("Column type mismatch while writing " + path_);
+    }
+    return columns_[cursor_++];
+}
+
+void ColumnarWriter::add_double(double value)
+{
+    append_le(next_column(Type::FLOAT64).values, value);
+}
+
+void ColumnarWriter::add_int(int32_t value)
+{
+    append_le(next_column(Type::INT32).values, value);
+}
+
+void ColumnarWriter::add_bool(bool value)
+{
+    next_column(Type::BOOL).values.push_back(value ? '\1' : '\0');
+}
+
+void ColumnarWriter::add_string(std::string_view value)
+{
+    ColumnBuffer& column = next_column(Type::STRING);
+    column.values.append(value.data(), value.size());
+    column.offsets.push_back(static_cast<int32_t>(column.values.size()));
+}
+
+void ColumnarWriter::end_row()
+{
+    if (cursor_ != columns_.size())
+    {
+        throw std::logic_error("Incomplete row while writing " + path_);
+    }
+    cursor_ = 0;
+    ++group_rows_;
+    ++total_rows_;
+
+    if (group_rows_ >= rows_per_group_)
+    {
+        flush_row_group();
+    }
+}
+
+void ColumnarWriter::write_buffer(const char* data, size_t size)
+{
+    std::string length;
+    append_le<uint64_t>(length, size);
+    out_.write(length.data(), static_cast<std::streamsize>(length.size()));
+    out_.write(data, static_cast<std::streamsize>(size));
+
+    static const char zeros[8] = {};
+    out_.write(zeros, static_cast<std::streamsize>(padding(size)));
+}
+
+void ColumnarWriter::flush_row_group()
+{
+    if (group_rows_ == 0)
+    {
+        return;
+    }
+
+    std::string header(ROW_GROUP_MAGIC, 8);
+    append_le<uint64_t>(header, group_rows_);
+    out_.write(header.data(), static_cast<std::streamsize>(header.size()));
+
+    std::string offsets;
+    for (auto& column : columns_)
+    {
+        if (column.type == Type::STRING)
+        {
+            offsets.clear();
+            for (int32_t offset : column.offsets)
+            {
+                append_le(offsets, offset);
+            }
+            write_buffer(offsets.data(), offsets.size());
+            column.offsets.assign(1, 0);
+        }
+        write_buffer(column.values.data(), column.values.size());
+        column.values.clear();
+    }
+
+    group_rows_ = 0;
+    ++group_count_;
+}
+
+void ColumnarWriter::close()
+{
+    if (closed_)
+    {
+        return;
+    }
+    closed_ = true;
+
+    flush_row_group();
+
+    std::string footer(FOOTER_MAGIC, 8);
+    append_le<uint64_t>(footer, total_rows_);
+    append_le<uint64_t>(footer, group_count_);
+    out_.write(footer.data(), static_cast<std::streamsize>(footer.size()));
+    out_.close();
+
+    if (out_.fail())
+    {
+        throw std::runtime_error("Could not write output file: " + path_);
+    }
+}
+
+// =============================================================================
+// ColumnarBatch Implementation
+// =============================================================================
+
+ColumnarBatch::ColumnarBatch(const std::vector<ColumnarWriter::Column>& columns)
+    : columns_(columns), data_(columns.size()), cursor_(0), rows_(0)
+{
+    for (size_t column = 0; column < columns_.size(); ++column)
+    {
+        if (columns_[column].type == ColumnarWriter::Type::STRING)
+        {
+            data_[column].ints.push_back(0);
+        }
+    }
+}
+
+ColumnarBatch::ColumnData& ColumnarBatch::next_column(ColumnarWriter::Type type)
+{
+    if (cursor_ >= columns_.size() || columns_[cursor_].type != type)
+    {
+        throw std::logic_error("Column type mismatch while filling a batch");
+    }
+    return data_[cursor_++];
+}
+
+void ColumnarBatch::add_double(double value)
+{
+    next_column(ColumnarWriter::Type::FLOAT64).doubles.push_back(value);
+}
+
+void ColumnarBatch::add_int(int32_t value)
+{
+    next_column(ColumnarWriter::Type::INT32).ints.push_back(value);
+}
+
+void ColumnarBatch::add_bool(bool value)
+{
+    next_column(ColumnarWriter::Type::BOOL).bools.push_back(value ? 1 : 0);
+}
+
+void ColumnarBatch::add_string(std::string_view value)
+{
+    ColumnData& column = next_column(ColumnarWriter::Type::STRING);
+    column.bytes.append(value.data(), value.size());
+    column.ints.push_back(static_cast<int32_t>(column.bytes.size()));
+}
+
+void ColumnarBatch::end_row()
+{
+    if (cursor_ != columns_.size())
+    {
+        throw std::logic_error("Incomplete row while filling a batch");
+    }
+    cursor_ = 0;
+    ++rows_;
+}
+
+size_t ColumnarBatch::find(std::string_view name) const
+{
+    for (size_t column = 0; column < columns_.size(); ++column)
+    {
+        if (columns_[column].name == name)
+        {
+            return column;
+        }
+    }
+    return columns_.size();
+}
+
+const ColumnarBatch::ColumnData& ColumnarBatch::column_data(size_t column, ColumnarWriter::Type type) const
+{
+    if (column >= columns_.size() || columns_[column].type != type)
+    {
+        throw std::out_of_range("Column " + std::to_string(column) + " of the batch does not have the requested type");
+    }
+    return data_[column];
+}
+
+const std::vector<double>& ColumnarBatch::doubles(size_t column) const
+{
+    return column_data(column, ColumnarWriter::Type::FLOAT64).doubles;
+}
+
+const std::vector<int32_t>& ColumnarBatch::ints(size_t column) const
+{
+    return column_data(column, ColumnarWriter::Type::INT32).ints;
+}
+
+const std::vector<uint8_t>& ColumnarBatch::bools(size_t column) const
+{
+    return column_data(column, ColumnarWriter::Type::BOOL).bools;
+}
+
+const std::vector<int32_t>& ColumnarBatch::string_offsets(size_t column) const
+{
+    return column_data(column, ColumnarWriter::Type::STRING).ints;
+}
+
+const std::string& ColumnarBatch::string_data(size_t column) const
+{
+    return column_data(column, ColumnarWriter::Type::STRING).bytes;
+}
+
+std::string_view ColumnarBatch::get_string(size_t column, size_t row) const
+{
+    const ColumnData& data = column_data(column, ColumnarWriter::Type::STRING);
+    if (row >= rows_)
+    {
+        throw std::out_of_range("Row " + std::to_string(row) + " is not in the batch");
+    }
+    return std::string_view(data.bytes).substr(static_cast<size_t>(data.ints[row]),
+                                               static_cast<size_t>(data.ints[row + 1] - data.ints[row]));
+}
+
+// =============================================================================
+// ColumnarReader Implementation
+// =============================================================================
+
+ColumnarReader::ColumnarReader(const std::string& path) : path_(path), rows_(0)
+{
+    std::ifstream in(path, std::ios::binary);
+    if (!in.is_open())
+    {
+        throw std::runtime_error("Could not open input file: " + path);
+    }
+    std::string file((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    if (in.bad())
+    {
+        throw std::runtime_error("Could not read input file: " + path);
+    }
+
+    size_t pos  = 0;
+    auto   fail = [&path](const std::string& reason) {
+        return std::runtime_error("Invalid columnar file " + path + ": " + reason);
+    };
+    auto need = [&](size_t bytes) {
+        if (file.size() - pos < bytes)
+        {
+            throw fail("unexpected end of file");
+        }
+    };
+    auto magic = [&](const char* expected) {
+        need(8);
+        bool match = file.compare(pos, 8, expected, 8) == 0;
+        pos += 8;
+        return match;
+    };
+    auto buffer = [&](std::string_view& bytes) {
+        need(8);
+        uint64_t size = read_le<uint64_t>(file.data() + pos);
+        pos += 8;
+        if (size > file.size() - pos)
+        {
+            throw fail("unexpected end of file");
+        }
+        bytes = std::string_view(file.data() + pos, static_cast<size_t>(size));
+        pos += static_cast<size_t>(size);
+        need(padding(static_cast<size_t>(size)));
+        pos += padding(static_cast<size_t>(size));
+    };
+
+    if (!magic(HEADER_MAGIC))
+    {
+        throw fail("not a columnar results file");
+    }
+    need(8);
+    uint32_t column_count = read_le<uint32_t>(file.data() + pos);
+    pos += 8;
+    for (uint32_t c = 0; c < column_count; ++c)
+    {
+        need(4);
+        auto     type   = static_cast<ColumnarWriter::Type>(static_cast<uint8_t>(file[pos]));
+        uint16_t length = read_le<uint16_t>(file.data() + pos + 2);
+        pos += 4;
+        need(length);
+        if (type != ColumnarWriter::Type::STRING && value_width(type) == 0)
+        {
+            throw fail("unknown column type");
+        }
+        columns_.push_back({file.substr(pos, length), type});
+        pos += length;
+    }
+    need(padding(pos));
+    pos += padding(pos);
+
+    data_.resize(columns_.size());
+    for (size_t c = 0; c < columns_.size(); ++c)
+    {
+        if (columns_[c].type == ColumnarWriter::Type::STRING)
+        {
+            data_[c].offsets.push_back(0);
+        }
+    }
+
+    uint64_t groups = 0;
+    while (true)
+    {
+        size_t section = pos;
+        if (!magic(ROW_GROUP_MAGIC))
+        {
+            pos = section;
+            break;
+        }
+        need(8);
+        uint64_t group_rows = read_le<uint64_t>(file.data() + pos);
+        pos += 8;
+
+        for (size_t c = 0; c < columns_.size(); ++c)
+        {
+            ColumnData&      column = data_[c];
+            std::string_view values;
+            if (columns_[c].type == ColumnarWriter::Type::STRING)
+            {
+                std::string_view offsets;
+                buffer(offsets);
+                buffer(values);
+                if (offsets.size() != (group_rows + 1) * 4)
+                {
+                    throw fail("string offsets do not match the row count");
+                }
+
+                uint64_t base     = column.values.size();
+                int32_t  previous = 0;
+                for (uint64_t r = 1; r <= group_rows; ++r)
+                {
+                    int32_t offset = read_le<int32_t>(offsets.data() + r * 4);
+                    if (offset < previous || static_cast<uint64_t>(offset) > values.size())
+                    {
+                        throw fail("string offsets out of range");
+                    }
+                    column.offsets.push_back(base + static_cast<uint64_t>(offset));
+                    previous = offset;
+                }
+            }
+            else
+            {
+                buffer(values);
+                if (values.size() != group_rows * value_width(columns_[c].type))
+                {
+                    throw fail("column length does not match the row count");
+                }
+            }
+            column.values.append(values.data(), values.size());
+        }
+
+        rows_ += group_rows;
+        ++groups;
+    }
+
+    if (!magic(FOOTER_MAGIC))
+    {
+        throw fail("missing footer (incomplete file)");
+    }
+    need(16);
+    if (read_le<uint64_t>(file.data() + pos) != rows_ || read_le<uint64_t>(file.data() + pos + 8) != groups)
+    {
+        throw fail("footer does not match the row groups");
+    }
+}
+
+const ColumnarReader::ColumnData&
+ColumnarReader::column_data(size_t column, ColumnarWriter::Type type, uint64_t row) const
+{
+    if (column >= columns_.size() || columns_[column].type != type || row >= rows_)
+    {
+        throw std::out_of_range("No such value in " + path_);
+    }
+    return data_[column];
+}
+
+double ColumnarReader::get_double(size_t column, uint64_t row) const
+{
+    return read_le<double>(column_data(column, ColumnarWriter::Type::FLOAT64, row).values.data() + row * 8);
+}
+
+int32_t ColumnarReader::get_int(size_t column, uint64_t row) const
+{
+    return read_le<int32_t>(column_data(column, ColumnarWriter::Type::INT32, row).values.data() + row * 4);
+}
+
+bool ColumnarReader::get_bool(size_t column, uint64_t row) const
+{
+    return column_data(column, ColumnarWriter::Type::BOOL, row).values[row] != '\0';
+}
+
+std::string_view ColumnarReader::get_string(size_t column, uint64_t row) const
+{
+    const ColumnData& data = column_data(column, ColumnarWriter::Type::STRING, row);
+    return std::string_view(data.values).substr(data.offsets[row], data.offsets[row + 1] - data.offsets[row]);
+}
@@ -0,0 +1,321 @@
+/**
+ * @file columnar_writer.h
+ * @brief Typed, column-oriented binary output (--format bin) and its reader
+ * @author Le Nhan Pham
+ * @date 2025
+ *
+ * This header provides the writer behind the "bin" output format of extract,
+ * high-kj and high-au. Rows are collected column by column and written in row
+ * groups as they arrive, so nothing is formatted as text and nothing waits for
+ * a pass over all results. Every buffer is little-endian and starts at a
+ * multiple of 8 bytes from the beginning of the file, so a reader can wrap it
+ * without copying (numpy.frombuffer / pandas / polars).
+ *
+ * @section Layout
+ * @verbatim
+   File     := Header RowGroup* Footer
+   Header   := "GXCOLS01" u32 column_count u32 0
+               column_count x { u8 type, u8 0, u16 name_length, name }
+               zero padding to a multiple of 8
+   RowGroup := "ROWGROUP" u64 row_count
+               column_count x Buffers
+   Buffers  := FLOAT64 / INT32 / BOOL: one Buffer of row_count values
+               STRING: one Buffer of row_count + 1 i32 offsets into a second
+               Buffer holding the UTF-8 bytes (the Arrow string layout)
+   Buffer   := u64 byte_length, bytes, zero padding to a multiple of 8
+   Footer   := "GXCOLEND" u64 total_rows u64 row_group_count
+   @endverbatim
+ *
+ * Type codes: 1 = FLOAT64 (<f8), 2 = INT32 (<i4), 3 = BOOL (u8 0/1),
+ * 4 = STRING.
+ *
+ * ColumnarReader loads such a file back, which merge uses to combine the
+ * partial results of a sharded extract without going through text.
+ *
+ * ColumnarBatch holds the same columns in memory, in native byte order, for
+ * callers that use the extractor as a library (see ExtractSession): each
+ * column is one contiguous array that bindings hand out without copying.
+ */
+
+#ifndef COLUMNAR_WRITER_H
+#define COLUMNAR_WRITER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief Rows per row group unless a writer is given another size
+ */
+const size_t COLUMNAR_ROWS_PER_GROUP = 65536;
+
+/**
+ * @class ColumnarWriter
+ * @brief Writes rows of a fixed schema as typed column buffers in row groups
+ *
+ * Values of a row are added in column order with the add_* call matching the
+ * column type, then end_row() completes the row. The writer is not
+ * thread-safe; callers that produce rows on several threads serialise them.
+ */
+class ColumnarWriter
+{
+public:
+    /**
+     * @enum Type
+     * @brief Storage type of a column
+     */
+    enum class Type : uint8_t
+    {
+        FLOAT64 = 1,  ///< IEEE double
+        INT32   = 2,  ///< Signed 32-bit integer
+        BOOL    = 3,  ///< One byte, 0 or 1
+        STRING  = 4   ///< UTF-8 text with 32-bit offsets
+    };
+
+    /**
+     * @struct Column
+     * @brief Name and type of one column
+     */
+    struct Column
+    {
+        std::string name;  ///< Column name as seen by readers
+        Type        type;  ///< Storage type
+    };
+
+    /**
+     * @brief Create the file and write its header
+     * @param path Output file
+     * @param columns Schema of every row
+     * @param rows_per_group Rows collected before a row group is written
+     * @throws std::runtime_error if the file cannot be opened
+     */
+    ColumnarWriter(const std::string&         path,
+                   const std::vector<Column>& columns,
+                   size_t                     rows_per_group = COLUMNAR_ROWS_PER_GROUP);
+
+    /**
+     * @brief Finish the file if close() was not called; errors are ignored
+     */
+    ~ColumnarWriter();
+
+    ColumnarWriter(const ColumnarWriter&)            = delete;
+    ColumnarWriter& operator=(const ColumnarWriter&) = delete;
+
+    /**
+     * @brief Add the value of the next FLOAT64 column of the current row
+     */
+    void add_double(double value);
+
+    /**
+     * @brief Add the value of the next INT32 column of the current row
+     */
+    void add_int(int32_t value);
+
+    /**
+     * @brief Add the value of the next BOOL column of the current row
+     */
+    void add_bool(bool value);
+
+    /**
+     * @brief Add the value of the next STRING column of the current row
+     */
+    void add_string(std::string_view value);
+
+    /**
+     * @brief Complete the current row; writes a row group when it is full
+     * @throws std::logic_error if not every column received a value
+     */
+    void end_row();
+
+    /**
+     * @brief Write the last row group and the footer and close the file
+     * @throws std::runtime_error if the file could not be written
+     */
+    void close();
+
+    /**
+     * @brief Number of completed rows
+     */
+    uint64_t row_count() const
+    {
+        return total_rows_;
+    }
+
+private:
+    struct ColumnBuffer
+    {
+        Type                 type;     ///< Storage type
+        std::string          values;   ///< Little-endian values, or the bytes of a STRING column
+        std::vector<int32_t> offsets;  ///< STRING only: row_count + 1 offsets into values
+    };
+
+    ColumnBuffer& next_column(Type type);
+    void          write_buffer(const char* data, size_t size);
+    void          flush_row_group();
+
+    std::string               path_;            ///< Output file, for error messages
+    std::ofstream             out_;             ///< Output stream (binary)
+    std::vector<ColumnBuffer> columns_;         ///< Values of the current row group
+    size_t                    rows_per_group_;  ///< Rows per row group
+    size_t                    cursor_;          ///< Next column of the current row
+    uint64_t                  group_rows_;      ///< Rows in the current row group
+    uint64_t                  total_rows_;      ///< Rows written or buffered
+    uint64_t                  group_count_;     ///< Row groups written
+    bool                      closed_;          ///< Whether the footer was written
+};
+
+/**
+ * @class ColumnarBatch
+ * @brief Rows of a fixed schema held in memory as one contiguous array per column
+ *
+ * Filled through the same add_* / end_row() calls as ColumnarWriter, so the
+ * code that produces rows serves both. FLOAT64 columns are arrays of double,
+ * INT32 of int32_t, BOOL of uint8_t (0/1); a STRING column is row_count() + 1
+ * int32_t offsets into its UTF-8 bytes (the Arrow string layout). Not
+ * thread-safe.
+ */
+class ColumnarBatch
+{
+public:
+    /**
+     * @brief Create an empty batch
+     * @param columns Schema of every row
+     */
+    explicit ColumnarBatch(const std::vector<ColumnarWriter::Column>& columns = {});
+
+    /**
+     * @brief Add the value of the next column of the current row (see ColumnarWriter)
+     * @throws std::logic_error if the next column has another type
+     */
+    void add_double(double value);
+    void add_int(int32_t value);
+    void add_bool(bool value);
+    void add_string(std::string_view value);
+
+    /**
+     * @brief Complete the current row
+     * @throws std::logic_error if not every column received a value
+     */
+    void end_row();
+
+    /**
+     * @brief Schema of the batch
+     */
+    const std::vector<ColumnarWriter::Column>& columns() const
+    {
+        return columns_;
+    }
+
+    /**
+     * @brief Number of completed rows
+     */
+    size_t row_count() const
+    {
+        return rows_;
+    }
+
+    /**
+     * @brief Index of a column by name
+     * @return Column index; columns().size() if there is no such column
+     */
+    size_t find(std::string_view name) const;
+
+    /**
+     * @brief Values of a FLOAT64, INT32 or BOOL column (row_count() entries)
+     * @throws std::out_of_range if the column has another type
+     */
+    const std::vector<double>&  doubles(size_t column) const;
+    const std::vector<int32_t>& ints(size_t column) const;
+    const std::vector<uint8_t>& bools(size_t column) const;
+
+    /**
+     * @brief Offsets (row_count() + 1) and UTF-8 bytes of a STRING column
+     * @throws std::out_of_range if the column has another type
+     */
+    const std::vector<int32_t>& string_offsets(size_t column) const;
+    const std::string&          string_data(size_t column) const;
+
+    /**
+     * @brief One value of a STRING column
+     */
+    std::string_view get_string(size_t column, size_t row) const;
+
+private:
+    struct ColumnData
+    {
+        std::vector<double>  doubles;  ///< FLOAT64 values
+        std::vector<int32_t> ints;     ///< INT32 values, or STRING offsets
+        std::vector<uint8_t> bools;    ///< BOOL values
+        std::string          bytes;    ///< STRING bytes
+    };
+
+    ColumnData&       next_column(ColumnarWriter::Type type);
+    const ColumnData& column_data(size_t column, ColumnarWriter::Type type) const;
+
+    std::vector<ColumnarWriter::Column> columns_;  ///< Schema
+    std::vector<ColumnData>             data_;     ///< Values of every row
+    size_t                              cursor_;   ///< Next column of the current row
+    size_t                              rows_;     ///< Completed rows
+};
+
+/**
+ * @class ColumnarReader
+ * @brief Loads a file written by ColumnarWriter and gives typed access to its values
+ *
+ * The whole file is read and validated on construction; row groups are
+ * concatenated, so rows are numbered from 0 to row_count() - 1.
+ */
+class ColumnarReader
+{
+public:
+    /**
+     * @brief Read and validate a columnar file
+     * @param path File written by ColumnarWriter
+     * @throws std::runtime_error if the file cannot be read or is not a complete columnar file
+     */
+    explicit ColumnarReader(const std::string& path);
+
+    /**
+     * @brief Schema of the file
+     */
+    const std::vector<ColumnarWriter::Column>& columns() const
+    {
+        return columns_;
+    }
+
+    /**
+     * @brief Number of rows in the file
+     */
+    uint64_t row_count() const
+    {
+        return rows_;
+    }
+
+    /**
+     * @brief Values of a FLOAT64 column, an INT32 column, ... by column index and row
+     * @throws std::out_of_range if the column has another type or the row does not exist
+     */
+    double           get_double(size_t column, uint64_t row) const;
+    int32_t          get_int(size_t column, uint64_t row) const;
+    bool             get_bool(size_t column, uint64_t row) const;
+    std::string_view get_string(size_t column, uint64_t row) const;
+
+private:
+    struct ColumnData
+    {
+        std::string           values;   ///< Little-endian values, or the bytes of a STRING column
+        std::vector<uint64_t> offsets;  ///< STRING only: rows + 1 offsets into values
+    };
+
+    const ColumnData& column_data(size_t column, ColumnarWriter::Type type, uint64_t row) const;
+
+    std::string                         path_;     ///< Input file, for error messages
+    std::vector<ColumnarWriter::Column> columns_;  ///< Schema
+    std::vector<ColumnData>             data_;     ///< Values of every row group, concatenated
+    uint64_t                            rows_;     ///< Rows in the file
+};
+
+#endif  // COLUMNAR_WRITER_H
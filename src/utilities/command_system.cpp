@@ -1,7 +1,10 @@
 #include "command_system.h"
+#include "extraction/custom_fields.h"
+#include "extraction/result_filter.h"
 #include "input_gen/parameter_parser.h"
 #include "ui/help_utils.h"
 #include "config_manager.h"
+#include "session_state.h"
 #include "utils.h"
 #include "version.h"
 #include <algorithm>
@@ -32,8 +35,9 @@ CommandContext CommandParser::parse(int argc, char* argv[])
     // Apply configuration defaults after config is loaded
     apply_config_to_context(context);
 
-    // Detect job scheduler resources early
-    context.job_resources = JobSchedulerDetector::detect_job_resources();
+    // Detect job scheduler resources early (once per interactive session)
+    SessionState* session = SessionState::active();
+    context.job_resources = session ? session->job_resources() : JobSchedulerDetector::detect_job_resources();
 
     // If no arguments, default to EXTRACT
     if (argc == 1)
@@ -235,12 +239,8 @@ CommandContext CommandParser::parse(int argc, char* argv[])
             }
         }
 
-        // Parse common options first
-        int original_i = i;
-        parse_common_options(context, i, argc, argv);
-
         // Parse command-specific options only if common options didn't handle this argument
-        if (i == original_i)
+        if (!parse_common_options(context, i, argc, argv))
         {
             if (context.command == CommandType::EXTRACT || context.command == CommandType::HIGH_LEVEL_KJ ||
                 context.command == CommandType::HIGH_LEVEL_AU)
@@ -255,6 +255,18 @@ CommandContext CommandParser::parse(int argc, char* argv[])
             {
                 parse_create_input_options(context, i, argc, argv);
             }
+            else if (context.command == CommandType::MERGE)
+            {
+                parse_merge_options(context, i, argc, argv);
+            }
+            else if (context.command == CommandType::WATCH)
+            {
+                parse_watch_options(context, i, argc, argv);
+            }
+            else if (context.command == CommandType::PIPELINE)
+            {
+                parse_pipeline_options(context, i, argc, argv);
+            }
             else
             {
                 parse_checker_options(context, i, argc, argv);
@@ -288,6 +300,12 @@ CommandType CommandParser::parse_command(const std::string& cmd)
         return CommandType::EXTRACT_COORDS;
     if (cmd == "ci" || cmd == "--create-input")
         return CommandType::CREATE_INPUT;
+    if (cmd == "merge")
+        return CommandType::MERGE;
+    if (cmd == "watch")
+        return CommandType::WATCH;
+    if (cmd == "pipeline")
+        return CommandType::PIPELINE;
 
     // If it starts with '-', it's probably an option, not a command
     if (!cmd.empty() && cmd.front() == '-')
@@ -321,12 +339,18 @@ std::string CommandParser::get_command_name(CommandType command)
             return std::string("xyz");
         case CommandType::CREATE_INPUT:
             return std::string("ci");
+        case CommandType::MERGE:
+            return std::string("merge");
+        case CommandType::WATCH:
+            return std::string("watch");
+        case CommandType::PIPELINE:
+            return std::string("pipeline");
         default:
             return std::string("unknown");
     }
 }
 
-void CommandParser::parse_common_options(CommandContext& context, int& i, int argc, char* argv[])
+bool CommandParser::parse_common_options(CommandContext& context, int& i, int argc, char* argv[])
 {
     std::string arg = argv[i];
 
@@ -454,6 +478,55 @@ void CommandParser::parse_common_options(CommandContext& context, int& i, int ar
             add_warning(context, "Error: Batch size value required after --batch-size.");
         }
     }
+    else if (arg == "--index")
+    {
+        context.use_result_index = true;
+    }
+    else if (arg == "--no-index")
+    {
+        context.use_result_index = false;
+    }
+    else if (arg == "--pin")
+    {
+        if (++i < argc)
+        {
+            std::string policy = argv[i];
+            if (policy == "none" || policy == "compact" || policy == "scatter")
+            {
+                context.pin_policy = policy;
+            }
+            else
+            {
+                add_warning(context, "Error: Pin policy must be 'none', 'compact' or 'scatter'. Threads are not pinned.");
+                context.pin_policy = "none";
+            }
+        }
+        else
+        {
+            add_warning(context, "Error: Pin policy required after --pin.");
+        }
+    }
+    else if (arg == "--profile")
+    {
+        context.profile = true;
+    }
+    else if (arg == "--profile-trace")
+    {
+        if (++i < argc)
+        {
+            context.profile       = true;
+            context.profile_trace = argv[i];
+        }
+        else
+        {
+            add_warning(context, "Error: Trace file required after --profile-trace.");
+        }
+    }
+    else
+    {
+        return false;
+    }
+    return true;
 }
 
 void CommandParser::parse_extract_options(CommandContext& context, int& i, int argc, char* argv[])
@@ -547,13 +620,13 @@ void CommandParser::parse_extract_options(CommandContext& context, int& i, int a
         if (++i < argc)
         {
             std::string fmt = argv[i];
-            if (fmt == "text" || fmt == "csv")
+            if (fmt == "text" || fmt == "csv" || fmt == "bin")
             {
                 context.output_format = fmt;
             }
             else
             {
-                add_warning(context, "Error: Format must be 'text' or 'csv'. Using default 'text'.");
+                add_warning(context, "Error: Format must be 'text', 'csv' or 'bin'. Using default 'text'.");
                 context.output_format = "text";
             }
         }
@@ -592,6 +665,138 @@ void CommandParser::parse_extract_options(CommandContext& context, int& i, int a
     {
         context.show_resource_info = true;
     }
+    else if (arg == "--stream")
+    {
+        context.stream_output = true;
+    }
+    else if (arg == "-r" || arg == "--recursive")
+    {
+        context.recursive = true;
+    }
+    else if (arg == "--with-xyz")
+    {
+        context.with_xyz = true;
+    }
+    else if (arg == "--resume" && context.command == CommandType::EXTRACT)
+    {
+        context.resume = true;
+    }
+    else if (arg == "--shard")
+    {
+        if (++i < argc)
+        {
+            if (!parse_shard(context, argv[i]))
+            {
+                add_warning(context,
+                            "Error: Shard must be i/N with 0 <= i < N, or 'auto'/'auto/N' in an array job. "
+                            "Processing all files.");
+            }
+        }
+        else
+        {
+            add_warning(context, "Error: Shard value required after --shard.");
+        }
+    }
+    else if (arg == "--where")
+    {
+        if (++i < argc)
+        {
+            ResultFilter filter;
+            std::string  error;
+            if (filter.add(argv[i], error))
+            {
+                context.where.push_back(argv[i]);
+            }
+            else
+            {
+                add_warning(context, "Error: Invalid --where filter: " + error + ". Filter ignored.");
+            }
+        }
+        else
+        {
+            add_warning(context, "Error: Filter expression required after --where.");
+        }
+    }
+    else if (arg == "--top")
+    {
+        if (++i < argc)
+        {
+            try
+            {
+                int count = std::stoi(argv[i]);
+                if (count > 0)
+                {
+                    context.top = static_cast<size_t>(count);
+                }
+                else
+                {
+                    add_warning(context, "Error: Top count must be positive. Writing all rows.");
+                }
+            }
+            catch (const std::exception& e)
+            {
+                add_warning(context, "Error: Invalid top count format. Writing all rows.");
+            }
+        }
+        else
+        {
+            add_warning(context, "Error: Row count required after --top.");
+        }
+    }
+    else if (arg == "--sort")
+    {
+        if (++i < argc)
+        {
+            int col = ResultFilter::column_number(argv[i]);
+            if (col > 0)
+            {
+                context.sort_column = col;
+            }
+            else
+            {
+                add_warning(context, "Error: Sort column must be 1-10 or a column name. Using default column 2.");
+            }
+        }
+        else
+        {
+            add_warning(context, "Error: Column required after --sort.");
+        }
+    }
+    else if (arg == "--io-depth")
+    {
+        if (++i < argc)
+        {
+            if (!parse_io_depth(argv[i], context.io_depth))
+            {
+                add_warning(context, "Error: I/O depth must be a non-negative number or 'auto'. Using 'auto'.");
+                context.io_depth = -1;
+            }
+        }
+        else
+        {
+            add_warning(context, "Error: I/O depth value required after --io-depth.");
+        }
+    }
+    else if (arg == "--scan-mode")
+    {
+        if (++i < argc)
+        {
+            std::string mode = argv[i];
+            if (mode == "fast" || mode == "tail" || mode == "legacy" || mode == "verify")
+            {
+                context.scan_mode = mode;
+            }
+            else
+            {
+                add_warning(context, "Error: Scan mode must be 'fast', 'tail', 'legacy' or 'verify'. Using default 'fast'.");
+                context.scan_mode = "fast";
+            }
+        }
+        else
+        {
+            add_warning(context, "Error: Scan mode value required after --scan-mode.");
+        }
+    }
     else if (!arg.empty() && arg.front() == '-')
     {
         add_warning(context, "Warning: Unknown argument '" + arg + "' ignored.");
@@ -628,6 +833,30 @@ void CommandParser::parse_checker_options(CommandContext& context, int& i, int a
     {
         context.show_error_details = true;
     }
+    else if (arg == "--dry-run")
+    {
+        context.dry_run = true;
+    }
+    else if (arg == "--resume")
+    {
+        context.resume = true;
+    }
+    else if (arg == "--undo-moves")
+    {
+        context.resume     = true;
+        context.undo_moves = true;
+    }
+    else if (arg == "--manifest")
+    {
+        if (++i < argc)
+        {
+            context.move_manifest = argv[i];
+        }
+        else
+        {
+            add_warning(context, "Error: File name required after --manifest.");
+        }
+    }
     else if (!arg.empty() && arg.front() == '-')
     {
         add_warning(context, "Warning: Unknown argument '" + arg + "' ignored.");
@@ -703,6 +932,233 @@ void CommandParser::parse_xyz_options(CommandContext& context, int& i, int argc,
             add_warning(context, "--files requires a filename or list of filenames");
         }
     }
+    else if (arg == "--all-frames")
+    {
+        context.all_frames = true;
+    }
+}
+
+void CommandParser::parse_merge_options(CommandContext& context, int& i, int argc, char* argv[])
+{
+    std::string arg = argv[i];
+
+    if (arg == "-f" || arg == "--format" || arg == "-col" || arg == "--column")
+    {
+        parse_extract_options(context, i, argc, argv);
+    }
+    else if (!arg.empty() && arg.front() == '-')
+    {
+        add_warning(context, "Warning: Unknown argument '" + arg + "' ignored.");
+    }
+    else
+    {
+        context.specific_files.push_back(arg);
+    }
+}
+
+void CommandParser::parse_watch_options(CommandContext& context, int& i, int argc, char* argv[])
+{
+    std::string arg = argv[i];
+
+    if (arg == "--interval" || arg == "--settle")
+    {
+        double& value    = (arg == "--interval") ? context.watch_interval : context.watch_settle;
+        double  fallback = (arg == "--interval") ? 10.0 : 30.0;
+        if (++i < argc)
+        {
+            try
+            {
+                value = std::stod(argv[i]);
+                if (value < 0 || (arg == "--interval" && value == 0))
+                {
+                    add_warning(context, "Warning: " + arg + " must be positive. Using default " +
+                                             std::to_string(static_cast<int>(fallback)) + " s.");
+                    value = fallback;
+                }
+            }
+            catch (const std::exception& e)
+            {
+                add_warning(context, "Error: Invalid " + arg + " format. Using default " +
+                                         std::to_string(static_cast<int>(fallback)) + " s.");
+                value = fallback;
+            }
+        }
+        else
+        {
+            add_warning(context, "Error: Seconds required after " + arg + ".");
+        }
+    }
+    else if (arg == "--poll")
+    {
+        context.watch_polling = true;
+    }
+    else if (arg == "--resume" || arg == "--undo-moves")
+    {
+        // A watch session moves each cycle's jobs as they finish; there is no run to continue
+        add_warning(context, "Warning: " + arg + " is not supported by watch; ignored.");
+    }
+    else if (arg == "--manifest")
+    {
+        // The moves of a watch session are planned one cycle at a time
+        add_warning(context, "Warning: --manifest is not supported by watch; ignored.");
+        if (i + 1 < argc)
+        {
+            ++i;
+        }
+    }
+    else
+    {
+        parse_checker_options(context, i, argc, argv);
+    }
+}
+
+void CommandParser::parse_pipeline_options(CommandContext& context, int& i, int argc, char* argv[])
+{
+    std::string arg = argv[i];
+
+    if (arg == "--stages")
+    {
+        if (++i < argc)
+        {
+            std::vector<std::string> stages;
+            if (parse_pipeline_stages(argv[i], stages))
+            {
+                context.pipeline_stages = stages;
+            }
+            else
+            {
+                add_warning(context,
+                            "Error: Stages must be a comma-separated list of check, extract, xyz, high-kj and "
+                            "high-au. Using default stages.");
+            }
+        }
+        else
+        {
+            add_warning(context, "Error: Stage list required after --stages.");
+        }
+    }
+    else if (arg == "--target-dir" || arg == "--dir-suffix" || arg == "--show-details" || arg == "--dry-run" ||
+             arg == "--manifest")
+    {
+        parse_checker_options(context, i, argc, argv);
+    }
+    else
+    {
+        parse_extract_options(context, i, argc, argv);
+    }
+}
+
+bool CommandParser::parse_pipeline_stages(const std::string& value, std::vector<std::string>& stages)
+{
+    // The results table is the base every other stage is fed from
+    stages = {"extract"};
+    for (auto name : ConfigUtils::split_string(value, ','))
+    {
+        name.erase(0, name.find_first_not_of(" \t"));
+        name.erase(name.find_last_not_of(" \t") + 1);
+        if (name != "check" && name != "extract" && name != "xyz" && name != "high-kj" && name != "high-au")
+        {
+            return false;
+        }
+        if (std::find(stages.begin(), stages.end(), name) == stages.end())
+        {
+            stages.push_back(name);
+        }
+    }
+    return true;
+}
+
+bool CommandParser::parse_io_depth(const std::string& value, int& depth)
+{
+    if (value == "auto")
+    {
+        depth = -1;
+        return true;
+    }
+    try
+    {
+        size_t used   = 0;
+        long   number = std::stol(value, &used);
+        if (used != value.size() || number < 0 || number > 256)
+        {
+            return false;
+        }
+        depth = static_cast<int>(number);
+        return true;
+    }
+    catch (const std::exception&)
+    {
+        return false;
+    }
+}
+
+bool CommandParser::parse_shard(CommandContext& context, const std::string& value)
+{
+    size_t      slash = value.find('/');
+    std::string first = value.substr(0, slash);
+    long        count = 0;
+    if (slash != std::string::npos)
+    {
+        try
+        {
+            size_t used = 0;
+            count       = std::stol(value.substr(slash + 1), &used);
+            if (used != value.size() - slash - 1)
+            {
+                return false;
+            }
+        }
+        catch (const std::exception&)
+        {
+            return false;
+        }
+        if (count <= 0)
+        {
+            return false;
+        }
+    }
+
+    if (first == "auto")
+    {
+        unsigned int index      = 0;
+        unsigned int task_count = 0;
+        if (!JobSchedulerDetector::get_array_task(context.job_resources.scheduler_type, index, task_count))
+        {
+            return false;
+        }
+        if (count == 0)
+        {
+            if (task_count == 0)
+            {
+                return false;
+            }
+            count = task_count;
+        }
+        context.shard_index = index % static_cast<unsigned int>(count);
+        context.shard_count = static_cast<unsigned int>(count);
+        return true;
+    }
+
+    if (count == 0)
+    {
+        return false;
+    }
+    try
+    {
+        size_t used  = 0;
+        long   index = std::stol(first, &used);
+        if (used != first.size() || index < 0 || index >= count)
+        {
+            return false;
+        }
+        context.shard_index = static_cast<unsigned int>(index);
+        context.shard_count = static_cast<unsigned int>(count);
+        return true;
+    }
+    catch (const std::exception&)
+    {
+        return false;
+    }
 }
 
 void CommandParser::add_warning(CommandContext& context, const std::string& warning)
@@ -724,6 +1180,14 @@ void CommandParser::validate_context(CommandContext& context)
     {
         context.max_file_size_mb = g_config_manager.get_default_max_file_size();
     }
+
+    // Only extract writes partial results that merge can combine
+    if (context.shard_count > 0 && context.command != CommandType::EXTRACT)
+    {
+        add_warning(context, "Warning: --shard is only supported by extract; processing all files.");
+        context.shard_index = 0;
+        context.shard_count = 0;
+    }
 }
 
 void CommandParser::apply_config_to_context(CommandContext& context)
@@ -746,8 +1210,26 @@ void CommandParser::apply_config_to_context(CommandContext& context)
     context.output_format      = g_config_manager.get_default_output_format();
     context.use_input_temp     = g_config_manager.get_bool("use_input_temp");
     context.memory_limit_mb    = g_config_manager.get_size_t("memory_limit_mb");
+    context.scan_mode          = g_config_manager.get_string("scan_mode");
+    parse_io_depth(g_config_manager.get_string("io_depth"), context.io_depth);
+    context.pin_policy         = g_config_manager.get_string("cpu_pinning");
+    context.use_result_index   = g_config_manager.get_bool("result_index");
     context.show_error_details = g_config_manager.get_bool("show_error_details");
     context.dir_suffix         = g_config_manager.get_string("done_directory_suffix");
+
+    std::vector<std::string> stages;
+    if (parse_pipeline_stages(g_config_manager.get_string("pipeline_stages"), stages))
+    {
+        context.pipeline_stages = stages;
+    }
+
+    // User-defined extract fields ("field.<name>" lines); invalid specs are skipped with a warning
+    std::vector<std::string> field_errors;
+    CustomFieldSet::install(CustomFieldSet::from_config(g_config_manager.get_custom_fields(), field_errors));
+    for (const auto& error : field_errors)
+    {
+        add_warning(context, "Warning: " + error);
+    }
 }
 
 void CommandParser::load_configuration()
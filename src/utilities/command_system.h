@@ -22,6 +22,9 @@
  * - check-all: Run comprehensive job status checks
  * - high-kj: Calculate high-level energies with output in kJ/mol units
  * - high-au: Calculate high-level energies with detailed output in atomic units
+ * - merge: Combine the partial results of a sharded extract
+ * - watch: Stay resident and organize jobs as they finish
+ * - pipeline: Check, extract, write geometries and high-level energies from one read of each log
  *
  * @section Integration
  * The command system integrates with:
@@ -61,7 +64,10 @@ enum class CommandType
     HIGH_LEVEL_KJ,    ///< Calculate high-level energies with output in kJ/mol units
     HIGH_LEVEL_AU,    ///< Calculate high-level energies with detailed output in atomic units
     EXTRACT_COORDS,   ///< Extract coordinates from log files and organize XYZ files
-    CREATE_INPUT      ///< Create Gaussian input files from XYZ files
+    CREATE_INPUT,     ///< Create Gaussian input files from XYZ files
+    MERGE,            ///< Combine the partial results of a sharded extract (extract --shard)
+    WATCH,            ///< Watch the directory and organize jobs as they finish
+    PIPELINE          ///< Run several commands' stages from one read of each log
 };
 
 /**
@@ -87,27 +93,53 @@ struct CommandContext
     unsigned int             requested_threads;  ///< Number of threads requested by user
     size_t                   max_file_size_mb;   ///< Maximum individual file size in MB
     size_t                   batch_size;         ///< Batch size for processing large directories (0 = auto)
+    bool                     use_result_index;   ///< Reuse unchanged results from .gaussian_extractor.idx
+    bool                     profile;            ///< Print per-phase times and counters after the command
+    std::string              profile_trace;      ///< Chrome trace file of the profiled scopes ("" = none)
+    std::string              pin_policy;         ///< Thread placement on the allowed CPUs ("none", "compact", "scatter")
     std::string              extension;          ///< File extension to process (default: ".log")
     std::vector<std::string> valid_extensions;   ///< List of valid file extensions (e.g {".log", ".out"})
     std::vector<std::string> warnings;           ///< Collected warnings from parsing
     JobResources             job_resources;      ///< Job scheduler resource information
 
     // Extract-specific parameters
-    double      temp;                ///< Temperature for calculations (K)
-    int         concentration;       ///< Concentration for phase corrections (mM)
-    int         sort_column;         ///< Column number for result sorting
-    std::string output_format;       ///< Output format ("text", "csv", etc.)
-    bool        use_input_temp;      ///< Use temperature from input files
-    size_t      memory_limit_mb;     ///< Memory usage limit in MB
-    bool        show_resource_info;  ///< Display resource usage information
+    double                   temp;                ///< Temperature for calculations (K)
+    int                      concentration;       ///< Concentration for phase corrections (mM)
+    int                      sort_column;         ///< Column number for result sorting
+    std::string              output_format;       ///< Output format ("text", "csv", etc.)
+    bool                     use_input_temp;      ///< Use temperature from input files
+    size_t                   memory_limit_mb;     ///< Memory usage limit in MB
+    bool                     show_resource_info;  ///< Display resource usage information
+    std::string              scan_mode;           ///< Log scanning engine ("fast", "tail", "legacy", "verify")
+    bool                     stream_output;       ///< Write result rows as they complete, summary after the table
+    bool                     recursive;           ///< Also search subdirectories for log files
+    bool                     with_xyz;            ///< Write each log's final geometry during the extract scan
+    int                      io_depth;            ///< Logs read ahead by I/O threads (0 = off, -1 = auto)
+    std::vector<std::string> where;               ///< --where filter expressions, all of which must hold
+    size_t                   top;                 ///< Keep the first N rows in sort order (0 = all)
+    unsigned int             shard_index;         ///< Zero-based shard of this process (--shard i/N)
+    unsigned int             shard_count;         ///< Number of shards (0 = process every file)
+    bool                     resume;              ///< Journal the run and continue an interrupted one (also checkers)
 
     // Job checker-specific parameters
     std::string target_dir;          ///< Custom directory name for organizing files
     bool        show_error_details;  ///< Display detailed error messages from log files
     std::string dir_suffix;          ///< Custom suffix for completed job directory
+    bool        dry_run;             ///< Plan the file moves without carrying them out
+    std::string move_manifest;       ///< File receiving the planned moves ("" = none)
+    bool        undo_moves;          ///< Put back the files of moves an interrupted run left unfinished
+
+    // Watch-specific parameters
+    double watch_interval;  ///< Seconds between directory listings when polling
+    double watch_settle;    ///< Seconds a terminated log must stay unchanged before it is moved
+    bool   watch_polling;   ///< List the directory instead of using inotify
+
+    // Pipeline-specific parameters
+    std::vector<std::string> pipeline_stages;  ///< Stages fed from each read ("check", "extract", "xyz", "high-kj", "high-au")
 
     // Coordinate extraction-specific parameters
-    std::vector<std::string> specific_files;  ///< List of specific files to process (empty for all files)
+    std::vector<std::string> specific_files;  ///< Specific files to process, or partials to merge (empty for all files)
+    bool                     all_frames;      ///< Write every geometry of each log as a multi-frame XYZ file
 
     // Create input-specific parameters
     std::string ci_calc_type;              ///< Calculation type (sp, opt_freq, ts, etc.)
@@ -150,6 +182,9 @@ struct CommandContext
           requested_threads(0),                                                // Auto-detect thread count
           max_file_size_mb(100),                                               // 100MB max file size
           batch_size(0),                                                       // Auto-detect batch size (0 = disabled)
+          use_result_index(false),                                             // Parse every file
+          profile(false),                                                      // No instrumentation
+          pin_policy("none"),                                                  // Threads are not pinned
           extension(".log"),                                                   // Process .log files
           valid_extensions({".log", ".out", ".LOG", ".OUT", ".Log", ".Out"}),  // Valid output extensions
           temp(298.15),                                                        // Room temperature (25°C)
@@ -159,9 +194,27 @@ struct CommandContext
           use_input_temp(false),                    // Use fixed temperature
           memory_limit_mb(0),                       // No memory limit (auto-detect)
           show_resource_info(false),                // Don't show resource info by default
+          scan_mode("fast"),                        // Memory-mapped single-pass scanner
+          stream_output(false),                     // Buffer the table and write it in one go
+          recursive(false),                         // Current directory only
+          with_xyz(false),                          // Geometries come from the xyz command
+          io_depth(-1),                             // Read ahead on network file systems only
+          where(),                                  // Every result is written
+          top(0),                                   // No row limit
+          shard_index(0),                           // First shard
+          shard_count(0),                           // Not sharded
+          resume(false),                            // No journal
           target_dir(""),                           // Use default directory names
           show_error_details(false),                // Show minimal error info
           dir_suffix("done"),                       // Default suffix for completed jobs
+          dry_run(false),                           // Move the files
+          move_manifest(""),                        // No manifest
+          undo_moves(false),                        // Unfinished moves are completed by --resume
+          watch_interval(10.0),                     // Poll every 10 seconds
+          watch_settle(30.0),                       // Wait 30 seconds after the last write
+          watch_polling(false),                     // inotify where it works
+          pipeline_stages({"check", "extract", "xyz"}),  // The nightly check, extract and xyz runs
+          all_frames(false),                        // Last geometry only
           ci_calc_type("sp"),                       // Default to single point calculation
           ci_functional("UwB97XD"),                 // Default functional
           ci_basis("Def2SVPP"),                     // Default basis set
@@ -310,11 +363,12 @@ private:
      * @param i Current argument index (modified by reference)
      * @param argc Total number of arguments
      * @param argv Argument array
+     * @return true if the argument was a common option
      *
      * Handles options like --quiet, --threads, --max-size that are
      * available for all commands.
      */
-    static void parse_common_options(CommandContext& context, int& i, int argc, char* argv[]);
+    static bool parse_common_options(CommandContext& context, int& i, int argc, char* argv[]);
 
     /**
      * @brief Parse options specific to extract command
@@ -345,7 +399,7 @@ private:
      * @param argc Total number of arguments
      * @param argv Argument array
      *
-     * Handles xyz-specific options like --files.
+     * Handles xyz-specific options like --files and --all-frames.
      */
     static void parse_xyz_options(CommandContext& context, int& i, int argc, char* argv[]);
 
@@ -360,6 +414,70 @@ private:
      */
     static void parse_create_input_options(CommandContext& context, int& i, int argc, char* argv[]);
 
+    /**
+     * @brief Parse options specific to the merge command
+     * @param context CommandContext to populate
+     * @param i Current argument index (modified by reference)
+     * @param argc Total number of arguments
+     * @param argv Argument array
+     *
+     * Handles --format and --column; other arguments name partial results files.
+     */
+    static void parse_merge_options(CommandContext& context, int& i, int argc, char* argv[]);
+
+    /**
+     * @brief Parse options specific to the watch command
+     * @param context CommandContext to populate
+     * @param i Current argument index (modified by reference)
+     * @param argc Total number of arguments
+     * @param argv Argument array
+     *
+     * Handles --interval, --settle and --poll; the checker options --dir-suffix,
+     * --show-details and --dry-run are passed on to parse_checker_options().
+     */
+    static void parse_watch_options(CommandContext& context, int& i, int argc, char* argv[]);
+
+    /**
+     * @brief Parse options specific to the pipeline command
+     * @param context CommandContext to populate
+     * @param i Current argument index (modified by reference)
+     * @param argc Total number of arguments
+     * @param argv Argument array
+     *
+     * Handles --stages; the checker options --dir-suffix, --show-details,
+     * --dry-run and --manifest go to parse_checker_options(), everything
+     * else to parse_extract_options().
+     */
+    static void parse_pipeline_options(CommandContext& context, int& i, int argc, char* argv[]);
+
+    /**
+     * @brief Parse a comma-separated list of pipeline stages
+     * @param value Stage names, e.g. "check,extract,xyz,high-kj"
+     * @param stages Receives the stage names (extract is always included)
+     * @return false if a name is not a known stage
+     */
+    static bool parse_pipeline_stages(const std::string& value, std::vector<std::string>& stages);
+
+    /**
+     * @brief Parse the value of --shard ("i/N", "auto" or "auto/N")
+     * @param context CommandContext receiving shard_index and shard_count
+     * @param value Option value
+     * @return false if the value is invalid or "auto" finds no array job; the context is then unchanged
+     *
+     * "auto" takes the index and the number of tasks from the scheduler's
+     * array job variables; "auto/N" only takes the index, reduced modulo N,
+     * for schedulers that do not export the number of tasks.
+     */
+    static bool parse_shard(CommandContext& context, const std::string& value);
+
+    /**
+     * @brief Parse a read-ahead depth
+     * @param value A non-negative number of logs, or "auto"
+     * @param depth Receives the depth (-1 for "auto")
+     * @return false if the value is neither
+     */
+    static bool parse_io_depth(const std::string& value, int& depth);
+
     /**
      * @brief Add a warning message to the command context
      * @param context CommandContext to add warning to
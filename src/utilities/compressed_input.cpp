@@ -0,0 +1,697 @@
+/**
+ * @file compressed_input.cpp
+ * @brief Implementation of transparent reading of gzip and zstd compressed logs
+ * @author Le Nhan Pham
+ * @date 2025
+ */
+
+#include "compressed_input.h"
+#include <algorithm>
+#include <cctype>
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <streambuf>
+#include <utility>
+#include <vector>
+
+#ifdef HAVE_ZLIB
+    #include <zlib.h>
+#endif
+#ifdef HAVE_ZSTD
+    #include <zstd.h>
+#endif
+
+namespace
+{
+    const size_t INPUT_CHUNK_BYTES  = 256 * 1024;   ///< Compressed bytes read at a time
+    const size_t OUTPUT_CHUNK_BYTES = 1024 * 1024;  ///< Decompressed bytes produced at a time
+
+    bool ends_with_nocase(const char* name, size_t length, const char* suffix)
+    {
+        size_t suffix_length = std::strlen(suffix);
+        if (length <= suffix_length)
+        {
+            return false;
+        }
+        for (size_t i = 0; i < suffix_length; ++i)
+        {
+            if (std::tolower(static_cast<unsigned char>(name[length - suffix_length + i])) != suffix[i])
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    uint32_t read_le32(const unsigned char* bytes)
+    {
+        return static_cast<uint32_t>(bytes[0]) | (static_cast<uint32_t>(bytes[1]) << 8) |
+               (static_cast<uint32_t>(bytes[2]) << 16) | (static_cast<uint32_t>(bytes[3]) << 24);
+    }
+
+    /**
+     * @brief Source of decompressed bytes
+     */
+    class Decoder
+    {
+    public:
+        virtual ~Decoder() = default;
+
+        /**
+         * @brief Produce up to size decompressed bytes
+         * @return Bytes produced; 0 at the end of the data
+         * @throws std::runtime_error on corrupt or truncated data
+         */
+        virtual size_t read(char* out, size_t size) = 0;
+    };
+
+#ifdef HAVE_ZLIB
+    /**
+     * @brief gzip/zlib streams, including concatenated gzip members
+     */
+    class GzipDecoder : public Decoder
+    {
+    public:
+        GzipDecoder(std::ifstream&& in, const std::string& path)
+            : in_(std::move(in)), path_(path), input_(INPUT_CHUNK_BYTES), in_member_(true), eof_(false)
+        {
+            std::memset(&stream_, 0, sizeof(stream_));
+            // 15 + 32: maximum window, detect the gzip or zlib header
+            if (inflateInit2(&stream_, 15 + 32) != Z_OK)
+            {
+                throw std::runtime_error("Could not initialise gzip decompression for " + path_);
+            }
+        }
+
+        ~GzipDecoder() override
+        {
+            inflateEnd(&stream_);
+        }
+
+        size_t read(char* out, size_t size) override
+        {
+            size = std::min(size, static_cast<size_t>(UINT_MAX));
+            while (true)
+            {
+                if (stream_.avail_in == 0 && !eof_)
+                {
+                    in_.read(input_.data(), static_cast<std::streamsize>(input_.size()));
+                    if (in_.bad())
+                    {
+                        throw std::runtime_error("I/O error reading file '" + path_ + "'");
+                    }
+                    stream_.next_in  = reinterpret_cast<Bytef*>(input_.data());
+                    stream_.avail_in = static_cast<uInt>(in_.gcount());
+                    eof_             = stream_.avail_in == 0;
+                }
+                if (stream_.avail_in == 0)
+                {
+                    if (in_member_)
+                    {
+                        throw std::runtime_error("Truncated compressed file: " + path_);
+                    }
+                    return 0;
+                }
+                if (!in_member_)
+                {
+                    inflateReset(&stream_);  // Another gzip member follows
+                    in_member_ = true;
+                }
+
+                stream_.next_out  = reinterpret_cast<Bytef*>(out);
+                stream_.avail_out = static_cast<uInt>(size);
+                int    rc         = inflate(&stream_, Z_NO_FLUSH);
+                size_t produced   = size - stream_.avail_out;
+                if (rc == Z_STREAM_END)
+                {
+                    in_member_ = false;
+                }
+                else if (rc != Z_OK && rc != Z_BUF_ERROR)
+                {
+                    throw std::runtime_error("Corrupt compressed data in " + path_ + ": " +
+                                             (stream_.msg ? stream_.msg : "inflate failed"));
+                }
+                if (produced > 0)
+                {
+                    return produced;
+                }
+            }
+        }
+
+    private:
+        std::ifstream     in_;         ///< Compressed file
+        std::string       path_;       ///< For error messages
+        std::vector<char> input_;      ///< Compressed bytes not yet consumed
+        z_stream          stream_;     ///< zlib state
+        bool              in_member_;  ///< Inside a gzip member (its end not reached yet)
+        bool              eof_;        ///< The compressed file is exhausted
+    };
+#endif
+
+#ifdef HAVE_ZSTD
+    /**
+     * @brief Zstandard frames, read from a frame boundary to the end of the file
+     */
+    class ZstdDecoder : public Decoder
+    {
+    public:
+        ZstdDecoder(std::ifstream&& in, const std::string& path)
+            : in_(std::move(in)), path_(path), input_(INPUT_CHUNK_BYTES), stream_(ZSTD_createDStream()),
+              in_frame_(1), output_full_(false), eof_(false)
+        {
+            if (!stream_ || ZSTD_isError(ZSTD_initDStream(stream_)))
+            {
+                ZSTD_freeDStream(stream_);
+                throw std::runtime_error("Could not initialise zstd decompression for " + path_);
+            }
+            buffer_ = {input_.data(), 0, 0};
+        }
+
+        ~ZstdDecoder() override
+        {
+            ZSTD_freeDStream(stream_);
+        }
+
+        size_t read(char* out, size_t size) override
+        {
+            while (true)
+            {
+                if (buffer_.pos == buffer_.size && !eof_)
+                {
+                    in_.read(input_.data(), static_cast<std::streamsize>(input_.size()));
+                    if (in_.bad())
+                    {
+                        throw std::runtime_error("I/O error reading file '" + path_ + "'");
+                    }
+                    buffer_ = {input_.data(), static_cast<size_t>(in_.gcount()), 0};
+                    eof_    = buffer_.size == 0;
+                }
+
+                // With the input exhausted, data can still be waiting in the decoder if the last output was full
+                bool exhausted = buffer_.pos == buffer_.size && eof_;
+                if (exhausted && !output_full_)
+                {
+                    return finish();
+                }
+
+                ZSTD_outBuffer output = {out, size, 0};
+                size_t         rc     = ZSTD_decompressStream(stream_, &output, &buffer_);
+                if (ZSTD_isError(rc))
+                {
+                    throw std::runtime_error("Corrupt compressed data in " + path_ + ": " + ZSTD_getErrorName(rc));
+                }
+                in_frame_    = rc;
+                output_full_ = output.pos == output.size;
+                if (output.pos > 0)
+                {
+                    return output.pos;
+                }
+                if (exhausted)
+                {
+                    return finish();
+                }
+            }
+        }
+
+    private:
+        size_t finish() const
+        {
+            if (in_frame_ != 0)
+            {
+                throw std::runtime_error("Truncated compressed file: " + path_);
+            }
+            return 0;
+        }
+
+        std::ifstream     in_;           ///< Compressed file, positioned at a frame boundary
+        std::string       path_;         ///< For error messages
+        std::vector<char> input_;        ///< Compressed bytes
+        ZSTD_DStream*     stream_;       ///< libzstd state
+        ZSTD_inBuffer     buffer_;       ///< Unconsumed part of input_
+        size_t            in_frame_;     ///< Last ZSTD_decompressStream() result; 0 when a frame is complete
+        bool              output_full_;  ///< The last call filled the output buffer
+        bool              eof_;          ///< The compressed file is exhausted
+    };
+#endif
+
+    /**
+     * @brief One frame of a zstd file in the seekable format
+     */
+    struct SeekFrame
+    {
+        uint64_t compressed_offset;    ///< Position of the frame in the file
+        uint64_t decompressed_offset;  ///< Position of its content in the decompressed data
+    };
+
+    /**
+     * @brief Read the seek table at the end of a zstd file in the seekable format
+     * @return false if the file has no (valid) seek table
+     *
+     * The table is a skippable frame (magic 0x184D2A5E) holding one entry per
+     * frame (compressed size, decompressed size, optional checksum) and a
+     * footer with the frame count, a descriptor and the magic 0x8F92EAB1.
+     */
+    bool read_seek_table(const std::string& path, std::vector<SeekFrame>& frames, uint64_t& total_size)
+    {
+        std::ifstream in(path, std::ios::binary | std::ios::ate);
+        if (!in.is_open())
+        {
+            return false;
+        }
+        uint64_t file_size = static_cast<uint64_t>(in.tellg());
+        if (file_size < 17)
+        {
+            return false;
+        }
+
+        unsigned char footer[9];
+        in.seekg(static_cast<std::streamoff>(file_size - 9));
+        in.read(reinterpret_cast<char*>(footer), 9);
+        if (!in || read_le32(footer + 5) != 0x8F92EAB1U || (footer[4] & 0x7C) != 0)
+        {
+            return false;
+        }
+
+        uint64_t frame_count = read_le32(footer);
+        uint64_t entry_size  = (footer[4] & 0x80) ? 12 : 8;
+        uint64_t table_size  = frame_count * entry_size;
+        if (table_size + 17 > file_size)
+        {
+            return false;
+        }
+
+        std::vector<unsigned char> table(static_cast<size_t>(table_size + 8));
+        in.seekg(static_cast<std::streamoff>(file_size - 9 - table_size - 8));
+        in.read(reinterpret_cast<char*>(table.data()), static_cast<std::streamsize>(table.size()));
+        if (!in || read_le32(table.data()) != 0x184D2A5EU || read_le32(table.data() + 4) != table_size + 9)
+        {
+            return false;
+        }
+
+        frames.clear();
+        uint64_t compressed   = 0;
+        uint64_t decompressed = 0;
+        for (uint64_t i = 0; i < frame_count; ++i)
+        {
+            const unsigned char* entry = table.data() + 8 + i * entry_size;
+            frames.push_back({compressed, decompressed});
+            compressed += read_le32(entry);
+            decompressed += read_le32(entry + 4);
+        }
+        total_size = decompressed;
+
+        // The frames must fill the file up to the seek table
+        return compressed == file_size - 17 - table_size;
+    }
+
+    /**
+     * @brief Decoder for a compressed file, starting at a frame boundary
+     * @return nullptr if the file cannot be opened
+     * @throws std::runtime_error if the codec is not compiled in
+     */
+    std::unique_ptr<Decoder> make_decoder(const std::string& path, uint64_t offset = 0)
+    {
+        CompressedInput::Codec codec = CompressedInput::codec(path);
+        if (!CompressedInput::supported(codec))
+        {
+            throw std::runtime_error("Cannot read " + path + ": built without " +
+                                     CompressedInput::library(codec) + " support");
+        }
+
+        std::ifstream in(path, std::ios::binary);
+        if (!in.is_open())
+        {
+            return nullptr;
+        }
+        in.seekg(static_cast<std::streamoff>(offset));
+
+#ifdef HAVE_ZLIB
+        if (codec == CompressedInput::Codec::GZIP)
+        {
+            return std::make_unique<GzipDecoder>(std::move(in), path);
+        }
+#endif
+#ifdef HAVE_ZSTD
+        if (codec == CompressedInput::Codec::ZSTD)
+        {
+            return std::make_unique<ZstdDecoder>(std::move(in), path);
+        }
+#endif
+        return nullptr;
+    }
+
+    std::unique_ptr<Decoder> open_decoder(const std::string& path, uint64_t offset = 0)
+    {
+        std::unique_ptr<Decoder> decoder = make_decoder(path, offset);
+        if (!decoder)
+        {
+            throw std::runtime_error("Could not open file: " + path);
+        }
+        return decoder;
+    }
+
+    /**
+     * @brief Decompress from a decoder, keeping only the last bytes
+     */
+    std::string keep_last(Decoder& decoder, size_t bytes)
+    {
+        std::string       window;
+        std::vector<char> chunk(OUTPUT_CHUNK_BYTES);
+        while (size_t got = decoder.read(chunk.data(), chunk.size()))
+        {
+            window.append(chunk.data(), got);
+            if (window.size() > bytes)
+            {
+                window.erase(0, window.size() - bytes);
+            }
+        }
+        return window;
+    }
+
+    /**
+     * @brief Start of the n-th newline counted from the end, or npos
+     */
+    size_t nth_newline_from_end(const std::string& text, size_t n)
+    {
+        size_t pos = text.size();
+        while (pos > 0)
+        {
+            --pos;
+            if (text[pos] == '\n' && --n == 0)
+            {
+                return pos;
+            }
+        }
+        return std::string::npos;
+    }
+
+    /**
+     * @brief The text after the lines-th newline from the end (Utils::read_file_unified TAIL rule)
+     */
+    std::string trim_to_lines(const std::string& text, size_t lines)
+    {
+        size_t start = text.size();
+        while (start > 0 && lines > 0)
+        {
+            --start;
+            if (text[start] == '\n')
+            {
+                --lines;
+            }
+        }
+        if (start < text.size() && text[start] == '\n')
+        {
+            ++start;
+        }
+        return text.substr(start);
+    }
+
+    /**
+     * @brief Stream buffer over a decoder; reports the decompressed position to tellg()
+     */
+    class DecompressingBuffer : public std::streambuf
+    {
+    public:
+        explicit DecompressingBuffer(std::unique_ptr<Decoder> decoder)
+            : decoder_(std::move(decoder)), buffer_(OUTPUT_CHUNK_BYTES), consumed_(0)
+        {
+            setg(buffer_.data(), buffer_.data(), buffer_.data());
+        }
+
+    protected:
+        int_type underflow() override
+        {
+            if (gptr() < egptr())
+            {
+                return traits_type::to_int_type(*gptr());
+            }
+            consumed_ += static_cast<uint64_t>(egptr() - eback());
+            size_t got = decoder_->read(buffer_.data(), buffer_.size());
+            setg(buffer_.data(), buffer_.data(), buffer_.data() + got);
+            return got > 0 ? traits_type::to_int_type(*gptr()) : traits_type::eof();
+        }
+
+        pos_type seekoff(off_type offset, std::ios_base::seekdir direction, std::ios_base::openmode) override
+        {
+            if (offset == 0 && direction == std::ios_base::cur)
+            {
+                return pos_type(static_cast<off_type>(consumed_ + static_cast<uint64_t>(gptr() - eback())));
+            }
+            return pos_type(off_type(-1));
+        }
+
+    private:
+        std::unique_ptr<Decoder> decoder_;   ///< Source of the bytes
+        std::vector<char>        buffer_;    ///< Current decompressed chunk
+        uint64_t                 consumed_;  ///< Decompressed bytes before the current chunk
+    };
+
+    /**
+     * @brief Holds the buffer so it is constructed before the istream base
+     */
+    struct BufferHolder
+    {
+        explicit BufferHolder(std::unique_ptr<Decoder> decoder) : buffer(std::move(decoder)) {}
+
+        DecompressingBuffer buffer;  ///< Decompressing stream buffer
+    };
+
+    class DecompressingStream : private BufferHolder, public std::istream
+    {
+    public:
+        explicit DecompressingStream(std::unique_ptr<Decoder> decoder)
+            : BufferHolder(std::move(decoder)), std::istream(&buffer)
+        {}
+    };
+}  // namespace
+
+// =============================================================================
+// CompressedInput Implementation
+// =============================================================================
+
+CompressedInput::Codec CompressedInput::codec(const std::string& path)
+{
+    if (ends_with_nocase(path.c_str(), path.size(), ".gz"))
+    {
+        return Codec::GZIP;
+    }
+    if (ends_with_nocase(path.c_str(), path.size(), ".zst"))
+    {
+        return Codec::ZSTD;
+    }
+    return Codec::NONE;
+}
+
+bool CompressedInput::supported(Codec codec)
+{
+    switch (codec)
+    {
+        case Codec::NONE:
+            return true;
+        case Codec::GZIP:
+#ifdef HAVE_ZLIB
+            return true;
+#else
+            return false;
+#endif
+        case Codec::ZSTD:
+#ifdef HAVE_ZSTD
+            return true;
+#else
+            return false;
+#endif
+        default:
+            return false;
+    }
+}
+
+const char* CompressedInput::library(Codec codec)
+{
+    switch (codec)
+    {
+        case Codec::GZIP:
+            return "zlib";
+        case Codec::ZSTD:
+            return "zstd";
+        default:
+            return "";
+    }
+}
+
+size_t CompressedInput::suffix_length(const char* name, size_t length)
+{
+    if (supported(Codec::GZIP) && ends_with_nocase(name, length, ".gz"))
+    {
+        return 3;
+    }
+    if (supported(Codec::ZSTD) && ends_with_nocase(name, length, ".zst"))
+    {
+        return 4;
+    }
+    return 0;
+}
+
+CompressedInput::Codec CompressedInput::unsupported_suffix(const char* name, size_t length)
+{
+    if (!supported(Codec::GZIP) && ends_with_nocase(name, length, ".gz"))
+    {
+        return Codec::GZIP;
+    }
+    if (!supported(Codec::ZSTD) && ends_with_nocase(name, length, ".zst"))
+    {
+        return Codec::ZSTD;
+    }
+    return Codec::NONE;
+}
+
+std::string CompressedInput::strip_suffix(const std::string& path)
+{
+    switch (codec(path))
+    {
+        case Codec::GZIP:
+            return path.substr(0, path.size() - 3);
+        case Codec::ZSTD:
+            return path.substr(0, path.size() - 4);
+        default:
+            return path;
+    }
+}
+
+std::unique_ptr<std::istream> CompressedInput::open(const std::string& path)
+{
+    if (!is_compressed(path))
+    {
+        return std::make_unique<std::ifstream>(path, std::ios::binary);
+    }
+
+    std::unique_ptr<Decoder> decoder = make_decoder(path);
+    if (!decoder)
+    {
+        auto stream = std::make_unique<std::istringstream>();
+        stream->setstate(std::ios::failbit);
+        return stream;
+    }
+    auto stream = std::make_unique<DecompressingStream>(std::move(decoder));
+    stream->exceptions(std::ios::badbit);  // Report corrupt data with the decoder's message
+    return stream;
+}
+
+std::string CompressedInput::read_all(const std::string& path, size_t limit)
+{
+    std::string content;
+    if (!is_compressed(path))
+    {
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (!file.is_open())
+        {
+            throw std::runtime_error("Could not open file: " + path);
+        }
+        size_t size = static_cast<size_t>(file.tellg());
+        if (limit > 0)
+        {
+            size = std::min(size, limit);
+        }
+        file.seekg(0);
+        content.resize(size);
+        file.read(&content[0], static_cast<std::streamsize>(size));
+        content.resize(static_cast<size_t>(file.gcount()));
+        return content;
+    }
+
+    std::unique_ptr<Decoder> decoder = open_decoder(path);
+    std::vector<char>        chunk(OUTPUT_CHUNK_BYTES);
+    while (limit == 0 || content.size() < limit)
+    {
+        size_t want = limit == 0 ? chunk.size() : std::min(chunk.size(), limit - content.size());
+        size_t got  = decoder->read(chunk.data(), want);
+        if (got == 0)
+        {
+            break;
+        }
+        content.append(chunk.data(), got);
+    }
+    return content;
+}
+
+std::string CompressedInput::read_tail(const std::string& path, size_t bytes)
+{
+    if (!is_compressed(path))
+    {
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (!file.is_open())
+        {
+            throw std::runtime_error("Could not open file: " + path);
+        }
+        uint64_t size  = static_cast<uint64_t>(file.tellg());
+        uint64_t start = size > bytes ? size - bytes : 0;
+        std::string tail(static_cast<size_t>(size - start), '\0');
+        file.seekg(static_cast<std::streamoff>(start));
+        file.read(&tail[0], static_cast<std::streamsize>(tail.size()));
+        tail.resize(static_cast<size_t>(file.gcount()));
+        return tail;
+    }
+
+    // Seekable zstd: start at the last frame that begins before the wanted bytes
+    std::vector<SeekFrame> frames;
+    uint64_t               total = 0;
+    if (codec(path) == Codec::ZSTD && supported(Codec::ZSTD) && read_seek_table(path, frames, total) &&
+        !frames.empty())
+    {
+        uint64_t from  = total > bytes ? total - bytes : 0;
+        auto     frame = std::upper_bound(frames.begin(), frames.end(), from, [](uint64_t value, const SeekFrame& f) {
+            return value < f.decompressed_offset;
+        });
+        --frame;
+        std::unique_ptr<Decoder> decoder = open_decoder(path, frame->compressed_offset);
+        return keep_last(*decoder, bytes);
+    }
+
+    std::unique_ptr<Decoder> decoder = open_decoder(path);
+    return keep_last(*decoder, bytes);
+}
+
+std::string CompressedInput::read_tail_lines(const std::string& path, size_t lines)
+{
+    if (lines == 0)
+    {
+        return "";
+    }
+
+    std::vector<SeekFrame> frames;
+    uint64_t               total = 0;
+    bool random_access = !is_compressed(path) || (codec(path) == Codec::ZSTD && supported(Codec::ZSTD) &&
+                                                  read_seek_table(path, frames, total));
+
+    std::string window;
+    if (random_access)
+    {
+        // Widen the tail until it holds enough lines or the whole content
+        for (size_t bytes = 4096;; bytes *= 4)
+        {
+            window = read_tail(path, bytes);
+            if (window.size() < bytes || std::count(window.begin(), window.end(), '\n') > static_cast<long>(lines))
+            {
+                break;
+            }
+        }
+        return trim_to_lines(window, lines);
+    }
+
+    // Streams: keep the window from the (lines + 1)-th newline from the end while decompressing
+    std::unique_ptr<Decoder> decoder = open_decoder(path);
+    std::vector<char>        chunk(OUTPUT_CHUNK_BYTES);
+    while (size_t got = decoder->read(chunk.data(), chunk.size()))
+    {
+        window.append(chunk.data(), got);
+        size_t start = nth_newline_from_end(window, lines + 1);
+        if (start != std::string::npos && start > 0)
+        {
+            window.erase(0, start);
+        }
+    }
+    return trim_to_lines(window, lines);
+}
@@ -0,0 +1,149 @@
+/**
+ * @file compressed_input.h
+ * @brief Transparent reading of gzip and zstd compressed Gaussian logs
+ * @author Le Nhan Pham
+ * @date 2025
+ *
+ * This header provides the input backend that lets every module read
+ * archived logs ("opt.log.gz", "freq.out.zst") in place, without unpacking
+ * them to scratch first. A compressed log is decompressed as it is read, in
+ * chunks, so memory use does not depend on the size of the log; the modules
+ * that run on the shared TaskExecutor decompress one log per task, so the
+ * decompression of one log overlaps with the parsing of the others.
+ *
+ * @section Codecs
+ * - ".gz": gzip (and zlib) streams through zlib, including concatenated members
+ * - ".zst": Zstandard frames through libzstd
+ *
+ * Each codec is compiled in when its library is found at build time
+ * (HAVE_ZLIB, HAVE_ZSTD). File discovery only matches the suffixes this build
+ * can read; opening a log whose codec is missing throws a clear error.
+ *
+ * @section Tail Reads
+ * A gzip stream can only be read from its start, so a tail read decompresses
+ * the whole log and keeps its last bytes. A zstd log written in the seekable
+ * format (zstd --seekable, or t2sz) carries a seek table of its frames; a tail
+ * read then starts at the frame holding the requested bytes and decompresses
+ * only the frames from there to the end.
+ */
+
+#ifndef COMPRESSED_INPUT_H
+#define COMPRESSED_INPUT_H
+
+#include <cstddef>
+#include <istream>
+#include <memory>
+#include <string>
+
+/**
+ * @class CompressedInput
+ * @brief Codec detection and decompressing readers for log files
+ *
+ * Every function accepts uncompressed files as well and then reads them
+ * directly, so callers only need to branch where they use random access.
+ */
+class CompressedInput
+{
+public:
+    /**
+     * @enum Codec
+     * @brief Compression of a file, by its suffix
+     */
+    enum class Codec
+    {
+        NONE,  ///< Not compressed
+        GZIP,  ///< ".gz"
+        ZSTD   ///< ".zst"
+    };
+
+    /**
+     * @brief Compression of a file, from its suffix (case-insensitive)
+     */
+    static Codec codec(const std::string& path);
+
+    /**
+     * @brief Whether a file has a compression suffix
+     */
+    static bool is_compressed(const std::string& path)
+    {
+        return codec(path) != Codec::NONE;
+    }
+
+    /**
+     * @brief Whether this build can decompress a codec
+     */
+    static bool supported(Codec codec);
+
+    /**
+     * @brief Library a codec needs ("zlib" or "zstd"; "" for NONE)
+     */
+    static const char* library(Codec codec);
+
+    /**
+     * @brief Length of a compression suffix this build can read, 0 if there is none
+     * @param name File name
+     * @param length Length of the name
+     *
+     * Used by file discovery to match "opt.log.gz" against the extension ".log".
+     */
+    static size_t suffix_length(const char* name, size_t length);
+
+    /**
+     * @brief Codec of a compression suffix this build cannot read, NONE if there is none
+     * @param name File name
+     * @param length Length of the name
+     *
+     * Lets file discovery report "opt.log.zst" in a build without libzstd
+     * instead of leaving it out silently.
+     */
+    static Codec unsupported_suffix(const char* name, size_t length);
+
+    /**
+     * @brief Path without its compression suffix ("conf1/opt.log.gz" -> "conf1/opt.log")
+     *
+     * Used wherever a name is derived from the log: related input files,
+     * XYZ file names and molecule titles.
+     */
+    static std::string strip_suffix(const std::string& path);
+
+    /**
+     * @brief Open a file for sequential reading
+     * @param path Compressed or uncompressed file
+     * @return Stream of the decompressed bytes; in a failed state if the file cannot be opened
+     * @throws std::runtime_error if the codec is not compiled in; reads from the
+     *         stream throw it on corrupt or truncated data
+     *
+     * tellg() reports the position in the decompressed bytes; seeking is not
+     * supported on compressed files (use ignore() to skip forward).
+     */
+    static std::unique_ptr<std::istream> open(const std::string& path);
+
+    /**
+     * @brief Read the decompressed content of a file
+     * @param path Compressed or uncompressed file
+     * @param limit Stop after this many bytes (0 = no limit)
+     * @throws std::runtime_error if the file cannot be read or its data is corrupt or truncated
+     */
+    static std::string read_all(const std::string& path, size_t limit = 0);
+
+    /**
+     * @brief Read the last bytes of the decompressed content
+     * @param path Compressed or uncompressed file
+     * @param bytes Number of bytes wanted from the end
+     * @throws std::runtime_error if the file cannot be read or its data is corrupt or truncated
+     */
+    static std::string read_tail(const std::string& path, size_t bytes);
+
+    /**
+     * @brief Read the last lines of the decompressed content
+     * @param path Compressed or uncompressed file
+     * @param lines Number of lines wanted from the end
+     * @return The text after the lines-th newline from the end (the whole content if it has fewer lines)
+     * @throws std::runtime_error if the file cannot be read or its data is corrupt or truncated
+     *
+     * Follows Utils::read_file_unified(FileReadMode::TAIL).
+     */
+    static std::string read_tail_lines(const std::string& path, size_t lines);
+};
+
+#endif  // COMPRESSED_INPUT_H
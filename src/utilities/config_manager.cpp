@@ -38,9 +38,11 @@ void ConfigManager::initialize_default_values()
     config_values["default_concentration"] = ConfigValue("1.0", "Default concentration in M", "extract");
     config_values["default_pressure"]      = ConfigValue("1.0", "Default pressure in atm", "extract");
     config_values["default_sort_column"]   = ConfigValue("2", "Default column to sort by (2-10)", "extract");
-    config_values["default_output_format"] = ConfigValue("text", "Default output format (text/csv)", "extract");
+    config_values["default_output_format"] = ConfigValue("text", "Default output format (text/csv/bin)", "extract");
     config_values["use_input_temp"]   = ConfigValue("false", "Use temperature from input files by default", "extract");
     config_values["phase_correction"] = ConfigValue("true", "Apply phase correction by default", "extract");
+    config_values["pipeline_stages"]  = ConfigValue(
+        "check,extract,xyz", "Stages of the pipeline command (check/extract/xyz/high-kj/high-au)", "extract");
 
     // Job checker settings
     config_values["done_directory_suffix"] =
@@ -62,6 +64,14 @@ void ConfigManager::initialize_default_values()
     config_values["cluster_safe_mode"]  = ConfigValue("auto", "Cluster safety mode (auto/on/off)", "performance");
     config_values["progress_reporting"] = ConfigValue("true", "Show progress during processing", "performance");
     config_values["file_handle_limit"]  = ConfigValue("20", "Maximum concurrent file handles", "performance");
+    config_values["result_index"] =
+        ConfigValue("false", "Reuse unchanged results from .gaussian_extractor.idx", "performance");
+    config_values["scan_mode"] =
+        ConfigValue("fast", "Log scanning engine for extract (fast/tail/legacy/verify)", "performance");
+    config_values["cpu_pinning"] =
+        ConfigValue("none", "Pin worker threads to the allowed CPUs (none/compact/scatter)", "performance");
+    config_values["io_depth"] =
+        ConfigValue("auto", "Logs read ahead by I/O threads (number/auto; auto = network file systems)", "performance");
 
     // Output settings
     config_values["results_filename_template"] =
@@ -76,6 +86,7 @@ void ConfigManager::initialize_default_values()
 bool ConfigManager::load_config(const std::string& custom_path)
 {
     load_errors.clear();
+    custom_fields.clear();
     config_loaded = false;
 
     // Determine config file path
@@ -193,6 +204,13 @@ void ConfigManager::parse_config_line(const std::string& line, int line_number)
         }
     }
 
+    // User-defined extraction fields are open-ended; CustomFieldSet checks their specs
+    if (key.compare(0, 6, "field.") == 0)
+    {
+        custom_fields.emplace_back(key.substr(6), value);
+        return;
+    }
+
     // Validate key
     if (!is_valid_key(key))
     {
@@ -556,6 +574,17 @@ void ConfigManager::print_config_file_template()
         }
     }
 
+    std::cout << "\n# " << std::string(50, '=') << std::endl;
+    std::cout << "# custom extract fields" << std::endl;
+    std::cout << "# " << std::string(50, '=') << std::endl;
+    std::cout << std::endl;
+    std::cout << "# Extra results columns read in the same scan: field.<name> = \"anchor=<text>; field=<N> or "
+                 "offset=<N>;"
+              << std::endl;
+    std::cout << "# type=double|int|string; occurrence=first|last|all|count; reset=<text>\"" << std::endl;
+    std::cout << "# field.dipole = \"anchor=' Tot='; occurrence=last\"" << std::endl;
+    std::cout << "# field.s2 = \"anchor=S**2 before annihilation; field=4\"" << std::endl;
+
     std::cout << "\n# End of configuration file" << std::endl;
 }
 
@@ -635,9 +664,41 @@ std::vector<std::string> ConfigManager::validate_config()
 
     // Validate output format
     std::string format = get_string("default_output_format");
-    if (format != "text" && format != "csv")
+    if (format != "text" && format != "csv" && format != "bin")
+    {
+        errors.push_back("Invalid output format: " + format + " (must be 'text', 'csv' or 'bin')");
+    }
+
+    // Validate scan mode
+    std::string scan_mode = get_string("scan_mode");
+    if (scan_mode != "fast" && scan_mode != "tail" && scan_mode != "legacy" && scan_mode != "verify")
+    {
+        errors.push_back("Invalid scan mode: " + scan_mode + " (must be 'fast', 'tail', 'legacy' or 'verify')");
+    }
+
+    // Validate CPU pinning policy
+    std::string pinning = get_string("cpu_pinning");
+    if (pinning != "none" && pinning != "compact" && pinning != "scatter")
+    {
+        errors.push_back("Invalid CPU pinning: " + pinning + " (must be 'none', 'compact' or 'scatter')");
+    }
+
+    // Validate read-ahead depth
+    std::string io_depth = get_string("io_depth");
+    if (io_depth != "auto" && (io_depth.empty() || io_depth.find_first_not_of("0123456789") != std::string::npos ||
+                               io_depth.size() > 3 || std::stoi(io_depth) > 256))
     {
-        errors.push_back("Invalid output format: " + format + " (must be 'text' or 'csv')");
+        errors.push_back("Invalid I/O depth: " + io_depth + " (must be 0-256 or 'auto')");
+    }
+
+    // Validate pipeline stages
+    for (const auto& stage : ConfigUtils::split_string(get_string("pipeline_stages"), ','))
+    {
+        std::string name = trim(stage);
+        if (name != "check" && name != "extract" && name != "xyz" && name != "high-kj" && name != "high-au")
+        {
+            errors.push_back("Invalid pipeline stage: " + name + " (must be check, extract, xyz, high-kj or high-au)");
+        }
     }
 
     // Validate file extensions
@@ -45,6 +45,7 @@
 #include <fstream>
 #include <string>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 /**
@@ -179,10 +180,11 @@ struct ConfigValue
 class ConfigManager
 {
 private:
-    std::unordered_map<std::string, ConfigValue> config_values;     ///< Map of all configuration values with metadata
-    std::string                                  config_file_path;  ///< Path to the loaded configuration file
-    bool                                         config_loaded;  ///< Whether configuration has been successfully loaded
-    std::vector<std::string>                     load_errors;    ///< Collection of errors encountered during loading
+    std::unordered_map<std::string, ConfigValue>     config_values;     ///< Map of all configuration values with metadata
+    std::string                                      config_file_path;  ///< Path to the loaded configuration file
+    bool                                             config_loaded;  ///< Whether configuration has been successfully loaded
+    std::vector<std::string>                         load_errors;    ///< Collection of errors encountered during loading
+    std::vector<std::pair<std::string, std::string>> custom_fields;  ///< "field.<name>" entries (name, spec) in file order
 
     /**
      * @defgroup ConfigInternals Internal Configuration Methods
@@ -561,6 +563,18 @@ public:
         return load_errors;
     }
 
+    /**
+     * @brief User-defined extraction fields of the configuration file
+     * @return (name, spec) of every "field.<name> = <spec>" line, in file order
+     *
+     * The specs are not checked here; CustomFieldSet::from_config() parses
+     * them and reports invalid ones.
+     */
+    const std::vector<std::pair<std::string, std::string>>& get_custom_fields() const
+    {
+        return custom_fields;
+    }
+
     /**
      * @brief Print summary of current configuration values
      * @param show_descriptions Whether to include descriptions in output
@@ -0,0 +1,184 @@
+/**
+ * @file cpu_placement.cpp
+ * @brief Implementation of the executor thread placement
+ * @author Le Nhan Pham
+ * @date 2025
+ */
+
+#include "cpu_placement.h"
+#include "job_management/job_scheduler.h"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <map>
+
+#ifdef __linux__
+    #include <sched.h>
+#endif
+
+namespace
+{
+    /**
+     * @brief NUMA node of every CPU listed under /sys/devices/system/node, read once
+     */
+    const std::map<unsigned int, unsigned int>& cpu_nodes()
+    {
+        static const std::map<unsigned int, unsigned int> nodes = [] {
+            std::map<unsigned int, unsigned int> result;
+            std::error_code                      ec;
+            for (const auto& entry : std::filesystem::directory_iterator("/sys/devices/system/node", ec))
+            {
+                std::string name = entry.path().filename().string();
+                if (name.compare(0, 4, "node") != 0 || name.size() == 4 ||
+                    name.find_first_not_of("0123456789", 4) != std::string::npos)
+                {
+                    continue;
+                }
+                unsigned int  node = static_cast<unsigned int>(std::stoul(name.substr(4)));
+                std::ifstream file(entry.path() / "cpulist");
+                std::string   list;
+                std::getline(file, list);
+                for (unsigned int cpu : JobSchedulerDetector::parse_cpu_set(list))
+                {
+                    result[cpu] = node;
+                }
+            }
+            return result;
+        }();
+        return nodes;
+    }
+}  // namespace
+
+bool CpuPlacement::parse_policy(const std::string& name, Policy& policy)
+{
+    if (name == "none")
+    {
+        policy = Policy::NONE;
+    }
+    else if (name == "compact")
+    {
+        policy = Policy::COMPACT;
+    }
+    else if (name == "scatter")
+    {
+        policy = Policy::SCATTER;
+    }
+    else
+    {
+        return false;
+    }
+    return true;
+}
+
+std::vector<unsigned int>
+CpuPlacement::plan(const std::vector<unsigned int>& cpus, unsigned int thread_count, Policy policy)
+{
+    if (policy == Policy::NONE || cpus.empty() || thread_count == 0)
+    {
+        return {};
+    }
+
+    // CPUs of each node in ascending order
+    std::map<unsigned int, std::vector<unsigned int>> by_node;
+    for (unsigned int cpu : cpus)
+    {
+        by_node[numa_node(cpu)].push_back(cpu);
+    }
+
+    std::vector<unsigned int> order;
+    order.reserve(cpus.size());
+    if (policy == Policy::COMPACT)
+    {
+        for (const auto& node : by_node)
+        {
+            order.insert(order.end(), node.second.begin(), node.second.end());
+        }
+    }
+    else
+    {
+        for (size_t i = 0; order.size() < cpus.size(); ++i)
+        {
+            for (const auto& node : by_node)
+            {
+                if (i < node.second.size())
+                {
+                    order.push_back(node.second[i]);
+                }
+            }
+        }
+    }
+
+    std::vector<unsigned int> placement(thread_count);
+    for (unsigned int slot = 0; slot < thread_count; ++slot)
+    {
+        placement[slot] = order[slot % order.size()];
+    }
+    return placement;
+}
+
+unsigned int CpuPlacement::numa_node(unsigned int cpu)
+{
+    const auto& nodes = cpu_nodes();
+    auto        it    = nodes.find(cpu);
+    return it == nodes.end() ? 0 : it->second;
+}
+
+bool CpuPlacement::pin_current_thread(unsigned int cpu)
+{
+#ifdef __linux__
+    if (cpu >= CPU_SETSIZE)
+    {
+        return false;
+    }
+    cpu_set_t mask;
+    CPU_ZERO(&mask);
+    CPU_SET(cpu, &mask);
+    return sched_setaffinity(0, sizeof(mask), &mask) == 0;
+#else
+    (void)cpu;
+    return false;
+#endif
+}
+
+CpuPlacement::ScopedPin::ScopedPin(const std::vector<unsigned int>& cpus)
+{
+#ifdef __linux__
+    cpu_set_t mask;
+    CPU_ZERO(&mask);
+    if (cpus.empty() || sched_getaffinity(0, sizeof(mask), &mask) != 0)
+    {
+        return;
+    }
+    std::vector<unsigned int> previous;
+    for (unsigned int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+    {
+        if (CPU_ISSET(cpu, &mask))
+        {
+            previous.push_back(cpu);
+        }
+    }
+    if (pin_current_thread(cpus.front()))
+    {
+        previous_.swap(previous);
+    }
+#else
+    (void)cpus;
+#endif
+}
+
+CpuPlacement::ScopedPin::~ScopedPin()
+{
+#ifdef __linux__
+    if (previous_.empty())
+    {
+        return;
+    }
+    cpu_set_t mask;
+    CPU_ZERO(&mask);
+    for (unsigned int cpu : previous_)
+    {
+        CPU_SET(cpu, &mask);
+    }
+    sched_setaffinity(0, sizeof(mask), &mask);
+#endif
+}
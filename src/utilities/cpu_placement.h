@@ -0,0 +1,109 @@
+/**
+ * @file cpu_placement.h
+ * @brief Pinning of executor threads to the CPUs of the job (--pin)
+ * @author Le Nhan Pham
+ * @date 2025
+ *
+ * This header provides the placement of TaskExecutor threads on the CPUs the
+ * process is allowed to use (JobResources::cpu_set, from the affinity mask,
+ * the cgroup cpuset and the scheduler's binding). Unpinned threads float
+ * across sockets and onto CPUs of co-scheduled jobs; pinned threads stay on
+ * one CPU of the allocation each.
+ *
+ * @section Policies
+ * - none: threads are not pinned (default)
+ * - compact: consecutive CPUs of one NUMA node first, then the next node;
+ *   threads share the memory controller and last-level cache of a socket
+ * - scatter: round-robin over the NUMA nodes; threads get the memory
+ *   bandwidth of every socket
+ *
+ * @section NUMA-Local Memory
+ * Linux places a page on the node of the thread that first touches it. A
+ * pinned thread maps, reads and parses its logs itself, so its file pages,
+ * read buffers and parse results come from its own node without an explicit
+ * NUMA allocation API (libnuma is not needed). NUMA nodes are read from
+ * /sys/devices/system/node; without them every CPU counts as node 0.
+ */
+
+#ifndef CPU_PLACEMENT_H
+#define CPU_PLACEMENT_H
+
+#include <string>
+#include <vector>
+
+/**
+ * @class CpuPlacement
+ * @brief Placement plans and thread pinning
+ */
+class CpuPlacement
+{
+public:
+    /**
+     * @enum Policy
+     * @brief How executor threads are placed on the allowed CPUs
+     */
+    enum class Policy
+    {
+        NONE,     ///< Not pinned
+        COMPACT,  ///< Fill one NUMA node before the next
+        SCATTER   ///< Round-robin over NUMA nodes
+    };
+
+    /**
+     * @brief Parse a policy name
+     * @param name "none", "compact" or "scatter"
+     * @param policy Receives the policy
+     * @return false if the name is unknown
+     */
+    static bool parse_policy(const std::string& name, Policy& policy);
+
+    /**
+     * @brief CPU of each executor thread
+     * @param cpus Allowed CPU ids (JobResources::cpu_set)
+     * @param thread_count Number of threads to place
+     * @param policy Placement policy
+     * @return One CPU per thread, slot 0 first; empty for Policy::NONE or when no CPU is known
+     *
+     * With more threads than CPUs the plan wraps around, so CPUs are shared
+     * evenly.
+     */
+    static std::vector<unsigned int>
+    plan(const std::vector<unsigned int>& cpus, unsigned int thread_count, Policy policy);
+
+    /**
+     * @brief NUMA node of a CPU
+     * @return Node number; 0 when the topology is unknown
+     */
+    static unsigned int numa_node(unsigned int cpu);
+
+    /**
+     * @brief Restrict the calling thread to one CPU
+     * @return false if pinning is unsupported or was refused
+     */
+    static bool pin_current_thread(unsigned int cpu);
+
+    /**
+     * @class ScopedPin
+     * @brief Pins the calling thread for a scope and restores its previous affinity
+     *
+     * Used for the thread that calls TaskExecutor::run(), which works on the
+     * batch as slot 0 but must not stay pinned afterwards.
+     */
+    class ScopedPin
+    {
+    public:
+        /**
+         * @param cpus Plan of the executor; the thread is pinned to its first CPU (no-op if empty)
+         */
+        explicit ScopedPin(const std::vector<unsigned int>& cpus);
+        ~ScopedPin();
+
+        ScopedPin(const ScopedPin&)            = delete;
+        ScopedPin& operator=(const ScopedPin&) = delete;
+
+    private:
+        std::vector<unsigned int> previous_;  ///< Affinity before pinning (empty = not pinned)
+    };
+};
+
+#endif  // CPU_PLACEMENT_H
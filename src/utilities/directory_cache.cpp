@@ -0,0 +1,224 @@
+/**
+ * @file directory_cache.cpp
+ * @brief Implementation of the notified directory listing
+ * @author Le Nhan Pham
+ * @date 2025
+ */
+
+#include "directory_cache.h"
+#include "utilities/utils.h"
+#include <filesystem>
+#include <set>
+#include <system_error>
+
+#ifdef __linux__
+    #include <sys/inotify.h>
+    #include <unistd.h>
+#endif
+
+#ifdef _WIN32
+    #include <windows.h>
+#endif
+
+// =============================================================================
+// DirectoryCache Implementation
+// =============================================================================
+
+DirectoryCache::DirectoryCache()
+    : watching_(false), exact_stamps_(false), listings_(0), inotify_fd_(-1), change_handle_(nullptr)
+{}
+
+DirectoryCache::~DirectoryCache()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    unbind_locked();
+}
+
+void DirectoryCache::unbind_locked()
+{
+#ifdef __linux__
+    if (inotify_fd_ >= 0)
+    {
+        ::close(inotify_fd_);
+        inotify_fd_ = -1;
+    }
+#endif
+#ifdef _WIN32
+    if (change_handle_)
+    {
+        FindCloseChangeNotification(static_cast<HANDLE>(change_handle_));
+        change_handle_ = nullptr;
+    }
+#endif
+    entries_.clear();
+    watching_     = false;
+    exact_stamps_ = false;
+}
+
+bool DirectoryCache::bind_locked()
+{
+    std::error_code ec;
+    std::string     current = std::filesystem::current_path(ec).string();
+    if (ec)
+    {
+        unbind_locked();
+        directory_.clear();
+        return false;
+    }
+    if (current == directory_)
+    {
+        return watching_;
+    }
+
+    // A new working directory (first use or after cd): watch it before it is listed, so nothing is missed
+    unbind_locked();
+    directory_ = current;
+    if (Utils::on_network_file_system("."))
+    {
+        return false;
+    }
+#ifdef __linux__
+    inotify_fd_ = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    uint32_t mask = IN_CREATE | IN_DELETE | IN_MODIFY | IN_CLOSE_WRITE | IN_ATTRIB | IN_MOVED_FROM | IN_MOVED_TO;
+    if (inotify_fd_ >= 0 && inotify_add_watch(inotify_fd_, ".", mask) >= 0)
+    {
+        watching_     = true;
+        exact_stamps_ = true;
+    }
+#elif defined(_WIN32)
+    HANDLE handle = FindFirstChangeNotificationA(".", FALSE,
+                                                 FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_DIR_NAME |
+                                                     FILE_NOTIFY_CHANGE_SIZE | FILE_NOTIFY_CHANGE_LAST_WRITE);
+    if (handle != INVALID_HANDLE_VALUE)
+    {
+        change_handle_ = handle;
+        watching_      = true;
+    }
+#endif
+    if (!watching_)
+    {
+        unbind_locked();
+        return false;
+    }
+    relist_locked();
+    return true;
+}
+
+void DirectoryCache::relist_locked()
+{
+    entries_.clear();
+    ++listings_;
+    std::error_code ec;
+    for (std::filesystem::directory_iterator it(".", ec), end; !ec && it != end; it.increment(ec))
+    {
+        refresh_locked(it->path().filename().string());
+    }
+}
+
+void DirectoryCache::refresh_locked(const std::string& name)
+{
+    Entry entry;
+    entry.name    = name;
+    entry.regular = FileStamp::from_path(name, entry.stamp);
+    std::error_code ec;
+    entry.directory = !entry.regular && std::filesystem::is_directory(name, ec);
+    if (!entry.regular && !entry.directory && !std::filesystem::exists(std::filesystem::symlink_status(name, ec)))
+    {
+        entries_.erase(name);
+        return;
+    }
+    entries_[name] = std::move(entry);
+}
+
+void DirectoryCache::apply_changes_locked()
+{
+#ifdef __linux__
+    // Every name is looked at once however many events it raised (a growing log raises one per write)
+    std::set<std::string> changed;
+    bool                  overflow = false;
+    alignas(struct inotify_event) char buffer[64 * 1024];
+    ssize_t length;
+    while ((length = ::read(inotify_fd_, buffer, sizeof(buffer))) > 0)
+    {
+        for (char* ptr = buffer; ptr < buffer + length;)
+        {
+            auto* event = reinterpret_cast<struct inotify_event*>(ptr);
+            if (event->mask & (IN_Q_OVERFLOW | IN_IGNORED))
+            {
+                overflow = true;  // Events were lost, or the watch ended with its directory
+            }
+            else if (event->len > 0)
+            {
+                changed.insert(event->name);
+            }
+            ptr += sizeof(struct inotify_event) + event->len;
+        }
+    }
+    if (overflow)
+    {
+        relist_locked();
+        return;
+    }
+    for (const auto& name : changed)
+    {
+        refresh_locked(name);
+    }
+#elif defined(_WIN32)
+    if (WaitForSingleObject(static_cast<HANDLE>(change_handle_), 0) == WAIT_OBJECT_0)
+    {
+        FindNextChangeNotification(static_cast<HANDLE>(change_handle_));
+        relist_locked();
+    }
+#endif
+}
+
+bool DirectoryCache::watching()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return bind_locked();
+}
+
+std::vector<DirectoryCache::Entry> DirectoryCache::entries()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<Entry>          result;
+    if (!bind_locked())
+    {
+        return result;
+    }
+    apply_changes_locked();
+    result.reserve(entries_.size());
+    for (const auto& [name, entry] : entries_)
+    {
+        result.push_back(entry);
+    }
+    return result;
+}
+
+bool DirectoryCache::stamp(const std::string& path, FileStamp& stamp)
+{
+    // Only names directly in the watched directory are covered
+    std::string name = path.compare(0, 2, "./") == 0 ? path.substr(2) : path;
+    if (name.find('/') == std::string::npos && name.find('\\') == std::string::npos)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (bind_locked() && exact_stamps_)
+        {
+            apply_changes_locked();
+            auto it = entries_.find(name);
+            if (it == entries_.end() || !it->second.regular)
+            {
+                return false;
+            }
+            stamp = it->second.stamp;
+            return true;
+        }
+    }
+    return FileStamp::from_path(path, stamp);
+}
+
+size_t DirectoryCache::listing_count() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return listings_;
+}
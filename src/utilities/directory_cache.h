@@ -0,0 +1,115 @@
+/**
+ * @file directory_cache.h
+ * @brief Listing of the working directory kept current by change notifications
+ * @author Le Nhan Pham
+ * @date 2025
+ *
+ * This header provides the directory listing held by an interactive session
+ * (see SessionState). The working directory is listed once; afterwards only
+ * the entries named by change notifications are looked at again, so the next
+ * command's file discovery, its result index lookups and TAB completion need
+ * no directory read and no stat of unchanged files.
+ *
+ * @section Change Notifications
+ * - Linux: inotify on the working directory. Each event names the entry that
+ *   was created, written, renamed or removed, and only that entry is stat'ed
+ *   again. An overflowing event queue relists the directory. The stamps of
+ *   the cached entries are exact and are handed to the result index.
+ * - Windows: a change notification handle; any change relists the directory.
+ *   NTFS may report writes to a file that is still open late, so stamps are
+ *   read from the file system as before.
+ * - Network and parallel file systems (Lustre, NFS, GPFS, SMB, FUSE), where
+ *   writes from other nodes raise no notification, and other platforms: the
+ *   cache is not used and every walk reads the directory.
+ *
+ * @section Thread Safety
+ * All members may be called concurrently; entries() returns a copy.
+ */
+
+#ifndef DIRECTORY_CACHE_H
+#define DIRECTORY_CACHE_H
+
+#include "utilities/result_index.h"
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * @class DirectoryCache
+ * @brief Entries of the working directory, updated from change notifications
+ */
+class DirectoryCache
+{
+public:
+    /**
+     * @struct Entry
+     * @brief One name of the directory
+     */
+    struct Entry
+    {
+        std::string name;       ///< File name
+        bool        regular;    ///< Regular file (symbolic links followed)
+        bool        directory;  ///< Directory (symbolic links followed)
+        FileStamp   stamp;      ///< Size, modification time and inode of a regular file
+    };
+
+    /**
+     * @brief Create a cache for the working directory; nothing is listed yet
+     */
+    DirectoryCache();
+
+    /**
+     * @brief Stop watching the directory
+     */
+    ~DirectoryCache();
+
+    DirectoryCache(const DirectoryCache&)            = delete;
+    DirectoryCache& operator=(const DirectoryCache&) = delete;
+
+    /**
+     * @brief Whether the working directory is watched, i.e. entries() can stand in for a directory read
+     *
+     * Starts watching (and lists the directory) on the first call and again
+     * after the working directory changed.
+     */
+    bool watching();
+
+    /**
+     * @brief Current entries of the working directory, sorted by name
+     * @return Empty if the directory is not watched
+     */
+    std::vector<Entry> entries();
+
+    /**
+     * @brief Stamp of a file, from the cache where it is exact, else from the file system
+     * @param path Path of the file as passed to ResultIndex::lookup()
+     * @param stamp Receives the stamp
+     * @return false if the file does not exist or is not a regular file
+     */
+    bool stamp(const std::string& path, FileStamp& stamp);
+
+    /**
+     * @brief Full listings made so far (the first one and those after a queue overflow or a directory change)
+     */
+    size_t listing_count() const;
+
+private:
+    bool bind_locked();
+    void unbind_locked();
+    void relist_locked();
+    void refresh_locked(const std::string& name);
+    void apply_changes_locked();
+
+    mutable std::mutex           mutex_;          ///< Guards every member below
+    std::string                  directory_;      ///< Absolute path of the watched directory ("" = none)
+    std::map<std::string, Entry> entries_;        ///< Entries by name
+    bool                         watching_;       ///< Notifications arrive for directory_
+    bool                         exact_stamps_;   ///< Every write is notified, so cached stamps are current
+    size_t                       listings_;       ///< Full listings made
+    int                          inotify_fd_;     ///< inotify descriptor (-1 when not used)
+    void*                        change_handle_;  ///< Windows change notification handle (nullptr when not used)
+};
+
+#endif  // DIRECTORY_CACHE_H
@@ -0,0 +1,451 @@
+/**
+ * @file file_discovery.cpp
+ * @brief Implementation of single-pass file discovery
+ * @author Le Nhan Pham
+ * @date 2025
+ */
+
+#include "file_discovery.h"
+#include "compressed_input.h"
+#include "profiler.h"
+#include "session_state.h"
+#include "extraction/gaussian_extractor.h"
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <filesystem>
+#include <iostream>
+#include <stdexcept>
+
+#ifndef _WIN32
+    #include <dirent.h>
+    #include <fcntl.h>
+    #include <sys/stat.h>
+#endif
+
+namespace
+{
+    std::string to_lower(std::string text)
+    {
+        for (auto& c : text)
+        {
+            c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+        }
+        return text;
+    }
+
+    /**
+     * @brief Case-insensitive extension filter, built once per walk
+     */
+    class ExtensionFilter
+    {
+    public:
+        explicit ExtensionFilter(const std::vector<std::string>& extensions)
+        {
+            for (const auto& extension : extensions)
+            {
+                std::string lowered = to_lower(extension);
+                if (std::find(extensions_.begin(), extensions_.end(), lowered) == extensions_.end())
+                {
+                    extensions_.push_back(lowered);
+                }
+            }
+        }
+
+        /**
+         * @brief Whether a file name ends in one of the extensions
+         *
+         * Follows std::filesystem::path::extension(): a leading dot alone
+         * (".log") is a hidden file name, not an extension. A compression
+         * suffix this build can read is skipped ("opt.log.gz" matches ".log").
+         */
+        bool matches(const char* name, size_t length) const
+        {
+            return matches_stem(name, length - CompressedInput::suffix_length(name, length));
+        }
+
+        /**
+         * @brief Codec of a matching file this build cannot decompress ("opt.log.zst" without libzstd)
+         * @return CompressedInput::Codec::NONE for every other name
+         */
+        CompressedInput::Codec unreadable(const char* name, size_t length) const
+        {
+            CompressedInput::Codec codec = CompressedInput::unsupported_suffix(name, length);
+            if (codec == CompressedInput::Codec::NONE)
+            {
+                return codec;
+            }
+            size_t suffix = codec == CompressedInput::Codec::GZIP ? 3 : 4;
+            return matches_stem(name, length - suffix) ? codec : CompressedInput::Codec::NONE;
+        }
+
+    private:
+        bool matches_stem(const char* name, size_t length) const
+        {
+            size_t dot = length;
+            while (dot > 0 && name[dot - 1] != '.')
+            {
+                --dot;
+            }
+            if (dot <= 1)
+            {
+                return false;  // No dot, or only a leading one
+            }
+            --dot;
+
+            size_t extension_length = length - dot;
+            for (const auto& extension : extensions_)
+            {
+                if (extension.size() != extension_length)
+                {
+                    continue;
+                }
+                bool same = true;
+                for (size_t i = 0; i < extension_length; ++i)
+                {
+                    if (std::tolower(static_cast<unsigned char>(name[dot + i])) != extension[i])
+                    {
+                        same = false;
+                        break;
+                    }
+                }
+                if (same)
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        std::vector<std::string> extensions_;  ///< Lower-case extensions including the dot
+    };
+
+    std::string join_path(const std::string& directory, const char* name)
+    {
+        return directory.empty() ? std::string(name) : directory + "/" + name;
+    }
+
+    /**
+     * @brief Compressed logs a walk left out because their codec is not compiled in
+     */
+    struct UnreadableLogs
+    {
+        std::vector<std::string> paths;  ///< Files left out, relative to the root
+        bool                     gzip;   ///< A ".gz" file was left out (built without zlib)
+        bool                     zstd;   ///< A ".zst" file was left out (built without libzstd)
+
+        UnreadableLogs() : gzip(false), zstd(false) {}
+
+        void add(std::string path, CompressedInput::Codec codec)
+        {
+            paths.push_back(std::move(path));
+            (codec == CompressedInput::Codec::GZIP ? gzip : zstd) = true;
+        }
+    };
+
+    /**
+     * @brief Warn once per process about compressed logs this build cannot read
+     *
+     * Without the warning a directory of ".log.zst" files would look like a
+     * directory without logs.
+     */
+    void warn_unreadable(const UnreadableLogs& unreadable)
+    {
+        static std::atomic<bool> warned(false);
+        if (unreadable.paths.empty() || warned.exchange(true))
+        {
+            return;
+        }
+
+        const size_t listed = 10;
+        std::string  names;
+        for (size_t i = 0; i < unreadable.paths.size() && i < listed; ++i)
+        {
+            names += (i == 0 ? "" : ", ") + unreadable.paths[i];
+        }
+        if (unreadable.paths.size() > listed)
+        {
+            names += " and " + std::to_string(unreadable.paths.size() - listed) + " more";
+        }
+        std::string libraries = unreadable.gzip && unreadable.zstd ? "zlib and zstd"
+                                : unreadable.gzip                  ? "zlib"
+                                                                   : "zstd";
+        std::cerr << "Warning: Skipped " << unreadable.paths.size() << " compressed log file(s); this binary was "
+                  << "built without " << libraries << " support: " << names << std::endl;
+    }
+}  // namespace
+
+// =============================================================================
+// FileDiscovery Implementation
+// =============================================================================
+
+#ifndef _WIN32
+
+static size_t walk_tree(const FileDiscovery::Options& options, const FileDiscovery::Visitor& visit,
+                        UnreadableLogs& unreadable)
+{
+    ExtensionFilter filter(options.extensions);
+    uintmax_t       max_bytes = static_cast<uintmax_t>(options.max_file_size_mb) * 1024 * 1024;
+    size_t          reported  = 0;
+
+    // Directories still to read, relative to the root ("" is the root itself)
+    std::vector<std::string> pending = {""};
+    bool                     is_root = true;
+
+    while (!pending.empty() && !g_shutdown_requested.load())
+    {
+        std::string relative = std::move(pending.back());
+        pending.pop_back();
+
+        std::string directory = relative.empty() ? options.root : options.root + "/" + relative;
+        DIR*        handle    = ::opendir(directory.c_str());
+        if (!handle)
+        {
+            if (is_root)
+            {
+                throw std::runtime_error("Error accessing directory: " + directory);
+            }
+            continue;  // Unreadable subdirectory
+        }
+        is_root = false;
+
+        int descriptor = ::dirfd(handle);
+        while (struct dirent* entry = ::readdir(handle))
+        {
+            if (g_shutdown_requested.load(std::memory_order_relaxed))
+            {
+                break;
+            }
+
+            const char* name   = entry->d_name;
+            size_t      length = std::char_traits<char>::length(name);
+            if (name[0] == '.' && (length == 1 || (length == 2 && name[1] == '.')))
+            {
+                continue;
+            }
+
+            unsigned char type = entry->d_type;
+            if (type == DT_DIR)
+            {
+                if (options.recursive && name[0] != '.')
+                {
+                    pending.push_back(join_path(relative, name));
+                }
+                continue;
+            }
+            if (type != DT_REG && type != DT_LNK && type != DT_UNKNOWN)
+            {
+                continue;  // FIFOs, sockets, devices
+            }
+
+            bool name_matches = filter.matches(name, length);
+            if (!name_matches)
+            {
+                CompressedInput::Codec codec = filter.unreadable(name, length);
+                if (codec != CompressedInput::Codec::NONE)
+                {
+                    unreadable.add(join_path(relative, name), codec);
+                    continue;
+                }
+            }
+            if (!name_matches && !(type == DT_UNKNOWN && options.recursive))
+            {
+                continue;
+            }
+
+            // The size (and for unknown entries the type) needs one stat of the entry itself
+            struct stat st;
+            if (::fstatat(descriptor, name, &st, 0) != 0)
+            {
+                continue;
+            }
+            if (S_ISDIR(st.st_mode))
+            {
+                if (type == DT_UNKNOWN && options.recursive && name[0] != '.')
+                {
+                    pending.push_back(join_path(relative, name));
+                }
+                continue;
+            }
+            if (!name_matches || !S_ISREG(st.st_mode) || static_cast<uintmax_t>(st.st_size) > max_bytes)
+            {
+                continue;
+            }
+
+            visit(join_path(relative, name), static_cast<uintmax_t>(st.st_size));
+            ++reported;
+        }
+        ::closedir(handle);
+    }
+
+    return reported;
+}
+
+#else
+
+static size_t walk_tree(const FileDiscovery::Options& options, const FileDiscovery::Visitor& visit,
+                        UnreadableLogs& unreadable)
+{
+    ExtensionFilter filter(options.extensions);
+    uintmax_t       max_bytes = static_cast<uintmax_t>(options.max_file_size_mb) * 1024 * 1024;
+    size_t          reported  = 0;
+
+    auto report = [&](const std::filesystem::directory_entry& entry) {
+        std::error_code ec;
+        if (!entry.is_regular_file(ec))
+        {
+            return;
+        }
+        std::string name = entry.path().filename().string();
+        if (!filter.matches(name.c_str(), name.size()))
+        {
+            CompressedInput::Codec codec = filter.unreadable(name.c_str(), name.size());
+            if (codec != CompressedInput::Codec::NONE)
+            {
+                std::string path = std::filesystem::relative(entry.path(), options.root, ec).generic_string();
+                unreadable.add(ec ? name : path, codec);
+            }
+            return;
+        }
+        uintmax_t size = entry.file_size(ec);  // Cached from the directory listing on Windows
+        if (ec || size > max_bytes)
+        {
+            return;
+        }
+        std::string path = std::filesystem::relative(entry.path(), options.root, ec).generic_string();
+        visit(ec ? name : path, size);
+        ++reported;
+    };
+
+    try
+    {
+        if (options.recursive)
+        {
+            std::filesystem::recursive_directory_iterator it(
+                options.root, std::filesystem::directory_options::skip_permission_denied);
+            for (; it != std::filesystem::recursive_directory_iterator(); ++it)
+            {
+                if (g_shutdown_requested.load())
+                {
+                    break;
+                }
+                std::error_code ec;
+                if (it->is_directory(ec))
+                {
+                    std::string name = it->path().filename().string();
+                    if (it->is_symlink(ec) || (!name.empty() && name[0] == '.'))
+                    {
+                        it.disable_recursion_pending();
+                    }
+                    continue;
+                }
+                report(*it);
+            }
+        }
+        else
+        {
+            for (const auto& entry : std::filesystem::directory_iterator(options.root))
+            {
+                if (g_shutdown_requested.load())
+                {
+                    break;
+                }
+                report(entry);
+            }
+        }
+    }
+    catch (const std::filesystem::filesystem_error& e)
+    {
+        throw std::runtime_error("Error accessing directory: " + std::string(e.what()));
+    }
+
+    return reported;
+}
+
+#endif
+
+/**
+ * @brief Walk the working directory from the listing of the interactive session, if it has one
+ * @return false if the directory has to be read
+ */
+static bool walk_session_listing(const FileDiscovery::Options& options,
+                                 const FileDiscovery::Visitor& visit,
+                                 UnreadableLogs&               unreadable,
+                                 size_t&                       reported)
+{
+    SessionState* session = SessionState::active();
+    if (!session || options.recursive || options.root != "." || !session->directory().watching())
+    {
+        return false;
+    }
+
+    ExtensionFilter filter(options.extensions);
+    uintmax_t       max_bytes = static_cast<uintmax_t>(options.max_file_size_mb) * 1024 * 1024;
+    reported                  = 0;
+    for (const auto& entry : session->directory().entries())
+    {
+        if (g_shutdown_requested.load(std::memory_order_relaxed))
+        {
+            break;
+        }
+        if (!entry.regular)
+        {
+            continue;
+        }
+        if (entry.stamp.size <= max_bytes && filter.matches(entry.name.c_str(), entry.name.size()))
+        {
+            visit(entry.name, entry.stamp.size);
+            ++reported;
+            continue;
+        }
+        CompressedInput::Codec codec = filter.unreadable(entry.name.c_str(), entry.name.size());
+        if (codec != CompressedInput::Codec::NONE)
+        {
+            unreadable.add(entry.name, codec);
+        }
+    }
+    return true;
+}
+
+static size_t walk_directory(const FileDiscovery::Options& options, const FileDiscovery::Visitor& visit)
+{
+    UnreadableLogs unreadable;
+    size_t         reported = 0;
+    if (!walk_session_listing(options, visit, unreadable, reported))
+    {
+        reported = walk_tree(options, visit, unreadable);
+    }
+    warn_unreadable(unreadable);
+    return reported;
+}
+
+size_t FileDiscovery::walk(const Options& options, const Visitor& visit)
+{
+    if (!Profiler::enabled())
+    {
+        return walk_directory(options, visit);
+    }
+
+    // Files parsed while the walk goes on are not discovery time
+    Profiler::Clock::duration   in_visitor(0);
+    Profiler::Clock::time_point begin    = Profiler::Clock::now();
+    size_t                      reported = walk_directory(options, [&](const std::string& path, uintmax_t size) {
+        Profiler::Clock::time_point visit_begin = Profiler::Clock::now();
+        visit(path, size);
+        in_visitor += Profiler::Clock::now() - visit_begin;
+    });
+    Profiler::record(Profiler::Phase::DISCOVERY, begin, Profiler::Clock::now() - in_visitor);
+    return reported;
+}
+
+std::vector<std::string> FileDiscovery::collect(const Options& options)
+{
+    std::vector<std::string> files;
+    walk(options, [&files](const std::string& path, uintmax_t) {
+        files.push_back(path);
+    });
+
+    // One sort for a consistent processing order
+    std::sort(files.begin(), files.end());
+    return files;
+}
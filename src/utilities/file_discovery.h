@@ -0,0 +1,95 @@
+/**
+ * @file file_discovery.h
+ * @brief Single-pass discovery of Gaussian output files
+ * @author Le Nhan Pham
+ * @date 2025
+ *
+ * This header provides the directory walk behind findLogFiles() and the
+ * streaming discovery used by extract. The directory is read once for all
+ * requested extensions, and each matching file is handed to a visitor as soon
+ * as it is found, so callers can start parsing before the walk has finished.
+ *
+ * @section File Type Information
+ * On POSIX systems the walk uses the entry type reported by readdir()
+ * (d_type) to skip directories and non-matching names without a stat call.
+ * Only files whose extension matches are stat'ed (relative to the open
+ * directory) to read their size. Entries with an unknown type, as returned by
+ * some network and parallel file systems, and symbolic links fall back to a
+ * stat call. Other platforms use std::filesystem::directory_iterator.
+ *
+ * @section Recursive Mode
+ * With recursive discovery, subdirectories are walked as well and results are
+ * returned as paths relative to the working directory (e.g. "conf1/opt.log").
+ * Hidden directories and symbolic links to directories are not entered.
+ *
+ * @section Compressed Logs
+ * Names ending in a compression suffix this build can read (".gz", ".zst";
+ * see CompressedInput) match on the extension before it, so "opt.log.gz" is
+ * found when ".log" is requested. The size limit applies to the file on disk.
+ * Matching names whose codec is not compiled in are left out, and the first
+ * walk that leaves any out prints one warning naming them.
+ *
+ * @section Interactive Sessions
+ * While a SessionState is active, non-recursive walks of the working directory
+ * report the files of its notified listing (DirectoryCache) and the directory
+ * is not read.
+ */
+
+#ifndef FILE_DISCOVERY_H
+#define FILE_DISCOVERY_H
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+/**
+ * @class FileDiscovery
+ * @brief Walks a directory and reports files matching a set of extensions
+ */
+class FileDiscovery
+{
+public:
+    /**
+     * @struct Options
+     * @brief What to look for and where
+     */
+    struct Options
+    {
+        std::vector<std::string> extensions;        ///< Extensions including the dot; matched case-insensitively
+        size_t                   max_file_size_mb;  ///< Larger files are skipped
+        bool                     recursive;         ///< Also walk subdirectories
+        std::string              root;              ///< Directory to walk ("." for the working directory)
+
+        Options() : max_file_size_mb(100), recursive(false), root(".") {}
+    };
+
+    /**
+     * @brief Called for every matching file, in directory order
+     * @param path Path relative to the root (file name only for top-level files)
+     * @param size File size in bytes
+     */
+    using Visitor = std::function<void(const std::string& path, uintmax_t size)>;
+
+    /**
+     * @brief Walk the root directory once and report every matching file
+     * @param options Extensions, size limit and recursion
+     * @param visit Called for each matching file on the calling thread
+     * @return Number of files reported
+     * @throws std::runtime_error if the root directory cannot be read
+     *
+     * Stops early when g_shutdown_requested is set. Unreadable subdirectories
+     * are skipped.
+     */
+    static size_t walk(const Options& options, const Visitor& visit);
+
+    /**
+     * @brief Walk the root directory and return the matching files sorted by path
+     * @param options Extensions, size limit and recursion
+     * @return Sorted list of matching paths
+     * @throws std::runtime_error if the root directory cannot be read
+     */
+    static std::vector<std::string> collect(const Options& options);
+};
+
+#endif  // FILE_DISCOVERY_H
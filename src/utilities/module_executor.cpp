@@ -4,12 +4,20 @@
 #include "high_level/high_level_energy.h"
 #include "input_gen/create_input.h"
 #include "job_management/job_checker.h"
+#include "job_management/job_watcher.h"
+#include "utilities/move_planner.h"
+#include "utilities/profiler.h"
+#include "utilities/result_index.h"
+#include "utilities/session_state.h"
+#include "utilities/run_journal.h"
+#include "utilities/task_executor.h"
 #include <algorithm>
 #include <atomic>
 #include <csignal>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <mutex>
 #include <string>
 #include <thread>
 
@@ -30,6 +38,222 @@ void setup_signal_handlers()
     std::signal(SIGTERM, signal_handler_func);
 }
 
+// Map the --scan-mode / scan_mode config value to the extraction engine
+static ScanMode parse_scan_mode(const std::string& mode)
+{
+    if (mode == "tail")
+        return ScanMode::TAIL;
+    if (mode == "legacy")
+        return ScanMode::LEGACY;
+    if (mode == "verify")
+        return ScanMode::VERIFY;
+    return ScanMode::FAST;
+}
+
+// Dry-run, manifest and journal options of the job checker commands
+static MoveOptions move_options(const CommandContext& context, std::shared_ptr<RunJournal> journal = nullptr)
+{
+    MoveOptions options;
+    options.dry_run       = context.dry_run;
+    options.manifest_path = context.move_manifest;
+    options.journal       = std::move(journal);
+    return options;
+}
+
+// --resume of the job checkers: settle the moves an interrupted run left unfinished (completed, or put back with
+// --undo-moves), then journal the moves of this run. Returns false when the command ends here (--undo-moves).
+static bool open_move_journal(const CommandContext& context, std::shared_ptr<RunJournal>& journal)
+{
+    if (!context.resume)
+    {
+        return true;
+    }
+    if (context.dry_run)
+    {
+        std::cout << "Note: A dry run moves nothing; unfinished moves of an interrupted run are left as they are."
+                  << std::endl;
+        return !context.undo_moves;
+    }
+
+    std::string path = RunJournal::path_for(CommandParser::get_command_name(context.command));
+    std::string error;
+    auto        earlier = std::make_shared<RunJournal>(path);
+    if (!earlier->open("moves", error))
+    {
+        throw std::runtime_error(error);
+    }
+
+    std::vector<std::string> errors;
+    size_t                   groups = MovePlanner::recover(earlier->recovered(), context.undo_moves, errors);
+    if (!errors.empty())
+    {
+        for (const auto& message : errors)
+        {
+            std::cerr << "Error: " << message << std::endl;
+        }
+        throw std::runtime_error(std::string("Unfinished moves of the interrupted run could not be ") +
+                                 (context.undo_moves ? "undone" : "completed") + "; journal kept in " + path);
+    }
+    if (groups > 0 && !context.quiet)
+    {
+        std::cout << (context.undo_moves ? "Put back the files of " : "Completed the moves of ") << groups
+                  << " job(s) an interrupted run left unfinished" << std::endl;
+    }
+    earlier->finish();
+    if (context.undo_moves)
+    {
+        return false;
+    }
+
+    journal = std::make_shared<RunJournal>(path);
+    if (!journal->open("moves", error))
+    {
+        throw std::runtime_error(error);
+    }
+    return true;
+}
+
+// The checker command ran to the end: its journal is no longer needed
+static void close_move_journal(const std::shared_ptr<RunJournal>& journal)
+{
+    if (journal && !g_shutdown_requested.load())
+    {
+        journal->finish();
+    }
+}
+
+// Attach the persistent result index to a processing context when enabled; an interactive session always
+// attaches its own, kept in memory between commands
+static void open_result_index(const CommandContext& context, ProcessingContext& processing_context)
+{
+    if (SessionState* session = SessionState::active())
+    {
+        processing_context.result_index = session->result_index(context.use_result_index);
+    }
+    else if (context.use_result_index)
+    {
+        processing_context.result_index = std::make_shared<ResultIndex>();
+        processing_context.result_index->load();
+    }
+}
+
+// Write the result index back and report how many files were served from it
+static void close_result_index(const CommandContext& context, ProcessingContext& processing_context)
+{
+    if (!processing_context.result_index)
+    {
+        return;
+    }
+
+    if (!context.use_result_index)
+    {
+        if (!context.quiet)
+        {
+            std::cout << "Session: " << processing_context.result_index->hit_count() << " logs reused, "
+                      << processing_context.result_index->miss_count() << " parsed" << std::endl;
+        }
+    }
+    else if (!processing_context.result_index->save())
+    {
+        std::cerr << "Warning: Could not write result index: " << processing_context.result_index->path()
+                  << std::endl;
+    }
+    else if (!context.quiet)
+    {
+        std::cout << "Result index: " << processing_context.result_index->hit_count() << " reused, "
+                  << processing_context.result_index->miss_count() << " parsed" << std::endl;
+    }
+}
+
+// Save high-level results in the columnar binary format (--format bin) instead of printing a table
+static void save_high_level_columnar(const HighLevelEnergyCalculator&        calculator,
+                                     const std::vector<HighLevelEnergyData>& results,
+                                     const std::string&                      name_suffix,
+                                     const CommandContext&                   context,
+                                     const ProcessingContext&                processing_context)
+{
+    std::string output_filename = HighLevelEnergyUtils::get_current_directory_name() + name_suffix + ".bin";
+    try
+    {
+        calculator.write_columnar(results, output_filename);
+    }
+    catch (const std::exception&)
+    {
+        std::cerr << "Warning: Could not save results to " << output_filename << std::endl;
+        return;
+    }
+
+    if (!context.quiet)
+    {
+        std::cout << "\nResults saved to: " << output_filename << std::endl;
+        std::cout << "Peak memory usage: " << formatMemorySize(processing_context.memory_monitor->get_peak_usage())
+                  << std::endl;
+    }
+}
+
+// Print the high-level table (kJ/mol Gibbs energies or a.u. components) and save it next to the directory
+static void output_high_level_results(HighLevelEnergyCalculator&              calculator,
+                                      const std::vector<HighLevelEnergyData>& results,
+                                      bool                                    au_format,
+                                      const CommandContext&                   context,
+                                      const ProcessingContext&                processing_context)
+{
+    std::string name_suffix = au_format ? "-highLevel-au" : "-highLevel-kJ";
+
+    // The binary file holds the values behind the table and is not printed
+    if (context.output_format == "bin")
+    {
+        save_high_level_columnar(calculator, results, name_suffix, context, processing_context);
+        return;
+    }
+
+    bool csv   = context.output_format == "csv";
+    auto print = [&](bool quiet, std::ostream* output_file) {
+        if (au_format && csv)
+        {
+            calculator.print_components_csv_format(results, quiet, output_file);
+        }
+        else if (au_format)
+        {
+            calculator.print_components_format_dynamic(results, quiet, output_file);
+        }
+        else if (csv)
+        {
+            calculator.print_gibbs_csv_format(results, quiet, output_file);
+        }
+        else
+        {
+            calculator.print_gibbs_format_dynamic(results, quiet, output_file);
+        }
+    };
+
+    // Print results based on output format
+    print(context.quiet, nullptr);
+
+    // Save results to file
+    std::string   output_filename = HighLevelEnergyUtils::get_current_directory_name() + name_suffix +
+                                  (csv ? ".csv" : ".results");
+    std::ofstream output_file(output_filename);
+    if (!output_file.is_open())
+    {
+        std::cerr << "Warning: Could not save results to " << output_filename << std::endl;
+        return;
+    }
+
+    // Print results to file (include metadata)
+    print(false, &output_file);
+    output_file.close();
+
+    if (!context.quiet)
+    {
+        std::cout << "\nResults saved to: " << output_filename << std::endl;
+
+        // Print resource usage summary
+        auto peak_memory = processing_context.memory_monitor->get_peak_usage();
+        std::cout << "Peak memory usage: " << formatMemorySize(peak_memory) << std::endl;
+    }
+}
+
 int execute_extract_command(const CommandContext& context)
 {
     setup_signal_handlers();
@@ -92,6 +316,10 @@ int execute_extract_command(const CommandContext& context)
 
     try
     {
+        ShardSpec shard;
+        shard.index = context.shard_index;
+        shard.count = context.shard_count;
+
         // Call the existing processAndOutputResults function
         processAndOutputResults(context.temp,
                                 context.concentration,
@@ -105,7 +333,17 @@ int execute_extract_command(const CommandContext& context)
                                 context.memory_limit_mb,
                                 context.warnings,
                                 context.job_resources,
-                                context.batch_size);
+                                context.batch_size,
+                                parse_scan_mode(context.scan_mode),
+                                context.use_result_index,
+                                context.stream_output,
+                                context.recursive,
+                                context.with_xyz,
+                                shard,
+                                ScanObserver(),
+                                context.io_depth,
+                                ResultSelection{context.where, context.top},
+                                context.resume);
 
         return 0;
     }
@@ -127,6 +365,13 @@ int execute_check_done_command(const CommandContext& context)
 
     try
     {
+        // Moves an interrupted run left unfinished are settled before the directory is listed
+        std::shared_ptr<RunJournal> journal;
+        if (!open_move_journal(context, journal))
+        {
+            return 0;
+        }
+
         // Find log files using batch processing if specified
         std::vector<std::string> log_files;
 
@@ -170,6 +415,7 @@ int execute_check_done_command(const CommandContext& context)
                     std::cout << "No " << context.extension << " files found in current directory." << std::endl;
                 }
             }
+            close_move_journal(journal);
             return 0;
         }
 
@@ -190,7 +436,9 @@ int execute_check_done_command(const CommandContext& context)
         }
 
         // Create job checker
-        JobChecker checker(processing_context, context.quiet, false);
+        open_result_index(context, *processing_context);
+
+        JobChecker checker(processing_context, context.quiet, false, move_options(context, journal));
 
         // Determine target directory suffix
         std::string dir_suffix = context.dir_suffix;
@@ -202,6 +450,7 @@ int execute_check_done_command(const CommandContext& context)
 
         // Check completed jobs
         CheckSummary summary = checker.check_completed_jobs(log_files, dir_suffix);
+        close_result_index(context, *processing_context);
 
         // Print summary if not quiet
         if (!context.quiet)
@@ -215,6 +464,7 @@ int execute_check_done_command(const CommandContext& context)
             printResourceUsage(*processing_context, context.quiet);
         }
 
+        close_move_journal(journal);
         return (summary.errors.empty()) ? 0 : 1;
     }
     catch (const std::exception& e)
@@ -235,6 +485,13 @@ int execute_check_errors_command(const CommandContext& context)
 
     try
     {
+        // Moves an interrupted run left unfinished are settled before the directory is listed
+        std::shared_ptr<RunJournal> journal;
+        if (!open_move_journal(context, journal))
+        {
+            return 0;
+        }
+
         // Find log files using batch processing if specified
         std::vector<std::string> log_files;
 
@@ -278,6 +535,7 @@ int execute_check_errors_command(const CommandContext& context)
                     std::cout << "No " << context.extension << " files found in current directory." << std::endl;
                 }
             }
+            close_move_journal(journal);
             return 0;
         }
 
@@ -298,7 +556,8 @@ int execute_check_errors_command(const CommandContext& context)
         }
 
         // Create job checker
-        JobChecker checker(processing_context, context.quiet, context.show_error_details);
+        JobChecker checker(
+            processing_context, context.quiet, context.show_error_details, move_options(context, journal));
 
         // Determine target directory
         std::string target_dir = "errorJobs";
@@ -322,6 +581,7 @@ int execute_check_errors_command(const CommandContext& context)
             printResourceUsage(*processing_context, context.quiet);
         }
 
+        close_move_journal(journal);
         return (summary.errors.empty()) ? 0 : 1;
     }
     catch (const std::exception& e)
@@ -342,6 +602,13 @@ int execute_check_pcm_command(const CommandContext& context)
 
     try
     {
+        // Moves an interrupted run left unfinished are settled before the directory is listed
+        std::shared_ptr<RunJournal> journal;
+        if (!open_move_journal(context, journal))
+        {
+            return 0;
+        }
+
         // Find log files using batch processing if specified
         std::vector<std::string> log_files;
 
@@ -385,6 +652,7 @@ int execute_check_pcm_command(const CommandContext& context)
                     std::cout << "No " << context.extension << " files found in current directory." << std::endl;
                 }
             }
+            close_move_journal(journal);
             return 0;
         }
 
@@ -405,7 +673,7 @@ int execute_check_pcm_command(const CommandContext& context)
         }
 
         // Create job checker
-        JobChecker checker(processing_context, context.quiet, false);
+        JobChecker checker(processing_context, context.quiet, false, move_options(context, journal));
 
         // Determine target directory
         std::string target_dir = "PCMMkU";
@@ -429,6 +697,7 @@ int execute_check_pcm_command(const CommandContext& context)
             printResourceUsage(*processing_context, context.quiet);
         }
 
+        close_move_journal(journal);
         return (summary.errors.empty()) ? 0 : 1;
     }
     catch (const std::exception& e)
@@ -449,6 +718,13 @@ int execute_check_all_command(const CommandContext& context)
 
     try
     {
+        // Moves an interrupted run left unfinished are settled before the directory is listed
+        std::shared_ptr<RunJournal> journal;
+        if (!open_move_journal(context, journal))
+        {
+            return 0;
+        }
+
         // Find log files using batch processing if specified
         std::vector<std::string> log_files;
 
@@ -492,6 +768,7 @@ int execute_check_all_command(const CommandContext& context)
                     std::cout << "No " << context.extension << " files found in current directory." << std::endl;
                 }
             }
+            close_move_journal(journal);
             return 0;
         }
 
@@ -512,10 +789,14 @@ int execute_check_all_command(const CommandContext& context)
         }
 
         // Create job checker
-        JobChecker checker(processing_context, context.quiet, context.show_error_details);
+        open_result_index(context, *processing_context);
+
+        JobChecker checker(
+            processing_context, context.quiet, context.show_error_details, move_options(context, journal));
 
         // Run all checks
         CheckSummary summary = checker.check_all_job_types(log_files);
+        close_result_index(context, *processing_context);
 
         // Print any resource usage information
         if (!context.quiet)
@@ -523,6 +804,7 @@ int execute_check_all_command(const CommandContext& context)
             printResourceUsage(*processing_context, context.quiet);
         }
 
+        close_move_journal(journal);
         return (summary.errors.empty()) ? 0 : 1;
     }
     catch (const std::exception& e)
@@ -543,6 +825,13 @@ int execute_check_imaginary_command(const CommandContext& context)
 
     try
     {
+        // Moves an interrupted run left unfinished are settled before the directory is listed
+        std::shared_ptr<RunJournal> journal;
+        if (!open_move_journal(context, journal))
+        {
+            return 0;
+        }
+
         std::vector<std::string> log_files;
 
         // If using default extension (.log), search for both .log and .out files (case-insensitive)
@@ -585,6 +874,7 @@ int execute_check_imaginary_command(const CommandContext& context)
                     std::cout << "No " << context.extension << " files found in current directory." << std::endl;
                 }
             }
+            close_move_journal(journal);
             return 0;
         }
 
@@ -601,7 +891,7 @@ int execute_check_imaginary_command(const CommandContext& context)
             processing_context->memory_monitor->set_memory_limit(context.memory_limit_mb);
         }
 
-        JobChecker checker(processing_context, context.quiet, false);
+        JobChecker checker(processing_context, context.quiet, false, move_options(context, journal));
 
         std::string target_dir_suffix = "imaginary_freqs";
         if (!context.target_dir.empty())
@@ -621,6 +911,7 @@ int execute_check_imaginary_command(const CommandContext& context)
             printResourceUsage(*processing_context, context.quiet);
         }
 
+        close_move_journal(journal);
         return (summary.errors.empty()) ? 0 : 1;
     }
     catch (const std::exception& e)
@@ -699,11 +990,9 @@ int execute_high_level_kj_command(const CommandContext& context)
         double concentration_m = static_cast<double>(context.concentration) / 1000.0;
 
         // Determine optimal thread count for high-level processing
-        unsigned int requested_threads =
-            context.requested_threads > 0
-                ? context.requested_threads
-                : calculateSafeThreadCount(context.requested_threads, 100, context.job_resources);
-        unsigned int thread_count = std::min(requested_threads, static_cast<unsigned int>(filtered_files.size()));
+        unsigned int requested_threads = context.requested_threads;
+        unsigned int thread_count      = calculateSafeThreadCount(
+            requested_threads, static_cast<unsigned int>(filtered_files.size()), context.job_resources);
 
         if (!context.quiet)
         {
@@ -736,6 +1025,7 @@ int execute_high_level_kj_command(const CommandContext& context)
                                                                       context.extension,
                                                                       context.max_file_size_mb,
                                                                       job_resources);
+        open_result_index(context, *processing_context);
 
         // Create enhanced high-level energy calculator (KJ format)
         HighLevelEnergyCalculator calculator(
@@ -751,6 +1041,7 @@ int execute_high_level_kj_command(const CommandContext& context)
         {
             results = calculator.process_directory(context.extension);
         }
+        close_result_index(context, *processing_context);
 
         // Check for errors during processing
         if (processing_context->error_collector->has_errors())
@@ -792,48 +1083,7 @@ int execute_high_level_kj_command(const CommandContext& context)
                       << std::endl;
         }
 
-        // Print results based on output format
-        if (context.output_format == "csv")
-        {
-            calculator.print_gibbs_csv_format(results, context.quiet);
-        }
-        else
-        {
-            calculator.print_gibbs_format_dynamic(results, context.quiet);
-        }
-
-        // Save results to file
-        std::string file_extension = (context.output_format == "csv") ? ".csv" : ".results";
-        std::string output_filename =
-            HighLevelEnergyUtils::get_current_directory_name() + "-highLevel-kJ" + file_extension;
-
-        std::ofstream output_file(output_filename);
-        if (output_file.is_open())
-        {
-            // Print results to file (include metadata)
-            if (context.output_format == "csv")
-            {
-                calculator.print_gibbs_csv_format(results, false, &output_file);
-            }
-            else
-            {
-                calculator.print_gibbs_format_dynamic(results, false, &output_file);
-            }
-            output_file.close();
-
-            if (!context.quiet)
-            {
-                std::cout << "\nResults saved to: " << output_filename << std::endl;
-
-                // Print resource usage summary
-                auto peak_memory = processing_context->memory_monitor->get_peak_usage();
-                std::cout << "Peak memory usage: " << formatMemorySize(peak_memory) << std::endl;
-            }
-        }
-        else
-        {
-            std::cerr << "Warning: Could not save results to " << output_filename << std::endl;
-        }
+        output_high_level_results(calculator, results, false, context, *processing_context);
 
         return processing_context->error_collector->has_errors() ? 1 : 0;
     }
@@ -913,11 +1163,9 @@ int execute_high_level_au_command(const CommandContext& context)
         double concentration_m = static_cast<double>(context.concentration) / 1000.0;
 
         // Determine optimal thread count for high-level processing
-        unsigned int requested_threads =
-            context.requested_threads > 0
-                ? context.requested_threads
-                : calculateSafeThreadCount(context.requested_threads, 100, context.job_resources);
-        unsigned int thread_count = std::min(requested_threads, static_cast<unsigned int>(filtered_files.size()));
+        unsigned int requested_threads = context.requested_threads;
+        unsigned int thread_count      = calculateSafeThreadCount(
+            requested_threads, static_cast<unsigned int>(filtered_files.size()), context.job_resources);
 
         if (!context.quiet)
         {
@@ -950,6 +1198,7 @@ int execute_high_level_au_command(const CommandContext& context)
                                                                       context.extension,
                                                                       context.max_file_size_mb,
                                                                       job_resources);
+        open_result_index(context, *processing_context);
 
         // Create enhanced high-level energy calculator (AU format)
         HighLevelEnergyCalculator calculator(
@@ -965,6 +1214,7 @@ int execute_high_level_au_command(const CommandContext& context)
         {
             results = calculator.process_directory(context.extension);
         }
+        close_result_index(context, *processing_context);
 
         // Check for errors during processing
         if (processing_context->error_collector->has_errors())
@@ -1006,48 +1256,7 @@ int execute_high_level_au_command(const CommandContext& context)
                       << std::endl;
         }
 
-        // Print results based on output format
-        if (context.output_format == "csv")
-        {
-            calculator.print_components_csv_format(results, context.quiet);
-        }
-        else
-        {
-            calculator.print_components_format_dynamic(results, context.quiet);
-        }
-
-        // Save results to file
-        std::string file_extension = (context.output_format == "csv") ? ".csv" : ".results";
-        std::string output_filename =
-            HighLevelEnergyUtils::get_current_directory_name() + "-highLevel-au" + file_extension;
-
-        std::ofstream output_file(output_filename);
-        if (output_file.is_open())
-        {
-            // Print results to file (include metadata)
-            if (context.output_format == "csv")
-            {
-                calculator.print_components_csv_format(results, false, &output_file);
-            }
-            else
-            {
-                calculator.print_components_format_dynamic(results, false, &output_file);
-            }
-            output_file.close();
-
-            if (!context.quiet)
-            {
-                std::cout << "\nResults saved to: " << output_filename << std::endl;
-
-                // Print resource usage summary
-                auto peak_memory = processing_context->memory_monitor->get_peak_usage();
-                std::cout << "Peak memory usage: " << formatMemorySize(peak_memory) << std::endl;
-            }
-        }
-        else
-        {
-            std::cerr << "Warning: Could not save results to " << output_filename << std::endl;
-        }
+        output_high_level_results(calculator, results, true, context, *processing_context);
 
         return processing_context->error_collector->has_errors() ? 1 : 0;
     }
@@ -1141,7 +1350,7 @@ int execute_extract_coords_command(const CommandContext& context)
             processing_context->memory_monitor->set_memory_limit(context.memory_limit_mb);
         }
 
-        CoordExtractor extractor(processing_context, context.quiet);
+        CoordExtractor extractor(processing_context, context.quiet, context.all_frames);
 
         ExtractSummary summary = extractor.extract_coordinates(log_files);
 
@@ -1416,3 +1625,247 @@ int execute_create_input_command(const CommandContext& context)
         return 1;
     }
 }
+
+int execute_merge_command(const CommandContext& context)
+{
+    try
+    {
+        return mergeShardResults(context.specific_files,
+                                 context.sort_column,
+                                 context.output_format,
+                                 context.quiet,
+                                 context.requested_threads)
+                   ? 0
+                   : 1;
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Fatal error: " << e.what() << std::endl;
+        return 1;
+    }
+}
+
+int execute_watch_command(const CommandContext& context)
+{
+    setup_signal_handlers();
+
+    try
+    {
+        auto processing_context =
+            std::make_shared<ProcessingContext>(298.15,  // Temperature not needed for job checking
+                                                1000,    // Concentration not needed for job checking
+                                                context.use_input_temp,
+                                                context.requested_threads,
+                                                context.extension,
+                                                context.max_file_size_mb,
+                                                context.job_resources);
+
+        if (context.memory_limit_mb > 0)
+        {
+            processing_context->memory_monitor->set_memory_limit(context.memory_limit_mb);
+        }
+
+        open_result_index(context, *processing_context);
+
+        WatchOptions options;
+        options.interval_seconds = context.watch_interval;
+        options.settle_seconds   = context.watch_settle;
+        options.force_polling    = context.watch_polling;
+        options.dir_suffix       = context.dir_suffix;
+
+        JobWatcher   watcher(processing_context, options, context.quiet, context.show_error_details,
+                           move_options(context));
+        CheckSummary summary = watcher.run();
+        close_result_index(context, *processing_context);
+
+        for (const auto& error : summary.errors)
+        {
+            std::cerr << error << std::endl;
+        }
+        return (summary.errors.empty() && summary.failed_moves == 0) ? 0 : 1;
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Fatal error: " << e.what() << std::endl;
+        return 1;
+    }
+}
+
+int execute_pipeline_command(const CommandContext& context)
+{
+    setup_signal_handlers();
+
+    auto has_stage = [&context](const char* name) {
+        return std::find(context.pipeline_stages.begin(), context.pipeline_stages.end(), name) !=
+               context.pipeline_stages.end();
+    };
+    bool check   = has_stage("check");
+    bool xyz     = has_stage("xyz");
+    bool high_kj = has_stage("high-kj");
+    bool high_au = has_stage("high-au");
+
+    try
+    {
+        if ((high_kj || high_au) &&
+            !HighLevelEnergyUtils::is_valid_high_level_directory(context.extension, context.max_file_size_mb))
+        {
+            std::cerr << "Warning: No parent directory with low-level thermal data; high-level stage skipped."
+                      << std::endl;
+            high_kj = high_au = false;
+        }
+
+        // The check and high-level stages share one context for their warnings and the parent-file reads;
+        // extract sets up its own inside processAndOutputResults()
+        auto stage_context = std::make_shared<ProcessingContext>(context.temp,
+                                                                 context.concentration,
+                                                                 context.use_input_temp,
+                                                                 context.requested_threads,
+                                                                 context.extension,
+                                                                 context.max_file_size_mb,
+                                                                 context.job_resources);
+        if (context.memory_limit_mb > 0)
+        {
+            stage_context->memory_monitor->set_memory_limit(context.memory_limit_mb);
+        }
+
+        double                    concentration_m = static_cast<double>(context.concentration) / 1000.0;
+        JobChecker                checker(stage_context, context.quiet, context.show_error_details, move_options(context));
+        HighLevelEnergyCalculator kj_calculator(stage_context, context.temp, concentration_m, context.sort_column, false);
+        HighLevelEnergyCalculator au_calculator(stage_context, context.temp, concentration_m, context.sort_column, true);
+
+        std::vector<JobCheckResult>      jobs;
+        std::vector<HighLevelEnergyData> energies;
+        std::mutex                       stage_mutex;
+
+        // Every stage works on the content extract() has just read; nothing is moved until all logs are read
+        ScanObserver observer;
+        if (check || high_kj || high_au)
+        {
+            observer = [&](const std::string& path, std::string_view content, const LogScanData&) {
+                JobCheckResult      job;
+                HighLevelEnergyData energy;
+                if (check)
+                {
+                    job = checker.classify_content(path, content);
+                }
+                if (high_kj || high_au)
+                {
+                    energy = kj_calculator.calculate_high_level_energy(path, content);
+                }
+
+                auto lock = Profiler::lock(stage_mutex);
+                if (check)
+                {
+                    jobs.push_back(std::move(job));
+                }
+                if (high_kj || high_au)
+                {
+                    energies.push_back(std::move(energy));
+                }
+            };
+        }
+
+        processAndOutputResults(context.temp,
+                                context.concentration,
+                                context.sort_column,
+                                context.extension,
+                                context.quiet,
+                                context.output_format,
+                                context.use_input_temp,
+                                context.requested_threads,
+                                context.max_file_size_mb,
+                                context.memory_limit_mb,
+                                context.warnings,
+                                context.job_resources,
+                                context.batch_size,
+                                parse_scan_mode(context.scan_mode),
+                                context.use_result_index && !observer,
+                                context.stream_output,
+                                context.recursive,
+                                xyz || context.with_xyz,
+                                ShardSpec{},
+                                observer,
+                                context.io_depth,
+                                ResultSelection{context.where, context.top});
+
+        if (g_shutdown_requested.load())
+        {
+            std::cerr << "Pipeline interrupted; no files were moved." << std::endl;
+            return 4;
+        }
+
+        if (high_kj || high_au)
+        {
+            auto warnings = stage_context->error_collector->get_warnings();
+            if (!warnings.empty() && !context.quiet)
+            {
+                std::cout << "Warnings:" << std::endl;
+                for (const auto& warning : warnings)
+                {
+                    std::cout << "  " << warning << std::endl;
+                }
+            }
+            if (high_kj)
+            {
+                kj_calculator.sort_results(energies);
+                output_high_level_results(kj_calculator, energies, false, context, *stage_context);
+            }
+            if (high_au)
+            {
+                au_calculator.sort_results(energies);
+                output_high_level_results(au_calculator, energies, true, context, *stage_context);
+            }
+        }
+
+        // Moves come last, so the results table and XYZ files name the logs where they were read
+        bool moves_ok = true;
+        if (check)
+        {
+            CheckSummary summary = checker.organize_classified_jobs(jobs, context.dir_suffix);
+            for (const auto& error : summary.errors)
+            {
+                std::cerr << error << std::endl;
+            }
+            moves_ok = summary.errors.empty() && summary.failed_moves == 0;
+        }
+
+        for (const auto& error : stage_context->error_collector->get_errors())
+        {
+            std::cerr << "Error: " << error << std::endl;
+        }
+        return (moves_ok && !stage_context->error_collector->has_errors()) ? 0 : 1;
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Fatal error: " << e.what() << std::endl;
+        return 1;
+    }
+}
+
+void apply_cpu_placement(const CommandContext& context)
+{
+    CpuPlacement::Policy policy = CpuPlacement::Policy::NONE;
+    CpuPlacement::parse_policy(context.pin_policy, policy);
+    TaskExecutor::set_placement(policy, context.job_resources.cpu_set);
+
+    if (policy != CpuPlacement::Policy::NONE && !context.quiet)
+    {
+        if (context.job_resources.cpu_set.empty())
+        {
+            std::cerr << "Warning: The allowed CPUs could not be determined; threads are not pinned." << std::endl;
+        }
+        else
+        {
+            std::vector<unsigned int> nodes;
+            for (unsigned int cpu : context.job_resources.cpu_set)
+            {
+                nodes.push_back(CpuPlacement::numa_node(cpu));
+            }
+            std::sort(nodes.begin(), nodes.end());
+            nodes.erase(std::unique(nodes.begin(), nodes.end()), nodes.end());
+            std::cout << "Pinning threads (" << context.pin_policy << ") to " << context.job_resources.cpu_set.size()
+                      << " allowed CPUs on " << nodes.size() << " NUMA node" << (nodes.size() == 1 ? "" : "s")
+                      << std::endl;
+        }
+    }
+}
@@ -16,6 +16,9 @@
  * - execute_check_all_command: Run comprehensive job status checks
  * - execute_high_level_kj_command: Calculate high-level energies with kJ/mol output
  * - execute_high_level_au_command: Calculate high-level energies with atomic unit output
+ * - execute_merge_command: Combine the partial results of a sharded extract
+ * - execute_watch_command: Organize jobs as their logs terminate
+ * - execute_pipeline_command: Check, extract, xyz and high-level stages from one read of each log
  */
 
 #ifndef MODULE_EXECUTOR_H
@@ -175,6 +178,51 @@ int execute_extract_coords_command(const CommandContext& context);
  */
 int execute_create_input_command(const CommandContext& context);
 
+/**
+ * @brief Execute the merge command for the partial results of a sharded extract
+ * @param context Command context; specific_files names the partials (empty = all in the directory)
+ * @return Exit code: 0 for success, non-zero for errors
+ *
+ * Reads the "<dir>.shard-<i>-of-<N>.bin" files written by extract --shard,
+ * sorts and merges their rows and writes the results table in the requested
+ * format, warning about shards that are missing.
+ */
+int execute_merge_command(const CommandContext& context);
+
+/**
+ * @brief Execute the watch command that organizes jobs as they finish
+ * @param context Command context (watch timing, checker and index options)
+ * @return Exit code: 0 after a clean shutdown, non-zero if checks or moves failed
+ *
+ * Classifies the logs already present, then stays resident and moves each
+ * job into the done, errorJobs or PCMMkU directory once its log has
+ * terminated, until interrupted with Ctrl+C or SIGTERM.
+ */
+int execute_watch_command(const CommandContext& context);
+
+/**
+ * @brief Execute the pipeline command that feeds several stages from one read of each log
+ * @param context Command context; pipeline_stages selects the stages, extract and checker options apply
+ * @return Exit code: 0 for success, 1 if a stage failed, 4 if interrupted
+ *
+ * Discovers the logs once and reads each one once through the extract
+ * scanner. The same content is classified for check, parsed into the
+ * results table, written as its final geometry for xyz and combined with
+ * the parent directory's thermal data for high-kj/high-au. The check moves
+ * run last, after all tables and XYZ files have been written.
+ */
+int execute_pipeline_command(const CommandContext& context);
+
+/**
+ * @brief Apply the command's --pin placement to the shared executor
+ * @param context Command context; pin_policy and job_resources.cpu_set are used
+ *
+ * Call before executing the command. Batches run through later
+ * TaskExecutor::shared() calls pin their threads to the CPUs chosen by
+ * CpuPlacement::plan().
+ */
+void apply_cpu_placement(const CommandContext& context);
+
 /** @} */  // end of ModuleExecutors group
 
 #endif  // MODULE_EXECUTOR_H
\ No newline at end of file
@@ -0,0 +1,362 @@
+/**
+ * @file move_planner.cpp
+ * @brief Implementation of the batched file relocation planner
+ * @author Le Nhan Pham
+ * @date 2025
+ */
+
+#include "move_planner.h"
+#include "profiler.h"
+#include "task_executor.h"
+#include <algorithm>
+#include <chrono>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <sstream>
+#include <system_error>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace
+{
+    /**
+     * @brief Timestamp suffix of Utils::generate_unique_filename ("_YYYYMMDD_HHMMSS")
+     */
+    std::string timestamp_suffix()
+    {
+        auto now    = std::chrono::system_clock::now();
+        auto time_t = std::chrono::system_clock::to_time_t(now);
+        auto tm     = *std::localtime(&time_t);
+
+        std::ostringstream timestamp;
+        timestamp << "_" << std::put_time(&tm, "%Y%m%d_%H%M%S");
+        return timestamp.str();
+    }
+
+    std::string with_suffix(const std::filesystem::path& name, const std::string& suffix)
+    {
+        return name.stem().string() + suffix + name.extension().string();
+    }
+
+    /**
+     * @brief Move one file, copying and unlinking when the rename crosses file systems
+     */
+    void relocate(const std::string& source, const std::string& destination, bool replace, std::error_code& ec)
+    {
+        std::filesystem::rename(source, destination, ec);
+        if (ec != std::errc::cross_device_link)
+        {
+            return;
+        }
+
+        ec.clear();
+        auto options =
+            replace ? std::filesystem::copy_options::overwrite_existing : std::filesystem::copy_options::none;
+        if (!std::filesystem::copy_file(source, destination, options, ec) || ec)
+        {
+            return;
+        }
+
+        std::error_code time_error;
+        auto            modified = std::filesystem::last_write_time(source, time_error);
+        if (!time_error)
+        {
+            std::filesystem::last_write_time(destination, modified, time_error);
+        }
+        std::filesystem::remove(source, ec);
+    }
+}  // namespace
+
+// =============================================================================
+// MovePlanner Implementation
+// =============================================================================
+
+MovePlanner::MovePlanner(const MoveOptions& options, Collision collision) : options_(options), collision_(collision) {}
+
+size_t MovePlanner::add(const std::string&              target_dir,
+                        const std::string&              primary,
+                        const std::vector<std::string>& companions)
+{
+    Group group;
+    group.target_dir = target_dir;
+    group.first_move = moves_.size();
+    group.move_count = 1 + companions.size();
+    group.moved         = false;
+    group.journal_entry = 0;
+
+    moves_.push_back({primary, "", true});
+    for (const auto& companion : companions)
+    {
+        moves_.push_back({companion, "", false});
+    }
+
+    groups_.push_back(std::move(group));
+    return groups_.size() - 1;
+}
+
+void MovePlanner::resolve_destinations()
+{
+    // One creation and one listing per target directory
+    std::unordered_map<std::string, std::unordered_set<std::string>> taken;
+    std::unordered_set<std::string>                                  failed_dirs;
+    for (const auto& group : groups_)
+    {
+        if (taken.count(group.target_dir) || failed_dirs.count(group.target_dir))
+        {
+            continue;
+        }
+
+        std::error_code ec;
+        if (!options_.dry_run)
+        {
+            std::filesystem::create_directories(group.target_dir, ec);
+            if (ec)
+            {
+                general_errors_.push_back("Failed to create directory " + group.target_dir + ": " + ec.message());
+                failed_dirs.insert(group.target_dir);
+                continue;
+            }
+        }
+
+        auto& names = taken[group.target_dir];
+        if (collision_ == Collision::RENAME)
+        {
+            for (std::filesystem::directory_iterator it(group.target_dir, ec), end; !ec && it != end; it.increment(ec))
+            {
+                names.insert(it->path().filename().string());
+            }
+        }
+    }
+
+    std::string timestamp = timestamp_suffix();
+    for (auto& group : groups_)
+    {
+        if (failed_dirs.count(group.target_dir))
+        {
+            group.error = "Failed to create target directory: " + group.target_dir;
+            continue;
+        }
+
+        auto&                 names = taken[group.target_dir];
+        std::filesystem::path dir(group.target_dir);
+
+        // Keep every file of a job under the same suffix so the log and its companions still match
+        std::string suffix;
+        for (unsigned attempt = 0; collision_ == Collision::RENAME; ++attempt)
+        {
+            bool free = true;
+            for (size_t m = group.first_move; m < group.first_move + group.move_count && free; ++m)
+            {
+                std::filesystem::path name = std::filesystem::path(moves_[m].source).filename();
+                free = names.count(suffix.empty() ? name.string() : with_suffix(name, suffix)) == 0;
+            }
+            if (free)
+            {
+                break;
+            }
+            suffix = attempt == 0 ? timestamp : timestamp + "_" + std::to_string(attempt + 1);
+        }
+
+        for (size_t m = group.first_move; m < group.first_move + group.move_count; ++m)
+        {
+            std::filesystem::path name = std::filesystem::path(moves_[m].source).filename();
+            std::string           file = suffix.empty() ? name.string() : with_suffix(name, suffix);
+            names.insert(file);
+            moves_[m].destination = (dir / file).string();
+        }
+    }
+}
+
+void MovePlanner::move_group(Group& group)
+{
+    if (!group.error.empty())
+    {
+        return;
+    }
+    if (options_.dry_run)
+    {
+        group.moved = true;
+        return;
+    }
+
+    for (size_t m = group.first_move; m < group.first_move + group.move_count; ++m)
+    {
+        const Move&     move = moves_[m];
+        std::error_code ec;
+        relocate(move.source, move.destination, collision_ == Collision::REPLACE, ec);
+        if (ec && !(ec == std::errc::no_such_file_or_directory && !move.required))
+        {
+            group.error = "Failed to move files for " + moves_[group.first_move].source + ": cannot move " +
+                          move.source + " to " + move.destination + ": " + ec.message();
+            return;
+        }
+    }
+    group.moved = true;
+}
+
+bool MovePlanner::write_manifest()
+{
+    std::ofstream manifest(options_.manifest_path);
+    if (!manifest.is_open())
+    {
+        general_errors_.push_back("Could not write move manifest: " + options_.manifest_path);
+        return false;
+    }
+
+    std::ostringstream lines;
+    for (const auto& group : groups_)
+    {
+        if (!group.error.empty())
+        {
+            continue;
+        }
+        for (size_t m = group.first_move; m < group.first_move + group.move_count; ++m)
+        {
+            lines << moves_[m].source << '\t' << moves_[m].destination << '\n';
+        }
+    }
+    manifest << lines.str();
+    return static_cast<bool>(manifest);
+}
+
+size_t MovePlanner::execute(unsigned int thread_count)
+{
+    if (groups_.empty())
+    {
+        return 0;
+    }
+    Profiler::Scope moves(Profiler::Phase::MOVES);
+
+    resolve_destinations();
+
+    // Written before anything moves, so an interrupted run can still be traced
+    if (!options_.manifest_path.empty())
+    {
+        write_manifest();
+    }
+
+    // Groups are on disk before their first file moves, so an interrupted run can be settled by --resume
+    RunJournal* journal = options_.dry_run ? nullptr : options_.journal.get();
+    if (journal)
+    {
+        for (auto& group : groups_)
+        {
+            if (!group.error.empty())
+            {
+                continue;
+            }
+            std::string payload;
+            RunJournal::put(payload, static_cast<uint32_t>(group.move_count));
+            for (size_t m = group.first_move; m < group.first_move + group.move_count; ++m)
+            {
+                RunJournal::put_string(payload, moves_[m].source);
+                RunJournal::put_string(payload, moves_[m].destination);
+            }
+            group.journal_entry = journal->append(RunJournal::EntryType::MOVE, payload);
+        }
+        if (!journal->flush())
+        {
+            general_errors_.push_back("Could not write journal " + journal->path() + "; no files were moved");
+            return 0;
+        }
+    }
+
+    TaskExecutor::shared(thread_count).run(groups_.size(), [this, journal](size_t index) {
+        Group& group = groups_[index];
+        move_group(group);
+        if (journal && group.moved)
+        {
+            std::string payload;
+            RunJournal::put(payload, group.journal_entry);
+            journal->append(RunJournal::EntryType::MOVE_DONE, payload);
+        }
+    });
+    if (journal)
+    {
+        journal->flush();
+    }
+
+    size_t moved = 0;
+    for (const auto& group : groups_)
+    {
+        moved += group.moved ? 1 : 0;
+    }
+    return moved;
+}
+
+size_t MovePlanner::recover(const std::vector<RunJournal::Entry>& entries, bool undo, std::vector<std::string>& errors)
+{
+    // Groups whose MOVE entry has no MOVE_DONE entry, in journal order
+    std::map<uint64_t, std::vector<std::pair<std::string, std::string>>> unfinished;
+    for (const auto& entry : entries)
+    {
+        std::string_view payload = entry.payload;
+        if (entry.type == RunJournal::EntryType::MOVE)
+        {
+            uint32_t                                         count = 0;
+            std::vector<std::pair<std::string, std::string>> files;
+            bool                                             ok = RunJournal::get(payload, count);
+            for (uint32_t i = 0; ok && i < count; ++i)
+            {
+                std::pair<std::string, std::string> file;
+                ok = RunJournal::get_string(payload, file.first) && RunJournal::get_string(payload, file.second);
+                files.push_back(std::move(file));
+            }
+            if (ok)
+            {
+                unfinished[entry.number] = std::move(files);
+            }
+        }
+        else if (entry.type == RunJournal::EntryType::MOVE_DONE)
+        {
+            uint64_t number = 0;
+            if (RunJournal::get(payload, number))
+            {
+                unfinished.erase(number);
+            }
+        }
+    }
+
+    auto settle = [&](const std::pair<std::string, std::string>& file) {
+        const std::string& from = undo ? file.second : file.first;
+        const std::string& to   = undo ? file.first : file.second;
+
+        // A file still at its source has not moved (a copy across file systems may have been cut short and is
+        // redone); one missing there has moved already, or was an absent companion
+        std::error_code ec;
+        if (!std::filesystem::exists(from, ec) || (undo && std::filesystem::exists(to, ec)))
+        {
+            return;
+        }
+        std::filesystem::path parent = std::filesystem::path(to).parent_path();
+        if (!parent.empty())
+        {
+            std::filesystem::create_directories(parent, ec);
+        }
+        relocate(from, to, !undo, ec);
+        if (ec)
+        {
+            errors.push_back("Cannot move " + from + " to " + to + ": " + ec.message());
+        }
+    };
+
+    // Undoing walks back from the last group, so files that moved twice return to where they started
+    if (undo)
+    {
+        for (auto it = unfinished.rbegin(); it != unfinished.rend(); ++it)
+        {
+            std::for_each(it->second.rbegin(), it->second.rend(), settle);
+        }
+    }
+    else
+    {
+        for (const auto& [number, files] : unfinished)
+        {
+            std::for_each(files.begin(), files.end(), settle);
+        }
+    }
+    return unfinished.size();
+}
@@ -0,0 +1,196 @@
+/**
+ * @file move_planner.h
+ * @brief Batched, parallel relocation of job files into status directories
+ * @author Le Nhan Pham
+ * @date 2025
+ *
+ * This header provides the planner behind every command that moves files
+ * (done, errors, pcm, imode, check and xyz). Instead of creating the target
+ * directory, probing for an existing file and renaming for every job in turn,
+ * the planner first collects all moves of a command, then works in three
+ * steps:
+ *
+ * @section Planning
+ * - Every target directory is created (if needed) and listed exactly once
+ * - Destination names are checked against that listing and against the
+ *   names already planned in the same batch, entirely in memory
+ * - A job whose log or related files would replace an existing file gets a
+ *   timestamp suffix on all of its files (the Utils::generate_unique_filename
+ *   naming), so a log and its .chk/.gjf stay together under matching names
+ *
+ * @section Execution
+ * - The renames run in parallel on the shared TaskExecutor, one job per task
+ * - A rename across file systems (EXDEV) falls back to copy and unlink, with
+ *   the modification time of the source preserved
+ * - A dry run resolves the same destinations but does not touch any file
+ *
+ * @section Manifest
+ * The planned moves can be written as a tab-separated manifest
+ * ("source<TAB>destination", one line per file), which together with a dry
+ * run shows exactly what a command would do.
+ *
+ * @section Journal
+ * With a RunJournal (--resume), every group is recorded before any file
+ * moves and marked once all of its files have moved. recover() uses the
+ * groups left unmarked by an interrupted run to finish their moves or to put
+ * their files back.
+ */
+
+#ifndef MOVE_PLANNER_H
+#define MOVE_PLANNER_H
+
+#include "utilities/run_journal.h"
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @struct MoveOptions
+ * @brief How the planned moves of a command are carried out
+ */
+struct MoveOptions
+{
+    bool                        dry_run;        ///< Resolve and report the moves without touching any file
+    std::string                 manifest_path;  ///< Write the planned moves to this file ("" = no manifest)
+    std::shared_ptr<RunJournal> journal;        ///< Records the moves for --resume (nullptr = none; unused in dry runs)
+
+    MoveOptions() : dry_run(false) {}
+};
+
+/**
+ * @class MovePlanner
+ * @brief Collects file moves in groups and carries them out as one batch
+ *
+ * A group is the unit that succeeds or fails together: one job's log file
+ * with its related files, or a single XYZ file. Groups are numbered in the
+ * order they are added.
+ */
+class MovePlanner
+{
+public:
+    /**
+     * @enum Collision
+     * @brief What happens when a destination file already exists
+     */
+    enum class Collision
+    {
+        RENAME,  ///< Keep the existing file; the moved group gets a unique suffix
+        REPLACE  ///< Replace the existing file (refreshed output such as XYZ geometries)
+    };
+
+    /**
+     * @brief Create an empty plan
+     * @param options Dry-run and manifest settings
+     * @param collision Policy for destinations that already exist
+     */
+    explicit MovePlanner(const MoveOptions& options = MoveOptions(), Collision collision = Collision::RENAME);
+
+    /**
+     * @brief Add a group of files moved into the same directory
+     * @param target_dir Target directory (created when the plan is executed)
+     * @param primary File that must be moved for the group to succeed
+     * @param companions Files moved along with it; missing ones are skipped
+     * @return Group number, for moved() and error()
+     */
+    size_t add(const std::string& target_dir, const std::string& primary, const std::vector<std::string>& companions);
+
+    /**
+     * @brief Resolve all destinations and carry out the moves
+     * @param thread_count Thread count from calculateSafeThreadCount()
+     * @return Number of groups whose files were all moved (all groups in a dry run)
+     *
+     * Writes the manifest if one was requested, also for a dry run. Call once.
+     */
+    size_t execute(unsigned int thread_count);
+
+    /**
+     * @brief Whether every file of a group was moved (or would be, in a dry run)
+     */
+    bool moved(size_t group) const
+    {
+        return groups_[group].moved;
+    }
+
+    /**
+     * @brief Reason a group failed ("" if it succeeded)
+     */
+    const std::string& error(size_t group) const
+    {
+        return groups_[group].error;
+    }
+
+    /**
+     * @brief Final location of a group's primary file
+     */
+    const std::string& destination(size_t group) const
+    {
+        return moves_[groups_[group].first_move].destination;
+    }
+
+    /**
+     * @brief Number of groups in the plan
+     */
+    size_t group_count() const
+    {
+        return groups_.size();
+    }
+
+    /**
+     * @brief Errors that do not belong to a group (target directory, manifest)
+     */
+    const std::vector<std::string>& general_errors() const
+    {
+        return general_errors_;
+    }
+
+    /**
+     * @brief Settle the moves an interrupted run left unfinished
+     * @param entries Entries recovered from the run's journal
+     * @param undo Put the files of unfinished groups back instead of completing their moves
+     * @param errors Receives one message per file that could not be moved
+     * @return Number of unfinished groups found
+     *
+     * Every file is checked on its own, so files that already reached their
+     * destination (or were never moved, when undoing) are left alone.
+     */
+    static size_t recover(const std::vector<RunJournal::Entry>& entries, bool undo, std::vector<std::string>& errors);
+
+    /**
+     * @brief Whether this plan only reports its moves
+     */
+    bool dry_run() const
+    {
+        return options_.dry_run;
+    }
+
+private:
+    struct Move
+    {
+        std::string source;       ///< Current path
+        std::string destination;  ///< Resolved path inside the target directory
+        bool        required;     ///< false for companions, which may be missing
+    };
+
+    struct Group
+    {
+        std::string target_dir;     ///< Directory receiving the group
+        size_t      first_move;     ///< Index of the primary file in moves_
+        size_t      move_count;     ///< Number of consecutive entries in moves_
+        bool        moved;          ///< Set by execute()
+        std::string error;          ///< Failure reason
+        uint64_t    journal_entry;  ///< MOVE entry of the group in options_.journal
+    };
+
+    void resolve_destinations();
+    void move_group(Group& group);
+    bool write_manifest();
+
+    MoveOptions              options_;         ///< Dry-run and manifest settings
+    Collision                collision_;       ///< Policy for existing destinations
+    std::vector<Move>        moves_;           ///< All files, grouped consecutively
+    std::vector<Group>       groups_;          ///< Groups in insertion order
+    std::vector<std::string> general_errors_;  ///< Directory and manifest errors
+};
+
+#endif  // MOVE_PLANNER_H
@@ -0,0 +1,307 @@
+/**
+ * @file profiler.cpp
+ * @brief Implementation of the per-thread phase timers and counters
+ * @author Le Nhan Pham
+ * @date 2025
+ */
+
+#include "profiler.h"
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <sstream>
+#include <vector>
+
+namespace
+{
+    constexpr size_t PHASE_COUNT   = static_cast<size_t>(Profiler::Phase::COUNT);
+    constexpr size_t COUNTER_COUNT = static_cast<size_t>(Profiler::Counter::COUNT);
+
+    /**
+     * @brief Scopes kept per thread for the trace; later scopes are only counted
+     */
+    constexpr size_t MAX_TRACE_EVENTS = 1 << 20;
+
+    const char* const COUNTER_NAMES[COUNTER_COUNT] = {
+        "bytes_read", "lines_scanned", "regex_fallbacks", "cache_hits", "cache_misses", "cache_oversized",
+        "readahead_hits", "readahead_misses", "tail_rejects"};
+
+    /**
+     * @brief Keys of the phase totals in the trace's "otherData" (seconds summed over threads)
+     */
+    const char* const PHASE_KEYS[PHASE_COUNT] = {"discovery_s", "read_s",        "parse_s",       "sort_s",     "write_s",
+                                                 "move_s",      "handle_wait_s", "memory_wait_s", "lock_wait_s"};
+
+    /**
+     * @brief One timed scope of the trace
+     */
+    struct TraceEvent
+    {
+        uint64_t        begin_ns;  ///< Start, relative to start()
+        uint64_t        length_ns; ///< Duration
+        Profiler::Phase phase;     ///< Phase of the scope
+    };
+
+    /**
+     * @brief Totals of one thread
+     *
+     * Only the owning thread writes a slot; relaxed atomics let the report read
+     * it without a data race. Each slot starts on its own cache line.
+     */
+    struct alignas(64) ThreadSlot
+    {
+        std::array<std::atomic<uint64_t>, PHASE_COUNT>   phase_ns{};     ///< Time per phase
+        std::array<std::atomic<uint64_t>, PHASE_COUNT>   phase_calls{};  ///< Scopes per phase
+        std::array<std::atomic<uint64_t>, COUNTER_COUNT> counters{};     ///< Event counts
+        std::vector<TraceEvent>                          events;         ///< Scopes for the trace
+        uint64_t                                         dropped = 0;    ///< Scopes beyond MAX_TRACE_EVENTS
+        size_t                                           id      = 0;    ///< Thread number in the report
+    };
+
+    std::mutex                               g_slots_mutex;  // Guards g_slots (registration and report only)
+    std::vector<std::unique_ptr<ThreadSlot>> g_slots;        // Never shrinks, so a slot outlives its thread
+    std::atomic<bool>                        g_tracing{false};
+    Profiler::Clock::time_point              g_epoch;
+    thread_local ThreadSlot*                 t_slot = nullptr;
+
+    ThreadSlot& local_slot()
+    {
+        if (!t_slot)
+        {
+            std::lock_guard<std::mutex> lock(g_slots_mutex);
+            g_slots.push_back(std::make_unique<ThreadSlot>());
+            t_slot     = g_slots.back().get();
+            t_slot->id = g_slots.size() - 1;
+        }
+        return *t_slot;
+    }
+
+    void bump(std::atomic<uint64_t>& value, uint64_t amount)
+    {
+        // Single writer: a plain load/store pair avoids a locked read-modify-write
+        value.store(value.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+    }
+
+    uint64_t nanoseconds(Profiler::Clock::duration duration)
+    {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count());
+    }
+
+    std::string format_count(uint64_t value)
+    {
+        std::string digits = std::to_string(value);
+        for (size_t pos = digits.size(); pos > 3; pos -= 3)
+        {
+            digits.insert(pos - 3, ",");
+        }
+        return digits;
+    }
+}  // namespace
+
+// =============================================================================
+// Profiler Implementation
+// =============================================================================
+
+std::atomic<bool> Profiler::enabled_{false};
+
+void Profiler::start(bool trace)
+{
+    g_epoch = Clock::now();
+    g_tracing.store(trace, std::memory_order_relaxed);
+    enabled_.store(true, std::memory_order_release);
+}
+
+void Profiler::add(Counter counter, uint64_t amount)
+{
+    if (enabled())
+    {
+        bump(local_slot().counters[static_cast<size_t>(counter)], amount);
+    }
+}
+
+void Profiler::record(Phase phase, Clock::time_point begin, Clock::time_point end)
+{
+    ThreadSlot& slot   = local_slot();
+    size_t      index  = static_cast<size_t>(phase);
+    uint64_t    length = nanoseconds(end - begin);
+    bump(slot.phase_ns[index], length);
+    bump(slot.phase_calls[index], 1);
+
+    if (g_tracing.load(std::memory_order_relaxed))
+    {
+        if (slot.events.size() < MAX_TRACE_EVENTS)
+        {
+            slot.events.push_back(TraceEvent{nanoseconds(begin - g_epoch), length, phase});
+        }
+        else
+        {
+            ++slot.dropped;
+        }
+    }
+}
+
+const char* Profiler::phase_name(Phase phase)
+{
+    switch (phase)
+    {
+        case Phase::DISCOVERY:
+            return "Discovery";
+        case Phase::READ:
+            return "Read";
+        case Phase::PARSE:
+            return "Parse";
+        case Phase::SORT:
+            return "Sort";
+        case Phase::FORMAT:
+            return "Format/write";
+        case Phase::MOVES:
+            return "File moves";
+        case Phase::HANDLE_WAIT:
+            return "File handle wait";
+        case Phase::MEMORY_WAIT:
+            return "Memory wait";
+        case Phase::LOCK_WAIT:
+            return "Lock wait";
+        default:
+            return "Unknown";
+    }
+}
+
+void Profiler::report(std::ostream& out)
+{
+    std::array<uint64_t, PHASE_COUNT>   phase_ns{};
+    std::array<uint64_t, PHASE_COUNT>   phase_calls{};
+    std::array<uint64_t, PHASE_COUNT>   phase_max_ns{};  // Busiest thread of each phase
+    std::array<uint64_t, COUNTER_COUNT> counters{};
+    size_t                              threads = 0;
+    {
+        std::lock_guard<std::mutex> lock(g_slots_mutex);
+        threads = g_slots.size();
+        for (const auto& slot : g_slots)
+        {
+            for (size_t p = 0; p < PHASE_COUNT; ++p)
+            {
+                uint64_t ns = slot->phase_ns[p].load(std::memory_order_relaxed);
+                phase_ns[p] += ns;
+                phase_calls[p] += slot->phase_calls[p].load(std::memory_order_relaxed);
+                phase_max_ns[p] = std::max(phase_max_ns[p], ns);
+            }
+            for (size_t c = 0; c < COUNTER_COUNT; ++c)
+            {
+                counters[c] += slot->counters[c].load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    double wall = std::chrono::duration<double>(Clock::now() - g_epoch).count();
+
+    std::ostringstream text;
+    text << "\n=== Profile (" << threads << (threads == 1 ? " thread, " : " threads, ") << std::fixed << std::setprecision(3) << wall
+         << " s wall) ===\n";
+    text << std::left << std::setw(18) << "Phase" << std::right << std::setw(12) << "Total (s)" << std::setw(14)
+         << "Busiest (s)" << std::setw(14) << "Calls" << "\n";
+    for (size_t p = 0; p < PHASE_COUNT; ++p)
+    {
+        if (phase_calls[p] == 0)
+        {
+            continue;
+        }
+        text << std::left << std::setw(18) << phase_name(static_cast<Phase>(p)) << std::right << std::setw(12)
+             << std::setprecision(3) << phase_ns[p] / 1e9 << std::setw(14) << phase_max_ns[p] / 1e9 << std::setw(14)
+             << format_count(phase_calls[p]) << "\n";
+    }
+
+    uint64_t bytes = counters[static_cast<size_t>(Counter::BYTES_READ)];
+    text << "Bytes read: " << format_count(bytes) << " (" << std::setprecision(2) << bytes / (1024.0 * 1024.0)
+         << " MB)\n";
+    text << "Lines scanned: " << format_count(counters[static_cast<size_t>(Counter::LINES_SCANNED)]) << "\n";
+    text << "Regex fallbacks: " << format_count(counters[static_cast<size_t>(Counter::REGEX_FALLBACKS)]) << "\n";
+
+    uint64_t hits   = counters[static_cast<size_t>(Counter::CACHE_HITS)];
+    uint64_t misses = counters[static_cast<size_t>(Counter::CACHE_MISSES)];
+    if (hits + misses > 0)
+    {
+        text << "File cache: " << format_count(hits) << " hits, " << format_count(misses) << " misses";
+        if (uint64_t oversized = counters[static_cast<size_t>(Counter::CACHE_OVERSIZED)])
+        {
+            text << ", " << format_count(oversized) << " uncached (too large)";
+        }
+        text << "\n";
+    }
+
+    uint64_t ahead  = counters[static_cast<size_t>(Counter::READAHEAD_HITS)];
+    uint64_t behind = counters[static_cast<size_t>(Counter::READAHEAD_MISSES)];
+    if (ahead + behind > 0)
+    {
+        text << "Read-ahead: " << format_count(ahead) << " hits, " << format_count(behind) << " misses\n";
+    }
+    if (uint64_t rejects = counters[static_cast<size_t>(Counter::TAIL_REJECTS)])
+    {
+        text << "Skipped after tail check: " << format_count(rejects) << "\n";
+    }
+    text << "(Totals are summed over threads; waits are also counted in the phase that waited)\n";
+    out << text.str() << std::flush;
+}
+
+bool Profiler::write_trace(const std::string& path, std::string& error)
+{
+    std::ofstream file(path);
+    if (!file.is_open())
+    {
+        error = "Could not write profile trace: " + path;
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(g_slots_mutex);
+    std::array<uint64_t, PHASE_COUNT>   phase_ns{};
+    std::array<uint64_t, COUNTER_COUNT> counters{};
+    uint64_t                            dropped = 0;
+
+    // Chrome trace format: complete ("X") events in microseconds, one track per thread
+    std::ostringstream json;
+    json << std::fixed << std::setprecision(3);
+    json << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+    for (const auto& slot : g_slots)
+    {
+        json << (first ? "" : ",") << "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << slot->id
+             << ",\"args\":{\"name\":\"thread " << slot->id << "\"}}";
+        first = false;
+        for (const auto& event : slot->events)
+        {
+            json << ",\n{\"name\":\"" << phase_name(event.phase) << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << slot->id
+                 << ",\"ts\":" << event.begin_ns / 1e3 << ",\"dur\":" << event.length_ns / 1e3 << "}";
+        }
+        for (size_t p = 0; p < PHASE_COUNT; ++p)
+        {
+            phase_ns[p] += slot->phase_ns[p].load(std::memory_order_relaxed);
+        }
+        for (size_t c = 0; c < COUNTER_COUNT; ++c)
+        {
+            counters[c] += slot->counters[c].load(std::memory_order_relaxed);
+        }
+        dropped += slot->dropped;
+    }
+    json << "\n],\"otherData\":{";
+    json << std::setprecision(6);
+    for (size_t p = 0; p < PHASE_COUNT; ++p)
+    {
+        json << "\"" << PHASE_KEYS[p] << "\":" << phase_ns[p] / 1e9 << ",";
+    }
+    for (size_t c = 0; c < COUNTER_COUNT; ++c)
+    {
+        json << "\"" << COUNTER_NAMES[c] << "\":" << counters[c] << ",";
+    }
+    json << "\"dropped_events\":" << dropped << "}}\n";
+
+    file << json.str();
+    file.close();
+    if (!file)
+    {
+        error = "Could not write profile trace: " + path;
+        return false;
+    }
+    return true;
+}
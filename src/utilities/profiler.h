@@ -0,0 +1,189 @@
+/**
+ * @file profiler.h
+ * @brief Per-phase timers and counters behind the --profile report
+ * @author Le Nhan Pham
+ * @date 2025
+ *
+ * This header provides lightweight instrumentation of the hot paths, so a slow
+ * run can be attributed to directory listing, reading, parsing, sorting,
+ * writing or file moves, and to the time threads spend waiting for a file
+ * handle, for memory or for a shared lock.
+ *
+ * @section Cost
+ * Nothing is measured until start() is called: a disabled Scope is one relaxed
+ * atomic load. When enabled, every thread accumulates into its own slot (one
+ * cache line per thread, written only by its owner), so recording takes no
+ * lock and threads do not contend; the slots are summed when the report is
+ * printed.
+ *
+ * @section Output
+ * - --profile prints the per-phase times and the counters after the command
+ * - --profile-trace FILE also writes every timed scope as a Chrome trace
+ *   (chrome://tracing, Perfetto), with the phase totals (discovery_s, read_s,
+ *   ...) and the counters under "otherData"; the totals include scopes beyond
+ *   the per-thread event limit
+ *
+ * Phase times are summed over threads, so they can exceed the wall-clock
+ * time of the run. The wait phases are measured inside the phase that waits
+ * (a handle wait during a read is counted in both).
+ */
+
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <string>
+
+/**
+ * @class Profiler
+ * @brief Process-wide phase timers and counters
+ */
+class Profiler
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @enum Phase
+     * @brief Timed stages of a run
+     */
+    enum class Phase
+    {
+        DISCOVERY,    ///< Listing directories for log files
+        READ,         ///< Opening, mapping and reading files (including decompression)
+        PARSE,        ///< Scanning log content for values
+        SORT,         ///< Sorting results
+        FORMAT,       ///< Formatting and writing result tables and XYZ files
+        MOVES,        ///< Moving job files into their target directories
+        HANDLE_WAIT,  ///< Waiting for a FileHandleManager handle
+        MEMORY_WAIT,  ///< Waiting for a MemoryMonitor reservation
+        LOCK_WAIT,    ///< Waiting for a contended results/output lock
+        COUNT
+    };
+
+    /**
+     * @enum Counter
+     * @brief Event counts of a run
+     */
+    enum class Counter
+    {
+        BYTES_READ,        ///< Bytes read or mapped from logs
+        LINES_SCANNED,     ///< Lines handed to the value parsers
+        REGEX_FALLBACKS,   ///< Lookups that used std::regex instead of the anchor scanner
+        CACHE_HITS,        ///< File content cache hits (high-level commands)
+        CACHE_MISSES,      ///< File content cache misses
+        CACHE_OVERSIZED,   ///< Files the content cache handed out uncached because of their size
+        READAHEAD_HITS,    ///< Logs parsed from a Readahead buffer
+        READAHEAD_MISSES,  ///< Logs posted for read-ahead that the parsing thread read itself
+        TAIL_REJECTS,      ///< Logs a status filter rejected from their tail without a scan
+        COUNT
+    };
+
+    /**
+     * @brief Enable recording from now on
+     * @param trace Also keep every timed scope for write_trace()
+     */
+    static void start(bool trace = false);
+
+    /**
+     * @brief Whether recording is enabled
+     */
+    static bool enabled()
+    {
+        return enabled_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Add to a counter of the calling thread
+     */
+    static void add(Counter counter, uint64_t amount = 1);
+
+    /**
+     * @brief Add a timed interval to a phase of the calling thread
+     */
+    static void record(Phase phase, Clock::time_point begin, Clock::time_point end);
+
+    /**
+     * @brief Print the phase times and counters of all threads
+     */
+    static void report(std::ostream& out);
+
+    /**
+     * @brief Write the recorded scopes as a Chrome trace (JSON)
+     * @param path Output file
+     * @param error Set to a description when the file cannot be written
+     * @return true on success
+     */
+    static bool write_trace(const std::string& path, std::string& error);
+
+    /**
+     * @brief Display name of a phase
+     */
+    static const char* phase_name(Phase phase);
+
+    /**
+     * @class Scope
+     * @brief Times a block and adds it to a phase when the block ends
+     */
+    class Scope
+    {
+    public:
+        /**
+         * @param phase Phase the block belongs to
+         * @param active Time the block only if true (and recording is enabled)
+         */
+        explicit Scope(Phase phase, bool active = true) : phase_(phase), active_(active && enabled())
+        {
+            if (active_)
+            {
+                begin_ = Clock::now();
+            }
+        }
+
+        ~Scope()
+        {
+            if (active_)
+            {
+                record(phase_, begin_, Clock::now());
+            }
+        }
+
+        Scope(const Scope&)            = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        Phase             phase_;   ///< Phase the block belongs to
+        bool              active_;  ///< Whether the block is being timed
+        Clock::time_point begin_;   ///< Start of the block
+    };
+
+    /**
+     * @brief Lock a mutex, timing the wait when it is contended
+     *
+     * An uncontended lock is taken with try_lock() and not timed, so the
+     * LOCK_WAIT phase counts only the acquisitions that had to wait.
+     */
+    template <typename Mutex>
+    static std::unique_lock<Mutex> lock(Mutex& mutex)
+    {
+        if (!enabled())
+        {
+            return std::unique_lock<Mutex>(mutex);
+        }
+        if (mutex.try_lock())
+        {
+            return std::unique_lock<Mutex>(mutex, std::adopt_lock);
+        }
+        Scope wait(Phase::LOCK_WAIT);
+        return std::unique_lock<Mutex>(mutex);
+    }
+
+private:
+    static std::atomic<bool> enabled_;  ///< Recording switched on by start()
+};
+
+#endif  // PROFILER_H
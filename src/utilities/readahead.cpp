@@ -0,0 +1,331 @@
+#include "readahead.h"
+#include "extraction/gaussian_extractor.h"
+#include "utilities/compressed_input.h"
+#include "utilities/profiler.h"
+#include "utilities/utils.h"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <stdexcept>
+
+#ifdef _WIN32
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+extern std::atomic<bool> g_shutdown_requested;
+
+// Read-ahead of this many files keeps a parallel file system busy without holding many large buffers
+static const size_t NETWORK_FS_DEPTH = 16;
+
+// Upper bound for --io-depth; each file read ahead is one I/O thread
+static const size_t MAX_DEPTH = 256;
+
+Readahead::Buffer::~Buffer()
+{
+    release();
+}
+
+Readahead::Buffer::Buffer(Buffer&& other) noexcept
+    : content_(std::move(other.content_)), memory_(other.memory_), charged_(other.charged_)
+{
+    other.memory_  = nullptr;
+    other.charged_ = 0;
+}
+
+Readahead::Buffer& Readahead::Buffer::operator=(Buffer&& other) noexcept
+{
+    if (this != &other)
+    {
+        release();
+        content_       = std::move(other.content_);
+        memory_        = other.memory_;
+        charged_       = other.charged_;
+        other.memory_  = nullptr;
+        other.charged_ = 0;
+    }
+    return *this;
+}
+
+void Readahead::Buffer::release()
+{
+    if (memory_)
+    {
+        memory_->remove_usage(charged_);
+        memory_  = nullptr;
+        charged_ = 0;
+    }
+    std::string().swap(content_);
+}
+
+Readahead::Readahead(size_t depth, MemoryMonitor* memory)
+    : memory_(memory), depth_(std::min(std::max<size_t>(depth, 1), MAX_DEPTH))
+{
+    threads_.reserve(depth_);
+    for (size_t i = 0; i < depth_; ++i)
+    {
+        threads_.emplace_back(&Readahead::io_loop, this);
+    }
+}
+
+Readahead::~Readahead()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    work_ready_.notify_all();
+    read_done_.notify_all();
+    for (auto& thread : threads_)
+    {
+        thread.join();
+    }
+}
+
+void Readahead::post(const std::string& path, uintmax_t size)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Slot&                       slot = slots_[path];
+        slot.state                       = State::QUEUED;
+        slot.size                        = size;
+        queue_.push_back(path);
+    }
+    work_ready_.notify_one();
+}
+
+bool Readahead::take(const std::string& path, Buffer& buffer)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    auto                         it = slots_.find(path);
+    if (it == slots_.end())
+    {
+        ++misses_;
+        Profiler::add(Profiler::Counter::READAHEAD_MISSES);
+        return false;
+    }
+
+    // Not started yet: the caller is about to read it anyway, so the I/O threads skip it
+    if (it->second.state == State::QUEUED)
+    {
+        slots_.erase(it);
+        ++misses_;
+        Profiler::add(Profiler::Counter::READAHEAD_MISSES);
+        return false;
+    }
+
+    read_done_.wait(lock, [this, &path] {
+        auto slot = slots_.find(path);
+        return stopping_ || slot == slots_.end() || slot->second.state != State::READING;
+    });
+
+    it = slots_.find(path);
+    if (it == slots_.end() || it->second.state != State::READY)
+    {
+        if (it != slots_.end())
+        {
+            slots_.erase(it);
+        }
+        ++misses_;
+        Profiler::add(Profiler::Counter::READAHEAD_MISSES);
+        return false;
+    }
+
+    buffer = std::move(it->second.buffer);
+    slots_.erase(it);
+    --in_flight_;
+    ++hits_;
+    Profiler::add(Profiler::Counter::READAHEAD_HITS);
+    lock.unlock();
+    work_ready_.notify_one();
+    return true;
+}
+
+size_t Readahead::hit_count() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return hits_;
+}
+
+size_t Readahead::miss_count() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return misses_;
+}
+
+size_t Readahead::auto_depth(const std::string& directory)
+{
+    return Utils::on_network_file_system(directory) ? NETWORK_FS_DEPTH : 0;
+}
+
+void Readahead::io_loop()
+{
+    while (true)
+    {
+        std::string path;
+        uintmax_t   size = 0;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            work_ready_.wait(lock, [this] {
+                return stopping_ || (!queue_.empty() && in_flight_ < depth_);
+            });
+            if (stopping_)
+            {
+                return;
+            }
+
+            path = std::move(queue_.front());
+            queue_.pop_front();
+            auto it = slots_.find(path);
+            if (it == slots_.end() || it->second.state != State::QUEUED)
+            {
+                continue;  // Withdrawn by take()
+            }
+            it->second.state = State::READING;
+            size             = it->second.size;
+            ++in_flight_;
+        }
+
+        // Files that do not fit the memory limit now are left to the parsing thread's own reservation
+        Buffer buffer;
+        bool   filled = false;
+        if (!g_shutdown_requested.load() && (!memory_ || memory_->can_allocate(static_cast<size_t>(size))))
+        {
+            if (memory_)
+            {
+                buffer.memory_  = memory_;
+                buffer.charged_ = static_cast<size_t>(size);
+                memory_->add_usage(buffer.charged_);
+            }
+            try
+            {
+                filled = read_file(path, buffer.content_);
+            }
+            catch (const std::exception&)
+            {
+                filled = false;
+            }
+
+            // Decompressed logs are larger than the file on disk
+            if (filled && memory_ && buffer.content_.size() > buffer.charged_)
+            {
+                memory_->add_usage(buffer.content_.size() - buffer.charged_);
+                buffer.charged_ = buffer.content_.size();
+            }
+        }
+        if (!filled)
+        {
+            buffer.release();
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto                        it = slots_.find(path);
+            if (it != slots_.end() && filled)
+            {
+                it->second.buffer = std::move(buffer);
+                it->second.state  = State::READY;
+            }
+            else
+            {
+                if (it != slots_.end())
+                {
+                    it->second.state = State::FAILED;
+                }
+                --in_flight_;
+            }
+        }
+        read_done_.notify_all();
+        if (!filled)
+        {
+            work_ready_.notify_one();
+        }
+    }
+}
+
+bool Readahead::read_file(const std::string& path, std::string& content)
+{
+    Profiler::Scope read(Profiler::Phase::READ);
+    if (CompressedInput::is_compressed(path))
+    {
+        content = CompressedInput::read_all(path);
+        Profiler::add(Profiler::Counter::BYTES_READ, content.size());
+        return true;
+    }
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(),
+                              GENERIC_READ,
+                              FILE_SHARE_READ | FILE_SHARE_WRITE,
+                              nullptr,
+                              OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+                              nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size))
+    {
+        CloseHandle(file);
+        return false;
+    }
+    content.resize(static_cast<size_t>(size.QuadPart));
+    size_t done = 0;
+    while (done < content.size())
+    {
+        DWORD chunk = static_cast<DWORD>(std::min<size_t>(content.size() - done, 1u << 30));
+        DWORD got   = 0;
+        if (!ReadFile(file, &content[done], chunk, &got, nullptr) || got == 0)
+        {
+            break;
+        }
+        done += got;
+    }
+    CloseHandle(file);
+#else
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0)
+    {
+        close(fd);
+        return false;
+    }
+
+    // Announce the whole file so the client fetches it with many requests in flight, not block by block
+    #if defined(POSIX_FADV_WILLNEED)
+    posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+    posix_fadvise(fd, 0, 0, POSIX_FADV_WILLNEED);
+    #endif
+
+    content.resize(static_cast<size_t>(info.st_size));
+    size_t done = 0;
+    while (done < content.size())
+    {
+        ssize_t got = ::read(fd, &content[done], content.size() - done);
+        if (got < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (got <= 0)
+        {
+            break;
+        }
+        done += static_cast<size_t>(got);
+    }
+    close(fd);
+#endif
+
+    // A log that shrank while it was read is scanned as far as it was read; one that grew, as it was at open
+    content.resize(done);
+    Profiler::add(Profiler::Counter::BYTES_READ, done);
+    return true;
+}
@@ -0,0 +1,193 @@
+/**
+ * @file readahead.h
+ * @brief Reads logs ahead of the parsing threads
+ * @author Le Nhan Pham
+ * @date 2025
+ *
+ * This header provides the read-ahead queue used by extract. As the directory
+ * walk discovers logs, their paths are posted to the queue, and a separate set
+ * of I/O threads reads the next files into memory while the parsing threads
+ * are still busy with earlier ones. A parsing thread that reaches a file takes
+ * its filled buffer instead of opening the file, so storage latency overlaps
+ * with parsing.
+ *
+ * @section Queue Depth
+ * The depth is the number of files read ahead at once, and therefore the
+ * number of I/O threads and of buffers that are filled or being filled. It is
+ * independent of the parsing thread count: on Lustre or GPFS a handful of
+ * parsing threads can keep 16 or 32 reads in flight. The I/O threads do not
+ * take FileHandleManager handles; each holds at most one open file.
+ *
+ * @section I/O Backend
+ * - Linux/POSIX: the whole file is announced with posix_fadvise(SEQUENTIAL,
+ *   WILLNEED), so the kernel (and the Lustre/NFS client) issues the read-ahead
+ *   for all of it at once, then read into the buffer
+ * - Windows: CreateFile with FILE_FLAG_SEQUENTIAL_SCAN and ReadFile
+ * - Compressed logs are decompressed into the buffer by CompressedInput
+ *
+ * Each I/O thread keeps one blocking read in flight, so the depth is the queue
+ * depth seen by the file system, without an io_uring or overlapped-I/O
+ * dependency.
+ *
+ * @section Memory
+ * Buffers are charged to the MemoryMonitor with add_usage() while they are
+ * held, the way caches are. A file is read ahead only if can_allocate() admits
+ * it; otherwise it is left to the parsing thread, which reads it itself under
+ * its own reservation. Read-ahead therefore never makes a parsing thread wait.
+ */
+
+#ifndef READAHEAD_H
+#define READAHEAD_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+class MemoryMonitor;
+
+/**
+ * @class Readahead
+ * @brief Queue of logs read into memory by dedicated I/O threads
+ *
+ * Thread-safe: post() is called by the discovering thread, take() by any
+ * parsing thread. Destroying the queue stops the I/O threads after their
+ * current read.
+ */
+class Readahead
+{
+public:
+    /**
+     * @class Buffer
+     * @brief Content of one log read ahead; returns its bytes to the monitor when destroyed
+     */
+    class Buffer
+    {
+    public:
+        Buffer() = default;
+        ~Buffer();
+
+        Buffer(const Buffer&)            = delete;
+        Buffer& operator=(const Buffer&) = delete;
+        Buffer(Buffer&& other) noexcept;
+        Buffer& operator=(Buffer&& other) noexcept;
+
+        /**
+         * @brief The whole log content
+         */
+        std::string_view view() const
+        {
+            return content_;
+        }
+
+    private:
+        friend class Readahead;
+
+        void release();
+
+        std::string    content_;            ///< Log content
+        MemoryMonitor* memory_  = nullptr;  ///< Monitor charged with the content's bytes
+        size_t         charged_ = 0;        ///< Bytes charged
+    };
+
+    /**
+     * @brief Start the I/O threads
+     * @param depth Number of files read ahead at once (I/O threads); at least 1
+     * @param memory Monitor charged for the buffers (nullptr = not accounted)
+     */
+    Readahead(size_t depth, MemoryMonitor* memory);
+
+    /**
+     * @brief Stop the I/O threads and drop unclaimed buffers
+     */
+    ~Readahead();
+
+    Readahead(const Readahead&)            = delete;
+    Readahead& operator=(const Readahead&) = delete;
+
+    /**
+     * @brief Queue a log to be read ahead
+     * @param path Path as it will be passed to take()
+     * @param size File size on disk, used for the memory check
+     */
+    void post(const std::string& path, uintmax_t size);
+
+    /**
+     * @brief Take the content of a log that was posted
+     * @param path Path given to post()
+     * @param buffer Receives the content when the log was read ahead
+     * @return true if @p buffer holds the content; false if the caller must read the file itself
+     *
+     * Waits while the log is being read. A log still waiting in the queue is
+     * withdrawn and left to the caller, as are logs that failed to read or did
+     * not fit the memory limit.
+     */
+    bool take(const std::string& path, Buffer& buffer);
+
+    /**
+     * @brief Number of take() calls served from a buffer
+     */
+    size_t hit_count() const;
+
+    /**
+     * @brief Number of take() calls the caller had to read itself
+     */
+    size_t miss_count() const;
+
+    /**
+     * @brief Default depth for logs in a directory
+     * @param directory Directory the logs are read from
+     * @return 16 on network and parallel file systems (Lustre, GPFS, NFS, SMB, FUSE), 0 (off) otherwise
+     *
+     * Local disks are read through memory maps, which the page cache already
+     * reads ahead; a copy into a buffer would only add work there.
+     */
+    static size_t auto_depth(const std::string& directory);
+
+private:
+    /**
+     * @enum State
+     * @brief Progress of one posted log
+     */
+    enum class State
+    {
+        QUEUED,   ///< Waiting for an I/O thread
+        READING,  ///< Being read
+        READY,    ///< Buffer filled
+        FAILED    ///< Not read ahead (read error or memory limit); the parsing thread reads it
+    };
+
+    /**
+     * @struct Slot
+     * @brief One posted log
+     */
+    struct Slot
+    {
+        State     state = State::QUEUED;
+        uintmax_t size  = 0;
+        Buffer    buffer;
+    };
+
+    void io_loop();
+    bool read_file(const std::string& path, std::string& content);
+
+    MemoryMonitor*                        memory_;            ///< Monitor charged for buffers (may be null)
+    size_t                                depth_;             ///< Files read ahead at once
+    mutable std::mutex                    mutex_;             ///< Guards the members below
+    std::condition_variable               work_ready_;        ///< Wakes I/O threads: new path or free slot
+    std::condition_variable               read_done_;         ///< Wakes take(): a read finished
+    std::deque<std::string>               queue_;             ///< Posted paths in discovery order
+    std::unordered_map<std::string, Slot> slots_;             ///< Posted logs not yet taken
+    size_t                                in_flight_ = 0;     ///< Slots READING or READY
+    size_t                                hits_      = 0;     ///< take() calls served from a buffer
+    size_t                                misses_    = 0;     ///< take() calls left to the caller
+    bool                                  stopping_  = false; ///< Set by the destructor
+    std::vector<std::thread>              threads_;           ///< I/O threads
+};
+
+#endif  // READAHEAD_H
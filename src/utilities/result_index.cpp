@@ -0,0 +1,340 @@
+/**
+ * @file result_index.cpp
+ * @brief Implementation of the persistent on-disk result index
+ * @author Le Nhan Pham
+ * @date 2025
+ */
+
+#include "result_index.h"
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+#ifndef _WIN32
+    #include <sys/stat.h>
+#endif
+
+namespace
+{
+    /**
+     * @brief First line of every index file; bump the version when a section's field layout changes
+     */
+    const char* const INDEX_HEADER = "# gaussian_extractor result index v1";
+
+    std::string make_key(const std::string& section, const std::string& path)
+    {
+        return section + '\t' + path;
+    }
+
+    std::vector<std::string> split_tabs(const std::string& line)
+    {
+        std::vector<std::string> parts;
+        size_t                   start = 0;
+        while (true)
+        {
+            size_t tab = line.find('\t', start);
+            parts.push_back(line.substr(start, tab == std::string::npos ? std::string::npos : tab - start));
+            if (tab == std::string::npos)
+            {
+                break;
+            }
+            start = tab + 1;
+        }
+        return parts;
+    }
+
+    bool parse_unsigned(const std::string& text, unsigned long long& value)
+    {
+        try
+        {
+            size_t pos = 0;
+            value      = std::stoull(text, &pos);
+            return pos == text.size();
+        }
+        catch (const std::exception&)
+        {
+            return false;
+        }
+    }
+
+    bool parse_signed(const std::string& text, long long& value)
+    {
+        try
+        {
+            size_t pos = 0;
+            value      = std::stoll(text, &pos);
+            return pos == text.size();
+        }
+        catch (const std::exception&)
+        {
+            return false;
+        }
+    }
+}  // namespace
+
+// =============================================================================
+// FileStamp Implementation
+// =============================================================================
+
+bool FileStamp::from_path(const std::string& path, FileStamp& stamp)
+{
+#ifndef _WIN32
+    struct stat st;
+    if (::stat(path.c_str(), &st) != 0 || !S_ISREG(st.st_mode))
+    {
+        return false;
+    }
+    stamp.size = static_cast<uintmax_t>(st.st_size);
+    #ifdef __APPLE__
+    stamp.mtime_ns = static_cast<long long>(st.st_mtimespec.tv_sec) * 1000000000LL + st.st_mtimespec.tv_nsec;
+    #else
+    stamp.mtime_ns = static_cast<long long>(st.st_mtim.tv_sec) * 1000000000LL + st.st_mtim.tv_nsec;
+    #endif
+    stamp.inode = static_cast<uint64_t>(st.st_ino);
+    return true;
+#else
+    std::error_code ec;
+    stamp.size = std::filesystem::file_size(path, ec);
+    if (ec)
+    {
+        return false;
+    }
+    auto mtime = std::filesystem::last_write_time(path, ec);
+    if (ec)
+    {
+        return false;
+    }
+    stamp.mtime_ns = static_cast<long long>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(mtime.time_since_epoch()).count());
+    stamp.inode = 0;
+    return true;
+#endif
+}
+
+std::string FileStamp::to_string() const
+{
+    return std::to_string(size) + ":" + std::to_string(mtime_ns) + ":" + std::to_string(inode);
+}
+
+// =============================================================================
+// ResultIndex Implementation
+// =============================================================================
+
+ResultIndex::ResultIndex(const std::string& index_path) : index_path_(index_path), dirty_(false), hits_(0), misses_(0)
+{}
+
+bool ResultIndex::load()
+{
+    std::ifstream file(index_path_);
+    if (!file.is_open())
+    {
+        return false;
+    }
+
+    std::string line;
+    if (!std::getline(file, line) || line != INDEX_HEADER)
+    {
+        // Unknown layout: start from scratch and replace the file on save
+        std::lock_guard<std::mutex> lock(mutex_);
+        dirty_ = true;
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    while (std::getline(file, line))
+    {
+        std::vector<std::string> parts = split_tabs(line);
+        if (parts.size() < 5)
+        {
+            dirty_ = true;  // Drop malformed lines
+            continue;
+        }
+
+        Entry              entry;
+        unsigned long long size  = 0;
+        unsigned long long inode = 0;
+        long long          mtime = 0;
+        if (!parse_unsigned(parts[1], size) || !parse_signed(parts[2], mtime) || !parse_unsigned(parts[3], inode))
+        {
+            dirty_ = true;
+            continue;
+        }
+        entry.stamp.size     = static_cast<uintmax_t>(size);
+        entry.stamp.mtime_ns = mtime;
+        entry.stamp.inode    = static_cast<uint64_t>(inode);
+        entry.fields.assign(parts.begin() + 5, parts.end());
+        entry.touched = false;
+
+        entries_[make_key(parts[0], parts[4])] = std::move(entry);
+    }
+    return true;
+}
+
+bool ResultIndex::save()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    // Forget logs that were not seen again by the sections used in this run
+    for (auto it = entries_.begin(); it != entries_.end();)
+    {
+        std::string section = it->first.substr(0, it->first.find('\t'));
+        if (!it->second.touched && active_sections_.count(section))
+        {
+            it     = entries_.erase(it);
+            dirty_ = true;
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    if (!dirty_)
+    {
+        return true;
+    }
+
+    std::string   temp_path = index_path_ + ".tmp";
+    std::ofstream file(temp_path, std::ios::trunc);
+    if (!file.is_open())
+    {
+        return false;
+    }
+
+    file << INDEX_HEADER << '\n';
+    for (const auto& [key, entry] : entries_)
+    {
+        size_t tab = key.find('\t');
+        file << key.substr(0, tab) << '\t' << entry.stamp.size << '\t' << entry.stamp.mtime_ns << '\t'
+             << entry.stamp.inode << '\t' << key.substr(tab + 1);
+        for (const auto& field : entry.fields)
+        {
+            file << '\t' << field;
+        }
+        file << '\n';
+    }
+    file.close();
+    if (!file)
+    {
+        std::remove(temp_path.c_str());
+        return false;
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(temp_path, index_path_, ec);
+    if (ec)
+    {
+        std::remove(temp_path.c_str());
+        return false;
+    }
+
+    dirty_ = false;
+    return true;
+}
+
+void ResultIndex::begin_run()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& [key, entry] : entries_)
+    {
+        entry.touched = false;
+    }
+    active_sections_.clear();
+    hits_   = 0;
+    misses_ = 0;
+}
+
+void ResultIndex::set_stamp_source(std::function<bool(const std::string& path, FileStamp& stamp)> source)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    stamp_source_ = std::move(source);
+}
+
+bool ResultIndex::lookup(const std::string&        section,
+                         const std::string&        path,
+                         FileStamp&                stamp,
+                         std::vector<std::string>& fields)
+{
+    bool have_stamp = stamp_source_ ? stamp_source_(path, stamp) : FileStamp::from_path(path, stamp);
+    if (!have_stamp)
+    {
+        stamp = FileStamp();
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    active_sections_.insert(section);
+
+    auto it = entries_.find(make_key(section, path));
+    if (it != entries_.end())
+    {
+        if (have_stamp && it->second.stamp == stamp)
+        {
+            it->second.touched = true;
+            fields             = it->second.fields;
+            hits_++;
+            return true;
+        }
+
+        // Stale entry: the file changed or disappeared
+        entries_.erase(it);
+        dirty_ = true;
+    }
+
+    misses_++;
+    return false;
+}
+
+void ResultIndex::store(const std::string&       section,
+                        const std::string&       path,
+                        const FileStamp&         stamp,
+                        std::vector<std::string> fields)
+{
+    if (stamp.mtime_ns == 0 || path.find_first_of("\t\r\n") != std::string::npos)
+    {
+        return;  // File could not be stamped, or path not representable in the line format
+    }
+
+    for (auto& field : fields)
+    {
+        for (auto& c : field)
+        {
+            if (c == '\t' || c == '\n' || c == '\r')
+            {
+                c = ' ';
+            }
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    active_sections_.insert(section);
+
+    Entry& entry  = entries_[make_key(section, path)];
+    entry.stamp   = stamp;
+    entry.fields  = std::move(fields);
+    entry.touched = true;
+    dirty_        = true;
+}
+
+std::string ResultIndex::format_double(double value)
+{
+    std::ostringstream oss;
+    oss.precision(17);
+    oss << value;
+    return oss.str();
+}
+
+bool ResultIndex::parse_double(const std::string& text, double& value)
+{
+    try
+    {
+        size_t pos = 0;
+        value      = std::stod(text, &pos);
+        return pos == text.size();
+    }
+    catch (const std::exception&)
+    {
+        return false;
+    }
+}
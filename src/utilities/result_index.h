@@ -0,0 +1,209 @@
+/**
+ * @file result_index.h
+ * @brief Persistent on-disk index of per-file parse results
+ * @author Le Nhan Pham
+ * @date 2025
+ *
+ * This header provides the incremental result cache shared by extract, the job
+ * checkers and the high-level energy calculator. Results are stored in a
+ * plain-text file (.gaussian_extractor.idx by default) in the working
+ * directory and keyed by path together with file size, modification time and
+ * inode, so a later run only re-parses logs that are new or have changed.
+ *
+ * @section Stored Values
+ * Every module stores the raw values it extracted from a log, never values
+ * derived from command-line options. Temperature, concentration and phase
+ * corrections are applied after a lookup exactly as after a fresh parse.
+ *
+ * @section File Format
+ * One entry per line, tab separated:
+ * @code
+ * section  size  mtime_ns  inode  path  field1  field2 ...
+ * @endcode
+ * The first line is a version header; files with any other header are ignored
+ * and rewritten. The index is written to a temporary file and renamed into
+ * place so an interrupted run never leaves a truncated index behind.
+ *
+ * @section Sessions
+ * An interactive session (see SessionState) keeps one index in memory for all
+ * of its commands: begin_run() starts each command, and the stamps come from
+ * the session's directory listing instead of a stat of every log.
+ *
+ * @section Thread Safety
+ * lookup() and store() may be called concurrently from worker threads.
+ */
+
+#ifndef RESULT_INDEX_H
+#define RESULT_INDEX_H
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Default result index file name, created in the working directory
+ */
+const std::string RESULT_INDEX_FILENAME = ".gaussian_extractor.idx";
+
+/**
+ * @struct FileStamp
+ * @brief Identity of a file's content as seen by the file system
+ */
+struct FileStamp
+{
+    uintmax_t size     = 0;  ///< File size in bytes
+    long long mtime_ns = 0;  ///< Last modification time (nanoseconds since epoch)
+    uint64_t  inode    = 0;  ///< Inode number (0 where not available)
+
+    /**
+     * @brief Read the stamp of a file
+     * @param path Path to the file
+     * @param stamp Receives the stamp
+     * @return true if the file exists and could be inspected
+     */
+    static bool from_path(const std::string& path, FileStamp& stamp);
+
+    /**
+     * @brief Compact "size:mtime:inode" form, used to embed dependency stamps
+     */
+    std::string to_string() const;
+
+    bool operator==(const FileStamp& other) const
+    {
+        return size == other.size && mtime_ns == other.mtime_ns && inode == other.inode;
+    }
+};
+
+/**
+ * @class ResultIndex
+ * @brief Thread-safe persistent map from (section, path, stamp) to stored fields
+ *
+ * A section names the producer of an entry ("extract", "check", "high") so the
+ * same log can be indexed by several commands. Entries of a section that was
+ * used during a run but not looked up or stored again (deleted or moved logs)
+ * are dropped when the index is saved.
+ */
+class ResultIndex
+{
+public:
+    /**
+     * @brief Create an empty index bound to a file
+     * @param index_path Path of the index file
+     */
+    explicit ResultIndex(const std::string& index_path = RESULT_INDEX_FILENAME);
+
+    /**
+     * @brief Load entries from the index file
+     * @return true if an index was read, false if missing or incompatible
+     */
+    bool load();
+
+    /**
+     * @brief Write the index file if anything changed
+     * @return true on success or when nothing needed writing
+     */
+    bool save();
+
+    /**
+     * @brief Start another run with the entries in memory (interactive sessions)
+     *
+     * Resets the hit and miss counts and what save() considers seen, so the
+     * next save() drops exactly the logs this run did not see again.
+     */
+    void begin_run();
+
+    /**
+     * @brief Where lookup() takes the stamps of files from (default: FileStamp::from_path)
+     * @param source Fills the stamp of a path and returns false if the file cannot be inspected;
+     *               called concurrently from worker threads
+     */
+    void set_stamp_source(std::function<bool(const std::string& path, FileStamp& stamp)> source);
+
+    /**
+     * @brief Look up stored fields for a file
+     * @param section Producer of the entry
+     * @param path Path of the log file
+     * @param stamp Receives the current stamp of the file (pass it to store());
+     *              reset to an empty stamp, which store() ignores, if the file cannot be inspected
+     * @param fields Receives the stored fields on a hit
+     * @return true if an entry with a matching stamp exists
+     *
+     * Take the stamp before parsing: a file modified while it is being parsed
+     * then no longer matches its entry on the next run.
+     */
+    bool lookup(const std::string&        section,
+                const std::string&        path,
+                FileStamp&                stamp,
+                std::vector<std::string>& fields);
+
+    /**
+     * @brief Store fields for a file
+     * @param section Producer of the entry
+     * @param path Path of the log file
+     * @param stamp Stamp returned by the preceding lookup()
+     * @param fields Values to store; tabs and newlines are replaced by spaces
+     */
+    void store(const std::string&       section,
+               const std::string&       path,
+               const FileStamp&         stamp,
+               std::vector<std::string> fields);
+
+    /**
+     * @brief Number of successful lookups
+     */
+    size_t hit_count() const
+    {
+        return hits_.load();
+    }
+
+    /**
+     * @brief Number of failed lookups
+     */
+    size_t miss_count() const
+    {
+        return misses_.load();
+    }
+
+    /**
+     * @brief Path of the index file
+     */
+    const std::string& path() const
+    {
+        return index_path_;
+    }
+
+    /**
+     * @brief Format a double so that parse_double() restores it exactly
+     */
+    static std::string format_double(double value);
+
+    /**
+     * @brief Parse a field written by format_double()
+     * @return true if the whole field was a number
+     */
+    static bool parse_double(const std::string& text, double& value);
+
+private:
+    struct Entry
+    {
+        FileStamp                stamp;    ///< Stamp of the file when it was parsed
+        std::vector<std::string> fields;   ///< Stored values
+        bool                     touched;  ///< Looked up or stored during this run
+    };
+
+    std::string                                         index_path_;       ///< Index file location
+    mutable std::mutex                                  mutex_;            ///< Guards entries_, active_sections_, dirty_
+    std::unordered_map<std::string, Entry>              entries_;          ///< Keyed by section + '\t' + path
+    std::set<std::string>                               active_sections_;  ///< Sections used during this run
+    bool                                                dirty_;            ///< Whether save() has anything to write
+    std::atomic<size_t>                                 hits_;             ///< Lookup hits
+    std::atomic<size_t>                                 misses_;           ///< Lookup misses
+    std::function<bool(const std::string&, FileStamp&)> stamp_source_;     ///< Stamps of files (empty = from_path)
+};
+
+#endif  // RESULT_INDEX_H
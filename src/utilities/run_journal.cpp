@@ -0,0 +1,283 @@
+/**
+ * @file run_journal.cpp
+ * @brief Implementation of the --resume journal
+ * @author Le Nhan Pham
+ * @date 2025
+ */
+
+#include "run_journal.h"
+#include <filesystem>
+#include <system_error>
+
+#ifdef _WIN32
+    #include <io.h>
+#else
+    #include <unistd.h>
+#endif
+
+namespace
+{
+    /**
+     * @brief Start of every header payload; bump the version when a record or payload layout changes
+     */
+    const char* const JOURNAL_MAGIC = "GXJRNL01";
+
+    const size_t RECORD_HEADER_SIZE = RunJournal::RECORD_SIZE - RunJournal::PAYLOAD_SIZE;
+
+    /**
+     * @brief Write batches at least this often, so a slow run does not keep its last results in memory
+     */
+    const std::chrono::seconds MAX_BATCH_AGE(2);
+
+    uint32_t checksum(const char* data, size_t size)
+    {
+        uint32_t hash = 2166136261u;
+        for (size_t i = 0; i < size; ++i)
+        {
+            hash ^= static_cast<unsigned char>(data[i]);
+            hash *= 16777619u;
+        }
+        return hash;
+    }
+
+    /**
+     * @brief Fixed part of a record, in front of its payload
+     */
+    struct RecordHeader
+    {
+        uint32_t checksum;
+        uint16_t type;
+        uint16_t length;
+        uint32_t index;
+        uint32_t count;
+    };
+    static_assert(sizeof(RecordHeader) == RECORD_HEADER_SIZE, "record header must be 16 bytes");
+
+    void encode_entry(std::vector<char>& records, RunJournal::EntryType type, std::string_view payload)
+    {
+        size_t count =
+            payload.empty() ? 1 : (payload.size() + RunJournal::PAYLOAD_SIZE - 1) / RunJournal::PAYLOAD_SIZE;
+        for (size_t index = 0; index < count; ++index)
+        {
+            std::string_view part = payload.substr(index * RunJournal::PAYLOAD_SIZE, RunJournal::PAYLOAD_SIZE);
+
+            char         record[RunJournal::RECORD_SIZE] = {};
+            RecordHeader header;
+            header.checksum = 0;
+            header.type     = static_cast<uint16_t>(type);
+            header.length   = static_cast<uint16_t>(part.size());
+            header.index    = static_cast<uint32_t>(index);
+            header.count    = static_cast<uint32_t>(count);
+            std::memcpy(record, &header, sizeof(header));
+            std::memcpy(record + RECORD_HEADER_SIZE, part.data(), part.size());
+
+            header.checksum = checksum(record + sizeof(uint32_t), RunJournal::RECORD_SIZE - sizeof(uint32_t));
+            std::memcpy(record, &header.checksum, sizeof(uint32_t));
+            records.insert(records.end(), record, record + RunJournal::RECORD_SIZE);
+        }
+    }
+}  // namespace
+
+// =============================================================================
+// RunJournal Implementation
+// =============================================================================
+
+std::string RunJournal::path_for(const std::string& command)
+{
+    return ".gaussian_extractor." + command + ".journal";
+}
+
+RunJournal::RunJournal(const std::string& path, size_t batch_records)
+    : path_(path),
+      batch_records_(batch_records > 0 ? batch_records : 1),
+      file_(nullptr),
+      next_entry_(0),
+      appended_(0),
+      last_write_(std::chrono::steady_clock::now()),
+      discarded_(false)
+{}
+
+RunJournal::~RunJournal()
+{
+    if (file_)
+    {
+        flush();
+        std::fclose(file_);
+    }
+}
+
+void RunJournal::put_string(std::string& payload, std::string_view text)
+{
+    put(payload, static_cast<uint32_t>(text.size()));
+    payload.append(text.data(), text.size());
+}
+
+bool RunJournal::get_string(std::string_view& payload, std::string& text)
+{
+    uint32_t size = 0;
+    if (!get(payload, size) || payload.size() < size)
+    {
+        return false;
+    }
+    text.assign(payload.data(), size);
+    payload.remove_prefix(size);
+    return true;
+}
+
+bool RunJournal::read_existing(const std::string& header, uint64_t& valid_bytes)
+{
+    valid_bytes     = 0;
+    std::FILE* file = std::fopen(path_.c_str(), "rb");
+    if (!file)
+    {
+        return false;
+    }
+
+    // Entries are read up to the first record that is damaged or out of place; a killed run can only have cut
+    // its last batch short, so everything after that point is dropped
+    std::vector<Entry> entries;
+    Entry              entry;
+    uint32_t           next_index = 0;  // Index the next record must have (0 = a new entry)
+    uint32_t           count      = 0;  // Records of the entry being read
+    uint64_t           offset     = 0;
+    char               record[RECORD_SIZE];
+    while (std::fread(record, 1, RECORD_SIZE, file) == RECORD_SIZE)
+    {
+        RecordHeader fields;
+        std::memcpy(&fields, record, sizeof(fields));
+        if (fields.checksum != checksum(record + sizeof(uint32_t), RECORD_SIZE - sizeof(uint32_t)) ||
+            fields.length > PAYLOAD_SIZE || fields.index != next_index || fields.index >= fields.count)
+        {
+            break;
+        }
+        if (fields.index == 0)
+        {
+            entry.type   = static_cast<EntryType>(fields.type);
+            entry.number = entries.size();
+            entry.payload.clear();
+            count = fields.count;
+        }
+        else if (static_cast<uint16_t>(entry.type) != fields.type || fields.count != count)
+        {
+            break;
+        }
+        entry.payload.append(record + RECORD_HEADER_SIZE, fields.length);
+        offset += RECORD_SIZE;
+        next_index = fields.index + 1;
+        if (next_index == count)
+        {
+            entries.push_back(std::move(entry));
+            entry       = Entry();
+            next_index  = 0;
+            valid_bytes = offset;
+        }
+    }
+    std::fclose(file);
+
+    if (entries.empty() || entries.front().type != EntryType::HEADER || entries.front().payload != header)
+    {
+        discarded_  = !entries.empty();
+        valid_bytes = 0;
+        return false;
+    }
+    recovered_.assign(std::make_move_iterator(entries.begin() + 1), std::make_move_iterator(entries.end()));
+    return true;
+}
+
+bool RunJournal::open(const std::string& signature, std::string& error)
+{
+    std::string header = JOURNAL_MAGIC + signature;
+    uint64_t    valid  = 0;
+    if (read_existing(header, valid))
+    {
+        // Continue after the last complete entry
+        std::error_code ec;
+        std::filesystem::resize_file(path_, valid, ec);
+        file_ = ec ? nullptr : std::fopen(path_.c_str(), "ab");
+        if (!file_)
+        {
+            error = "Could not continue journal " + path_;
+            return false;
+        }
+        next_entry_ = recovered_.size() + 1;
+        return true;
+    }
+
+    file_ = std::fopen(path_.c_str(), "wb");
+    if (!file_)
+    {
+        error = "Could not create journal " + path_;
+        return false;
+    }
+    append(EntryType::HEADER, header);
+    appended_ = 0;
+    if (!flush())
+    {
+        error = "Could not write journal " + path_;
+        return false;
+    }
+    return true;
+}
+
+bool RunJournal::write_pending(std::vector<char>& records)
+{
+    if (!file_ || records.empty())
+    {
+        return file_ != nullptr;
+    }
+    bool ok = std::fwrite(records.data(), 1, records.size(), file_) == records.size() && std::fflush(file_) == 0;
+#ifdef _WIN32
+    ok = ok && _commit(_fileno(file_)) == 0;
+#else
+    ok = ok && ::fsync(fileno(file_)) == 0;
+#endif
+    return ok;
+}
+
+uint64_t RunJournal::append(EntryType type, std::string_view payload)
+{
+    std::unique_lock<std::mutex> lock(buffer_mutex_);
+    uint64_t                     number = next_entry_++;
+    ++appended_;
+    encode_entry(pending_, type, payload);
+
+    auto now = std::chrono::steady_clock::now();
+    if (pending_.size() < batch_records_ * RECORD_SIZE && now - last_write_ < MAX_BATCH_AGE)
+    {
+        return number;
+    }
+
+    // Batches reach the file in the order they were cut: the file lock is taken before the next batch can start
+    std::vector<char> records;
+    records.swap(pending_);
+    last_write_ = now;
+    std::lock_guard<std::mutex> write_lock(file_mutex_);
+    lock.unlock();
+    write_pending(records);
+    return number;
+}
+
+bool RunJournal::flush()
+{
+    std::unique_lock<std::mutex> lock(buffer_mutex_);
+    std::vector<char>            records;
+    records.swap(pending_);
+    last_write_ = std::chrono::steady_clock::now();
+    std::lock_guard<std::mutex> write_lock(file_mutex_);
+    lock.unlock();
+    return write_pending(records);
+}
+
+void RunJournal::finish()
+{
+    std::lock_guard<std::mutex> lock(buffer_mutex_);
+    std::lock_guard<std::mutex> write_lock(file_mutex_);
+    if (file_)
+    {
+        std::fclose(file_);
+        file_ = nullptr;
+    }
+    pending_.clear();
+    std::error_code ec;
+    std::filesystem::remove(path_, ec);
+}
@@ -0,0 +1,222 @@
+/**
+ * @file run_journal.h
+ * @brief Append-only journal of the work a run has finished, for --resume
+ * @author Le Nhan Pham
+ * @date 2025
+ *
+ * This header provides the checkpoint behind the --resume option of extract
+ * and the job checkers. While a run works, every finished unit is appended to
+ * a journal in the working directory: the parsed values of each log for
+ * extract, and every group of file moves for the checkers. When walltime or a
+ * signal ends the run, the next run with --resume reads the journal back,
+ * reuses the logs that were already parsed and completes (or undoes) the moves
+ * that were in progress. A run that finishes removes its journal.
+ *
+ * @section File Format
+ * The journal is a sequence of fixed-size records of RECORD_SIZE bytes, in
+ * native byte order:
+ * @verbatim
+   Record := u32 checksum   FNV-1a of the remaining 124 bytes
+             u16 type       EntryType of the entry the record belongs to
+             u16 length     payload bytes used in this record (at most 112)
+             u32 index      position of the record within its entry
+             u32 count      records of the entry
+             u8[112]        payload, zero padded
+   @endverbatim
+ * An entry (a header, one log's values, one move group) whose payload does
+ * not fit in one record continues in the records that follow it. The first
+ * entry is a HEADER holding the settings the recorded work depends on; a
+ * journal written under other settings is started over.
+ *
+ * @section Durability
+ * Records are buffered and written in batches, each followed by an fsync, so
+ * a run that is killed loses at most the last batch (and a batch that was
+ * cut short is recognised by its checksums and dropped). flush() writes the
+ * pending records at once; the move planner calls it before any file moves.
+ *
+ * @section Thread Safety
+ * append() may be called concurrently from worker threads.
+ */
+
+#ifndef RUN_JOURNAL_H
+#define RUN_JOURNAL_H
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @class RunJournal
+ * @brief Crash-safe record of the finished work of one command
+ */
+class RunJournal
+{
+public:
+    /**
+     * @enum EntryType
+     * @brief What an entry records
+     */
+    enum class EntryType : uint16_t
+    {
+        HEADER    = 1,  ///< Settings of the run that wrote the journal (first entry)
+        RESULT    = 2,  ///< Parsed values of one log (extract)
+        MOVE      = 3,  ///< Planned moves of one group, written before any of them happens
+        MOVE_DONE = 4   ///< All files of a MOVE entry were moved (payload: its entry number)
+    };
+
+    /**
+     * @struct Entry
+     * @brief One entry read back from a journal
+     */
+    struct Entry
+    {
+        EntryType   type;     ///< What the entry records
+        uint64_t    number;   ///< Position of the entry in the journal (the header is 0)
+        std::string payload;  ///< Bytes passed to append()
+    };
+
+    static constexpr size_t RECORD_SIZE  = 128;  ///< Bytes per record
+    static constexpr size_t PAYLOAD_SIZE = 112;  ///< Payload bytes per record
+
+    /**
+     * @brief Journal file of a command in the working directory (".gaussian_extractor.<command>.journal")
+     */
+    static std::string path_for(const std::string& command);
+
+    /**
+     * @brief Create a journal bound to a file; nothing is read or written yet
+     * @param path Journal file
+     * @param batch_records Records collected before they are written and synced
+     */
+    explicit RunJournal(const std::string& path, size_t batch_records = 256);
+
+    /**
+     * @brief Write pending records and close the file (the journal is kept)
+     */
+    ~RunJournal();
+
+    RunJournal(const RunJournal&)            = delete;
+    RunJournal& operator=(const RunJournal&) = delete;
+
+    /**
+     * @brief Continue the journal left by an earlier run, or start a new one
+     * @param signature Settings the recorded work depends on
+     * @param error Receives the reason when the journal cannot be written
+     * @return false if the journal file cannot be written
+     *
+     * Entries of an earlier run with the same signature are kept and available
+     * from recovered(); an incomplete last batch is cut off. A journal with
+     * another signature is replaced (see discarded()).
+     */
+    bool open(const std::string& signature, std::string& error);
+
+    /**
+     * @brief Entries of the earlier run, in order, without the header
+     */
+    const std::vector<Entry>& recovered() const
+    {
+        return recovered_;
+    }
+
+    /**
+     * @brief Whether open() found a journal of other settings and started over
+     */
+    bool discarded() const
+    {
+        return discarded_;
+    }
+
+    /**
+     * @brief Add an entry; it reaches the file with the next batch
+     * @param type What the entry records
+     * @param payload Entry data (split over as many records as needed)
+     * @return Entry number, as Entry::number reports it on recovery
+     */
+    uint64_t append(EntryType type, std::string_view payload);
+
+    /**
+     * @brief Write and sync every pending record
+     * @return false if the file could not be written
+     */
+    bool flush();
+
+    /**
+     * @brief The run completed: close and remove the journal
+     */
+    void finish();
+
+    /**
+     * @brief Entries appended by this run
+     */
+    size_t appended_count() const
+    {
+        return appended_;
+    }
+
+    /**
+     * @brief Path of the journal file
+     */
+    const std::string& path() const
+    {
+        return path_;
+    }
+
+    /**
+     * @brief Append a value to a payload, byte for byte
+     */
+    template <typename T>
+    static void put(std::string& payload, const T& value)
+    {
+        payload.append(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    /**
+     * @brief Append a length-prefixed string to a payload
+     */
+    static void put_string(std::string& payload, std::string_view text);
+
+    /**
+     * @brief Read a value written by put() from the front of @p payload
+     * @return false if the payload is too short
+     */
+    template <typename T>
+    static bool get(std::string_view& payload, T& value)
+    {
+        if (payload.size() < sizeof(T))
+        {
+            return false;
+        }
+        std::memcpy(&value, payload.data(), sizeof(T));
+        payload.remove_prefix(sizeof(T));
+        return true;
+    }
+
+    /**
+     * @brief Read a string written by put_string() from the front of @p payload
+     * @return false if the payload is too short
+     */
+    static bool get_string(std::string_view& payload, std::string& text);
+
+private:
+    bool read_existing(const std::string& header, uint64_t& valid_bytes);
+    bool write_pending(std::vector<char>& records);
+
+    std::string                           path_;           ///< Journal file
+    size_t                                batch_records_;  ///< Records per write
+    std::FILE*                            file_;           ///< Open journal (nullptr before open() and after finish())
+    std::mutex                            buffer_mutex_;   ///< Guards pending_, next_entry_, appended_, last_write_
+    std::mutex                            file_mutex_;     ///< Serialises writes; taken before buffer_mutex_ is released
+    std::vector<char>                     pending_;        ///< Records not written yet
+    uint64_t                              next_entry_;     ///< Number of the next entry
+    size_t                                appended_;       ///< Entries appended by this run
+    std::chrono::steady_clock::time_point last_write_;     ///< Time of the last batch
+    std::vector<Entry>                    recovered_;      ///< Entries of the earlier run
+    bool                                  discarded_;      ///< An earlier journal of other settings was replaced
+};
+
+#endif  // RUN_JOURNAL_H
@@ -0,0 +1,74 @@
+/**
+ * @file session_state.cpp
+ * @brief Implementation of the interactive session state
+ * @author Le Nhan Pham
+ * @date 2025
+ */
+
+#include "session_state.h"
+#include <filesystem>
+#include <system_error>
+
+namespace
+{
+    SessionState* active_session = nullptr;
+}  // namespace
+
+// =============================================================================
+// SessionState Implementation
+// =============================================================================
+
+SessionState::SessionState() : have_resources_(false)
+{
+    active_session = this;
+}
+
+SessionState::~SessionState()
+{
+    for (auto& [directory, entry] : indexes_)
+    {
+        if (entry.persistent)
+        {
+            entry.index->save();
+        }
+    }
+    if (active_session == this)
+    {
+        active_session = nullptr;
+    }
+}
+
+SessionState* SessionState::active()
+{
+    return active_session;
+}
+
+std::shared_ptr<ResultIndex> SessionState::result_index(bool persistent)
+{
+    std::error_code       ec;
+    std::filesystem::path cwd   = std::filesystem::current_path(ec);
+    DirectoryIndex&       entry = indexes_[cwd.string()];
+    if (!entry.index)
+    {
+        // First command in this directory; its index file is bound by absolute path, so a later cd does not move it
+        entry.index = std::make_shared<ResultIndex>((cwd / RESULT_INDEX_FILENAME).string());
+        entry.index->load();
+        entry.index->set_stamp_source([this](const std::string& path, FileStamp& stamp) {
+            return directory_.stamp(path, stamp);
+        });
+        entry.persistent = false;
+    }
+    entry.persistent = entry.persistent || persistent;
+    entry.index->begin_run();
+    return entry.index;
+}
+
+const JobResources& SessionState::job_resources()
+{
+    if (!have_resources_)
+    {
+        resources_      = JobSchedulerDetector::detect_job_resources();
+        have_resources_ = true;
+    }
+    return resources_;
+}
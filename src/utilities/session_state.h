@@ -0,0 +1,109 @@
+/**
+ * @file session_state.h
+ * @brief State kept warm between the commands of an interactive session
+ * @author Le Nhan Pham
+ * @date 2025
+ *
+ * Each command typed in interactive mode runs through the same code as on the
+ * command line. Without a session, every command would list the directory,
+ * detect the job resources and read every log again. While a SessionState is
+ * active, those steps are served from state that lives as long as the
+ * session:
+ *
+ * - The listing of the working directory (DirectoryCache), kept current by
+ *   change notifications; FileDiscovery walks it instead of the directory,
+ *   and TAB completion reads it instead of listing the directory per key
+ * - The result index of the working directory, held in memory and used by
+ *   every command (whether or not --index is given), so logs that did not
+ *   change are not read again; a different temperature, concentration or
+ *   sort column is applied to the stored raw values. The index file is only
+ *   written for commands run with --index (and when the session ends)
+ * - The job resources, detected once
+ * - The worker threads, which TaskExecutor::shared() already keeps for the
+ *   whole process
+ *
+ * After cd, the listing and the index follow the new working directory; the
+ * index of a directory left behind stays in memory for a return to it.
+ *
+ * Shards keep their own index files and do not use the session.
+ */
+
+#ifndef SESSION_STATE_H
+#define SESSION_STATE_H
+
+#include "job_management/job_scheduler.h"
+#include "utilities/directory_cache.h"
+#include "utilities/result_index.h"
+#include <map>
+#include <memory>
+#include <string>
+
+/**
+ * @class SessionState
+ * @brief Directory listing, result index and job resources shared by the commands of a session
+ *
+ * Create one on the main thread for the duration of the session; it is the
+ * active session until it is destroyed. Commands call its members from the
+ * main thread between runs, except directory(), which is thread-safe.
+ */
+class SessionState
+{
+public:
+    /**
+     * @brief Start a session and make it the active one
+     */
+    SessionState();
+
+    /**
+     * @brief Write the result index if a command asked for it, and end the session
+     */
+    ~SessionState();
+
+    SessionState(const SessionState&)            = delete;
+    SessionState& operator=(const SessionState&) = delete;
+
+    /**
+     * @brief The session in progress, or nullptr outside interactive mode
+     */
+    static SessionState* active();
+
+    /**
+     * @brief Listing of the working directory
+     */
+    DirectoryCache& directory()
+    {
+        return directory_;
+    }
+
+    /**
+     * @brief Result index of the working directory, ready for one command
+     * @param persistent The command was run with --index: the index file is written after it and when the
+     *                   session ends
+     * @return Index with the entries of the earlier commands in this directory (and of its index file, read on
+     *         first use); its hit and miss counts start from zero
+     */
+    std::shared_ptr<ResultIndex> result_index(bool persistent);
+
+    /**
+     * @brief Job scheduler resources, detected on first use
+     */
+    const JobResources& job_resources();
+
+private:
+    /**
+     * @struct DirectoryIndex
+     * @brief Result index of one working directory
+     */
+    struct DirectoryIndex
+    {
+        std::shared_ptr<ResultIndex> index;       ///< Entries of the directory's logs
+        bool                         persistent;  ///< A command in the directory asked for the index file
+    };
+
+    DirectoryCache                        directory_;       ///< Notified listing of the working directory
+    std::map<std::string, DirectoryIndex> indexes_;         ///< Result indexes by absolute directory
+    bool                                  have_resources_;  ///< resources_ was detected
+    JobResources                          resources_;       ///< Detected job resources
+};
+
+#endif  // SESSION_STATE_H
@@ -0,0 +1,537 @@
+/**
+ * @file task_executor.cpp
+ * @brief Implementation of the shared work-stealing executor
+ * @author Le Nhan Pham
+ * @date 2025
+ */
+
+#include "task_executor.h"
+#include "extraction/gaussian_extractor.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <numeric>
+#include <thread>
+#include <utility>
+
+namespace
+{
+    /**
+     * @brief Whether the current thread is executing a task (nested batches run inline)
+     */
+    thread_local bool t_inside_task = false;
+
+    /**
+     * @brief Executor slot of the current thread (0 for threads that are not workers)
+     */
+    thread_local unsigned int t_slot = 0;
+
+    /**
+     * @brief Restores t_inside_task when leaving a task scope
+     */
+    struct InsideTaskScope
+    {
+        bool previous;
+        InsideTaskScope() : previous(t_inside_task)
+        {
+            t_inside_task = true;
+        }
+        ~InsideTaskScope()
+        {
+            t_inside_task = previous;
+        }
+    };
+
+    std::vector<size_t> ordered_indices(size_t count, const std::vector<uintmax_t>& weights)
+    {
+        std::vector<size_t> order(count);
+        std::iota(order.begin(), order.end(), 0);
+        if (weights.size() == count)
+        {
+            std::stable_sort(order.begin(), order.end(), [&weights](size_t a, size_t b) {
+                return weights[a] > weights[b];
+            });
+        }
+        return order;
+    }
+
+    /**
+     * @brief Placement applied by TaskExecutor::shared(); guarded by g_shared_mutex
+     */
+    CpuPlacement::Policy      g_placement_policy = CpuPlacement::Policy::NONE;
+    std::vector<unsigned int> g_placement_cpus;
+    std::mutex                g_shared_mutex;
+}  // namespace
+
+// =============================================================================
+// TaskExecutor::Pool
+// =============================================================================
+
+/**
+ * @class TaskExecutor::Pool
+ * @brief Worker threads and batch state shared by the executors on one pool
+ *
+ * Slot 0 is the thread that calls run(); workers take slots 1 and up. A batch
+ * is limited to the first thread_count slots of its executor; the pool only
+ * grows, while holding run_mutex_ and between batches, so workers are never
+ * stopped under a running batch.
+ */
+class TaskExecutor::Pool
+{
+public:
+    Pool() : task_(nullptr), generation_(0), limit_(1), active_workers_(0), stopping_(false), open_(false),
+             unfinished_(0), executed_(0), submissions_(0)
+    {
+        queues_.push_back(std::make_unique<WorkQueue>());
+    }
+
+    ~Pool();
+
+    size_t run(size_t count, const Task& task, const std::vector<uintmax_t>& weights, unsigned int thread_count,
+               const std::vector<unsigned int>& cpus);
+    size_t run_streaming(const Producer& producer, const Task& task, unsigned int thread_count,
+                         const std::vector<unsigned int>& cpus);
+
+    /**
+     * @brief Start workers until the pool has thread_count slots
+     *
+     * Only while no batch is running: from the constructor of an executor or
+     * with run_mutex_ held.
+     */
+    void grow(unsigned int thread_count);
+
+private:
+    struct WorkQueue
+    {
+        std::mutex         mutex;  ///< Guards tasks
+        std::deque<size_t> tasks;  ///< Pending task indices, largest first
+    };
+
+    void post_batch(const Task& task, unsigned int thread_count, const std::vector<unsigned int>& cpus,
+                    size_t unfinished, bool open);
+    std::exception_ptr wait_for_batch();
+    void worker_loop(unsigned int slot);
+    void work_on_batch(unsigned int slot, const Task& task);
+    bool next_task(unsigned int slot, size_t& index);
+    bool wait_for_submission(uint64_t seen_submissions);
+    void drop_pending_tasks();
+    void finish_tasks(size_t count);
+
+    std::vector<std::unique_ptr<WorkQueue>> queues_;   ///< One deque per slot; slot 0 is the caller
+    std::vector<std::thread>                workers_;  ///< Threads for slots 1..queues_.size()-1
+
+    std::mutex                run_mutex_;       ///< Serialises batches of every executor on the pool
+    std::mutex                state_mutex_;     ///< Guards the batch state below
+    std::condition_variable   batch_ready_;     ///< Signals workers that a batch was posted
+    std::condition_variable   batch_done_;      ///< Signals run() that the batch finished
+    const Task*               task_;            ///< Task of the current batch
+    uint64_t                  generation_;      ///< Incremented for every batch
+    unsigned int              limit_;           ///< Slots taking part in the current batch
+    std::vector<unsigned int> cpus_;            ///< CPU of each slot of the current batch (empty = not pinned)
+    unsigned int              active_workers_;  ///< Workers currently inside a batch
+    bool                      stopping_;        ///< Set by the destructor
+    bool                      open_;            ///< Streaming batch whose producer is still running
+    std::condition_variable   task_submitted_;  ///< Signals idle workers of a streaming batch
+    std::exception_ptr        first_error_;     ///< First exception escaping a task
+
+    std::atomic<size_t>   unfinished_;   ///< Tasks of the current batch not yet run or dropped
+    std::atomic<size_t>   executed_;     ///< Tasks of the current batch that were run
+    std::atomic<uint64_t> submissions_;  ///< Tasks submitted to streaming batches; changed under state_mutex_
+};
+
+TaskExecutor::Pool::~Pool()
+{
+    {
+        std::lock_guard<std::mutex> lock(state_mutex_);
+        stopping_ = true;
+    }
+    batch_ready_.notify_all();
+    task_submitted_.notify_all();
+    for (auto& worker : workers_)
+    {
+        if (worker.joinable())
+        {
+            worker.join();
+        }
+    }
+}
+
+void TaskExecutor::Pool::grow(unsigned int thread_count)
+{
+    while (queues_.size() < thread_count)
+    {
+        queues_.push_back(std::make_unique<WorkQueue>());
+        workers_.emplace_back(&Pool::worker_loop, this, static_cast<unsigned int>(queues_.size() - 1));
+    }
+}
+
+size_t TaskExecutor::Pool::run(size_t count, const Task& task, const std::vector<uintmax_t>& weights,
+                               unsigned int thread_count, const std::vector<unsigned int>& cpus)
+{
+    if (count == 0)
+    {
+        return 0;
+    }
+
+    std::vector<size_t> order = ordered_indices(count, weights);
+
+    // Single thread or nested batch: run inline in weight order
+    if (thread_count == 1 || t_inside_task)
+    {
+        InsideTaskScope scope;
+        size_t          executed = 0;
+        for (size_t index : order)
+        {
+            if (g_shutdown_requested.load(std::memory_order_relaxed))
+            {
+                break;
+            }
+            task(index);
+            ++executed;
+        }
+        return executed;
+    }
+
+    std::lock_guard<std::mutex> run_lock(run_mutex_);
+    CpuPlacement::ScopedPin     pin(cpus);
+    grow(thread_count);
+
+    // Deal tasks round-robin so every deque stays ordered largest first
+    for (size_t i = 0; i < order.size(); ++i)
+    {
+        WorkQueue&                  queue = *queues_[i % thread_count];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.tasks.push_back(order[i]);
+    }
+
+    post_batch(task, thread_count, cpus, count, false);
+
+    {
+        InsideTaskScope scope;
+        work_on_batch(0, task);
+    }
+
+    std::exception_ptr error = wait_for_batch();
+    if (error)
+    {
+        std::rethrow_exception(error);
+    }
+    return executed_.load();
+}
+
+size_t TaskExecutor::Pool::run_streaming(const Producer& producer, const Task& task, unsigned int thread_count,
+                                         const std::vector<unsigned int>& cpus)
+{
+    // Single thread or nested batch: run every task as soon as it is submitted
+    if (thread_count == 1 || t_inside_task)
+    {
+        InsideTaskScope scope;
+        size_t          executed = 0;
+        producer([&task, &executed](size_t index) {
+            if (!g_shutdown_requested.load(std::memory_order_relaxed))
+            {
+                task(index);
+                ++executed;
+            }
+        });
+        return executed;
+    }
+
+    std::lock_guard<std::mutex> run_lock(run_mutex_);
+    CpuPlacement::ScopedPin     pin(cpus);
+    grow(thread_count);
+
+    post_batch(task, thread_count, cpus, 1, true);  // One unfinished task held by the producer until it returns
+
+    // The calling thread is busy producing, so tasks are dealt to the workers only
+    size_t submitted = 0;
+    Submit submit    = [this, thread_count, &submitted](size_t index) {
+        if (g_shutdown_requested.load(std::memory_order_relaxed))
+        {
+            return;
+        }
+        unfinished_.fetch_add(1);
+        {
+            WorkQueue&                  queue = *queues_[1 + submitted++ % (thread_count - 1)];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            queue.tasks.push_back(index);
+        }
+        {
+            std::lock_guard<std::mutex> lock(state_mutex_);
+            submissions_.fetch_add(1);
+        }
+        task_submitted_.notify_one();
+    };
+
+    std::exception_ptr producer_error;
+    try
+    {
+        producer(submit);
+    }
+    catch (...)
+    {
+        producer_error = std::current_exception();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(state_mutex_);
+        open_ = false;
+    }
+    task_submitted_.notify_all();
+    finish_tasks(1);
+
+    // Help with whatever the workers have not started yet
+    {
+        InsideTaskScope scope;
+        work_on_batch(0, task);
+    }
+
+    std::exception_ptr error = wait_for_batch();
+    if (producer_error)
+    {
+        error = producer_error;
+    }
+    if (error)
+    {
+        std::rethrow_exception(error);
+    }
+    return executed_.load();
+}
+
+void TaskExecutor::Pool::post_batch(const Task& task, unsigned int thread_count, const std::vector<unsigned int>& cpus,
+                                    size_t unfinished, bool open)
+{
+    {
+        std::lock_guard<std::mutex> lock(state_mutex_);
+        task_        = &task;
+        limit_       = thread_count;
+        cpus_        = cpus;
+        first_error_ = nullptr;
+        open_        = open;
+        unfinished_.store(unfinished);
+        executed_.store(0);
+        ++generation_;
+    }
+    batch_ready_.notify_all();
+}
+
+std::exception_ptr TaskExecutor::Pool::wait_for_batch()
+{
+    std::unique_lock<std::mutex> lock(state_mutex_);
+    batch_done_.wait(lock, [this] {
+        return unfinished_.load() == 0 && active_workers_ == 0;
+    });
+    task_ = nullptr;
+    return first_error_;
+}
+
+void TaskExecutor::Pool::worker_loop(unsigned int slot)
+{
+    t_inside_task = true;
+    t_slot        = slot;
+
+    uint64_t                     seen_generation = 0;
+    std::unique_lock<std::mutex> lock(state_mutex_);
+    while (true)
+    {
+        batch_ready_.wait(lock, [this, seen_generation] {
+            return stopping_ || (generation_ != seen_generation && task_ != nullptr);
+        });
+        if (stopping_)
+        {
+            return;
+        }
+        seen_generation = generation_;
+        if (slot >= limit_)
+        {
+            continue;  // Batch of an executor with fewer threads
+        }
+        const Task&               task = *task_;
+        std::vector<unsigned int> cpu;
+        if (slot < cpus_.size())
+        {
+            cpu.push_back(cpus_[slot]);
+        }
+        ++active_workers_;
+        lock.unlock();
+
+        {
+            CpuPlacement::ScopedPin pin(cpu);
+            work_on_batch(slot, task);
+        }
+
+        lock.lock();
+        if (--active_workers_ == 0)
+        {
+            batch_done_.notify_all();
+        }
+    }
+}
+
+void TaskExecutor::Pool::work_on_batch(unsigned int slot, const Task& task)
+{
+    size_t index = 0;
+    while (true)
+    {
+        uint64_t seen_submissions = submissions_.load();
+        if (!next_task(slot, index))
+        {
+            if (wait_for_submission(seen_submissions))
+            {
+                continue;
+            }
+            return;
+        }
+
+        if (g_shutdown_requested.load(std::memory_order_relaxed))
+        {
+            finish_tasks(1);
+            drop_pending_tasks();
+            return;
+        }
+
+        try
+        {
+            task(index);
+        }
+        catch (...)
+        {
+            std::lock_guard<std::mutex> lock(state_mutex_);
+            if (!first_error_)
+            {
+                first_error_ = std::current_exception();
+            }
+        }
+        executed_.fetch_add(1);
+        finish_tasks(1);
+    }
+}
+
+bool TaskExecutor::Pool::next_task(unsigned int slot, size_t& index)
+{
+    // Own deque first, then steal the largest pending task of the other threads of the batch
+    for (unsigned int offset = 0; offset < limit_; ++offset)
+    {
+        WorkQueue&                  queue = *queues_[(slot + offset) % limit_];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (!queue.tasks.empty())
+        {
+            index = queue.tasks.front();
+            queue.tasks.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+bool TaskExecutor::Pool::wait_for_submission(uint64_t seen_submissions)
+{
+    std::unique_lock<std::mutex> lock(state_mutex_);
+    if (!open_)
+    {
+        return false;
+    }
+
+    // Woken by a new task, the producer finishing or the destructor; look at the queues again in every case
+    task_submitted_.wait(lock, [this, seen_submissions] {
+        return !open_ || stopping_ || submissions_.load() != seen_submissions;
+    });
+    return !stopping_;
+}
+
+void TaskExecutor::Pool::drop_pending_tasks()
+{
+    for (unsigned int slot = 0; slot < limit_; ++slot)
+    {
+        size_t dropped = 0;
+        {
+            std::lock_guard<std::mutex> lock(queues_[slot]->mutex);
+            dropped = queues_[slot]->tasks.size();
+            queues_[slot]->tasks.clear();
+        }
+        finish_tasks(dropped);
+    }
+}
+
+void TaskExecutor::Pool::finish_tasks(size_t count)
+{
+    if (count > 0 && unfinished_.fetch_sub(count) == count)
+    {
+        std::lock_guard<std::mutex> lock(state_mutex_);
+        batch_done_.notify_all();
+    }
+}
+
+// =============================================================================
+// TaskExecutor Implementation
+// =============================================================================
+
+TaskExecutor::TaskExecutor(unsigned int thread_count, const std::vector<unsigned int>& cpus)
+    : TaskExecutor(std::make_shared<Pool>(), thread_count, cpus)
+{
+    pool_->grow(thread_count_);
+}
+
+TaskExecutor::TaskExecutor(std::shared_ptr<Pool> pool, unsigned int thread_count, const std::vector<unsigned int>& cpus)
+    : pool_(std::move(pool)), thread_count_(std::max(1u, thread_count)), cpus_(cpus)
+{
+}
+
+TaskExecutor::~TaskExecutor() = default;
+
+size_t TaskExecutor::run(size_t count, const Task& task, const std::vector<uintmax_t>& weights)
+{
+    return pool_->run(count, task, weights, thread_count_, cpus_);
+}
+
+size_t TaskExecutor::run_streaming(const Producer& producer, const Task& task)
+{
+    return pool_->run_streaming(producer, task, thread_count_, cpus_);
+}
+
+unsigned int TaskExecutor::current_slot()
+{
+    return t_slot;
+}
+
+TaskExecutor& TaskExecutor::shared(unsigned int thread_count)
+{
+    // One pool for the process; one executor per thread count and placement, kept so references stay valid
+    static std::shared_ptr<Pool> pool = std::make_shared<Pool>();
+    static std::map<std::pair<unsigned int, std::vector<unsigned int>>, std::unique_ptr<TaskExecutor>> executors;
+
+    std::lock_guard<std::mutex> lock(g_shared_mutex);
+    thread_count                   = std::max(1u, thread_count);
+    std::vector<unsigned int> cpus = CpuPlacement::plan(g_placement_cpus, thread_count, g_placement_policy);
+    std::unique_ptr<TaskExecutor>& executor = executors[{thread_count, cpus}];
+    if (!executor)
+    {
+        executor.reset(new TaskExecutor(pool, thread_count, cpus));
+    }
+    return *executor;
+}
+
+void TaskExecutor::set_placement(CpuPlacement::Policy policy, const std::vector<unsigned int>& cpus)
+{
+    std::lock_guard<std::mutex> lock(g_shared_mutex);
+    g_placement_policy = policy;
+    g_placement_cpus   = cpus;
+}
+
+std::vector<uintmax_t> TaskExecutor::file_sizes(const std::vector<std::string>& paths)
+{
+    std::vector<uintmax_t> sizes;
+    sizes.reserve(paths.size());
+    for (const auto& path : paths)
+    {
+        std::error_code ec;
+        uintmax_t       size = std::filesystem::file_size(path, ec);
+        sizes.push_back(ec ? 0 : size);
+    }
+    return sizes;
+}
@@ -0,0 +1,191 @@
+/**
+ * @file task_executor.h
+ * @brief Shared work-stealing executor for per-file parallel processing
+ * @author Le Nhan Pham
+ * @date 2025
+ *
+ * This header provides the single thread pool used by every module that
+ * processes files in parallel (extract, the job checkers, high-level energies,
+ * coordinate extraction and input creation). Worker threads are created once
+ * and reused by later batches, which keeps repeated commands in interactive
+ * mode from spawning and joining a fresh set of threads every time.
+ *
+ * A TaskExecutor is a handle on a pool with its own thread count and
+ * placement. Every executor returned by shared() works on the same
+ * process-wide pool: the pool grows to the largest thread count requested and
+ * is never replaced, and each batch only uses as many of its threads as the
+ * executor that runs it. Asking for another thread count therefore never
+ * touches the workers of a batch that is still running.
+ *
+ * @section Scheduling
+ * - Tasks of a batch are ordered by weight (file size), largest first, and
+ *   dealt round-robin into one deque per thread
+ * - A thread takes the largest task from its own deque and, once that is
+ *   empty, steals the largest pending task of another thread, so a single
+ *   large log starts early instead of becoming the last task of the run
+ * - The calling thread works on its own batch as one of the threads
+ * - A streaming batch (run_streaming()) receives its tasks while it runs, e.g.
+ *   from a directory walk; workers start on the first file while the calling
+ *   thread is still producing, and the calling thread joins them afterwards
+ *
+ * @section Cancellation
+ * Before every task the threads check g_shutdown_requested; once it is set the
+ * remaining tasks of the batch are dropped and run() returns.
+ *
+ * @section Thread Count
+ * The executor does not decide how many threads are safe. Callers pass the
+ * result of calculateSafeThreadCount(), which applies the SLURM/PBS/SGE/LSF
+ * CPU allocation detected by JobSchedulerDetector. That count caps the
+ * threads of each batch; workers of the pool beyond it sleep through the
+ * batch.
+ *
+ * @section Placement
+ * With a placement set by set_placement() (--pin), every thread of a batch is
+ * pinned to its CPU of the plan while it works on the batch: slot 0, the
+ * calling thread, to the first CPU and each worker to the CPU of its slot
+ * (see CpuPlacement).
+ */
+
+#ifndef TASK_EXECUTOR_H
+#define TASK_EXECUTOR_H
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "cpu_placement.h"
+
+/**
+ * @class TaskExecutor
+ * @brief Work-stealing thread pool running batches of indexed tasks on up to thread_count() threads
+ *
+ * A batch is a task function called once for every index in [0, count). run()
+ * blocks until the batch is complete or cancelled. Only one batch runs at a
+ * time on a pool, even across executors sharing it; run() called from inside
+ * a task executes the nested batch inline on the calling thread instead of
+ * deadlocking.
+ */
+class TaskExecutor
+{
+public:
+    /**
+     * @brief Task body, called with the index of the item to process
+     *
+     * Tasks should report per-item failures themselves (usually through the
+     * error collector). An exception escaping a task is rethrown by run()
+     * after the batch has finished.
+     */
+    using Task = std::function<void(size_t index)>;
+
+    /**
+     * @brief Hands one new task index to a running streaming batch
+     */
+    using Submit = std::function<void(size_t index)>;
+
+    /**
+     * @brief Produces the tasks of a streaming batch by calling submit for each
+     */
+    using Producer = std::function<void(const Submit& submit)>;
+
+    /**
+     * @brief Create an executor with a pool of its own
+     * @param thread_count Total number of threads, including the thread calling run()
+     * @param cpus CPU of each slot from CpuPlacement::plan() (empty = threads are not pinned)
+     */
+    explicit TaskExecutor(unsigned int thread_count, const std::vector<unsigned int>& cpus = {});
+
+    /**
+     * @brief Release the pool; its workers are stopped and joined once no executor uses it
+     */
+    ~TaskExecutor();
+
+    TaskExecutor(const TaskExecutor&)            = delete;
+    TaskExecutor& operator=(const TaskExecutor&) = delete;
+
+    /**
+     * @brief Run a batch of tasks and wait for it
+     * @param count Number of tasks
+     * @param task Task body, called with each index in [0, count)
+     * @param weights Optional per-index weights (e.g. file sizes); larger tasks start first
+     * @return Number of tasks that were run (less than count after a shutdown request)
+     * @throws The first exception that escaped a task
+     */
+    size_t run(size_t count, const Task& task, const std::vector<uintmax_t>& weights = {});
+
+    /**
+     * @brief Run a batch whose tasks are produced while it runs
+     * @param producer Runs on the calling thread and submits each task index as it becomes known
+     * @param task Task body, called with each submitted index
+     * @return Number of tasks that were run
+     * @throws The exception that escaped the producer, otherwise the first one that escaped a task
+     *
+     * Tasks are run in submission order across the worker threads. The task
+     * may be running for earlier indices while the producer is still
+     * submitting later ones, so any storage shared between the two must be
+     * synchronised by the caller.
+     */
+    size_t run_streaming(const Producer& producer, const Task& task);
+
+    /**
+     * @brief Total number of threads working on a batch
+     */
+    unsigned int thread_count() const
+    {
+        return thread_count_;
+    }
+
+    /**
+     * @brief CPU of each slot (empty when the threads are not pinned)
+     */
+    const std::vector<unsigned int>& placement() const
+    {
+        return cpus_;
+    }
+
+    /**
+     * @brief Slot of the calling thread while it runs a task of this executor
+     * @return Index in [0, thread_count()); 0 for the thread that called run()
+     *
+     * Lets tasks write to per-thread buffers sized thread_count() without locking.
+     */
+    static unsigned int current_slot();
+
+    /**
+     * @brief Executor on the process-wide pool with the given number of threads
+     * @param thread_count Thread count from calculateSafeThreadCount()
+     * @return Executor for this thread count and the current placement; it stays valid for the
+     *         lifetime of the process
+     *
+     * Safe to call at any time, also from inside a task or while another
+     * module's batch is running: the pool is only grown, at the start of a
+     * batch, and never replaced.
+     */
+    static TaskExecutor& shared(unsigned int thread_count);
+
+    /**
+     * @brief Placement of the threads of executors returned by later shared() calls
+     * @param policy Placement policy (--pin)
+     * @param cpus CPUs the process may use (JobResources::cpu_set)
+     */
+    static void set_placement(CpuPlacement::Policy policy, const std::vector<unsigned int>& cpus);
+
+    /**
+     * @brief Sizes of a list of files, for use as run() weights
+     * @param paths File paths
+     * @return Size of each file in bytes (0 where it cannot be determined)
+     */
+    static std::vector<uintmax_t> file_sizes(const std::vector<std::string>& paths);
+
+private:
+    class Pool;
+
+    TaskExecutor(std::shared_ptr<Pool> pool, unsigned int thread_count, const std::vector<unsigned int>& cpus);
+
+    std::shared_ptr<Pool>     pool_;          ///< Worker threads, possibly shared with other executors
+    unsigned int              thread_count_;  ///< Threads of each batch, including the calling thread
+    std::vector<unsigned int> cpus_;          ///< CPU of each slot (empty = not pinned)
+};
+
+#endif  // TASK_EXECUTOR_H
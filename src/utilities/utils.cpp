@@ -1,4 +1,6 @@
 #include "utils.h"
+#include "compressed_input.h"
+#include "profiler.h"
 #include <algorithm>
 #include <chrono>
 #include <filesystem>
@@ -8,12 +10,34 @@
 #include <stdexcept>
 #include <vector>
 
+#ifdef __linux__
+    #include <sys/vfs.h>
+#endif
+
 namespace Utils
 {
 
-    std::string
-    read_file_unified(const std::string& file_path, FileReadMode mode, size_t tail_lines, const std::string& pattern)
+    /**
+     * @brief Reading behind read_file_unified(), which adds the profiler accounting
+     */
+    static std::string
+    read_file_content(const std::string& file_path, FileReadMode mode, size_t tail_lines, const std::string& pattern)
     {
+        // Compressed logs are decompressed as they are read; TAIL keeps only the last lines
+        if (CompressedInput::is_compressed(file_path))
+        {
+            if (mode == FileReadMode::FULL)
+            {
+                return CompressedInput::read_all(file_path);
+            }
+            std::string result = CompressedInput::read_tail_lines(file_path, tail_lines);
+            if (mode == FileReadMode::SMART && !pattern.empty() && result.find(pattern) == std::string::npos)
+            {
+                result = CompressedInput::read_all(file_path);
+            }
+            return result;
+        }
+
         std::ifstream file(file_path, std::ios::binary | std::ios::ate);
         if (!file.is_open())
         {
@@ -111,6 +135,61 @@ namespace Utils
         return buffer.str();
     }
 
+    std::string
+    read_file_unified(const std::string& file_path, FileReadMode mode, size_t tail_lines, const std::string& pattern)
+    {
+        Profiler::Scope read(Profiler::Phase::READ);
+        std::string     content = read_file_content(file_path, mode, tail_lines, pattern);
+        Profiler::add(Profiler::Counter::BYTES_READ, content.size());
+        return content;
+    }
+
+    std::string_view tail_lines(std::string_view text, size_t lines)
+    {
+        if (lines == 0)
+        {
+            return std::string_view();
+        }
+
+        size_t start = text.size();
+        while (start > 0)
+        {
+            --start;
+            if (text[start] == '\n' && --lines == 0)
+            {
+                return text.substr(start + 1);
+            }
+        }
+        return text;
+    }
+
+    bool on_network_file_system(const std::string& path)
+    {
+#ifdef __linux__
+        struct statfs info;
+        if (statfs(path.c_str(), &info) != 0)
+        {
+            return false;
+        }
+        switch (static_cast<unsigned long>(info.f_type))
+        {
+            case 0x0BD00BD0UL:  // Lustre
+            case 0x6969UL:      // NFS
+            case 0x47504653UL:  // GPFS
+            case 0xFF534D42UL:  // CIFS
+            case 0xFE534D42UL:  // SMB2
+            case 0x517BUL:      // SMB
+            case 0x65735546UL:  // FUSE
+                return true;
+            default:
+                return false;
+        }
+#else
+        (void)path;
+        return false;
+#endif
+    }
+
     std::filesystem::path generate_unique_filename(const std::filesystem::path& base_path)
     {
         if (!std::filesystem::exists(base_path))
@@ -14,6 +14,7 @@
 
 #include <filesystem>
 #include <string>
+#include <string_view>
 
 /**
  * @enum FileReadMode
@@ -52,6 +53,25 @@ namespace Utils
                                   size_t             tail_lines = 0,
                                   const std::string& pattern    = "");
 
+    /**
+     * @brief Last lines of a text already in memory
+     * @param text Complete content, e.g. of a log read once for several checks
+     * @param lines Number of lines wanted from the end
+     * @return The text after the lines-th newline from the end (the whole text if it has fewer lines)
+     *
+     * Follows the TAIL rule of read_file_unified(), so checks that classify a
+     * job by its last lines give the same answer for either source.
+     */
+    std::string_view tail_lines(std::string_view text, size_t lines);
+
+    /**
+     * @brief Whether a path lies on a network or parallel file system
+     * @param path File or directory to test
+     * @return true for Lustre, GPFS, NFS, SMB/CIFS and FUSE mounts; false otherwise,
+     *         and always false where the file system type cannot be queried (non-Linux)
+     */
+    bool on_network_file_system(const std::string& path);
+
     /**
      * @brief Generate a unique filename with timestamp suffix if file already exists
      * @param base_path
@@ -0,0 +1,41 @@
+#!/usr/bin/env python3
+"""Write the zstd fixtures of this directory from opt.log (needs the zstd command).
+
+  opt.log.zst           one frame, as written by "zstd opt.log"
+  opt-seekable.log.zst  frames of 4 KiB of content followed by a seek table
+                        (the zstd seekable format)
+"""
+
+import os
+import struct
+import subprocess
+
+SKIPPABLE_SEEK_TABLE_MAGIC = 0x184D2A5E
+SEEKABLE_MAGIC = 0x8F92EAB1
+
+
+def compress(content):
+    return subprocess.run(["zstd", "-q", "-19", "-c"], input=content, stdout=subprocess.PIPE, check=True).stdout
+
+
+def seekable(content, frame_size):
+    chunks = [content[i:i + frame_size] for i in range(0, len(content), frame_size)]
+    frames = [compress(chunk) for chunk in chunks]
+    entries = b"".join(struct.pack("<II", len(frame), len(chunk)) for frame, chunk in zip(frames, chunks))
+    footer = struct.pack("<IBI", len(frames), 0, SEEKABLE_MAGIC)
+    table = struct.pack("<II", SKIPPABLE_SEEK_TABLE_MAGIC, len(entries) + len(footer)) + entries + footer
+    return b"".join(frames) + table
+
+
+def main():
+    here = os.path.dirname(os.path.abspath(__file__))
+    with open(os.path.join(here, "opt.log"), "rb") as handle:
+        content = handle.read()
+    with open(os.path.join(here, "opt.log.zst"), "wb") as handle:
+        handle.write(compress(content))
+    with open(os.path.join(here, "opt-seekable.log.zst"), "wb") as handle:
+        handle.write(seekable(content, 4096))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,61 @@
+#!/bin/bash
+
+# Shared helpers of the regression tests
+# Each test is run as: <test>.sh <extractor executable> [tests directory]
+# and sources this file, which sets BINARY, TESTS_DIR and a scratch directory WORK
+# that is removed when the test exits.
+
+set -e
+
+if [ $# -lt 1 ]; then
+    echo "Usage: $0 <gaussian_extractor executable> [tests directory]" >&2
+    exit 2
+fi
+
+BINARY="$(cd "$(dirname "$1")" && pwd)/$(basename "$1")"
+TESTS_DIR="$(cd "${2:-$(dirname "${BASH_SOURCE[0]}")/..}" && pwd)"
+WORK="$(mktemp -d "${TMPDIR:-/tmp}/gx_test.XXXXXX")"
+trap 'rm -rf "$WORK"' EXIT
+
+if [ ! -x "$BINARY" ]; then
+    echo "Extractor not found: $BINARY" >&2
+    exit 2
+fi
+
+# Print a failure and stop the test
+fail() {
+    echo "FAIL: $(basename "$0"): $1" >&2
+    exit 1
+}
+
+# Print the end-of-test line
+pass() {
+    echo "PASS: $(basename "$0")"
+}
+
+# Run extract in a directory and print the rows of its CSV output (one per log)
+# Usage: extract_rows <directory> [extra extract options...]
+# The console output is left in <directory>/extract.console (a name extract does
+# not pick up as a log); the CSV file, which also
+# holds the run summary and its warnings, in <directory>/<directory name>.csv
+extract_rows() {
+    local dir="$1"
+    shift
+    (cd "$dir" && "$BINARY" extract -q -f csv "$@" > extract.console 2>&1) || fail "extract $* failed in $dir"
+    grep '^"' "$dir/$(basename "$dir").csv" || true
+}
+
+# Fail if the last extract in a directory reported a scanner cross-check mismatch
+# Usage: expect_no_mismatch <directory>
+expect_no_mismatch() {
+    local output="$1/$(basename "$1").csv"
+    if grep -q "cross-check mismatch" "$output"; then
+        fail "verify reported a mismatch: $(grep "cross-check mismatch" "$output")"
+    fi
+}
+
+# Print one field (1-based) of the CSV row of a log
+# Usage: row_field <rows> <log name> <field>
+row_field() {
+    printf '%s\n' "$1" | grep "^\"$2\"," | cut -d, -f"$3"
+}
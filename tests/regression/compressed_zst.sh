@@ -0,0 +1,43 @@
+#!/bin/bash
+
+# Compressed logs in tests/compressed: opt.log.zst (one frame) and
+# opt-seekable.log.zst (the seekable format, whose tail is read through its seek
+# table) must give the same row as opt.log. A build without libzstd must name
+# the .zst files in a warning instead of leaving them out silently.
+# The fixtures are written by tests/compressed/make_fixtures.py.
+
+source "$(dirname "$0")/common.sh" "$@"
+
+DIR="$WORK/compressed"
+mkdir -p "$DIR"
+cp "$TESTS_DIR/compressed/opt.log" "$TESTS_DIR"/compressed/*.log.zst "$DIR/"
+
+for mode in fast tail legacy; do
+    rows="$(extract_rows "$DIR" --scan-mode "$mode")"
+    plain="$(printf '%s\n' "$rows" | grep '^"opt.log",' | cut -d, -f2-)"
+    [ -n "$plain" ] || fail "no row for opt.log with --scan-mode $mode: $rows"
+
+    if grep -q "built without zstd" "$DIR/extract.console"; then
+        for name in opt.log.zst opt-seekable.log.zst; do
+            grep "built without zstd" "$DIR/extract.console" | grep -q "$name" ||
+                fail "the warning does not name $name: $(cat "$DIR/extract.console")"
+        done
+        [ "$(printf '%s\n' "$rows" | wc -l)" = "1" ] || fail "rows for unreadable .zst files: $rows"
+        continue
+    fi
+
+    for name in opt.log.zst opt-seekable.log.zst; do
+        compressed="$(printf '%s\n' "$rows" | grep "^\"$name\"," | cut -d, -f2-)"
+        [ "$compressed" = "$plain" ] || fail "$name differs from opt.log with --scan-mode $mode: $rows"
+    done
+done
+
+# The job checker reads the last lines of each log, through the seek table where there is one
+if ! grep -q "built without zstd" "$DIR/extract.console"; then
+    (cd "$DIR" && "$BINARY" done --dry-run > done.console 2>&1) || fail "done --dry-run failed: $(cat "$DIR/done.console")"
+    for name in opt.log opt.log.zst opt-seekable.log.zst; do
+        grep -q "^$name would be moved" "$DIR/done.console" || fail "$name not reported as done: $(cat "$DIR/done.console")"
+    done
+fi
+
+pass
@@ -0,0 +1,90 @@
+#!/usr/bin/env python3
+"""Smoke test of the Python module: the rows it returns match the CLI's CSV output.
+
+Run as: python_module.py <module directory> <extractor executable> [tests directory]
+"""
+
+import csv
+import os
+import shutil
+import subprocess
+import sys
+import tempfile
+
+
+def fail(message):
+    print("FAIL: python_module.py: " + message, file=sys.stderr)
+    sys.exit(1)
+
+
+def cli_rows(binary, directory):
+    """Rows of `extract -f csv` by log name (the CSV also holds the run summary)."""
+    subprocess.run([binary, "extract", "-q", "-f", "csv"], cwd=directory, check=True, stdout=subprocess.DEVNULL)
+    with open(os.path.join(directory, os.path.basename(directory) + ".csv"), newline="") as handle:
+        lines = [line for line in handle if line.startswith('"')]
+    return {row[0]: row for row in csv.reader(lines)}
+
+
+def main():
+    if len(sys.argv) < 3:
+        print(__doc__, file=sys.stderr)
+        return 2
+    module_dir, binary = sys.argv[1], os.path.abspath(sys.argv[2])
+    tests_dir = sys.argv[3] if len(sys.argv) > 3 else os.path.join(os.path.dirname(__file__), "..")
+    sys.path.insert(0, module_dir)
+    import gaussian_extractor as gx
+
+    with tempfile.TemporaryDirectory(prefix="gx_test.") as work:
+        data = os.path.join(work, "data")
+        os.mkdir(data)
+        for name in ("test-1.log", "test-2.log"):
+            shutil.copy(os.path.join(tests_dir, "data", name), data)
+        expected = cli_rows(binary, data)
+
+        session = gx.Session(threads=2)
+        batch = session.extract_many([os.path.join(data, name) for name in sorted(expected)])
+        if len(batch) != len(expected):
+            fail("%d rows for %d logs" % (len(batch), len(expected)))
+        if batch.columns[:3] != ["file_name", "etg_kj_mol", "lowest_frequency"]:
+            fail("unexpected columns %s" % batch.columns)
+
+        names = batch.column("file_name")
+        gibbs = batch.column("etg_hartree")
+        flags = batch.column("phase_correction")
+        rounds = batch.column("round")
+        if gibbs.format != "d" or not gibbs.readonly or rounds.format != "i":
+            fail("numeric columns are not read-only float64/int32 views")
+        for row, name in enumerate(names):
+            cli = expected.get(os.path.basename(name))
+            if cli is None:
+                fail("row for unexpected log " + name)
+            if abs(gibbs[row] - float(cli[3])) > 1e-6:
+                fail("%s: etg_hartree %.6f, CLI %s" % (name, gibbs[row], cli[3]))
+            if batch.column("status")[row] != cli[7] or flags[row] != (cli[8] == "YES") or rounds[row] != int(cli[9]):
+                fail("%s: status, phase correction or round differ from the CLI" % name)
+
+        offsets, text = batch.string_buffers("file_name")
+        if offsets[len(batch)] != len(text) or bytes(text).decode() != "".join(names):
+            fail("string buffers do not match the file_name column")
+        if set(batch.to_dict()) != set(batch.columns):
+            fail("to_dict() keys differ from the columns")
+        try:
+            import pyarrow
+        except ImportError:
+            pyarrow = None
+        if pyarrow is not None:
+            table = batch.to_arrow()
+            if table.num_rows != len(batch) or table.column("etg_hartree").to_pylist() != gibbs.tolist():
+                fail("to_arrow() differs from the batch")
+            if table.column("file_name").to_pylist() != names:
+                fail("to_arrow() file names differ from the batch")
+        del batch
+        if gibbs.tolist()[0] != gibbs[0]:
+            fail("column view did not outlive its batch")
+
+    print("PASS: python_module.py")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,77 @@
+#!/bin/bash
+
+# The result index (extract --index): unchanged logs are served from the index,
+# a log edited between two runs is parsed again (stamp mismatch), entries of
+# logs that are gone are dropped only from the sections the run used, and an
+# index with another version header is ignored and rewritten.
+
+source "$(dirname "$0")/common.sh" "$@"
+
+DIR="$WORK/indexed"
+INDEX="$DIR/.gaussian_extractor.idx"
+mkdir -p "$DIR"
+cp "$TESTS_DIR"/data/test-1.log "$TESTS_DIR"/data/test-2.log "$DIR/"
+
+# Run extract with the index and print its rows; the console output is kept for expect_reuse
+indexed_rows() {
+    (cd "$DIR" && "$BINARY" extract -f csv --index > extract.console 2>&1) || fail "extract --index failed"
+    grep '^"' "$DIR/$(basename "$DIR").csv" || true
+}
+
+# Usage: expect_reuse <reused> <parsed>
+expect_reuse() {
+    grep -q "Result index: $1 reused, $2 parsed" "$DIR/extract.console" ||
+        fail "expected $1 reused and $2 parsed: $(grep "Result index" "$DIR/extract.console")"
+}
+
+# Replace text in a file without changing its inode
+rewrite() {
+    sed "$2" "$1" > "$WORK/rewritten" && cat "$WORK/rewritten" > "$1"
+}
+
+# Store -1111.5 as the SCF energy of test-1.log (values are written with up to 17 digits)
+# Usage: forge_scf <stored value without its trailing digits>
+forge_scf() {
+    rewrite "$INDEX" "/^extract.*test-1\.log/s/\t$1[0-9]*\t/\t-1111.5\t/"
+    grep -q $'\t-1111.5\t' "$INDEX" || fail "could not forge the stored SCF energy: $(grep test-1 "$INDEX")"
+}
+
+# First run parses everything and writes one entry per log
+first="$(indexed_rows)"
+expect_reuse 0 2
+[ "$(head -n 1 "$INDEX")" = "# gaussian_extractor result index v1" ] || fail "unexpected index header: $(head -n 1 "$INDEX")"
+[ "$(grep -c "^extract" "$INDEX")" = "2" ] || fail "expected two extract entries: $(cut -f1,5 "$INDEX")"
+
+# Unchanged logs are served from the index, which a forged value proves
+rows="$(indexed_rows)"
+expect_reuse 2 0
+[ "$rows" = "$first" ] || fail "rows from the index differ: $rows"
+forge_scf '-1234\.5678'
+rows="$(indexed_rows)"
+[ "$(row_field "$rows" test-1.log 6)" = "-1111.500000" ] || fail "the stored value was not used: $rows"
+
+# A log edited in place (same size and inode, new mtime) is parsed again
+rewrite "$DIR/test-1.log" 's/-1234\.5678/-1234.6789/'
+touch -d "@$(($(stat -c %Y "$DIR/test-1.log") + 60))" "$DIR/test-1.log"
+rows="$(indexed_rows)"
+expect_reuse 1 1
+[ "$(row_field "$rows" test-1.log 6)" = "-1234.678900" ] || fail "the edited log was not parsed again: $rows"
+
+# A log that is gone leaves the sections used by the run, not the others
+(cd "$DIR" && "$BINARY" done --dry-run --index > done.console 2>&1) || fail "done --dry-run --index failed"
+[ "$(grep -c "^check" "$INDEX")" = "2" ] || fail "expected two check entries: $(cut -f1,5 "$INDEX")"
+rm "$DIR/test-2.log"
+rows="$(indexed_rows)"
+expect_reuse 1 0
+grep -q "^extract.*test-2\.log" "$INDEX" && fail "the extract entry of the removed log was kept"
+grep -q "^check.*test-2\.log" "$INDEX" || fail "the check entry of the removed log was dropped by extract"
+
+# An index with another version header is ignored and written again
+forge_scf '-1234\.6789'
+rewrite "$INDEX" '1s/ v1$/ v0/'
+rows="$(indexed_rows)"
+expect_reuse 0 1
+[ "$(row_field "$rows" test-1.log 6)" = "-1234.678900" ] || fail "an entry of the old index version was used: $rows"
+[ "$(head -n 1 "$INDEX")" = "# gaussian_extractor result index v1" ] || fail "the index was not rewritten: $(head -n 1 "$INDEX")"
+
+pass
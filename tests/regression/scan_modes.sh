@@ -0,0 +1,32 @@
+#!/bin/bash
+
+# The scanners behind --scan-mode fast, tail, legacy and verify must give the
+# same rows for every fixture log: tests/data (CRLF line endings; test-2.log
+# holds three job steps) and tests/extract-xyz (C8.log holds two Link1 steps;
+# .log and .out files in mixed case). verify must not report a mismatch.
+
+source "$(dirname "$0")/common.sh" "$@"
+
+DIR="$WORK/fixtures"
+mkdir -p "$DIR"
+cp "$TESTS_DIR"/data/*.log "$TESTS_DIR"/extract-xyz/* "$DIR/"
+
+grep -q $'\r$' "$DIR/test-2.log" || fail "test-2.log no longer has CRLF line endings"
+[ "$(grep -c "Normal termination" "$DIR/C8.log")" -ge 2 ] || fail "C8.log no longer holds several job steps"
+
+fast="$(extract_rows "$DIR" --scan-mode fast -e log,out)"
+[ "$(printf '%s\n' "$fast" | wc -l)" = "8" ] || fail "expected 8 rows from the fixtures: $fast"
+[ "$(row_field "$fast" test-2.log 10)" = "3" ] || fail "test-2.log is not counted as three job steps: $fast"
+[ "$(row_field "$fast" C8.log 8)" = "DONE" ] || fail "C8.log is not DONE: $fast"
+
+for mode in tail legacy verify; do
+    rows="$(extract_rows "$DIR" --scan-mode "$mode" -e log,out)"
+    [ "$rows" = "$fast" ] || fail "--scan-mode $mode differs from fast: $(diff <(echo "$fast") <(echo "$rows"))"
+done
+expect_no_mismatch "$DIR"
+
+# Several threads: large logs are split into parts scanned in parallel
+rows="$(extract_rows "$DIR" --scan-mode fast -e log,out -nt 4)"
+[ "$rows" = "$fast" ] || fail "fast with 4 threads differs: $(diff <(echo "$fast") <(echo "$rows"))"
+
+pass
@@ -0,0 +1,31 @@
+#!/bin/bash
+
+# Tail-first scanning of a multi-step log whose second banner lies outside both
+# the header probe and the backward window: Round and PCorr must match a full scan.
+# The log is assembled from tests/extract-xyz/C8.log with filler lines, so the
+# second step starts in the part of the file the tail scan does not parse.
+
+source "$(dirname "$0")/common.sh" "$@"
+
+SOURCE="$TESTS_DIR/extract-xyz/C8.log"
+DIR="$WORK/multistep"
+mkdir -p "$DIR"
+{
+    sed -n '1,11p' "$SOURCE"
+    seq 1 60000 | sed 's/^/ Filler line of the first job step /'
+    sed -n '12,$p' "$SOURCE"
+    sed -n '1,11p' "$SOURCE"
+    seq 1 30000 | sed 's/^/ Filler line of the second job step /'
+    sed -n '900,$p' "$SOURCE"
+} > "$DIR/multi.log"
+
+full="$(extract_rows "$DIR" --scan-mode fast)"
+[ "$(row_field "$full" multi.log 10)" = "2" ] || fail "full scan did not count two job steps: $full"
+
+for mode in tail legacy verify; do
+    rows="$(extract_rows "$DIR" --scan-mode "$mode")"
+    [ "$rows" = "$full" ] || fail "--scan-mode $mode differs from fast: $rows"
+done
+expect_no_mismatch "$DIR"
+
+pass